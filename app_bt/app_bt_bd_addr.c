@@ -0,0 +1,96 @@
+/******************************************************************************
+* File Name:   app_bt_bd_addr.c
+*
+* Description: This file contains the derivation of the device BD address from its unique ID. It needs no
+*              stack headers, so the host tests link it as built for the target.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "app_bt_utils.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: app_bt_util_generate_bd_address
+***************************************************************************************************
+* Function Description:
+* @brief Function used to generate unique BD Address for the device. The unique ID is hashed
+*        (FNV-1a followed by a 64-bit finalizer) so that neighbouring IDs give unrelated
+*        addresses. The two most significant bits are set, as for a static random address,
+*        and the remaining 46 bits are never all zero or all one.
+*
+* @param unique_id: device unique ID, e.g. read from efuse
+* @param id_len: length of the unique ID in bytes
+* @param bd_addr: generated address
+*
+* @return void
+*/
+void app_bt_util_generate_bd_address(const uint8_t *unique_id, uint8_t id_len, wiced_bt_device_address_t bd_addr)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    uint8_t  i;
+
+    for (i = 0; i < id_len; i++)
+    {
+        h ^= unique_id[i];
+        h *= 0x100000001b3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+
+    h &= 0x3FFFFFFFFFFFULL;
+    if ((h == 0) || (h == 0x3FFFFFFFFFFFULL))
+    {
+        h ^= 0x155555555555ULL;
+    }
+    for (i = 0; i < BD_ADDR_LEN; i++)
+    {
+        bd_addr[i] = (uint8_t)(h >> (8 * (BD_ADDR_LEN - 1 - i)));
+    }
+    bd_addr[0] |= 0xC0;
+}
+/* [] END OF FILE */
@@ -0,0 +1,283 @@
+/*******************************************************************************
+* File Name: app_bt_dispatch.c
+*
+* Description: This file contains the table driven Bluetooth event dispatcher.
+*              Modules subscribe handlers per event id; dispatch is an indexed
+*              lookup followed by the subscriber chain of that event.
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+ ******************************************************************************/
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "app_bt_utils.h"
+#include "app_bt_dispatch.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+ * Macro Definitions
+*******************************************************************************/
+#define APP_BT_DISPATCH_NONE            (0xFF)
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    app_bt_dispatch_handler_t *handler;
+    uint8_t                   next;              /* next subscription of the same event */
+} app_bt_dispatch_sub_t;
+
+static app_bt_dispatch_sub_t   dispatch_sub[APP_BT_DISPATCH_MAX_SUBS];
+static uint8_t                 dispatch_sub_used = 0;
+static uint8_t                 dispatch_head[APP_BT_DISPATCH_DOMAIN_NUM][APP_BT_DISPATCH_MAX_EVENTS];
+static app_bt_dispatch_stats_t dispatch_stats[APP_BT_DISPATCH_DOMAIN_NUM][APP_BT_DISPATCH_MAX_EVENTS];
+static uint32_t                dispatch_unhandled[APP_BT_DISPATCH_DOMAIN_NUM];
+static wiced_bool_t            dispatch_trace = WICED_FALSE;
+
+/*******************************************************************************
+ * Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: app_bt_dispatch_init
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears all subscriptions and statistics and starts the cycle counter. Must run
+* before wiced_bt_stack_init() so that no event arrives before its handler is subscribed.
+* @return void
+*/
+void app_bt_dispatch_init(void)
+{
+    memset(dispatch_sub, 0, sizeof(dispatch_sub));
+    memset(dispatch_head, APP_BT_DISPATCH_NONE, sizeof(dispatch_head));
+    memset(dispatch_stats, 0, sizeof(dispatch_stats));
+    memset(dispatch_unhandled, 0, sizeof(dispatch_unhandled));
+    dispatch_sub_used = 0;
+    app_bt_util_cycle_counter_init();
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_dispatch_subscribe
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function adds a handler to the end of an event's subscriber chain. Subscribe during
+* initialization only, not from a handler.
+* @param domain  , event domain.
+* @param event   , event id within the domain.
+* @param handler , handler to call.
+* @return wiced_result_t WICED_SUCCESS, WICED_BADARG or WICED_BT_NO_RESOURCES.
+*/
+wiced_result_t app_bt_dispatch_subscribe(app_bt_dispatch_domain_t domain, uint32_t event, app_bt_dispatch_handler_t *handler)
+{
+    uint8_t *p_link;
+    uint8_t  idx;
+
+    if ((domain >= APP_BT_DISPATCH_DOMAIN_NUM) || (event >= APP_BT_DISPATCH_MAX_EVENTS) || (handler == NULL))
+    {
+        return WICED_BADARG;
+    }
+    if (dispatch_sub_used >= APP_BT_DISPATCH_MAX_SUBS)
+    {
+        printf("app_bt_dispatch_subscribe: no free entry for evt:0x%lx\n", (unsigned long)event);
+        return WICED_BT_NO_RESOURCES;
+    }
+    idx = dispatch_sub_used++;
+    dispatch_sub[idx].handler = handler;
+    dispatch_sub[idx].next    = APP_BT_DISPATCH_NONE;
+
+    p_link = &dispatch_head[domain][event];
+    while (*p_link != APP_BT_DISPATCH_NONE)
+    {
+        p_link = &dispatch_sub[*p_link].next;
+    }
+    *p_link = idx;
+    return WICED_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_dispatch_event_name
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the name of an event for the trace.
+* @param domain , event domain.
+* @param event  , event id.
+* @return const char* event name.
+*/
+static const char *app_bt_dispatch_event_name(app_bt_dispatch_domain_t domain, uint32_t event)
+{
+    if (domain == APP_BT_DISPATCH_BTM)
+    {
+        return app_bt_util_get_btm_event_name((wiced_bt_management_evt_t)event);
+    }
+    if (domain == APP_BT_DISPATCH_EXT_SCAN)
+    {
+        return "EXT_SCAN_REPORT";
+    }
+    return app_bt_util_get_ext_adv_event_name((wiced_ble_ext_adv_event_t)event);
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_dispatch
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function calls every handler subscribed to the event.
+* @param domain       , event domain.
+* @param event        , event id within the domain.
+* @param p_event_data , event data passed to the handlers.
+* @return wiced_result_t WICED_BT_ERROR if nobody subscribed, else the first handler failure or
+*         WICED_BT_SUCCESS.
+*/
+wiced_result_t app_bt_dispatch(app_bt_dispatch_domain_t domain, uint32_t event, void *p_event_data)
+{
+    app_bt_dispatch_stats_t *p_stats;
+    wiced_result_t          result = WICED_BT_SUCCESS;
+    wiced_result_t          status;
+    uint32_t                start;
+    uint32_t                cycles;
+    uint8_t                 idx;
+
+    if (dispatch_trace)
+    {
+        printf("evt:%s\n", app_bt_dispatch_event_name(domain, event));
+    }
+    if ((domain >= APP_BT_DISPATCH_DOMAIN_NUM) || (event >= APP_BT_DISPATCH_MAX_EVENTS) ||
+        (dispatch_head[domain][event] == APP_BT_DISPATCH_NONE))
+    {
+        if (domain < APP_BT_DISPATCH_DOMAIN_NUM)
+        {
+            dispatch_unhandled[domain]++;
+        }
+        return WICED_BT_ERROR;
+    }
+
+    start = APP_BT_UTIL_CYCLES();
+    for (idx = dispatch_head[domain][event]; idx != APP_BT_DISPATCH_NONE; idx = dispatch_sub[idx].next)
+    {
+        status = dispatch_sub[idx].handler(event, p_event_data);
+        if ((status != WICED_BT_SUCCESS) && (result == WICED_BT_SUCCESS))
+        {
+            result = status;
+        }
+    }
+    cycles = APP_BT_UTIL_CYCLES() - start;
+
+    p_stats = &dispatch_stats[domain][event];
+    p_stats->count++;
+    p_stats->cycles_sum += cycles;
+    if (cycles > p_stats->cycles_max)
+    {
+        p_stats->cycles_max = cycles;
+    }
+    return result;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_dispatch_set_trace
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function turns the per event name trace on or off. Off by default.
+* @param enable , WICED_TRUE to print every dispatched event.
+* @return void
+*/
+void app_bt_dispatch_set_trace(wiced_bool_t enable)
+{
+    dispatch_trace = enable;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_dispatch_get_stats
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the statistics of one event.
+* @param domain  , event domain.
+* @param event   , event id within the domain.
+* @param p_stats , statistics, zeroed for an unknown event.
+* @return void
+*/
+void app_bt_dispatch_get_stats(app_bt_dispatch_domain_t domain, uint32_t event, app_bt_dispatch_stats_t *p_stats)
+{
+    if ((domain < APP_BT_DISPATCH_DOMAIN_NUM) && (event < APP_BT_DISPATCH_MAX_EVENTS))
+    {
+        *p_stats = dispatch_stats[domain][event];
+    }
+    else
+    {
+        memset(p_stats, 0, sizeof(*p_stats));
+    }
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_dispatch_print_stats
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the statistics of every event seen so far.
+* @return void
+*/
+void app_bt_dispatch_print_stats(void)
+{
+    uint8_t  domain;
+    uint32_t event;
+
+    for (domain = 0; domain < APP_BT_DISPATCH_DOMAIN_NUM; domain++)
+    {
+        for (event = 0; event < APP_BT_DISPATCH_MAX_EVENTS; event++)
+        {
+            app_bt_dispatch_stats_t *p_stats = &dispatch_stats[domain][event];
+            if (p_stats->count != 0)
+            {
+                printf("%s: cnt:%lu, cyc_avg:%lu, cyc_max:%lu\n",
+                       app_bt_dispatch_event_name((app_bt_dispatch_domain_t)domain, event),
+                       (unsigned long)p_stats->count,
+                       (unsigned long)(p_stats->cycles_sum / p_stats->count),
+                       (unsigned long)p_stats->cycles_max);
+            }
+        }
+        printf("domain:%d unhandled:%lu\n", domain, (unsigned long)dispatch_unhandled[domain]);
+    }
+}
+
+/* END OF FILE [] */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name: app_bt_dispatch.h
+*
+* Description: This file is the public interface of the table driven Bluetooth
+*              event dispatcher.
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef APP_BT_DISPATCH_H_
+#define APP_BT_DISPATCH_H_
+/******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+ * Macro Definitions
+*******************************************************************************/
+#define APP_BT_DISPATCH_MAX_EVENTS      (48)     /* event ids per domain, larger ids are unhandled */
+#define APP_BT_DISPATCH_MAX_SUBS        (16)     /* subscriptions across all domains */
+#define APP_BT_DISPATCH_EXT_SCAN_REPORT (0)      /* the one event of APP_BT_DISPATCH_EXT_SCAN */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef enum
+{
+    APP_BT_DISPATCH_BTM = 0,                     /* wiced_bt_management_evt_t */
+    APP_BT_DISPATCH_EXT_ADV,                     /* wiced_ble_ext_adv_event_t */
+    APP_BT_DISPATCH_EXT_SCAN,                    /* extended advertising reports, wiced_ble_ext_scan_results_t */
+    APP_BT_DISPATCH_DOMAIN_NUM
+} app_bt_dispatch_domain_t;
+
+/* Handlers run in the Bluetooth stack context, in subscription order. */
+typedef wiced_result_t (app_bt_dispatch_handler_t)(uint32_t event, void *p_event_data);
+
+typedef struct
+{
+    uint32_t count;                              /* events dispatched */
+    uint32_t cycles_sum;                         /* CPU cycles spent in all handlers */
+    uint32_t cycles_max;                         /* worst single dispatch */
+} app_bt_dispatch_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+******************************************************************************/
+void app_bt_dispatch_init(void);
+wiced_result_t app_bt_dispatch_subscribe(app_bt_dispatch_domain_t domain, uint32_t event, app_bt_dispatch_handler_t *handler);
+wiced_result_t app_bt_dispatch(app_bt_dispatch_domain_t domain, uint32_t event, void *p_event_data);
+void app_bt_dispatch_set_trace(wiced_bool_t enable);
+void app_bt_dispatch_get_stats(app_bt_dispatch_domain_t domain, uint32_t event, app_bt_dispatch_stats_t *p_stats);
+void app_bt_dispatch_print_stats(void);
+#endif /* APP_BT_DISPATCH_H_ */
+
+/* END OF FILE [] */
@@ -59,6 +59,7 @@
 #include "wiced_bt_trace.h"
 #include "cybt_platform_trace.h"
 #include "pawr_app.h"
+#include "app_bt_dispatch.h"
 
 /*******************************************************************************
  * Macro Definitions
@@ -71,13 +72,52 @@
 /*******************************************************************************
  * Function Definitions
 ******************************************************************************/
+/**************************************************************************************************
+* Function Name: app_bt_enabled_handler
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the dispatch handler of BTM_ENABLED_EVT.
+* @param event        , Bluetooth LE event code of one byte length.
+* @param p_event_data , Pointer to Bluetooth LE management event structures.
+* @return wiced_result_t Error code from WICED_RESULT_LIST or BT_RESULT_LIST.
+*/
+static wiced_result_t app_bt_enabled_handler(uint32_t event, void *p_event_data)
+{
+    wiced_bt_management_evt_data_t *p_data = (wiced_bt_management_evt_data_t *)p_event_data;
+
+    /* Bluetooth Controller and Host Stack Enabled */
+    if (WICED_BT_SUCCESS == p_data->enabled.status)
+    {
+        app_peripheral_init();
+        return WICED_BT_SUCCESS;
+    }
+    printf( "Failed to initialize Bluetooth controller and stack\n");
+    return WICED_BT_ERROR;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_event_handler_init
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets up the event dispatch table and subscribes the management event handlers.
+* Must be called before wiced_bt_stack_init().
+* @return void
+*/
+void app_bt_event_handler_init(void)
+{
+    app_bt_dispatch_init();
+    app_bt_dispatch_subscribe(APP_BT_DISPATCH_BTM, BTM_ENABLED_EVT, app_bt_enabled_handler);
+}
+
 /**************************************************************************************************
 * Function Name: app_bt_management_callback
 ***************************************************************************************************
 * Function Description:
 * @brief
 * This function is a Bluetooth stack event handler function to receive management events
-* from the Bluetooth stack and process as per the application.
+* from the Bluetooth stack and hand them to the subscribed handlers.
 * @param event        , Bluetooth LE event code of one byte length.
 * @param p_event_data , Pointer to Bluetooth LE management event structures.
 * @return wiced_result_t Error code from WICED_RESULT_LIST or BT_RESULT_LIST.
@@ -85,27 +125,7 @@
 wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
                                           wiced_bt_management_evt_data_t *p_event_data)
 {
-    wiced_result_t result  = WICED_BT_ERROR;
-    printf("Bluetooth Management Event:0x%x\r\n",event);
-    switch (event)
-    {
-        case BTM_ENABLED_EVT:
-            /* Bluetooth Controller and Host Stack Enabled */
-            if (WICED_BT_SUCCESS == p_event_data->enabled.status)
-            {
-                app_peripheral_init();
-                result = WICED_BT_SUCCESS;
-            }
-            else
-            {
-                printf( "Failed to initialize Bluetooth controller and stack\n");
-            }
-        break;
-        default:
-            printf( "unknown:evt:0x%x\n",event);
-        break;
-    }
-    return result;
+    return app_bt_dispatch(APP_BT_DISPATCH_BTM, (uint32_t)event, p_event_data);
 }
 
 /* END OF FILE [] */
@@ -54,6 +54,7 @@
 /*******************************************************************************
  * Function Prototypes
 ******************************************************************************/
+void app_bt_event_handler_init(void);
 wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
                                           wiced_bt_management_evt_data_t *p_event_data);
 #endif /* APP_BT_EVENT_HANDLER_H_ */
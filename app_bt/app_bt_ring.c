@@ -0,0 +1,307 @@
+/*******************************************************************************
+* File Name: app_bt_ring.c
+*
+* Description: This file contains the lock-free single-producer single-consumer
+*              ring buffer used to hand data between the Bluetooth stack context
+*              and application tasks.
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+ ******************************************************************************/
+#include <string.h>
+#include "app_bt_ring.h"
+
+/*******************************************************************************
+ * Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+ * Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: app_bt_ring_init
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function initializes a ring over caller provided storage. Must complete before either side
+* uses the ring.
+* @param p_ring    , ring to initialize.
+* @param p_buf     , storage of elem_size * capacity bytes, see APP_BT_RING_DEFINE_BUF.
+* @param elem_size , size of one element in bytes.
+* @param capacity  , number of elements, must be a power of two.
+* @return wiced_result_t WICED_SUCCESS or WICED_BADARG.
+*/
+wiced_result_t app_bt_ring_init(app_bt_ring_t *p_ring, uint8_t *p_buf, uint16_t elem_size, uint32_t capacity)
+{
+    if ((p_ring == NULL) || (p_buf == NULL) || (elem_size == 0) ||
+        (capacity == 0) || ((capacity & (capacity - 1)) != 0))
+    {
+        return WICED_BADARG;
+    }
+    p_ring->p_buf      = p_buf;
+    p_ring->mask       = capacity - 1;
+    p_ring->elem_size  = elem_size;
+    p_ring->tail_cache = 0;
+    p_ring->pushed     = 0;
+    p_ring->overflow   = 0;
+    p_ring->head_cache = 0;
+    p_ring->popped     = 0;
+    atomic_init(&p_ring->head, 0);
+    atomic_init(&p_ring->tail, 0);
+    return WICED_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_copy_in
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies num elements into the ring starting at index pos, wrapping at the end.
+* @param p_ring , ring.
+* @param pos    , free running index of the first element.
+* @param p_src  , elements to copy.
+* @param num    , number of elements.
+* @return void
+*/
+static void app_bt_ring_copy_in(app_bt_ring_t *p_ring, uint32_t pos, const uint8_t *p_src, uint32_t num)
+{
+    uint32_t idx   = pos & p_ring->mask;
+    uint32_t first = (p_ring->mask + 1) - idx;
+
+    if (first > num)
+    {
+        first = num;
+    }
+    memcpy(&p_ring->p_buf[idx * p_ring->elem_size], p_src, first * p_ring->elem_size);
+    if (num > first)
+    {
+        memcpy(p_ring->p_buf, &p_src[first * p_ring->elem_size], (num - first) * p_ring->elem_size);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_copy_out
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies num elements out of the ring starting at index pos, wrapping at the end.
+* @param p_ring , ring.
+* @param pos    , free running index of the first element.
+* @param p_dst  , destination.
+* @param num    , number of elements.
+* @return void
+*/
+static void app_bt_ring_copy_out(app_bt_ring_t *p_ring, uint32_t pos, uint8_t *p_dst, uint32_t num)
+{
+    uint32_t idx   = pos & p_ring->mask;
+    uint32_t first = (p_ring->mask + 1) - idx;
+
+    if (first > num)
+    {
+        first = num;
+    }
+    memcpy(p_dst, &p_ring->p_buf[idx * p_ring->elem_size], first * p_ring->elem_size);
+    if (num > first)
+    {
+        memcpy(&p_dst[first * p_ring->elem_size], p_ring->p_buf, (num - first) * p_ring->elem_size);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_push_batch
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function appends up to num elements. Producer side only. Elements that do not fit are
+* counted as overflow and dropped.
+* @param p_ring  , ring.
+* @param p_elems , num consecutive elements.
+* @param num     , number of elements to append.
+* @return uint32_t number of elements appended.
+*/
+uint32_t app_bt_ring_push_batch(app_bt_ring_t *p_ring, const void *p_elems, uint32_t num)
+{
+    uint32_t head     = atomic_load_explicit(&p_ring->head, memory_order_relaxed);
+    uint32_t capacity = p_ring->mask + 1;
+    uint32_t space    = capacity - (head - p_ring->tail_cache);
+
+    if (space < num)
+    {
+        /* only touch the consumer's cache line when the cached view says we are short */
+        p_ring->tail_cache = atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+        space = capacity - (head - p_ring->tail_cache);
+    }
+    if (space < num)
+    {
+        p_ring->overflow += num - space;
+        num = space;
+    }
+    if (num != 0)
+    {
+        app_bt_ring_copy_in(p_ring, head, (const uint8_t *)p_elems, num);
+        atomic_store_explicit(&p_ring->head, head + num, memory_order_release);
+        p_ring->pushed += num;
+    }
+    return num;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_push
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function appends one element. Producer side only.
+* @param p_ring , ring.
+* @param p_elem , element to append.
+* @return wiced_bool_t WICED_FALSE if the ring was full.
+*/
+wiced_bool_t app_bt_ring_push(app_bt_ring_t *p_ring, const void *p_elem)
+{
+    return (app_bt_ring_push_batch(p_ring, p_elem, 1) == 1) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_pop_batch
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function removes up to max_num elements. Consumer side only.
+* @param p_ring  , ring.
+* @param p_elems , destination for max_num elements.
+* @param max_num , maximum number of elements to remove.
+* @return uint32_t number of elements removed.
+*/
+uint32_t app_bt_ring_pop_batch(app_bt_ring_t *p_ring, void *p_elems, uint32_t max_num)
+{
+    uint32_t tail  = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    uint32_t avail = p_ring->head_cache - tail;
+
+    if (avail < max_num)
+    {
+        p_ring->head_cache = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+        avail = p_ring->head_cache - tail;
+    }
+    if (avail > max_num)
+    {
+        avail = max_num;
+    }
+    if (avail != 0)
+    {
+        app_bt_ring_copy_out(p_ring, tail, (uint8_t *)p_elems, avail);
+        atomic_store_explicit(&p_ring->tail, tail + avail, memory_order_release);
+        p_ring->popped += avail;
+    }
+    return avail;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_pop
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function removes one element. Consumer side only.
+* @param p_ring , ring.
+* @param p_elem , destination for the element.
+* @return wiced_bool_t WICED_FALSE if the ring was empty.
+*/
+wiced_bool_t app_bt_ring_pop(app_bt_ring_t *p_ring, void *p_elem)
+{
+    return (app_bt_ring_pop_batch(p_ring, p_elem, 1) == 1) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_peek
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the oldest element in place without removing it. Consumer side only; the
+* element stays valid until the consumer pops it.
+* @param p_ring , ring.
+* @return void* oldest element or NULL if the ring is empty.
+*/
+void *app_bt_ring_peek(app_bt_ring_t *p_ring)
+{
+    uint32_t tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+
+    if (p_ring->head_cache == tail)
+    {
+        p_ring->head_cache = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+        if (p_ring->head_cache == tail)
+        {
+            return NULL;
+        }
+    }
+    return &p_ring->p_buf[(tail & p_ring->mask) * p_ring->elem_size];
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_count
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the number of queued elements. Exact from the consumer side, an upper
+* bound from the producer side.
+* @param p_ring , ring.
+* @return uint32_t number of queued elements.
+*/
+uint32_t app_bt_ring_count(app_bt_ring_t *p_ring)
+{
+    /* tail first: head only grows, so the difference can never go negative */
+    uint32_t tail = atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+
+    return head - tail;
+}
+
+/**************************************************************************************************
+* Function Name: app_bt_ring_get_overflow
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the number of elements dropped because the ring was full.
+* @param p_ring , ring.
+* @return uint32_t overflow counter.
+*/
+uint32_t app_bt_ring_get_overflow(const app_bt_ring_t *p_ring)
+{
+    return p_ring->overflow;
+}
+
+/* END OF FILE [] */
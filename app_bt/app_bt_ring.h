@@ -0,0 +1,97 @@
+/*******************************************************************************
+* File Name: app_bt_ring.h
+*
+* Description: This file is the public interface of the lock-free single-producer
+*              single-consumer ring buffer.
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef APP_BT_RING_H_
+#define APP_BT_RING_H_
+/******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdatomic.h>
+#include "cy_utils.h"
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+ * Macro Definitions
+*******************************************************************************/
+#define APP_BT_RING_CACHE_LINE          (32)     /* producer and consumer indexes live on separate lines */
+
+/* Declares zero-initialized, cache-line aligned storage for a ring of capacity elements. */
+#define APP_BT_RING_DEFINE_BUF(name, elem_size, capacity) \
+    static uint8_t name[(elem_size) * (capacity)] CY_ALIGN(APP_BT_RING_CACHE_LINE)
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+/* One producer context and one consumer context, e.g. the Bluetooth stack callback and an
+ * application task. Indexes run freely and are masked on access, so a full ring uses every
+ * element. No locks and no allocation; storage is provided by the caller. */
+typedef struct
+{
+    /* read-only after app_bt_ring_init() */
+    uint8_t     *p_buf;
+    uint32_t    mask;
+    uint16_t    elem_size;
+
+    /* producer side */
+    atomic_uint head CY_ALIGN(APP_BT_RING_CACHE_LINE);
+    uint32_t    tail_cache;                      /* producer's last view of tail */
+    uint32_t    pushed;
+    uint32_t    overflow;                        /* elements rejected because the ring was full */
+
+    /* consumer side */
+    atomic_uint tail CY_ALIGN(APP_BT_RING_CACHE_LINE);
+    uint32_t    head_cache;                      /* consumer's last view of head */
+    uint32_t    popped;
+} app_bt_ring_t;
+
+/*******************************************************************************
+ * Function Prototypes
+******************************************************************************/
+wiced_result_t app_bt_ring_init(app_bt_ring_t *p_ring, uint8_t *p_buf, uint16_t elem_size, uint32_t capacity);
+wiced_bool_t app_bt_ring_push(app_bt_ring_t *p_ring, const void *p_elem);
+uint32_t app_bt_ring_push_batch(app_bt_ring_t *p_ring, const void *p_elems, uint32_t num);
+wiced_bool_t app_bt_ring_pop(app_bt_ring_t *p_ring, void *p_elem);
+uint32_t app_bt_ring_pop_batch(app_bt_ring_t *p_ring, void *p_elems, uint32_t max_num);
+void *app_bt_ring_peek(app_bt_ring_t *p_ring);
+uint32_t app_bt_ring_count(app_bt_ring_t *p_ring);
+uint32_t app_bt_ring_get_overflow(const app_bt_ring_t *p_ring);
+#endif /* APP_BT_RING_H_ */
+
+/* END OF FILE [] */
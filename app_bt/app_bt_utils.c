@@ -51,6 +51,58 @@
 /*******************************************************************************
  * Variable Definitions
 *******************************************************************************/
+/* indexed by event id, so name lookups on the event path are a bounds check and a load */
+static const char * const btm_event_name[] =
+{
+    TABLE_ENTRY_STR(BTM_ENABLED_EVT)
+    TABLE_ENTRY_STR(BTM_DISABLED_EVT)
+    TABLE_ENTRY_STR(BTM_POWER_MANAGEMENT_STATUS_EVT)
+    TABLE_ENTRY_STR(BTM_PIN_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_USER_CONFIRMATION_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_PASSKEY_NOTIFICATION_EVT)
+    TABLE_ENTRY_STR(BTM_PASSKEY_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_KEYPRESS_NOTIFICATION_EVT)
+    TABLE_ENTRY_STR(BTM_PAIRING_IO_CAPABILITIES_BR_EDR_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_PAIRING_IO_CAPABILITIES_BR_EDR_RESPONSE_EVT)
+    TABLE_ENTRY_STR(BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_PAIRING_COMPLETE_EVT)
+    TABLE_ENTRY_STR(BTM_ENCRYPTION_STATUS_EVT)
+    TABLE_ENTRY_STR(BTM_SECURITY_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_SECURITY_FAILED_EVT)
+    TABLE_ENTRY_STR(BTM_SECURITY_ABORTED_EVT)
+    TABLE_ENTRY_STR(BTM_READ_LOCAL_OOB_DATA_COMPLETE_EVT)
+    TABLE_ENTRY_STR(BTM_REMOTE_OOB_DATA_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT)
+    TABLE_ENTRY_STR(BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT)
+    TABLE_ENTRY_STR(BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_BLE_SCAN_STATE_CHANGED_EVT)
+    TABLE_ENTRY_STR(BTM_BLE_ADVERT_STATE_CHANGED_EVT)
+    TABLE_ENTRY_STR(BTM_SMP_REMOTE_OOB_DATA_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_SMP_SC_REMOTE_OOB_DATA_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_SMP_SC_LOCAL_OOB_DATA_NOTIFICATION_EVT)
+    TABLE_ENTRY_STR(BTM_SCO_CONNECTED_EVT)
+    TABLE_ENTRY_STR(BTM_SCO_DISCONNECTED_EVT)
+    TABLE_ENTRY_STR(BTM_SCO_CONNECTION_REQUEST_EVT)
+    TABLE_ENTRY_STR(BTM_SCO_CONNECTION_CHANGE_EVT)
+    TABLE_ENTRY_STR(BTM_BLE_CONNECTION_PARAM_UPDATE)
+    TABLE_ENTRY_STR(BTM_BLE_DATA_LENGTH_UPDATE_EVENT)
+};
+
+static const char * const ext_adv_event_name[] =
+{
+    TABLE_ENTRY_STR(WICED_BLE_ADV_SET_TERMINATED_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_SCAN_REQUEST_RECEIVED_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_BIGINFO_ADV_REPORT_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_EXT_COMMAND_CMPLT_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_PERIODIC_ADV_REPORT_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_PERIODIC_ADV_SYNC_TRANSFER_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_PAWR_SUBEVENT_DATA_REQ_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_PAWR_RSP_REPORT_EVENT)
+    TABLE_ENTRY_STR(WICED_BLE_SET_PERIODIC_ADV_SYNC_TRANSFER_PARAM_EVENT)
+};
 
 /*******************************************************************************
  * Function Definitions
@@ -67,41 +119,9 @@
 */
 const char* app_bt_util_get_btm_event_name(wiced_bt_management_evt_t event)
 {
-    switch ((int)event)
+    if (((uint32_t)event < (sizeof(btm_event_name) / sizeof(btm_event_name[0]))) && (btm_event_name[event] != NULL))
     {
-        CASE_RETURN_STR(BTM_ENABLED_EVT)
-        CASE_RETURN_STR(BTM_DISABLED_EVT)
-        CASE_RETURN_STR(BTM_POWER_MANAGEMENT_STATUS_EVT)
-        CASE_RETURN_STR(BTM_PIN_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_USER_CONFIRMATION_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_PASSKEY_NOTIFICATION_EVT)
-        CASE_RETURN_STR(BTM_PASSKEY_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_KEYPRESS_NOTIFICATION_EVT)
-        CASE_RETURN_STR(BTM_PAIRING_IO_CAPABILITIES_BR_EDR_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_PAIRING_IO_CAPABILITIES_BR_EDR_RESPONSE_EVT)
-        CASE_RETURN_STR(BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_PAIRING_COMPLETE_EVT)
-        CASE_RETURN_STR(BTM_ENCRYPTION_STATUS_EVT)
-        CASE_RETURN_STR(BTM_SECURITY_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_SECURITY_FAILED_EVT)
-        CASE_RETURN_STR(BTM_SECURITY_ABORTED_EVT)
-        CASE_RETURN_STR(BTM_READ_LOCAL_OOB_DATA_COMPLETE_EVT)
-        CASE_RETURN_STR(BTM_REMOTE_OOB_DATA_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT)
-        CASE_RETURN_STR(BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT)
-        CASE_RETURN_STR(BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_BLE_SCAN_STATE_CHANGED_EVT)
-        CASE_RETURN_STR(BTM_BLE_ADVERT_STATE_CHANGED_EVT)
-        CASE_RETURN_STR(BTM_SMP_REMOTE_OOB_DATA_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_SMP_SC_REMOTE_OOB_DATA_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_SMP_SC_LOCAL_OOB_DATA_NOTIFICATION_EVT)
-        CASE_RETURN_STR(BTM_SCO_CONNECTED_EVT)
-        CASE_RETURN_STR(BTM_SCO_DISCONNECTED_EVT)
-        CASE_RETURN_STR(BTM_SCO_CONNECTION_REQUEST_EVT)
-        CASE_RETURN_STR(BTM_SCO_CONNECTION_CHANGE_EVT)
-        CASE_RETURN_STR(BTM_BLE_CONNECTION_PARAM_UPDATE)
-        CASE_RETURN_STR(BTM_BLE_DATA_LENGTH_UPDATE_EVENT)
+        return btm_event_name[event];
     }
     return "UNKNOWN_EVENT";
 }
@@ -120,19 +140,9 @@ const char* app_bt_util_get_btm_event_name(wiced_bt_management_evt_t event)
 */
 const char *app_bt_util_get_ext_adv_event_name(wiced_ble_ext_adv_event_t event)
 {
-    switch ((int)event)
+    if (((uint32_t)event < (sizeof(ext_adv_event_name) / sizeof(ext_adv_event_name[0]))) && (ext_adv_event_name[event] != NULL))
     {
-        CASE_RETURN_STR(WICED_BLE_ADV_SET_TERMINATED_EVENT)
-        CASE_RETURN_STR(WICED_BLE_SCAN_REQUEST_RECEIVED_EVENT)
-        CASE_RETURN_STR(WICED_BLE_BIGINFO_ADV_REPORT_EVENT)
-        CASE_RETURN_STR(WICED_BLE_EXT_COMMAND_CMPLT_EVENT)
-        CASE_RETURN_STR(WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT)
-        CASE_RETURN_STR(WICED_BLE_PERIODIC_ADV_REPORT_EVENT)
-        CASE_RETURN_STR(WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT)
-        CASE_RETURN_STR(WICED_BLE_PERIODIC_ADV_SYNC_TRANSFER_EVENT)
-        CASE_RETURN_STR(WICED_BLE_PAWR_SUBEVENT_DATA_REQ_EVENT)
-        CASE_RETURN_STR(WICED_BLE_PAWR_RSP_REPORT_EVENT)
-        CASE_RETURN_STR(WICED_BLE_SET_PERIODIC_ADV_SYNC_TRANSFER_PARAM_EVENT)
+        return ext_adv_event_name[event];
     }
     return "UNKNOWN_EVENT";
 }
@@ -403,17 +413,19 @@ void app_bt_util_print_link_key_data(wiced_bt_device_sec_keys_t *p_key)
 }
 
 /**************************************************************************************************
-* Function Name: app_bt_util_generate_bd_address
+* Function Name: app_bt_util_cycle_counter_init
 ***************************************************************************************************
 * Function Description:
-* @brief Function used to generate unique BD Address for the device
-*
-* @param device_addr: pointer to read device address structure
+* @brief Starts the DWT cycle counter read by APP_BT_UTIL_CYCLES(), when the core has one
 *
 * @return void
 */
-void app_bt_util_generate_bd_address(const uint8_t *device_addr)
+void app_bt_util_cycle_counter_init(void)
 {
-    printf("BD Address 0x%x%x%x%x%x%x%x%x\r\n",device_addr[0], device_addr[1],device_addr[2], device_addr[3],device_addr[4], device_addr[5],device_addr[6], device_addr[7]);
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 }
+
 /* [] END OF FILE */
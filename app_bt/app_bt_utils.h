@@ -44,11 +44,20 @@
 #include "wiced_bt_dev.h"
 #include "wiced_bt_ble.h"
 #include "wiced_bt_gatt.h"
+#include "cybsp.h"
 
 /*******************************************************************************
  * Macro Definitions
 *******************************************************************************/
 #define CASE_RETURN_STR(const)          case const: return #const;
+#define TABLE_ENTRY_STR(const)          [const] = #const,
+
+/* DWT cycle counter when the core has one, otherwise timing reads as zero */
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define APP_BT_UTIL_CYCLES()            (DWT->CYCCNT)
+#else
+#define APP_BT_UTIL_CYCLES()            (0UL)
+#endif
 
 /*******************************************************************************
  * Variable Definitions
@@ -67,7 +76,8 @@ void app_bt_util_print_bd_address(const wiced_bt_device_address_t bdadr);
 void app_bt_util_print_byte_array(void *to_print, uint16_t len);
 void app_bt_util_print_local_identity_key(char *st, wiced_bt_local_identity_keys_t *p_identity_key);
 void app_bt_util_print_link_key_data(wiced_bt_device_sec_keys_t *p_key);
-void app_bt_util_generate_bd_address(const uint8_t *device_addr);
+void app_bt_util_cycle_counter_init(void);
+void app_bt_util_generate_bd_address(const uint8_t *unique_id, uint8_t id_len, wiced_bt_device_address_t bd_addr);
 
 #endif      /* APP_BT_UTIS_H_ */
 
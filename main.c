@@ -56,6 +56,7 @@
 #include "cybsp_bt_config.h"
 #include "wiced_bt_trace.h"
 #include "pawr_app.h"
+#include "app_bt_event_handler.h"
 #ifdef ENABLE_BT_SPY_LOG
 #include "cybt_debug_uart.h"
 #else
@@ -116,6 +117,8 @@ int main()
     cybt_platform_set_trace_level(CYBT_TRACE_ID_STACK, CYBT_TRACE_ID_MAX);
     /* Configure platform specific settings for the BT device */
     cybt_platform_config_init(&cybsp_bt_platform_cfg);
+    /* Subscribe the event handlers before the stack can deliver events */
+    app_bt_event_handler_init();
     /* Register call back and configuration with stack */
     wiced_result = wiced_bt_stack_init(app_bt_management_callback, &wiced_bt_cfg_settings);
 
@@ -51,16 +51,61 @@
 #include "wiced_bt_cfg.h"
 #include "cybt_platform_trace.h"
 #include "pawr.h"
+#include "pawr_rsp_sched.h"
+#include "pawr_msg.h"
+#include "pawr_data_store.h"
+#include "pawr_prefetch.h"
+#include "pawr_packed.h"
+#include "pawr_filter.h"
+#include "pawr_link.h"
+#include "pawr_timesync.h"
+#include "pawr_cmd.h"
+#include "pawr_flow.h"
+#ifdef ENABLE_PAWR_CAPTURE
+#include "pawr_capture.h"
+#endif
+#ifdef ENABLE_PAWR_SECURITY
+#include "pawr_security.h"
+#endif
+#ifdef ENABLE_PAWR_COMPRESSION
+#include "pawr_compress.h"
+#endif
+#ifdef ENABLE_PAWR_OTA
+#include "pawr_ota.h"
+#endif
+#ifdef ENABLE_PAWR_FRAME
+#include "pawr_frame.h"
+#endif
+#ifdef ENABLE_PAWR_ROAM
+#include "pawr_roam.h"
+#endif
+#ifdef ENABLE_PAWR_DISCOVERY
+#include "pawr_discover.h"
+#endif
+#ifdef ENABLE_PAWR_SKIP
+#include "pawr_skip.h"
+#endif
+#ifdef ENABLE_PAWR_BACKLOG
+#include "pawr_backlog.h"
+#endif
 #ifdef ENABLE_BT_SPY_LOG
 #include "cybt_debug_uart.h"
 #else
 #include "cy_retarget_io.h"
 #endif
 #include "app_bt_utils.h"
+#include "app_bt_dispatch.h"
 
 /*******************************************************************************
 * Macro Definitions
 *******************************************************************************/
+#define PAWR_REL_MAX_SUBEVENTS          (PAWR_CFG_NUM_SUBEVENTS)   /* subevents tracked by the reliability layer */
+#define PAWR_REL_WINDOW                 (32)     /* msg_ids remembered behind the newest one */
+#define PAWR_REL_STALE_EVENTS           (256)    /* events of silence after which the window restarts */
+#define PAWR_CMD_TIMEOUT_MS             (1000)   /* controller command to its completion */
+#define PAWR_CANCEL_TIMEOUT_MS          (2000)   /* cancel to the cancelled sync established event */
+#define PAWR_RESCAN_BACKOFF_MS          (1000)   /* failed scan/sync setup to the next attempt */
+#define PAWR_SKIP_RESYNC_TIMEOUT_MS     (3000)   /* re-created sync for a new skip, else a sync loss */
 
 /*******************************************************************************
 * Variable Definitions
@@ -70,7 +115,39 @@ static uint8_t      pawr_central_address[BD_ADDR_LEN] = {0x00};
 pawr_se_rsp_cb_t    * pawr_se_rsp_cb                  = NULL;
 pawr_conn_up_cb_t   * pawr_conn_up_cb                 = NULL;
 pawr_conn_down_cb_t * pawr_conn_down_cb               = NULL;
-uint8_t             subevents[2]                      = {0, 1};
+uint8_t             subevents[PAWR_CFG_NUM_SUBEVENTS];
+
+/* Duplicate suppression state of one subevent. Bit n of window is set when msg_id last_id-n
+ * has been delivered. */
+typedef struct
+{
+    wiced_bool_t in_use;
+    uint8_t      subevent;
+    uint8_t      last_id;
+    wiced_bool_t ack_pending;
+    uint16_t     last_evt;
+    uint32_t     window;
+} pawr_rel_state_t;
+
+static pawr_rel_state_t pawr_rel_state[PAWR_REL_MAX_SUBEVENTS];
+static uint32_t         pawr_rel_delivered = 0;
+static uint32_t         pawr_rel_dup       = 0;
+static uint32_t         pawr_rel_old       = 0;
+static uint32_t         pawr_rel_acked     = 0;
+static uint32_t         pawr_rsp_no_room   = 0;   /* acks or flow fields a response left no room for */
+
+/* Report to first response latency, split by whether a prefetched response answered it. */
+typedef struct
+{
+    uint32_t count;
+    uint32_t cycles;
+    uint32_t cycles_max;
+} pawr_rsp_latency_t;
+
+static pawr_rsp_latency_t pawr_rsp_latency[2];
+static uint32_t           pawr_rpt_start      = 0;
+static wiced_bool_t       pawr_rpt_timing     = WICED_FALSE;
+static wiced_bool_t       pawr_rpt_prefetched = WICED_FALSE;
 
 wiced_ble_ext_scan_params_t scan_params =
 {
@@ -78,8 +155,8 @@ wiced_ble_ext_scan_params_t scan_params =
     .scanning_phys = WICED_BLE_EXT_ADV_PHY_1M_BIT,
     .scan_filter_policy = WICED_BLE_EXT_SCAN_BASIC_UNFILTERED_SP,
     .sp_1m.scan_type = BTM_BLE_SCAN_MODE_PASSIVE,
-    .sp_1m.scan_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_INTERVAL,
-    .sp_1m.scan_window = WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_WINDOW
+    .sp_1m.scan_interval = PAWR_CFG_SCAN_INTERVAL,
+    .sp_1m.scan_window = PAWR_CFG_SCAN_WINDOW
 };
 
 wiced_ble_ext_scan_enable_params_t scan_enable =
@@ -94,21 +171,177 @@ wiced_ble_padv_create_sync_params_t sync_par =
     .options = WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST,
     .adv_sid = EXT_ADV_SET_ID,
     .adv_addr_type = BLE_ADDR_PUBLIC,
-    .adv_addr = {0xC0, 0x01, 0x02, 0x03, 0x04, 0x05},
+    .adv_addr = {PAWR_CFG_CENTRAL_ADDR},
     .skip= 0,
     .sync_timeout = PERIODIC_ADV_EXPIRD_TIME,
     .sync_cte_type = 0,
 };
 
+/* A create sync is outstanding until the sync established event, whatever its status. */
+static wiced_bool_t  pawr_sync_pending = WICED_FALSE;
+static wiced_timer_t pawr_rescan_timer;
+
+/* The train synced to, and the skip of that sync. The skip only takes effect at create sync, so
+ * a new one re-creates the sync on the same train without telling the app. */
+static wiced_bt_ble_address_type_t pawr_train_addr_type = BLE_ADDR_PUBLIC;
+static wiced_bt_device_address_t   pawr_train_addr;
+static uint8_t                     pawr_train_sid       = 0;
+static uint16_t                    pawr_sync_skip       = 0;
+static wiced_bool_t                pawr_skip_resync     = WICED_FALSE;
+
+static wiced_bt_dev_status_t pawr_issue_scan_params(void);
+static wiced_bt_dev_status_t pawr_issue_scan_disable(void);
+static wiced_bt_dev_status_t pawr_issue_scan_enable(void);
+static wiced_bt_dev_status_t pawr_issue_create_sync(void);
+static wiced_bt_dev_status_t pawr_issue_cancel_sync(void);
+static wiced_bt_dev_status_t pawr_issue_set_subevents(void);
+static void pawr_inform_conn_down_app(void);
+
+/* Scan/sync setup steps, run in order by the command pipeline, see pawr_cmd.h. */
+static const pawr_cmd_t pawr_cmd_scan_params   = {"scan_params",   pawr_issue_scan_params,   PAWR_CMD_DONE_ON_STATUS, PAWR_CMD_TIMEOUT_MS,    0, PAWR_CMD_OP_SCAN_PARAMS};
+static const pawr_cmd_t pawr_cmd_scan_disable  = {"scan_disable",  pawr_issue_scan_disable,  PAWR_CMD_DONE_ON_STATUS, PAWR_CMD_TIMEOUT_MS,    1, PAWR_CMD_OP_SCAN_ENABLE};
+static const pawr_cmd_t pawr_cmd_create_sync   = {"create_sync",   pawr_issue_create_sync,   PAWR_CMD_DONE_ON_STATUS, PAWR_CMD_TIMEOUT_MS,    2, PAWR_CMD_OP_CREATE_SYNC};
+static const pawr_cmd_t pawr_cmd_scan_enable   = {"scan_enable",   pawr_issue_scan_enable,   PAWR_CMD_DONE_ON_STATUS, PAWR_CMD_TIMEOUT_MS,    3, PAWR_CMD_OP_SCAN_ENABLE};
+static const pawr_cmd_t pawr_cmd_cancel_sync   = {"cancel_sync",   pawr_issue_cancel_sync,   PAWR_CMD_DONE_ON_EVENT,  PAWR_CANCEL_TIMEOUT_MS, 4, PAWR_CMD_OP_CANCEL_SYNC};
+static const pawr_cmd_t pawr_cmd_set_subevents = {"set_subevents", pawr_issue_set_subevents, PAWR_CMD_DONE_ON_STATUS, PAWR_CMD_TIMEOUT_MS,    5, PAWR_CMD_OP_SYNC_SUBEVENT};
+
 /******************************************************************************
 * Function Definitions
 ******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_rel_find()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the reliability state of a subevent.
+* @param[in] subevent , PAwR subevent.
+* @param[in] create   , claim a free entry if the subevent is not tracked yet.
+* @return    pawr_rel_state_t* state, or NULL.
+**************************************************************************************************/
+static pawr_rel_state_t *pawr_rel_find(uint8_t subevent, wiced_bool_t create)
+{
+    pawr_rel_state_t *p_free = NULL;
+    uint8_t           i;
+
+    for (i = 0; i < PAWR_REL_MAX_SUBEVENTS; i++)
+    {
+        if (pawr_rel_state[i].in_use && (pawr_rel_state[i].subevent == subevent))
+        {
+            return &pawr_rel_state[i];
+        }
+        if (!pawr_rel_state[i].in_use && (p_free == NULL))
+        {
+            p_free = &pawr_rel_state[i];
+        }
+    }
+    if (create && (p_free != NULL))
+    {
+        memset(p_free, 0, sizeof(*p_free));
+        p_free->in_use   = WICED_TRUE;
+        p_free->subevent = subevent;
+        return p_free;
+    }
+    return NULL;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rel_accept()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function decides whether a reliable message is new. The msg_id is compared modulo 256
+* against the newest id seen in the subevent; older ids inside the window are looked up in the
+* bitmap. A window unused for PAWR_REL_STALE_EVENTS periodic events restarts, so a wrapped
+* periodic_evt_counter or msg_id cannot be mistaken for a retransmission. Every reliable message,
+* new or duplicate, schedules an acknowledgement.
+* @param[in] subevent    , PAwR subevent of the report.
+* @param[in] msg_id      , message id from the reliable header.
+* @param[in] evt_counter , periodic_evt_counter of the report.
+* @return    wiced_bool_t WICED_TRUE if the message must be delivered.
+**************************************************************************************************/
+static wiced_bool_t pawr_rel_accept(uint8_t subevent, uint8_t msg_id, uint16_t evt_counter)
+{
+    pawr_rel_state_t *st = pawr_rel_find(subevent, WICED_TRUE);
+    int8_t            diff;
+
+    if (st == NULL)
+    {
+        /* out of tracking entries, deliver rather than lose data */
+        pawr_rel_delivered++;
+        return WICED_TRUE;
+    }
+    st->ack_pending = WICED_TRUE;
+    if ((st->window == 0) || ((uint16_t)(evt_counter - st->last_evt) > PAWR_REL_STALE_EVENTS))
+    {
+        st->last_id  = msg_id;
+        st->window   = 1;
+        st->last_evt = evt_counter;
+        pawr_rel_delivered++;
+        return WICED_TRUE;
+    }
+    st->last_evt = evt_counter;
+    diff = (int8_t)(msg_id - st->last_id);
+    if (diff > 0)
+    {
+        st->window  = (diff >= PAWR_REL_WINDOW) ? 1 : ((st->window << diff) | 1);
+        st->last_id = msg_id;
+        pawr_rel_delivered++;
+        return WICED_TRUE;
+    }
+    if (-diff >= PAWR_REL_WINDOW)
+    {
+        pawr_rel_old++;
+        return WICED_FALSE;
+    }
+    if (st->window & (1UL << -diff))
+    {
+        pawr_rel_dup++;
+        return WICED_FALSE;
+    }
+    st->window |= (1UL << -diff);
+    pawr_rel_delivered++;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rel_ack_pending()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function tells whether an acknowledgement waits for a response in the subevent.
+* @param[in] subevent , PAwR subevent.
+* @return    wiced_bool_t WICED_TRUE if an acknowledgement is pending.
+**************************************************************************************************/
+static wiced_bool_t pawr_rel_ack_pending(uint8_t subevent)
+{
+    pawr_rel_state_t *st = pawr_rel_find(subevent, WICED_FALSE);
+
+    return ((st != NULL) && st->ack_pending) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rel_reset()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function forgets all msg_id windows, used when a new train is synchronized.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+static void pawr_rel_reset(void)
+{
+    memset(pawr_rel_state, 0, sizeof(pawr_rel_state));
+}
+
 /**************************************************************************************************
 * Function Name: pawr_snd_se_rsp_central()
 ***************************************************************************************************
 * Function Description:
 * @brief
-* This function send the subevent response data to central.
+* This function send the subevent response data to central. A pending acknowledgement for
+* req_subevent is prepended, see PAWR_MSG_TYPE_ACK, and the flow control field in front of that,
+* see pawr_flow.h. With ENABLE_PAWR_SECURITY the result is sealed into a PAWR_MSG_TYPE_SECURE
+* message.
 * @param[in] sync_handle  ,      handle for synchronized advertising train.
 * @param[in] subevent_num ,      PAwR response subevent.
 * @param[in] response_slot,      PAwR response slot.
@@ -125,13 +358,229 @@ wiced_bt_dev_status_t pawr_snd_se_rsp_central(uint16_t sync_handle,
                                               uint8_t *p_data)
 {
     wiced_ble_padv_subevent_rsp_data_t pawr_subevent_rsp_data;
+    wiced_bt_dev_status_t              status;
+    pawr_rel_state_t                   *st = pawr_rel_find(req_subevent, WICED_FALSE);
+    uint8_t                            rsp_buf[PAWR_FLOW_HDR_LEN + PAWR_ACK_HDR_LEN + PAWR_RSP_MAX_DATA_LEN];
+    uint8_t                            *p_ack = &rsp_buf[PAWR_FLOW_HDR_LEN];
+#ifdef ENABLE_PAWR_SECURITY
+    uint8_t                            sec_buf[PAWR_FLOW_HDR_LEN + PAWR_ACK_HDR_LEN + PAWR_RSP_MAX_DATA_LEN + PAWR_SEC_OVERHEAD];
+#endif
+
+    /* piggyback a pending acknowledgement when the response leaves room for it */
+    if ((st != NULL) && st->ack_pending && (rsp_data_len <= PAWR_RSP_MAX_DATA_LEN))
+    {
+        p_ack[0] = PAWR_MSG_TYPE_ACK;
+        p_ack[1] = st->last_id;
+        p_ack[2] = (uint8_t)(st->window >> 1);
+        if (rsp_data_len != 0)
+        {
+            memcpy(&p_ack[PAWR_ACK_HDR_LEN], p_data, rsp_data_len);
+        }
+        p_data        = p_ack;
+        rsp_data_len += PAWR_ACK_HDR_LEN;
+    }
+    else
+    {
+        if ((st != NULL) && st->ack_pending)
+        {
+            pawr_rsp_no_room++;
+        }
+        st = NULL;
+    }
+    /* the flow control field goes in front of all */
+    if (pawr_flow_get_field(rsp_buf) != 0)
+    {
+        if (rsp_data_len > PAWR_ACK_HDR_LEN + PAWR_RSP_MAX_DATA_LEN)
+        {
+            pawr_rsp_no_room++;
+        }
+        else
+        {
+            if ((p_data != p_ack) && (rsp_data_len != 0))
+            {
+                memcpy(p_ack, p_data, rsp_data_len);
+            }
+            p_data        = rsp_buf;
+            rsp_data_len += PAWR_FLOW_HDR_LEN;
+        }
+    }
+
+#ifdef ENABLE_PAWR_SECURITY
+    if (pawr_sec_is_active())
+    {
+        rsp_data_len = (uint8_t)pawr_sec_seal(p_data, rsp_data_len, evt_counter, rsp_subevent, rsp_slot,
+                                              sec_buf, sizeof(sec_buf));
+        if (rsp_data_len == 0)
+        {
+            return WICED_BT_BADARG;
+        }
+        p_data = sec_buf;
+    }
+#endif
+
     pawr_subevent_rsp_data.req_event    = evt_counter;
     pawr_subevent_rsp_data.req_subevent = req_subevent;
     pawr_subevent_rsp_data.rsp_subevent = rsp_subevent;
     pawr_subevent_rsp_data.rsp_slot     = rsp_slot;
     pawr_subevent_rsp_data.rsp_data_len = rsp_data_len;
     pawr_subevent_rsp_data.p_data       = p_data;
-    return wiced_ble_padv_set_subevent_rsp_data(sync_handle, &pawr_subevent_rsp_data);
+#ifdef ENABLE_PAWR_CAPTURE
+    if (pawr_cap_is_replaying())
+    {
+        /* replayed requests have no live train behind them */
+        status = WICED_SUCCESS;
+    }
+    else
+#endif
+    {
+        status = wiced_ble_padv_set_subevent_rsp_data(sync_handle, &pawr_subevent_rsp_data);
+    }
+#ifdef ENABLE_PAWR_CAPTURE
+    if (status == WICED_SUCCESS)
+    {
+        pawr_cap_record_rsp(&pawr_subevent_rsp_data);
+    }
+#endif
+    if ((status == WICED_SUCCESS) && pawr_rpt_timing)
+    {
+        pawr_rsp_latency_t *lat    = &pawr_rsp_latency[pawr_rpt_prefetched ? 1 : 0];
+        uint32_t            cycles = APP_BT_UTIL_CYCLES() - pawr_rpt_start;
+
+        lat->count++;
+        lat->cycles += cycles;
+        if (cycles > lat->cycles_max)
+        {
+            lat->cycles_max = cycles;
+        }
+        pawr_rpt_timing = WICED_FALSE;
+    }
+    if ((status == WICED_SUCCESS) && (st != NULL))
+    {
+        st->ack_pending = WICED_FALSE;
+        pawr_rel_acked++;
+    }
+    return status;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_issue_scan_params()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the extended scan parameters.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_issue_scan_params(void)
+{
+    return wiced_ble_ext_scan_set_params(&scan_params);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_issue_scan_disable()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function disables extended scan.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_issue_scan_disable(void)
+{
+    return wiced_ble_ext_scan_enable(0, &scan_enable);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_issue_scan_enable()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function enables extended scan.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_issue_scan_enable(void)
+{
+    return wiced_ble_ext_scan_enable(1, &scan_enable);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_issue_create_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts synchronizing to the central's periodic advertising.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_issue_create_sync(void)
+{
+    wiced_bt_dev_status_t status = wiced_ble_padv_create_sync(&sync_par);
+
+    pawr_sync_skip    = sync_par.skip;
+
+    pawr_sync_pending = (status == WICED_BT_SUCCESS) || (status == WICED_BT_PENDING);
+    return status;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_issue_cancel_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function cancels the outstanding create sync. It is complete when the sync established
+* event reports the cancellation.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_issue_cancel_sync(void)
+{
+    return wiced_ble_padv_cancel_sync();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_issue_set_subevents()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function selects the subevents the peripheral listens to.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_issue_set_subevents(void)
+{
+    return wiced_ble_padv_set_sync_subevent(pawr_conn_handle, 0, sizeof(subevents), subevents);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prepare_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the create sync parameters: the current train when only the skip changes,
+* a known central from roaming, else the central found by the discovery mode, else the
+* configured central.
+* @param[in] void.
+* @return    wiced_bool_t WICED_FALSE while a discovery runs, the scan then goes without a sync.
+**************************************************************************************************/
+static wiced_bool_t pawr_prepare_sync(void)
+{
+    sync_par.options       = WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST;
+    sync_par.adv_addr_type = BLE_ADDR_PUBLIC;
+    sync_par.adv_sid       = EXT_ADV_SET_ID;
+    memcpy(sync_par.adv_addr, pawr_central_address, BD_ADDR_LEN);
+    if (pawr_skip_resync)
+    {
+        sync_par.adv_addr_type = pawr_train_addr_type;
+        sync_par.adv_sid       = pawr_train_sid;
+        memcpy(sync_par.adv_addr, pawr_train_addr, BD_ADDR_LEN);
+        return WICED_TRUE;
+    }
+#ifdef ENABLE_PAWR_ROAM
+    if (pawr_roam_prepare_sync(&sync_par))
+    {
+        return WICED_TRUE;
+    }
+#endif
+#ifdef ENABLE_PAWR_DISCOVERY
+    return pawr_disc_prepare_sync(&sync_par);
+#else
+    return WICED_TRUE;
+#endif
 }
 
 /**************************************************************************************************
@@ -139,50 +588,75 @@ wiced_bt_dev_status_t pawr_snd_se_rsp_central(uint16_t sync_handle,
 ***************************************************************************************************
 * Function Description:
 * @brief
-* This function scan for a PAwR network.
+* This function scan for a PAwR network. The setup steps go through the command pipeline and
+* replace any setup still queued; a create sync still outstanding is cancelled first.
 * @param[in] void.
 * @return    void.
 **************************************************************************************************/
 void pawr_scan_for_pawr_network(void)
 {
-    wiced_bt_dev_status_t           status = WICED_BT_ERROR;
-
-    /* set extended scan parameters */
-    status = wiced_ble_ext_scan_set_params(&scan_params);
-    if (WICED_SUCCESS != status)
+    if (!pawr_skip_resync && wiced_is_timer_in_use(&pawr_rescan_timer))
     {
-        printf("Error setting extended scan parameters: %d\n", status);
-        return;
+        wiced_stop_timer(&pawr_rescan_timer);
     }
-
-    /* Disable extended scan */
-    status = wiced_ble_ext_scan_enable(0, &scan_enable);
-    if (WICED_SUCCESS != status)
+    pawr_cmd_supersede();
+    if (pawr_sync_pending && (pawr_cmd_in_flight() != &pawr_cmd_cancel_sync))
     {
-        printf("Error disabling extended scan: %d\n", status);
-        return;
+        pawr_cmd_submit(&pawr_cmd_cancel_sync);
     }
 
-    memcpy(sync_par.adv_addr, pawr_central_address, BD_ADDR_LEN);
-
-    status = wiced_ble_padv_create_sync(&sync_par);
-    if (WICED_SUCCESS != status)
+    /* the parameters cannot change while scanning */
+    pawr_cmd_submit(&pawr_cmd_scan_disable);
+    pawr_cmd_submit(&pawr_cmd_scan_params);
+    if (pawr_prepare_sync())
     {
-        printf("Error create_sync: %d\n", status);
+        pawr_cmd_submit(&pawr_cmd_create_sync);
     }
+    pawr_cmd_submit(&pawr_cmd_scan_enable);
 
     printf("pawr_scan_for_pawr_network:addr: ");
-    app_bt_util_print_bd_address(pawr_central_address);
+    app_bt_util_print_bd_address(sync_par.adv_addr);
+    printf("pawr start\n");
+}
+
+/**************************************************************************************************
+* Function Name: pawr_scan_enable()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function turns extended scan on or off with the parameters of the last scan, for
+* example to hear other centrals while synced.
+* @param[in] enable , scan on.
+* @return    void.
+**************************************************************************************************/
+void pawr_scan_enable(wiced_bool_t enable)
+{
+    pawr_cmd_submit(enable ? &pawr_cmd_scan_enable : &pawr_cmd_scan_disable);
+}
 
-    /* set extended scan enable */
-    status = wiced_ble_ext_scan_enable(1, &scan_enable);
-    if (WICED_SUCCESS != status)
+/**************************************************************************************************
+* Function Name: pawr_rescan_timer_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function retries the scan/sync setup after a failed attempt.
+* @param[in] cb_params , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_rescan_timer_cb(WICED_TIMER_PARAM_TYPE cb_params)
+{
+    if (pawr_skip_resync)
     {
-        printf("Error starting extended scan: %d\n", status);
+        /* the train was not found again, a sync loss after all */
+        printf("pawr skip resync timeout\n");
+        pawr_skip_resync = WICED_FALSE;
+        pawr_inform_conn_down_app();
         return;
     }
-
-    printf("pawr start\n");
+    if (pawr_conn_handle == 0xFFFF)
+    {
+        pawr_scan_for_pawr_network();
+    }
 }
 
 /**************************************************************************************************
@@ -208,7 +682,8 @@ void pawr_reg_se_rsp_cb(pawr_se_rsp_cb_t *callback)
 ***************************************************************************************************
 * Function Description:
 * @brief
-* This function inform the PAwR sub event indication report to app.
+* This function inform the PAwR sub event indication report to app. Messages the PAwR layer
+* handles itself, selected by the first payload byte, are consumed here.
 * @param[in] sync_handle  ,  Handle for synchronized advertising train.
 * @param[in] p_msg        ,  Pointer to PAwR sub event indication report payload.
 * @param[in] msg_len      ,  Length of PAwR sub event indication report.
@@ -218,6 +693,78 @@ void pawr_reg_se_rsp_cb(pawr_se_rsp_cb_t *callback)
 */
 static void pawr_inform_se_ind_rcv_app(uint16_t sync_handle,uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num, uint16_t evt_counter)
 {
+    const uint8_t *p_rec;
+
+#ifdef ENABLE_PAWR_SECURITY
+    static uint8_t sec_plain[PAWR_SEC_MAX_MSG_LEN];
+
+    /* once a key is in place only authenticated messages reach the handlers below */
+    if (pawr_sec_is_active())
+    {
+        if ((p_msg[0] != PAWR_MSG_TYPE_SECURE) || (msg_len > PAWR_SEC_MAX_MSG_LEN))
+        {
+            return;
+        }
+        msg_len = pawr_sec_open(p_msg, msg_len, evt_counter, subevent_num, sec_plain);
+        if (msg_len == 0)
+        {
+            return;
+        }
+        p_msg = sec_plain;
+    }
+#endif
+    if (p_msg[0] == PAWR_MSG_TYPE_RELIABLE)
+    {
+        if ((msg_len <= PAWR_REL_HDR_LEN) || (p_msg[PAWR_REL_HDR_LEN] == PAWR_MSG_TYPE_RELIABLE))
+        {
+            return;
+        }
+        if (!pawr_rel_accept(subevent_num, p_msg[1], evt_counter))
+        {
+            return;
+        }
+        p_msg   += PAWR_REL_HDR_LEN;
+        msg_len -= PAWR_REL_HDR_LEN;
+    }
+    /* of a dense report only this device's record goes on, as a message of its own */
+    if (p_msg[0] == PAWR_MSG_TYPE_PACKED)
+    {
+        msg_len = pawr_packed_find(p_msg, msg_len, &p_rec);
+        if ((msg_len == 0) || (p_rec[0] == PAWR_MSG_TYPE_PACKED) || (p_rec[0] == PAWR_MSG_TYPE_RELIABLE))
+        {
+            return;
+        }
+        p_msg = (uint8_t *)p_rec;
+    }
+
+    /* a response staged ahead of time goes out before the app handler runs */
+    if (pawr_prefetch_submit(subevent_num, evt_counter, p_msg, msg_len))
+    {
+        pawr_rpt_prefetched = WICED_TRUE;
+        pawr_rsp_sched_service(sync_handle, evt_counter, subevent_num);
+    }
+
+    switch (p_msg[0])
+    {
+        case PAWR_MSG_TYPE_DS_DELTA:
+            pawr_ds_apply(p_msg, msg_len);
+        return;
+#ifdef ENABLE_PAWR_OTA
+        case PAWR_MSG_TYPE_OTA:
+            pawr_ota_on_msg(subevent_num, evt_counter, p_msg, msg_len);
+        return;
+#endif
+#ifdef ENABLE_PAWR_FRAME
+        case PAWR_MSG_TYPE_FRAME:
+            pawr_frame_on_msg(subevent_num, p_msg, msg_len);
+        return;
+#endif
+        case PAWR_MSG_TYPE_FLOW:
+            pawr_flow_on_msg(p_msg, msg_len);
+        return;
+        default:
+        break;
+    }
     if (pawr_se_rsp_cb)
     {
         pawr_se_rsp_cb(sync_handle,p_msg,msg_len,subevent_num,evt_counter);
@@ -255,14 +802,56 @@ static void pawr_inform_conn_down_app(void)
 {
     printf("pawr conn down\n");
     /* Disconnect the sync handle, and start scanning for sync again. */
-    wiced_ble_padv_terminate_sync(pawr_conn_handle);
+    if (pawr_conn_handle != 0xFFFF)
+    {
+        wiced_ble_padv_terminate_sync(pawr_conn_handle);
+    }
     pawr_conn_handle = 0xFFFF;
+    /* A new sync, possibly on another train after roaming, starts by receiving every event. */
+    sync_par.skip = 0;
+#ifdef ENABLE_PAWR_ROAM
+    pawr_roam_on_sync_lost();
+#endif
+#ifdef ENABLE_PAWR_SKIP
+    pawr_skip_on_sync_lost();
+#endif
+#ifdef ENABLE_PAWR_BACKLOG
+    pawr_backlog_on_sync_lost();
+#endif
+    pawr_flow_on_sync_lost();
     if (pawr_conn_down_cb)
     {
         pawr_conn_down_cb();
     }
 }
 
+/**************************************************************************************************
+* Function Name: pawr_resync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function drops the sync on purpose, for example to move to another central. The app
+* sees a sync loss and scans again.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_resync(void)
+{
+    if ((pawr_conn_handle != 0xFFFF) || pawr_skip_resync)
+    {
+        if (pawr_skip_resync)
+        {
+            wiced_stop_timer(&pawr_rescan_timer);
+            pawr_skip_resync = WICED_FALSE;
+        }
+        pawr_inform_conn_down_app();
+    }
+    else
+    {
+        pawr_scan_for_pawr_network();
+    }
+}
+
 /**************************************************************************************************
 * Function Name: pawr_reg_conn_up_cb()
 ***************************************************************************************************
@@ -293,56 +882,328 @@ void pawr_reg_conn_up_cb(pawr_conn_up_cb_t *callback)
 static void pawr_inform_conn_up_app(wiced_ble_padv_sync_established_event_data_t *ps)
 {
     /* save the sync handle */
-    pawr_conn_handle = ps->sync_handle;
-    wiced_ble_padv_set_sync_subevent(pawr_conn_handle, 0, sizeof(subevents), subevents);
+    pawr_conn_handle     = ps->sync_handle;
+    pawr_train_addr_type = ps->adv_addr_type;
+    pawr_train_sid       = ps->adv_sid;
+    memcpy(pawr_train_addr, ps->adv_addr, BD_ADDR_LEN);
+    pawr_cmd_submit(&pawr_cmd_set_subevents);
 
     /* stop scanning */
-    wiced_ble_ext_scan_enable(0, &scan_enable);
+    pawr_cmd_submit(&pawr_cmd_scan_disable);
+#ifdef ENABLE_PAWR_SKIP
+    pawr_skip_on_sync(ps);
+#endif
+    pawr_rsp_sched_reset_timebase();
+    pawr_rel_reset();
+    pawr_prefetch_reset();
+    pawr_link_reset();
+    pawr_link_set_skip(pawr_sync_skip);
+    pawr_ts_on_sync(ps->periodic_adv_int, ps->subevent_interval);
+    pawr_flow_on_sync(ps);
+#ifdef ENABLE_PAWR_SECURITY
+    pawr_sec_on_sync(ps->adv_addr);
+#endif
+#ifdef ENABLE_PAWR_BACKLOG
+    pawr_backlog_on_sync();
+#endif
     if (pawr_conn_up_cb)
     {
         pawr_conn_up_cb(ps);
     }
 }
 
+/**************************************************************************************************
+* Function Name: pawr_process_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function handles one periodic advertising report: the payload goes to the PAwR layer
+* handlers or the app, then the response slots of the subevent are filled.
+* @param[in] p_report, periodic advertising report.
+* @return    void.
+**************************************************************************************************/
+static void pawr_process_report(wiced_ble_padv_report_event_data_t *p_report)
+{
+    /* arrival time first, before any handler adds to it */
+    pawr_ts_on_report(p_report->periodic_evt_counter, p_report->sub_event, p_report->data_status);
+    /* empty and incomplete reports still tell how the link is doing */
+    pawr_link_on_report(p_report->sub_event, p_report->periodic_evt_counter, p_report->rssi, p_report->data_status);
+#ifdef ENABLE_PAWR_SKIP
+    pawr_skip_on_report(p_report->periodic_evt_counter, (p_report->data_length != 0), pawr_filter_take_wake());
+#endif
+#ifdef ENABLE_PAWR_FRAME
+    /* a frame the decoder task finished is handed to the app from the stack context */
+    pawr_frame_poll();
+#endif
+    if (p_report->data_length == 0)
+    {
+#ifdef ENABLE_PAWR_BACKLOG
+        /* an empty but complete subevent still has response slots for the backlog */
+        if ((p_report->data_status == 0) && (pawr_backlog_drain(p_report->sub_event) != 0))
+        {
+            pawr_flow_update(p_report->periodic_evt_counter);
+            pawr_rsp_sched_service(p_report->sync_handle, p_report->periodic_evt_counter, p_report->sub_event);
+        }
+#endif
+        return;
+    }
+    pawr_rpt_start      = APP_BT_UTIL_CYCLES();
+    pawr_rpt_timing     = WICED_TRUE;
+    pawr_rpt_prefetched = WICED_FALSE;
+    pawr_inform_se_ind_rcv_app(p_report->sync_handle,
+                               p_report->p_data,
+                               p_report->data_length,
+                               p_report->sub_event,
+                               p_report->periodic_evt_counter);
+#ifdef ENABLE_PAWR_BACKLOG
+    /* backlog records take the slots the responses of the handlers left */
+    pawr_backlog_drain(p_report->sub_event);
+#endif
+    pawr_flow_update(p_report->periodic_evt_counter);
+    if ((pawr_rsp_sched_service(p_report->sync_handle, p_report->periodic_evt_counter, p_report->sub_event) == 0) &&
+        pawr_rel_ack_pending(p_report->sub_event) && (pawr_rsp_sched_num_slots(p_report->sub_event) != 0))
+    {
+        /* nothing to piggyback on, send the acknowledgement alone; without a slot here it would
+         * only sit in the CONTROL queue until it expired */
+        pawr_rsp_sched_submit(PAWR_RSP_PRIO_CONTROL, p_report->sub_event, NULL, 0);
+        pawr_rsp_sched_service(p_report->sync_handle, p_report->periodic_evt_counter, p_report->sub_event);
+    }
+    pawr_rpt_timing = WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_on_sync_lost()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the dispatch handler of WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT.
+* @param[in] event       , The extended adv event code.
+* @param[in] p_event_data, Event data refer to wiced_ble_ext_adv_event_data_t.
+* @return    wiced_result_t WICED_BT_SUCCESS.
+**************************************************************************************************/
+static wiced_result_t pawr_on_sync_lost(uint32_t event, void *p_event_data)
+{
+    pawr_inform_conn_down_app();
+    return WICED_BT_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_resync_start()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function re-creates the sync on the same train so that a new skip takes effect. The app
+* is not told; a train that does not come back within PAWR_SKIP_RESYNC_TIMEOUT_MS is a sync
+* loss.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+static void pawr_skip_resync_start(void)
+{
+    printf("pawr skip:%d\n", sync_par.skip);
+    pawr_skip_resync = WICED_TRUE;
+    wiced_ble_padv_terminate_sync(pawr_conn_handle);
+    pawr_conn_handle = 0xFFFF;
+    if (wiced_is_timer_in_use(&pawr_rescan_timer))
+    {
+        wiced_stop_timer(&pawr_rescan_timer);
+    }
+    pawr_scan_for_pawr_network();
+    wiced_start_timer(&pawr_rescan_timer, PAWR_SKIP_RESYNC_TIMEOUT_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_resync_done()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function resumes on the re-created sync. The layer state carries on as the train is the
+* same; a skip changed meanwhile starts the next re-create.
+* @param[in] ps , sync established event data.
+* @return    void.
+**************************************************************************************************/
+static void pawr_skip_resync_done(wiced_ble_padv_sync_established_event_data_t *ps)
+{
+    wiced_stop_timer(&pawr_rescan_timer);
+    pawr_skip_resync = WICED_FALSE;
+    pawr_conn_handle = ps->sync_handle;
+    pawr_cmd_submit(&pawr_cmd_set_subevents);
+    pawr_cmd_submit(&pawr_cmd_scan_disable);
+    pawr_link_set_skip(pawr_sync_skip);
+#ifdef ENABLE_PAWR_SKIP
+    pawr_skip_on_sync(ps);
+#endif
+    if (sync_par.skip != pawr_sync_skip)
+    {
+        pawr_skip_resync_start();
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_set_skip()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the number of periodic events the controller may skip. While synced, the
+* sync is re-created on the same train for it.
+* @param[in] skip , periodic events to skip, 0 to receive every one.
+* @return    void.
+**************************************************************************************************/
+void pawr_set_skip(uint16_t skip)
+{
+    sync_par.skip = skip;
+    if ((pawr_conn_handle == 0xFFFF) || (skip == pawr_sync_skip))
+    {
+        /* the next create sync takes it, or a re-create in progress checks it when done */
+        return;
+    }
+    pawr_skip_resync_start();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_on_sync_established()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the dispatch handler of WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT.
+* @param[in] event       , The extended adv event code.
+* @param[in] p_event_data, Event data refer to wiced_ble_ext_adv_event_data_t.
+* @return    wiced_result_t WICED_BT_SUCCESS.
+**************************************************************************************************/
+static wiced_result_t pawr_on_sync_established(uint32_t event, void *p_event_data)
+{
+    wiced_ble_padv_sync_established_event_data_t *ps         = &((wiced_ble_ext_adv_event_data_t *)p_event_data)->sync_establish;
+    wiced_bool_t                                  cancelling = (pawr_cmd_in_flight() == &pawr_cmd_cancel_sync);
+
+    /* the create sync is over either way; a cancel in flight is complete */
+    pawr_sync_pending = WICED_FALSE;
+    pawr_cmd_on_event(WICED_TRUE);
+    if (ps->status != WICED_BT_SUCCESS)
+    {
+        if (cancelling)
+        {
+            return WICED_BT_SUCCESS;
+        }
+        printf("pawr sync failed: %d\n", ps->status);
+        if (pawr_skip_resync)
+        {
+            /* the train did not come back, a sync loss after all */
+            wiced_stop_timer(&pawr_rescan_timer);
+            pawr_skip_resync = WICED_FALSE;
+            pawr_inform_conn_down_app();
+        }
+        else
+        {
+            pawr_scan_for_pawr_network();
+        }
+        return WICED_BT_SUCCESS;
+    }
+
+    /* synced before a cancel took effect, the resync queued behind it is not needed */
+    pawr_cmd_supersede();
+    if (pawr_skip_resync)
+    {
+        pawr_skip_resync_done(ps);
+        return WICED_BT_SUCCESS;
+    }
+#ifdef ENABLE_PAWR_DISCOVERY
+    pawr_disc_on_sync(ps);
+#endif
+#ifdef ENABLE_PAWR_ROAM
+    pawr_roam_on_sync(ps);
+#endif
+    pawr_inform_conn_up_app(ps);
+    return WICED_BT_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_on_cmd_fail()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function recovers from a failed scan/sync setup step: unsynced, the setup restarts after
+* a backoff; synced without subevents, the sync is dropped the same way as a sync loss.
+* @param[in] p_cmd  , failed command.
+* @param[in] status , error status.
+* @return    void.
+**************************************************************************************************/
+static void pawr_on_cmd_fail(const pawr_cmd_t *p_cmd, wiced_bt_dev_status_t status)
+{
+    if (p_cmd == &pawr_cmd_cancel_sync)
+    {
+        /* nothing left to cancel */
+        pawr_sync_pending = WICED_FALSE;
+    }
+    if (pawr_conn_handle != 0xFFFF)
+    {
+        if (p_cmd == &pawr_cmd_set_subevents)
+        {
+            pawr_inform_conn_down_app();
+        }
+        return;
+    }
+    if (!wiced_is_timer_in_use(&pawr_rescan_timer))
+    {
+        wiced_start_timer(&pawr_rescan_timer, PAWR_RESCAN_BACKOFF_MS);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_on_periodic_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the dispatch handler of WICED_BLE_PERIODIC_ADV_REPORT_EVENT.
+* @param[in] event       , The extended adv event code.
+* @param[in] p_event_data, Event data refer to wiced_ble_ext_adv_event_data_t.
+* @return    wiced_result_t WICED_BT_SUCCESS.
+**************************************************************************************************/
+static wiced_result_t pawr_on_periodic_report(uint32_t event, void *p_event_data)
+{
+    pawr_process_report(&((wiced_ble_ext_adv_event_data_t *)p_event_data)->periodic_adv_report);
+    return WICED_BT_SUCCESS;
+}
+
 /**************************************************************************************************
 * Function Name: pawr_ext_adv_callback()
 ***************************************************************************************************
 * Function Description:
 * @brief
-* This function process Extended ADV events.
+* This function process Extended ADV events through the event dispatch table. Addressed
+* messages for other devices are emptied first, see pawr_filter.h.
 * @param[in] event , The extended adv event code.
 * @param[in] p_data, Event data refer to wiced_ble_ext_adv_event_data_t.
 * @return    void.
 **************************************************************************************************/
 static void pawr_ext_adv_callback(wiced_ble_ext_adv_event_t event, wiced_ble_ext_adv_event_data_t *p_data)
 {
-    switch (event)
+    wiced_ble_ext_adv_event_data_t report;
+
+    /* the stack's event stays untouched; capture and replay see the report as the handlers do */
+    if ((event == WICED_BLE_PERIODIC_ADV_REPORT_EVENT) && (p_data->periodic_adv_report.data_length != 0))
     {
-        case WICED_BT_BLE_PAWR_SUBEVENT_DATA_REQ_EVENT:
-            printf("central sub event data ind\n");
-        break;
-        case WICED_BT_BLE_PAWR_RSP_REPORT_EVENT:
-            printf("central sub event received data ind response report from peripheral\n");
-        break;
-        case WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT:
-            pawr_inform_conn_down_app();
-        break;
-        case WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT:
-            pawr_inform_conn_up_app(&p_data->sync_establish);
-        break;
-        case WICED_BLE_PERIODIC_ADV_REPORT_EVENT:
-            if (p_data->periodic_adv_report.data_length != 0)
-            {
-                pawr_inform_se_ind_rcv_app(p_data->periodic_adv_report.sync_handle,
-                                           p_data->periodic_adv_report.p_data,
-                                           p_data->periodic_adv_report.data_length,
-                                           p_data->periodic_adv_report.sub_event,
-                                           p_data->periodic_adv_report.periodic_evt_counter);
-            }
-        break;
-        default:
-        break;
+        report.periodic_adv_report = p_data->periodic_adv_report;
+        pawr_filter_report(&report.periodic_adv_report);
+        p_data = &report;
     }
+#ifdef ENABLE_PAWR_CAPTURE
+    pawr_cap_record_event(event, p_data);
+#endif
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_ADV, (uint32_t)event, p_data);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ext_scan_callback()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function passes extended advertising reports to the event dispatch table.
+* @param[in] p_result , extended advertising report.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ext_scan_callback(wiced_ble_ext_scan_results_t *p_result)
+{
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, p_result);
 }
 
 /**************************************************************************************************
@@ -361,6 +1222,64 @@ void pawr_set_central_addr(const uint8_t *addr)
     app_bt_util_print_bd_address(pawr_central_address);
 }
 
+/**************************************************************************************************
+* Function Name: pawr_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the PAwR layer statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_print_stats(void)
+{
+    printf("pawr rel: delivered:%lu, dup:%lu, old:%lu, acked:%lu, no room:%lu\n",
+           (unsigned long)pawr_rel_delivered,
+           (unsigned long)pawr_rel_dup,
+           (unsigned long)pawr_rel_old,
+           (unsigned long)pawr_rel_acked,
+           (unsigned long)pawr_rsp_no_room);
+    printf("pawr rsp latency: prefetch cnt:%lu avg:%lu max:%lu, callback cnt:%lu avg:%lu max:%lu cycles\n",
+           (unsigned long)pawr_rsp_latency[1].count,
+           (unsigned long)((pawr_rsp_latency[1].count != 0) ? (pawr_rsp_latency[1].cycles / pawr_rsp_latency[1].count) : 0),
+           (unsigned long)pawr_rsp_latency[1].cycles_max,
+           (unsigned long)pawr_rsp_latency[0].count,
+           (unsigned long)((pawr_rsp_latency[0].count != 0) ? (pawr_rsp_latency[0].cycles / pawr_rsp_latency[0].count) : 0),
+           (unsigned long)pawr_rsp_latency[0].cycles_max);
+    pawr_rsp_sched_print_stats();
+    pawr_prefetch_print_stats();
+    pawr_link_print_stats();
+    pawr_ts_print_stats();
+    pawr_cmd_print_stats();
+    pawr_flow_print_stats();
+    pawr_packed_print_stats();
+    pawr_filter_print_stats();
+#ifdef ENABLE_PAWR_SECURITY
+    pawr_sec_print_stats();
+#endif
+#ifdef ENABLE_PAWR_COMPRESSION
+    pawr_cmp_print_stats();
+#endif
+#ifdef ENABLE_PAWR_OTA
+    pawr_ota_print_stats();
+#endif
+#ifdef ENABLE_PAWR_FRAME
+    pawr_frame_print_stats();
+#endif
+#ifdef ENABLE_PAWR_ROAM
+    pawr_roam_print_stats();
+#endif
+#ifdef ENABLE_PAWR_DISCOVERY
+    pawr_disc_print_stats();
+#endif
+#ifdef ENABLE_PAWR_SKIP
+    pawr_skip_print_stats();
+#endif
+#ifdef ENABLE_PAWR_BACKLOG
+    pawr_backlog_print_stats();
+#endif
+}
+
 /**************************************************************************************************
 * Function Name: pawr_init()
 ***************************************************************************************************
@@ -372,8 +1291,52 @@ void pawr_set_central_addr(const uint8_t *addr)
 **************************************************************************************************/
 void pawr_init(void)
 {
+    uint8_t i;
+
+    for (i = 0; i < PAWR_CFG_NUM_SUBEVENTS; i++)
+    {
+        subevents[i] = (uint8_t)(PAWR_CFG_FIRST_SUBEVENT + i);
+    }
     wiced_bt_ble_observe(WICED_FALSE, 0, NULL);
+    pawr_rsp_sched_init();
+    pawr_ds_init();
+    pawr_prefetch_init();
+    pawr_link_init();
+    pawr_ts_init();
+    pawr_flow_init();
+    app_bt_util_cycle_counter_init();
+#ifdef ENABLE_PAWR_SECURITY
+    pawr_sec_init();
+#endif
+#ifdef ENABLE_PAWR_COMPRESSION
+    pawr_cmp_init();
+#endif
+#ifdef ENABLE_PAWR_CAPTURE
+    pawr_cap_init();
+    pawr_cap_enable(WICED_TRUE);
+#endif
+#ifdef ENABLE_PAWR_OTA
+    pawr_ota_init();
+#endif
+#ifdef ENABLE_PAWR_FRAME
+    pawr_frame_init();
+#endif
+#ifdef ENABLE_PAWR_ROAM
+    pawr_roam_init();
+#endif
+#ifdef ENABLE_PAWR_DISCOVERY
+    pawr_disc_init();
+#endif
+#ifdef ENABLE_PAWR_BACKLOG
+    pawr_backlog_init();
+#endif
+    pawr_cmd_init(pawr_on_cmd_fail);
+    wiced_init_timer(&pawr_rescan_timer, pawr_rescan_timer_cb, 0, WICED_MILLI_SECONDS_TIMER);
+    app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT, pawr_on_sync_lost);
+    app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT, pawr_on_sync_established);
+    app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, WICED_BLE_PERIODIC_ADV_REPORT_EVENT, pawr_on_periodic_report);
     wiced_ble_ext_adv_register_cback(pawr_ext_adv_callback);
+    wiced_ble_ext_scan_register_cb(pawr_ext_scan_callback);
     pawr_scan_for_pawr_network();
 }
 
@@ -42,12 +42,14 @@
 * Header Files
 *******************************************************************************/
 #include "wiced_bt_ble.h"
+#include "pawr_config.h"
 
 /*******************************************************************************
 * Macro Definitions
 *******************************************************************************/
-#define EXT_ADV_SET_ID                  (0x00)   /* extended adv set id */
-#define PERIODIC_ADV_EXPIRD_TIME        (1000)   /* 10 second 1000*10ms */
+#define EXT_ADV_SET_ID                  (PAWR_CFG_EXT_ADV_SET_ID)
+#define PERIODIC_ADV_EXPIRD_TIME        (PAWR_CFG_SYNC_TIMEOUT)
+#define PAWR_RSP_MAX_DATA_LEN           (PAWR_CFG_RSP_MAX_DATA_LEN)
 
 /*******************************************************************************
  * Variable Definitions
@@ -65,6 +67,10 @@ void pawr_reg_conn_down_cb(pawr_conn_down_cb_t *callback);
 wiced_bt_dev_status_t pawr_snd_se_rsp_central(uint16_t sync_handle,uint16_t evt_counter,uint8_t req_subevent,uint8_t rsp_subevent,uint8_t rsp_slot,uint8_t rsp_data_len,uint8_t *p_data);
 void pawr_set_central_addr(const uint8_t *addr);
 void pawr_scan_for_pawr_network(void);
+void pawr_scan_enable(wiced_bool_t enable);
+void pawr_resync(void);
+void pawr_set_skip(uint16_t skip);
+void pawr_print_stats(void);
 void pawr_init(void);
 #endif /* PAWR_H_ */
 
@@ -41,6 +41,7 @@
 *******************************************************************************/
 #include <string.h>
 #include <FreeRTOS.h>
+#include <task.h>
 #include <string.h>
 #include "cybsp.h"
 #include "cyhal.h"
@@ -58,6 +59,29 @@
 #include "wiced_bt_dev.h"
 #include "pawr.h"
 #include "pawr_app.h"
+#include "pawr_rsp_sched.h"
+#include "pawr_data_store.h"
+#include "pawr_identity.h"
+#include "pawr_link.h"
+#include "pawr_msg.h"
+#include "pawr_esl.h"
+#include "pawr_packed.h"
+#include "pawr_filter.h"
+#ifdef ENABLE_PAWR_SECURITY
+#include "pawr_security.h"
+#endif
+#ifdef ENABLE_PAWR_OTA
+#include "pawr_ota.h"
+#endif
+#ifdef ENABLE_PAWR_FRAME
+#include "pawr_frame.h"
+#endif
+#ifdef ENABLE_PAWR_ROAM
+#include "pawr_roam.h"
+#endif
+#ifdef ENABLE_PAWR_BACKLOG
+#include "pawr_backlog.h"
+#endif
 #ifdef ENABLE_BT_SPY_LOG
 #include "cybt_debug_uart.h"
 #else
@@ -74,16 +98,43 @@
 /*******************************************************************************
 * Macro Definitions
 *******************************************************************************/
+#define PAWR_APP_SAMPLE_MS             (1000)   /* sensor sample period of the backlog demo */
 
 /*******************************************************************************
 * Variable Definitions
 *******************************************************************************/
 extern const char brcm_patch_version[];
 static const char pawr_version[]                        = {"[1.00]"};
-static uint8_t app_central_address[BD_ADDR_LEN]         = {0xc0,0x01,0x02,0x03,0x04,0x05};
-static uint8_t app_peripheral_address[BD_ADDR_LEN]      = {0xc0,0x00,0x00,0x01,0x00,PAWR_PERIPHERAL_RSP_SLOT};
+static uint8_t app_central_address[BD_ADDR_LEN]         = {PAWR_CFG_CENTRAL_ADDR};
+static uint8_t app_peripheral_address[BD_ADDR_LEN]      = {0x00};
+static pawr_app_ctx_t app_ctx;
+static pawr_esl_ctx_t app_esl;
 static const uint8_t pawr_subevent0_data[PAWR_BUF_SIZE] = {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f};
+#if (PAWR_APP_NUM_SUBEVENTS > 1)
 static const uint8_t pawr_subevent1_data[PAWR_BUF_SIZE] = {0x00,0x11,0x22,0x33,0x44,0x55,0x66,0x77,0x88,0x99,0xaa,0xbb,0xcc,0xdd,0xee,0xff};
+#endif
+static void app_esl_led_control(uint8_t led, const uint8_t *p_ctrl);
+static wiced_bool_t app_esl_display_image(uint8_t display, uint8_t image);
+static uint8_t app_esl_sensor_read(uint8_t sensor, uint8_t *p_data, uint8_t max_len);
+/* demo label: one LED, one display with 4 images, one sensor reporting the payload count */
+static const pawr_esl_hw_t app_esl_hw =
+{
+    .num_leds      = 1,
+    .num_displays  = 1,
+    .num_images    = 4,
+    .num_sensors   = 1,
+    .led_control   = app_esl_led_control,
+    .display_image = app_esl_display_image,
+    .sensor_read   = app_esl_sensor_read,
+};
+#ifdef ENABLE_PAWR_SECURITY
+/* demo network key, must match the central. Provision a per-network key in a product. */
+static const uint8_t pawr_network_key[PAWR_SEC_KEY_LEN] = {0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf};
+#endif
+#ifdef ENABLE_PAWR_BACKLOG
+static wiced_timer_t app_sample_timer;
+static uint16_t      app_sample_seq = 0;
+#endif
 
 /******************************************************************************
 * Function Definitions
@@ -107,6 +158,184 @@ void hci_trace_cback(wiced_bt_hci_trace_type_t type,
 }
 #endif
 
+/**************************************************************************************************
+* Function Name: app_pawr_ctx_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function initializes the state of one peripheral instance.
+* @param[out] p_ctx    , peripheral state.
+* @param[in]  rsp_slot , response slot of the peripheral.
+* @return     void
+**************************************************************************************************/
+void app_pawr_ctx_init(pawr_app_ctx_t *p_ctx, uint8_t rsp_slot)
+{
+    memset(p_ctx, 0, sizeof(*p_ctx));
+    p_ctx->rsp_slot = rsp_slot;
+}
+
+/**************************************************************************************************
+* Function Name: app_pawr_handle_request()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the response logic of a peripheral: it checks an indication report and builds
+* the echo response. It only touches p_ctx and calls no stack API, so a load generator can run
+* many instances in one process.
+* @param[in,out] p_ctx        , peripheral state.
+* @param[in]     p_msg        , PAwR sub event indication report data.
+* @param[in]     msg_len      , PAwR sub event indication report data len.
+* @param[in]     subevent_num , PAwR sub event indication report subevent.
+* @param[out]    p_rsp        , response, PAWR_BUF_SIZE bytes.
+* @return        uint8_t response length, 0 if the request is not answered.
+**************************************************************************************************/
+uint8_t app_pawr_handle_request(pawr_app_ctx_t *p_ctx, const uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num, uint8_t *p_rsp)
+{
+    const uint8_t *p_expected = pawr_subevent0_data;
+    uint8_t       idx         = (uint8_t)(subevent_num - SUBEVT0);
+
+    if ((idx >= PAWR_APP_NUM_SUBEVENTS) || (msg_len != PAWR_BUF_SIZE))
+    {
+        return 0;
+    }
+#if (PAWR_APP_NUM_SUBEVENTS > 1)
+    if (subevent_num == SUBEVT1)
+    {
+        p_expected = pawr_subevent1_data;
+    }
+#endif
+    p_ctx->rcv_cnt[idx]++;
+    if (memcmp(p_msg, p_expected, PAWR_BUF_SIZE))
+    {
+        p_ctx->err_cnt[idx]++;
+        return 0;
+    }
+    memcpy(p_rsp, p_msg, PAWR_BUF_SIZE);
+    return PAWR_BUF_SIZE;
+}
+
+/**************************************************************************************************
+* Function Name: app_esl_led_control()
+***************************************************************************************************
+* Function Description:
+* @brief
+* These functions are the hardware of the demo label, see pawr_esl_hw_t. They log instead of
+* driving an LED and an e-paper display.
+**************************************************************************************************/
+static void app_esl_led_control(uint8_t led, const uint8_t *p_ctrl)
+{
+    printf("esl led:%d, color:0x%02x, repeats:0x%02x%02x\n", led, p_ctrl[0], p_ctrl[9], p_ctrl[8]);
+}
+
+static wiced_bool_t app_esl_display_image(uint8_t display, uint8_t image)
+{
+    printf("esl display:%d, image:%d\n", display, image);
+    return WICED_TRUE;
+}
+
+static uint8_t app_esl_sensor_read(uint8_t sensor, uint8_t *p_data, uint8_t max_len)
+{
+    p_data[0] = (uint8_t)app_esl.payloads;
+    p_data[1] = (uint8_t)(app_esl.payloads >> 8);
+    return 2;
+}
+
+/**************************************************************************************************
+* Function Name: app_pawr_esl_handle()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs the ESL commands of a group payload and answers in the response slot the
+* payload assigns to this label, in the same event. The assigned slot is an index into the
+* response slots this label holds in the subevent; one it does not hold is refused.
+* @param[in] p_msg        , PAWR_MSG_TYPE_ESL message.
+* @param[in] msg_len      , message length.
+* @param[in] subevent_num , subevent, the ESL group.
+* @return void
+**************************************************************************************************/
+static void app_pawr_esl_handle(uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num)
+{
+    uint8_t               rsp[PAWR_ESL_MAX_RSP_LEN];
+    uint8_t               rsp_len;
+    uint8_t               rsp_slot = 0;
+    uint32_t              now_ms   = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    wiced_bt_dev_status_t status;
+
+    /* the AP sets the ESL absolute time over GATT in a full ESL, the local time stands in */
+    pawr_esl_poll(&app_esl, now_ms);
+    rsp_len = pawr_esl_process(&app_esl, subevent_num, &p_msg[1], msg_len - 1, now_ms, rsp, &rsp_slot);
+    if (rsp_len == 0)
+    {
+        return;
+    }
+    /* the slot goes through the scheduler so no other response lands in it */
+    status = pawr_rsp_sched_submit_slot(PAWR_RSP_PRIO_CONTROL, subevent_num, rsp_slot, rsp, rsp_len);
+    if (status != WICED_BT_SUCCESS)
+    {
+        printf("esl rsp error:%d, slot:%d of %d\n", status, rsp_slot, pawr_rsp_sched_num_slots(subevent_num));
+    }
+}
+
+/**************************************************************************************************
+* Function Name: app_pawr_filter_set_group()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function makes the ESL group the only group of the addressed message filter. A group
+* without a bit in the group address gets no group messages; the central reaches those labels
+* by unicast or Bloom address.
+* @param[in] group , ESL group.
+* @return void
+**************************************************************************************************/
+static void app_pawr_filter_set_group(uint8_t group)
+{
+    pawr_filter_set_groups(0);
+    if (!pawr_filter_join_group(group))
+    {
+        printf("esl group:%d has no filter group bit\n", group);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: app_pawr_esl_assign_handle()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes the ESL ID and group the central assigns to this label's BD address and
+* confirms them from the label's own response slot. Until then the label has no ESL ID and runs
+* only broadcast commands. The assignment is not stored; the central assigns it again when a
+* label does not answer after a reset.
+* @param[in] p_msg        , PAWR_MSG_TYPE_ESL_ADDR message.
+* @param[in] msg_len      , message length.
+* @param[in] subevent_num , subevent the message arrived in.
+* @return void
+**************************************************************************************************/
+static void app_pawr_esl_assign_handle(uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num)
+{
+    uint8_t               rsp[PAWR_ESL_ADDR_RSP_LEN];
+    wiced_bt_dev_status_t status;
+
+    if (!pawr_esl_assign(&app_esl, app_peripheral_address, p_msg, msg_len, rsp))
+    {
+        return;
+    }
+    printf("esl id:%d, group:%d assigned\n", app_esl.esl_id, app_esl.group_id);
+    /* records of packed downlink messages are addressed by ESL ID as well */
+    pawr_packed_set_id(app_esl.esl_id);
+    /* addressed downlinks: the ESL ID, and the ESL group as group bit */
+    pawr_filter_set_id(app_esl.esl_id);
+    app_pawr_filter_set_group(app_esl.group_id);
+#ifdef ENABLE_PAWR_FRAME
+    /* frame updates are addressed like ESL commands */
+    pawr_frame_set_addr(app_esl.esl_id);
+#endif
+    status = pawr_rsp_sched_submit(PAWR_RSP_PRIO_CONTROL, subevent_num, rsp, sizeof(rsp));
+    if (status != WICED_BT_SUCCESS)
+    {
+        printf("esl assign rsp error:%d\n", status);
+    }
+}
+
 /**************************************************************************************************
 * Function Name: app_pawr_subevt_rsp_cb()
 ***************************************************************************************************
@@ -122,53 +351,159 @@ void hci_trace_cback(wiced_bt_hci_trace_type_t type,
 **************************************************************************************************/
 void app_pawr_se_rsp_cb(uint16_t sync_handle, uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num, uint16_t evt_counter)
 {
-    wiced_bt_dev_status_t  status      = WICED_BT_ERROR;
-    static uint32_t        rcv_se0_cnt = 0;
-    static uint32_t        rcv_se1_cnt = 0;
-    uint8_t rcv_buf[PAWR_BUF_SIZE];
-    uint8_t *rcv = rcv_buf;
-    uint8_t snd_buf[PAWR_BUF_SIZE];
-    uint8_t *snd = snd_buf;
-    if (((subevent_num == SUBEVT0) || (subevent_num == SUBEVT1)) && (msg_len == PAWR_BUF_SIZE))
+    wiced_bt_dev_status_t  status = WICED_BT_ERROR;
+    uint8_t                snd_buf[PAWR_BUF_SIZE];
+    uint8_t                snd_len;
+    uint32_t               err_cnt;
+    uint8_t                idx    = (uint8_t)(subevent_num - SUBEVT0);
+
+    if ((msg_len > 1) && (p_msg[0] == PAWR_MSG_TYPE_ESL))
     {
-        switch(subevent_num)
-        {
-            case SUBEVT0:
-                printf("rcv:se:%d,cnt:%lu,\n",subevent_num,rcv_se0_cnt++);
-                if (memcmp(p_msg,pawr_subevent0_data,PAWR_BUF_SIZE))
-                {
-                    printf("se0 error:\n");
-                    app_bt_util_print_byte_array(p_msg,msg_len);
-                    return;
-                }
-            break;
-            case SUBEVT1:
-                printf("rcv:se:%d,cnt:%lu\n",subevent_num,rcv_se1_cnt++);
-                if (memcmp(p_msg,pawr_subevent1_data,PAWR_BUF_SIZE))
-                {
-                    printf("se1 error:\n");
-                    app_bt_util_print_byte_array(p_msg,msg_len);
-                    return;
-                }
-            break;
-        }
-        STREAM_TO_ARRAY(rcv,p_msg,PAWR_BUF_SIZE);
-        ARRAY_TO_STREAM(snd,rcv_buf,PAWR_BUF_SIZE);
-        status = pawr_snd_se_rsp_central(sync_handle,
-                                         evt_counter,
-                                         subevent_num,
-                                         subevent_num,
-                                         PAWR_PERIPHERAL_RSP_SLOT,
-                                         PAWR_BUF_SIZE,
-                                         snd_buf);
-        if (status != WICED_SUCCESS)
-        {
-            printf("pawr snd rsp error:%d\n",status);
-            return;
-        }
+        app_pawr_esl_handle(p_msg, msg_len, subevent_num);
+        return;
     }
+    if ((msg_len > 1) && (p_msg[0] == PAWR_MSG_TYPE_ESL_ADDR))
+    {
+        app_pawr_esl_assign_handle(p_msg, msg_len, subevent_num);
+        return;
+    }
+    if ((idx >= PAWR_APP_NUM_SUBEVENTS) || (msg_len != PAWR_BUF_SIZE))
+    {
+        return;
+    }
+    err_cnt = app_ctx.err_cnt[idx];
+    printf("rcv:se:%d,cnt:%lu\n", subevent_num, (unsigned long)app_ctx.rcv_cnt[idx]);
+    snd_len = app_pawr_handle_request(&app_ctx, p_msg, msg_len, subevent_num, snd_buf);
+    if (app_ctx.err_cnt[idx] != err_cnt)
+    {
+        printf("se%d error:\n", subevent_num);
+        app_bt_util_print_byte_array(p_msg,msg_len);
+        return;
+    }
+    if (snd_len == 0)
+    {
+        return;
+    }
+    /* the echo is routine telemetry, the PAwR layer sends it in this subevent's slot */
+    status = pawr_rsp_sched_submit(PAWR_RSP_PRIO_TELEMETRY,
+                                   subevent_num,
+                                   snd_buf,
+                                   snd_len);
+    if (status != WICED_SUCCESS)
+    {
+        printf("pawr snd rsp error:%d\n",status);
+        return;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: app_pawr_ds_update_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the callback of a data store update broadcast by the central.
+* @param[in] version      , new image version.
+* @param[in] changed_keys , bitmap of the keys written or removed.
+* @return void
+**************************************************************************************************/
+void app_pawr_ds_update_cb(uint16_t version, uint32_t changed_keys)
+{
+    printf("ds update: ver:%d, keys:0x%08lx\n", version, (unsigned long)changed_keys);
+}
+
+/**************************************************************************************************
+* Function Name: app_pawr_link_tx_power_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the callback of a response TX power change from the link estimator.
+* @param[in] subevent , subevent.
+* @param[in] tx_power , new response TX power in dBm.
+* @return void
+**************************************************************************************************/
+void app_pawr_link_tx_power_cb(uint8_t subevent, int8_t tx_power)
+{
+    printf("link se:%d, rsp tx power:%d dBm\n", subevent, tx_power);
+}
+
+/**************************************************************************************************
+* Function Name: app_pawr_link_weak_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the callback of the weak link signal from the link estimator. The link does
+* not improve at full power, so the central should be asked for another subevent or slot.
+* @param[in] subevent , subevent.
+* @param[in] weak     , WICED_TRUE when the link became weak.
+* @param[in] p_info   , link quality.
+* @return void
+**************************************************************************************************/
+void app_pawr_link_weak_cb(uint8_t subevent, wiced_bool_t weak, const pawr_link_info_t *p_info)
+{
+    printf("link se:%d %s, rssi:%d, loss:%d%%\n", subevent, weak ? "weak" : "recovered", p_info->rssi, p_info->loss_pct);
 }
 
+#ifdef ENABLE_PAWR_OTA
+/**************************************************************************************************
+* Function Name: app_pawr_ota_ready_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the callback of a verified firmware image applied by the central. The
+* bootloader in use decides how the secondary slot is marked for the swap; this example only
+* reports the image.
+* @param[in] slot_addr  , secondary slot offset in the serial flash.
+* @param[in] image_size , image size in bytes.
+* @return void
+**************************************************************************************************/
+void app_pawr_ota_ready_cb(uint32_t slot_addr, uint32_t image_size)
+{
+    printf("ota image ready at 0x%08lx, %lu bytes\n", (unsigned long)slot_addr, (unsigned long)image_size);
+    pawr_ota_print_stats();
+}
+#endif
+
+#ifdef ENABLE_PAWR_FRAME
+/**************************************************************************************************
+* Function Name: app_pawr_frame_ready_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the callback of a display frame update. A label would now stream the frame
+* to its panel tile by tile with pawr_frame_read_tile(); this example only reports it.
+* @param[in] version , frame version now stored.
+* @return void
+**************************************************************************************************/
+void app_pawr_frame_ready_cb(uint16_t version)
+{
+    printf("frame version %d ready\n", version);
+    pawr_frame_print_stats();
+}
+#endif
+
+#ifdef ENABLE_PAWR_BACKLOG
+/**************************************************************************************************
+* Function Name: app_pawr_sample_timer_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes a sensor sample on its own schedule. Samples go to the uplink backlog,
+* which keeps them through sync losses.
+* @param[in] cb_params , unused.
+* @return    void
+**************************************************************************************************/
+static void app_pawr_sample_timer_cb(WICED_TIMER_PARAM_TYPE cb_params)
+{
+    uint8_t sample[2 + 2];
+
+    sample[0] = (uint8_t)app_sample_seq;
+    sample[1] = (uint8_t)(app_sample_seq >> 8);
+    app_esl_sensor_read(0, &sample[2], sizeof(sample) - 2);
+    app_sample_seq++;
+    pawr_backlog_put(sample, sizeof(sample));
+}
+#endif
+
 /**************************************************************************************************
 * Function Name: app_pawr_conn_up_cb()
 ***************************************************************************************************
@@ -190,6 +525,7 @@ void app_pawr_conn_up_cb(const wiced_ble_padv_sync_established_event_data_t *paw
            pawr_param->subevent_interval,
            pawr_param->response_slot_delay,
            pawr_param->response_slot_spacing);
+    pawr_esl_set_synced(&app_esl, WICED_TRUE);
 }
 
 /**************************************************************************************************
@@ -204,6 +540,8 @@ void app_pawr_conn_up_cb(const wiced_ble_padv_sync_established_event_data_t *paw
 void app_pawr_conn_down_cb(void)
 {
     printf("pawr conn down\n");
+    pawr_esl_set_synced(&app_esl, WICED_FALSE);
+    pawr_esl_print_stats(&app_esl);
     pawr_scan_for_pawr_network();
 }
 
@@ -218,13 +556,32 @@ void app_pawr_conn_down_cb(void)
 **************************************************************************************************/
 void app_peripheral_init(void)
 {
+    uint8_t subevent;
+
     printf("===================================\n");
     pawr_reg_se_rsp_cb(app_pawr_se_rsp_cb);
     pawr_reg_conn_up_cb(app_pawr_conn_up_cb);
     pawr_reg_conn_down_cb(app_pawr_conn_down_cb);
     printf("FW VERSION:%s\n",brcm_patch_version);
     printf("PAWR PERIPHERAL VERSION:%s\n",pawr_version);
-    wiced_bt_set_local_bdaddr(app_peripheral_address, BLE_ADDR_PUBLIC);
+    /* address and response slot follow from the unique ID, one build serves every device; the
+     * response slot is the same in every subevent the device answers in */
+    pawr_identity_init();
+    pawr_identity_get_bd_addr(app_peripheral_address);
+    app_pawr_ctx_init(&app_ctx, PAWR_PERIPHERAL_RSP_SLOT + pawr_identity_get_slot(PAWR_PERIPHERAL_RSP_SLOT_NUM));
+    /* a hashed ESL ID would collide between labels; the central assigns it, see
+     * app_pawr_esl_assign_handle(). The group until then follows from the unique ID. */
+    pawr_esl_init(&app_esl, &app_esl_hw, PAWR_ESL_ID_NONE,
+                  PAWR_CFG_FIRST_SUBEVENT + pawr_identity_get_slot(PAWR_CFG_NUM_SUBEVENTS));
+    printf("esl id:%d, group:%d\n", app_esl.esl_id, app_esl.group_id);
+    /* no packed record is ours until the ESL ID is assigned */
+    pawr_packed_set_id(PAWR_PACKED_ID_NONE);
+    /* addressed downlinks: no unicast or Bloom address is ours until the ESL ID is assigned; the
+     * ESL group sets the group bit */
+    pawr_filter_set_id(PAWR_FILTER_ID_NONE);
+    app_pawr_filter_set_group(app_esl.group_id);
+    /* the derived address has its two top bits set: a static random address, not a public one */
+    wiced_bt_set_local_bdaddr(app_peripheral_address, BLE_ADDR_RANDOM);
     wiced_bt_dev_read_local_addr(app_peripheral_address);
     printf("central addr: ");
     app_bt_util_print_bd_address(app_central_address);
@@ -232,9 +589,38 @@ void app_peripheral_init(void)
     app_bt_util_print_bd_address(app_peripheral_address);
 #ifdef ENABLE_BT_SPY_LOG
     wiced_bt_dev_register_hci_trace(hci_trace_cback);
+#endif
+#if defined(ENABLE_PAWR_ROAM) && !defined(ENABLE_PAWR_DISCOVERY)
+    /* the configured central is the first known one; add the centrals of neighbouring zones here */
+    pawr_roam_add_central(BLE_ADDR_PUBLIC, app_central_address, EXT_ADV_SET_ID);
 #endif
     pawr_set_central_addr((const uint8_t *)app_central_address);
     pawr_init();
+#ifdef ENABLE_PAWR_SECURITY
+    pawr_sec_set_key(0, pawr_network_key);
+    /* every peripheral holds the network key; its own address keeps its uplink nonces apart */
+    pawr_sec_set_device_addr(app_peripheral_address);
+#endif
+    pawr_ds_reg_update_cb(app_pawr_ds_update_cb);
+    pawr_link_reg_tx_power_cb(app_pawr_link_tx_power_cb);
+    pawr_link_reg_weak_cb(app_pawr_link_weak_cb);
+#ifdef ENABLE_PAWR_OTA
+    pawr_ota_reg_ready_cb(app_pawr_ota_ready_cb);
+#endif
+#ifdef ENABLE_PAWR_FRAME
+    /* frame updates are addressed like ESL commands */
+    pawr_frame_set_addr(app_esl.esl_id);
+    pawr_frame_reg_ready_cb(app_pawr_frame_ready_cb);
+#endif
+    for (subevent = PAWR_CFG_FIRST_SUBEVENT; subevent < PAWR_CFG_SUBEVENT_TABLE_LEN; subevent++)
+    {
+        pawr_rsp_sched_set_slots(subevent, app_ctx.rsp_slot, 1);
+    }
+#ifdef ENABLE_PAWR_BACKLOG
+    wiced_init_timer(&app_sample_timer, app_pawr_sample_timer_cb, 0, WICED_MILLI_SECONDS_PERIODIC_TIMER);
+    wiced_start_timer(&app_sample_timer, PAWR_APP_SAMPLE_MS);
+#endif
+    printf("app state per peripheral instance: %u bytes\n", (unsigned int)sizeof(pawr_app_ctx_t));
     printf("===================================\n");
 }
 /* [] END OF FILE */
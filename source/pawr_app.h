@@ -41,23 +41,36 @@
 /******************************************************************************
 * Header Files
 *******************************************************************************/
+#include "pawr_config.h"
 
 /*******************************************************************************
  * Macro Definitions
 *******************************************************************************/
-#define PAWR_BUF_SIZE                  16
-#define SUBEVT0                        0x00
-#define SUBEVT1                        0x01
-#define PAWR_PERIPHERAL_RSP_SLOT       0
+#define PAWR_BUF_SIZE                  PAWR_CFG_BUF_SIZE
+#define SUBEVT0                        PAWR_CFG_FIRST_SUBEVENT
+#define SUBEVT1                        (PAWR_CFG_FIRST_SUBEVENT + 1)
+#define PAWR_PERIPHERAL_RSP_SLOT       PAWR_CFG_RSP_SLOT
+#define PAWR_PERIPHERAL_RSP_SLOT_NUM   PAWR_CFG_RSP_SLOT_NUM
+#define PAWR_APP_NUM_SUBEVENTS         ((PAWR_CFG_NUM_SUBEVENTS > 1) ? 2 : 1)   /* subevents with demo payloads */
 
 /*******************************************************************************
 * Variable Definitions
 *******************************************************************************/
+/* State of one peripheral. All response logic state lives here so several peripherals can be
+ * simulated in one process, see app_pawr_handle_request(). */
+typedef struct
+{
+    uint8_t  rsp_slot;                           /* response slot derived from the unique ID */
+    uint32_t rcv_cnt[PAWR_APP_NUM_SUBEVENTS];    /* indications received per subevent, from SUBEVT0 */
+    uint32_t err_cnt[PAWR_APP_NUM_SUBEVENTS];    /* indications with an unexpected payload */
+} pawr_app_ctx_t;
 
 /******************************************************************************
  * Function Prototypes
 ******************************************************************************/
 void app_peripheral_init(void);
+void app_pawr_ctx_init(pawr_app_ctx_t *p_ctx, uint8_t rsp_slot);
+uint8_t app_pawr_handle_request(pawr_app_ctx_t *p_ctx, const uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num, uint8_t *p_rsp);
 wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
                                           wiced_bt_management_evt_data_t *p_event_data);
 #endif /* PAWR_APP_H_ */
@@ -0,0 +1,879 @@
+/******************************************************************************
+* File Name:   pawr_backlog.c
+*
+* Description: This file consists of the uplink backlog. Records the application produces pass to a low priority task that spills them to the serial flash a page at a time when RAM runs short and feeds them back oldest first; the stack drains them into the response slots once synced.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <stdatomic.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "pawr_backlog.h"
+#include "pawr_flash.h"
+#include "pawr_frame.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+#include "app_bt_ring.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_BACKLOG_TASK_STACK_SIZE    (configMINIMAL_STACK_SIZE * 4)
+#define PAWR_BACKLOG_TASK_PRIORITY      (tskIDLE_PRIORITY + 1)
+#define PAWR_BACKLOG_TASK_PERIOD_MS     (10)
+
+/* A stored entry is len, enqueue time (uint32 LE, ms) and the data; a flash page is an entry
+ * count followed by whole entries. */
+#define PAWR_BACKLOG_ENTRY_HDR_LEN      (5)
+#define PAWR_BACKLOG_ENTRY_MAX_LEN      (PAWR_BACKLOG_ENTRY_HDR_LEN + PAWR_BACKLOG_MAX_REC_LEN)
+#define PAWR_BACKLOG_RING_LEN           (PAWR_CFG_BACKLOG_RAM_LEN / 2)   /* each way between the stack and the task */
+#define PAWR_BACKLOG_MAX_AGE            (0xFFFF)
+#define PAWR_BACKLOG_FLASH_PAGES        (PAWR_CFG_BACKLOG_FLASH_SIZE / PAWR_BACKLOG_PAGE_LEN)
+
+_Static_assert(PAWR_BACKLOG_MAX_REC_LEN >= 1, "no room for backlog records in a response");
+_Static_assert((PAWR_CFG_BACKLOG_RAM_LEN & (PAWR_CFG_BACKLOG_RAM_LEN - 1)) == 0, "backlog RAM must be a power of two");
+_Static_assert(PAWR_BACKLOG_RING_LEN >= PAWR_BACKLOG_PAGE_LEN, "backlog RAM does not hold a flash page each way");
+_Static_assert(PAWR_BACKLOG_PAGE_LEN - 1 >= PAWR_BACKLOG_ENTRY_MAX_LEN, "a backlog page does not hold a record");
+_Static_assert((PAWR_CFG_BACKLOG_FLASH_SIZE % PAWR_BACKLOG_PAGE_LEN) == 0, "backlog flash must be whole pages");
+_Static_assert(PAWR_BACKLOG_FLASH_PAGES <= 0xFFFF, "backlog page index is 16 bit");
+#if (PAWR_CFG_BACKLOG_FLASH_SIZE != 0)
+_Static_assert((PAWR_CFG_BACKLOG_FLASH_ADDR >= PAWR_CFG_OTA_SLOT_ADDR + PAWR_CFG_OTA_SLOT_SIZE) ||
+               (PAWR_CFG_BACKLOG_FLASH_ADDR + PAWR_CFG_BACKLOG_FLASH_SIZE <= PAWR_CFG_OTA_SLOT_ADDR),
+               "backlog flash overlaps the OTA slot");
+_Static_assert((PAWR_CFG_BACKLOG_FLASH_ADDR >= PAWR_CFG_FRAME_FLASH_ADDR + PAWR_FRAME_NUM_TILES * PAWR_FRAME_TILE_STRIDE) ||
+               (PAWR_CFG_BACKLOG_FLASH_ADDR + PAWR_CFG_BACKLOG_FLASH_SIZE <= PAWR_CFG_FRAME_FLASH_ADDR),
+               "backlog flash overlaps the frame store");
+#endif
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static const pawr_backlog_store_t pawr_backlog_default_store =
+{
+    .init       = pawr_flash_init,
+    .erase_size = pawr_flash_erase_size,
+    .erase      = pawr_flash_erase,
+    .write      = pawr_flash_write,
+    .read       = pawr_flash_read,
+};
+
+static const pawr_backlog_store_t *bl_store = &pawr_backlog_default_store;
+
+/* Oldest first: the staged entry, the drain ring, the flash pages, the write page, the put ring.
+ * Shared between the stack and the backlog task. */
+APP_BT_RING_DEFINE_BUF(bl_put_ring_buf, 1, PAWR_BACKLOG_RING_LEN);
+APP_BT_RING_DEFINE_BUF(bl_drain_ring_buf, 1, PAWR_BACKLOG_RING_LEN);
+static app_bt_ring_t        bl_put_ring;                   /* stack to task */
+static app_bt_ring_t        bl_drain_ring;                 /* task to stack, in drain order */
+static atomic_uint          bl_lost_records;               /* given up by the task */
+static atomic_uint          bl_lost_bytes;
+static atomic_uint          bl_held_ms;                    /* enqueue time of the oldest entry the task holds */
+static atomic_bool          bl_held;
+static atomic_uint          bl_flash_pages;
+static atomic_uint          bl_spilled_pages;
+static atomic_uint          bl_store_errors;
+
+/* Backlog task side */
+static uint8_t              bl_entry[PAWR_BACKLOG_ENTRY_MAX_LEN];
+static uint8_t              bl_rd_page[PAWR_BACKLOG_PAGE_LEN];
+static uint8_t              bl_wr_page[PAWR_BACKLOG_PAGE_LEN];
+static uint16_t             bl_wr_off          = 1;        /* end of the entries in bl_wr_page */
+static uint16_t             bl_fl_rd           = 0;        /* oldest pending page */
+static uint16_t             bl_fl_pages        = 0;
+static uint16_t             bl_fl_total        = 0;        /* 0 until the store is found usable */
+static uint16_t             bl_fl_sector_pages = 0;
+#if (PAWR_BACKLOG_FLASH_PAGES != 0)
+static uint8_t              bl_fl_count[PAWR_BACKLOG_FLASH_PAGES];   /* entries per page */
+static uint8_t              bl_fl_len[PAWR_BACKLOG_FLASH_PAGES];     /* entry bytes per page */
+static uint32_t             bl_fl_first_ms[PAWR_BACKLOG_FLASH_PAGES];/* enqueue time of the first entry */
+#else
+static uint8_t              bl_fl_count[1];
+static uint8_t              bl_fl_len[1];
+static uint32_t             bl_fl_first_ms[1];
+#endif
+static wiced_bool_t         bl_store_checked   = WICED_FALSE;
+
+/* Stack side */
+static uint8_t              bl_next[PAWR_BACKLOG_ENTRY_MAX_LEN];     /* oldest entry, taken off the drain ring */
+static uint16_t             bl_next_len        = 0;
+static uint32_t             bl_put_records     = 0;
+static uint32_t             bl_put_bytes       = 0;
+static uint32_t             bl_taken_records   = 0;
+static uint32_t             bl_taken_bytes     = 0;
+static wiced_bool_t         bl_synced          = WICED_FALSE;
+static wiced_bool_t         bl_draining        = WICED_FALSE;
+static uint32_t             bl_drain_since_ms  = 0;
+static pawr_backlog_stats_t bl_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_backlog_now_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the local time in milliseconds.
+* @return    uint32_t time, ms.
+**************************************************************************************************/
+static uint32_t pawr_backlog_now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_entry_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the enqueue time of an entry.
+* @param[in] p_entry , entry.
+* @return    uint32_t enqueue time, ms.
+**************************************************************************************************/
+static uint32_t pawr_backlog_entry_ms(const uint8_t *p_entry)
+{
+    return (uint32_t)p_entry[1] | ((uint32_t)p_entry[2] << 8) | ((uint32_t)p_entry[3] << 16) | ((uint32_t)p_entry[4] << 24);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_page_addr()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the flash address of a backlog page.
+* @param[in] page , page index in the backlog region.
+* @return    uint32_t flash address.
+**************************************************************************************************/
+static uint32_t pawr_backlog_page_addr(uint16_t page)
+{
+    return PAWR_CFG_BACKLOG_FLASH_ADDR + (uint32_t)page * PAWR_BACKLOG_PAGE_LEN;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_store_ready()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function checks the spill store on first use. Without a usable store the backlog keeps
+* to RAM. Backlog task only.
+* @return    wiced_bool_t WICED_TRUE if pages can be spilled.
+**************************************************************************************************/
+static wiced_bool_t pawr_backlog_store_ready(void)
+{
+    uint32_t sector;
+
+    if (bl_store_checked)
+    {
+        return (bl_fl_total != 0);
+    }
+    bl_store_checked = WICED_TRUE;
+    if ((PAWR_CFG_BACKLOG_FLASH_SIZE == 0) || !bl_store->init())
+    {
+        return WICED_FALSE;
+    }
+    sector = bl_store->erase_size(PAWR_CFG_BACKLOG_FLASH_ADDR);
+    /* two sectors at least, erasing one for new pages must not take every pending page */
+    if ((sector < PAWR_BACKLOG_PAGE_LEN) || ((sector % PAWR_BACKLOG_PAGE_LEN) != 0) ||
+        ((PAWR_CFG_BACKLOG_FLASH_ADDR % sector) != 0) || ((PAWR_CFG_BACKLOG_FLASH_SIZE % sector) != 0) ||
+        (PAWR_CFG_BACKLOG_FLASH_SIZE < 2 * sector))
+    {
+        printf("pawr_backlog: flash sector %lu does not fit the region, RAM only\n", (unsigned long)sector);
+        return WICED_FALSE;
+    }
+    bl_fl_total        = (uint16_t)(PAWR_CFG_BACKLOG_FLASH_SIZE / PAWR_BACKLOG_PAGE_LEN);
+    bl_fl_sector_pages = (uint16_t)(sector / PAWR_BACKLOG_PAGE_LEN);
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_lose()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function accounts for entries the backlog task gave up.
+* @param[in] records , entries.
+* @param[in] bytes   , their bytes, headers included.
+* @return    void.
+**************************************************************************************************/
+static void pawr_backlog_lose(uint32_t records, uint32_t bytes)
+{
+    atomic_fetch_add_explicit(&bl_lost_records, records, memory_order_relaxed);
+    atomic_fetch_add_explicit(&bl_lost_bytes, bytes, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_drop_page()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function gives up the oldest pending flash page. Backlog task only.
+* @return    void.
+**************************************************************************************************/
+static void pawr_backlog_drop_page(void)
+{
+    pawr_backlog_lose(bl_fl_count[bl_fl_rd], bl_fl_len[bl_fl_rd]);
+    bl_fl_rd = (uint16_t)((bl_fl_rd + 1) % bl_fl_total);
+    bl_fl_pages--;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_spill()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function programs the full write page as the newest flash page. The page after the newest
+* one is erased a sector at a time as it comes up; pending pages in that sector are given up.
+* Entries that cannot be stored are given up. Backlog task only.
+* @return    void.
+**************************************************************************************************/
+static void pawr_backlog_spill(void)
+{
+    uint16_t     wr;
+    wiced_bool_t ok = pawr_backlog_store_ready();
+
+    if (ok)
+    {
+        wr = (uint16_t)((bl_fl_rd + bl_fl_pages) % bl_fl_total);
+        if ((wr % bl_fl_sector_pages) == 0)
+        {
+            while ((bl_fl_pages != 0) && (bl_fl_pages + bl_fl_sector_pages > bl_fl_total))
+            {
+                pawr_backlog_drop_page();
+            }
+            ok = bl_store->erase(pawr_backlog_page_addr(wr), (uint32_t)bl_fl_sector_pages * PAWR_BACKLOG_PAGE_LEN);
+        }
+        if (ok)
+        {
+            memset(&bl_wr_page[bl_wr_off], 0xFF, PAWR_BACKLOG_PAGE_LEN - bl_wr_off);
+            ok = bl_store->write(pawr_backlog_page_addr(wr), PAWR_BACKLOG_PAGE_LEN, bl_wr_page);
+        }
+        if (ok)
+        {
+            bl_fl_count[wr]    = bl_wr_page[0];
+            bl_fl_len[wr]      = (uint8_t)(bl_wr_off - 1);
+            bl_fl_first_ms[wr] = pawr_backlog_entry_ms(&bl_wr_page[1]);
+            bl_fl_pages++;
+            atomic_fetch_add_explicit(&bl_spilled_pages, 1, memory_order_relaxed);
+        }
+        else
+        {
+            atomic_fetch_add_explicit(&bl_store_errors, 1, memory_order_relaxed);
+        }
+    }
+    if (!ok)
+    {
+        pawr_backlog_lose(bl_wr_page[0], (uint32_t)(bl_wr_off - 1));
+    }
+    bl_wr_page[0] = 0;
+    bl_wr_off     = 1;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_load_pages()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function moves the oldest flash pages onto the drain ring while it has room for them.
+* Backlog task only.
+* @return    wiced_bool_t WICED_TRUE if a page was moved.
+**************************************************************************************************/
+static wiced_bool_t pawr_backlog_load_pages(void)
+{
+    wiced_bool_t moved = WICED_FALSE;
+
+    while ((bl_fl_pages != 0) &&
+           (PAWR_BACKLOG_RING_LEN - app_bt_ring_count(&bl_drain_ring) >= bl_fl_len[bl_fl_rd]))
+    {
+        if (!bl_store->read(pawr_backlog_page_addr(bl_fl_rd), PAWR_BACKLOG_PAGE_LEN, bl_rd_page) ||
+            (bl_rd_page[0] != bl_fl_count[bl_fl_rd]))
+        {
+            atomic_fetch_add_explicit(&bl_store_errors, 1, memory_order_relaxed);
+            pawr_backlog_drop_page();
+            continue;
+        }
+        /* one push, the stack never sees part of an entry */
+        app_bt_ring_push_batch(&bl_drain_ring, &bl_rd_page[1], bl_fl_len[bl_fl_rd]);
+        bl_fl_rd = (uint16_t)((bl_fl_rd + 1) % bl_fl_total);
+        bl_fl_pages--;
+        moved = WICED_TRUE;
+    }
+    return moved;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_unspill()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function moves the entries of the write page onto the drain ring while it has room, once
+* no flash page is older. Backlog task only.
+* @return    wiced_bool_t WICED_TRUE if an entry was moved.
+**************************************************************************************************/
+static wiced_bool_t pawr_backlog_unspill(void)
+{
+    uint16_t off   = 1;
+    uint16_t len;
+    uint32_t space = PAWR_BACKLOG_RING_LEN - app_bt_ring_count(&bl_drain_ring);
+
+    if (bl_fl_pages != 0)
+    {
+        return WICED_FALSE;
+    }
+    while ((off < bl_wr_off) && ((len = (uint16_t)(PAWR_BACKLOG_ENTRY_HDR_LEN + bl_wr_page[off])) <= space - (off - 1)))
+    {
+        off += len;
+    }
+    if (off == 1)
+    {
+        return WICED_FALSE;
+    }
+    app_bt_ring_push_batch(&bl_drain_ring, &bl_wr_page[1], off - 1);
+    for (len = 1; len < off; len = (uint16_t)(len + PAWR_BACKLOG_ENTRY_HDR_LEN + bl_wr_page[len]))
+    {
+        bl_wr_page[0]--;
+    }
+    memmove(&bl_wr_page[1], &bl_wr_page[off], bl_wr_off - off);
+    bl_wr_off = (uint16_t)(bl_wr_off - (off - 1));
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_take_puts()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes the records the stack put. They go straight onto the drain ring while
+* nothing older waits in the task, into the write page otherwise; a full write page is spilled.
+* Backlog task only.
+* @return    wiced_bool_t WICED_TRUE if a record was taken.
+**************************************************************************************************/
+static wiced_bool_t pawr_backlog_take_puts(void)
+{
+    wiced_bool_t  moved = WICED_FALSE;
+    const uint8_t *p_len;
+    uint16_t      len;
+
+    while ((p_len = app_bt_ring_peek(&bl_put_ring)) != NULL)
+    {
+        /* the stack pushes an entry at once, so all of it is there */
+        len = (uint16_t)(PAWR_BACKLOG_ENTRY_HDR_LEN + *p_len);
+        app_bt_ring_pop_batch(&bl_put_ring, bl_entry, len);
+        moved = WICED_TRUE;
+        if ((bl_fl_pages == 0) && (bl_wr_off == 1) &&
+            (PAWR_BACKLOG_RING_LEN - app_bt_ring_count(&bl_drain_ring) >= len))
+        {
+            app_bt_ring_push_batch(&bl_drain_ring, bl_entry, len);
+            continue;
+        }
+        if (bl_wr_off + len > PAWR_BACKLOG_PAGE_LEN)
+        {
+            pawr_backlog_spill();
+        }
+        memcpy(&bl_wr_page[bl_wr_off], bl_entry, len);
+        bl_wr_off = (uint16_t)(bl_wr_off + len);
+        bl_wr_page[0]++;
+    }
+    return moved;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_publish()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function tells the stack what the backlog task holds, from RAM, so that the stack never
+* has to look into the flash.
+* @return    void.
+**************************************************************************************************/
+static void pawr_backlog_publish(void)
+{
+    wiced_bool_t held = WICED_TRUE;
+
+    if (bl_fl_pages != 0)
+    {
+        atomic_store_explicit(&bl_held_ms, bl_fl_first_ms[bl_fl_rd], memory_order_relaxed);
+    }
+    else if (bl_wr_off != 1)
+    {
+        atomic_store_explicit(&bl_held_ms, pawr_backlog_entry_ms(&bl_wr_page[1]), memory_order_relaxed);
+    }
+    else
+    {
+        held = WICED_FALSE;
+    }
+    atomic_store_explicit(&bl_held, held, memory_order_release);
+    atomic_store_explicit(&bl_flash_pages, bl_fl_pages, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_task()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function moves records between RAM and the flash. Erasing a sector and programming or
+* reading a page take far too long for the Bluetooth stack context.
+* @param[in] arg , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_backlog_task(void *arg)
+{
+    wiced_bool_t moved;
+
+    for (;;)
+    {
+        /* oldest first: flash pages, then the write page, then new records */
+        moved  = pawr_backlog_load_pages();
+        moved |= pawr_backlog_unspill();
+        moved |= pawr_backlog_take_puts();
+        pawr_backlog_publish();
+        if (!moved)
+        {
+            vTaskDelay(pdMS_TO_TICKS(PAWR_BACKLOG_TASK_PERIOD_MS));
+        }
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_stage()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes the oldest entry off the drain ring unless one is staged already.
+* @return    wiced_bool_t WICED_TRUE if an entry is staged in bl_next.
+**************************************************************************************************/
+static wiced_bool_t pawr_backlog_stage(void)
+{
+    const uint8_t *p_len;
+
+    if ((bl_next_len == 0) && ((p_len = app_bt_ring_peek(&bl_drain_ring)) != NULL))
+    {
+        bl_next_len = (uint16_t)(PAWR_BACKLOG_ENTRY_HDR_LEN + *p_len);
+        app_bt_ring_pop_batch(&bl_drain_ring, bl_next, bl_next_len);
+    }
+    return (bl_next_len != 0);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_pending()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function counts the pending records, wherever they are.
+* @param[out] p_bytes , their bytes, headers included, or NULL.
+* @return     uint32_t pending records.
+**************************************************************************************************/
+static uint32_t pawr_backlog_pending(uint32_t *p_bytes)
+{
+    if (p_bytes != NULL)
+    {
+        *p_bytes = bl_put_bytes - bl_taken_bytes - atomic_load_explicit(&bl_lost_bytes, memory_order_relaxed);
+    }
+    return bl_put_records - bl_taken_records - atomic_load_explicit(&bl_lost_records, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_oldest_age()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the age of the oldest pending record. Records still on their way to the
+* backlog task count as new.
+* @param[in] now , local time, ms.
+* @return    uint32_t age, ms, 0 if none.
+**************************************************************************************************/
+static uint32_t pawr_backlog_oldest_age(uint32_t now)
+{
+    if (pawr_backlog_stage())
+    {
+        return now - pawr_backlog_entry_ms(bl_next);
+    }
+    if (atomic_load_explicit(&bl_held, memory_order_acquire))
+    {
+        return now - atomic_load_explicit(&bl_held_ms, memory_order_relaxed);
+    }
+    return 0;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_close_window()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function ends a drain period, the backlog ran empty or the sync is gone.
+* @return    void.
+**************************************************************************************************/
+static void pawr_backlog_close_window(void)
+{
+    if (bl_draining)
+    {
+        bl_stats.drain_ms += pawr_backlog_now_ms() - bl_drain_since_ms;
+        bl_draining        = WICED_FALSE;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets up the queues and starts the backlog task. The flash is checked when the
+* first page spills.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_backlog_init(void)
+{
+    app_bt_ring_init(&bl_put_ring, bl_put_ring_buf, 1, PAWR_BACKLOG_RING_LEN);
+    app_bt_ring_init(&bl_drain_ring, bl_drain_ring_buf, 1, PAWR_BACKLOG_RING_LEN);
+    atomic_init(&bl_lost_records, 0);
+    atomic_init(&bl_lost_bytes, 0);
+    atomic_init(&bl_held_ms, 0);
+    atomic_init(&bl_held, WICED_FALSE);
+    atomic_init(&bl_flash_pages, 0);
+    atomic_init(&bl_spilled_pages, 0);
+    atomic_init(&bl_store_errors, 0);
+    bl_wr_page[0]    = 0;
+    bl_wr_off        = 1;
+    bl_fl_rd         = 0;
+    bl_fl_pages      = 0;
+    bl_fl_total      = 0;
+    bl_store_checked = WICED_FALSE;
+    bl_next_len      = 0;
+    bl_put_records   = 0;
+    bl_put_bytes     = 0;
+    bl_taken_records = 0;
+    bl_taken_bytes   = 0;
+    bl_synced        = WICED_FALSE;
+    bl_draining      = WICED_FALSE;
+    memset(&bl_stats, 0, sizeof(bl_stats));
+    if (xTaskCreate(pawr_backlog_task, "pawr_backlog", PAWR_BACKLOG_TASK_STACK_SIZE, NULL, PAWR_BACKLOG_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        printf("pawr_backlog_init: task create failed\n");
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_set_store()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function replaces the spill store, before the first record is put.
+* @param[in] p_store , spill store, NULL for the serial flash.
+* @return    void.
+**************************************************************************************************/
+void pawr_backlog_set_store(const pawr_backlog_store_t *p_store)
+{
+    bl_store         = (p_store != NULL) ? p_store : &pawr_backlog_default_store;
+    bl_store_checked = WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_put()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues an uplink record, synced or not. The record only goes into RAM; the
+* backlog task spills it to the flash if need be. Must be called from the Bluetooth stack context.
+* @param[in] p_data   , record data, copied.
+* @param[in] data_len , 1 to PAWR_BACKLOG_MAX_REC_LEN bytes.
+* @return    wiced_bool_t WICED_TRUE if queued, WICED_FALSE if too long or the task is behind.
+**************************************************************************************************/
+wiced_bool_t pawr_backlog_put(const uint8_t *p_data, uint8_t data_len)
+{
+    uint8_t  entry[PAWR_BACKLOG_ENTRY_MAX_LEN];
+    uint16_t len = (uint16_t)(PAWR_BACKLOG_ENTRY_HDR_LEN + data_len);
+    uint32_t now = pawr_backlog_now_ms();
+    uint32_t records;
+
+    if ((data_len == 0) || (data_len > PAWR_BACKLOG_MAX_REC_LEN))
+    {
+        return WICED_FALSE;
+    }
+    if (PAWR_BACKLOG_RING_LEN - app_bt_ring_count(&bl_put_ring) < len)
+    {
+        bl_stats.dropped++;
+        return WICED_FALSE;
+    }
+    entry[0] = data_len;
+    entry[1] = (uint8_t)now;
+    entry[2] = (uint8_t)(now >> 8);
+    entry[3] = (uint8_t)(now >> 16);
+    entry[4] = (uint8_t)(now >> 24);
+    memcpy(&entry[PAWR_BACKLOG_ENTRY_HDR_LEN], p_data, data_len);
+    app_bt_ring_push_batch(&bl_put_ring, entry, len);
+    bl_put_records++;
+    bl_put_bytes += len;
+    bl_stats.put++;
+    records = pawr_backlog_pending(NULL);
+    if (records > bl_stats.records_max)
+    {
+        bl_stats.records_max = records;
+    }
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_drain()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function packs the oldest records into full size responses for the slots of a subevent
+* that no other telemetry is waiting for. Called per report, before the slots are serviced; only
+* records the backlog task has brought into RAM are taken.
+* @param[in] subevent , subevent of the report.
+* @return    uint8_t responses queued.
+**************************************************************************************************/
+uint8_t pawr_backlog_drain(uint8_t subevent)
+{
+    uint8_t                msg[PAWR_BACKLOG_MSG_MAX_LEN];
+    uint8_t                queued = 0;
+    uint8_t                num_slots;
+    uint16_t               off;
+    uint32_t               now;
+    uint32_t               age;
+    uint32_t               age_units;
+    uint32_t               pending;
+    uint32_t               msg_records;
+    uint32_t               msg_bytes;
+    uint32_t               msg_age_sum;
+    uint32_t               msg_age_max;
+    pawr_rsp_sched_stats_t rsp;
+
+    if (!bl_synced || (subevent >= PAWR_CFG_SUBEVENT_TABLE_LEN))
+    {
+        return 0;
+    }
+    if (pawr_backlog_pending(NULL) == 0)
+    {
+        return 0;
+    }
+    num_slots = pawr_rsp_sched_num_slots(subevent);
+    pawr_rsp_sched_get_stats(PAWR_RSP_PRIO_TELEMETRY, &rsp);
+    now = pawr_backlog_now_ms();
+    if (!bl_draining)
+    {
+        bl_draining       = WICED_TRUE;
+        bl_drain_since_ms = now;
+    }
+    while ((rsp.depth + queued < num_slots) && pawr_backlog_stage())
+    {
+        off         = PAWR_BACKLOG_MSG_HDR_LEN;
+        msg_records = 0;
+        msg_bytes   = 0;
+        msg_age_sum = 0;
+        msg_age_max = 0;
+        while (pawr_backlog_stage() && (off + PAWR_BACKLOG_REC_HDR_LEN + bl_next[0] <= PAWR_BACKLOG_MSG_MAX_LEN))
+        {
+            age       = now - pawr_backlog_entry_ms(bl_next);
+            age_units = age / PAWR_BACKLOG_AGE_UNIT_MS;
+            age_units = (age_units > PAWR_BACKLOG_MAX_AGE) ? PAWR_BACKLOG_MAX_AGE : age_units;
+            msg[off]     = bl_next[0];
+            msg[off + 1] = (uint8_t)age_units;
+            msg[off + 2] = (uint8_t)(age_units >> 8);
+            memcpy(&msg[off + PAWR_BACKLOG_REC_HDR_LEN], &bl_next[PAWR_BACKLOG_ENTRY_HDR_LEN], bl_next[0]);
+            off += (uint16_t)(PAWR_BACKLOG_REC_HDR_LEN + bl_next[0]);
+            msg_records++;
+            msg_bytes   += bl_next[0];
+            msg_age_sum += age;
+            msg_age_max  = (age > msg_age_max) ? age : msg_age_max;
+            bl_taken_records++;
+            bl_taken_bytes += bl_next_len;
+            bl_next_len     = 0;
+        }
+        pending = pawr_backlog_pending(NULL);
+        msg[0] = PAWR_MSG_TYPE_BACKLOG;
+        msg[1] = (uint8_t)((pending > 0xFFFF) ? 0xFF : pending);
+        msg[2] = (uint8_t)((pending > 0xFFFF) ? 0xFF : (pending >> 8));
+        /* the records are off the drain ring already, a refused message is lost */
+        if (pawr_rsp_sched_submit(PAWR_RSP_PRIO_TELEMETRY, subevent, msg, (uint8_t)off) != WICED_BT_SUCCESS)
+        {
+            bl_stats.dropped += msg_records;
+            break;
+        }
+        bl_stats.drained     += msg_records;
+        bl_stats.drain_bytes += msg_bytes;
+        bl_stats.age_sum_ms  += msg_age_sum;
+        if (msg_age_max > bl_stats.age_max_ms)
+        {
+            bl_stats.age_max_ms = msg_age_max;
+        }
+        bl_stats.drain_msgs++;
+        queued++;
+    }
+    if (pawr_backlog_pending(NULL) == 0)
+    {
+        pawr_backlog_close_window();
+    }
+    return queued;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_on_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts draining with the next report.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_backlog_on_sync(void)
+{
+    bl_synced = WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_on_sync_lost()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function stops draining until the next sync.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_backlog_on_sync_lost(void)
+{
+    bl_synced = WICED_FALSE;
+    pawr_backlog_close_window();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_depth()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the pending records.
+* @param[in] void.
+* @return    uint32_t pending records, RAM and flash.
+**************************************************************************************************/
+uint32_t pawr_backlog_depth(void)
+{
+    return pawr_backlog_pending(NULL);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_get_demand()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sizes the pending records in drain responses. It works from counters and RAM
+* only, so it is cheap enough to call per report.
+* @param[out] p_oldest_age_ms , age of the oldest record, 0 if none.
+* @return     uint32_t full size drain responses the pending records take.
+**************************************************************************************************/
+uint32_t pawr_backlog_get_demand(uint32_t *p_oldest_age_ms)
+{
+    uint32_t bytes;
+    uint32_t records = pawr_backlog_pending(&bytes);
+    uint32_t per_msg;
+
+    *p_oldest_age_ms = 0;
+    if (records == 0)
+    {
+        return 0;
+    }
+    *p_oldest_age_ms = pawr_backlog_oldest_age(pawr_backlog_now_ms());
+    /* Whole records per message at the average packed length, stored entries are 2 bytes longer.
+     * Exact when the records are of one length, as telemetry records usually are. */
+    per_msg = (PAWR_BACKLOG_MSG_MAX_LEN - PAWR_BACKLOG_MSG_HDR_LEN) / ((bytes - 2 * records + records - 1) / records);
+    return (records + per_msg - 1) / per_msg;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the backlog statistics; the drain time includes the current period.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_backlog_get_stats(pawr_backlog_stats_t *p_stats)
+{
+    uint32_t now = pawr_backlog_now_ms();
+
+    *p_stats               = bl_stats;
+    p_stats->records       = pawr_backlog_pending(&p_stats->bytes);
+    p_stats->flash_pages   = atomic_load_explicit(&bl_flash_pages, memory_order_relaxed);
+    p_stats->oldest_age_ms = (p_stats->records != 0) ? pawr_backlog_oldest_age(now) : 0;
+    p_stats->dropped      += atomic_load_explicit(&bl_lost_records, memory_order_relaxed);
+    p_stats->spilled_pages = atomic_load_explicit(&bl_spilled_pages, memory_order_relaxed);
+    p_stats->store_errors  = atomic_load_explicit(&bl_store_errors, memory_order_relaxed);
+    if (bl_draining)
+    {
+        p_stats->drain_ms += now - bl_drain_since_ms;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_backlog_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the backlog statistics, with the drain rate over the synced time with
+* records pending.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_backlog_print_stats(void)
+{
+    pawr_backlog_stats_t stats;
+
+    pawr_backlog_get_stats(&stats);
+    printf("pawr backlog: records:%lu max:%lu, bytes:%lu, pages:%lu, oldest:%lu ms, put:%lu, dropped:%lu, spilled:%lu, store err:%lu\n",
+           (unsigned long)stats.records,
+           (unsigned long)stats.records_max,
+           (unsigned long)stats.bytes,
+           (unsigned long)stats.flash_pages,
+           (unsigned long)stats.oldest_age_ms,
+           (unsigned long)stats.put,
+           (unsigned long)stats.dropped,
+           (unsigned long)stats.spilled_pages,
+           (unsigned long)stats.store_errors);
+    printf("pawr backlog drain: records:%lu, msgs:%lu, rate:%lu rec/s %lu B/s, age avg:%lu max:%lu ms\n",
+           (unsigned long)stats.drained,
+           (unsigned long)stats.drain_msgs,
+           (unsigned long)((stats.drain_ms != 0) ? (uint32_t)(((uint64_t)stats.drained * 1000) / stats.drain_ms) : 0),
+           (unsigned long)((stats.drain_ms != 0) ? (uint32_t)(((uint64_t)stats.drain_bytes * 1000) / stats.drain_ms) : 0),
+           (unsigned long)((stats.drained != 0) ? (stats.age_sum_ms / stats.drained) : 0),
+           (unsigned long)stats.age_max_ms);
+}
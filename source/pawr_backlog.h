@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   pawr_backlog.h
+*
+* Description: This file is the public interface of the uplink backlog.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_BACKLOG_H_
+#define PAWR_BACKLOG_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr.h"
+#include "pawr_msg.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Drain response: type, pending records after this message (uint16 LE, saturated), then records
+ * of len, age (uint16 LE in 100 ms units, saturated) and len data bytes each, oldest first. A
+ * drain response leaves room for the flow control field and an acknowledgement in front of it.
+ * Extra slots for the drain are granted with a flow control message, see pawr_flow.h. */
+#define PAWR_BACKLOG_MSG_HDR_LEN        (3)
+#define PAWR_BACKLOG_REC_HDR_LEN        (3)
+#define PAWR_BACKLOG_AGE_UNIT_MS        (100)
+#define PAWR_BACKLOG_MSG_MAX_LEN        (PAWR_RSP_MAX_DATA_LEN - PAWR_FLOW_HDR_LEN - PAWR_ACK_HDR_LEN)   /* room left for the flow field and an ack */
+#define PAWR_BACKLOG_MAX_REC_LEN        (PAWR_BACKLOG_MSG_MAX_LEN - PAWR_BACKLOG_MSG_HDR_LEN - PAWR_BACKLOG_REC_HDR_LEN)
+#define PAWR_BACKLOG_PAGE_LEN           (256)    /* spill unit, a serial flash program page */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+/* Spill store, called from the backlog task only. Same contract as pawr_flash.h; a host build
+ * passes a file backed stand-in. */
+typedef struct
+{
+    wiced_bool_t (*init)(void);
+    uint32_t     (*erase_size)(uint32_t addr);
+    wiced_bool_t (*erase)(uint32_t addr, uint32_t len);
+    wiced_bool_t (*write)(uint32_t addr, uint32_t len, const uint8_t *p_data);
+    wiced_bool_t (*read)(uint32_t addr, uint32_t len, uint8_t *p_data);
+} pawr_backlog_store_t;
+
+typedef struct
+{
+    uint32_t records;                            /* pending, RAM and flash */
+    uint32_t records_max;                        /* pending high-water mark */
+    uint32_t bytes;                              /* pending record bytes, headers included */
+    uint32_t flash_pages;                        /* pending pages in the flash */
+    uint32_t oldest_age_ms;                      /* of the oldest pending record */
+    uint32_t put;                                /* records accepted by pawr_backlog_put() */
+    uint32_t dropped;                            /* records given up, rejected puts included */
+    uint32_t spilled_pages;                      /* pages written to the flash */
+    uint32_t store_errors;                       /* flash accesses that failed */
+    uint32_t drained;                            /* records handed to the response scheduler */
+    uint32_t drain_msgs;                         /* responses they went out in */
+    uint32_t drain_bytes;                        /* record data bytes, headers excluded */
+    uint32_t drain_ms;                           /* synced time with records pending */
+    uint32_t age_sum_ms;                         /* data age of the drained records */
+    uint32_t age_max_ms;
+} pawr_backlog_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_backlog_init(void);
+void pawr_backlog_set_store(const pawr_backlog_store_t *p_store);
+wiced_bool_t pawr_backlog_put(const uint8_t *p_data, uint8_t data_len);
+uint8_t pawr_backlog_drain(uint8_t subevent);
+void pawr_backlog_on_sync(void);
+void pawr_backlog_on_sync_lost(void);
+uint32_t pawr_backlog_depth(void);
+uint32_t pawr_backlog_get_demand(uint32_t *p_oldest_age_ms);
+void pawr_backlog_get_stats(pawr_backlog_stats_t *p_stats);
+void pawr_backlog_print_stats(void);
+#endif /* PAWR_BACKLOG_H_ */
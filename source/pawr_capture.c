@@ -0,0 +1,630 @@
+/******************************************************************************
+* File Name:   pawr_capture.c
+*
+* Description: This file consists of the PAwR event capture and replay. Sync, report and response events are recorded into a compact stream printed on the debug UART; a recorded stream can be fed back through the event dispatch table to compare the produced responses and time the handlers.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_bt_ble.h"
+#include "pawr.h"
+#include "pawr_capture.h"
+#include "app_bt_ring.h"
+#include "app_bt_utils.h"
+#include "app_bt_dispatch.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_CAP_TASK_STACK_SIZE        (configMINIMAL_STACK_SIZE * 4)
+#define PAWR_CAP_TASK_PRIORITY          (tskIDLE_PRIORITY + 1)
+#define PAWR_CAP_DRAIN_PERIOD_MS        (20)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* A response produced while replaying, kept as a digest for the comparison. */
+typedef struct
+{
+    uint16_t evt_counter;
+    uint8_t  rsp_slot;
+    uint8_t  data_len;
+    uint32_t hash;
+} pawr_cap_rsp_digest_t;
+
+APP_BT_RING_DEFINE_BUF(cap_ring_buf, 1, PAWR_CAP_RING_SIZE);
+static app_bt_ring_t         cap_ring;
+static wiced_bool_t          cap_enabled   = WICED_FALSE;
+static wiced_bool_t          cap_replaying = WICED_FALSE;
+static uint32_t              cap_lost      = 0;       /* records dropped since the last GAP record */
+static pawr_cap_rsp_digest_t cap_produced[PAWR_CAP_MAX_RSP_PER_EVT];
+static uint8_t               cap_produced_num = 0;
+static uint8_t               cap_produced_overflow = 0;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_cap_hash()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function digests a response payload with FNV-1a.
+* @param[in] p_data , payload.
+* @param[in] len    , payload length.
+* @return    uint32_t digest.
+**************************************************************************************************/
+static uint32_t pawr_cap_hash(const uint8_t *p_data, uint16_t len)
+{
+    uint32_t h = 2166136261UL;
+
+    while (len--)
+    {
+        h = (h ^ *p_data++) * 16777619UL;
+    }
+    return h;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_put()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues a complete record, preceded by a GAP record when earlier records were
+* lost. A record is queued whole or not at all, so the stream never contains a partial record.
+* @param[in] p_rec   , record, header included.
+* @param[in] rec_len , record length.
+* @return    void.
+**************************************************************************************************/
+static void pawr_cap_put(uint8_t *p_rec, uint16_t rec_len)
+{
+    uint8_t  gap[PAWR_CAP_REC_HDR_LEN + 4];
+    uint16_t need = rec_len + ((cap_lost != 0) ? sizeof(gap) : 0);
+
+    if (PAWR_CAP_RING_SIZE - app_bt_ring_count(&cap_ring) < need)
+    {
+        cap_lost++;
+        return;
+    }
+    if (cap_lost != 0)
+    {
+        memcpy(gap, p_rec, PAWR_CAP_REC_HDR_LEN);
+        gap[0] = PAWR_CAP_REC_GAP;
+        gap[1] = 4;
+        gap[2] = 0;
+        gap[7] = (uint8_t)cap_lost;
+        gap[8] = (uint8_t)(cap_lost >> 8);
+        gap[9] = (uint8_t)(cap_lost >> 16);
+        gap[10] = (uint8_t)(cap_lost >> 24);
+        app_bt_ring_push_batch(&cap_ring, gap, sizeof(gap));
+        cap_lost = 0;
+    }
+    app_bt_ring_push_batch(&cap_ring, p_rec, rec_len);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_hdr()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function fills a record header with the current time.
+* @param[out] p_rec       , record.
+* @param[in]  type        , record type.
+* @param[in]  payload_len , payload length.
+* @return     uint8_t * payload start.
+**************************************************************************************************/
+static uint8_t *pawr_cap_hdr(uint8_t *p_rec, uint8_t type, uint16_t payload_len)
+{
+    uint32_t ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+    p_rec[0] = type;
+    p_rec[1] = (uint8_t)payload_len;
+    p_rec[2] = (uint8_t)(payload_len >> 8);
+    p_rec[3] = (uint8_t)ms;
+    p_rec[4] = (uint8_t)(ms >> 8);
+    p_rec[5] = (uint8_t)(ms >> 16);
+    p_rec[6] = (uint8_t)(ms >> 24);
+    return &p_rec[PAWR_CAP_REC_HDR_LEN];
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_read()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes the oldest queued record out of the capture ring. The drain task prints
+* what it reads; a host runner can collect the stream the same way.
+* @param[out] p_rec    , record, header included.
+* @param[in]  rec_size , size of p_rec, at least PAWR_CAP_REC_MAX_LEN.
+* @return     uint16_t record length, 0 if none is queued.
+**************************************************************************************************/
+uint16_t pawr_cap_read(uint8_t *p_rec, uint16_t rec_size)
+{
+    uint16_t len;
+
+    /* records are pushed whole, a header in the ring means the payload is there too */
+    if ((rec_size < PAWR_CAP_REC_MAX_LEN) || (app_bt_ring_count(&cap_ring) < PAWR_CAP_REC_HDR_LEN))
+    {
+        return 0;
+    }
+    app_bt_ring_pop_batch(&cap_ring, p_rec, PAWR_CAP_REC_HDR_LEN);
+    len = (uint16_t)(p_rec[1] | (p_rec[2] << 8));
+    app_bt_ring_pop_batch(&cap_ring, &p_rec[PAWR_CAP_REC_HDR_LEN], len);
+    return (uint16_t)(PAWR_CAP_REC_HDR_LEN + len);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_drain_task()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This task prints queued records on the debug UART, away from the Bluetooth stack context.
+* @param[in] arg , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_cap_drain_task(void *arg)
+{
+    uint8_t  rec[PAWR_CAP_REC_MAX_LEN];
+    uint16_t len;
+    uint16_t i;
+
+    for (;;)
+    {
+        while ((len = pawr_cap_read(rec, sizeof(rec))) != 0)
+        {
+            printf("PCAP:");
+            for (i = 0; i < len; i++)
+            {
+                printf("%02x", rec[i]);
+            }
+            printf("\n");
+        }
+        vTaskDelay(pdMS_TO_TICKS(PAWR_CAP_DRAIN_PERIOD_MS));
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets up the capture ring and starts the drain task. Capture starts disabled.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_cap_init(void)
+{
+    app_bt_ring_init(&cap_ring, cap_ring_buf, 1, PAWR_CAP_RING_SIZE);
+    app_bt_util_cycle_counter_init();
+    if (xTaskCreate(pawr_cap_drain_task, "pawr_cap", PAWR_CAP_TASK_STACK_SIZE, NULL, PAWR_CAP_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        printf("pawr_cap_init: task create failed\n");
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_enable()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts or stops recording.
+* @param[in] enable , WICED_TRUE to record.
+* @return    void.
+**************************************************************************************************/
+void pawr_cap_enable(wiced_bool_t enable)
+{
+    cap_enabled = enable;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_record_event()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function records a PAwR relevant extended advertising event. Called by the PAwR layer
+* before the event is dispatched, in the Bluetooth stack context.
+* @param[in] event  , extended adv event code.
+* @param[in] p_data , event data.
+* @return    void.
+**************************************************************************************************/
+void pawr_cap_record_event(wiced_ble_ext_adv_event_t event, const wiced_ble_ext_adv_event_data_t *p_data)
+{
+    uint8_t  rec[PAWR_CAP_REC_MAX_LEN];
+    uint8_t  *p;
+
+    if (!cap_enabled || cap_replaying)
+    {
+        return;
+    }
+    switch (event)
+    {
+        case WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT:
+        {
+            const wiced_ble_padv_sync_established_event_data_t *ps = &p_data->sync_establish;
+
+            p = pawr_cap_hdr(rec, PAWR_CAP_REC_SYNC_EST, 19);
+            p[0]  = ps->status;
+            p[1]  = (uint8_t)ps->sync_handle;
+            p[2]  = (uint8_t)(ps->sync_handle >> 8);
+            p[3]  = ps->adv_sid;
+            p[4]  = (uint8_t)ps->adv_addr_type;
+            memcpy(&p[5], ps->adv_addr, BD_ADDR_LEN);
+            p[11] = ps->adv_phy;
+            p[12] = (uint8_t)ps->periodic_adv_int;
+            p[13] = (uint8_t)(ps->periodic_adv_int >> 8);
+            p[14] = ps->adv_clock_accuracy;
+            p[15] = ps->num_subevents;
+            p[16] = ps->subevent_interval;
+            p[17] = ps->response_slot_delay;
+            p[18] = ps->response_slot_spacing;
+            pawr_cap_put(rec, PAWR_CAP_REC_HDR_LEN + 19);
+        }
+        break;
+        case WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT:
+            p = pawr_cap_hdr(rec, PAWR_CAP_REC_SYNC_LOST, 2);
+            p[0] = (uint8_t)p_data->sync_handle;
+            p[1] = (uint8_t)(p_data->sync_handle >> 8);
+            pawr_cap_put(rec, PAWR_CAP_REC_HDR_LEN + 2);
+        break;
+        case WICED_BLE_PERIODIC_ADV_REPORT_EVENT:
+        {
+            const wiced_ble_padv_report_event_data_t *pr = &p_data->periodic_adv_report;
+
+            p = pawr_cap_hdr(rec, PAWR_CAP_REC_REPORT, (uint16_t)(10 + pr->data_length));
+            p[0] = (uint8_t)pr->sync_handle;
+            p[1] = (uint8_t)(pr->sync_handle >> 8);
+            p[2] = (uint8_t)pr->tx_power;
+            p[3] = (uint8_t)pr->rssi;
+            p[4] = pr->cte_type;
+            p[5] = pr->data_status;
+            p[6] = (uint8_t)pr->periodic_evt_counter;
+            p[7] = (uint8_t)(pr->periodic_evt_counter >> 8);
+            p[8] = pr->sub_event;
+            p[9] = pr->data_length;
+            if (pr->data_length != 0)
+            {
+                memcpy(&p[10], pr->p_data, pr->data_length);
+            }
+            pawr_cap_put(rec, (uint16_t)(PAWR_CAP_REC_HDR_LEN + 10 + pr->data_length));
+        }
+        break;
+        default:
+        break;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_record_rsp()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function records a response accepted by the controller. While replaying, the response is
+* kept for the comparison with the recording instead.
+* @param[in] p_rsp , response as handed to the controller.
+* @return    void.
+**************************************************************************************************/
+void pawr_cap_record_rsp(const wiced_ble_padv_subevent_rsp_data_t *p_rsp)
+{
+    uint8_t rec[PAWR_CAP_REC_MAX_LEN];
+    uint8_t *p;
+
+    if (cap_replaying)
+    {
+        if (cap_produced_num < PAWR_CAP_MAX_RSP_PER_EVT)
+        {
+            pawr_cap_rsp_digest_t *d = &cap_produced[cap_produced_num++];
+
+            d->evt_counter = p_rsp->req_event;
+            d->rsp_slot    = p_rsp->rsp_slot;
+            d->data_len    = p_rsp->rsp_data_len;
+            d->hash        = pawr_cap_hash(p_rsp->p_data, p_rsp->rsp_data_len);
+        }
+        else
+        {
+            cap_produced_overflow++;
+        }
+        return;
+    }
+    if (!cap_enabled)
+    {
+        return;
+    }
+    p = pawr_cap_hdr(rec, PAWR_CAP_REC_RSP, (uint16_t)(6 + p_rsp->rsp_data_len));
+    p[0] = (uint8_t)p_rsp->req_event;
+    p[1] = (uint8_t)(p_rsp->req_event >> 8);
+    p[2] = p_rsp->req_subevent;
+    p[3] = p_rsp->rsp_subevent;
+    p[4] = p_rsp->rsp_slot;
+    p[5] = p_rsp->rsp_data_len;
+    if (p_rsp->rsp_data_len != 0)
+    {
+        memcpy(&p[6], p_rsp->p_data, p_rsp->rsp_data_len);
+    }
+    pawr_cap_put(rec, (uint16_t)(PAWR_CAP_REC_HDR_LEN + 6 + p_rsp->rsp_data_len));
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_is_replaying()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function tells the PAwR layer to keep responses away from the controller.
+* @param[in] void.
+* @return    wiced_bool_t WICED_TRUE while pawr_cap_replay() runs.
+**************************************************************************************************/
+wiced_bool_t pawr_cap_is_replaying(void)
+{
+    return cap_replaying;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_settle()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function closes the comparison of the previous event: produced responses the recording
+* did not consume are extra.
+* @param[in]     consumed , recorded responses compared so far.
+* @param[in,out] p_result , replay result.
+* @return        void.
+**************************************************************************************************/
+static void pawr_cap_settle(uint8_t consumed, pawr_cap_replay_result_t *p_result)
+{
+    if (cap_produced_num > consumed)
+    {
+        p_result->rsp_extra += cap_produced_num - consumed;
+    }
+    p_result->rsp_extra  += cap_produced_overflow;
+    cap_produced_num      = 0;
+    cap_produced_overflow = 0;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_replay()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function feeds a recorded stream through the extended adv event dispatch table, the same
+* path pawr_ext_adv_callback() takes, and compares every produced response with the recorded
+* one. Run it where the stack events normally arrive: in the Bluetooth stack context on the
+* device, or from a host runner linking the PAwR sources.
+* @param[in]  p_stream   , recorded stream.
+* @param[in]  stream_len , stream length.
+* @param[in]  speedup    , 1 keeps the recorded timing, N runs N times faster, 0 does not wait.
+* @param[out] p_result   , comparison and handler latency.
+* @return     wiced_bool_t WICED_TRUE if the whole stream was replayed and matched.
+**************************************************************************************************/
+wiced_bool_t pawr_cap_replay(const uint8_t *p_stream, uint32_t stream_len, uint16_t speedup, pawr_cap_replay_result_t *p_result)
+{
+    static uint8_t                 data[255];
+    wiced_ble_ext_adv_event_data_t evt;
+    wiced_ble_ext_adv_event_t      code;
+    uint32_t                       pos      = 0;
+    uint32_t                       prev_ms  = 0;
+    wiced_bool_t                   first    = WICED_TRUE;
+    uint8_t                        consumed = 0;
+
+    if ((p_stream == NULL) || (p_result == NULL))
+    {
+        return WICED_FALSE;
+    }
+    memset(p_result, 0, sizeof(*p_result));
+    cap_produced_num      = 0;
+    cap_produced_overflow = 0;
+    cap_replaying         = WICED_TRUE;
+
+    while (pos + PAWR_CAP_REC_HDR_LEN <= stream_len)
+    {
+        const uint8_t *r    = &p_stream[pos];
+        const uint8_t *p    = &r[PAWR_CAP_REC_HDR_LEN];
+        uint16_t       plen = (uint16_t)(r[1] | (r[2] << 8));
+        uint32_t       ms   = (uint32_t)(r[3] | (r[4] << 8) | (r[5] << 16) | ((uint32_t)r[6] << 24));
+
+        if (pos + PAWR_CAP_REC_HDR_LEN + plen > stream_len)
+        {
+            p_result->malformed = WICED_TRUE;
+            break;
+        }
+        pos += PAWR_CAP_REC_HDR_LEN + plen;
+
+        if (r[0] == PAWR_CAP_REC_RSP)
+        {
+            if (plen < 6)
+            {
+                p_result->malformed = WICED_TRUE;
+                break;
+            }
+            if (consumed >= cap_produced_num)
+            {
+                p_result->rsp_missing++;
+            }
+            else
+            {
+                pawr_cap_rsp_digest_t *d = &cap_produced[consumed];
+
+                if ((d->evt_counter == (uint16_t)(p[0] | (p[1] << 8))) && (d->rsp_slot == p[4]) &&
+                    (d->data_len == p[5]) && (plen >= 6 + p[5]) && (d->hash == pawr_cap_hash(&p[6], p[5])))
+                {
+                    p_result->rsp_match++;
+                }
+                else
+                {
+                    p_result->rsp_mismatch++;
+                }
+            }
+            consumed++;
+            continue;
+        }
+        if (r[0] == PAWR_CAP_REC_GAP)
+        {
+            p_result->gaps++;
+            continue;
+        }
+
+        memset(&evt, 0, sizeof(evt));
+        switch (r[0])
+        {
+            case PAWR_CAP_REC_SYNC_EST:
+                if (plen < 19)
+                {
+                    p_result->malformed = WICED_TRUE;
+                    break;
+                }
+                code = WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT;
+                evt.sync_establish.status                = p[0];
+                evt.sync_establish.sync_handle           = (uint16_t)(p[1] | (p[2] << 8));
+                evt.sync_establish.adv_sid               = p[3];
+                evt.sync_establish.adv_addr_type         = (wiced_bt_ble_address_type_t)p[4];
+                memcpy(evt.sync_establish.adv_addr, &p[5], BD_ADDR_LEN);
+                evt.sync_establish.adv_phy               = p[11];
+                evt.sync_establish.periodic_adv_int      = (uint16_t)(p[12] | (p[13] << 8));
+                evt.sync_establish.adv_clock_accuracy    = p[14];
+                evt.sync_establish.num_subevents         = p[15];
+                evt.sync_establish.subevent_interval     = p[16];
+                evt.sync_establish.response_slot_delay   = p[17];
+                evt.sync_establish.response_slot_spacing = p[18];
+            break;
+            case PAWR_CAP_REC_SYNC_LOST:
+                if (plen < 2)
+                {
+                    p_result->malformed = WICED_TRUE;
+                    break;
+                }
+                code = WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT;
+                evt.sync_handle = (uint16_t)(p[0] | (p[1] << 8));
+            break;
+            case PAWR_CAP_REC_REPORT:
+                if ((plen < 10) || (plen < 10 + p[9]))
+                {
+                    p_result->malformed = WICED_TRUE;
+                    break;
+                }
+                code = WICED_BLE_PERIODIC_ADV_REPORT_EVENT;
+                evt.periodic_adv_report.sync_handle          = (uint16_t)(p[0] | (p[1] << 8));
+                evt.periodic_adv_report.tx_power             = (int8_t)p[2];
+                evt.periodic_adv_report.rssi                 = (int8_t)p[3];
+                evt.periodic_adv_report.cte_type             = p[4];
+                evt.periodic_adv_report.data_status          = p[5];
+                evt.periodic_adv_report.periodic_evt_counter = (uint16_t)(p[6] | (p[7] << 8));
+                evt.periodic_adv_report.sub_event            = p[8];
+                evt.periodic_adv_report.data_length          = p[9];
+                memcpy(data, &p[10], p[9]);
+                evt.periodic_adv_report.p_data               = data;
+            break;
+            default:
+                /* unknown record types from newer recorders are skipped */
+            continue;
+        }
+        if (p_result->malformed)
+        {
+            break;
+        }
+
+        pawr_cap_settle(consumed, p_result);
+        consumed = 0;
+        if (!first && (speedup != 0) && ((ms - prev_ms) / speedup != 0))
+        {
+            vTaskDelay(pdMS_TO_TICKS((ms - prev_ms) / speedup));
+        }
+        first   = WICED_FALSE;
+        prev_ms = ms;
+
+        {
+            pawr_cap_latency_t *lat   = &p_result->latency[r[0]];
+            uint32_t            start = APP_BT_UTIL_CYCLES();
+            uint32_t            cycles;
+
+            app_bt_dispatch(APP_BT_DISPATCH_EXT_ADV, code, &evt);
+            cycles = APP_BT_UTIL_CYCLES() - start;
+            lat->count++;
+            lat->cycles += cycles;
+            if (cycles > lat->cycles_max)
+            {
+                lat->cycles_max = cycles;
+            }
+        }
+        p_result->events++;
+    }
+    pawr_cap_settle(consumed, p_result);
+    cap_replaying = WICED_FALSE;
+
+    return (!p_result->malformed && (p_result->rsp_mismatch == 0) && (p_result->rsp_missing == 0) &&
+            (p_result->rsp_extra == 0)) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cap_print_result()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints a replay result.
+* @param[in] p_result , replay result.
+* @return    void.
+**************************************************************************************************/
+void pawr_cap_print_result(const pawr_cap_replay_result_t *p_result)
+{
+    static const char *name[PAWR_CAP_REC_REPORT + 1] = {"", "sync est", "sync lost", "report"};
+    uint8_t           i;
+
+    printf("pawr replay: events:%lu, match:%lu, mismatch:%lu, missing:%lu, extra:%lu, gaps:%lu%s\n",
+           (unsigned long)p_result->events,
+           (unsigned long)p_result->rsp_match,
+           (unsigned long)p_result->rsp_mismatch,
+           (unsigned long)p_result->rsp_missing,
+           (unsigned long)p_result->rsp_extra,
+           (unsigned long)p_result->gaps,
+           p_result->malformed ? ", malformed" : "");
+    for (i = PAWR_CAP_REC_SYNC_EST; i <= PAWR_CAP_REC_REPORT; i++)
+    {
+        const pawr_cap_latency_t *lat = &p_result->latency[i];
+
+        if (lat->count != 0)
+        {
+            printf("%s: cnt:%lu, avg:%lu, max:%lu cycles\n", name[i], (unsigned long)lat->count,
+                   (unsigned long)(lat->cycles / lat->count), (unsigned long)lat->cycles_max);
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,105 @@
+/******************************************************************************
+* File Name:   pawr_capture.h
+*
+* Description: This file is the public interface of the PAwR event capture and replay.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_CAPTURE_H_
+#define PAWR_CAPTURE_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Capture stream, version 1. A sequence of records, little endian:
+ *   type(1) payload_len(2) time_ms(4) payload
+ * SYNC_EST  : status, sync_handle(2), adv_sid, adv_addr_type, adv_addr(6), adv_phy,
+ *             periodic_adv_int(2), adv_clock_accuracy, num_subevents, subevent_interval,
+ *             response_slot_delay, response_slot_spacing
+ * SYNC_LOST : sync_handle(2)
+ * REPORT    : sync_handle(2), tx_power, rssi, cte_type, data_status, evt_counter(2), subevent,
+ *             data_length, data
+ * RSP       : evt_counter(2), req_subevent, rsp_subevent, rsp_slot, data_len, data, the bytes
+ *             handed to the controller
+ * GAP       : records lost since the previous record(4)
+ * Every RSP record follows the event record whose handling produced it. The device prints the
+ * stream as "PCAP:" lines of hex, one record per line. */
+#define PAWR_CAP_REC_SYNC_EST           (0x01)
+#define PAWR_CAP_REC_SYNC_LOST          (0x02)
+#define PAWR_CAP_REC_REPORT             (0x03)
+#define PAWR_CAP_REC_RSP                (0x04)
+#define PAWR_CAP_REC_GAP                (0x05)
+#define PAWR_CAP_REC_HDR_LEN            (7)
+#define PAWR_CAP_REC_MAX_LEN            (PAWR_CAP_REC_HDR_LEN + 10 + 255)
+#define PAWR_CAP_RING_SIZE              (2048)   /* bytes buffered between the stack and the drain task */
+#define PAWR_CAP_MAX_RSP_PER_EVT        (4)      /* responses compared per replayed event */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t count;
+    uint32_t cycles;
+    uint32_t cycles_max;
+} pawr_cap_latency_t;
+
+typedef struct
+{
+    uint32_t           events;                   /* event records dispatched */
+    uint32_t           rsp_match;                /* responses identical to the recording */
+    uint32_t           rsp_mismatch;             /* responses whose slot or bytes differ */
+    uint32_t           rsp_missing;              /* recorded responses not produced */
+    uint32_t           rsp_extra;                /* produced responses not in the recording */
+    uint32_t           gaps;                     /* GAP records, the recording itself lost data */
+    wiced_bool_t       malformed;                /* replay stopped on a truncated record */
+    pawr_cap_latency_t latency[PAWR_CAP_REC_REPORT + 1];   /* handler cycles per event record type */
+} pawr_cap_replay_result_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_cap_init(void);
+void pawr_cap_enable(wiced_bool_t enable);
+void pawr_cap_record_event(wiced_ble_ext_adv_event_t event, const wiced_ble_ext_adv_event_data_t *p_data);
+void pawr_cap_record_rsp(const wiced_ble_padv_subevent_rsp_data_t *p_rsp);
+uint16_t pawr_cap_read(uint8_t *p_rec, uint16_t rec_size);
+wiced_bool_t pawr_cap_is_replaying(void);
+wiced_bool_t pawr_cap_replay(const uint8_t *p_stream, uint32_t stream_len, uint16_t speedup, pawr_cap_replay_result_t *p_result);
+void pawr_cap_print_result(const pawr_cap_replay_result_t *p_result);
+#endif /* PAWR_CAPTURE_H_ */
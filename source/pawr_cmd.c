@@ -0,0 +1,386 @@
+/******************************************************************************
+* File Name:   pawr_cmd.c
+*
+* Description: This file consists of the controller command pipeline. Commands are queued, issued one at a time once the previous one completed, and timed from the call to the completion.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_timer.h"
+#include "pawr_cmd.h"
+#include "app_bt_dispatch.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_CMD_HCI_SUCCESS            (0x00)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static const pawr_cmd_t   *cmd_queue[PAWR_CMD_QUEUE_LEN];
+static uint8_t             cmd_head;
+static uint8_t             cmd_count;
+static const pawr_cmd_t   *cmd_busy = NULL;  /* issued, not complete */
+static wiced_bool_t        cmd_busy_cmplt;   /* waiting for the command complete event */
+static wiced_bool_t        cmd_busy_stale;   /* superseded, its failure restarts nothing */
+static wiced_bool_t        cmd_failed;       /* the sequence failed, its later steps are dropped */
+static uint32_t            cmd_busy_start;   /* ms, the cycle counter stops in tickless idle */
+static wiced_timer_t       cmd_timer;
+static pawr_cmd_fail_cb_t *cmd_fail_cb = NULL;
+static pawr_cmd_stats_t    cmd_stats[PAWR_CMD_MAX_IDS];
+static const char         *cmd_names[PAWR_CMD_MAX_IDS];
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void pawr_cmd_next(void);
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_now_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the local time in milliseconds.
+* @return    uint32_t time, ms.
+**************************************************************************************************/
+static uint32_t pawr_cmd_now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_drop_queue()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function drops every queued command.
+* @return    void.
+**************************************************************************************************/
+static void pawr_cmd_drop_queue(void)
+{
+    while (cmd_count != 0)
+    {
+        cmd_stats[cmd_queue[cmd_head]->id].dropped++;
+        cmd_head = (uint8_t)((cmd_head + 1) % PAWR_CMD_QUEUE_LEN);
+        cmd_count--;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_finish()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function completes the command in flight. A failure drops the commands chained behind it
+* and tells the owner, unless the command had already been superseded.
+* @param[in] status , WICED_BT_SUCCESS, or the failure.
+* @return    void.
+**************************************************************************************************/
+static void pawr_cmd_finish(wiced_bt_dev_status_t status)
+{
+    const pawr_cmd_t *p_cmd  = cmd_busy;
+    pawr_cmd_stats_t *p_stat = &cmd_stats[p_cmd->id];
+    uint32_t          ms     = pawr_cmd_now_ms() - cmd_busy_start;
+
+    if (wiced_is_timer_in_use(&cmd_timer))
+    {
+        wiced_stop_timer(&cmd_timer);
+    }
+    cmd_busy = NULL;
+    p_stat->ms_sum += ms;
+    if (ms > p_stat->ms_max)
+    {
+        p_stat->ms_max = ms;
+    }
+    if (status != WICED_BT_SUCCESS)
+    {
+        printf("pawr_cmd: %s failed: %d\n", p_cmd->name, status);
+        if (!cmd_busy_stale)
+        {
+            cmd_failed = WICED_TRUE;
+            pawr_cmd_drop_queue();
+            if (cmd_fail_cb)
+            {
+                cmd_fail_cb(p_cmd, status);
+            }
+        }
+    }
+    pawr_cmd_next();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_next()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function issues queued commands until one has to wait for its completion.
+* @return    void.
+**************************************************************************************************/
+static void pawr_cmd_next(void)
+{
+    wiced_bt_dev_status_t status;
+
+    while ((cmd_busy == NULL) && (cmd_count != 0))
+    {
+        cmd_busy       = cmd_queue[cmd_head];
+        cmd_head       = (uint8_t)((cmd_head + 1) % PAWR_CMD_QUEUE_LEN);
+        cmd_count--;
+        cmd_busy_stale = WICED_FALSE;
+        cmd_busy_start = pawr_cmd_now_ms();
+        cmd_stats[cmd_busy->id].issued++;
+        status         = cmd_busy->issue();
+        cmd_busy_cmplt = (status == WICED_BT_PENDING);
+        if ((status == WICED_BT_SUCCESS) && (cmd_busy->wait == PAWR_CMD_DONE_ON_STATUS))
+        {
+            pawr_cmd_finish(WICED_BT_SUCCESS);
+            return;
+        }
+        if ((status != WICED_BT_SUCCESS) && (status != WICED_BT_PENDING))
+        {
+            cmd_stats[cmd_busy->id].failed++;
+            pawr_cmd_finish(status);
+            return;
+        }
+        wiced_start_timer(&cmd_timer, cmd_busy->timeout_ms);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_timer_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function fails a command whose completion did not arrive in time.
+* @param[in] cb_params , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_cmd_timer_cb(WICED_TIMER_PARAM_TYPE cb_params)
+{
+    if (cmd_busy != NULL)
+    {
+        cmd_stats[cmd_busy->id].timeouts++;
+        pawr_cmd_finish(WICED_BT_TIMEOUT);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_on_cmd_cmplt()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the dispatch handler of WICED_BLE_EXT_COMMAND_CMPLT_EVENT. An event whose
+* opcode is not the one of the command in flight belongs to someone else and is left alone. A
+* failed status completes the command, also one waiting for its owner's event, which will not
+* come.
+* @param[in] event        , The extended adv event code.
+* @param[in] p_event_data , Event data refer to wiced_ble_ext_adv_event_data_t.
+* @return    wiced_result_t WICED_BT_SUCCESS.
+**************************************************************************************************/
+static wiced_result_t pawr_cmd_on_cmd_cmplt(uint32_t event, void *p_event_data)
+{
+    const wiced_ble_ext_cmd_cmplt_t *p_cmplt = &((wiced_ble_ext_adv_event_data_t *)p_event_data)->cmd_cmplt;
+
+    if ((cmd_busy == NULL) || !cmd_busy_cmplt || (p_cmplt->opcode != cmd_busy->opcode))
+    {
+        return WICED_BT_SUCCESS;
+    }
+    cmd_busy_cmplt = WICED_FALSE;
+    if (p_cmplt->status != PAWR_CMD_HCI_SUCCESS)
+    {
+        printf("pawr_cmd: %s hci status: 0x%02x\n", cmd_busy->name, p_cmplt->status);
+        cmd_stats[cmd_busy->id].failed++;
+        pawr_cmd_finish(WICED_BT_ERROR);
+    }
+    else if (cmd_busy->wait == PAWR_CMD_DONE_ON_STATUS)
+    {
+        pawr_cmd_finish(WICED_BT_SUCCESS);
+    }
+    return WICED_BT_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets up the pipeline.
+* @param[in] fail_cb , called when a command fails or times out.
+* @return    void.
+**************************************************************************************************/
+void pawr_cmd_init(pawr_cmd_fail_cb_t *fail_cb)
+{
+    cmd_fail_cb = fail_cb;
+    wiced_init_timer(&cmd_timer, pawr_cmd_timer_cb, 0, WICED_MILLI_SECONDS_TIMER);
+    app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, WICED_BLE_EXT_COMMAND_CMPLT_EVENT, pawr_cmd_on_cmd_cmplt);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_submit()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues a command behind the ones already submitted and issues it right away
+* when the pipeline is idle. Once a step failed, the rest of the sequence is dropped until the
+* next pawr_cmd_supersede().
+* @param[in] p_cmd , command.
+* @return    wiced_bool_t WICED_FALSE when the command was dropped.
+**************************************************************************************************/
+wiced_bool_t pawr_cmd_submit(const pawr_cmd_t *p_cmd)
+{
+    cmd_names[p_cmd->id] = p_cmd->name;
+    if (cmd_failed || (cmd_count == PAWR_CMD_QUEUE_LEN))
+    {
+        if (!cmd_failed)
+        {
+            printf("pawr_cmd: queue full, %s dropped\n", p_cmd->name);
+        }
+        cmd_stats[p_cmd->id].dropped++;
+        return WICED_FALSE;
+    }
+    cmd_queue[(cmd_head + cmd_count) % PAWR_CMD_QUEUE_LEN] = p_cmd;
+    cmd_count++;
+    pawr_cmd_next();
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_supersede()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts a new sequence: the queued commands of the previous one are dropped. The
+* command in flight still runs to completion, so the controller never sees two at once, but its
+* outcome no longer matters.
+* @return    void.
+**************************************************************************************************/
+void pawr_cmd_supersede(void)
+{
+    cmd_failed = WICED_FALSE;
+    pawr_cmd_drop_queue();
+    if (cmd_busy != NULL)
+    {
+        cmd_busy_stale = WICED_TRUE;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_on_event()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function completes a PAWR_CMD_DONE_ON_EVENT command in flight with the outcome the owner
+* saw in its event.
+* @param[in] ok , the event reported success.
+* @return    void.
+**************************************************************************************************/
+void pawr_cmd_on_event(wiced_bool_t ok)
+{
+    if ((cmd_busy == NULL) || (cmd_busy->wait != PAWR_CMD_DONE_ON_EVENT))
+    {
+        return;
+    }
+    if (!ok)
+    {
+        cmd_stats[cmd_busy->id].failed++;
+    }
+    pawr_cmd_finish(ok ? WICED_BT_SUCCESS : WICED_BT_ERROR);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_in_flight()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the command waiting for its completion.
+* @return    const pawr_cmd_t * command, NULL when idle.
+**************************************************************************************************/
+const pawr_cmd_t *pawr_cmd_in_flight(void)
+{
+    return cmd_busy;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the statistics of one command.
+* @param[in]  id      , command statistics slot.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_cmd_get_stats(uint8_t id, pawr_cmd_stats_t *p_stats)
+{
+    *p_stats = cmd_stats[id % PAWR_CMD_MAX_IDS];
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmd_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the statistics and latency of each command used so far.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_cmd_print_stats(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PAWR_CMD_MAX_IDS; i++)
+    {
+        if (cmd_names[i] == NULL)
+        {
+            continue;
+        }
+        printf("pawr cmd %s: issued:%lu, failed:%lu, timeouts:%lu, dropped:%lu, avg:%lu ms, max:%lu ms\n",
+               cmd_names[i],
+               (unsigned long)cmd_stats[i].issued,
+               (unsigned long)cmd_stats[i].failed,
+               (unsigned long)cmd_stats[i].timeouts,
+               (unsigned long)cmd_stats[i].dropped,
+               (unsigned long)((cmd_stats[i].issued != 0) ? (cmd_stats[i].ms_sum / cmd_stats[i].issued) : 0),
+               (unsigned long)cmd_stats[i].ms_max);
+    }
+}
@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name:   pawr_cmd.h
+*
+* Description: This file is the public interface of the controller command pipeline of the PAwR layer.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_CMD_H_
+#define PAWR_CMD_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_CMD_QUEUE_LEN              (8)
+#define PAWR_CMD_MAX_IDS                (8)      /* distinct commands with their own statistics */
+
+/* HCI opcodes the command complete event reports, matched against the command in flight */
+#define PAWR_CMD_OP_SCAN_PARAMS         (0x2041) /* LE Set Extended Scan Parameters */
+#define PAWR_CMD_OP_SCAN_ENABLE         (0x2042) /* LE Set Extended Scan Enable, also to disable */
+#define PAWR_CMD_OP_CREATE_SYNC         (0x2044) /* LE Periodic Advertising Create Sync */
+#define PAWR_CMD_OP_CANCEL_SYNC         (0x2045) /* LE Periodic Advertising Create Sync Cancel */
+#define PAWR_CMD_OP_LIST_ADD            (0x2047) /* LE Add Device To Periodic Advertiser List */
+#define PAWR_CMD_OP_LIST_CLEAR          (0x2049) /* LE Clear Periodic Advertiser List */
+#define PAWR_CMD_OP_SYNC_SUBEVENT       (0x2084) /* LE Set Periodic Sync Subevent */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+/* When a command is complete. A command whose call returns WICED_BT_PENDING waits for the
+ * command complete event in either case. */
+typedef enum
+{
+    PAWR_CMD_DONE_ON_STATUS = 0,                 /* the call returned WICED_BT_SUCCESS */
+    PAWR_CMD_DONE_ON_EVENT,                      /* the owner reports the outcome, pawr_cmd_on_event() */
+} pawr_cmd_wait_t;
+
+typedef wiced_bt_dev_status_t (pawr_cmd_issue_fn_t)(void);
+
+/* One controller operation. Commands are constant tables in the owner; the pipeline runs them
+ * one at a time in submission order. */
+typedef struct
+{
+    const char           *name;
+    pawr_cmd_issue_fn_t  *issue;
+    pawr_cmd_wait_t       wait;
+    uint16_t              timeout_ms;            /* from the call to the completion */
+    uint8_t               id;                    /* statistics slot, below PAWR_CMD_MAX_IDS */
+    uint16_t              opcode;                /* HCI opcode of its command complete event */
+} pawr_cmd_t;
+
+/* A command failed or timed out; the rest of its sequence is dropped. */
+typedef void (pawr_cmd_fail_cb_t)(const pawr_cmd_t *p_cmd, wiced_bt_dev_status_t status);
+
+typedef struct
+{
+    uint32_t issued;
+    uint32_t failed;                             /* error status, or an error event */
+    uint32_t timeouts;
+    uint32_t dropped;                            /* queued, then superseded or behind a failure */
+    uint32_t ms_sum;                             /* call to completion, RTOS ticks in ms */
+    uint32_t ms_max;
+} pawr_cmd_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_cmd_init(pawr_cmd_fail_cb_t *fail_cb);
+wiced_bool_t pawr_cmd_submit(const pawr_cmd_t *p_cmd);
+void pawr_cmd_supersede(void);
+void pawr_cmd_on_event(wiced_bool_t ok);
+const pawr_cmd_t *pawr_cmd_in_flight(void);
+void pawr_cmd_get_stats(uint8_t id, pawr_cmd_stats_t *p_stats);
+void pawr_cmd_print_stats(void);
+#endif /* PAWR_CMD_H_ */
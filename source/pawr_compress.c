@@ -0,0 +1,361 @@
+/******************************************************************************
+* File Name:   pawr_compress.c
+*
+* Description: This file consists of the PAwR response compression stage, a small LZ codec with a static dictionary for short telemetry frames. RAM use is fixed and the work per input byte is bounded.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "pawr_msg.h"
+#include "pawr_compress.h"
+#include "app_bt_utils.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_CMP_WINDOW_LEN             (PAWR_CMP_DICT_MAX_LEN + PAWR_CMP_MAX_IN_LEN)
+#define PAWR_CMP_MAX_OFFSET             (2048)
+#define PAWR_CMP_HASH(p)                ((uint8_t)((((p)[0] << 4) ^ ((p)[1] << 2) ^ (p)[2]) & (PAWR_CMP_HASH_SIZE - 1)))
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* Default dictionary: zero padding, all-ones and the sign extension of small negative readings
+ * dominate short sensor frames. Replace it with pawr_cmp_set_dict() to match the frame layout. */
+static const uint8_t cmp_default_dict[] =
+{
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,
+};
+
+static uint8_t          cmp_dict_len = 0;
+static uint8_t          cmp_window[PAWR_CMP_WINDOW_LEN];    /* dictionary, then the current frame */
+static uint16_t         cmp_dict_hash[PAWR_CMP_HASH_SIZE];  /* hash heads of the dictionary, position + 1 */
+static pawr_cmp_stats_t cmp_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_cmp_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function installs the default dictionary and clears the statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_cmp_init(void)
+{
+    memset(&cmp_stats, 0, sizeof(cmp_stats));
+    pawr_cmp_set_dict(cmp_default_dict, sizeof(cmp_default_dict));
+    app_bt_util_cycle_counter_init();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmp_set_dict()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function installs the static dictionary and hashes it once, so compression only has to
+* hash the frame. The central must decompress with the same dictionary.
+* @param[in] p_dict   , dictionary, the most useful bytes last since offsets are shorter.
+* @param[in] dict_len , dictionary length, up to PAWR_CMP_DICT_MAX_LEN.
+* @return    wiced_bool_t WICED_TRUE if installed.
+**************************************************************************************************/
+wiced_bool_t pawr_cmp_set_dict(const uint8_t *p_dict, uint8_t dict_len)
+{
+    uint16_t i;
+
+    if ((dict_len > PAWR_CMP_DICT_MAX_LEN) || ((p_dict == NULL) && (dict_len != 0)))
+    {
+        return WICED_FALSE;
+    }
+    if (dict_len != 0)
+    {
+        memcpy(cmp_window, p_dict, dict_len);
+    }
+    cmp_dict_len = dict_len;
+    memset(cmp_dict_hash, 0, sizeof(cmp_dict_hash));
+    for (i = 0; i + PAWR_CMP_MIN_MATCH <= dict_len; i++)
+    {
+        cmp_dict_hash[PAWR_CMP_HASH(&cmp_window[i])] = i + 1;
+    }
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmp_flush_literals()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function emits pending literals as runs of up to PAWR_CMP_MAX_LITERALS bytes.
+* @param[in]     p_lit    , first pending literal.
+* @param[in]     lit_len  , number of pending literals.
+* @param[out]    p_out    , output buffer.
+* @param[in,out] p_pos    , write position in p_out.
+* @param[in]     out_size , size of p_out.
+* @return        wiced_bool_t WICED_FALSE if the output does not fit.
+**************************************************************************************************/
+static wiced_bool_t pawr_cmp_flush_literals(const uint8_t *p_lit, uint16_t lit_len, uint8_t *p_out, uint16_t *p_pos, uint16_t out_size)
+{
+    uint16_t run;
+
+    while (lit_len != 0)
+    {
+        run = (lit_len > PAWR_CMP_MAX_LITERALS) ? PAWR_CMP_MAX_LITERALS : lit_len;
+        if (*p_pos + 1 + run > out_size)
+        {
+            return WICED_FALSE;
+        }
+        p_out[(*p_pos)++] = (uint8_t)(run - 1);
+        memcpy(&p_out[*p_pos], p_lit, run);
+        *p_pos  += run;
+        p_lit   += run;
+        lit_len -= run;
+    }
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmp_compress()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function compresses a frame into a PAWR_MSG_TYPE_COMPRESSED message. Greedy parse with a
+* single hash candidate per position: at most one lookup and PAWR_CMP_MAX_MATCH compares per
+* input byte, so the time is linear in the frame length.
+* @param[in]  p_in     , frame.
+* @param[in]  in_len   , frame length, PAWR_CMP_MIN_IN_LEN to PAWR_CMP_MAX_IN_LEN.
+* @param[out] p_out    , message.
+* @param[in]  out_size , size of p_out.
+* @return     uint16_t message length, 0 if the frame should be sent as it is.
+**************************************************************************************************/
+uint16_t pawr_cmp_compress(const uint8_t *p_in, uint16_t in_len, uint8_t *p_out, uint16_t out_size)
+{
+    uint16_t hash[PAWR_CMP_HASH_SIZE];
+    uint16_t end   = cmp_dict_len + in_len;
+    uint16_t pos   = cmp_dict_len;
+    uint16_t lit   = cmp_dict_len;
+    uint16_t out   = PAWR_CMP_HDR_LEN;
+    uint16_t limit;
+    uint16_t cand;
+    uint16_t len;
+    uint16_t off;
+    uint32_t start = APP_BT_UTIL_CYCLES();
+    uint32_t cycles;
+
+    cmp_stats.frames++;
+    if ((p_in == NULL) || (in_len < PAWR_CMP_MIN_IN_LEN) || (in_len > PAWR_CMP_MAX_IN_LEN))
+    {
+        return 0;
+    }
+    /* never worth more than the frame itself */
+    limit = (out_size < in_len) ? out_size : in_len;
+    if (limit <= PAWR_CMP_HDR_LEN)
+    {
+        return 0;
+    }
+
+    memcpy(&cmp_window[cmp_dict_len], p_in, in_len);
+    memcpy(hash, cmp_dict_hash, sizeof(hash));
+
+    while (pos + PAWR_CMP_MIN_MATCH <= end)
+    {
+        uint8_t h = PAWR_CMP_HASH(&cmp_window[pos]);
+
+        cand    = hash[h];
+        hash[h] = pos + 1;
+        len     = 0;
+        if (cand != 0)
+        {
+            cand--;
+            off = pos - cand;
+            while ((len < PAWR_CMP_MAX_MATCH) && (pos + len < end) && (cmp_window[cand + len] == cmp_window[pos + len]))
+            {
+                len++;
+            }
+        }
+        if (len < PAWR_CMP_MIN_MATCH)
+        {
+            pos++;
+            continue;
+        }
+
+        if (!pawr_cmp_flush_literals(&cmp_window[lit], pos - lit, p_out, &out, limit) || (out + 2 > limit))
+        {
+            return 0;
+        }
+        p_out[out++] = (uint8_t)(0x80 | ((len - PAWR_CMP_MIN_MATCH) << 3) | ((off - 1) >> 8));
+        p_out[out++] = (uint8_t)(off - 1);
+
+        /* keep the skipped positions findable, still one store per byte */
+        for (pos++, len--; len != 0; pos++, len--)
+        {
+            if (pos + PAWR_CMP_MIN_MATCH <= end)
+            {
+                hash[PAWR_CMP_HASH(&cmp_window[pos])] = pos + 1;
+            }
+        }
+        lit = pos;
+    }
+    if (!pawr_cmp_flush_literals(&cmp_window[lit], end - lit, p_out, &out, limit) || (out >= in_len))
+    {
+        return 0;
+    }
+
+    p_out[0] = PAWR_MSG_TYPE_COMPRESSED;
+    p_out[1] = (uint8_t)in_len;
+
+    cycles = APP_BT_UTIL_CYCLES() - start;
+    cmp_stats.compressed++;
+    cmp_stats.bytes_in  += in_len;
+    cmp_stats.bytes_out += out;
+    cmp_stats.cycles    += cycles;
+    if (cycles > cmp_stats.cycles_max)
+    {
+        cmp_stats.cycles_max = cycles;
+    }
+    return out;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmp_decompress()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function expands a PAWR_MSG_TYPE_COMPRESSED message, for the central side and for tests.
+* @param[in]  p_msg    , message.
+* @param[in]  msg_len  , message length.
+* @param[out] p_out    , frame.
+* @param[in]  out_size , size of p_out.
+* @return     uint16_t frame length, 0 if the message is malformed.
+**************************************************************************************************/
+uint16_t pawr_cmp_decompress(const uint8_t *p_msg, uint16_t msg_len, uint8_t *p_out, uint16_t out_size)
+{
+    uint16_t in  = PAWR_CMP_HDR_LEN;
+    uint16_t out = 0;
+    uint16_t total;
+    uint16_t len;
+    uint16_t off;
+    uint8_t  t;
+
+    if ((msg_len < PAWR_CMP_HDR_LEN) || (p_msg[0] != PAWR_MSG_TYPE_COMPRESSED) || (p_msg[1] > out_size))
+    {
+        return 0;
+    }
+    total = p_msg[1];
+
+    while ((in < msg_len) && (out < total))
+    {
+        t = p_msg[in++];
+        if ((t & 0x80) == 0)
+        {
+            len = (uint16_t)t + 1;
+            if ((in + len > msg_len) || (out + len > total))
+            {
+                return 0;
+            }
+            memcpy(&p_out[out], &p_msg[in], len);
+            in  += len;
+            out += len;
+            continue;
+        }
+        if (in >= msg_len)
+        {
+            return 0;
+        }
+        len = ((t >> 3) & 0x0F) + PAWR_CMP_MIN_MATCH;
+        off = (uint16_t)((((t & 0x07) << 8) | p_msg[in++]) + 1);
+        if ((off > out + cmp_dict_len) || (out + len > total))
+        {
+            return 0;
+        }
+        /* byte by byte, a copy may overlap its own output */
+        for (; len != 0; len--, out++)
+        {
+            p_out[out] = (off > out) ? cmp_window[cmp_dict_len - (off - out)] : p_out[out - off];
+        }
+    }
+    return ((in == msg_len) && (out == total)) ? total : 0;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmp_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the compression statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_cmp_get_stats(pawr_cmp_stats_t *p_stats)
+{
+    if (p_stats)
+    {
+        *p_stats = cmp_stats;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_cmp_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the compression ratio and cycles per input byte.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_cmp_print_stats(void)
+{
+    printf("pawr cmp: frames:%lu, compressed:%lu, in:%lu, out:%lu (%lu%%), cyc/byte:%lu, cyc max:%lu\n",
+           (unsigned long)cmp_stats.frames,
+           (unsigned long)cmp_stats.compressed,
+           (unsigned long)cmp_stats.bytes_in,
+           (unsigned long)cmp_stats.bytes_out,
+           (unsigned long)((cmp_stats.bytes_in != 0) ? (cmp_stats.bytes_out * 100 / cmp_stats.bytes_in) : 0),
+           (unsigned long)((cmp_stats.bytes_in != 0) ? (cmp_stats.cycles / cmp_stats.bytes_in) : 0),
+           (unsigned long)cmp_stats.cycles_max);
+}
+
+/* [] END OF FILE */
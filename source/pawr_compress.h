@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:   pawr_compress.h
+*
+* Description: This file is the public interface of the PAwR response compression stage.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_COMPRESS_H_
+#define PAWR_COMPRESS_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Compressed response: type, original length, LZ token stream. Tokens:
+ *   0LLLLLLL                    literal run of L+1 bytes, the bytes follow
+ *   1LLLLOOO OOOOOOOO           copy L+3 bytes from O+1 bytes back, may reach into the dictionary
+ * The window is the static dictionary followed by the frame itself. */
+#define PAWR_CMP_HDR_LEN                (2)
+#define PAWR_CMP_MAX_IN_LEN             (255)    /* largest frame, original length is one byte */
+#define PAWR_CMP_MIN_IN_LEN             (8)      /* shorter frames are sent as they are */
+#define PAWR_CMP_DICT_MAX_LEN           (64)     /* static dictionary, shared with the central */
+#define PAWR_CMP_MIN_MATCH              (3)
+#define PAWR_CMP_MAX_MATCH              (18)
+#define PAWR_CMP_MAX_LITERALS           (128)
+#define PAWR_CMP_HASH_SIZE              (64)     /* one candidate per hash, bounds work per byte */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t frames;                             /* frames offered to pawr_cmp_compress() */
+    uint32_t compressed;                         /* frames sent compressed */
+    uint32_t bytes_in;                           /* original bytes of compressed frames */
+    uint32_t bytes_out;                          /* compressed bytes, header included */
+    uint32_t cycles;                             /* cycles spent compressing */
+    uint32_t cycles_max;                         /* worst single frame */
+} pawr_cmp_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_cmp_init(void);
+wiced_bool_t pawr_cmp_set_dict(const uint8_t *p_dict, uint8_t dict_len);
+uint16_t pawr_cmp_compress(const uint8_t *p_in, uint16_t in_len, uint8_t *p_out, uint16_t out_size);
+uint16_t pawr_cmp_decompress(const uint8_t *p_msg, uint16_t msg_len, uint8_t *p_out, uint16_t out_size);
+void pawr_cmp_get_stats(pawr_cmp_stats_t *p_stats);
+void pawr_cmp_print_stats(void);
+#endif /* PAWR_COMPRESS_H_ */
@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name:   pawr_config.h
+*
+* Description: This file is the single compile-time configuration of the PAwR schedule. Every value can be overridden by the PAWR_CFG_* Makefile variable of the same name; buffer and table sizes of the PAwR layer are derived from it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_CONFIG_H_
+#define PAWR_CONFIG_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Periodic advertising train of the central */
+#ifndef PAWR_CFG_EXT_ADV_SET_ID
+#define PAWR_CFG_EXT_ADV_SET_ID         (0x00)   /* extended adv set id */
+#endif
+#ifndef PAWR_CFG_SYNC_TIMEOUT
+#define PAWR_CFG_SYNC_TIMEOUT           (1000)   /* 10 second 1000*10ms */
+#endif
+#ifndef PAWR_CFG_CENTRAL_ADDR
+#define PAWR_CFG_CENTRAL_ADDR           0xc0,0x01,0x02,0x03,0x04,0x05
+#endif
+
+/* Discovery mode: service data of a central's extended advertising, see pawr_discover.h */
+#ifndef PAWR_CFG_DISC_UUID
+#define PAWR_CFG_DISC_UUID              (0x1857)   /* 16-bit service UUID, the ESL service */
+#endif
+#ifndef PAWR_CFG_NETWORK_ID
+#define PAWR_CFG_NETWORK_ID             (0x0001)   /* centrals of other networks are ignored */
+#endif
+
+/* Subevents this peripheral synchronizes to: FIRST_SUBEVENT .. FIRST_SUBEVENT + NUM_SUBEVENTS - 1 */
+#ifndef PAWR_CFG_FIRST_SUBEVENT
+#define PAWR_CFG_FIRST_SUBEVENT         (0)
+#endif
+#ifndef PAWR_CFG_NUM_SUBEVENTS
+#define PAWR_CFG_NUM_SUBEVENTS          (2)
+#endif
+
+/* Response slots */
+#ifndef PAWR_CFG_RSP_SLOT
+#define PAWR_CFG_RSP_SLOT               (0)      /* first response slot used by peripherals */
+#endif
+#ifndef PAWR_CFG_RSP_SLOT_NUM
+#define PAWR_CFG_RSP_SLOT_NUM           (1)      /* slots peripherals are spread across by unique ID */
+#endif
+#ifndef PAWR_CFG_RSP_MAX_DATA_LEN
+#define PAWR_CFG_RSP_MAX_DATA_LEN       (64)     /* max response data buffered by the PAwR layer */
+#endif
+
+/* Application payload */
+#ifndef PAWR_CFG_BUF_SIZE
+#define PAWR_CFG_BUF_SIZE               (16)
+#endif
+
+/* Scanning for the train */
+#ifndef PAWR_CFG_SCAN_INTERVAL
+#define PAWR_CFG_SCAN_INTERVAL          WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_INTERVAL
+#endif
+#ifndef PAWR_CFG_SCAN_WINDOW
+#define PAWR_CFG_SCAN_WINDOW            WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_WINDOW
+#endif
+
+/* Adaptive periodic event skipping, see pawr_skip.h */
+#ifndef PAWR_CFG_SKIP_MAX_LATENCY_MS
+#define PAWR_CFG_SKIP_MAX_LATENCY_MS    (2000)   /* longest gap between received events */
+#endif
+#ifndef PAWR_CFG_SKIP_QUIET_MS
+#define PAWR_CFG_SKIP_QUIET_MS          (10000)  /* quiet time before each skip increase */
+#endif
+#ifndef PAWR_CFG_SKIP_HOLD_MS
+#define PAWR_CFG_SKIP_HOLD_MS           (30000)  /* least time between a skip change and the next increase */
+#endif
+
+/* Firmware update over the downlink, see pawr_ota.h. Chunks arrive on one of the subevents above
+ * and are written to the secondary image slot in the serial flash. */
+#ifndef PAWR_CFG_OTA_SUBEVENT
+#define PAWR_CFG_OTA_SUBEVENT           (PAWR_CFG_FIRST_SUBEVENT + PAWR_CFG_NUM_SUBEVENTS - 1)
+#endif
+#ifndef PAWR_CFG_OTA_SLOT_ADDR
+#define PAWR_CFG_OTA_SLOT_ADDR          (0x00100000)   /* secondary slot offset in the serial flash */
+#endif
+#ifndef PAWR_CFG_OTA_SLOT_SIZE
+#define PAWR_CFG_OTA_SLOT_SIZE          (0x00080000)   /* bytes, a multiple of the erase size */
+#endif
+
+/* Display frame updates, see pawr_frame.h. The frame is ROW_BYTES wide and HEIGHT rows high;
+ * unless it is kept in RAM it lives in the serial flash at FRAME_FLASH_ADDR. */
+#ifndef PAWR_CFG_FRAME_ROW_BYTES
+#define PAWR_CFG_FRAME_ROW_BYTES        (50)           /* 400 pixels at 1 bit per pixel */
+#endif
+#ifndef PAWR_CFG_FRAME_HEIGHT
+#define PAWR_CFG_FRAME_HEIGHT           (300)
+#endif
+#ifndef PAWR_CFG_FRAME_FLASH_ADDR
+#define PAWR_CFG_FRAME_FLASH_ADDR       (0x00180000)   /* serial flash offset, after the OTA slot */
+#endif
+
+/* Uplink backlog, see pawr_backlog.h. Records wait in RAM and spill to the serial flash at
+ * BACKLOG_FLASH_ADDR when it fills; a BACKLOG_FLASH_SIZE of 0 keeps them in RAM only. The RAM is
+ * split between the queues to and from the backlog task. */
+#ifndef PAWR_CFG_BACKLOG_RAM_LEN
+#define PAWR_CFG_BACKLOG_RAM_LEN        (1024)         /* bytes, record headers included, power of two */
+#endif
+#ifndef PAWR_CFG_BACKLOG_FLASH_ADDR
+#define PAWR_CFG_BACKLOG_FLASH_ADDR     (0x00190000)   /* serial flash offset, after the frame store */
+#endif
+#ifndef PAWR_CFG_BACKLOG_FLASH_SIZE
+#define PAWR_CFG_BACKLOG_FLASH_SIZE     (0x00010000)   /* bytes, at least two erase sectors */
+#endif
+
+/* Derived sizes. Tables indexed by subevent number hold exactly the subevents in use instead of
+ * the 128 a train can have. */
+#define PAWR_CFG_SUBEVENT_TABLE_LEN     (PAWR_CFG_FIRST_SUBEVENT + PAWR_CFG_NUM_SUBEVENTS)
+
+_Static_assert((PAWR_CFG_NUM_SUBEVENTS >= 1) && (PAWR_CFG_SUBEVENT_TABLE_LEN <= 128), "PAwR trains have 1 to 128 subevents");
+_Static_assert((PAWR_CFG_RSP_SLOT_NUM >= 1) && (PAWR_CFG_RSP_SLOT + PAWR_CFG_RSP_SLOT_NUM <= 255), "bad response slot range");
+_Static_assert((PAWR_CFG_RSP_MAX_DATA_LEN >= PAWR_CFG_BUF_SIZE) && (PAWR_CFG_RSP_MAX_DATA_LEN <= 247), "bad response length");
+
+_Static_assert((PAWR_CFG_OTA_SUBEVENT >= PAWR_CFG_FIRST_SUBEVENT) && (PAWR_CFG_OTA_SUBEVENT < PAWR_CFG_SUBEVENT_TABLE_LEN), "OTA subevent is not synchronized");
+
+#endif /* PAWR_CONFIG_H_ */
@@ -0,0 +1,315 @@
+/******************************************************************************
+* File Name:   pawr_data_store.c
+*
+* Description: This file consists of the versioned PAwR downlink data store. Delta messages from the central update a key-value image in RAM; readers in any task get consistent copies through a sequence lock.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <stdatomic.h>
+#include "wiced_bt_ble.h"
+#include "pawr_msg.h"
+#include "pawr_data_store.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* Single writer, the Bluetooth stack context. ds_seq is odd while the image is being written. */
+static pawr_ds_image_t       ds_image;
+static atomic_uint           ds_seq;
+static pawr_ds_stats_t       ds_stats;
+static pawr_ds_update_cb_t * ds_update_cb = NULL;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_ds_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears the image and the statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_ds_init(void)
+{
+    atomic_init(&ds_seq, 0);
+    memset(&ds_image, 0, sizeof(ds_image));
+    memset(&ds_stats, 0, sizeof(ds_stats));
+    ds_image.version = PAWR_DS_VERSION_NONE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ds_reg_update_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function reg the data store update callback.
+* @param[in] callback, called after each applied delta.
+* @return void.
+**************************************************************************************************/
+void pawr_ds_reg_update_cb(pawr_ds_update_cb_t *callback)
+{
+    ds_update_cb = callback;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ds_validate()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function checks the record framing of a delta so that a bad message never leaves a half
+* written image behind.
+* @param[in] p_rec   , first record.
+* @param[in] rec_len , length of all records.
+* @return    wiced_bool_t WICED_TRUE if every record is well formed.
+**************************************************************************************************/
+static wiced_bool_t pawr_ds_validate(const uint8_t *p_rec, uint16_t rec_len)
+{
+    uint16_t pos = 0;
+
+    while (pos < rec_len)
+    {
+        if ((rec_len - pos < 2) ||
+            (p_rec[pos] >= PAWR_DS_MAX_KEYS) ||
+            (p_rec[pos + 1] > PAWR_DS_MAX_VALUE_LEN) ||
+            (rec_len - pos - 2 < p_rec[pos + 1]))
+        {
+            return WICED_FALSE;
+        }
+        pos += 2 + p_rec[pos + 1];
+    }
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ds_apply()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function applies a delta message to the image. A report carrying the current version is
+* rejected after reading its two version bytes, so unchanged broadcasts cost almost nothing.
+* @param[in] p_msg   , delta message starting with PAWR_MSG_TYPE_DS_DELTA.
+* @param[in] msg_len , length of the message.
+* @return    wiced_bool_t WICED_TRUE if the image changed.
+**************************************************************************************************/
+wiced_bool_t pawr_ds_apply(const uint8_t *p_msg, uint16_t msg_len)
+{
+    uint16_t version;
+    uint16_t base_version;
+    uint8_t  flags;
+    uint32_t changed = 0;
+    uint16_t pos;
+    uint32_t seq;
+
+    if (msg_len < PAWR_DS_HDR_LEN)
+    {
+        ds_stats.malformed++;
+        return WICED_FALSE;
+    }
+    version = (uint16_t)(p_msg[1] | (p_msg[2] << 8));
+    if (version == ds_image.version)
+    {
+        ds_stats.unchanged++;
+        return WICED_FALSE;
+    }
+    base_version = (uint16_t)(p_msg[3] | (p_msg[4] << 8));
+    flags        = p_msg[5];
+    if (!(flags & PAWR_DS_FLAG_FULL) && (base_version != ds_image.version))
+    {
+        /* a delta was missed, wait for the central to resend or send a full image */
+        ds_stats.gap++;
+        return WICED_FALSE;
+    }
+    if (!pawr_ds_validate(&p_msg[PAWR_DS_HDR_LEN], (uint16_t)(msg_len - PAWR_DS_HDR_LEN)))
+    {
+        ds_stats.malformed++;
+        return WICED_FALSE;
+    }
+
+    seq = atomic_load_explicit(&ds_seq, memory_order_relaxed);
+    atomic_store_explicit(&ds_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    if (flags & PAWR_DS_FLAG_FULL)
+    {
+        for (pos = 0; pos < PAWR_DS_MAX_KEYS; pos++)
+        {
+            if (ds_image.len[pos] != 0)
+            {
+                changed |= (1UL << pos);
+            }
+        }
+        memset(ds_image.len, 0, sizeof(ds_image.len));
+    }
+    pos = PAWR_DS_HDR_LEN;
+    while (pos < msg_len)
+    {
+        uint8_t key = p_msg[pos];
+        uint8_t len = p_msg[pos + 1];
+
+        memcpy(ds_image.value[key], &p_msg[pos + 2], len);
+        ds_image.len[key] = len;
+        changed |= (1UL << key);
+        pos += 2 + len;
+    }
+    ds_image.version = version;
+
+    atomic_store_explicit(&ds_seq, seq + 2, memory_order_release);
+
+    ds_stats.applied++;
+    if (ds_update_cb)
+    {
+        ds_update_cb(version, changed);
+    }
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ds_read()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies one value out of the image. Safe from any task; retries while the
+* Bluetooth stack is writing.
+* @param[in]  key       , key id.
+* @param[out] p_buf     , destination for the value.
+* @param[in]  buf_len   , size of p_buf, the value is truncated to it.
+* @param[out] p_version , image version the value belongs to, may be NULL.
+* @return     uint8_t length of the value, 0 if the key is absent.
+**************************************************************************************************/
+uint8_t pawr_ds_read(uint8_t key, uint8_t *p_buf, uint8_t buf_len, uint16_t *p_version)
+{
+    uint32_t seq;
+    uint8_t  len;
+    uint16_t version;
+
+    if (key >= PAWR_DS_MAX_KEYS)
+    {
+        return 0;
+    }
+    do
+    {
+        seq = atomic_load_explicit(&ds_seq, memory_order_acquire);
+        if (seq & 1)
+        {
+            continue;
+        }
+        len = ds_image.len[key];
+        if (len > buf_len)
+        {
+            len = buf_len;
+        }
+        memcpy(p_buf, ds_image.value[key], len);
+        version = ds_image.version;
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || (seq != atomic_load_explicit(&ds_seq, memory_order_relaxed)));
+
+    if (p_version)
+    {
+        *p_version = version;
+    }
+    return len;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ds_snapshot()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the whole image. Safe from any task.
+* @param[out] p_image , destination.
+* @return     void.
+**************************************************************************************************/
+void pawr_ds_snapshot(pawr_ds_image_t *p_image)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = atomic_load_explicit(&ds_seq, memory_order_acquire);
+        if (seq & 1)
+        {
+            continue;
+        }
+        memcpy(p_image, &ds_image, sizeof(ds_image));
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || (seq != atomic_load_explicit(&ds_seq, memory_order_relaxed)));
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ds_get_version()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the current image version.
+* @param[in] void.
+* @return    uint16_t image version or PAWR_DS_VERSION_NONE.
+**************************************************************************************************/
+uint16_t pawr_ds_get_version(void)
+{
+    return ds_image.version;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ds_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the data store statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_ds_get_stats(pawr_ds_stats_t *p_stats)
+{
+    if (p_stats != NULL)
+    {
+        *p_stats = ds_stats;
+    }
+}
+
+/* [] END OF FILE */
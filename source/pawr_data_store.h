@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name:   pawr_data_store.h
+*
+* Description: This file consists of the inteface for the versioned PAwR downlink data store.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_DATA_STORE_H_
+#define PAWR_DATA_STORE_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_DS_MAX_KEYS                (16)     /* keys in the image, key ids 0..PAWR_DS_MAX_KEYS-1 */
+#define PAWR_DS_MAX_VALUE_LEN           (16)     /* max value length per key */
+#define PAWR_DS_VERSION_NONE            (0xFFFF) /* image has never been written */
+
+/* Delta message: type, version(LE16), base_version(LE16), flags, then records of
+ * key(1), len(1), value(len). len 0 deletes the key. The delta applies only on top of
+ * base_version unless PAWR_DS_FLAG_FULL is set, which clears the image first. */
+#define PAWR_DS_HDR_LEN                 (6)
+#define PAWR_DS_FLAG_FULL               (0x01)
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint16_t version;
+    uint8_t  len[PAWR_DS_MAX_KEYS];              /* 0 when the key is absent */
+    uint8_t  value[PAWR_DS_MAX_KEYS][PAWR_DS_MAX_VALUE_LEN];
+} pawr_ds_image_t;
+
+typedef struct
+{
+    uint32_t applied;                            /* deltas written to the image */
+    uint32_t unchanged;                          /* reports skipped, version already current */
+    uint32_t gap;                                /* deltas dropped, base_version did not match */
+    uint32_t malformed;                          /* deltas dropped, bad framing */
+} pawr_ds_stats_t;
+
+/* Called in the Bluetooth stack context after a delta is applied. changed_keys has one bit per key. */
+typedef void (pawr_ds_update_cb_t)(uint16_t version, uint32_t changed_keys);
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_ds_init(void);
+void pawr_ds_reg_update_cb(pawr_ds_update_cb_t *callback);
+wiced_bool_t pawr_ds_apply(const uint8_t *p_msg, uint16_t msg_len);
+uint8_t pawr_ds_read(uint8_t key, uint8_t *p_buf, uint8_t buf_len, uint16_t *p_version);
+void pawr_ds_snapshot(pawr_ds_image_t *p_image);
+uint16_t pawr_ds_get_version(void);
+void pawr_ds_get_stats(pawr_ds_stats_t *p_stats);
+#endif /* PAWR_DATA_STORE_H_ */
+
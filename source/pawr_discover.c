@@ -0,0 +1,434 @@
+/******************************************************************************
+* File Name:   pawr_discover.c
+*
+* Description: This file consists of the PAwR central discovery mode. Extended advertising reports are parsed for the network's service data, the centrals heard are ranked by RSSI and advertised load, and the sync goes to the best one on its own advertising set ID.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_timer.h"
+#include "pawr.h"
+#include "pawr_discover.h"
+#ifdef ENABLE_PAWR_ROAM
+#include "pawr_roam.h"
+#endif
+#include "app_bt_dispatch.h"
+#include "app_bt_utils.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_DISC_NONE                  (-1)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef enum
+{
+    PAWR_DISC_IDLE = 0,
+    PAWR_DISC_SCANNING,                          /* collecting candidates */
+    PAWR_DISC_CHOSEN,                            /* best central picked, sync not requested yet */
+    PAWR_DISC_SYNCING,                           /* create sync to the choice outstanding */
+} pawr_disc_state_t;
+
+typedef struct
+{
+    wiced_bt_ble_address_type_t addr_type;
+    wiced_bt_device_address_t   addr;
+    uint8_t                     sid;
+    uint8_t                     load;            /* percent */
+    uint8_t                     samples;
+    int16_t                     rssi;            /* averaged, dBm */
+} pawr_disc_cand_t;
+
+static pawr_disc_cand_t     disc_cand[PAWR_DISC_MAX_CANDIDATES];
+static uint8_t              disc_num       = 0;
+static int8_t               disc_choice    = PAWR_DISC_NONE;
+static pawr_disc_state_t    disc_state     = PAWR_DISC_IDLE;
+static uint32_t             disc_start_ms  = 0;
+static wiced_bt_device_address_t disc_avoid_addr;             /* last choice that did not sync */
+static uint8_t              disc_avoid_sid = 0;
+static uint32_t             disc_avoid_ms  = 0;
+static wiced_bool_t         disc_avoiding  = WICED_FALSE;
+static wiced_timer_t        disc_timer;
+static pawr_disc_stats_t    disc_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_disc_now_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the local time in milliseconds.
+* @return    uint32_t time, ms.
+**************************************************************************************************/
+static uint32_t pawr_disc_now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_score()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function ranks a candidate: its RSSI, less a penalty for the load it advertises.
+* @param[in] p_c , candidate.
+* @return    int16_t score, higher is better.
+**************************************************************************************************/
+static int16_t pawr_disc_score(const pawr_disc_cand_t *p_c)
+{
+    return (int16_t)(p_c->rssi - (p_c->load * PAWR_DISC_LOAD_DB) / 100);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_parse()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function looks for the network's service data in advertising data.
+* @param[in]  p_data , advertising data.
+* @param[in]  len    , data length.
+* @param[out] p_load , advertised load, percent.
+* @return     wiced_bool_t WICED_TRUE when the advertiser is a central of this network.
+**************************************************************************************************/
+static wiced_bool_t pawr_disc_parse(const uint8_t *p_data, uint16_t len, uint8_t *p_load)
+{
+    uint16_t pos = 0;
+    uint8_t  ad_len;
+
+    while ((pos + 2) <= len)
+    {
+        ad_len = p_data[pos];
+        if ((ad_len == 0) || ((pos + 1 + ad_len) > len))
+        {
+            /* padding, or a structure cut short */
+            break;
+        }
+        if ((p_data[pos + 1] == PAWR_DISC_AD_SERVICE_DATA) && ((ad_len - 1) >= PAWR_DISC_SVC_DATA_LEN) &&
+            ((p_data[pos + 2] | (p_data[pos + 3] << 8)) == PAWR_CFG_DISC_UUID) &&
+            ((p_data[pos + 4] | (p_data[pos + 5] << 8)) == PAWR_CFG_NETWORK_ID))
+        {
+            *p_load = (p_data[pos + 6] > 100) ? 100 : p_data[pos + 6];
+            return WICED_TRUE;
+        }
+        pos = (uint16_t)(pos + 1 + ad_len);
+    }
+    return WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_update()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function folds one report into the candidate table. When the table is full, a new
+* central replaces the lowest ranked one if it ranks higher.
+* @param[in] p_rpt , extended advertising report.
+* @param[in] load  , advertised load, percent.
+* @return    void.
+**************************************************************************************************/
+static void pawr_disc_update(const wiced_ble_ext_scan_results_t *p_rpt, uint8_t load)
+{
+    pawr_disc_cand_t *p_c   = NULL;
+    pawr_disc_cand_t  fresh;
+    uint8_t           worst = 0;
+    uint8_t           i;
+
+    for (i = 0; i < disc_num; i++)
+    {
+        if ((disc_cand[i].sid == p_rpt->adv_sid) && (memcmp(disc_cand[i].addr, p_rpt->bd_addr, BD_ADDR_LEN) == 0))
+        {
+            p_c = &disc_cand[i];
+            break;
+        }
+        if (pawr_disc_score(&disc_cand[i]) < pawr_disc_score(&disc_cand[worst]))
+        {
+            worst = i;
+        }
+    }
+    if (p_c != NULL)
+    {
+        p_c->rssi += (int16_t)((p_rpt->rssi - p_c->rssi) / (1 << PAWR_DISC_EWMA_SHIFT));
+        p_c->load  = load;
+        if (p_c->samples < UINT8_MAX)
+        {
+            p_c->samples++;
+        }
+        return;
+    }
+
+    memset(&fresh, 0, sizeof(fresh));
+    fresh.addr_type = p_rpt->addr_type;
+    fresh.sid       = p_rpt->adv_sid;
+    fresh.load      = load;
+    fresh.samples   = 1;
+    fresh.rssi      = p_rpt->rssi;
+    memcpy(fresh.addr, p_rpt->bd_addr, BD_ADDR_LEN);
+    if (disc_num < PAWR_DISC_MAX_CANDIDATES)
+    {
+        disc_cand[disc_num++] = fresh;
+    }
+    else if (pawr_disc_score(&fresh) > pawr_disc_score(&disc_cand[worst]))
+    {
+        disc_cand[worst] = fresh;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_on_scan_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the dispatch handler of extended advertising reports while discovering.
+* @param[in] event        , APP_BT_DISPATCH_EXT_SCAN_REPORT.
+* @param[in] p_event_data , wiced_ble_ext_scan_results_t.
+* @return    wiced_result_t WICED_BT_SUCCESS.
+**************************************************************************************************/
+static wiced_result_t pawr_disc_on_scan_report(uint32_t event, void *p_event_data)
+{
+    wiced_ble_ext_scan_results_t *p_rpt = (wiced_ble_ext_scan_results_t *)p_event_data;
+    uint32_t                      start = APP_BT_UTIL_CYCLES();
+    uint8_t                       load;
+
+    /* only advertising sets with a periodic train can be synced to */
+    if ((disc_state != PAWR_DISC_SCANNING) || (p_rpt->periodic_adv_interval == 0) || (p_rpt->p_data == NULL))
+    {
+        return WICED_BT_SUCCESS;
+    }
+    disc_stats.reports++;
+    if (disc_avoiding && ((pawr_disc_now_ms() - disc_avoid_ms) >= PAWR_DISC_AVOID_MS))
+    {
+        disc_avoiding = WICED_FALSE;
+    }
+    if (pawr_disc_parse(p_rpt->p_data, p_rpt->data_length, &load) &&
+        !(disc_avoiding && (p_rpt->adv_sid == disc_avoid_sid) && (memcmp(p_rpt->bd_addr, disc_avoid_addr, BD_ADDR_LEN) == 0)))
+    {
+        disc_stats.matched++;
+        pawr_disc_update(p_rpt, load);
+    }
+    disc_stats.cycles += APP_BT_UTIL_CYCLES() - start;
+    return WICED_BT_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_timer_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function picks the best candidate once the window allows it, or gives up on a choice
+* that did not sync.
+* @param[in] cb_params , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_disc_timer_cb(WICED_TIMER_PARAM_TYPE cb_params)
+{
+    uint32_t now = pawr_disc_now_ms();
+    uint32_t elapsed;
+    int8_t   best = PAWR_DISC_NONE;
+    uint8_t  i;
+
+    if (disc_state == PAWR_DISC_SYNCING)
+    {
+        printf("pawr disc: sync timeout\n");
+        pawr_scan_for_pawr_network();
+        return;
+    }
+    if (disc_state != PAWR_DISC_SCANNING)
+    {
+        return;
+    }
+
+    elapsed = now - disc_start_ms;
+    for (i = 0; i < disc_num; i++)
+    {
+        if ((best == PAWR_DISC_NONE) || (pawr_disc_score(&disc_cand[i]) > pawr_disc_score(&disc_cand[best])))
+        {
+            best = (int8_t)i;
+        }
+    }
+    if ((best == PAWR_DISC_NONE) ||
+        ((elapsed < PAWR_DISC_WINDOW_MS) && ((elapsed < PAWR_DISC_MIN_MS) || (disc_cand[best].samples < PAWR_DISC_MIN_SAMPLES))))
+    {
+        wiced_start_timer(&disc_timer, PAWR_DISC_CHECK_MS);
+        return;
+    }
+
+    disc_stats.discoveries++;
+    disc_stats.disc_ms_sum += elapsed;
+    if (elapsed > disc_stats.disc_ms_max)
+    {
+        disc_stats.disc_ms_max = elapsed;
+    }
+    disc_choice = best;
+    disc_state  = PAWR_DISC_CHOSEN;
+    printf("pawr disc: %d centrals, chose sid:%d, rssi:%d, load:%d%% after %lu ms, addr: ", disc_num,
+           disc_cand[best].sid, disc_cand[best].rssi, disc_cand[best].load, (unsigned long)elapsed);
+    app_bt_util_print_bd_address(disc_cand[best].addr);
+    pawr_scan_for_pawr_network();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function initializes the discovery mode.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_disc_init(void)
+{
+    wiced_init_timer(&disc_timer, pawr_disc_timer_cb, 0, WICED_MILLI_SECONDS_TIMER);
+    app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, pawr_disc_on_scan_report);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_prepare_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function fills in the create sync parameters for the chosen central. Without a choice it
+* starts a discovery; the scan then runs without a create sync, and the PAwR layer scans again
+* once a central is chosen. A choice still syncing counts as failed and is avoided for a while.
+* @param[in,out] p_sync , create sync parameters.
+* @return        wiced_bool_t WICED_FALSE while discovering.
+**************************************************************************************************/
+wiced_bool_t pawr_disc_prepare_sync(wiced_ble_padv_create_sync_params_t *p_sync)
+{
+    uint32_t now = pawr_disc_now_ms();
+
+    if (wiced_is_timer_in_use(&disc_timer))
+    {
+        wiced_stop_timer(&disc_timer);
+    }
+    if (disc_state == PAWR_DISC_SYNCING)
+    {
+        disc_stats.sync_fails++;
+        disc_avoiding  = WICED_TRUE;
+        disc_avoid_ms  = now;
+        disc_avoid_sid = disc_cand[disc_choice].sid;
+        memcpy(disc_avoid_addr, disc_cand[disc_choice].addr, BD_ADDR_LEN);
+    }
+    if (disc_state == PAWR_DISC_CHOSEN)
+    {
+        p_sync->options       = WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST;
+        p_sync->adv_addr_type = disc_cand[disc_choice].addr_type;
+        p_sync->adv_sid       = disc_cand[disc_choice].sid;
+        memcpy(p_sync->adv_addr, disc_cand[disc_choice].addr, BD_ADDR_LEN);
+        disc_state = PAWR_DISC_SYNCING;
+        wiced_start_timer(&disc_timer, PAWR_DISC_SYNC_TIMEOUT_MS);
+        return WICED_TRUE;
+    }
+
+    disc_num      = 0;
+    disc_choice   = PAWR_DISC_NONE;
+    disc_state    = PAWR_DISC_SCANNING;
+    disc_start_ms = now;
+    wiced_start_timer(&disc_timer, PAWR_DISC_CHECK_MS);
+    return WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_on_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function ends the discovery. With roaming, every central heard becomes a known central.
+* @param[in] ps , sync established event data.
+* @return    void.
+**************************************************************************************************/
+void pawr_disc_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps)
+{
+#ifdef ENABLE_PAWR_ROAM
+    uint8_t i;
+
+    for (i = 0; i < disc_num; i++)
+    {
+        pawr_roam_add_central(disc_cand[i].addr_type, disc_cand[i].addr, disc_cand[i].sid);
+    }
+#endif
+    if (wiced_is_timer_in_use(&disc_timer))
+    {
+        wiced_stop_timer(&disc_timer);
+    }
+    disc_state = PAWR_DISC_IDLE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the discovery statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_disc_get_stats(pawr_disc_stats_t *p_stats)
+{
+    *p_stats = disc_stats;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_disc_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the discovery statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_disc_print_stats(void)
+{
+    printf("pawr disc: reports:%lu, matched:%lu, cycles/report:%lu, discoveries:%lu, avg:%lu max:%lu ms, sync fails:%lu\n",
+           (unsigned long)disc_stats.reports,
+           (unsigned long)disc_stats.matched,
+           (unsigned long)((disc_stats.reports != 0) ? (disc_stats.cycles / disc_stats.reports) : 0),
+           (unsigned long)disc_stats.discoveries,
+           (unsigned long)((disc_stats.discoveries != 0) ? (disc_stats.disc_ms_sum / disc_stats.discoveries) : 0),
+           (unsigned long)disc_stats.disc_ms_max,
+           (unsigned long)disc_stats.sync_fails);
+}
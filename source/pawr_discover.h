@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name:   pawr_discover.h
+*
+* Description: This file is the public interface of the PAwR central discovery mode.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_DISCOVER_H_
+#define PAWR_DISCOVER_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* A central marks its extended advertising with a service data AD structure:
+ *   length, type 0x16, UUID (LE16, PAWR_CFG_DISC_UUID), network ID (LE16, PAWR_CFG_NETWORK_ID),
+ *   load (percent of its response slots in use)
+ * The advertising set carries the periodic advertising train, its SID is the one to sync to. */
+#define PAWR_DISC_AD_SERVICE_DATA       (0x16)
+#define PAWR_DISC_SVC_DATA_LEN          (5)      /* UUID, network ID, load */
+
+#define PAWR_DISC_MAX_CANDIDATES        (8)      /* centrals tracked at once, the weakest makes room */
+#define PAWR_DISC_CHECK_MS              (100)    /* ranking period while discovering */
+#define PAWR_DISC_MIN_MS                (400)    /* earliest choice */
+#define PAWR_DISC_WINDOW_MS             (2000)   /* latest choice once any central was heard */
+#define PAWR_DISC_MIN_SAMPLES           (2)      /* reports of the best central before an early choice */
+#define PAWR_DISC_LOAD_DB               (20)     /* a fully loaded central ranks like one 20 dB weaker */
+#define PAWR_DISC_EWMA_SHIFT            (2)      /* weight 1/4 per report */
+#define PAWR_DISC_SYNC_TIMEOUT_MS       (5000)   /* the choice does not sync, discover again */
+#define PAWR_DISC_AVOID_MS              (30000)  /* a choice that did not sync is passed over */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t reports;                            /* extended advertising reports parsed */
+    uint32_t matched;                            /* reports of centrals of this network */
+    uint32_t discoveries;                        /* centrals chosen */
+    uint32_t disc_ms_sum;                        /* discovery start to the choice */
+    uint32_t disc_ms_max;
+    uint32_t sync_fails;                         /* choices that did not sync */
+    uint32_t cycles;                             /* spent parsing reports */
+} pawr_disc_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_disc_init(void);
+wiced_bool_t pawr_disc_prepare_sync(wiced_ble_padv_create_sync_params_t *p_sync);
+void pawr_disc_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps);
+void pawr_disc_get_stats(pawr_disc_stats_t *p_stats);
+void pawr_disc_print_stats(void);
+#endif /* PAWR_DISCOVER_H_ */
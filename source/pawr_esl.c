@@ -0,0 +1,572 @@
+/******************************************************************************
+* File Name:   pawr_esl.c
+*
+* Description: This file consists of the Electronic Shelf Label command engine. It walks the ESL commands of a group payload, runs the ones addressed to this label from a fixed command table and builds the response for the same event.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "pawr_esl.h"
+#include "pawr_msg.h"
+#include "app_bt_utils.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_ESL_PARAM_LEN(op)          ((uint8_t)((((op) >> 4) & 0x0F) + 1))
+#define PAWR_ESL_MAX_ONE_RSP_LEN        (17)     /* opcode and up to 16 parameters */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* Runs one command. p_param follows the ESL ID; returns the response length. */
+typedef uint8_t (pawr_esl_cmd_fn_t)(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+
+static uint8_t pawr_esl_cmd_basic(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+static uint8_t pawr_esl_cmd_service_reset(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+static uint8_t pawr_esl_cmd_read_sensor(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+static uint8_t pawr_esl_cmd_refresh_display(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+static uint8_t pawr_esl_cmd_display_image(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+static uint8_t pawr_esl_cmd_led_control(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+static uint8_t pawr_esl_cmd_timed(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp);
+
+static const struct
+{
+    uint8_t            opcode;
+    pawr_esl_cmd_fn_t *fn;
+    const char        *name;
+} esl_cmd_table[PAWR_ESL_NUM_COMMANDS] =
+{
+    { PAWR_ESL_OP_PING,                pawr_esl_cmd_basic,           "ping"        },
+    { PAWR_ESL_OP_SERVICE_RESET,       pawr_esl_cmd_service_reset,   "svc reset"   },
+    { PAWR_ESL_OP_UPDATE_COMPLETE,     pawr_esl_cmd_basic,           "upd cmpl"    },
+    { PAWR_ESL_OP_READ_SENSOR,         pawr_esl_cmd_read_sensor,     "sensor"      },
+    { PAWR_ESL_OP_REFRESH_DISPLAY,     pawr_esl_cmd_refresh_display, "refresh"     },
+    { PAWR_ESL_OP_DISPLAY_IMAGE,       pawr_esl_cmd_display_image,   "image"       },
+    { PAWR_ESL_OP_DISPLAY_TIMED_IMAGE, pawr_esl_cmd_timed,           "timed image" },
+    { PAWR_ESL_OP_LED_CONTROL,         pawr_esl_cmd_led_control,     "led"         },
+    { PAWR_ESL_OP_LED_TIMED_CONTROL,   pawr_esl_cmd_timed,           "timed led"   },
+};
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_esl_error()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function builds an error response.
+* @param[out] p_rsp , response.
+* @param[in]  code  , PAWR_ESL_ERR_*.
+* @return     uint8_t response length.
+**************************************************************************************************/
+static uint8_t pawr_esl_error(uint8_t *p_rsp, uint8_t code)
+{
+    p_rsp[0] = PAWR_ESL_RSP_ERROR;
+    p_rsp[1] = code;
+    return 2;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_update_state()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function derives the LED and pending bits of the basic state.
+* @param[in,out] p_ctx , label state.
+* @return        void.
+**************************************************************************************************/
+static void pawr_esl_update_state(pawr_esl_ctx_t *p_ctx)
+{
+    uint8_t i;
+
+    p_ctx->basic_state &= (uint16_t)~(PAWR_ESL_STATE_ACTIVE_LED | PAWR_ESL_STATE_PENDING_LED | PAWR_ESL_STATE_PENDING_DISPLAY);
+    if (p_ctx->led_active != 0)
+    {
+        p_ctx->basic_state |= PAWR_ESL_STATE_ACTIVE_LED;
+    }
+    for (i = 0; i < PAWR_ESL_MAX_TIMED; i++)
+    {
+        if (p_ctx->timed[i].in_use)
+        {
+            p_ctx->basic_state |= (p_ctx->timed[i].opcode == PAWR_ESL_OP_LED_TIMED_CONTROL) ?
+                                  PAWR_ESL_STATE_PENDING_LED : PAWR_ESL_STATE_PENDING_DISPLAY;
+        }
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_basic_state()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function builds a basic state response.
+* @param[in]  p_ctx , label state.
+* @param[out] p_rsp , response.
+* @return     uint8_t response length.
+**************************************************************************************************/
+static uint8_t pawr_esl_basic_state(const pawr_esl_ctx_t *p_ctx, uint8_t *p_rsp)
+{
+    p_rsp[0] = PAWR_ESL_RSP_BASIC_STATE;
+    p_rsp[1] = (uint8_t)p_ctx->basic_state;
+    p_rsp[2] = (uint8_t)(p_ctx->basic_state >> 8);
+    return 3;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_led_apply()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function drives an LED. Zero repeats switch the LED off.
+* @param[in,out] p_ctx  , label state.
+* @param[in]     led    , LED index, validated.
+* @param[in]     p_ctrl , PAWR_ESL_LED_CTRL_LEN bytes of LED control.
+* @return        void.
+**************************************************************************************************/
+static void pawr_esl_led_apply(pawr_esl_ctx_t *p_ctx, uint8_t led, const uint8_t *p_ctrl)
+{
+    if ((p_ctrl[8] | p_ctrl[9]) != 0)
+    {
+        p_ctx->led_active |= (uint8_t)(1U << led);
+    }
+    else
+    {
+        p_ctx->led_active &= (uint8_t)~(1U << led);
+    }
+    if (p_ctx->p_hw->led_control)
+    {
+        p_ctx->p_hw->led_control(led, p_ctrl);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_display_apply()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function shows a stored image.
+* @param[in,out] p_ctx   , label state.
+* @param[in]     display , display index, validated.
+* @param[in]     image   , image index, validated.
+* @return        wiced_bool_t WICED_FALSE if the image is not stored.
+**************************************************************************************************/
+static wiced_bool_t pawr_esl_display_apply(pawr_esl_ctx_t *p_ctx, uint8_t display, uint8_t image)
+{
+    if ((p_ctx->p_hw->display_image != NULL) && !p_ctx->p_hw->display_image(display, image))
+    {
+        return WICED_FALSE;
+    }
+    p_ctx->image[display] = image;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_cmd_*()
+***************************************************************************************************
+* Function Description:
+* @brief
+* These functions are the command table entries, see pawr_esl_cmd_fn_t.
+**************************************************************************************************/
+static uint8_t pawr_esl_cmd_basic(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp)
+{
+    return pawr_esl_basic_state(p_ctx, p_rsp);
+}
+
+static uint8_t pawr_esl_cmd_service_reset(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp)
+{
+    p_ctx->basic_state &= (uint16_t)~PAWR_ESL_STATE_SERVICE_NEEDED;
+    return pawr_esl_basic_state(p_ctx, p_rsp);
+}
+
+static uint8_t pawr_esl_cmd_read_sensor(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp)
+{
+    uint8_t len;
+
+    if ((p_param[0] >= p_ctx->p_hw->num_sensors) || (p_ctx->p_hw->sensor_read == NULL))
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_INVALID_PARAM);
+    }
+    len = p_ctx->p_hw->sensor_read(p_param[0], &p_rsp[2], PAWR_ESL_MAX_SENSOR_LEN);
+    if ((len == 0) || (len > PAWR_ESL_MAX_SENSOR_LEN))
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_RETRY);
+    }
+    p_rsp[0] = (uint8_t)((len << 4) | PAWR_ESL_RSP_SENSOR_VALUE);
+    p_rsp[1] = p_param[0];
+    return (uint8_t)(2 + len);
+}
+
+static uint8_t pawr_esl_cmd_refresh_display(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp)
+{
+    if (p_param[0] >= p_ctx->p_hw->num_displays)
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_INVALID_PARAM);
+    }
+    if (!pawr_esl_display_apply(p_ctx, p_param[0], p_ctx->image[p_param[0]]))
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_IMAGE_NOT_AVAIL);
+    }
+    p_rsp[0] = PAWR_ESL_RSP_DISPLAY_STATE;
+    p_rsp[1] = p_param[0];
+    p_rsp[2] = p_ctx->image[p_param[0]];
+    return 3;
+}
+
+static uint8_t pawr_esl_cmd_display_image(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp)
+{
+    if (p_param[0] >= p_ctx->p_hw->num_displays)
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_INVALID_PARAM);
+    }
+    if (p_param[1] >= p_ctx->p_hw->num_images)
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_INVALID_IMAGE);
+    }
+    if (!pawr_esl_display_apply(p_ctx, p_param[0], p_param[1]))
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_IMAGE_NOT_AVAIL);
+    }
+    p_rsp[0] = PAWR_ESL_RSP_DISPLAY_STATE;
+    p_rsp[1] = p_param[0];
+    p_rsp[2] = p_param[1];
+    return 3;
+}
+
+static uint8_t pawr_esl_cmd_led_control(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp)
+{
+    if (p_param[0] >= p_ctx->p_hw->num_leds)
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_INVALID_PARAM);
+    }
+    pawr_esl_led_apply(p_ctx, p_param[0], &p_param[1]);
+    pawr_esl_update_state(p_ctx);
+    p_rsp[0] = PAWR_ESL_RSP_LED_STATE;
+    p_rsp[1] = p_param[0];
+    return 2;
+}
+
+/* Timed commands carry the untimed parameters followed by the absolute time. Time 0 removes
+ * the pending command of that display or LED. */
+static uint8_t pawr_esl_cmd_timed(pawr_esl_ctx_t *p_ctx, uint8_t opcode, const uint8_t *p_param, uint32_t now_ms, uint8_t *p_rsp)
+{
+    wiced_bool_t      led = (opcode == PAWR_ESL_OP_LED_TIMED_CONTROL) ? WICED_TRUE : WICED_FALSE;
+    uint8_t           len = led ? (1 + PAWR_ESL_LED_CTRL_LEN) : 2;
+    uint32_t          abs_time = (uint32_t)p_param[len] | ((uint32_t)p_param[len + 1] << 8) |
+                                 ((uint32_t)p_param[len + 2] << 16) | ((uint32_t)p_param[len + 3] << 24);
+    pawr_esl_timed_t *p_free = NULL;
+    uint8_t           i;
+
+    if (p_param[0] >= (led ? p_ctx->p_hw->num_leds : p_ctx->p_hw->num_displays))
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_INVALID_PARAM);
+    }
+    if (!led && (p_param[1] >= p_ctx->p_hw->num_images))
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_INVALID_IMAGE);
+    }
+    if ((abs_time != 0) && ((uint32_t)(abs_time - now_ms) > PAWR_ESL_MAX_TIME_AHEAD_MS))
+    {
+        return pawr_esl_error(p_rsp, PAWR_ESL_ERR_IMPLAUSIBLE_TIME);
+    }
+    /* one pending command per display or LED, a new one replaces it */
+    for (i = 0; i < PAWR_ESL_MAX_TIMED; i++)
+    {
+        pawr_esl_timed_t *t = &p_ctx->timed[i];
+        if (t->in_use && (t->opcode == opcode) && (t->param[0] == p_param[0]))
+        {
+            t->in_use = WICED_FALSE;
+        }
+        if (!t->in_use && (p_free == NULL))
+        {
+            p_free = t;
+        }
+    }
+    if (abs_time != 0)
+    {
+        if (p_free == NULL)
+        {
+            return pawr_esl_error(p_rsp, PAWR_ESL_ERR_QUEUE_FULL);
+        }
+        p_free->in_use      = WICED_TRUE;
+        p_free->opcode      = opcode;
+        p_free->abs_time_ms = abs_time;
+        memcpy(p_free->param, p_param, len);
+    }
+    pawr_esl_update_state(p_ctx);
+    return pawr_esl_basic_state(p_ctx, p_rsp);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function initializes the state of one label.
+* @param[out] p_ctx    , label state.
+* @param[in]  p_hw     , hardware of the label.
+* @param[in]  esl_id   , ESL ID, 0x00 - 0xFE, or PAWR_ESL_ID_NONE until one is assigned.
+* @param[in]  group_id , group, the subevent the label listens to.
+* @return     void.
+**************************************************************************************************/
+void pawr_esl_init(pawr_esl_ctx_t *p_ctx, const pawr_esl_hw_t *p_hw, uint8_t esl_id, uint8_t group_id)
+{
+    memset(p_ctx, 0, sizeof(*p_ctx));
+    p_ctx->p_hw     = p_hw;
+    p_ctx->esl_id   = esl_id;
+    p_ctx->group_id = group_id;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_set_synced()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the synchronized bit of the basic state.
+* @param[in,out] p_ctx  , label state.
+* @param[in]     synced , WICED_TRUE while synchronized to the train.
+* @return        void.
+**************************************************************************************************/
+void pawr_esl_set_synced(pawr_esl_ctx_t *p_ctx, wiced_bool_t synced)
+{
+    if (synced)
+    {
+        p_ctx->basic_state |= PAWR_ESL_STATE_SYNCHRONIZED;
+    }
+    else
+    {
+        p_ctx->basic_state &= (uint16_t)~PAWR_ESL_STATE_SYNCHRONIZED;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_assign()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function applies a PAWR_MSG_TYPE_ESL_ADDR message addressed to this label's BD address.
+* The central assigns every label its own ESL ID this way, as an ESL access point does when it
+* configures a label, so no two labels of a group answer the same command. The confirmation
+* carries the assigned ID and group back to the central.
+* @param[in,out] p_ctx   , label state.
+* @param[in]     bd_addr , BD address of this label.
+* @param[in]     p_msg   , PAWR_MSG_TYPE_ESL_ADDR message.
+* @param[in]     msg_len , message length.
+* @param[out]    p_rsp   , confirmation, PAWR_ESL_ADDR_RSP_LEN bytes.
+* @return        WICED_TRUE if the ID and group were set; WICED_FALSE for another label, a
+*                malformed message, the broadcast ID or a group outside the subevents.
+**************************************************************************************************/
+wiced_bool_t pawr_esl_assign(pawr_esl_ctx_t *p_ctx, const wiced_bt_device_address_t bd_addr, const uint8_t *p_msg,
+                             uint16_t msg_len, uint8_t *p_rsp)
+{
+    if ((msg_len != PAWR_ESL_ADDR_LEN) || (p_msg[0] != PAWR_MSG_TYPE_ESL_ADDR) ||
+        (memcmp(&p_msg[1], bd_addr, BD_ADDR_LEN) != 0))
+    {
+        return WICED_FALSE;
+    }
+    if ((p_msg[7] == PAWR_ESL_ID_BROADCAST) || ((uint8_t)(p_msg[8] - PAWR_CFG_FIRST_SUBEVENT) >= PAWR_CFG_NUM_SUBEVENTS))
+    {
+        return WICED_FALSE;
+    }
+    p_ctx->esl_id   = p_msg[7];
+    p_ctx->group_id = p_msg[8];
+    p_rsp[0]        = PAWR_MSG_TYPE_ESL_ADDR;
+    p_rsp[1]        = p_ctx->esl_id;
+    p_rsp[2]        = p_ctx->group_id;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_process()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs the commands of a group payload addressed to this label and builds its
+* response. Broadcast commands run without a response. Parsing stops at a command cut short;
+* responses that no longer fit are left out. Only p_ctx and the hardware functions are touched.
+* @param[in,out] p_ctx      , label state.
+* @param[in]     group_id   , subevent the payload arrived in.
+* @param[in]     p_cmds     , ESL commands.
+* @param[in]     cmds_len   , length of the commands.
+* @param[in]     now_ms     , ESL absolute time, for timed commands.
+* @param[out]    p_rsp      , response, PAWR_ESL_MAX_RSP_LEN bytes.
+* @param[out]    p_rsp_slot , response slot, valid when a response is returned.
+* @return        uint8_t response length, 0 if the payload holds no command for this label.
+**************************************************************************************************/
+uint8_t pawr_esl_process(pawr_esl_ctx_t *p_ctx, uint8_t group_id, const uint8_t *p_cmds, uint16_t cmds_len,
+                         uint32_t now_ms, uint8_t *p_rsp, uint8_t *p_rsp_slot)
+{
+    uint8_t      one[PAWR_ESL_MAX_ONE_RSP_LEN];
+    uint8_t      rsp_len   = 0;
+    uint8_t      unicast   = 0;
+    wiced_bool_t addressed = WICED_FALSE;
+    uint16_t     pos       = 0;
+    uint8_t      opcode;
+    uint8_t      param_len;
+    uint8_t      esl_id;
+    uint8_t      len;
+    uint8_t      i;
+    uint32_t     start;
+
+    if (group_id != p_ctx->group_id)
+    {
+        return 0;
+    }
+    p_ctx->payloads++;
+    while (pos < cmds_len)
+    {
+        opcode    = p_cmds[pos];
+        param_len = PAWR_ESL_PARAM_LEN(opcode);
+        if (pos + 1 + param_len > cmds_len)
+        {
+            p_ctx->malformed++;
+            break;
+        }
+        esl_id = p_cmds[pos + 1];
+        if ((esl_id == p_ctx->esl_id) || (esl_id == PAWR_ESL_ID_BROADCAST))
+        {
+            if ((esl_id != PAWR_ESL_ID_BROADCAST) && !addressed)
+            {
+                addressed   = WICED_TRUE;
+                *p_rsp_slot = unicast;
+            }
+            for (i = 0; (i < PAWR_ESL_NUM_COMMANDS) && (esl_cmd_table[i].opcode != opcode); i++)
+            {
+            }
+            if (i < PAWR_ESL_NUM_COMMANDS)
+            {
+                start  = APP_BT_UTIL_CYCLES();
+                len    = esl_cmd_table[i].fn(p_ctx, opcode, &p_cmds[pos + 2], now_ms, one);
+                start  = APP_BT_UTIL_CYCLES() - start;
+                p_ctx->cmd_stats[i].count++;
+                p_ctx->cmd_stats[i].cycles += start;
+                if (start > p_ctx->cmd_stats[i].cycles_max)
+                {
+                    p_ctx->cmd_stats[i].cycles_max = start;
+                }
+            }
+            else
+            {
+                len = pawr_esl_error(one, PAWR_ESL_ERR_INVALID_OPCODE);
+            }
+            if ((esl_id != PAWR_ESL_ID_BROADCAST) && (rsp_len + len <= PAWR_ESL_MAX_RSP_LEN))
+            {
+                memcpy(&p_rsp[rsp_len], one, len);
+                rsp_len += len;
+            }
+        }
+        if (esl_id != PAWR_ESL_ID_BROADCAST)
+        {
+            unicast++;
+        }
+        pos += 1 + param_len;
+    }
+    return rsp_len;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_poll()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs the timed commands whose absolute time has come.
+* @param[in,out] p_ctx  , label state.
+* @param[in]     now_ms , ESL absolute time.
+* @return        void.
+**************************************************************************************************/
+void pawr_esl_poll(pawr_esl_ctx_t *p_ctx, uint32_t now_ms)
+{
+    pawr_esl_timed_t *t;
+    wiced_bool_t      ran = WICED_FALSE;
+    uint8_t           i;
+
+    for (i = 0; i < PAWR_ESL_MAX_TIMED; i++)
+    {
+        t = &p_ctx->timed[i];
+        if (!t->in_use || ((int32_t)(now_ms - t->abs_time_ms) < 0))
+        {
+            continue;
+        }
+        t->in_use = WICED_FALSE;
+        ran       = WICED_TRUE;
+        if (t->opcode == PAWR_ESL_OP_LED_TIMED_CONTROL)
+        {
+            pawr_esl_led_apply(p_ctx, t->param[0], &t->param[1]);
+        }
+        else if (!pawr_esl_display_apply(p_ctx, t->param[0], t->param[1]))
+        {
+            p_ctx->basic_state |= PAWR_ESL_STATE_SERVICE_NEEDED;
+        }
+    }
+    if (ran)
+    {
+        pawr_esl_update_state(p_ctx);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_esl_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the payload counters and the execution cycles per command.
+* @param[in] p_ctx , label state.
+* @return    void.
+**************************************************************************************************/
+void pawr_esl_print_stats(const pawr_esl_ctx_t *p_ctx)
+{
+    uint8_t i;
+
+    printf("esl: id %d group %d, state 0x%04x, payloads %lu malformed %lu\n", p_ctx->esl_id, p_ctx->group_id,
+           p_ctx->basic_state, (unsigned long)p_ctx->payloads, (unsigned long)p_ctx->malformed);
+    for (i = 0; i < PAWR_ESL_NUM_COMMANDS; i++)
+    {
+        const pawr_esl_cmd_stats_t *s = &p_ctx->cmd_stats[i];
+        if (s->count != 0)
+        {
+            printf("esl: %-11s n %lu, cycles avg %lu max %lu\n", esl_cmd_table[i].name, (unsigned long)s->count,
+                   (unsigned long)(s->cycles / s->count), (unsigned long)s->cycles_max);
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/******************************************************************************
+* File Name:   pawr_esl.h
+*
+* Description: This file is the public interface of the Electronic Shelf Label command engine.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_ESL_H_
+#define PAWR_ESL_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr_config.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* ESL commands and responses as in the ESL Service specification. The subevent is the group.
+ * Bits 4-7 of an opcode give its parameter length minus one; the first parameter of a command
+ * is the ESL ID. An ESL answers in the response slot numbered by the position of its first
+ * command among the commands to single ESLs, with the responses to all its commands in order. */
+#define PAWR_ESL_OP_PING                (0x00)
+#define PAWR_ESL_OP_SERVICE_RESET       (0x02)
+#define PAWR_ESL_OP_UPDATE_COMPLETE     (0x04)
+#define PAWR_ESL_OP_READ_SENSOR         (0x10)
+#define PAWR_ESL_OP_REFRESH_DISPLAY     (0x11)
+#define PAWR_ESL_OP_DISPLAY_IMAGE       (0x20)
+#define PAWR_ESL_OP_DISPLAY_TIMED_IMAGE (0x60)
+#define PAWR_ESL_OP_LED_CONTROL         (0xB0)
+#define PAWR_ESL_OP_LED_TIMED_CONTROL   (0xF0)
+
+#define PAWR_ESL_RSP_ERROR              (0x00)
+#define PAWR_ESL_RSP_LED_STATE          (0x01)
+#define PAWR_ESL_RSP_BASIC_STATE        (0x10)
+#define PAWR_ESL_RSP_DISPLAY_STATE      (0x11)
+#define PAWR_ESL_RSP_SENSOR_VALUE       (0x0E)   /* | data length << 4 */
+
+#define PAWR_ESL_ERR_UNSPECIFIED        (0x01)
+#define PAWR_ESL_ERR_INVALID_OPCODE     (0x02)
+#define PAWR_ESL_ERR_INVALID_IMAGE      (0x04)
+#define PAWR_ESL_ERR_IMAGE_NOT_AVAIL    (0x05)
+#define PAWR_ESL_ERR_INVALID_PARAM      (0x06)
+#define PAWR_ESL_ERR_RETRY              (0x0A)
+#define PAWR_ESL_ERR_QUEUE_FULL         (0x0B)
+#define PAWR_ESL_ERR_IMPLAUSIBLE_TIME   (0x0C)
+
+/* Basic state bits */
+#define PAWR_ESL_STATE_SERVICE_NEEDED   (0x0001)
+#define PAWR_ESL_STATE_SYNCHRONIZED     (0x0002)
+#define PAWR_ESL_STATE_ACTIVE_LED       (0x0004)
+#define PAWR_ESL_STATE_PENDING_LED      (0x0008)
+#define PAWR_ESL_STATE_PENDING_DISPLAY  (0x0010)
+
+#define PAWR_ESL_ID_BROADCAST           (0xFF)   /* executed by every ESL of the group, never answered */
+#define PAWR_ESL_ID_NONE                (PAWR_ESL_ID_BROADCAST)   /* not assigned: only broadcast commands run */
+#define PAWR_ESL_ADDR_LEN               (9)      /* type, BD address(6), ESL ID, group */
+#define PAWR_ESL_ADDR_RSP_LEN           (3)      /* type, ESL ID, group */
+#define PAWR_ESL_LED_CTRL_LEN           (10)     /* color, flash pattern(5), off, on, repeats(2) */
+#define PAWR_ESL_MAX_SENSOR_LEN         (14)     /* sensor data bytes in a sensor value response */
+#define PAWR_ESL_MAX_TIME_AHEAD_MS      (48UL * 24 * 3600 * 1000)   /* later absolute times are implausible */
+#define PAWR_ESL_MAX_LEDS               (4)
+#define PAWR_ESL_MAX_DISPLAYS           (2)
+#define PAWR_ESL_MAX_TIMED              (4)      /* timed commands waiting for their time */
+#define PAWR_ESL_MAX_RSP_LEN            (48)
+#define PAWR_ESL_NUM_COMMANDS           (9)      /* entries of the command table */
+
+_Static_assert(PAWR_ESL_MAX_RSP_LEN <= PAWR_CFG_RSP_MAX_DATA_LEN, "ESL response does not fit");
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+/* The hardware of one label. The engine validates indexes against the counts before it calls
+ * the functions. */
+typedef struct
+{
+    uint8_t      num_leds;
+    uint8_t      num_displays;
+    uint8_t      num_images;                     /* images stored per display */
+    uint8_t      num_sensors;
+    void         (*led_control)(uint8_t led, const uint8_t *p_ctrl);   /* PAWR_ESL_LED_CTRL_LEN bytes */
+    wiced_bool_t (*display_image)(uint8_t display, uint8_t image);     /* WICED_FALSE if not stored */
+    uint8_t      (*sensor_read)(uint8_t sensor, uint8_t *p_data, uint8_t max_len);   /* 0 if not ready */
+} pawr_esl_hw_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t cycles;
+    uint32_t cycles_max;
+} pawr_esl_cmd_stats_t;
+
+typedef struct
+{
+    wiced_bool_t in_use;
+    uint8_t      opcode;
+    uint32_t     abs_time_ms;
+    uint8_t      param[PAWR_ESL_LED_CTRL_LEN + 1];   /* index and the untimed parameters */
+} pawr_esl_timed_t;
+
+/* State of one label. All engine state lives here so a load generator or a host test can run
+ * many labels in one process. */
+typedef struct
+{
+    const pawr_esl_hw_t *p_hw;
+    uint8_t              esl_id;
+    uint8_t              group_id;
+    uint16_t             basic_state;
+    uint8_t              led_active;             /* bit per LED */
+    uint8_t              image[PAWR_ESL_MAX_DISPLAYS];
+    pawr_esl_timed_t     timed[PAWR_ESL_MAX_TIMED];
+    uint32_t             payloads;               /* group payloads parsed */
+    uint32_t             malformed;              /* payloads cut short inside a command */
+    pawr_esl_cmd_stats_t cmd_stats[PAWR_ESL_NUM_COMMANDS];
+} pawr_esl_ctx_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_esl_init(pawr_esl_ctx_t *p_ctx, const pawr_esl_hw_t *p_hw, uint8_t esl_id, uint8_t group_id);
+void pawr_esl_set_synced(pawr_esl_ctx_t *p_ctx, wiced_bool_t synced);
+wiced_bool_t pawr_esl_assign(pawr_esl_ctx_t *p_ctx, const wiced_bt_device_address_t bd_addr, const uint8_t *p_msg,
+                             uint16_t msg_len, uint8_t *p_rsp);
+uint8_t pawr_esl_process(pawr_esl_ctx_t *p_ctx, uint8_t group_id, const uint8_t *p_cmds, uint16_t cmds_len,
+                         uint32_t now_ms, uint8_t *p_rsp, uint8_t *p_rsp_slot);
+void pawr_esl_poll(pawr_esl_ctx_t *p_ctx, uint32_t now_ms);
+void pawr_esl_print_stats(const pawr_esl_ctx_t *p_ctx);
+#endif /* PAWR_ESL_H_ */
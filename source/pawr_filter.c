@@ -0,0 +1,270 @@
+/******************************************************************************
+* File Name:   pawr_filter.c
+*
+* Description: This file consists of the addressed message filter. It runs on every periodic report before the event dispatch, so reports for other devices cost a few comparisons instead of the whole handler chain.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "pawr_filter.h"
+#include "pawr_msg.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* Address length by mode */
+static const uint8_t filter_addr_len[] =
+{
+    [PAWR_FILTER_MODE_UNICAST] = 1,
+    [PAWR_FILTER_MODE_GROUPS]  = 4,
+    [PAWR_FILTER_MODE_BLOOM]   = 8,
+};
+
+static uint8_t             filter_id = PAWR_FILTER_ID_NONE;
+static uint32_t            filter_groups;
+static uint32_t            filter_bloom[2];  /* our two Bloom bits, low and high word */
+static wiced_bool_t        filter_wake = WICED_FALSE;   /* wake flag for us, not yet taken */
+static pawr_filter_stats_t filter_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_filter_set_id()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the device ID unicast and Bloom addresses are matched against, e.g. the
+* ESL ID. The Bloom bits are worked out here once.
+* @param[in] id , device ID, PAWR_FILTER_ID_NONE to match none.
+* @return    void.
+**************************************************************************************************/
+void pawr_filter_set_id(uint8_t id)
+{
+    uint8_t k;
+    uint8_t bit;
+
+    filter_id       = id;
+    filter_bloom[0] = 0;
+    filter_bloom[1] = 0;
+    if (id == PAWR_FILTER_ID_NONE)
+    {
+        return;
+    }
+    for (k = 0; k < 2; k++)
+    {
+        bit = PAWR_FILTER_BLOOM_BIT(id, k);
+        filter_bloom[bit / 32] |= 1UL << (bit % 32);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_filter_set_groups()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the groups this device belongs to, one bit per group.
+* @param[in] groups , group bitmap.
+* @return    void.
+**************************************************************************************************/
+void pawr_filter_set_groups(uint32_t groups)
+{
+    filter_groups = groups;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_filter_join_group()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function adds one group to the groups this device belongs to. Only the first
+* PAWR_FILTER_NUM_GROUPS groups have a bit in the GROUPS address; a higher group is refused
+* rather than folded onto a lower one, which would deliver that group's messages as well.
+* Such a device is reached by unicast or Bloom address instead.
+* @param[in] group , group, e.g. the ESL group.
+* @return    wiced_bool_t WICED_FALSE for a group without a bit.
+**************************************************************************************************/
+wiced_bool_t pawr_filter_join_group(uint8_t group)
+{
+    if (group >= PAWR_FILTER_NUM_GROUPS)
+    {
+        return WICED_FALSE;
+    }
+    filter_groups |= 1UL << group;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_filter_get_groups()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the groups this device belongs to.
+* @return    uint32_t group bitmap.
+**************************************************************************************************/
+uint32_t pawr_filter_get_groups(void)
+{
+    return filter_groups;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_filter_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function checks the address of an addressed message. A message for us continues without
+* the wrapper; one for others is emptied, so the report still counts for link quality and
+* network time but reaches no handler.
+* @param[in,out] p_report , periodic report with data, a copy the caller owns.
+* @return        wiced_bool_t WICED_FALSE when the message was dropped.
+**************************************************************************************************/
+wiced_bool_t pawr_filter_report(wiced_ble_padv_report_event_data_t *p_report)
+{
+    const uint8_t *p  = p_report->p_data;
+    uint8_t        mode;
+    uint8_t        hdr_len;
+    uint32_t       lo;
+    uint32_t       hi;
+    wiced_bool_t   hit;
+
+    if (p_report->data_length == 0)
+    {
+        return WICED_TRUE;
+    }
+    if (p[0] != PAWR_MSG_TYPE_ADDRESSED)
+    {
+        filter_stats.unaddressed++;
+        return WICED_TRUE;
+    }
+    mode = (p_report->data_length < PAWR_FILTER_HDR_LEN) ? (uint8_t)sizeof(filter_addr_len) : (uint8_t)(p[1] & ~PAWR_FILTER_MODE_WAKE);
+    if ((mode >= sizeof(filter_addr_len)) || (p_report->data_length < PAWR_FILTER_HDR_LEN + filter_addr_len[mode]) ||
+        ((p_report->data_length == PAWR_FILTER_HDR_LEN + filter_addr_len[mode]) && !(p[1] & PAWR_FILTER_MODE_WAKE)))
+    {
+        filter_stats.malformed++;
+        p_report->data_length = 0;
+        return WICED_FALSE;
+    }
+    hdr_len = (uint8_t)(PAWR_FILTER_HDR_LEN + filter_addr_len[mode]);
+    switch (mode)
+    {
+        case PAWR_FILTER_MODE_UNICAST:
+            hit = (filter_id != PAWR_FILTER_ID_NONE) && (p[2] == filter_id);
+        break;
+        case PAWR_FILTER_MODE_GROUPS:
+            lo  = (uint32_t)p[2] | ((uint32_t)p[3] << 8) | ((uint32_t)p[4] << 16) | ((uint32_t)p[5] << 24);
+            hit = ((lo & filter_groups) != 0);
+        break;
+        default:
+            lo  = (uint32_t)p[2] | ((uint32_t)p[3] << 8) | ((uint32_t)p[4] << 16) | ((uint32_t)p[5] << 24);
+            hi  = (uint32_t)p[6] | ((uint32_t)p[7] << 8) | ((uint32_t)p[8] << 16) | ((uint32_t)p[9] << 24);
+            hit = (filter_id != PAWR_FILTER_ID_NONE) &&
+                  ((lo & filter_bloom[0]) == filter_bloom[0]) && ((hi & filter_bloom[1]) == filter_bloom[1]);
+        break;
+    }
+    if (!hit)
+    {
+        filter_stats.filtered++;
+        p_report->data_length = 0;
+        return WICED_FALSE;
+    }
+    if (p[1] & PAWR_FILTER_MODE_WAKE)
+    {
+        filter_stats.wakes++;
+        filter_wake = WICED_TRUE;
+    }
+    filter_stats.delivered++;
+    p_report->p_data      += hdr_len;
+    p_report->data_length  = (uint8_t)(p_report->data_length - hdr_len);
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_filter_take_wake()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns whether a wake flag for us arrived since the last call.
+* @return    wiced_bool_t WICED_TRUE once per wake flag.
+**************************************************************************************************/
+wiced_bool_t pawr_filter_take_wake(void)
+{
+    wiced_bool_t wake = filter_wake;
+
+    filter_wake = WICED_FALSE;
+    return wake;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_filter_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the filter statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_filter_get_stats(pawr_filter_stats_t *p_stats)
+{
+    *p_stats = filter_stats;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_filter_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the filter statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_filter_print_stats(void)
+{
+    printf("pawr filter: delivered:%lu, filtered:%lu, unaddressed:%lu, malformed:%lu, wakes:%lu\n",
+           (unsigned long)filter_stats.delivered,
+           (unsigned long)filter_stats.filtered,
+           (unsigned long)filter_stats.unaddressed,
+           (unsigned long)filter_stats.malformed,
+           (unsigned long)filter_stats.wakes);
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:   pawr_filter.h
+*
+* Description: This file is the public interface of the addressed message filter run before the PAwR event dispatch.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_FILTER_H_
+#define PAWR_FILTER_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Addressed message (PAWR_MSG_TYPE_ADDRESSED): type, mode, address, then the message for the
+ * addressed devices, which may be a secure message; the address itself is not authenticated.
+ *   UNICAST : address is one device ID
+ *   GROUPS  : address is a 32-bit group bitmap, little endian; taken when it shares a bit with
+ *             ours
+ *   BLOOM   : address is a 64-bit Bloom filter over device IDs, little endian; taken when both
+ *             bits of our ID, PAWR_FILTER_BLOOM_BIT(id, 0) and (id, 1), are set. False positives
+ *             reach the handlers and are dropped there by their own addressing.
+ * Messages without the wrapper are not filtered.
+ * PAWR_FILTER_MODE_WAKE in the mode byte asks the addressed devices to stop skipping periodic
+ * events; a wake header may come without a message. */
+#define PAWR_FILTER_MODE_UNICAST        (0x00)
+#define PAWR_FILTER_MODE_GROUPS         (0x01)
+#define PAWR_FILTER_MODE_BLOOM          (0x02)
+#define PAWR_FILTER_MODE_WAKE           (0x80)
+#define PAWR_FILTER_HDR_LEN             (2)
+#define PAWR_FILTER_ID_NONE             (0xFF)   /* matches no unicast or Bloom address */
+#define PAWR_FILTER_NUM_GROUPS          (32)     /* groups with a bit in the GROUPS address */
+
+#define PAWR_FILTER_BLOOM_BIT(id, k)    ((uint8_t)((((uint32_t)(id) + 1) * ((k) ? 0x9DU : 0x3BU)) >> 2) & 0x3F)
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t delivered;                          /* addressed messages for us, header removed */
+    uint32_t filtered;                           /* addressed messages for others, dropped */
+    uint32_t unaddressed;                        /* messages without the wrapper, passed on */
+    uint32_t malformed;                          /* wrapper too short or unknown mode, dropped */
+    uint32_t wakes;                              /* wake flags for us */
+} pawr_filter_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_filter_set_id(uint8_t id);
+void pawr_filter_set_groups(uint32_t groups);
+wiced_bool_t pawr_filter_join_group(uint8_t group);
+uint32_t pawr_filter_get_groups(void);
+wiced_bool_t pawr_filter_report(wiced_ble_padv_report_event_data_t *p_report);
+wiced_bool_t pawr_filter_take_wake(void);
+void pawr_filter_get_stats(pawr_filter_stats_t *p_stats);
+void pawr_filter_print_stats(void);
+#endif /* PAWR_FILTER_H_ */
@@ -0,0 +1,124 @@
+/******************************************************************************
+* File Name:   pawr_flash.c
+*
+* Description: This file consists of the serial flash access shared by the PAwR modules. Several tasks may use the flash; build with CY_SERIAL_FLASH_QSPI_THREAD_SAFE so the serial-flash library serializes them.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdatomic.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "cybsp.h"
+#include "cy_serial_flash_qspi.h"
+#include "cycfg_qspi_memslot.h"
+#include "pawr_flash.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_FLASH_UNINIT               (0)
+#define PAWR_FLASH_INIT_BUSY            (1)
+#define PAWR_FLASH_READY                (2)
+#define PAWR_FLASH_FAILED               (3)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* Init progress, one of the PAWR_FLASH_* states below */
+static atomic_int flash_state = 0;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_flash_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function brings up the serial flash from the BSP memory configuration on first use.
+* Later calls, from any task, wait for and return the first result.
+* @return    wiced_bool_t WICED_TRUE when the flash is usable.
+**************************************************************************************************/
+wiced_bool_t pawr_flash_init(void)
+{
+    int state = PAWR_FLASH_UNINIT;
+
+    if (atomic_compare_exchange_strong(&flash_state, &state, PAWR_FLASH_INIT_BUSY))
+    {
+        state = (cy_serial_flash_qspi_init(smifMemConfigs[0], CYBSP_QSPI_D0, CYBSP_QSPI_D1, CYBSP_QSPI_D2,
+                                           CYBSP_QSPI_D3, NC, NC, NC, NC, CYBSP_QSPI_SCK, CYBSP_QSPI_SS,
+                                           PAWR_FLASH_QSPI_FREQ_HZ) == CY_RSLT_SUCCESS) ?
+                PAWR_FLASH_READY : PAWR_FLASH_FAILED;
+        atomic_store(&flash_state, state);
+    }
+    while (state == PAWR_FLASH_INIT_BUSY)
+    {
+        vTaskDelay(1);
+        state = atomic_load(&flash_state);
+    }
+    return (state == PAWR_FLASH_READY);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flash_erase_size()
+***************************************************************************************************
+* Function Description:
+* @brief
+* These functions wrap the serial-flash library, addresses are offsets in the flash.
+**************************************************************************************************/
+uint32_t pawr_flash_erase_size(uint32_t addr)
+{
+    return (uint32_t)cy_serial_flash_qspi_get_erase_size(addr);
+}
+
+wiced_bool_t pawr_flash_erase(uint32_t addr, uint32_t len)
+{
+    return (atomic_load(&flash_state) == PAWR_FLASH_READY) &&
+           (cy_serial_flash_qspi_erase(addr, len) == CY_RSLT_SUCCESS);
+}
+
+wiced_bool_t pawr_flash_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    return (atomic_load(&flash_state) == PAWR_FLASH_READY) &&
+           (cy_serial_flash_qspi_write(addr, len, p_data) == CY_RSLT_SUCCESS);
+}
+
+wiced_bool_t pawr_flash_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    return (atomic_load(&flash_state) == PAWR_FLASH_READY) &&
+           (cy_serial_flash_qspi_read(addr, len, p_data) == CY_RSLT_SUCCESS);
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+* File Name:   pawr_flash.h
+*
+* Description: This file is the public interface of the serial flash access shared by the PAwR modules.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_FLASH_H_
+#define PAWR_FLASH_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_FLASH_QSPI_FREQ_HZ         (50000000UL)
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+wiced_bool_t pawr_flash_init(void);
+uint32_t pawr_flash_erase_size(uint32_t addr);
+wiced_bool_t pawr_flash_erase(uint32_t addr, uint32_t len);
+wiced_bool_t pawr_flash_write(uint32_t addr, uint32_t len, const uint8_t *p_data);
+wiced_bool_t pawr_flash_read(uint32_t addr, uint32_t len, uint8_t *p_data);
+#endif /* PAWR_FLASH_H_ */
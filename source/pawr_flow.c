@@ -0,0 +1,321 @@
+/******************************************************************************
+* File Name:   pawr_flow.c
+*
+* Description: This file consists of uplink flow control. Responses carry the pending depth, the oldest data age and the extra slots wanted, and the central lends response slots in return.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "pawr.h"
+#include "pawr_flow.h"
+#include "pawr_rsp_sched.h"
+#ifdef ENABLE_PAWR_BACKLOG
+#include "pawr_backlog.h"
+#endif
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_FLOW_MAX_AGE               (0xFFFF)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static wiced_bool_t      flow_enabled     = WICED_FALSE;   /* the central sent a flow message this sync */
+static uint32_t          flow_interval_ms = 0;             /* periodic advertising interval */
+static uint8_t           flow_field[PAWR_FLOW_HDR_LEN];
+static wiced_bool_t      flow_have_field  = WICED_FALSE;
+static uint8_t           flow_granted[PAWR_CFG_SUBEVENT_TABLE_LEN];
+static uint16_t          flow_granted_sum = 0;             /* up to 128 subevents of granted slots */
+static uint16_t          flow_last_evt    = 0;
+static uint8_t           flow_idle_events = 0;
+static pawr_flow_stats_t flow_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_flow_release()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function gives every granted slot back.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+static void pawr_flow_release(void)
+{
+    pawr_rsp_sched_release_grants();
+    memset(flow_granted, 0, sizeof(flow_granted));
+    flow_granted_sum = 0;
+    flow_idle_events = 0;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears the flow control state and statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_flow_init(void)
+{
+    flow_enabled     = WICED_FALSE;
+    flow_interval_ms = 0;
+    flow_have_field  = WICED_FALSE;
+    pawr_flow_release();
+    memset(&flow_stats, 0, sizeof(flow_stats));
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_on_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts a sync with the field off until the central asks for it.
+* @param[in] ps , sync established event data.
+* @return    void.
+**************************************************************************************************/
+void pawr_flow_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps)
+{
+    /* periodic_adv_int is in 1.25 ms units */
+    flow_interval_ms = ((uint32_t)ps->periodic_adv_int * 5) / 4;
+    flow_enabled     = WICED_FALSE;
+    flow_have_field  = WICED_FALSE;
+    pawr_flow_release();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_on_sync_lost()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function ends the grants with the sync.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_flow_on_sync_lost(void)
+{
+    flow_enabled    = WICED_FALSE;
+    flow_have_field = WICED_FALSE;
+    pawr_flow_release();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_on_msg()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes the grant entries of a flow message and turns the field on.
+* @param[in] p_msg   , PAWR_MSG_TYPE_FLOW message.
+* @param[in] msg_len , message length.
+* @return    void.
+**************************************************************************************************/
+void pawr_flow_on_msg(const uint8_t *p_msg, uint16_t msg_len)
+{
+    const uint8_t *p_entry;
+    uint8_t       i;
+
+    if ((msg_len < PAWR_FLOW_GRANT_HDR_LEN) ||
+        (msg_len < PAWR_FLOW_GRANT_HDR_LEN + (uint16_t)p_msg[1] * PAWR_FLOW_GRANT_ENTRY_LEN))
+    {
+        return;
+    }
+    flow_enabled = WICED_TRUE;
+    for (i = 0; i < p_msg[1]; i++)
+    {
+        p_entry = &p_msg[PAWR_FLOW_GRANT_HDR_LEN + i * PAWR_FLOW_GRANT_ENTRY_LEN];
+        /* only subevents this device is synchronized to have slots it can use */
+        if (((uint8_t)(p_entry[0] - PAWR_CFG_FIRST_SUBEVENT) >= PAWR_CFG_NUM_SUBEVENTS) ||
+            !pawr_rsp_sched_grant(p_entry[0], p_entry[1], p_entry[2]))
+        {
+            flow_stats.rejected++;
+            continue;
+        }
+        flow_granted_sum         = (uint16_t)(flow_granted_sum - flow_granted[p_entry[0]] + p_entry[2]);
+        flow_granted[p_entry[0]] = p_entry[2];
+        if (p_entry[2] != 0)
+        {
+            flow_stats.grants++;
+        }
+    }
+    flow_idle_events = 0;
+    if (flow_granted_sum > flow_stats.granted_max)
+    {
+        flow_stats.granted_max = flow_granted_sum;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_update()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function works out the field for the responses about to go out: everything pending in
+* the response scheduler and, with ENABLE_PAWR_BACKLOG, the drain responses of the backlog.
+* Called per report, before the response slots are serviced.
+* @param[in] evt_counter , periodic_evt_counter of the report.
+* @return    void.
+**************************************************************************************************/
+void pawr_flow_update(uint16_t evt_counter)
+{
+    uint32_t depth;
+    uint32_t age_ms;
+    uint32_t want;
+    uint32_t held = 0;
+    uint32_t req;
+    uint16_t age_evts;
+    uint8_t  se;
+#ifdef ENABLE_PAWR_BACKLOG
+    uint32_t bl_age_ms;
+#endif
+
+    depth  = pawr_rsp_sched_pending(&age_evts);
+    age_ms = (uint32_t)age_evts * flow_interval_ms;
+#ifdef ENABLE_PAWR_BACKLOG
+    depth += pawr_backlog_get_demand(&bl_age_ms);
+    if (bl_age_ms > age_ms)
+    {
+        age_ms = bl_age_ms;
+    }
+#endif
+    if (depth > flow_stats.depth_max)
+    {
+        flow_stats.depth_max = (uint16_t)((depth > 0xFFFF) ? 0xFFFF : depth);
+    }
+
+    /* grants are given back once nothing has been pending for a while */
+    if ((depth == 0) && (flow_granted_sum != 0) && (evt_counter != flow_last_evt) &&
+        (++flow_idle_events >= PAWR_FLOW_IDLE_EVENTS))
+    {
+        pawr_flow_release();
+        flow_stats.releases++;
+    }
+    else if (depth != 0)
+    {
+        flow_idle_events = 0;
+    }
+    flow_last_evt   = evt_counter;
+    flow_have_field = (flow_enabled && (depth != 0)) ? WICED_TRUE : WICED_FALSE;
+    if (!flow_have_field)
+    {
+        return;
+    }
+
+    for (se = PAWR_CFG_FIRST_SUBEVENT; se < PAWR_CFG_SUBEVENT_TABLE_LEN; se++)
+    {
+        held += pawr_rsp_sched_num_slots(se);
+    }
+    want = (depth + PAWR_FLOW_DRAIN_EVENTS - 1) / PAWR_FLOW_DRAIN_EVENTS;
+    req  = (want > held) ? (want - held) : 0;
+    req  = (req > 0xFF) ? 0xFF : req;
+    if (req > flow_stats.req_max)
+    {
+        flow_stats.req_max = (uint8_t)req;
+    }
+    age_ms /= PAWR_FLOW_AGE_UNIT_MS;
+    age_ms  = (age_ms > PAWR_FLOW_MAX_AGE) ? PAWR_FLOW_MAX_AGE : age_ms;
+    flow_field[0] = PAWR_MSG_TYPE_FLOW;
+    flow_field[1] = (uint8_t)((depth > 0xFF) ? 0xFF : depth);
+    flow_field[2] = (uint8_t)age_ms;
+    flow_field[3] = (uint8_t)(age_ms >> 8);
+    flow_field[4] = (uint8_t)req;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_get_field()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the field for a response going out.
+* @param[out] p_field , PAWR_FLOW_HDR_LEN bytes.
+* @return     uint8_t field length, 0 when no field is due.
+**************************************************************************************************/
+uint8_t pawr_flow_get_field(uint8_t *p_field)
+{
+    if (!flow_have_field)
+    {
+        return 0;
+    }
+    memcpy(p_field, flow_field, PAWR_FLOW_HDR_LEN);
+    flow_stats.fields++;
+    return PAWR_FLOW_HDR_LEN;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the flow control statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_flow_get_stats(pawr_flow_stats_t *p_stats)
+{
+    *p_stats = flow_stats;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_flow_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the flow control statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_flow_print_stats(void)
+{
+    printf("pawr flow: on:%d, fields:%lu, depth max:%u, req max:%u, granted:%u max:%u, grants:%lu, rejected:%lu, releases:%lu\n",
+           flow_enabled,
+           (unsigned long)flow_stats.fields,
+           flow_stats.depth_max,
+           flow_stats.req_max,
+           flow_granted_sum,
+           flow_stats.granted_max,
+           (unsigned long)flow_stats.grants,
+           (unsigned long)flow_stats.rejected,
+           (unsigned long)flow_stats.releases);
+}
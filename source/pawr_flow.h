@@ -0,0 +1,90 @@
+/******************************************************************************
+* File Name:   pawr_flow.h
+*
+* Description: This file is the public interface of uplink flow control.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_FLOW_H_
+#define PAWR_FLOW_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr_msg.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Flow control field, PAWR_FLOW_HDR_LEN bytes in front of a response: type, depth (responses
+ * pending, this event's included, saturated), oldest data age (uint16 LE in 100 ms units,
+ * saturated), requested slots (extra slots per periodic event wanted on top of those held).
+ * It is sent once the central has sent any flow message in this sync, and only while something
+ * is pending. A depth equal to the responses received in the event means the queue ran empty.
+ * Grant downlink: type, count, then count entries of subevent, first_slot, num_slots. Each
+ * entry replaces the grant of its subevent; num_slots 0 ends it. A count of 0 only turns the
+ * field on. Grants end with the sync, or are given back after PAWR_FLOW_IDLE_EVENTS with
+ * nothing pending. */
+#define PAWR_FLOW_AGE_UNIT_MS           (100)
+#define PAWR_FLOW_DRAIN_EVENTS          (4)      /* periodic events the requested slots should empty the queue in */
+#define PAWR_FLOW_IDLE_EVENTS           (8)      /* periodic events with nothing pending before grants are given back */
+#define PAWR_FLOW_GRANT_HDR_LEN         (2)
+#define PAWR_FLOW_GRANT_ENTRY_LEN       (3)
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t fields;                             /* responses that carried the field */
+    uint32_t grants;                             /* grant entries taken */
+    uint32_t rejected;                           /* grant entries refused */
+    uint32_t releases;                           /* grants given back after going idle */
+    uint16_t depth_max;                          /* pending responses high-water mark */
+    uint16_t granted_max;                        /* most granted slots held at once */
+    uint8_t  req_max;                            /* largest slot request */
+} pawr_flow_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_flow_init(void);
+void pawr_flow_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps);
+void pawr_flow_on_sync_lost(void);
+void pawr_flow_on_msg(const uint8_t *p_msg, uint16_t msg_len);
+void pawr_flow_update(uint16_t evt_counter);
+uint8_t pawr_flow_get_field(uint8_t *p_field);
+void pawr_flow_get_stats(pawr_flow_stats_t *p_stats);
+void pawr_flow_print_stats(void);
+#endif /* PAWR_FLOW_H_ */
@@ -0,0 +1,853 @@
+/******************************************************************************
+* File Name:   pawr_frame.c
+*
+* Description: This file consists of the display frame update over the PAwR downlink. Updates arrive as run-length and region records; the stack only orders the fragments and a task decodes them tile by tile into the frame store.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "pawr_frame.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+#include "app_bt_ring.h"
+#include "app_bt_utils.h"
+#ifndef PAWR_FRAME_IN_RAM
+#include "pawr_flash.h"
+#endif
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_FRAME_TASK_STACK_SIZE      (configMINIMAL_STACK_SIZE * 4)
+#define PAWR_FRAME_TASK_PRIORITY        (tskIDLE_PRIORITY + 1)
+#define PAWR_FRAME_TASK_PERIOD_MS       (5)
+#define PAWR_FRAME_POP_BATCH            (128)
+
+_Static_assert(PAWR_FRAME_TILE_ROWS >= 1, "a frame row does not fit a tile");
+_Static_assert(PAWR_FRAME_NUM_TILES <= 256, "tile index is 8 bit");
+_Static_assert(PAWR_CFG_FRAME_ROW_BYTES <= 255, "x and w are 8 bit");
+#ifndef PAWR_FRAME_IN_RAM
+_Static_assert((PAWR_CFG_FRAME_FLASH_ADDR % PAWR_FRAME_TILE_STRIDE) == 0, "frame store must be sector aligned");
+_Static_assert((PAWR_CFG_FRAME_FLASH_ADDR >= PAWR_CFG_OTA_SLOT_ADDR + PAWR_CFG_OTA_SLOT_SIZE) ||
+               (PAWR_CFG_FRAME_FLASH_ADDR + PAWR_FRAME_NUM_TILES * PAWR_FRAME_TILE_STRIDE <= PAWR_CFG_OTA_SLOT_ADDR),
+               "frame store overlaps the OTA slot");
+#endif
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+#ifdef PAWR_FRAME_IN_RAM
+static wiced_bool_t pawr_frame_ram_init(void);
+static wiced_bool_t pawr_frame_ram_read(uint16_t tile, uint8_t *p_buf, uint16_t len);
+static wiced_bool_t pawr_frame_ram_write(uint16_t tile, const uint8_t *p_buf, uint16_t len);
+
+static uint8_t frm_ram[PAWR_FRAME_BYTES];
+static const pawr_frame_store_t pawr_frame_default_store =
+{
+    .init       = pawr_frame_ram_init,
+    .read_tile  = pawr_frame_ram_read,
+    .write_tile = pawr_frame_ram_write,
+};
+#else
+static wiced_bool_t pawr_frame_flash_read(uint16_t tile, uint8_t *p_buf, uint16_t len);
+static wiced_bool_t pawr_frame_flash_write(uint16_t tile, const uint8_t *p_buf, uint16_t len);
+
+static const pawr_frame_store_t pawr_frame_default_store =
+{
+    .init       = pawr_flash_init,
+    .read_tile  = pawr_frame_flash_read,
+    .write_tile = pawr_frame_flash_write,
+};
+#endif
+
+/* Record length up to the payload, by opcode */
+static const uint8_t frm_rec_len[] =
+{
+    [PAWR_FRAME_REC_END]       = 1,
+    [PAWR_FRAME_REC_TILE]      = 2,
+    [PAWR_FRAME_REC_RUN]       = 6,
+    [PAWR_FRAME_REC_LITERAL]   = 5,
+    [PAWR_FRAME_REC_RECT]      = 5,
+    [PAWR_FRAME_REC_FILL_RECT] = 6,
+};
+
+/* Shared between the stack and the decoder task */
+APP_BT_RING_DEFINE_BUF(frm_ring_buf, 1, PAWR_FRAME_RING_LEN);
+static app_bt_ring_t            frm_ring;
+static atomic_uint              frm_state;
+static atomic_uint              frm_version;     /* of the stored frame */
+static atomic_uint              frm_new_version; /* of the update being received */
+static atomic_bool              frm_restart;     /* a new update starts with the next bytes */
+static atomic_bool              frm_abort;       /* drop the update being received */
+static atomic_uint              frm_tiles_written;
+static atomic_uint              frm_decode_bytes;
+static atomic_uint              frm_decode_cycles;
+static const pawr_frame_store_t *frm_store = &pawr_frame_default_store;
+
+/* Stack side */
+static pawr_frame_ready_cb_t   *frm_ready_cb = NULL;
+static uint8_t                  frm_addr = PAWR_FRAME_ADDR_ALL;
+static uint8_t                  frm_update_id;
+static uint16_t                 frm_next_seq;
+static uint32_t                 frm_rx_bytes;    /* encoded bytes of the update being received */
+static wiced_bool_t             frm_reported = WICED_TRUE;
+static uint32_t                 frm_updates;
+static uint32_t                 frm_errors;
+static uint32_t                 frm_fragments;
+static uint32_t                 frm_fragments_dup;
+static uint32_t                 frm_fragments_gap;
+static uint32_t                 frm_fragments_busy;
+static uint32_t                 frm_encoded_bytes;
+static uint32_t                 frm_raw_bytes;
+
+/* Decoder task side */
+static uint8_t                  dec_in[PAWR_FRAME_POP_BATCH];
+static uint8_t                  dec_tile_buf[PAWR_FRAME_TILE_BYTES];
+static int16_t                  dec_tile = -1;   /* tile held in dec_tile_buf */
+static uint16_t                 dec_tile_len;
+static wiced_bool_t             dec_dirty;
+static wiced_bool_t             dec_active;      /* an update is being decoded */
+static wiced_bool_t             dec_store_ready = WICED_FALSE;
+static uint8_t                  dec_hdr[PAWR_FRAME_REC_MAX_HDR];
+static uint8_t                  dec_hdr_len;
+static uint16_t                 dec_left;        /* payload bytes of the current record still to come */
+static uint16_t                 dec_pos;         /* where the next payload byte goes */
+static uint8_t                  dec_rect_w;      /* RECT width, 0 for LITERAL */
+static uint8_t                  dec_col;         /* RECT column of the next payload byte */
+static uint32_t                 dec_store_cycles;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+#ifdef PAWR_FRAME_IN_RAM
+/**************************************************************************************************
+* Function Name: pawr_frame_ram_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* These functions are the default store when the frame is kept in RAM.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_ram_init(void)
+{
+    return WICED_TRUE;
+}
+
+static wiced_bool_t pawr_frame_ram_read(uint16_t tile, uint8_t *p_buf, uint16_t len)
+{
+    memcpy(p_buf, &frm_ram[(uint32_t)tile * PAWR_FRAME_TILE_BYTES], len);
+    return WICED_TRUE;
+}
+
+static wiced_bool_t pawr_frame_ram_write(uint16_t tile, const uint8_t *p_buf, uint16_t len)
+{
+    memcpy(&frm_ram[(uint32_t)tile * PAWR_FRAME_TILE_BYTES], p_buf, len);
+    return WICED_TRUE;
+}
+#else
+/**************************************************************************************************
+* Function Name: pawr_frame_flash_read()
+***************************************************************************************************
+* Function Description:
+* @brief
+* These functions are the default store in the serial flash, one sector per tile at
+* PAWR_CFG_FRAME_FLASH_ADDR.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_flash_read(uint16_t tile, uint8_t *p_buf, uint16_t len)
+{
+    return pawr_flash_read(PAWR_CFG_FRAME_FLASH_ADDR + (uint32_t)tile * PAWR_FRAME_TILE_STRIDE, len, p_buf);
+}
+
+static wiced_bool_t pawr_frame_flash_write(uint16_t tile, const uint8_t *p_buf, uint16_t len)
+{
+    uint32_t addr = PAWR_CFG_FRAME_FLASH_ADDR + (uint32_t)tile * PAWR_FRAME_TILE_STRIDE;
+
+    return pawr_flash_erase(addr, PAWR_FRAME_TILE_STRIDE) && pawr_flash_write(addr, len, p_buf);
+}
+#endif
+
+/**************************************************************************************************
+* Function Name: pawr_frame_tile_len()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the length of a tile; the last tile may hold fewer rows.
+* @param[in] tile , tile index.
+* @return    uint16_t bytes, 0 for a tile past the frame.
+**************************************************************************************************/
+uint16_t pawr_frame_tile_len(uint16_t tile)
+{
+    uint32_t row = (uint32_t)tile * PAWR_FRAME_TILE_ROWS;
+
+    if (row >= PAWR_CFG_FRAME_HEIGHT)
+    {
+        return 0;
+    }
+    return (uint16_t)(((PAWR_CFG_FRAME_HEIGHT - row < PAWR_FRAME_TILE_ROWS) ? (PAWR_CFG_FRAME_HEIGHT - row) :
+                       PAWR_FRAME_TILE_ROWS) * PAWR_CFG_FRAME_ROW_BYTES);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_finish()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function ends the update being decoded. A failed update leaves some tiles new and some
+* old, so the stored frame no longer has a known version.
+* @param[in] ok , the END record was reached and every tile was stored.
+* @return    void.
+**************************************************************************************************/
+static void pawr_frame_finish(wiced_bool_t ok)
+{
+    unsigned int state = PAWR_FRAME_STATE_RECEIVING;
+
+    dec_active = WICED_FALSE;
+    atomic_store_explicit(&frm_version, ok ? atomic_load_explicit(&frm_new_version, memory_order_relaxed) :
+                          PAWR_FRAME_VERSION_NONE, memory_order_relaxed);
+    atomic_compare_exchange_strong(&frm_state, &state, ok ? PAWR_FRAME_STATE_DONE : PAWR_FRAME_STATE_ERROR);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_store_tile()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function writes the tile held in RAM back to the store when it changed.
+* @return    wiced_bool_t WICED_FALSE on a store failure.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_store_tile(void)
+{
+    uint32_t     start = APP_BT_UTIL_CYCLES();
+    wiced_bool_t ok;
+
+    if ((dec_tile < 0) || !dec_dirty)
+    {
+        return WICED_TRUE;
+    }
+    ok = frm_store->write_tile((uint16_t)dec_tile, dec_tile_buf, dec_tile_len);
+    dec_dirty = WICED_FALSE;
+    dec_store_cycles += APP_BT_UTIL_CYCLES() - start;
+    if (!ok)
+    {
+        printf("pawr_frame: tile %d write failed\n", dec_tile);
+        return WICED_FALSE;
+    }
+    atomic_fetch_add_explicit(&frm_tiles_written, 1, memory_order_relaxed);
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_load_tile()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function stores the current tile and reads the next one to patch.
+* @param[in] tile , tile index.
+* @return    wiced_bool_t WICED_FALSE on a bad index or a store failure.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_load_tile(uint8_t tile)
+{
+    uint32_t     start;
+    wiced_bool_t ok;
+
+    if ((tile >= PAWR_FRAME_NUM_TILES) || ((dec_tile >= 0) && (tile <= dec_tile)) || !pawr_frame_store_tile())
+    {
+        return WICED_FALSE;
+    }
+    start        = APP_BT_UTIL_CYCLES();
+    dec_tile     = tile;
+    dec_tile_len = pawr_frame_tile_len(tile);
+    ok           = frm_store->read_tile(tile, dec_tile_buf, dec_tile_len);
+    dec_store_cycles += APP_BT_UTIL_CYCLES() - start;
+    return ok;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_rect_ok()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function checks that the region of a RECT or FILL_RECT record lies in the current tile.
+* @param[in] p_hdr , record, x y w h after the opcode.
+* @return    wiced_bool_t WICED_TRUE when the region is valid.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_rect_ok(const uint8_t *p_hdr)
+{
+    return (dec_tile >= 0) && (p_hdr[3] != 0) && (p_hdr[4] != 0) &&
+           ((uint16_t)p_hdr[1] + p_hdr[3] <= PAWR_CFG_FRAME_ROW_BYTES) &&
+           ((uint32_t)(p_hdr[2] + p_hdr[4]) * PAWR_CFG_FRAME_ROW_BYTES <= dec_tile_len);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_exec()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs a complete record header. LITERAL and RECT set up their payload, which
+* pawr_frame_decode() copies as it arrives.
+* @param[in] p_hdr , record header.
+* @return    wiced_bool_t WICED_FALSE for an invalid record.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_exec(const uint8_t *p_hdr)
+{
+    uint16_t offset = (uint16_t)(p_hdr[1] | (p_hdr[2] << 8));
+    uint16_t count  = (uint16_t)(p_hdr[3] | (p_hdr[4] << 8));
+    uint16_t pos;
+    uint8_t  row;
+
+    switch (p_hdr[0])
+    {
+        case PAWR_FRAME_REC_END:
+            if (!pawr_frame_store_tile())
+            {
+                return WICED_FALSE;
+            }
+            pawr_frame_finish(WICED_TRUE);
+        return WICED_TRUE;
+        case PAWR_FRAME_REC_TILE:
+        return pawr_frame_load_tile(p_hdr[1]);
+        case PAWR_FRAME_REC_RUN:
+        case PAWR_FRAME_REC_LITERAL:
+            if ((dec_tile < 0) || (count == 0) || ((uint32_t)offset + count > dec_tile_len))
+            {
+                return WICED_FALSE;
+            }
+            if (p_hdr[0] == PAWR_FRAME_REC_RUN)
+            {
+                memset(&dec_tile_buf[offset], p_hdr[5], count);
+            }
+            else
+            {
+                dec_pos    = offset;
+                dec_left   = count;
+                dec_rect_w = 0;
+            }
+        break;
+        case PAWR_FRAME_REC_RECT:
+        case PAWR_FRAME_REC_FILL_RECT:
+            if (!pawr_frame_rect_ok(p_hdr))
+            {
+                return WICED_FALSE;
+            }
+            pos = (uint16_t)(p_hdr[2] * PAWR_CFG_FRAME_ROW_BYTES + p_hdr[1]);
+            if (p_hdr[0] == PAWR_FRAME_REC_FILL_RECT)
+            {
+                for (row = 0; row < p_hdr[4]; row++, pos += PAWR_CFG_FRAME_ROW_BYTES)
+                {
+                    memset(&dec_tile_buf[pos], p_hdr[5], p_hdr[3]);
+                }
+            }
+            else
+            {
+                dec_pos    = pos;
+                dec_left   = (uint16_t)(p_hdr[3] * p_hdr[4]);
+                dec_rect_w = p_hdr[3];
+                dec_col    = 0;
+            }
+        break;
+        default:
+        return WICED_FALSE;
+    }
+    dec_dirty = WICED_TRUE;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_decode()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function decodes a piece of the encoded stream. Records may be split anywhere across
+* pieces; headers are collected byte by byte, payloads are copied in runs.
+* @param[in] p_data , encoded bytes.
+* @param[in] len    , number of bytes.
+* @return    wiced_bool_t WICED_FALSE when the stream is invalid or the store failed.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_decode(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t n;
+
+    while ((len != 0) && dec_active)
+    {
+        if (dec_left != 0)
+        {
+            n = (len < dec_left) ? len : dec_left;
+            if ((dec_rect_w != 0) && (n > (uint32_t)(dec_rect_w - dec_col)))
+            {
+                n = dec_rect_w - dec_col;
+            }
+            memcpy(&dec_tile_buf[dec_pos], p_data, n);
+            dec_pos  += (uint16_t)n;
+            dec_left -= (uint16_t)n;
+            p_data   += n;
+            len      -= n;
+            if (dec_rect_w != 0)
+            {
+                dec_col += (uint8_t)n;
+                if (dec_col == dec_rect_w)
+                {
+                    dec_col  = 0;
+                    dec_pos += PAWR_CFG_FRAME_ROW_BYTES - dec_rect_w;
+                }
+            }
+            continue;
+        }
+        dec_hdr[dec_hdr_len++] = *p_data++;
+        len--;
+        if (dec_hdr[0] >= sizeof(frm_rec_len))
+        {
+            return WICED_FALSE;
+        }
+        if (dec_hdr_len < frm_rec_len[dec_hdr[0]])
+        {
+            continue;
+        }
+        dec_hdr_len = 0;
+        if (!pawr_frame_exec(dec_hdr))
+        {
+            return WICED_FALSE;
+        }
+    }
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_task()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function decodes the bytes queued by the stack. Reading and writing tiles, in particular
+* flash erases, take far too long for the Bluetooth stack context.
+* @param[in] arg , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_frame_task(void *arg)
+{
+    uint32_t n;
+    uint32_t start;
+    uint32_t cycles;
+
+    for (;;)
+    {
+        if (atomic_load_explicit(&frm_abort, memory_order_acquire))
+        {
+            /* the stack queues nothing while an abort is pending, so the ring holds only the old update */
+            while (app_bt_ring_pop_batch(&frm_ring, dec_in, sizeof(dec_in)) != 0)
+            {
+            }
+            atomic_store_explicit(&frm_restart, false, memory_order_relaxed);
+            pawr_frame_finish(WICED_FALSE);
+            atomic_store_explicit(&frm_abort, false, memory_order_release);
+        }
+        n = app_bt_ring_pop_batch(&frm_ring, dec_in, sizeof(dec_in));
+        if (n == 0)
+        {
+            vTaskDelay(pdMS_TO_TICKS(PAWR_FRAME_TASK_PERIOD_MS));
+            continue;
+        }
+        /* the flag is raised before the first bytes of an update are queued */
+        if (atomic_exchange_explicit(&frm_restart, false, memory_order_acquire))
+        {
+            if (!dec_store_ready)
+            {
+                dec_store_ready = frm_store->init();
+            }
+            dec_tile    = -1;
+            dec_dirty   = WICED_FALSE;
+            dec_hdr_len = 0;
+            dec_left    = 0;
+            dec_active  = WICED_TRUE;
+            if (!dec_store_ready)
+            {
+                printf("pawr_frame: store init failed\n");
+                pawr_frame_finish(WICED_FALSE);
+            }
+        }
+        start            = APP_BT_UTIL_CYCLES();
+        dec_store_cycles = 0;
+        if (dec_active && !pawr_frame_decode(dec_in, n))
+        {
+            printf("pawr_frame: bad stream in tile %d\n", dec_tile);
+            pawr_frame_finish(WICED_FALSE);
+        }
+        cycles = APP_BT_UTIL_CYCLES() - start - dec_store_cycles;
+        atomic_fetch_add_explicit(&frm_decode_bytes, n, memory_order_relaxed);
+        atomic_fetch_add_explicit(&frm_decode_cycles, cycles, memory_order_relaxed);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_send_status()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues a status response with the next fragment wanted.
+* @param[in] subevent , subevent to respond in.
+* @return    void.
+**************************************************************************************************/
+static void pawr_frame_send_status(uint8_t subevent)
+{
+    uint8_t  rsp[PAWR_FRAME_STATUS_LEN];
+    uint16_t version = (uint16_t)atomic_load_explicit(&frm_version, memory_order_relaxed);
+
+    rsp[0] = PAWR_MSG_TYPE_FRAME;
+    rsp[1] = frm_update_id;
+    rsp[2] = (uint8_t)atomic_load_explicit(&frm_state, memory_order_relaxed);
+    rsp[3] = (uint8_t)version;
+    rsp[4] = (uint8_t)(version >> 8);
+    rsp[5] = (uint8_t)frm_next_seq;
+    rsp[6] = (uint8_t)(frm_next_seq >> 8);
+    pawr_rsp_sched_submit(PAWR_RSP_PRIO_CONTROL, subevent, rsp, sizeof(rsp));
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_on_begin()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts an update. One already being received is aborted first; the central
+* repeats BEGIN until the status shows the new update id receiving.
+* @param[in] p_msg , BEGIN message.
+* @return    void.
+**************************************************************************************************/
+static void pawr_frame_on_begin(const uint8_t *p_msg)
+{
+    uint16_t     base  = (uint16_t)(p_msg[4] | (p_msg[5] << 8));
+    unsigned int state = atomic_load_explicit(&frm_state, memory_order_relaxed);
+
+    if (state == PAWR_FRAME_STATE_RECEIVING)
+    {
+        if (p_msg[2] != frm_update_id)
+        {
+            atomic_store_explicit(&frm_abort, true, memory_order_release);
+        }
+        return;
+    }
+    if (atomic_load_explicit(&frm_abort, memory_order_acquire) || (app_bt_ring_count(&frm_ring) != 0) ||
+        ((base != PAWR_FRAME_VERSION_NONE) && (base != atomic_load_explicit(&frm_version, memory_order_relaxed))))
+    {
+        return;
+    }
+    frm_update_id = p_msg[2];
+    frm_next_seq  = 0;
+    frm_rx_bytes  = 0;
+    frm_reported  = WICED_FALSE;
+    atomic_store_explicit(&frm_new_version, (unsigned int)(p_msg[6] | (p_msg[7] << 8)), memory_order_relaxed);
+    atomic_store_explicit(&frm_state, PAWR_FRAME_STATE_RECEIVING, memory_order_relaxed);
+    atomic_store_explicit(&frm_restart, true, memory_order_release);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_on_data()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues the next fragment for the decoder. A fragment is taken whole or not at
+* all, so the central resends from next_seq on whatever went missing.
+* @param[in] p_msg   , DATA message.
+* @param[in] msg_len , message length.
+* @return    wiced_bool_t WICED_TRUE when a status response should tell the central the next seq.
+**************************************************************************************************/
+static wiced_bool_t pawr_frame_on_data(const uint8_t *p_msg, uint16_t msg_len)
+{
+    uint16_t seq = (uint16_t)(p_msg[3] | (p_msg[4] << 8));
+    uint16_t len = (uint16_t)(msg_len - PAWR_FRAME_DATA_HDR_LEN);
+
+    if ((p_msg[2] != frm_update_id) ||
+        (atomic_load_explicit(&frm_state, memory_order_relaxed) != PAWR_FRAME_STATE_RECEIVING) ||
+        atomic_load_explicit(&frm_abort, memory_order_relaxed))
+    {
+        return WICED_FALSE;
+    }
+    if ((uint16_t)(seq - frm_next_seq) >= 0x8000)
+    {
+        frm_fragments_dup++;
+        return WICED_FALSE;
+    }
+    if (seq != frm_next_seq)
+    {
+        frm_fragments_gap++;
+        return WICED_TRUE;
+    }
+    if (PAWR_FRAME_RING_LEN - app_bt_ring_count(&frm_ring) < len)
+    {
+        frm_fragments_busy++;
+        return WICED_TRUE;
+    }
+    app_bt_ring_push_batch(&frm_ring, &p_msg[PAWR_FRAME_DATA_HDR_LEN], len);
+    frm_next_seq++;
+    frm_rx_bytes += len;
+    frm_fragments++;
+    return WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_on_msg()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function handles a frame downlink message, from any subevent.
+* @param[in] subevent , subevent the message arrived in, also used for the status response.
+* @param[in] p_msg    , message, starting with PAWR_MSG_TYPE_FRAME.
+* @param[in] msg_len  , message length.
+* @return    void.
+**************************************************************************************************/
+void pawr_frame_on_msg(uint8_t subevent, const uint8_t *p_msg, uint16_t msg_len)
+{
+    if (msg_len < 3)
+    {
+        return;
+    }
+    switch (p_msg[1])
+    {
+        case PAWR_FRAME_OP_BEGIN:
+            if ((msg_len >= PAWR_FRAME_BEGIN_LEN) && ((p_msg[3] == frm_addr) || (p_msg[3] == PAWR_FRAME_ADDR_ALL)))
+            {
+                pawr_frame_on_begin(p_msg);
+                pawr_frame_send_status(subevent);
+            }
+        break;
+        case PAWR_FRAME_OP_DATA:
+            if ((msg_len > PAWR_FRAME_DATA_HDR_LEN) && pawr_frame_on_data(p_msg, msg_len))
+            {
+                pawr_frame_send_status(subevent);
+            }
+        break;
+        case PAWR_FRAME_OP_QUERY:
+            if (p_msg[2] == frm_update_id)
+            {
+                pawr_frame_poll();
+                pawr_frame_send_status(subevent);
+            }
+        break;
+        default:
+        break;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_poll()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function reports an update the decoder finished, once, to the ready callback. Called from
+* the stack for every report.
+* @return    void.
+**************************************************************************************************/
+void pawr_frame_poll(void)
+{
+    unsigned int state;
+
+    if (frm_reported)
+    {
+        return;
+    }
+    state = atomic_load_explicit(&frm_state, memory_order_relaxed);
+    if (state == PAWR_FRAME_STATE_DONE)
+    {
+        frm_reported = WICED_TRUE;
+        frm_updates++;
+        frm_encoded_bytes += frm_rx_bytes;
+        frm_raw_bytes     += PAWR_FRAME_BYTES;
+        if (frm_ready_cb)
+        {
+            frm_ready_cb((uint16_t)atomic_load_explicit(&frm_version, memory_order_relaxed));
+        }
+    }
+    else if (state == PAWR_FRAME_STATE_ERROR)
+    {
+        frm_reported = WICED_TRUE;
+        frm_errors++;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_read_tile()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function reads back a tile of the stored frame, e.g. to stream it to the panel. Call it
+* while no update is being received.
+* @param[in]  tile  , tile index.
+* @param[out] p_buf , tile bytes.
+* @param[in]  len   , bytes to read, at most pawr_frame_tile_len(tile).
+* @return     wiced_bool_t WICED_FALSE on a bad tile or a store failure.
+**************************************************************************************************/
+wiced_bool_t pawr_frame_read_tile(uint16_t tile, uint8_t *p_buf, uint16_t len)
+{
+    if ((len > pawr_frame_tile_len(tile)) || !frm_store->init())
+    {
+        return WICED_FALSE;
+    }
+    return frm_store->read_tile(tile, p_buf, len);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets up the byte queue and starts the decoder task. The store is not touched
+* until an update begins.
+* @return    void.
+**************************************************************************************************/
+void pawr_frame_init(void)
+{
+    app_bt_ring_init(&frm_ring, frm_ring_buf, 1, PAWR_FRAME_RING_LEN);
+    atomic_init(&frm_state, PAWR_FRAME_STATE_IDLE);
+    atomic_init(&frm_version, PAWR_FRAME_VERSION_NONE);
+    atomic_init(&frm_new_version, PAWR_FRAME_VERSION_NONE);
+    atomic_init(&frm_restart, false);
+    atomic_init(&frm_abort, false);
+    atomic_init(&frm_tiles_written, 0);
+    atomic_init(&frm_decode_bytes, 0);
+    atomic_init(&frm_decode_cycles, 0);
+    if (xTaskCreate(pawr_frame_task, "pawr_frame", PAWR_FRAME_TASK_STACK_SIZE, NULL, PAWR_FRAME_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        printf("pawr_frame_init: task create failed\n");
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_set_store()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function replaces the frame store. Only call it while no update is being received.
+* @param[in] p_store , store, NULL restores the default.
+* @return    void.
+**************************************************************************************************/
+void pawr_frame_set_store(const pawr_frame_store_t *p_store)
+{
+    frm_store       = (p_store != NULL) ? p_store : &pawr_frame_default_store;
+    dec_store_ready = WICED_FALSE;
+    atomic_store_explicit(&frm_version, PAWR_FRAME_VERSION_NONE, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_set_addr()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the address BEGIN messages are matched against, e.g. the ESL ID.
+* @param[in] addr , address.
+* @return    void.
+**************************************************************************************************/
+void pawr_frame_set_addr(uint8_t addr)
+{
+    frm_addr = addr;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_reg_ready_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function registers the callback run when an update has been stored.
+* @param[in] callback , ready callback.
+* @return    void.
+**************************************************************************************************/
+void pawr_frame_reg_ready_cb(pawr_frame_ready_cb_t *callback)
+{
+    if (callback)
+    {
+        frm_ready_cb = callback;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the update statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_frame_get_stats(pawr_frame_stats_t *p_stats)
+{
+    p_stats->state          = (pawr_frame_state_t)atomic_load_explicit(&frm_state, memory_order_relaxed);
+    p_stats->version        = (uint16_t)atomic_load_explicit(&frm_version, memory_order_relaxed);
+    p_stats->updates        = frm_updates;
+    p_stats->errors         = frm_errors;
+    p_stats->fragments      = frm_fragments;
+    p_stats->fragments_dup  = frm_fragments_dup;
+    p_stats->fragments_gap  = frm_fragments_gap;
+    p_stats->fragments_busy = frm_fragments_busy;
+    p_stats->encoded_bytes  = frm_encoded_bytes;
+    p_stats->raw_bytes      = frm_raw_bytes;
+    p_stats->tiles_written  = atomic_load_explicit(&frm_tiles_written, memory_order_relaxed);
+    p_stats->decode_bytes   = atomic_load_explicit(&frm_decode_bytes, memory_order_relaxed);
+    p_stats->decode_cycles  = atomic_load_explicit(&frm_decode_cycles, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_frame_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the update statistics, the bytes on air saved against sending full
+* frames and the decoder throughput.
+* @return    void.
+**************************************************************************************************/
+void pawr_frame_print_stats(void)
+{
+    pawr_frame_stats_t s;
+
+    pawr_frame_get_stats(&s);
+    if ((s.updates == 0) && (s.errors == 0) && (s.state == PAWR_FRAME_STATE_IDLE))
+    {
+        return;
+    }
+    printf("frame: state %d version %d, updates %lu errors %lu, fragments %lu dup %lu gap %lu busy %lu, tiles %lu\n",
+           s.state, s.version, (unsigned long)s.updates, (unsigned long)s.errors, (unsigned long)s.fragments,
+           (unsigned long)s.fragments_dup, (unsigned long)s.fragments_gap, (unsigned long)s.fragments_busy,
+           (unsigned long)s.tiles_written);
+    printf("frame: %lu encoded bytes for %lu raw, %lu%% saved; decode %lu bytes, %lu cycles/byte\n",
+           (unsigned long)s.encoded_bytes, (unsigned long)s.raw_bytes,
+           (unsigned long)((s.raw_bytes > s.encoded_bytes) ? ((uint64_t)(s.raw_bytes - s.encoded_bytes) * 100 / s.raw_bytes) : 0),
+           (unsigned long)s.decode_bytes,
+           (unsigned long)((s.decode_bytes != 0) ? (s.decode_cycles / s.decode_bytes) : 0));
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+* File Name:   pawr_frame.h
+*
+* Description: This file is the public interface of the display frame updates sent as deltas over the PAwR downlink.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_FRAME_H_
+#define PAWR_FRAME_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr_config.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* The frame, PAWR_CFG_FRAME_ROW_BYTES x PAWR_CFG_FRAME_HEIGHT bytes, is cut into tiles of whole
+ * rows that each fit one 4 KB flash sector. Only the tile being decoded is held in RAM. */
+#define PAWR_FRAME_BYTES                ((uint32_t)PAWR_CFG_FRAME_ROW_BYTES * PAWR_CFG_FRAME_HEIGHT)
+#define PAWR_FRAME_TILE_STRIDE          (4096)   /* tile spacing in the store */
+#define PAWR_FRAME_TILE_ROWS            (((PAWR_FRAME_TILE_STRIDE / PAWR_CFG_FRAME_ROW_BYTES) > 255) ? 255 : \
+                                         (PAWR_FRAME_TILE_STRIDE / PAWR_CFG_FRAME_ROW_BYTES))
+#define PAWR_FRAME_TILE_BYTES           (PAWR_FRAME_TILE_ROWS * PAWR_CFG_FRAME_ROW_BYTES)
+#define PAWR_FRAME_NUM_TILES            ((PAWR_CFG_FRAME_HEIGHT + PAWR_FRAME_TILE_ROWS - 1) / PAWR_FRAME_TILE_ROWS)
+#define PAWR_FRAME_VERSION_NONE         (0xFFFF) /* frame content unknown; as base: a full frame update */
+
+/* Downlink, multi byte fields little endian:
+ *   BEGIN : type, op, update_id, addr, base_version(2), new_version(2)
+ *   DATA  : type, op, update_id, seq(2), encoded bytes; seq counts from 0 per update
+ *   QUERY : type, op, update_id; the peripheral answers with a status response
+ * BEGIN is taken when addr is ours or PAWR_FRAME_ADDR_ALL and base_version matches the stored
+ * frame. DATA fragments are decoded in seq order; a gap, or a fragment that finds the decoder
+ * queue full, is answered with a status naming the next seq wanted. */
+#define PAWR_FRAME_OP_BEGIN             (0x01)
+#define PAWR_FRAME_OP_DATA              (0x02)
+#define PAWR_FRAME_OP_QUERY             (0x03)
+#define PAWR_FRAME_BEGIN_LEN            (8)
+#define PAWR_FRAME_DATA_HDR_LEN         (5)
+#define PAWR_FRAME_ADDR_ALL             (0xFF)
+
+/* Uplink status: type, update_id, state, version(2), next_seq(2) */
+#define PAWR_FRAME_STATUS_LEN           (7)
+
+/* Encoded stream, a sequence of records. Offsets and coordinates are within the selected tile,
+ * x and widths in bytes, y and heights in rows; the encoder splits regions at tile boundaries.
+ *   END       : op                               last record, the frame is complete
+ *   TILE      : op, tile                         select a tile, in increasing order
+ *   RUN       : op, offset(2), count(2), value   count copies of value
+ *   LITERAL   : op, offset(2), count(2), bytes   count bytes
+ *   RECT      : op, x, y, w, h, bytes            w x h bytes, row by row
+ *   FILL_RECT : op, x, y, w, h, value            w x h copies of value
+ * Bytes a record does not cover keep their stored value, so a delta only carries what changed.
+ * A full frame update (base PAWR_FRAME_VERSION_NONE) covers every byte of every tile. */
+#define PAWR_FRAME_REC_END              (0x00)
+#define PAWR_FRAME_REC_TILE             (0x01)
+#define PAWR_FRAME_REC_RUN              (0x02)
+#define PAWR_FRAME_REC_LITERAL          (0x03)
+#define PAWR_FRAME_REC_RECT             (0x04)
+#define PAWR_FRAME_REC_FILL_RECT        (0x05)
+#define PAWR_FRAME_REC_MAX_HDR          (6)
+
+#define PAWR_FRAME_RING_LEN             (1024)   /* encoded bytes between the stack and the decoder task, power of two */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef enum
+{
+    PAWR_FRAME_STATE_IDLE = 0,
+    PAWR_FRAME_STATE_RECEIVING,
+    PAWR_FRAME_STATE_DONE,                       /* the stored frame is new_version */
+    PAWR_FRAME_STATE_ERROR,                      /* bad stream or store failure, the frame version is unknown */
+} pawr_frame_state_t;
+
+/* Frame store, called from the decoder task only. A tile is PAWR_FRAME_TILE_BYTES long except
+ * the last one, which may hold fewer rows. */
+typedef struct
+{
+    wiced_bool_t (*init)(void);
+    wiced_bool_t (*read_tile)(uint16_t tile, uint8_t *p_buf, uint16_t len);
+    wiced_bool_t (*write_tile)(uint16_t tile, const uint8_t *p_buf, uint16_t len);
+} pawr_frame_store_t;
+
+typedef struct
+{
+    pawr_frame_state_t state;
+    uint16_t version;
+    uint32_t updates;                            /* completed */
+    uint32_t errors;                             /* failed or aborted */
+    uint32_t fragments;                          /* decoded in order */
+    uint32_t fragments_dup;
+    uint32_t fragments_gap;                      /* out of order, not taken */
+    uint32_t fragments_busy;                     /* decoder queue full, not taken */
+    uint32_t encoded_bytes;                      /* of the completed updates */
+    uint32_t raw_bytes;                          /* full frames the completed updates replaced */
+    uint32_t tiles_written;
+    uint32_t decode_bytes;
+    uint32_t decode_cycles;                      /* decoding only, store access excluded */
+} pawr_frame_stats_t;
+
+/* The stored frame changed; the display driver reads it back with pawr_frame_read_tile(). */
+typedef void (pawr_frame_ready_cb_t)(uint16_t version);
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_frame_init(void);
+void pawr_frame_set_store(const pawr_frame_store_t *p_store);
+void pawr_frame_set_addr(uint8_t addr);
+void pawr_frame_reg_ready_cb(pawr_frame_ready_cb_t *callback);
+void pawr_frame_on_msg(uint8_t subevent, const uint8_t *p_msg, uint16_t msg_len);
+void pawr_frame_poll(void);
+wiced_bool_t pawr_frame_read_tile(uint16_t tile, uint8_t *p_buf, uint16_t len);
+uint16_t pawr_frame_tile_len(uint16_t tile);
+void pawr_frame_get_stats(pawr_frame_stats_t *p_stats);
+void pawr_frame_print_stats(void);
+#endif /* PAWR_FRAME_H_ */
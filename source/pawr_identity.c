@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name:   pawr_identity.c
+*
+* Description: This file consists of the PAwR peripheral identity. The BD address and the default subevent and response slot are derived from the device unique ID, so one build serves a whole fleet.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "cybsp.h"
+#include "wiced_bt_ble.h"
+#include "pawr_identity.h"
+#include "app_bt_utils.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_IDENTITY_SLOT_SEED         (0x9E3779B97F4A7C15ULL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static wiced_bt_device_address_t pawr_identity_addr;
+static uint32_t                  pawr_identity_slot_hash = 0;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_identity_init_from_id()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function derives the identity from the given unique ID. The slot hash uses a different
+* seed than the address so that the slot does not follow from visible address bits.
+* @param[in] p_uid   , unique ID.
+* @param[in] uid_len , length of the unique ID.
+* @return    void.
+**************************************************************************************************/
+void pawr_identity_init_from_id(const uint8_t *p_uid, uint8_t uid_len)
+{
+    uint64_t h = PAWR_IDENTITY_SLOT_SEED;
+    uint8_t  i;
+
+    app_bt_util_generate_bd_address(p_uid, uid_len, pawr_identity_addr);
+
+    for (i = 0; i < uid_len; i++)
+    {
+        h = (h ^ p_uid[i]) * 0x100000001b3ULL;
+    }
+    /* murmur3 finalizer, every input bit affects every output bit */
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    pawr_identity_slot_hash = (uint32_t)(h >> 32);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_identity_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function derives the identity from the die unique ID.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_identity_init(void)
+{
+    uint64_t uid = Cy_SysLib_GetUniqueId();
+    uint8_t  uid_bytes[PAWR_IDENTITY_UID_LEN];
+    uint8_t  i;
+
+    for (i = 0; i < PAWR_IDENTITY_UID_LEN; i++)
+    {
+        uid_bytes[i] = (uint8_t)(uid >> (8 * i));
+    }
+    printf("unique id: ");
+    app_bt_util_print_byte_array(uid_bytes, PAWR_IDENTITY_UID_LEN);
+    pawr_identity_init_from_id(uid_bytes, PAWR_IDENTITY_UID_LEN);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_identity_get_bd_addr()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the derived BD address.
+* @param[out] bd_addr , derived address.
+* @return     void.
+**************************************************************************************************/
+void pawr_identity_get_bd_addr(wiced_bt_device_address_t bd_addr)
+{
+    memcpy(bd_addr, pawr_identity_addr, BD_ADDR_LEN);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_identity_get_slot()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function maps the identity onto one of num_slots positions. The 32-bit hash is scaled with
+* a multiply and shift instead of a modulo, which splits the hash range into positions of equal
+* size, within one, for any count.
+* @param[in] num_slots , positions to choose from, e.g. the response slots available to peripherals.
+* @return    position, 0 to num_slots - 1; 0 when num_slots is 0.
+**************************************************************************************************/
+uint8_t pawr_identity_get_slot(uint8_t num_slots)
+{
+    return (uint8_t)(((uint64_t)pawr_identity_slot_hash * num_slots) >> 32);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,399 @@
+/******************************************************************************
+* File Name:   pawr_link.c
+*
+* Description: This file consists of the PAwR link quality estimator. Downlink RSSI and report loss are averaged per subevent; the estimate sets the response TX power and raises a weak link signal for the app.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "pawr_link.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_LINK_RSSI_UNAVAILABLE      (127)    /* HCI value for an RSSI that was not measured */
+#define PAWR_LINK_DATA_COMPLETE         (0x00)   /* HCI data_status of a complete report */
+#define PAWR_LINK_LOSS_ONE              (0xFFFF) /* loss average scale */
+#define PAWR_LINK_PCT_TO_LOSS(pct)      ((uint16_t)(((uint32_t)(pct) * PAWR_LINK_LOSS_ONE) / 100))
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    wiced_bool_t in_use;
+    uint16_t     last_evt;
+    int16_t      rssi_q4;                        /* averaged RSSI in 1/16 dBm */
+    uint16_t     loss;                           /* averaged loss, PAWR_LINK_LOSS_ONE is 100% */
+    uint16_t     samples;
+    int8_t       tx_power;
+    wiced_bool_t weak;
+    uint32_t     reports;
+    uint32_t     missed;
+    uint32_t     tx_changes;
+} pawr_link_state_t;
+
+static pawr_link_state_t       link_state[PAWR_LINK_MAX_SUBEVENTS];
+static pawr_link_tx_power_cb_t *link_tx_power_cb = NULL;
+static pawr_link_weak_cb_t     *link_weak_cb     = NULL;
+static uint16_t                link_skip        = 0;   /* events the controller skips between receptions */
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_link_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears the link state and statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_link_init(void)
+{
+    uint8_t i;
+
+    memset(link_state, 0, sizeof(link_state));
+    link_skip = 0;
+    for (i = 0; i < PAWR_LINK_MAX_SUBEVENTS; i++)
+    {
+        link_state[i].tx_power = PAWR_LINK_TX_POWER_DEFAULT;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_reset()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function restarts the estimate on a new sync; the old averages describe another train.
+* Statistics and the TX power in use are kept.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_link_reset(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PAWR_LINK_MAX_SUBEVENTS; i++)
+    {
+        link_state[i].in_use  = WICED_FALSE;
+        link_state[i].samples = 0;
+        link_state[i].weak    = WICED_FALSE;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_set_skip()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the skip of the current sync. The controller listens to one event in
+* skip + 1; the events in between are not lost.
+* @param[in] skip , periodic events skipped, 0 to receive every one.
+* @return    void.
+**************************************************************************************************/
+void pawr_link_set_skip(uint16_t skip)
+{
+    link_skip = skip;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_reg_tx_power_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function registers the callback that applies the response TX power.
+* @param[in] callback , TX power callback.
+* @return    void.
+**************************************************************************************************/
+void pawr_link_reg_tx_power_cb(pawr_link_tx_power_cb_t *callback)
+{
+    link_tx_power_cb = callback;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_reg_weak_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function registers the weak link callback.
+* @param[in] callback , weak link callback.
+* @return    void.
+**************************************************************************************************/
+void pawr_link_reg_weak_cb(pawr_link_weak_cb_t *callback)
+{
+    link_weak_cb = callback;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_fill_info()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function converts the internal state to the public view.
+* @param[in]  st     , link state.
+* @param[out] p_info , link quality.
+* @return     void.
+**************************************************************************************************/
+static void pawr_link_fill_info(const pawr_link_state_t *st, pawr_link_info_t *p_info)
+{
+    p_info->rssi       = (int8_t)(st->rssi_q4 / 16);
+    p_info->loss_pct   = (uint8_t)(((uint32_t)st->loss * 100 + PAWR_LINK_LOSS_ONE / 2) / PAWR_LINK_LOSS_ONE);
+    p_info->tx_power   = st->tx_power;
+    p_info->weak       = st->weak;
+    p_info->reports    = st->reports;
+    p_info->missed     = st->missed;
+    p_info->tx_changes = st->tx_changes;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_loss_sample()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function folds one event into the loss average.
+* @param[in,out] st   , link state.
+* @param[in]     lost , WICED_TRUE if the event brought no usable report.
+* @return        void.
+**************************************************************************************************/
+static void pawr_link_loss_sample(pawr_link_state_t *st, wiced_bool_t lost)
+{
+    int32_t target = lost ? PAWR_LINK_LOSS_ONE : 0;
+
+    st->loss = (uint16_t)((int32_t)st->loss + ((target - (int32_t)st->loss) >> PAWR_LINK_EWMA_SHIFT));
+    if (lost)
+    {
+        st->missed++;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_adapt()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function moves the response TX power one step towards the RSSI window and updates the
+* weak link state, with hysteresis on both.
+* @param[in]     subevent , subevent.
+* @param[in,out] st       , link state.
+* @return        void.
+**************************************************************************************************/
+static void pawr_link_adapt(uint8_t subevent, pawr_link_state_t *st)
+{
+    int16_t          rssi  = st->rssi_q4 / 16;
+    int8_t           power = st->tx_power;
+    wiced_bool_t     weak  = st->weak;
+    pawr_link_info_t info;
+
+    if ((rssi < PAWR_LINK_RSSI_LOW) || (st->loss > PAWR_LINK_PCT_TO_LOSS(PAWR_LINK_LOSS_HIGH_PCT)))
+    {
+        power += PAWR_LINK_TX_POWER_STEP;
+    }
+    else if (rssi > PAWR_LINK_RSSI_HIGH)
+    {
+        power -= PAWR_LINK_TX_POWER_STEP;
+    }
+    if (power > PAWR_LINK_TX_POWER_MAX)
+    {
+        power = PAWR_LINK_TX_POWER_MAX;
+    }
+    if (power < PAWR_LINK_TX_POWER_MIN)
+    {
+        power = PAWR_LINK_TX_POWER_MIN;
+    }
+    if (power != st->tx_power)
+    {
+        st->tx_power = power;
+        st->tx_changes++;
+        if (link_tx_power_cb)
+        {
+            link_tx_power_cb(subevent, power);
+        }
+    }
+
+    if (!weak)
+    {
+        weak = (power == PAWR_LINK_TX_POWER_MAX) &&
+               ((rssi < PAWR_LINK_WEAK_RSSI) || (st->loss > PAWR_LINK_PCT_TO_LOSS(PAWR_LINK_WEAK_LOSS_PCT)));
+    }
+    else
+    {
+        weak = !((rssi >= PAWR_LINK_WEAK_RSSI + PAWR_LINK_HYSTERESIS_DB) &&
+                 (st->loss < PAWR_LINK_PCT_TO_LOSS(PAWR_LINK_WEAK_LOSS_PCT / 2)));
+    }
+    if (weak != st->weak)
+    {
+        st->weak = weak;
+        if (link_weak_cb)
+        {
+            pawr_link_fill_info(st, &info);
+            link_weak_cb(subevent, weak, &info);
+        }
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_on_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function updates the estimate of a subevent with a periodic report. Events missed since
+* the previous report of the subevent count as lost, as does a report the controller could not
+* receive completely; events the sync skips on purpose do not.
+* @param[in] subevent    , subevent of the report.
+* @param[in] evt_counter , periodic_evt_counter of the report.
+* @param[in] rssi        , report RSSI in dBm, 127 if not available.
+* @param[in] data_status , report data_status.
+* @return    void.
+**************************************************************************************************/
+void pawr_link_on_report(uint8_t subevent, uint16_t evt_counter, int8_t rssi, uint8_t data_status)
+{
+    pawr_link_state_t *st;
+    uint16_t          gap;
+
+    if (subevent >= PAWR_LINK_MAX_SUBEVENTS)
+    {
+        return;
+    }
+    st = &link_state[subevent];
+    if (!st->in_use)
+    {
+        st->in_use   = WICED_TRUE;
+        st->rssi_q4  = (rssi != PAWR_LINK_RSSI_UNAVAILABLE) ? (int16_t)(rssi * 16) : (int16_t)(PAWR_LINK_RSSI_LOW * 16);
+        st->loss     = 0;
+    }
+    else
+    {
+        gap = (uint16_t)(evt_counter - st->last_evt - 1);
+        if (gap < 0x8000)
+        {
+            gap = (uint16_t)(gap / (link_skip + 1U));
+            if (gap > PAWR_LINK_MAX_GAP_SAMPLES)
+            {
+                st->missed += gap - PAWR_LINK_MAX_GAP_SAMPLES;
+                gap = PAWR_LINK_MAX_GAP_SAMPLES;
+            }
+            while (gap--)
+            {
+                pawr_link_loss_sample(st, WICED_TRUE);
+            }
+        }
+    }
+    st->last_evt = evt_counter;
+    st->reports++;
+    pawr_link_loss_sample(st, (data_status != PAWR_LINK_DATA_COMPLETE) ? WICED_TRUE : WICED_FALSE);
+    if (rssi != PAWR_LINK_RSSI_UNAVAILABLE)
+    {
+        st->rssi_q4 += (int16_t)((rssi * 16 - st->rssi_q4) / (1 << PAWR_LINK_EWMA_SHIFT));
+    }
+
+    if (st->samples < PAWR_LINK_MIN_SAMPLES)
+    {
+        st->samples++;
+        return;
+    }
+    pawr_link_adapt(subevent, st);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_get_info()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the link quality of a subevent.
+* @param[in]  subevent , subevent.
+* @param[out] p_info   , link quality.
+* @return     wiced_bool_t WICED_FALSE if the subevent has no estimate yet.
+**************************************************************************************************/
+wiced_bool_t pawr_link_get_info(uint8_t subevent, pawr_link_info_t *p_info)
+{
+    if ((subevent >= PAWR_LINK_MAX_SUBEVENTS) || !link_state[subevent].in_use || (p_info == NULL))
+    {
+        return WICED_FALSE;
+    }
+    pawr_link_fill_info(&link_state[subevent], p_info);
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_is_weak()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function tells whether a subevent is in the weak link state.
+* @param[in] subevent , subevent.
+* @return    wiced_bool_t WICED_TRUE if the link is weak.
+**************************************************************************************************/
+wiced_bool_t pawr_link_is_weak(uint8_t subevent)
+{
+    return ((subevent < PAWR_LINK_MAX_SUBEVENTS) && link_state[subevent].weak) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_link_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the link quality of every tracked subevent.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_link_print_stats(void)
+{
+    pawr_link_info_t info;
+    uint8_t          i;
+
+    for (i = 0; i < PAWR_LINK_MAX_SUBEVENTS; i++)
+    {
+        if (pawr_link_get_info(i, &info))
+        {
+            printf("pawr link se:%d, rssi:%d, loss:%d%%, tx:%d dBm, weak:%d, reports:%lu, missed:%lu, tx changes:%lu\n",
+                   i, info.rssi, info.loss_pct, info.tx_power, info.weak,
+                   (unsigned long)info.reports, (unsigned long)info.missed, (unsigned long)info.tx_changes);
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name:   pawr_link.h
+*
+* Description: This file is the public interface of the PAwR link quality estimator.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_LINK_H_
+#define PAWR_LINK_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr_config.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_LINK_MAX_SUBEVENTS         (PAWR_CFG_SUBEVENT_TABLE_LEN)   /* subevents 0..N-1, see pawr_config.h */
+#define PAWR_LINK_EWMA_SHIFT            (3)      /* weight 1/8 per sample */
+#define PAWR_LINK_MIN_SAMPLES           (8)      /* samples before the estimate is used */
+#define PAWR_LINK_MAX_GAP_SAMPLES       (32)     /* missed events folded in per report, bounds the work */
+
+/* Response TX power follows the downlink: the path loss is about the same both ways. */
+#define PAWR_LINK_TX_POWER_MIN          (-16)    /* dBm */
+#define PAWR_LINK_TX_POWER_MAX          (4)      /* dBm */
+#define PAWR_LINK_TX_POWER_DEFAULT      (0)      /* dBm */
+#define PAWR_LINK_TX_POWER_STEP         (2)      /* dB per adjustment */
+#define PAWR_LINK_RSSI_HIGH             (-55)    /* dBm, above this power is lowered */
+#define PAWR_LINK_RSSI_LOW              (-75)    /* dBm, below this power is raised */
+#define PAWR_LINK_LOSS_HIGH_PCT         (10)     /* report loss that raises power */
+
+/* Weak link: poor even at full power, the app should ask for another subevent or slot. */
+#define PAWR_LINK_WEAK_RSSI             (-85)    /* dBm */
+#define PAWR_LINK_WEAK_LOSS_PCT         (25)
+#define PAWR_LINK_HYSTERESIS_DB         (5)      /* margin to leave the weak state again */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    int8_t       rssi;                           /* averaged downlink RSSI, dBm */
+    uint8_t      loss_pct;                       /* averaged report loss, percent */
+    int8_t       tx_power;                       /* response TX power in use, dBm */
+    wiced_bool_t weak;                           /* weak link signalled to the app */
+    uint32_t     reports;                        /* reports received */
+    uint32_t     missed;                         /* events without a report or with an incomplete one */
+    uint32_t     tx_changes;                     /* TX power adjustments */
+} pawr_link_info_t;
+
+/* Applies a new response TX power; the controller call is platform specific. */
+typedef void (pawr_link_tx_power_cb_t)(uint8_t subevent, int8_t tx_power);
+/* Reports entering or leaving the weak link state of a subevent. */
+typedef void (pawr_link_weak_cb_t)(uint8_t subevent, wiced_bool_t weak, const pawr_link_info_t *p_info);
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_link_init(void);
+void pawr_link_reset(void);
+void pawr_link_set_skip(uint16_t skip);
+void pawr_link_reg_tx_power_cb(pawr_link_tx_power_cb_t *callback);
+void pawr_link_reg_weak_cb(pawr_link_weak_cb_t *callback);
+void pawr_link_on_report(uint8_t subevent, uint16_t evt_counter, int8_t rssi, uint8_t data_status);
+wiced_bool_t pawr_link_get_info(uint8_t subevent, pawr_link_info_t *p_info);
+wiced_bool_t pawr_link_is_weak(uint8_t subevent);
+void pawr_link_print_stats(void);
+#endif /* PAWR_LINK_H_ */
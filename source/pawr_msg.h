@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name:   pawr_msg.h
+*
+* Description: This file consists of the PAwR downlink and uplink message framing.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_MSG_H_
+#define PAWR_MSG_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* The first byte of every subevent indication report selects the handler in the PAwR layer. */
+#define PAWR_MSG_TYPE_APP               (0x00)   /* application payload, passed to the app unchanged */
+#define PAWR_MSG_TYPE_DS_DELTA          (0x01)   /* data store delta, see pawr_data_store.h */
+#define PAWR_MSG_TYPE_RELIABLE          (0x02)   /* acknowledged message, wraps another message */
+#define PAWR_MSG_TYPE_SECURE            (0x03)   /* AES-CCM protected message, see pawr_security.h */
+#define PAWR_MSG_TYPE_OTA               (0x05)   /* firmware update, see pawr_ota.h; also its status response */
+#define PAWR_MSG_TYPE_ESL               (0x06)   /* ESL commands of a group, passed to the app, see pawr_esl.h */
+#define PAWR_MSG_TYPE_FRAME             (0x07)   /* display frame delta, see pawr_frame.h; also its status response */
+#define PAWR_MSG_TYPE_PACKED            (0x08)   /* records for many devices, only ours is handled, see pawr_packed.h */
+#define PAWR_MSG_TYPE_ADDRESSED         (0x09)   /* wraps a message for some devices, see pawr_filter.h */
+#define PAWR_MSG_TYPE_BACKLOG           (0x0A)   /* backlog drain response, see pawr_backlog.h */
+#define PAWR_MSG_TYPE_FLOW              (0x0B)   /* response slot grant, see pawr_flow.h; also the flow control field */
+#define PAWR_MSG_TYPE_ESL_ADDR          (0x0C)   /* ESL ID and group of one label, see pawr_esl.h; also its confirmation */
+
+/* Reliable downlink: type, msg_id, then the wrapped message starting with its own type byte.
+ * msg_id increments per new message in a subevent; retransmissions reuse it. */
+#define PAWR_REL_HDR_LEN                (2)
+
+/* Acknowledgement piggybacked in front of a response: type, ack_id, ack_bits, then the
+ * response payload. Bit n of ack_bits acknowledges msg_id ack_id-1-n. */
+#define PAWR_MSG_TYPE_ACK               (0x02)
+#define PAWR_ACK_HDR_LEN                (3)
+
+/* Flow control field in front of a response, ahead of any acknowledgement, see pawr_flow.h. */
+#define PAWR_FLOW_HDR_LEN               (5)
+
+/* Compressed response: type, original length, token stream, see pawr_compress.h. */
+#define PAWR_MSG_TYPE_COMPRESSED        (0x04)
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+#endif /* PAWR_MSG_H_ */
+
@@ -0,0 +1,797 @@
+/******************************************************************************
+* File Name:   pawr_ota.c
+*
+* Description: This file consists of the firmware update over the PAwR downlink. Image chunks broadcast on a dedicated subevent are gathered into flash pages and written to the secondary slot by a flash task; the missing chunks go back to the central in status responses.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <stdatomic.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "pawr_ota.h"
+#include "pawr_flash.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+#include "app_bt_ring.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_OTA_TASK_STACK_SIZE        (configMINIMAL_STACK_SIZE * 4)
+#define PAWR_OTA_TASK_PRIORITY          (tskIDLE_PRIORITY + 1)
+#define PAWR_OTA_TASK_PERIOD_MS         (5)
+
+#define PAWR_OTA_CHUNKS_PER_PAGE        (PAWR_OTA_PAGE_SIZE / PAWR_OTA_CHUNK_SIZE)
+#define PAWR_OTA_MAP_WORDS              ((PAWR_OTA_MAX_CHUNKS + 31) / 32)
+#define PAWR_OTA_MAX_UNITS              (PAWR_CFG_OTA_SLOT_SIZE / PAWR_OTA_MIN_ERASE_SIZE)
+
+/* Jobs for the flash task */
+#define PAWR_OTA_JOB_BEGIN              (0)      /* new session, forget erased sectors */
+#define PAWR_OTA_JOB_WRITE              (1)      /* program len bytes at offset */
+#define PAWR_OTA_JOB_VERIFY             (2)      /* CRC offset bytes, expected CRC in data[0..3] */
+
+_Static_assert((PAWR_OTA_PAGE_SIZE % PAWR_OTA_CHUNK_SIZE) == 0, "chunks must tile a page");
+_Static_assert((PAWR_CFG_OTA_SLOT_ADDR % PAWR_OTA_MIN_ERASE_SIZE) == 0, "OTA slot must be sector aligned");
+_Static_assert((PAWR_CFG_OTA_SLOT_SIZE % PAWR_OTA_MIN_ERASE_SIZE) == 0, "OTA slot must be whole sectors");
+_Static_assert(PAWR_OTA_MAX_CHUNKS <= 0x10000, "chunk index is 16 bit");
+_Static_assert(PAWR_ACK_HDR_LEN + PAWR_OTA_STATUS_HDR_LEN + PAWR_OTA_STATUS_BITMAP_LEN <= PAWR_CFG_RSP_MAX_DATA_LEN, "OTA status does not fit a response");
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint8_t  op;
+    uint8_t  session;
+    uint16_t len;
+    uint32_t offset;                             /* from the start of the slot */
+    uint8_t  data[PAWR_OTA_PAGE_SIZE];
+} pawr_ota_job_t;
+
+/* Default backend, the serial flash shared with the other modules */
+static const pawr_ota_flash_t pawr_ota_serial_flash =
+{
+    .init       = pawr_flash_init,
+    .erase_size = pawr_flash_erase_size,
+    .erase      = pawr_flash_erase,
+    .write      = pawr_flash_write,
+    .read       = pawr_flash_read,
+};
+
+/* CRC-32 (IEEE 802.3), 4 bits per step */
+static const uint32_t ota_crc_tab[16] =
+{
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+};
+
+/* Shared between the stack and the flash task */
+APP_BT_RING_DEFINE_BUF(ota_ring_buf, sizeof(pawr_ota_job_t), PAWR_OTA_JOB_QUEUE_LEN);
+static app_bt_ring_t            ota_ring;
+static atomic_uint              ota_state;
+static atomic_uint              ota_cur_session;
+static atomic_uint              ota_pages_written;
+static atomic_uint              ota_sectors_erased;
+static atomic_uint              ota_flash_errors;
+static const pawr_ota_flash_t  *ota_flash = &pawr_ota_serial_flash;
+
+/* Stack side */
+static pawr_ota_ready_cb_t     *ota_ready_cb = NULL;
+static uint8_t                  ota_session;
+static uint32_t                 ota_image_size;
+static uint32_t                 ota_image_crc;
+static uint32_t                 ota_num_chunks;
+static uint32_t                 ota_rcvd_map[PAWR_OTA_MAP_WORDS];   /* chunks handed to the flash task */
+static uint32_t                 ota_chunks_rcvd;
+static uint32_t                 ota_chunks_dup;
+static uint32_t                 ota_chunks_dropped;
+static wiced_bool_t             ota_verify_pending;
+static uint8_t                  ota_page[PAWR_OTA_PAGE_SIZE];   /* page being gathered, written as one batch */
+static int32_t                  ota_page_idx = -1;
+static uint8_t                  ota_page_mask;   /* chunks of the page held in ota_page */
+static uint32_t                 ota_start_ms;
+static uint32_t                 ota_elapsed_ms;
+static uint16_t                 ota_last_evt;
+static uint32_t                 ota_intervals;
+static pawr_ota_job_t           ota_tx_job;      /* job being queued */
+
+/* Flash task side */
+static pawr_ota_job_t           ota_job;
+static uint8_t                  ota_erased_map[(PAWR_OTA_MAX_UNITS + 7) / 8];
+static wiced_bool_t             ota_flash_ready = WICED_FALSE;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_ota_crc32()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function continues a CRC-32 over a block. Start with 0xFFFFFFFF and invert the result.
+* @param[in] crc    , running CRC.
+* @param[in] p_data , block.
+* @param[in] len    , block length.
+* @return    uint32_t running CRC.
+**************************************************************************************************/
+static uint32_t pawr_ota_crc32(uint32_t crc, const uint8_t *p_data, uint32_t len)
+{
+    while (len--)
+    {
+        crc ^= *p_data++;
+        crc = (crc >> 4) ^ ota_crc_tab[crc & 0x0F];
+        crc = (crc >> 4) ^ ota_crc_tab[crc & 0x0F];
+    }
+    return crc;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_fail()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function ends the transfer of a session with an error, unless a newer session started.
+* Called from the flash task.
+* @param[in] session , session of the failed job.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_fail(uint8_t session)
+{
+    unsigned int state = atomic_load_explicit(&ota_state, memory_order_relaxed);
+
+    atomic_fetch_add_explicit(&ota_flash_errors, 1, memory_order_relaxed);
+    if ((session == atomic_load_explicit(&ota_cur_session, memory_order_relaxed)) &&
+        ((state == PAWR_OTA_STATE_RECEIVING) || (state == PAWR_OTA_STATE_VERIFYING)))
+    {
+        atomic_compare_exchange_strong(&ota_state, &state, PAWR_OTA_STATE_ERROR);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_prepare()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function erases the sectors under a write that were not erased yet in this session.
+* Called from the flash task.
+* @param[in] offset , write offset in the slot.
+* @param[in] len    , write length.
+* @return    wiced_bool_t WICED_TRUE when the range is erased.
+**************************************************************************************************/
+static wiced_bool_t pawr_ota_prepare(uint32_t offset, uint32_t len)
+{
+    uint32_t end = offset + len;
+    uint32_t unit;
+    uint32_t size;
+    uint32_t start;
+
+    while (offset < end)
+    {
+        unit = offset / PAWR_OTA_MIN_ERASE_SIZE;
+        if ((ota_erased_map[unit / 8] & (1U << (unit % 8))) == 0)
+        {
+            size = ota_flash->erase_size(PAWR_CFG_OTA_SLOT_ADDR + offset);
+            if (size < PAWR_OTA_MIN_ERASE_SIZE)
+            {
+                size = PAWR_OTA_MIN_ERASE_SIZE;
+            }
+            start = offset - (offset % size);
+            if ((start + size > PAWR_CFG_OTA_SLOT_SIZE) ||
+                !ota_flash->erase(PAWR_CFG_OTA_SLOT_ADDR + start, size))
+            {
+                return WICED_FALSE;
+            }
+            atomic_fetch_add_explicit(&ota_sectors_erased, 1, memory_order_relaxed);
+            for (unit = start / PAWR_OTA_MIN_ERASE_SIZE; unit < (start + size) / PAWR_OTA_MIN_ERASE_SIZE; unit++)
+            {
+                ota_erased_map[unit / 8] |= (uint8_t)(1U << (unit % 8));
+            }
+        }
+        offset = (offset / PAWR_OTA_MIN_ERASE_SIZE + 1) * PAWR_OTA_MIN_ERASE_SIZE;
+    }
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_verify()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function reads the written image back and checks its CRC. Called from the flash task.
+* @param[in] p_job , VERIFY job.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_verify(pawr_ota_job_t *p_job)
+{
+    uint32_t     expected = (uint32_t)p_job->data[0] | ((uint32_t)p_job->data[1] << 8) |
+                            ((uint32_t)p_job->data[2] << 16) | ((uint32_t)p_job->data[3] << 24);
+    uint32_t     crc = 0xFFFFFFFFUL;
+    uint32_t     offset;
+    uint32_t     len;
+    unsigned int state = PAWR_OTA_STATE_VERIFYING;
+
+    for (offset = 0; offset < p_job->offset; offset += len)
+    {
+        len = p_job->offset - offset;
+        if (len > PAWR_OTA_PAGE_SIZE)
+        {
+            len = PAWR_OTA_PAGE_SIZE;
+        }
+        if (!ota_flash->read(PAWR_CFG_OTA_SLOT_ADDR + offset, len, p_job->data))
+        {
+            pawr_ota_fail(p_job->session);
+            return;
+        }
+        crc = pawr_ota_crc32(crc, p_job->data, len);
+    }
+    if (p_job->session != atomic_load_explicit(&ota_cur_session, memory_order_relaxed))
+    {
+        return;
+    }
+    if (~crc != expected)
+    {
+        printf("pawr_ota: image CRC %08lx, expected %08lx\n", (unsigned long)~crc, (unsigned long)expected);
+    }
+    atomic_compare_exchange_strong(&ota_state, &state, (~crc == expected) ? PAWR_OTA_STATE_READY : PAWR_OTA_STATE_ERROR);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_flash_task()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs the flash jobs queued by the stack. Erasing and programming take
+* milliseconds, far too long for the Bluetooth stack context.
+* @param[in] arg , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_flash_task(void *arg)
+{
+    for (;;)
+    {
+        while (app_bt_ring_pop(&ota_ring, &ota_job))
+        {
+            if (ota_job.op == PAWR_OTA_JOB_BEGIN)
+            {
+                memset(ota_erased_map, 0, sizeof(ota_erased_map));
+                if (!ota_flash_ready)
+                {
+                    ota_flash_ready = ota_flash->init();
+                }
+                if (!ota_flash_ready)
+                {
+                    printf("pawr_ota: flash init failed\n");
+                    pawr_ota_fail(ota_job.session);
+                }
+                continue;
+            }
+            /* jobs of a replaced session are dropped, the new session rewrites the slot */
+            if (!ota_flash_ready || (ota_job.session != atomic_load_explicit(&ota_cur_session, memory_order_relaxed)))
+            {
+                continue;
+            }
+            if (ota_job.op == PAWR_OTA_JOB_VERIFY)
+            {
+                pawr_ota_verify(&ota_job);
+            }
+            else if (pawr_ota_prepare(ota_job.offset, ota_job.len) &&
+                     ota_flash->write(PAWR_CFG_OTA_SLOT_ADDR + ota_job.offset, ota_job.len, ota_job.data))
+            {
+                atomic_fetch_add_explicit(&ota_pages_written, 1, memory_order_relaxed);
+            }
+            else
+            {
+                pawr_ota_fail(ota_job.session);
+            }
+        }
+        vTaskDelay(pdMS_TO_TICKS(PAWR_OTA_TASK_PERIOD_MS));
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_now_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the time base of the transfer statistics.
+* @return    uint32_t milliseconds.
+**************************************************************************************************/
+static uint32_t pawr_ota_now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_try_verify()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues the CRC check once every chunk is with the flash task.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_try_verify(void)
+{
+    pawr_ota_job_t *p_job = &ota_tx_job;
+
+    if (!ota_verify_pending)
+    {
+        return;
+    }
+    p_job->op      = PAWR_OTA_JOB_VERIFY;
+    p_job->session = ota_session;
+    p_job->len     = 4;
+    p_job->offset  = ota_image_size;
+    p_job->data[0] = (uint8_t)ota_image_crc;
+    p_job->data[1] = (uint8_t)(ota_image_crc >> 8);
+    p_job->data[2] = (uint8_t)(ota_image_crc >> 16);
+    p_job->data[3] = (uint8_t)(ota_image_crc >> 24);
+    if (app_bt_ring_push(&ota_ring, p_job))
+    {
+        ota_verify_pending = WICED_FALSE;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_flush_page()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function hands the gathered page to the flash task, as one write when the page is
+* complete, else one write per run of received chunks. Chunks that do not fit the queue are
+* dropped and stay missing, the central sends them again.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_flush_page(void)
+{
+    uint32_t first = (uint32_t)ota_page_idx * PAWR_OTA_CHUNKS_PER_PAGE;
+    uint32_t page_off = (uint32_t)ota_page_idx * PAWR_OTA_PAGE_SIZE;
+    uint32_t c = 0;
+    uint32_t run;
+    uint32_t off;
+    uint32_t len;
+    uint32_t i;
+
+    if ((ota_page_idx < 0) || (ota_page_mask == 0))
+    {
+        ota_page_idx = -1;
+        return;
+    }
+    while (c < PAWR_OTA_CHUNKS_PER_PAGE)
+    {
+        if ((ota_page_mask & (1U << c)) == 0)
+        {
+            c++;
+            continue;
+        }
+        for (run = 1; (c + run < PAWR_OTA_CHUNKS_PER_PAGE) && (ota_page_mask & (1U << (c + run))); run++)
+        {
+        }
+        off = page_off + c * PAWR_OTA_CHUNK_SIZE;
+        len = run * PAWR_OTA_CHUNK_SIZE;
+        if (off + len > ota_image_size)
+        {
+            len = ota_image_size - off;
+        }
+        ota_tx_job.op      = PAWR_OTA_JOB_WRITE;
+        ota_tx_job.session = ota_session;
+        ota_tx_job.len     = (uint16_t)len;
+        ota_tx_job.offset  = off;
+        memcpy(ota_tx_job.data, &ota_page[c * PAWR_OTA_CHUNK_SIZE], len);
+        if (app_bt_ring_push(&ota_ring, &ota_tx_job))
+        {
+            for (i = first + c; i < first + c + run; i++)
+            {
+                ota_rcvd_map[i / 32] |= 1UL << (i % 32);
+            }
+            ota_chunks_rcvd += run;
+        }
+        else
+        {
+            ota_chunks_dropped += run;
+        }
+        c += run;
+    }
+    ota_page_idx  = -1;
+    ota_page_mask = 0;
+
+    if (ota_chunks_rcvd == ota_num_chunks)
+    {
+        ota_elapsed_ms = pawr_ota_now_ms() - ota_start_ms;
+        ota_verify_pending = WICED_TRUE;
+        atomic_store_explicit(&ota_state, PAWR_OTA_STATE_VERIFYING, memory_order_relaxed);
+        pawr_ota_try_verify();
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_send_status()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues a status response carrying the missing chunk bitmap from the first
+* missing chunk on.
+* @param[in] subevent , subevent to respond in.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_send_status(uint8_t subevent)
+{
+    uint8_t  rsp[PAWR_OTA_STATUS_HDR_LEN + PAWR_OTA_STATUS_BITMAP_LEN];
+    uint8_t  rsp_len = PAWR_OTA_STATUS_HDR_LEN;
+    uint8_t  state = (uint8_t)atomic_load_explicit(&ota_state, memory_order_relaxed);
+    uint32_t missing = 0;
+    uint32_t base = 0;
+    uint32_t i;
+
+    memset(rsp, 0, sizeof(rsp));
+    if (state == PAWR_OTA_STATE_RECEIVING)
+    {
+        missing = ota_num_chunks - ota_chunks_rcvd;
+        while ((base / 32 < PAWR_OTA_MAP_WORDS) && (ota_rcvd_map[base / 32] == 0xFFFFFFFFUL))
+        {
+            base += 32;
+        }
+        while ((base < ota_num_chunks) && (ota_rcvd_map[base / 32] & (1UL << (base % 32))))
+        {
+            base++;
+        }
+        for (i = base; (i < ota_num_chunks) && (i - base < PAWR_OTA_STATUS_BITMAP_LEN * 8); i++)
+        {
+            if ((ota_rcvd_map[i / 32] & (1UL << (i % 32))) == 0)
+            {
+                rsp[PAWR_OTA_STATUS_HDR_LEN + (i - base) / 8] |= (uint8_t)(1U << ((i - base) % 8));
+            }
+        }
+        rsp_len += (uint8_t)((i - base + 7) / 8);
+    }
+    rsp[0] = PAWR_MSG_TYPE_OTA;
+    rsp[1] = ota_session;
+    rsp[2] = state;
+    rsp[3] = (uint8_t)missing;
+    rsp[4] = (uint8_t)(missing >> 8);
+    rsp[5] = (uint8_t)base;
+    rsp[6] = (uint8_t)(base >> 8);
+    pawr_rsp_sched_submit(PAWR_RSP_PRIO_CONTROL, subevent, rsp, rsp_len);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_on_begin()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts a session. A repeated BEGIN of the running session is ignored.
+* @param[in] evt_counter , periodic event counter of the message.
+* @param[in] p_msg       , BEGIN message.
+* @param[in] msg_len     , message length.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_on_begin(uint16_t evt_counter, const uint8_t *p_msg, uint16_t msg_len)
+{
+    uint8_t  session = p_msg[2];
+    uint32_t size;
+
+    if ((msg_len < PAWR_OTA_BEGIN_LEN) ||
+        ((session == ota_session) && (atomic_load_explicit(&ota_state, memory_order_relaxed) != PAWR_OTA_STATE_IDLE)))
+    {
+        return;
+    }
+    size = (uint32_t)p_msg[3] | ((uint32_t)p_msg[4] << 8) | ((uint32_t)p_msg[5] << 16) | ((uint32_t)p_msg[6] << 24);
+    ota_session = session;
+    atomic_store_explicit(&ota_cur_session, session, memory_order_relaxed);
+    if ((size == 0) || (size > PAWR_CFG_OTA_SLOT_SIZE) || (p_msg[11] != PAWR_OTA_CHUNK_SIZE))
+    {
+        printf("pawr_ota: session %d rejected, size %lu chunk %d\n", session, (unsigned long)size, p_msg[11]);
+        atomic_store_explicit(&ota_state, PAWR_OTA_STATE_ERROR, memory_order_relaxed);
+        return;
+    }
+    ota_image_size     = size;
+    ota_image_crc      = (uint32_t)p_msg[7] | ((uint32_t)p_msg[8] << 8) | ((uint32_t)p_msg[9] << 16) | ((uint32_t)p_msg[10] << 24);
+    ota_num_chunks     = (size + PAWR_OTA_CHUNK_SIZE - 1) / PAWR_OTA_CHUNK_SIZE;
+    ota_chunks_rcvd    = 0;
+    ota_chunks_dup     = 0;
+    ota_chunks_dropped = 0;
+    ota_verify_pending = WICED_FALSE;
+    ota_page_idx       = -1;
+    ota_page_mask      = 0;
+    ota_start_ms       = pawr_ota_now_ms();
+    ota_elapsed_ms     = 0;
+    ota_last_evt       = evt_counter;
+    ota_intervals      = 0;
+    memset(ota_rcvd_map, 0, sizeof(ota_rcvd_map));
+    atomic_store_explicit(&ota_pages_written, 0, memory_order_relaxed);
+    atomic_store_explicit(&ota_sectors_erased, 0, memory_order_relaxed);
+    atomic_store_explicit(&ota_flash_errors, 0, memory_order_relaxed);
+
+    ota_tx_job.op      = PAWR_OTA_JOB_BEGIN;
+    ota_tx_job.session = session;
+    ota_tx_job.len     = 0;
+    ota_tx_job.offset  = 0;
+    /* without the flash task the session cannot start, stay idle so a repeated BEGIN retries */
+    atomic_store_explicit(&ota_state, app_bt_ring_push(&ota_ring, &ota_tx_job) ? PAWR_OTA_STATE_RECEIVING : PAWR_OTA_STATE_IDLE,
+                          memory_order_relaxed);
+    printf("pawr_ota: session %d, %lu bytes in %lu chunks\n", session, (unsigned long)size, (unsigned long)ota_num_chunks);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_on_chunk()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function gathers a chunk into its page. The page is written when complete or when a
+* chunk of another page arrives.
+* @param[in] evt_counter , periodic event counter of the message.
+* @param[in] p_msg       , CHUNK message.
+* @param[in] msg_len     , message length.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ota_on_chunk(uint16_t evt_counter, const uint8_t *p_msg, uint16_t msg_len)
+{
+    uint32_t idx;
+    uint32_t off;
+    uint32_t len;
+    int32_t  page;
+    uint8_t  bit;
+    uint32_t page_chunks;
+
+    if ((msg_len <= PAWR_OTA_CHUNK_HDR_LEN) || (p_msg[2] != ota_session) ||
+        (atomic_load_explicit(&ota_state, memory_order_relaxed) != PAWR_OTA_STATE_RECEIVING))
+    {
+        return;
+    }
+    idx = (uint32_t)p_msg[3] | ((uint32_t)p_msg[4] << 8);
+    if (idx >= ota_num_chunks)
+    {
+        return;
+    }
+    off = idx * PAWR_OTA_CHUNK_SIZE;
+    len = ota_image_size - off;
+    if (len > PAWR_OTA_CHUNK_SIZE)
+    {
+        len = PAWR_OTA_CHUNK_SIZE;
+    }
+    if ((uint32_t)(msg_len - PAWR_OTA_CHUNK_HDR_LEN) != len)
+    {
+        return;
+    }
+    page = (int32_t)(off / PAWR_OTA_PAGE_SIZE);
+    bit  = (uint8_t)(1U << (idx % PAWR_OTA_CHUNKS_PER_PAGE));
+    if ((ota_rcvd_map[idx / 32] & (1UL << (idx % 32))) ||
+        ((page == ota_page_idx) && (ota_page_mask & bit)))
+    {
+        ota_chunks_dup++;
+        return;
+    }
+    if (page != ota_page_idx)
+    {
+        pawr_ota_flush_page();
+        ota_page_idx = page;
+    }
+    memcpy(&ota_page[off % PAWR_OTA_PAGE_SIZE], &p_msg[PAWR_OTA_CHUNK_HDR_LEN], len);
+    ota_page_mask |= bit;
+    ota_intervals += (uint16_t)(evt_counter - ota_last_evt);
+    ota_last_evt   = evt_counter;
+
+    page_chunks = ota_num_chunks - (uint32_t)page * PAWR_OTA_CHUNKS_PER_PAGE;
+    if (page_chunks > PAWR_OTA_CHUNKS_PER_PAGE)
+    {
+        page_chunks = PAWR_OTA_CHUNKS_PER_PAGE;
+    }
+    if (ota_page_mask == (uint8_t)((1U << page_chunks) - 1))
+    {
+        pawr_ota_flush_page();
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_on_msg()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function handles an OTA downlink message. Messages outside PAWR_CFG_OTA_SUBEVENT are
+* ignored.
+* @param[in] subevent    , subevent the message arrived in.
+* @param[in] evt_counter , periodic event counter.
+* @param[in] p_msg       , message, starting with PAWR_MSG_TYPE_OTA.
+* @param[in] msg_len     , message length.
+* @return    void.
+**************************************************************************************************/
+void pawr_ota_on_msg(uint8_t subevent, uint16_t evt_counter, const uint8_t *p_msg, uint16_t msg_len)
+{
+    if ((subevent != PAWR_CFG_OTA_SUBEVENT) || (msg_len < 3))
+    {
+        return;
+    }
+    switch (p_msg[1])
+    {
+        case PAWR_OTA_OP_BEGIN:
+            pawr_ota_on_begin(evt_counter, p_msg, msg_len);
+        break;
+        case PAWR_OTA_OP_CHUNK:
+            pawr_ota_on_chunk(evt_counter, p_msg, msg_len);
+        break;
+        case PAWR_OTA_OP_QUERY:
+            if (p_msg[2] == ota_session)
+            {
+                /* a page still gathering would show up as missing, write it first */
+                pawr_ota_flush_page();
+                pawr_ota_try_verify();
+            }
+            pawr_ota_send_status(subevent);
+        break;
+        case PAWR_OTA_OP_APPLY:
+            if ((p_msg[2] == ota_session) &&
+                (atomic_load_explicit(&ota_state, memory_order_relaxed) == PAWR_OTA_STATE_READY) && ota_ready_cb)
+            {
+                ota_ready_cb(PAWR_CFG_OTA_SLOT_ADDR, ota_image_size);
+            }
+            pawr_ota_send_status(subevent);
+        break;
+        default:
+        break;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets up the job queue and starts the flash task. The flash is not touched until
+* a session begins.
+* @return    void.
+**************************************************************************************************/
+void pawr_ota_init(void)
+{
+    app_bt_ring_init(&ota_ring, ota_ring_buf, sizeof(pawr_ota_job_t), PAWR_OTA_JOB_QUEUE_LEN);
+    atomic_init(&ota_state, PAWR_OTA_STATE_IDLE);
+    atomic_init(&ota_cur_session, 0);
+    atomic_init(&ota_pages_written, 0);
+    atomic_init(&ota_sectors_erased, 0);
+    atomic_init(&ota_flash_errors, 0);
+    if (xTaskCreate(pawr_ota_flash_task, "pawr_ota", PAWR_OTA_TASK_STACK_SIZE, NULL, PAWR_OTA_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        printf("pawr_ota_init: task create failed\n");
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_set_flash()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function replaces the flash backend. Only call it while no session is running.
+* @param[in] p_flash , backend, NULL restores the serial flash.
+* @return    void.
+**************************************************************************************************/
+void pawr_ota_set_flash(const pawr_ota_flash_t *p_flash)
+{
+    ota_flash       = (p_flash != NULL) ? p_flash : &pawr_ota_serial_flash;
+    ota_flash_ready = WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_reg_ready_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function registers the callback run when the central applies a verified image.
+* @param[in] callback , ready callback.
+* @return    void.
+**************************************************************************************************/
+void pawr_ota_reg_ready_cb(pawr_ota_ready_cb_t *callback)
+{
+    if (callback)
+    {
+        ota_ready_cb = callback;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_get_state()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the transfer state.
+* @return    pawr_ota_state_t state.
+**************************************************************************************************/
+pawr_ota_state_t pawr_ota_get_state(void)
+{
+    return (pawr_ota_state_t)atomic_load_explicit(&ota_state, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the statistics of the current or last session.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_ota_get_stats(pawr_ota_stats_t *p_stats)
+{
+    p_stats->state          = pawr_ota_get_state();
+    p_stats->image_size     = ota_image_size;
+    p_stats->chunks_rcvd    = ota_chunks_rcvd;
+    p_stats->chunks_dup     = ota_chunks_dup;
+    p_stats->chunks_dropped = ota_chunks_dropped;
+    p_stats->pages_written  = atomic_load_explicit(&ota_pages_written, memory_order_relaxed);
+    p_stats->sectors_erased = atomic_load_explicit(&ota_sectors_erased, memory_order_relaxed);
+    p_stats->flash_errors   = atomic_load_explicit(&ota_flash_errors, memory_order_relaxed);
+    p_stats->elapsed_ms     = ((p_stats->state == PAWR_OTA_STATE_RECEIVING) || (ota_elapsed_ms == 0)) ?
+                              (pawr_ota_now_ms() - ota_start_ms) : ota_elapsed_ms;
+    p_stats->intervals      = ota_intervals;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ota_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the transfer statistics and the throughput, per second and per periodic
+* advertising interval.
+* @return    void.
+**************************************************************************************************/
+void pawr_ota_print_stats(void)
+{
+    pawr_ota_stats_t s;
+    uint32_t         bytes;
+
+    pawr_ota_get_stats(&s);
+    if (s.state == PAWR_OTA_STATE_IDLE)
+    {
+        return;
+    }
+    bytes = s.chunks_rcvd * PAWR_OTA_CHUNK_SIZE;
+    if (bytes > s.image_size)
+    {
+        bytes = s.image_size;
+    }
+    printf("ota: session %d state %d, %lu/%lu bytes, dup %lu dropped %lu, pages %lu sectors %lu, flash errors %lu\n",
+           ota_session, s.state, (unsigned long)bytes, (unsigned long)s.image_size,
+           (unsigned long)s.chunks_dup, (unsigned long)s.chunks_dropped,
+           (unsigned long)s.pages_written, (unsigned long)s.sectors_erased, (unsigned long)s.flash_errors);
+    printf("ota: %lu ms, %lu bytes/s, %lu bytes/interval over %lu intervals\n",
+           (unsigned long)s.elapsed_ms,
+           (unsigned long)((s.elapsed_ms != 0) ? ((uint64_t)bytes * 1000 / s.elapsed_ms) : 0),
+           (unsigned long)((s.intervals != 0) ? (bytes / s.intervals) : 0), (unsigned long)s.intervals);
+}
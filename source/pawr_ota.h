@@ -0,0 +1,127 @@
+/******************************************************************************
+* File Name:   pawr_ota.h
+*
+* Description: This file is the public interface of the firmware update over the PAwR downlink.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_OTA_H_
+#define PAWR_OTA_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr_config.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Downlink, on PAWR_CFG_OTA_SUBEVENT, multi byte fields little endian:
+ *   BEGIN : type, op, session, image_size(4), image_crc32(4), chunk_size
+ *   CHUNK : type, op, session, chunk_idx(2), data; chunk_size bytes, the last chunk may be shorter
+ *   QUERY : type, op, session; the peripheral answers with a status response
+ *   APPLY : type, op, session; hands a verified image to the app, see pawr_ota_reg_ready_cb()
+ * The same image is broadcast to every peripheral on the subevent. A new session id restarts
+ * the transfer. */
+#define PAWR_OTA_OP_BEGIN               (0x01)
+#define PAWR_OTA_OP_CHUNK               (0x02)
+#define PAWR_OTA_OP_QUERY               (0x03)
+#define PAWR_OTA_OP_APPLY               (0x04)
+#define PAWR_OTA_BEGIN_LEN              (12)
+#define PAWR_OTA_CHUNK_HDR_LEN          (5)
+
+/* Uplink status: type, session, state, missing(2), base_idx(2), bitmap. Bit n of the bitmap,
+ * LSB first, is set when chunk base_idx + n is still missing; base_idx is the first missing
+ * chunk, so the central retransmits only the gaps. */
+#define PAWR_OTA_STATUS_HDR_LEN         (7)
+#define PAWR_OTA_STATUS_BITMAP_LEN      (32)     /* 256 chunks per status */
+
+/* Chunks are collected into a flash page and the page is written as one batch. */
+#define PAWR_OTA_CHUNK_SIZE             (128)
+#define PAWR_OTA_PAGE_SIZE              (256)    /* serial flash program page */
+#define PAWR_OTA_MAX_CHUNKS             (PAWR_CFG_OTA_SLOT_SIZE / PAWR_OTA_CHUNK_SIZE)
+#define PAWR_OTA_MIN_ERASE_SIZE         (4096)   /* smallest erase sector tracked */
+#define PAWR_OTA_JOB_QUEUE_LEN          (8)      /* page writes between the stack and the flash task, power of two */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef enum
+{
+    PAWR_OTA_STATE_IDLE = 0,
+    PAWR_OTA_STATE_RECEIVING,
+    PAWR_OTA_STATE_VERIFYING,                    /* all chunks written, CRC check running */
+    PAWR_OTA_STATE_READY,                        /* image verified, waiting for APPLY */
+    PAWR_OTA_STATE_ERROR,
+} pawr_ota_state_t;
+
+/* Flash backend, offsets are relative to the start of the flash. The default uses the
+ * serial-flash library; a stand-in, e.g. backed by a file, can be installed before a transfer. */
+typedef struct
+{
+    wiced_bool_t (*init)(void);
+    uint32_t     (*erase_size)(uint32_t addr);
+    wiced_bool_t (*erase)(uint32_t addr, uint32_t len);
+    wiced_bool_t (*write)(uint32_t addr, uint32_t len, const uint8_t *p_data);
+    wiced_bool_t (*read)(uint32_t addr, uint32_t len, uint8_t *p_data);
+} pawr_ota_flash_t;
+
+typedef struct
+{
+    pawr_ota_state_t state;
+    uint32_t image_size;
+    uint32_t chunks_rcvd;                        /* distinct chunks written */
+    uint32_t chunks_dup;                         /* retransmissions of chunks already held */
+    uint32_t chunks_dropped;                     /* accepted chunks lost to a full job queue */
+    uint32_t pages_written;
+    uint32_t sectors_erased;
+    uint32_t flash_errors;
+    uint32_t elapsed_ms;                         /* BEGIN to the last chunk written */
+    uint32_t intervals;                          /* periodic events over the same span */
+} pawr_ota_stats_t;
+
+/* A verified image is in the secondary slot; the app marks it for the bootloader and resets. */
+typedef void (pawr_ota_ready_cb_t)(uint32_t slot_addr, uint32_t image_size);
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_ota_init(void);
+void pawr_ota_set_flash(const pawr_ota_flash_t *p_flash);
+void pawr_ota_reg_ready_cb(pawr_ota_ready_cb_t *callback);
+void pawr_ota_on_msg(uint8_t subevent, uint16_t evt_counter, const uint8_t *p_msg, uint16_t msg_len);
+pawr_ota_state_t pawr_ota_get_state(void);
+void pawr_ota_get_stats(pawr_ota_stats_t *p_stats);
+void pawr_ota_print_stats(void);
+#endif /* PAWR_OTA_H_ */
@@ -0,0 +1,284 @@
+/******************************************************************************
+* File Name:   pawr_packed.c
+*
+* Description: This file consists of the lookup of this device's record in a packed multi-device downlink message. The lookup touches O(log n) index entries or O(n / 32) bitmap words, never the other devices' records.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "pawr_packed.h"
+#include "pawr_msg.h"
+#include "app_bt_utils.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint8_t             packed_id = PAWR_PACKED_ID_NONE;
+static pawr_packed_stats_t packed_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_packed_popcount()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function counts the set bits of a word. Cortex-M has no population count instruction,
+* the SWAR sum takes a dozen cycles where the library call loops per bit.
+* @param[in] v , word.
+* @return    uint32_t number of set bits.
+**************************************************************************************************/
+static inline uint32_t pawr_packed_popcount(uint32_t v)
+{
+    v = v - ((v >> 1) & 0x55555555UL);
+    v = (v & 0x33333333UL) + ((v >> 2) & 0x33333333UL);
+    v = (v + (v >> 4)) & 0x0F0F0F0FUL;
+    return (uint32_t)(v * 0x01010101UL) >> 24;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_packed_find_index()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function binary searches the sorted index of an INDEX message.
+* @param[in]  p_msg   , packed message.
+* @param[in]  msg_len , message length.
+* @param[out] pp_rec  , this device's record.
+* @return     uint16_t record length, 0 when there is none.
+**************************************************************************************************/
+static uint16_t pawr_packed_find_index(const uint8_t *p_msg, uint16_t msg_len, const uint8_t **pp_rec)
+{
+    const uint8_t *p_idx = &p_msg[PAWR_PACKED_INDEX_HDR_LEN];
+    uint16_t       n     = p_msg[2];
+    uint16_t       data_len;
+    uint16_t       lo    = 0;
+    uint16_t       hi    = n;
+    uint16_t       mid;
+    uint16_t       start;
+
+    if ((msg_len < PAWR_PACKED_INDEX_HDR_LEN) || (PAWR_PACKED_INDEX_HDR_LEN + 2 * n > msg_len))
+    {
+        packed_stats.malformed++;
+        return 0;
+    }
+    packed_stats.records += n;
+    data_len = (uint16_t)(msg_len - PAWR_PACKED_INDEX_HDR_LEN - 2 * n);
+    while (lo < hi)
+    {
+        mid = (uint16_t)((lo + hi) / 2);
+        if (p_idx[2 * mid] < packed_id)
+        {
+            lo = (uint16_t)(mid + 1);
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if ((lo == n) || (p_idx[2 * lo] != packed_id))
+    {
+        packed_stats.absent++;
+        return 0;
+    }
+    /* only our entry and the one before it are checked, the rest of the index is never read */
+    start = (lo != 0) ? p_idx[2 * lo - 1] : 0;
+    if ((p_idx[2 * lo + 1] <= start) || (p_idx[2 * lo + 1] > data_len))
+    {
+        packed_stats.malformed++;
+        return 0;
+    }
+    packed_stats.found++;
+    *pp_rec = &p_msg[PAWR_PACKED_INDEX_HDR_LEN + 2 * n + start];
+    return (uint16_t)(p_idx[2 * lo + 1] - start);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_packed_find_bitmap()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function ranks this device's bit in the bitmap of a BITMAP message.
+* @param[in]  p_msg   , packed message.
+* @param[in]  msg_len , message length.
+* @param[out] pp_rec  , this device's record.
+* @return     uint16_t record length, 0 when there is none.
+**************************************************************************************************/
+static uint16_t pawr_packed_find_bitmap(const uint8_t *p_msg, uint16_t msg_len, const uint8_t **pp_rec)
+{
+    const uint8_t *p_map   = &p_msg[PAWR_PACKED_BITMAP_HDR_LEN];
+    uint8_t        rec_len = p_msg[2];
+    uint8_t        map_len = p_msg[4];
+    uint16_t       bit     = (uint16_t)(packed_id - p_msg[3]);
+    uint32_t       rank    = 0;
+    uint32_t       word;
+    uint16_t       total;
+    uint16_t       i;
+
+    if ((msg_len < PAWR_PACKED_BITMAP_HDR_LEN) || (rec_len == 0) || (PAWR_PACKED_BITMAP_HDR_LEN + map_len > msg_len))
+    {
+        packed_stats.malformed++;
+        return 0;
+    }
+    total = (uint16_t)((msg_len - PAWR_PACKED_BITMAP_HDR_LEN - map_len) / rec_len);
+    packed_stats.records += total;
+    if ((packed_id < p_msg[3]) || (bit >= map_len * 8) || ((p_map[bit / 8] & (1U << (bit % 8))) == 0))
+    {
+        packed_stats.absent++;
+        return 0;
+    }
+    /* whole words below our bit, then the bits below it in its own byte */
+    for (i = 0; i + 4 <= bit / 8; i += 4)
+    {
+        memcpy(&word, &p_map[i], sizeof(word));
+        rank += pawr_packed_popcount(word);
+    }
+    for (; i < bit / 8; i++)
+    {
+        rank += pawr_packed_popcount(p_map[i]);
+    }
+    rank += pawr_packed_popcount(p_map[bit / 8] & ((1U << (bit % 8)) - 1));
+    if (rank >= total)
+    {
+        packed_stats.malformed++;
+        return 0;
+    }
+    packed_stats.found++;
+    *pp_rec = &p_map[map_len + rank * rec_len];
+    return rec_len;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_packed_set_id()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the ID records are looked up by, e.g. the ESL ID.
+* @param[in] id , device ID, PAWR_PACKED_ID_NONE to ignore packed messages.
+* @return    void.
+**************************************************************************************************/
+void pawr_packed_set_id(uint8_t id)
+{
+    packed_id = id;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_packed_find()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function finds this device's record in a packed message.
+* @param[in]  p_msg   , message, starting with PAWR_MSG_TYPE_PACKED.
+* @param[in]  msg_len , message length.
+* @param[out] pp_rec  , this device's record, a complete message.
+* @return     uint16_t record length, 0 when the message holds nothing for this device.
+**************************************************************************************************/
+uint16_t pawr_packed_find(const uint8_t *p_msg, uint16_t msg_len, const uint8_t **pp_rec)
+{
+    uint32_t start = APP_BT_UTIL_CYCLES();
+    uint16_t len   = 0;
+
+    packed_stats.messages++;
+    if ((msg_len < 2) || (packed_id == PAWR_PACKED_ID_NONE))
+    {
+        packed_stats.absent++;
+    }
+    else if (p_msg[1] == PAWR_PACKED_FMT_INDEX)
+    {
+        len = pawr_packed_find_index(p_msg, msg_len, pp_rec);
+    }
+    else if (p_msg[1] == PAWR_PACKED_FMT_BITMAP)
+    {
+        len = pawr_packed_find_bitmap(p_msg, msg_len, pp_rec);
+    }
+    else
+    {
+        packed_stats.malformed++;
+    }
+    packed_stats.cycles += APP_BT_UTIL_CYCLES() - start;
+    return len;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_packed_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the lookup statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_packed_get_stats(pawr_packed_stats_t *p_stats)
+{
+    *p_stats = packed_stats;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_packed_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the lookup statistics and the average cost of a lookup.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_packed_print_stats(void)
+{
+    if (packed_stats.messages == 0)
+    {
+        return;
+    }
+    printf("pawr packed: messages:%lu, found:%lu, absent:%lu, malformed:%lu, records/msg:%lu, cycles/lookup:%lu\n",
+           (unsigned long)packed_stats.messages,
+           (unsigned long)packed_stats.found,
+           (unsigned long)packed_stats.absent,
+           (unsigned long)packed_stats.malformed,
+           (unsigned long)(packed_stats.records / packed_stats.messages),
+           (unsigned long)(packed_stats.cycles / packed_stats.messages));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:   pawr_packed.h
+*
+* Description: This file is the public interface of the packed multi-device downlink records.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_PACKED_H_
+#define PAWR_PACKED_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* A packed message carries one record for each of many devices; each record is itself a complete
+ * message starting with its type byte. Two layouts, chosen by the central per message:
+ *   INDEX  : type, fmt, n, n x (id, end), records
+ *            ids strictly increasing; end is the offset just past the record, counted from the
+ *            first record; a record starts where the previous one ends. Found by binary search.
+ *   BITMAP : type, fmt, rec_len, base_id, map_len, bitmap, records
+ *            bit k, LSB first, set when device base_id + k has a record; records are rec_len
+ *            bytes each in bit order. Found by counting the set bits below ours.
+ * Only the record for this device's ID goes on; a message without one ends here. */
+#define PAWR_PACKED_FMT_INDEX           (0x00)
+#define PAWR_PACKED_FMT_BITMAP          (0x01)
+#define PAWR_PACKED_INDEX_HDR_LEN       (3)
+#define PAWR_PACKED_BITMAP_HDR_LEN      (5)
+#define PAWR_PACKED_ID_NONE             (0xFF)   /* matches no record */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t messages;                           /* packed messages looked at */
+    uint32_t found;                              /* with a record for this device */
+    uint32_t absent;                             /* without one */
+    uint32_t malformed;
+    uint32_t records;                            /* records in all messages looked at */
+    uint32_t cycles;                             /* spent in lookups */
+} pawr_packed_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_packed_set_id(uint8_t id);
+uint16_t pawr_packed_find(const uint8_t *p_msg, uint16_t msg_len, const uint8_t **pp_rec);
+void pawr_packed_get_stats(pawr_packed_stats_t *p_stats);
+void pawr_packed_print_stats(void);
+#endif /* PAWR_PACKED_H_ */
@@ -0,0 +1,319 @@
+/******************************************************************************
+* File Name:   pawr_prefetch.c
+*
+* Description: This file consists of PAwR response prefetch. The application stages the response for an upcoming event ahead of time and the PAwR layer submits it as soon as the request report arrives, keeping the application handler off the request to response path.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdatomic.h>
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "pawr.h"
+#include "pawr_rsp_sched.h"
+#include "pawr_prefetch.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* One staged response per subevent. Written by a single application task, read by the Bluetooth
+ * stack context through a sequence lock; seq is odd while the entry is being written. The reader
+ * never waits for the writer, a torn read simply falls back to the callback. The payload is
+ * accessed with relaxed atomics, plain loads and stores on the target, so that the read racing a
+ * write is defined. */
+typedef struct
+{
+    atomic_uint    seq;
+    atomic_ushort  evt_counter;                  /* event the response is meant for */
+    atomic_uchar   data_len;
+    atomic_uchar   data[PAWR_RSP_MAX_DATA_LEN];
+} pawr_prefetch_entry_t;
+
+static pawr_prefetch_entry_t     prefetch_entry[PAWR_PREFETCH_MAX_SUBEVENTS];
+static uint32_t                  prefetch_taken[PAWR_PREFETCH_MAX_SUBEVENTS];    /* seq already consumed, stack context */
+static atomic_uint               prefetch_last_evt[PAWR_PREFETCH_MAX_SUBEVENTS];
+static pawr_prefetch_demand_cb_t *prefetch_demand_cb = NULL;
+static pawr_prefetch_stats_t     prefetch_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_prefetch_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears staged responses and statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_prefetch_init(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PAWR_PREFETCH_MAX_SUBEVENTS; i++)
+    {
+        atomic_init(&prefetch_entry[i].seq, 0);
+        atomic_init(&prefetch_last_evt[i], 0);
+        prefetch_taken[i] = 0;
+    }
+    memset(&prefetch_stats, 0, sizeof(prefetch_stats));
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prefetch_reset()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is called on a new sync. Responses staged for the old train's event counter are
+* marked consumed so none of them can match the new one.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_prefetch_reset(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PAWR_PREFETCH_MAX_SUBEVENTS; i++)
+    {
+        prefetch_taken[i] = atomic_load_explicit(&prefetch_entry[i].seq, memory_order_acquire) & ~1UL;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prefetch_reg_demand_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function registers the check for requests that need a content dependent response.
+* Without it every request is answered with the staged response when there is one.
+* @param[in] callback , demand check, called in the Bluetooth stack context.
+* @return    void.
+**************************************************************************************************/
+void pawr_prefetch_reg_demand_cb(pawr_prefetch_demand_cb_t *callback)
+{
+    prefetch_demand_cb = callback;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prefetch_next_evt()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the event the next request of a subevent is expected in.
+* @param[in] subevent , subevent.
+* @return    uint16_t periodic_evt_counter of the next request.
+**************************************************************************************************/
+uint16_t pawr_prefetch_next_evt(uint8_t subevent)
+{
+    if (subevent >= PAWR_PREFETCH_MAX_SUBEVENTS)
+    {
+        return 0;
+    }
+    return (uint16_t)(atomic_load_explicit(&prefetch_last_evt[subevent], memory_order_relaxed) + 1);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prefetch_stage()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function stages the response for a future request, replacing any earlier one. Call it
+* from one application task during idle time, typically right after the previous request with
+* pawr_prefetch_next_evt().
+* @param[in] subevent    , subevent of the request.
+* @param[in] evt_counter , periodic_evt_counter of the request.
+* @param[in] p_data      , response payload, copied.
+* @param[in] data_len    , response payload length.
+* @return    wiced_bool_t WICED_TRUE if staged.
+**************************************************************************************************/
+wiced_bool_t pawr_prefetch_stage(uint8_t subevent, uint16_t evt_counter, const uint8_t *p_data, uint8_t data_len)
+{
+    pawr_prefetch_entry_t *e;
+    uint32_t               seq;
+    uint8_t                i;
+
+    if ((subevent >= PAWR_PREFETCH_MAX_SUBEVENTS) || (data_len > PAWR_RSP_MAX_DATA_LEN) ||
+        ((p_data == NULL) && (data_len != 0)))
+    {
+        return WICED_FALSE;
+    }
+    e   = &prefetch_entry[subevent];
+    seq = atomic_load_explicit(&e->seq, memory_order_relaxed);
+    atomic_store_explicit(&e->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&e->evt_counter, evt_counter, memory_order_relaxed);
+    atomic_store_explicit(&e->data_len, data_len, memory_order_relaxed);
+    for (i = 0; i < data_len; i++)
+    {
+        atomic_store_explicit(&e->data[i], p_data[i], memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&e->seq, seq + 2, memory_order_release);
+    prefetch_stats.staged++;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prefetch_submit()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is called by the PAwR layer on a request report, before the app callback. A
+* response staged for this event is handed to the response scheduler.
+* @param[in] subevent    , subevent of the report.
+* @param[in] evt_counter , periodic_evt_counter of the report.
+* @param[in] p_msg       , request payload, for the demand check.
+* @param[in] msg_len     , request payload length.
+* @return    wiced_bool_t WICED_TRUE if a staged response was submitted.
+**************************************************************************************************/
+wiced_bool_t pawr_prefetch_submit(uint8_t subevent, uint16_t evt_counter, const uint8_t *p_msg, uint16_t msg_len)
+{
+    pawr_prefetch_entry_t *e;
+    uint8_t                data[PAWR_RSP_MAX_DATA_LEN];
+    uint32_t               seq;
+    uint16_t               evt;
+    uint8_t                len;
+    uint8_t                i;
+
+    if (subevent >= PAWR_PREFETCH_MAX_SUBEVENTS)
+    {
+        return WICED_FALSE;
+    }
+    atomic_store_explicit(&prefetch_last_evt[subevent], evt_counter, memory_order_relaxed);
+    e   = &prefetch_entry[subevent];
+    seq = atomic_load_explicit(&e->seq, memory_order_acquire);
+    if (seq == prefetch_taken[subevent])
+    {
+        prefetch_stats.miss++;
+        return WICED_FALSE;
+    }
+    if (seq & 1)
+    {
+        prefetch_stats.busy++;
+        return WICED_FALSE;
+    }
+    evt = atomic_load_explicit(&e->evt_counter, memory_order_relaxed);
+    len = atomic_load_explicit(&e->data_len, memory_order_relaxed);
+    if (len > PAWR_RSP_MAX_DATA_LEN)
+    {
+        len = PAWR_RSP_MAX_DATA_LEN;
+    }
+    for (i = 0; i < len; i++)
+    {
+        data[i] = atomic_load_explicit(&e->data[i], memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_acquire);
+    if (seq != atomic_load_explicit(&e->seq, memory_order_relaxed))
+    {
+        prefetch_stats.busy++;
+        return WICED_FALSE;
+    }
+
+    if ((int16_t)(evt - evt_counter) < 0)
+    {
+        prefetch_taken[subevent] = seq;
+        prefetch_stats.stale++;
+        return WICED_FALSE;
+    }
+    if (evt != evt_counter)
+    {
+        /* staged for a later event, keep it */
+        prefetch_stats.miss++;
+        return WICED_FALSE;
+    }
+    if (prefetch_demand_cb && prefetch_demand_cb(subevent, p_msg, msg_len))
+    {
+        prefetch_stats.demanded++;
+        return WICED_FALSE;
+    }
+    if (pawr_rsp_sched_submit(PAWR_RSP_PRIO_TELEMETRY, subevent, data, len) != WICED_BT_SUCCESS)
+    {
+        return WICED_FALSE;
+    }
+    prefetch_taken[subevent] = seq;
+    prefetch_stats.hit++;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prefetch_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the prefetch statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_prefetch_get_stats(pawr_prefetch_stats_t *p_stats)
+{
+    if (p_stats)
+    {
+        *p_stats = prefetch_stats;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_prefetch_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the prefetch statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_prefetch_print_stats(void)
+{
+    printf("pawr prefetch: staged:%lu, hit:%lu, miss:%lu, stale:%lu, demanded:%lu, busy:%lu\n",
+           (unsigned long)prefetch_stats.staged,
+           (unsigned long)prefetch_stats.hit,
+           (unsigned long)prefetch_stats.miss,
+           (unsigned long)prefetch_stats.stale,
+           (unsigned long)prefetch_stats.demanded,
+           (unsigned long)prefetch_stats.busy);
+}
+
+/* [] END OF FILE */
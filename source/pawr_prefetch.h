@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name:   pawr_prefetch.h
+*
+* Description: This file is the public interface of PAwR response prefetch.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_PREFETCH_H_
+#define PAWR_PREFETCH_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_PREFETCH_MAX_SUBEVENTS     (PAWR_CFG_SUBEVENT_TABLE_LEN)   /* subevents 0..N-1, see pawr_config.h */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+/* Returns WICED_TRUE when the request needs a response built from its contents, in which case
+ * the staged response is kept and the app callback answers instead. */
+typedef wiced_bool_t (pawr_prefetch_demand_cb_t)(uint8_t subevent, const uint8_t *p_msg, uint16_t msg_len);
+
+typedef struct
+{
+    uint32_t staged;                             /* pawr_prefetch_stage() calls */
+    uint32_t hit;                                /* staged responses submitted on the report */
+    uint32_t miss;                               /* reports without a response staged for them */
+    uint32_t stale;                              /* staged for an event that had already passed */
+    uint32_t demanded;                           /* requests that wanted the callback instead */
+    uint32_t busy;                               /* staging raced with the report, callback used */
+} pawr_prefetch_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_prefetch_init(void);
+void pawr_prefetch_reset(void);
+void pawr_prefetch_reg_demand_cb(pawr_prefetch_demand_cb_t *callback);
+uint16_t pawr_prefetch_next_evt(uint8_t subevent);
+wiced_bool_t pawr_prefetch_stage(uint8_t subevent, uint16_t evt_counter, const uint8_t *p_data, uint8_t data_len);
+wiced_bool_t pawr_prefetch_submit(uint8_t subevent, uint16_t evt_counter, const uint8_t *p_msg, uint16_t msg_len);
+void pawr_prefetch_get_stats(pawr_prefetch_stats_t *p_stats);
+void pawr_prefetch_print_stats(void);
+#endif /* PAWR_PREFETCH_H_ */
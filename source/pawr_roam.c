@@ -0,0 +1,588 @@
+/******************************************************************************
+* File Name:   pawr_roam.c
+*
+* Description: This file consists of roaming between known PAwR centrals. The known centrals are loaded into the periodic advertiser list so that an unsynced peripheral joins whichever it hears first. A poor serving link starts a scan for the others, and the peripheral hands over to a clearly stronger one.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_timer.h"
+#include "pawr.h"
+#include "pawr_roam.h"
+#include "pawr_cmd.h"
+#include "pawr_link.h"
+#include "app_bt_dispatch.h"
+#include "app_bt_utils.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_ROAM_CMD_TIMEOUT_MS        (1000)
+#define PAWR_ROAM_NONE                  (-1)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef enum
+{
+    PAWR_ROAM_IDLE = 0,                          /* not synced, joining any known central */
+    PAWR_ROAM_SERVING,                           /* synced, watching the link */
+    PAWR_ROAM_SURVEY,                            /* synced, scanning for a stronger central */
+    PAWR_ROAM_HANDOVER,                          /* sync dropped, joining the chosen central */
+} pawr_roam_state_t;
+
+typedef struct
+{
+    wiced_bt_ble_address_type_t addr_type;
+    wiced_bt_device_address_t   addr;
+    uint8_t                     sid;
+    int16_t                     rssi;            /* averaged extended advertising RSSI, dBm */
+    uint8_t                     samples;
+    uint32_t                    seen_ms;
+} pawr_roam_central_t;
+
+static pawr_roam_central_t roam_central[PAWR_ROAM_MAX_CENTRALS];
+static uint8_t             roam_num         = 0;
+static uint8_t             roam_load_idx    = 0;
+static wiced_bool_t        roam_list_dirty  = WICED_FALSE;  /* the controller's list is out of date */
+static pawr_roam_state_t   roam_state       = PAWR_ROAM_IDLE;
+static int8_t              roam_serving     = PAWR_ROAM_NONE;
+static int8_t              roam_target      = PAWR_ROAM_NONE;
+static uint8_t             roam_poor        = 0;
+static uint32_t            roam_state_ms    = 0;            /* survey or handover start */
+static uint32_t            roam_backoff_ms  = 0;            /* no survey before this */
+static wiced_bool_t        roam_lost        = WICED_FALSE;
+static uint32_t            roam_lost_ms     = 0;
+static wiced_timer_t       roam_timer;
+static pawr_roam_stats_t   roam_stats;
+
+static wiced_bt_dev_status_t pawr_roam_issue_clear(void);
+static wiced_bt_dev_status_t pawr_roam_issue_add(void);
+
+static const pawr_cmd_t roam_cmd_clear = {"pa_list_clear", pawr_roam_issue_clear, PAWR_CMD_DONE_ON_STATUS, PAWR_ROAM_CMD_TIMEOUT_MS, 6, PAWR_CMD_OP_LIST_CLEAR};
+static const pawr_cmd_t roam_cmd_add   = {"pa_list_add",   pawr_roam_issue_add,   PAWR_CMD_DONE_ON_STATUS, PAWR_ROAM_CMD_TIMEOUT_MS, 7, PAWR_CMD_OP_LIST_ADD};
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_roam_now_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the local time in milliseconds.
+* @return    uint32_t time, ms.
+**************************************************************************************************/
+static uint32_t pawr_roam_now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_find()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function looks up a known central.
+* @param[in] addr , advertiser address.
+* @param[in] sid  , advertising set ID.
+* @return    int8_t index, PAWR_ROAM_NONE when unknown.
+**************************************************************************************************/
+static int8_t pawr_roam_find(const uint8_t *addr, uint8_t sid)
+{
+    uint8_t i;
+
+    for (i = 0; i < roam_num; i++)
+    {
+        if ((roam_central[i].sid == sid) && (memcmp(roam_central[i].addr, addr, BD_ADDR_LEN) == 0))
+        {
+            return (int8_t)i;
+        }
+    }
+    return PAWR_ROAM_NONE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_issue_clear()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears the controller's periodic advertiser list.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_roam_issue_clear(void)
+{
+    roam_load_idx = 0;
+    return wiced_ble_padv_clear_list();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_issue_add()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function adds the next known central to the periodic advertiser list. The list is up to
+* date once the last one went in.
+* @return    wiced_bt_dev_status_t status of the call.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_roam_issue_add(void)
+{
+    pawr_roam_central_t  *p_c = &roam_central[roam_load_idx % PAWR_ROAM_MAX_CENTRALS];
+    wiced_bt_dev_status_t status;
+
+    status = wiced_ble_padv_add_device_to_list(p_c->addr_type, p_c->addr, p_c->sid);
+    roam_load_idx++;
+    if ((roam_load_idx == roam_num) && ((status == WICED_BT_SUCCESS) || (status == WICED_BT_PENDING)))
+    {
+        roam_list_dirty = WICED_FALSE;
+    }
+    return status;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_link()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function rates the serving link by its best subevent.
+* @param[out] p_rssi , averaged downlink RSSI, dBm.
+* @param[out] p_loss , averaged report loss, percent.
+* @return     wiced_bool_t WICED_FALSE while no subevent has enough samples.
+**************************************************************************************************/
+static wiced_bool_t pawr_roam_link(int16_t *p_rssi, uint8_t *p_loss)
+{
+    pawr_link_info_t info;
+    wiced_bool_t     valid = WICED_FALSE;
+    uint8_t          i;
+
+    for (i = 0; i < PAWR_LINK_MAX_SUBEVENTS; i++)
+    {
+        if (!pawr_link_get_info(i, &info) || (info.reports < PAWR_LINK_MIN_SAMPLES))
+        {
+            continue;
+        }
+        if (!valid || (info.rssi > *p_rssi))
+        {
+            *p_rssi = info.rssi;
+            *p_loss = info.loss_pct;
+            valid   = WICED_TRUE;
+        }
+    }
+    return valid;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_best()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the strongest other central heard recently enough.
+* @param[in] now , local time, ms.
+* @return    int8_t index, PAWR_ROAM_NONE when there is none.
+**************************************************************************************************/
+static int8_t pawr_roam_best(uint32_t now)
+{
+    int8_t  best = PAWR_ROAM_NONE;
+    uint8_t i;
+
+    for (i = 0; i < roam_num; i++)
+    {
+        pawr_roam_central_t *p_c = &roam_central[i];
+
+        if (((int8_t)i == roam_serving) || (p_c->samples < PAWR_ROAM_MIN_SAMPLES) ||
+            ((now - p_c->seen_ms) > PAWR_ROAM_SAMPLE_MAX_AGE_MS))
+        {
+            continue;
+        }
+        if ((best == PAWR_ROAM_NONE) || (p_c->rssi > roam_central[best].rssi))
+        {
+            best = (int8_t)i;
+        }
+    }
+    return best;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_on_scan_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the dispatch handler of extended advertising reports. It averages the RSSI
+* of the known centrals.
+* @param[in] event        , APP_BT_DISPATCH_EXT_SCAN_REPORT.
+* @param[in] p_event_data , wiced_ble_ext_scan_results_t.
+* @return    wiced_result_t WICED_BT_SUCCESS.
+**************************************************************************************************/
+static wiced_result_t pawr_roam_on_scan_report(uint32_t event, void *p_event_data)
+{
+    wiced_ble_ext_scan_results_t *p_rpt = (wiced_ble_ext_scan_results_t *)p_event_data;
+    pawr_roam_central_t          *p_c;
+    uint32_t                      now   = pawr_roam_now_ms();
+    int8_t                        idx   = pawr_roam_find(p_rpt->bd_addr, p_rpt->adv_sid);
+
+    if (idx == PAWR_ROAM_NONE)
+    {
+        return WICED_BT_SUCCESS;
+    }
+    p_c = &roam_central[idx];
+    if ((p_c->samples == 0) || ((now - p_c->seen_ms) > PAWR_ROAM_SAMPLE_MAX_AGE_MS))
+    {
+        p_c->rssi    = p_rpt->rssi;
+        p_c->samples = 0;
+    }
+    else
+    {
+        p_c->rssi += (int16_t)((p_rpt->rssi - p_c->rssi) / (1 << PAWR_ROAM_EWMA_SHIFT));
+    }
+    if (p_c->samples < UINT8_MAX)
+    {
+        p_c->samples++;
+    }
+    p_c->seen_ms = now;
+    return WICED_BT_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_end_survey()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function stops the scan of a survey that found no better central.
+* @param[in] now , local time, ms.
+* @return    void.
+**************************************************************************************************/
+static void pawr_roam_end_survey(uint32_t now)
+{
+    pawr_scan_enable(WICED_FALSE);
+    roam_state      = PAWR_ROAM_SERVING;
+    roam_poor       = 0;
+    roam_backoff_ms = now + PAWR_ROAM_SURVEY_BACKOFF_MS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_timer_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function checks the serving link and drives surveys and handovers.
+* @param[in] cb_params , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_roam_timer_cb(WICED_TIMER_PARAM_TYPE cb_params)
+{
+    uint32_t now  = pawr_roam_now_ms();
+    int16_t  rssi = 0;
+    uint8_t  loss = 0;
+    int8_t   best;
+
+    switch (roam_state)
+    {
+    case PAWR_ROAM_SERVING:
+        if (!pawr_roam_link(&rssi, &loss))
+        {
+            break;
+        }
+        roam_poor = ((rssi < PAWR_ROAM_TRIGGER_RSSI) || (loss > PAWR_ROAM_TRIGGER_LOSS_PCT)) ? (uint8_t)(roam_poor + 1) : 0;
+        if ((roam_poor >= PAWR_ROAM_TRIGGER_CHECKS) && ((int32_t)(now - roam_backoff_ms) >= 0))
+        {
+            roam_stats.surveys++;
+            roam_state    = PAWR_ROAM_SURVEY;
+            roam_state_ms = now;
+            pawr_scan_enable(WICED_TRUE);
+        }
+        break;
+
+    case PAWR_ROAM_SURVEY:
+        if (!pawr_roam_link(&rssi, &loss))
+        {
+            break;
+        }
+        best = pawr_roam_best(now);
+        if ((best != PAWR_ROAM_NONE) && (roam_central[best].rssi >= rssi + PAWR_ROAM_HYSTERESIS_DB))
+        {
+            printf("pawr roam: handover, serving rssi:%d, candidate rssi:%d, addr: ", rssi, roam_central[best].rssi);
+            app_bt_util_print_bd_address(roam_central[best].addr);
+            roam_state    = PAWR_ROAM_HANDOVER;
+            roam_state_ms = now;
+            roam_target   = best;
+            pawr_resync();
+        }
+        else if (((now - roam_state_ms) >= PAWR_ROAM_SURVEY_MS) ||
+                 ((rssi >= PAWR_ROAM_TRIGGER_RSSI + PAWR_ROAM_HYSTERESIS_DB) && (loss <= PAWR_ROAM_TRIGGER_LOSS_PCT)))
+        {
+            pawr_roam_end_survey(now);
+        }
+        break;
+
+    case PAWR_ROAM_HANDOVER:
+        if ((now - roam_state_ms) >= PAWR_ROAM_HANDOVER_TIMEOUT_MS)
+        {
+            /* the chosen central is gone as well, join any known one; the outage runs on */
+            printf("pawr roam: handover timeout\n");
+            roam_stats.handover_fails++;
+            roam_stats.losses++;
+            roam_state   = PAWR_ROAM_IDLE;
+            roam_target  = PAWR_ROAM_NONE;
+            roam_lost    = WICED_TRUE;
+            roam_lost_ms = roam_state_ms;
+            pawr_scan_for_pawr_network();
+        }
+        break;
+
+    default:
+        break;
+    }
+    if (roam_state != PAWR_ROAM_IDLE)
+    {
+        wiced_start_timer(&roam_timer, PAWR_ROAM_CHECK_MS);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function initializes roaming.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_roam_init(void)
+{
+    wiced_init_timer(&roam_timer, pawr_roam_timer_cb, 0, WICED_MILLI_SECONDS_TIMER);
+    app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, pawr_roam_on_scan_report);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_add_central()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function adds a known central. The periodic advertiser list is reloaded at the next scan.
+* @param[in] addr_type , advertiser address type.
+* @param[in] addr      , advertiser address.
+* @param[in] sid       , advertising set ID of the periodic advertising train.
+* @return    wiced_bool_t WICED_FALSE when the table is full.
+**************************************************************************************************/
+wiced_bool_t pawr_roam_add_central(wiced_bt_ble_address_type_t addr_type, const uint8_t *addr, uint8_t sid)
+{
+    pawr_roam_central_t *p_c;
+
+    if (pawr_roam_find(addr, sid) != PAWR_ROAM_NONE)
+    {
+        return WICED_TRUE;
+    }
+    if (roam_num == PAWR_ROAM_MAX_CENTRALS)
+    {
+        printf("pawr roam: central table full\n");
+        return WICED_FALSE;
+    }
+    p_c = &roam_central[roam_num++];
+    memset(p_c, 0, sizeof(*p_c));
+    p_c->addr_type  = addr_type;
+    p_c->sid        = sid;
+    memcpy(p_c->addr, addr, BD_ADDR_LEN);
+    roam_list_dirty = WICED_TRUE;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_prepare_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function picks what the next create sync goes to: the central chosen by a handover, or
+* else every known central through the periodic advertiser list, which is reloaded first when
+* it changed. Without known centrals the parameters stay as they are.
+* @param[in,out] p_sync , create sync parameters.
+* @return        wiced_bool_t WICED_FALSE without known centrals.
+**************************************************************************************************/
+wiced_bool_t pawr_roam_prepare_sync(wiced_ble_padv_create_sync_params_t *p_sync)
+{
+    uint8_t i;
+
+    if (roam_target != PAWR_ROAM_NONE)
+    {
+        p_sync->options       = WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST;
+        p_sync->adv_addr_type = roam_central[roam_target].addr_type;
+        p_sync->adv_sid       = roam_central[roam_target].sid;
+        memcpy(p_sync->adv_addr, roam_central[roam_target].addr, BD_ADDR_LEN);
+        return WICED_TRUE;
+    }
+    if (roam_num == 0)
+    {
+        return WICED_FALSE;
+    }
+    if (roam_list_dirty)
+    {
+        pawr_cmd_submit(&roam_cmd_clear);
+        for (i = 0; i < roam_num; i++)
+        {
+            pawr_cmd_submit(&roam_cmd_add);
+        }
+    }
+    p_sync->options = WICED_BLE_PADV_CREATE_SYNC_OPTION_USE_PA_LIST;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_on_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts watching the new serving link and closes the handover or outage timing.
+* @param[in] ps , sync established event data.
+* @return    void.
+**************************************************************************************************/
+void pawr_roam_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps)
+{
+    uint32_t now = pawr_roam_now_ms();
+    uint32_t ms;
+    uint8_t  i;
+
+    if (roam_state == PAWR_ROAM_HANDOVER)
+    {
+        ms = now - roam_state_ms;
+        roam_stats.handovers++;
+        roam_stats.handover_ms_sum += ms;
+        if (ms > roam_stats.handover_ms_max)
+        {
+            roam_stats.handover_ms_max = ms;
+        }
+    }
+    else if (roam_lost)
+    {
+        ms = now - roam_lost_ms;
+        roam_stats.outage_ms_sum += ms;
+        if (ms > roam_stats.outage_ms_max)
+        {
+            roam_stats.outage_ms_max = ms;
+        }
+    }
+    for (i = 0; i < roam_num; i++)
+    {
+        roam_central[i].samples = 0;
+    }
+    roam_lost     = WICED_FALSE;
+    roam_target   = PAWR_ROAM_NONE;
+    roam_serving  = pawr_roam_find(ps->adv_addr, ps->adv_sid);
+    roam_poor     = 0;
+    roam_state    = PAWR_ROAM_SERVING;
+    if (wiced_is_timer_in_use(&roam_timer))
+    {
+        wiced_stop_timer(&roam_timer);
+    }
+    wiced_start_timer(&roam_timer, PAWR_ROAM_CHECK_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_on_sync_lost()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts the outage timing when the sync went down on its own; a handover keeps
+* its own timing.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_roam_on_sync_lost(void)
+{
+    if (roam_state == PAWR_ROAM_HANDOVER)
+    {
+        return;
+    }
+    if (wiced_is_timer_in_use(&roam_timer))
+    {
+        wiced_stop_timer(&roam_timer);
+    }
+    roam_stats.losses++;
+    roam_state   = PAWR_ROAM_IDLE;
+    roam_serving = PAWR_ROAM_NONE;
+    roam_lost    = WICED_TRUE;
+    roam_lost_ms = pawr_roam_now_ms();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the roaming statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_roam_get_stats(pawr_roam_stats_t *p_stats)
+{
+    *p_stats = roam_stats;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_roam_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the roaming statistics and the known centrals.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_roam_print_stats(void)
+{
+    uint8_t i;
+
+    printf("pawr roam: surveys:%lu, handovers:%lu, fails:%lu, handover avg:%lu max:%lu ms, losses:%lu, outage avg:%lu max:%lu ms\n",
+           (unsigned long)roam_stats.surveys,
+           (unsigned long)roam_stats.handovers,
+           (unsigned long)roam_stats.handover_fails,
+           (unsigned long)((roam_stats.handovers != 0) ? (roam_stats.handover_ms_sum / roam_stats.handovers) : 0),
+           (unsigned long)roam_stats.handover_ms_max,
+           (unsigned long)roam_stats.losses,
+           (unsigned long)((roam_stats.losses != 0) ? (roam_stats.outage_ms_sum / roam_stats.losses) : 0),
+           (unsigned long)roam_stats.outage_ms_max);
+    for (i = 0; i < roam_num; i++)
+    {
+        printf("central %d%s sid:%d, rssi:%d, samples:%d, addr: ", i, ((int8_t)i == roam_serving) ? "*" : "",
+               roam_central[i].sid, roam_central[i].rssi, roam_central[i].samples);
+        app_bt_util_print_bd_address(roam_central[i].addr);
+    }
+}
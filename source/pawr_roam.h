@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name:   pawr_roam.h
+*
+* Description: This file is the public interface of roaming between known PAwR centrals.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_ROAM_H_
+#define PAWR_ROAM_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_ROAM_MAX_CENTRALS          (4)      /* known centrals, loaded into the periodic advertiser list */
+#define PAWR_ROAM_CHECK_MS              (500)    /* serving link check period */
+#define PAWR_ROAM_TRIGGER_RSSI          (-80)    /* dBm, a serving link below this starts a survey */
+#define PAWR_ROAM_TRIGGER_LOSS_PCT      (20)     /* report loss above this starts a survey */
+#define PAWR_ROAM_TRIGGER_CHECKS        (3)      /* consecutive poor checks before a survey */
+#define PAWR_ROAM_HYSTERESIS_DB         (6)      /* a candidate must beat the serving link by this */
+#define PAWR_ROAM_MIN_SAMPLES           (3)      /* advertising reports before a candidate counts */
+#define PAWR_ROAM_SAMPLE_MAX_AGE_MS     (2000)   /* older candidate samples are stale */
+#define PAWR_ROAM_EWMA_SHIFT            (2)      /* weight 1/4 per advertising report */
+#define PAWR_ROAM_SURVEY_MS             (3000)   /* scan for candidates while synced */
+#define PAWR_ROAM_SURVEY_BACKOFF_MS     (10000)  /* after a survey without a better central */
+#define PAWR_ROAM_HANDOVER_TIMEOUT_MS   (5000)   /* sync to the chosen central, then any known one */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t surveys;                            /* scans started on a poor serving link */
+    uint32_t handovers;                          /* synced to the chosen central */
+    uint32_t handover_fails;                     /* chosen central not synced in time */
+    uint32_t handover_ms_sum;                    /* handover start to sync established */
+    uint32_t handover_ms_max;
+    uint32_t losses;                             /* sync lost */
+    uint32_t outage_ms_sum;                      /* sync lost to sync established */
+    uint32_t outage_ms_max;
+} pawr_roam_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_roam_init(void);
+wiced_bool_t pawr_roam_add_central(wiced_bt_ble_address_type_t addr_type, const uint8_t *addr, uint8_t sid);
+wiced_bool_t pawr_roam_prepare_sync(wiced_ble_padv_create_sync_params_t *p_sync);
+void pawr_roam_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps);
+void pawr_roam_on_sync_lost(void);
+void pawr_roam_get_stats(pawr_roam_stats_t *p_stats);
+void pawr_roam_print_stats(void);
+#endif /* PAWR_ROAM_H_ */
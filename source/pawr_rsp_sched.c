@@ -0,0 +1,660 @@
+/******************************************************************************
+* File Name:   pawr_rsp_sched.c
+*
+* Description: This file consists of the PAwR response scheduler. Pending responses are kept in per-priority class queues and placed into the response slots of each subevent by priority and age.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "pawr.h"
+#include "pawr_rsp_sched.h"
+#ifdef ENABLE_PAWR_COMPRESSION
+#include "pawr_compress.h"
+#endif
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_RSP_SCHED_NO_SLOT          (0xFF)
+
+_Static_assert(2 * PAWR_RSP_SCHED_MAX_SLOTS <= 8, "slot bitmap of pawr_rsp_sched_service() is 8 bit");
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint16_t enq_evt;                            /* periodic_evt_counter when queued */
+    uint8_t  subevent;                           /* required subevent or PAWR_RSP_SCHED_ANY_SUBEVENT */
+    uint8_t  slot;                               /* reserved slot index or PAWR_RSP_SCHED_ANY_SLOT */
+    uint8_t  data_len;
+    uint8_t  data[PAWR_RSP_MAX_DATA_LEN];
+} pawr_rsp_entry_t;
+
+typedef struct
+{
+    uint8_t          count;
+    pawr_rsp_entry_t entry[PAWR_RSP_SCHED_QUEUE_DEPTH];   /* FIFO, oldest first */
+} pawr_rsp_queue_t;
+
+static pawr_rsp_queue_t       rsp_queue[PAWR_RSP_PRIO_NUM];
+static pawr_rsp_sched_stats_t rsp_stats[PAWR_RSP_PRIO_NUM];
+static uint8_t                rsp_first_slot[PAWR_RSP_SCHED_MAX_SUBEVENTS];
+static uint8_t                rsp_num_slots[PAWR_RSP_SCHED_MAX_SUBEVENTS];
+static uint8_t                rsp_grant_first[PAWR_RSP_SCHED_MAX_SUBEVENTS];   /* extra slots lent by the central */
+static uint8_t                rsp_grant_num[PAWR_RSP_SCHED_MAX_SUBEVENTS];
+static uint16_t               rsp_last_evt     = 0;
+static wiced_bool_t           rsp_restamp      = WICED_TRUE;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears all queues, statistics and slot assignments.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_rsp_sched_init(void)
+{
+    memset(rsp_queue, 0, sizeof(rsp_queue));
+    memset(rsp_stats, 0, sizeof(rsp_stats));
+    memset(rsp_first_slot, PAWR_RSP_SCHED_NO_SLOT, sizeof(rsp_first_slot));
+    memset(rsp_num_slots, 0, sizeof(rsp_num_slots));
+    memset(rsp_grant_num, 0, sizeof(rsp_grant_num));
+    rsp_last_evt = 0;
+    rsp_restamp  = WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_set_slots()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function assigns the response slots this peripheral owns in a subevent.
+* @param[in] subevent   , PAwR subevent.
+* @param[in] first_slot , first response slot owned in the subevent.
+* @param[in] num_slots  , number of consecutive slots owned, 0 releases the subevent.
+* @return    wiced_bool_t WICED_TRUE if the assignment was accepted.
+**************************************************************************************************/
+wiced_bool_t pawr_rsp_sched_set_slots(uint8_t subevent, uint8_t first_slot, uint8_t num_slots)
+{
+    if ((subevent >= PAWR_RSP_SCHED_MAX_SUBEVENTS) || (num_slots > PAWR_RSP_SCHED_MAX_SLOTS) ||
+        ((uint16_t)first_slot + num_slots > 0xFF))
+    {
+        printf("pawr_rsp_sched_set_slots: bad param se:%d,slot:%d,num:%d\n", subevent, first_slot, num_slots);
+        return WICED_FALSE;
+    }
+    rsp_first_slot[subevent] = (num_slots != 0) ? first_slot : PAWR_RSP_SCHED_NO_SLOT;
+    rsp_num_slots[subevent]  = num_slots;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_grant()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes extra response slots the central lends in a subevent, on top of the slots
+* owned there. A subevent without owned slots becomes usable this way. A new grant replaces the
+* previous one of the subevent.
+* @param[in] subevent   , PAwR subevent.
+* @param[in] first_slot , first granted slot, must not overlap the owned slots.
+* @param[in] num_slots  , number of consecutive granted slots, 0 ends the grant.
+* @return    wiced_bool_t WICED_TRUE if the grant was accepted.
+**************************************************************************************************/
+wiced_bool_t pawr_rsp_sched_grant(uint8_t subevent, uint8_t first_slot, uint8_t num_slots)
+{
+    if ((subevent >= PAWR_RSP_SCHED_MAX_SUBEVENTS) || (num_slots > PAWR_RSP_SCHED_MAX_SLOTS) ||
+        ((uint16_t)first_slot + num_slots > 0xFF) ||
+        ((num_slots != 0) && (rsp_num_slots[subevent] != 0) &&
+         (first_slot < rsp_first_slot[subevent] + rsp_num_slots[subevent]) &&
+         (rsp_first_slot[subevent] < first_slot + num_slots)))
+    {
+        printf("pawr_rsp_sched_grant: bad param se:%d,slot:%d,num:%d\n", subevent, first_slot, num_slots);
+        return WICED_FALSE;
+    }
+    rsp_grant_first[subevent] = first_slot;
+    rsp_grant_num[subevent]   = num_slots;
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_release_grants()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function gives every granted slot back, for example when the sync is lost.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_rsp_sched_release_grants(void)
+{
+    memset(rsp_grant_num, 0, sizeof(rsp_grant_num));
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_num_slots()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the response slots usable in a subevent.
+* @param[in] subevent , PAwR subevent.
+* @return    uint8_t owned plus granted slots.
+**************************************************************************************************/
+uint8_t pawr_rsp_sched_num_slots(uint8_t subevent)
+{
+    if (subevent >= PAWR_RSP_SCHED_MAX_SUBEVENTS)
+    {
+        return 0;
+    }
+    return (uint8_t)(rsp_num_slots[subevent] + rsp_grant_num[subevent]);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_pending()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the responses waiting in all classes and how long the oldest has waited
+* up to the last serviced event.
+* @param[out] p_oldest_age , events the oldest response has waited, 0 if none.
+* @return     uint8_t pending responses.
+**************************************************************************************************/
+uint8_t pawr_rsp_sched_pending(uint16_t *p_oldest_age)
+{
+    uint8_t  prio;
+    uint8_t  count = 0;
+    uint16_t age;
+
+    *p_oldest_age = 0;
+    for (prio = 0; prio < PAWR_RSP_PRIO_NUM; prio++)
+    {
+        /* FIFO per class, the first entry is the oldest of the class */
+        if (rsp_queue[prio].count != 0)
+        {
+            age = rsp_restamp ? 0 : (uint16_t)(rsp_last_evt - rsp_queue[prio].entry[0].enq_evt);
+            if (age > *p_oldest_age)
+            {
+                *p_oldest_age = age;
+            }
+        }
+        count = (uint8_t)(count + rsp_queue[prio].count);
+    }
+    return count;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_enqueue()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues a response in its class.
+* @param[in] prio     , priority class of the response.
+* @param[in] subevent , subevent the response must go out in, or PAWR_RSP_SCHED_ANY_SUBEVENT.
+* @param[in] slot     , slot index the response must go out in, or PAWR_RSP_SCHED_ANY_SLOT.
+* @param[in] p_data   , response payload, copied. May be NULL for an empty response.
+* @param[in] data_len , response payload length. With ENABLE_PAWR_COMPRESSION a frame longer
+*                       than PAWR_RSP_MAX_DATA_LEN is accepted when it compresses to fit.
+* @return    wiced_bt_dev_status_t WICED_BT_SUCCESS if queued.
+**************************************************************************************************/
+static wiced_bt_dev_status_t pawr_rsp_sched_enqueue(pawr_rsp_prio_t prio, uint8_t subevent, uint8_t slot,
+                                                    const uint8_t *p_data, uint8_t data_len)
+{
+    pawr_rsp_queue_t *q;
+    pawr_rsp_entry_t *e;
+    uint16_t         cmp_len = 0;
+
+    if ((prio >= PAWR_RSP_PRIO_NUM) || ((p_data == NULL) && (data_len != 0)))
+    {
+        return WICED_BT_BADARG;
+    }
+    q = &rsp_queue[prio];
+    if (q->count >= PAWR_RSP_SCHED_QUEUE_DEPTH)
+    {
+        rsp_stats[prio].dropped++;
+        return WICED_BT_NO_RESOURCES;
+    }
+    e = &q->entry[q->count];
+#ifdef ENABLE_PAWR_COMPRESSION
+    /* compress straight into the queue entry, the report path only copies it out */
+    cmp_len = pawr_cmp_compress(p_data, data_len, e->data, PAWR_RSP_MAX_DATA_LEN);
+#endif
+    if ((cmp_len == 0) && (data_len > PAWR_RSP_MAX_DATA_LEN))
+    {
+        return WICED_BT_BADARG;
+    }
+    q->count++;
+    e->enq_evt  = rsp_last_evt;
+    e->subevent = subevent;
+    e->slot     = slot;
+    e->data_len = (cmp_len != 0) ? (uint8_t)cmp_len : data_len;
+    if ((cmp_len == 0) && (data_len != 0))
+    {
+        memcpy(e->data, p_data, data_len);
+    }
+
+    rsp_stats[prio].enqueued++;
+    rsp_stats[prio].depth = q->count;
+    if (q->count > rsp_stats[prio].depth_max)
+    {
+        rsp_stats[prio].depth_max = q->count;
+    }
+    return WICED_BT_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_submit()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues a response for the next available slot. Must be called from the
+* Bluetooth stack context, the same context pawr_rsp_sched_service() runs in.
+* @param[in] prio     , priority class of the response.
+* @param[in] subevent , subevent the response must go out in, or PAWR_RSP_SCHED_ANY_SUBEVENT.
+* @param[in] p_data   , response payload, copied. May be NULL for an empty response.
+* @param[in] data_len , response payload length. With ENABLE_PAWR_COMPRESSION a frame longer
+*                       than PAWR_RSP_MAX_DATA_LEN is accepted when it compresses to fit.
+* @return    wiced_bt_dev_status_t WICED_BT_SUCCESS if queued.
+**************************************************************************************************/
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    return pawr_rsp_sched_enqueue(prio, subevent, PAWR_RSP_SCHED_ANY_SLOT, p_data, data_len);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_submit_slot()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function queues a response that must go out in one particular slot of a subevent, for
+* responses whose slot the request assigns. The slot is taken before other responses are placed;
+* a second response for the same slot waits for the next event. Bluetooth stack context only.
+* @param[in] prio     , priority class of the response.
+* @param[in] subevent , subevent the response must go out in.
+* @param[in] slot     , index into the usable slots of the subevent, owned ones first, below
+*                       pawr_rsp_sched_num_slots().
+* @param[in] p_data   , response payload, copied. May be NULL for an empty response.
+* @param[in] data_len , response payload length.
+* @return    wiced_bt_dev_status_t WICED_BT_SUCCESS if queued, WICED_BT_BADARG for a slot this
+*            peripheral does not have.
+**************************************************************************************************/
+wiced_bt_dev_status_t pawr_rsp_sched_submit_slot(pawr_rsp_prio_t prio, uint8_t subevent, uint8_t slot,
+                                                 const uint8_t *p_data, uint8_t data_len)
+{
+    if (slot >= pawr_rsp_sched_num_slots(subevent))
+    {
+        return WICED_BT_BADARG;
+    }
+    return pawr_rsp_sched_enqueue(prio, subevent, slot, p_data, data_len);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_remove()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function removes an entry from a class queue keeping FIFO order.
+* @param[in] prio , priority class.
+* @param[in] idx  , entry index.
+* @return    void.
+**************************************************************************************************/
+static void pawr_rsp_sched_remove(pawr_rsp_prio_t prio, uint8_t idx)
+{
+    pawr_rsp_queue_t *q = &rsp_queue[prio];
+
+    q->count--;
+    if (idx < q->count)
+    {
+        memmove(&q->entry[idx], &q->entry[idx + 1], (q->count - idx) * sizeof(pawr_rsp_entry_t));
+    }
+    rsp_stats[prio].depth = q->count;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_expire()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function stamps responses queued before the timebase was known and drops the ones that
+* have waited longer than PAWR_RSP_SCHED_MAX_AGE_EVENTS.
+* @param[in] evt_counter , current periodic_evt_counter.
+* @return    void.
+**************************************************************************************************/
+static void pawr_rsp_sched_expire(uint16_t evt_counter)
+{
+    uint8_t prio;
+    uint8_t idx;
+
+    for (prio = 0; prio < PAWR_RSP_PRIO_NUM; prio++)
+    {
+        idx = 0;
+        while (idx < rsp_queue[prio].count)
+        {
+            pawr_rsp_entry_t *e = &rsp_queue[prio].entry[idx];
+            if (rsp_restamp)
+            {
+                e->enq_evt = evt_counter;
+            }
+            if ((uint16_t)(evt_counter - e->enq_evt) > PAWR_RSP_SCHED_MAX_AGE_EVENTS)
+            {
+                rsp_stats[prio].expired++;
+                pawr_rsp_sched_remove((pawr_rsp_prio_t)prio, idx);
+                continue;
+            }
+            idx++;
+        }
+    }
+    rsp_restamp  = WICED_FALSE;
+    rsp_last_evt = evt_counter;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_pick()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function selects the response for one free slot. Each class queue offers its oldest entry
+* that may go out in the subevent and has no slot reserved; the winner is the lowest effective priority, which drops by one class
+* for every PAWR_RSP_SCHED_AGING_EVENTS waited. Aged entries never outrank a pending alarm, and ties
+* go to the higher original class.
+* @param[in]  evt_counter , current periodic_evt_counter.
+* @param[in]  subevent    , subevent being served.
+* @param[out] p_prio      , class of the selected entry.
+* @param[out] p_idx       , index of the selected entry.
+* @return     wiced_bool_t WICED_TRUE if an entry was selected.
+**************************************************************************************************/
+static wiced_bool_t pawr_rsp_sched_pick(uint16_t evt_counter, uint8_t subevent, uint8_t *p_prio, uint8_t *p_idx)
+{
+    wiced_bool_t found      = WICED_FALSE;
+    uint8_t      ready[PAWR_RSP_PRIO_NUM];
+    int32_t      best_eff   = INT32_MAX;
+    uint8_t      prio;
+    uint8_t      idx;
+
+    for (prio = 0; prio < PAWR_RSP_PRIO_NUM; prio++)
+    {
+        ready[prio] = WICED_FALSE;
+        for (idx = 0; idx < rsp_queue[prio].count; idx++)
+        {
+            pawr_rsp_entry_t *e = &rsp_queue[prio].entry[idx];
+            if ((e->slot == PAWR_RSP_SCHED_ANY_SLOT) &&
+                ((e->subevent == PAWR_RSP_SCHED_ANY_SUBEVENT) || (e->subevent == subevent)))
+            {
+                uint16_t age = (uint16_t)(evt_counter - e->enq_evt);
+                int32_t  eff = ((int32_t)prio * PAWR_RSP_SCHED_AGING_EVENTS) - (int32_t)age;
+
+                if ((prio != PAWR_RSP_PRIO_ALARM) && (eff < 1))
+                {
+                    eff = 1;
+                }
+                ready[prio] = WICED_TRUE;
+                if (eff < best_eff)
+                {
+                    best_eff = eff;
+                    *p_prio  = prio;
+                    *p_idx   = idx;
+                    found    = WICED_TRUE;
+                }
+                break;
+            }
+        }
+    }
+
+    /* account the slot as a starvation event for every other class that had work */
+    if (found)
+    {
+        for (prio = 0; prio < PAWR_RSP_PRIO_NUM; prio++)
+        {
+            if (ready[prio] && (prio != *p_prio))
+            {
+                rsp_stats[prio].starved++;
+            }
+        }
+    }
+    return found;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_send()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function hands one queued response to the controller and takes it off its queue.
+* @param[in] sync_handle , handle for synchronized advertising train.
+* @param[in] evt_counter , periodic_evt_counter of the indication report.
+* @param[in] subevent    , subevent of the indication report.
+* @param[in] slot        , slot index in the subevent, owned slots first, then granted ones.
+* @param[in] prio        , class of the response.
+* @param[in] idx         , index of the response in its class queue.
+* @return    wiced_bool_t WICED_TRUE if sent, WICED_FALSE leaves it queued for the next event.
+**************************************************************************************************/
+static wiced_bool_t pawr_rsp_sched_send(uint16_t sync_handle, uint16_t evt_counter, uint8_t subevent,
+                                        uint8_t slot, uint8_t prio, uint8_t idx)
+{
+    wiced_bt_dev_status_t status;
+    pawr_rsp_entry_t      *e   = &rsp_queue[prio].entry[idx];
+    uint16_t              age  = (uint16_t)(evt_counter - e->enq_evt);
+
+    status = pawr_snd_se_rsp_central(sync_handle,
+                                     evt_counter,
+                                     subevent,
+                                     subevent,
+                                     (slot < rsp_num_slots[subevent]) ?
+                                     (uint8_t)(rsp_first_slot[subevent] + slot) :
+                                     (uint8_t)(rsp_grant_first[subevent] + slot - rsp_num_slots[subevent]),
+                                     e->data_len,
+                                     e->data);
+    if (status != WICED_SUCCESS)
+    {
+        printf("pawr_rsp_sched snd error:%d\n", status);
+        return WICED_FALSE;
+    }
+    rsp_stats[prio].sent++;
+    rsp_stats[prio].age_sum += age;
+    if (age > rsp_stats[prio].age_max)
+    {
+        rsp_stats[prio].age_max = age;
+    }
+    pawr_rsp_sched_remove((pawr_rsp_prio_t)prio, idx);
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_service()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function fills the response slots usable in a subevent. Responses with a reserved slot
+* take it first, by class; the best pending responses fill the slots left.
+* Called by the PAwR layer once the subevent indication report has been handed to the app.
+* @param[in] sync_handle , handle for synchronized advertising train.
+* @param[in] evt_counter , periodic_evt_counter of the indication report.
+* @param[in] subevent    , subevent of the indication report.
+* @return    uint8_t number of responses handed to the controller.
+**************************************************************************************************/
+uint8_t pawr_rsp_sched_service(uint16_t sync_handle, uint16_t evt_counter, uint8_t subevent)
+{
+    uint8_t sent = 0;
+    uint8_t used = 0;                            /* bit per slot index, 2 * PAWR_RSP_SCHED_MAX_SLOTS */
+    uint8_t num_slots;
+    uint8_t slot;
+    uint8_t prio = PAWR_RSP_PRIO_NUM;
+    uint8_t idx  = 0;
+
+    pawr_rsp_sched_expire(evt_counter);
+    if (subevent >= PAWR_RSP_SCHED_MAX_SUBEVENTS)
+    {
+        return 0;
+    }
+    num_slots = (uint8_t)(rsp_num_slots[subevent] + rsp_grant_num[subevent]);
+
+    for (prio = 0; prio < PAWR_RSP_PRIO_NUM; prio++)
+    {
+        idx = 0;
+        while (idx < rsp_queue[prio].count)
+        {
+            pawr_rsp_entry_t *e = &rsp_queue[prio].entry[idx];
+
+            /* a reservation beyond the slots held now waits, or expires */
+            if ((e->slot != PAWR_RSP_SCHED_ANY_SLOT) && (e->subevent == subevent) && (e->slot < num_slots) &&
+                ((used & (1u << e->slot)) == 0))
+            {
+                slot = e->slot;
+                if (!pawr_rsp_sched_send(sync_handle, evt_counter, subevent, slot, prio, idx))
+                {
+                    return sent;
+                }
+                used |= (uint8_t)(1u << slot);
+                sent++;
+                continue;
+            }
+            idx++;
+        }
+    }
+
+    for (slot = 0; slot < num_slots; slot++)
+    {
+        if ((used & (1u << slot)) != 0)
+        {
+            continue;
+        }
+        if (!pawr_rsp_sched_pick(evt_counter, subevent, &prio, &idx) ||
+            !pawr_rsp_sched_send(sync_handle, evt_counter, subevent, slot, prio, idx))
+        {
+            /* leave it queued, the next event gets another try */
+            break;
+        }
+        sent++;
+    }
+    return sent;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_reset_timebase()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is called on a new sync. The periodic_evt_counter of the new train is unrelated
+* to the old one, so pending responses are restamped on the first serviced event.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_rsp_sched_reset_timebase(void)
+{
+    rsp_restamp = WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_flush()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function discards every pending response. Statistics are kept.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_rsp_sched_flush(void)
+{
+    uint8_t prio;
+
+    for (prio = 0; prio < PAWR_RSP_PRIO_NUM; prio++)
+    {
+        rsp_queue[prio].count = 0;
+        rsp_stats[prio].depth = 0;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the statistics of a priority class.
+* @param[in]  prio    , priority class.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_rsp_sched_get_stats(pawr_rsp_prio_t prio, pawr_rsp_sched_stats_t *p_stats)
+{
+    if ((prio < PAWR_RSP_PRIO_NUM) && (p_stats != NULL))
+    {
+        *p_stats = rsp_stats[prio];
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_rsp_sched_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the statistics of every priority class.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_rsp_sched_print_stats(void)
+{
+    uint8_t prio;
+
+    for (prio = 0; prio < PAWR_RSP_PRIO_NUM; prio++)
+    {
+        pawr_rsp_sched_stats_t *s = &rsp_stats[prio];
+        printf("rsp prio:%d, enq:%lu, sent:%lu, drop:%lu, exp:%lu, starved:%lu, age_avg:%lu, age_max:%d, depth:%d/%d\n",
+               prio,
+               (unsigned long)s->enqueued,
+               (unsigned long)s->sent,
+               (unsigned long)s->dropped,
+               (unsigned long)s->expired,
+               (unsigned long)s->starved,
+               (unsigned long)((s->sent != 0) ? (s->age_sum / s->sent) : 0),
+               s->age_max,
+               s->depth,
+               s->depth_max);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name:   pawr_rsp_sched.h
+*
+* Description: This file consists of the inteface for the PAwR response scheduler.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_RSP_SCHED_H_
+#define PAWR_RSP_SCHED_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "pawr_config.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_RSP_SCHED_QUEUE_DEPTH      (4)      /* pending responses per priority class */
+#define PAWR_RSP_SCHED_MAX_SUBEVENTS    (PAWR_CFG_SUBEVENT_TABLE_LEN)   /* subevents 0..N-1, see pawr_config.h */
+#define PAWR_RSP_SCHED_MAX_SLOTS        (4)      /* max response slots per subevent, owned and granted each */
+#define PAWR_RSP_SCHED_ANY_SUBEVENT     (0xFF)   /* response may go out in any subevent */
+#define PAWR_RSP_SCHED_ANY_SLOT         (0xFF)   /* response may go out in any usable slot */
+#define PAWR_RSP_SCHED_AGING_EVENTS     (8)      /* events of waiting that raise priority one class */
+#define PAWR_RSP_SCHED_MAX_AGE_EVENTS   (256)    /* pending responses older than this are dropped */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef enum
+{
+    PAWR_RSP_PRIO_ALARM = 0,                     /* never outranked by aged lower classes */
+    PAWR_RSP_PRIO_CONTROL,
+    PAWR_RSP_PRIO_TELEMETRY,
+    PAWR_RSP_PRIO_NUM
+} pawr_rsp_prio_t;
+
+typedef struct
+{
+    uint32_t enqueued;                           /* responses accepted by pawr_rsp_sched_submit() */
+    uint32_t sent;                               /* responses handed to the controller */
+    uint32_t dropped;                            /* rejected because the class queue was full */
+    uint32_t expired;                            /* discarded after PAWR_RSP_SCHED_MAX_AGE_EVENTS */
+    uint32_t starved;                            /* slots given to another class while this one waited */
+    uint32_t age_sum;                            /* sum of queueing ages of sent responses, in events */
+    uint16_t age_max;                            /* worst queueing age of a sent response, in events */
+    uint8_t  depth;                              /* current queue depth */
+    uint8_t  depth_max;                          /* queue depth high-water mark */
+} pawr_rsp_sched_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_rsp_sched_init(void);
+wiced_bool_t pawr_rsp_sched_set_slots(uint8_t subevent, uint8_t first_slot, uint8_t num_slots);
+wiced_bool_t pawr_rsp_sched_grant(uint8_t subevent, uint8_t first_slot, uint8_t num_slots);
+void pawr_rsp_sched_release_grants(void);
+uint8_t pawr_rsp_sched_num_slots(uint8_t subevent);
+uint8_t pawr_rsp_sched_pending(uint16_t *p_oldest_age);
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len);
+wiced_bt_dev_status_t pawr_rsp_sched_submit_slot(pawr_rsp_prio_t prio, uint8_t subevent, uint8_t slot,
+                                                 const uint8_t *p_data, uint8_t data_len);
+uint8_t pawr_rsp_sched_service(uint16_t sync_handle, uint16_t evt_counter, uint8_t subevent);
+void pawr_rsp_sched_reset_timebase(void);
+void pawr_rsp_sched_flush(void);
+void pawr_rsp_sched_get_stats(pawr_rsp_prio_t prio, pawr_rsp_sched_stats_t *p_stats);
+void pawr_rsp_sched_print_stats(void);
+#endif /* PAWR_RSP_SCHED_H_ */
+
@@ -0,0 +1,694 @@
+/******************************************************************************
+* File Name:   pawr_security.c
+*
+* Description: This file consists of the optional PAwR payload security layer. Payloads are protected with AES-128-CCM; the block cipher runs on the Cryptolite block when the device has one and in software otherwise.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "cybsp.h"
+#include "wiced_bt_ble.h"
+#include "pawr_msg.h"
+#include "pawr_security.h"
+#include "app_bt_utils.h"
+#if defined(CY_IP_MXCRYPTOLITE)
+#include "cy_cryptolite_aes.h"
+#endif
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_SEC_BLOCK_LEN              (16)
+#define PAWR_SEC_NONCE_LEN              (13)     /* CCM with a two byte length field */
+#define PAWR_SEC_DIR_DOWNLINK           (0x00)   /* in the key id byte of the nonce */
+#define PAWR_SEC_DIR_UPLINK             (0x80)
+#define PAWR_SEC_SIZE_BUCKETS           (8)      /* 32-byte payload size buckets for cycle stats */
+#define PAWR_SEC_NO_KEY                 (0xFF)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* Per-key context, expanded once at sync time so nothing but block encryptions run per message. */
+typedef struct
+{
+    wiced_bool_t                    valid;
+    uint8_t                         key[PAWR_SEC_KEY_LEN];
+#if defined(CY_IP_MXCRYPTOLITE)
+    cy_stc_cryptolite_aes_state_t   aes_state;
+    cy_stc_cryptolite_aes_buffers_t aes_buffers;
+#else
+    uint8_t                         round_key[176];
+#endif
+} pawr_sec_key_ctx_t;
+
+/* Replay state of one central. seq is (epoch << 24) | (evt_counter << 8) | subevent, bit n of
+ * window is set when seq top-n was accepted. */
+typedef struct
+{
+    wiced_bool_t              in_use;
+    wiced_bt_device_address_t addr;
+    uint64_t                  top;
+    uint32_t                  window;
+} pawr_sec_replay_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t bytes;
+    uint32_t cycles;
+} pawr_sec_cycle_stats_t;
+
+static pawr_sec_key_ctx_t     sec_key[PAWR_SEC_MAX_KEYS];
+static pawr_sec_replay_t      sec_replay[PAWR_SEC_MAX_CENTRALS];
+static pawr_sec_replay_t      *sec_cur_replay = NULL;
+static wiced_bt_device_address_t sec_central_addr;
+static wiced_bt_device_address_t sec_device_addr;
+static wiced_bool_t           sec_device_set = WICED_FALSE;
+static uint8_t                sec_tx_key_id  = PAWR_SEC_NO_KEY;
+static uint16_t               sec_tx_epoch   = 0;
+static uint32_t               sec_mic_fail   = 0;
+static uint32_t               sec_replayed   = 0;
+static uint32_t               sec_no_key     = 0;
+static pawr_sec_cycle_stats_t sec_open_stats[PAWR_SEC_SIZE_BUCKETS];
+static pawr_sec_cycle_stats_t sec_seal_stats[PAWR_SEC_SIZE_BUCKETS];
+
+#if !defined(CY_IP_MXCRYPTOLITE)
+static const uint8_t sec_sbox[256] =
+{
+    0x63,0x7c,0x77,0x7b,0xf2,0x6b,0x6f,0xc5,0x30,0x01,0x67,0x2b,0xfe,0xd7,0xab,0x76,
+    0xca,0x82,0xc9,0x7d,0xfa,0x59,0x47,0xf0,0xad,0xd4,0xa2,0xaf,0x9c,0xa4,0x72,0xc0,
+    0xb7,0xfd,0x93,0x26,0x36,0x3f,0xf7,0xcc,0x34,0xa5,0xe5,0xf1,0x71,0xd8,0x31,0x15,
+    0x04,0xc7,0x23,0xc3,0x18,0x96,0x05,0x9a,0x07,0x12,0x80,0xe2,0xeb,0x27,0xb2,0x75,
+    0x09,0x83,0x2c,0x1a,0x1b,0x6e,0x5a,0xa0,0x52,0x3b,0xd6,0xb3,0x29,0xe3,0x2f,0x84,
+    0x53,0xd1,0x00,0xed,0x20,0xfc,0xb1,0x5b,0x6a,0xcb,0xbe,0x39,0x4a,0x4c,0x58,0xcf,
+    0xd0,0xef,0xaa,0xfb,0x43,0x4d,0x33,0x85,0x45,0xf9,0x02,0x7f,0x50,0x3c,0x9f,0xa8,
+    0x51,0xa3,0x40,0x8f,0x92,0x9d,0x38,0xf5,0xbc,0xb6,0xda,0x21,0x10,0xff,0xf3,0xd2,
+    0xcd,0x0c,0x13,0xec,0x5f,0x97,0x44,0x17,0xc4,0xa7,0x7e,0x3d,0x64,0x5d,0x19,0x73,
+    0x60,0x81,0x4f,0xdc,0x22,0x2a,0x90,0x88,0x46,0xee,0xb8,0x14,0xde,0x5e,0x0b,0xdb,
+    0xe0,0x32,0x3a,0x0a,0x49,0x06,0x24,0x5c,0xc2,0xd3,0xac,0x62,0x91,0x95,0xe4,0x79,
+    0xe7,0xc8,0x37,0x6d,0x8d,0xd5,0x4e,0xa9,0x6c,0x56,0xf4,0xea,0x65,0x7a,0xae,0x08,
+    0xba,0x78,0x25,0x2e,0x1c,0xa6,0xb4,0xc6,0xe8,0xdd,0x74,0x1f,0x4b,0xbd,0x8b,0x8a,
+    0x70,0x3e,0xb5,0x66,0x48,0x03,0xf6,0x0e,0x61,0x35,0x57,0xb9,0x86,0xc1,0x1d,0x9e,
+    0xe1,0xf8,0x98,0x11,0x69,0xd9,0x8e,0x94,0x9b,0x1e,0x87,0xe9,0xce,0x55,0x28,0xdf,
+    0x8c,0xa1,0x89,0x0d,0xbf,0xe6,0x42,0x68,0x41,0x99,0x2d,0x0f,0xb0,0x54,0xbb,0x16
+};
+#endif
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+#if !defined(CY_IP_MXCRYPTOLITE)
+/**************************************************************************************************
+* Function Name: pawr_sec_xtime()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function multiplies by x in GF(2^8).
+* @param[in] b , field element.
+* @return    uint8_t b * x.
+**************************************************************************************************/
+static uint8_t pawr_sec_xtime(uint8_t b)
+{
+    return (uint8_t)((b << 1) ^ ((b & 0x80) ? 0x1b : 0x00));
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_expand_key()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function expands an AES-128 key into the 11 round keys.
+* @param[in]  p_key       , cipher key.
+* @param[out] p_round_key , 176 bytes of round keys.
+* @return     void.
+**************************************************************************************************/
+static void pawr_sec_expand_key(const uint8_t *p_key, uint8_t *p_round_key)
+{
+    uint8_t rcon = 0x01;
+    uint8_t i;
+    uint8_t t[4];
+
+    memcpy(p_round_key, p_key, PAWR_SEC_KEY_LEN);
+    for (i = 4; i < 44; i++)
+    {
+        memcpy(t, &p_round_key[(i - 1) * 4], 4);
+        if ((i % 4) == 0)
+        {
+            uint8_t t0 = t[0];
+            t[0] = (uint8_t)(sec_sbox[t[1]] ^ rcon);
+            t[1] = sec_sbox[t[2]];
+            t[2] = sec_sbox[t[3]];
+            t[3] = sec_sbox[t0];
+            rcon = pawr_sec_xtime(rcon);
+        }
+        p_round_key[i * 4 + 0] = p_round_key[(i - 4) * 4 + 0] ^ t[0];
+        p_round_key[i * 4 + 1] = p_round_key[(i - 4) * 4 + 1] ^ t[1];
+        p_round_key[i * 4 + 2] = p_round_key[(i - 4) * 4 + 2] ^ t[2];
+        p_round_key[i * 4 + 3] = p_round_key[(i - 4) * 4 + 3] ^ t[3];
+    }
+}
+#endif
+
+/**************************************************************************************************
+* Function Name: pawr_sec_encrypt_block()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function encrypts one block with AES-128. CCM only needs the forward cipher.
+* @param[in]  p_ctx , key context.
+* @param[in]  p_in  , plaintext block.
+* @param[out] p_out , ciphertext block, may equal p_in.
+* @return     void.
+**************************************************************************************************/
+static void pawr_sec_encrypt_block(pawr_sec_key_ctx_t *p_ctx, const uint8_t *p_in, uint8_t *p_out)
+{
+#if defined(CY_IP_MXCRYPTOLITE)
+    uint8_t in[PAWR_SEC_BLOCK_LEN];
+
+    memcpy(in, p_in, PAWR_SEC_BLOCK_LEN);
+    Cy_Cryptolite_Aes_Ecb(CRYPTOLITE, p_out, in, &p_ctx->aes_state);
+#else
+    const uint8_t *rk = p_ctx->round_key;
+    uint8_t        s[PAWR_SEC_BLOCK_LEN];
+    uint8_t        t[PAWR_SEC_BLOCK_LEN];
+    uint8_t        round;
+    uint8_t        i;
+
+    for (i = 0; i < PAWR_SEC_BLOCK_LEN; i++)
+    {
+        s[i] = p_in[i] ^ rk[i];
+    }
+    for (round = 1; round <= 10; round++)
+    {
+        /* SubBytes and ShiftRows, state is column major */
+        for (i = 0; i < PAWR_SEC_BLOCK_LEN; i++)
+        {
+            t[i] = sec_sbox[s[(i + 4 * (i % 4)) % PAWR_SEC_BLOCK_LEN]];
+        }
+        if (round != 10)
+        {
+            /* MixColumns */
+            for (i = 0; i < PAWR_SEC_BLOCK_LEN; i += 4)
+            {
+                uint8_t a0 = t[i];
+                uint8_t a1 = t[i + 1];
+                uint8_t a2 = t[i + 2];
+                uint8_t a3 = t[i + 3];
+                uint8_t x  = a0 ^ a1 ^ a2 ^ a3;
+
+                t[i]     = a0 ^ x ^ pawr_sec_xtime(a0 ^ a1);
+                t[i + 1] = a1 ^ x ^ pawr_sec_xtime(a1 ^ a2);
+                t[i + 2] = a2 ^ x ^ pawr_sec_xtime(a2 ^ a3);
+                t[i + 3] = a3 ^ x ^ pawr_sec_xtime(a3 ^ a0);
+            }
+        }
+        for (i = 0; i < PAWR_SEC_BLOCK_LEN; i++)
+        {
+            s[i] = t[i] ^ rk[round * PAWR_SEC_BLOCK_LEN + i];
+        }
+    }
+    memcpy(p_out, s, PAWR_SEC_BLOCK_LEN);
+#endif
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_ccm()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs AES-CCM (RFC 3610) with a 13 byte nonce and a PAWR_SEC_MIC_LEN tag. The
+* CBC-MAC always covers the plaintext, so the same routine seals and opens.
+* @param[in]  p_ctx    , key context.
+* @param[in]  p_nonce  , nonce.
+* @param[in]  p_aad    , additional authenticated data.
+* @param[in]  aad_len  , length of p_aad, less than 0xFF00.
+* @param[in]  p_in     , input payload.
+* @param[in]  len      , payload length.
+* @param[out] p_out    , output payload, may equal p_in.
+* @param[out] p_mic    , computed tag.
+* @param[in]  encrypt  , WICED_TRUE to seal, WICED_FALSE to open.
+* @return     void.
+**************************************************************************************************/
+static void pawr_sec_ccm(pawr_sec_key_ctx_t *p_ctx, const uint8_t *p_nonce, const uint8_t *p_aad, uint8_t aad_len,
+                         const uint8_t *p_in, uint16_t len, uint8_t *p_out, uint8_t *p_mic, wiced_bool_t encrypt)
+{
+    uint8_t  x[PAWR_SEC_BLOCK_LEN];
+    uint8_t  ctr[PAWR_SEC_BLOCK_LEN];
+    uint8_t  s[PAWR_SEC_BLOCK_LEN];
+    uint16_t pos;
+    uint16_t blk;
+    uint16_t i;
+    uint16_t cnt = 1;
+
+    /* B0: flags, nonce, message length */
+    x[0] = (uint8_t)(((aad_len != 0) ? 0x40 : 0x00) | (((PAWR_SEC_MIC_LEN - 2) / 2) << 3) | (2 - 1));
+    memcpy(&x[1], p_nonce, PAWR_SEC_NONCE_LEN);
+    x[14] = (uint8_t)(len >> 8);
+    x[15] = (uint8_t)len;
+    pawr_sec_encrypt_block(p_ctx, x, x);
+
+    /* additional data, prefixed with its two byte length */
+    if (aad_len != 0)
+    {
+        x[1] ^= aad_len;
+        pos = 2;
+        for (i = 0; i < aad_len; i++)
+        {
+            x[pos++] ^= p_aad[i];
+            if (pos == PAWR_SEC_BLOCK_LEN)
+            {
+                pawr_sec_encrypt_block(p_ctx, x, x);
+                pos = 0;
+            }
+        }
+        if (pos != 0)
+        {
+            pawr_sec_encrypt_block(p_ctx, x, x);
+        }
+    }
+
+    /* CTR blocks A_i: flags, nonce, counter */
+    ctr[0] = (uint8_t)(2 - 1);
+    memcpy(&ctr[1], p_nonce, PAWR_SEC_NONCE_LEN);
+
+    for (pos = 0; pos < len; pos += PAWR_SEC_BLOCK_LEN)
+    {
+        blk    = ((len - pos) < PAWR_SEC_BLOCK_LEN) ? (len - pos) : PAWR_SEC_BLOCK_LEN;
+        ctr[14] = (uint8_t)(cnt >> 8);
+        ctr[15] = (uint8_t)cnt;
+        cnt++;
+        pawr_sec_encrypt_block(p_ctx, ctr, s);
+        for (i = 0; i < blk; i++)
+        {
+            uint8_t in    = p_in[pos + i];
+            uint8_t out   = in ^ s[i];
+            x[i]         ^= encrypt ? in : out;
+            p_out[pos + i] = out;
+        }
+        pawr_sec_encrypt_block(p_ctx, x, x);
+    }
+
+    /* tag is the CBC-MAC encrypted with A_0 */
+    ctr[14] = 0;
+    ctr[15] = 0;
+    pawr_sec_encrypt_block(p_ctx, ctr, s);
+    for (i = 0; i < PAWR_SEC_MIC_LEN; i++)
+    {
+        p_mic[i] = x[i] ^ s[i];
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_make_nonce()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function builds the CCM nonce: sender address, epoch, periodic_evt_counter, subevent,
+* response slot, and direction with key id. The central sends once per subevent of an event, and
+* a peripheral at most once per response slot of a subevent, so with the sender address in front
+* and the central bumping the epoch each time periodic_evt_counter wraps, a (key, nonce) pair is
+* never reused, even though all peripherals share the network key.
+* @param[out] p_nonce     , nonce.
+* @param[in]  p_addr      , central address for the downlink, own address for the uplink.
+* @param[in]  epoch       , epoch from the message header.
+* @param[in]  evt_counter , periodic_evt_counter.
+* @param[in]  subevent    , subevent, the response subevent for the uplink.
+* @param[in]  rsp_slot    , response slot, 0 for the downlink.
+* @param[in]  dir         , PAWR_SEC_DIR_DOWNLINK or PAWR_SEC_DIR_UPLINK.
+* @param[in]  key_id      , key id.
+* @return     void.
+**************************************************************************************************/
+static void pawr_sec_make_nonce(uint8_t *p_nonce, const uint8_t *p_addr, uint16_t epoch, uint16_t evt_counter,
+                                uint8_t subevent, uint8_t rsp_slot, uint8_t dir, uint8_t key_id)
+{
+    memcpy(p_nonce, p_addr, BD_ADDR_LEN);
+    p_nonce[6]  = (uint8_t)epoch;
+    p_nonce[7]  = (uint8_t)(epoch >> 8);
+    p_nonce[8]  = (uint8_t)evt_counter;
+    p_nonce[9]  = (uint8_t)(evt_counter >> 8);
+    p_nonce[10] = subevent;
+    p_nonce[11] = rsp_slot;
+    p_nonce[12] = (uint8_t)(dir | key_id);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_account()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function adds one operation to the cycle statistics of its payload size bucket.
+* @param[in] p_stats , bucket array.
+* @param[in] len     , payload length.
+* @param[in] cycles  , cycles spent.
+* @return    void.
+**************************************************************************************************/
+static void pawr_sec_account(pawr_sec_cycle_stats_t *p_stats, uint16_t len, uint32_t cycles)
+{
+    uint8_t bucket = (uint8_t)(len / 32);
+
+    if (bucket >= PAWR_SEC_SIZE_BUCKETS)
+    {
+        bucket = PAWR_SEC_SIZE_BUCKETS - 1;
+    }
+    p_stats[bucket].count++;
+    p_stats[bucket].bytes  += len;
+    p_stats[bucket].cycles += cycles;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function clears keys, replay windows and statistics.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_sec_init(void)
+{
+    memset(sec_key, 0, sizeof(sec_key));
+    memset(sec_replay, 0, sizeof(sec_replay));
+    memset(sec_open_stats, 0, sizeof(sec_open_stats));
+    memset(sec_seal_stats, 0, sizeof(sec_seal_stats));
+    sec_cur_replay = NULL;
+    sec_tx_key_id  = PAWR_SEC_NO_KEY;
+    sec_device_set = WICED_FALSE;
+    app_bt_util_cycle_counter_init();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_set_device_addr()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the address of this device, which starts every uplink nonce so that two
+* peripherals answering in the same slot of the same event never share a nonce. Responses are
+* not sealed until it is set.
+* @param[in] device_addr , own BD address, unique per device.
+* @return    void.
+**************************************************************************************************/
+void pawr_sec_set_device_addr(const wiced_bt_device_address_t device_addr)
+{
+    memcpy(sec_device_addr, device_addr, BD_ADDR_LEN);
+    sec_device_set = WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_set_key()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function installs a network key. The key schedule is built on the next sync.
+* @param[in] key_id , key id carried in secure messages.
+* @param[in] p_key  , PAWR_SEC_KEY_LEN byte key.
+* @return    wiced_result_t WICED_SUCCESS or WICED_BADARG.
+**************************************************************************************************/
+wiced_result_t pawr_sec_set_key(uint8_t key_id, const uint8_t *p_key)
+{
+    if ((key_id >= PAWR_SEC_MAX_KEYS) || (p_key == NULL))
+    {
+        return WICED_BADARG;
+    }
+    memcpy(sec_key[key_id].key, p_key, PAWR_SEC_KEY_LEN);
+    sec_key[key_id].valid = WICED_FALSE;
+    if (sec_tx_key_id == PAWR_SEC_NO_KEY)
+    {
+        sec_tx_key_id = key_id;
+    }
+    return WICED_SUCCESS;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_on_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prepares the per-key contexts and selects the replay window of the central the
+* peripheral just synchronized to, so the report path only runs block encryptions.
+* @param[in] central_addr , address of the central.
+* @return    void.
+**************************************************************************************************/
+void pawr_sec_on_sync(const wiced_bt_device_address_t central_addr)
+{
+    pawr_sec_replay_t *p_free = NULL;
+    uint8_t            i;
+    static const uint8_t zero_key[PAWR_SEC_KEY_LEN] = {0};
+
+    memcpy(sec_central_addr, central_addr, BD_ADDR_LEN);
+    for (i = 0; i < PAWR_SEC_MAX_KEYS; i++)
+    {
+        if (memcmp(sec_key[i].key, zero_key, PAWR_SEC_KEY_LEN) == 0)
+        {
+            continue;
+        }
+#if defined(CY_IP_MXCRYPTOLITE)
+        Cy_Cryptolite_Aes_Init(CRYPTOLITE, sec_key[i].key, &sec_key[i].aes_state, &sec_key[i].aes_buffers);
+#else
+        pawr_sec_expand_key(sec_key[i].key, sec_key[i].round_key);
+#endif
+        sec_key[i].valid = WICED_TRUE;
+    }
+
+    sec_cur_replay = NULL;
+    for (i = 0; i < PAWR_SEC_MAX_CENTRALS; i++)
+    {
+        if (sec_replay[i].in_use && (memcmp(sec_replay[i].addr, central_addr, BD_ADDR_LEN) == 0))
+        {
+            sec_cur_replay = &sec_replay[i];
+            break;
+        }
+        if (!sec_replay[i].in_use && (p_free == NULL))
+        {
+            p_free = &sec_replay[i];
+        }
+    }
+    if (sec_cur_replay == NULL)
+    {
+        /* reuse the first entry when every slot belongs to another central */
+        sec_cur_replay = (p_free != NULL) ? p_free : &sec_replay[0];
+        memset(sec_cur_replay, 0, sizeof(*sec_cur_replay));
+        sec_cur_replay->in_use = WICED_TRUE;
+        memcpy(sec_cur_replay->addr, central_addr, BD_ADDR_LEN);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_is_active()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function tells whether a key is ready, in which case clear text is no longer accepted.
+* @param[in] void.
+* @return    wiced_bool_t WICED_TRUE if payloads are protected.
+**************************************************************************************************/
+wiced_bool_t pawr_sec_is_active(void)
+{
+    return ((sec_tx_key_id != PAWR_SEC_NO_KEY) && sec_key[sec_tx_key_id].valid) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_replay_check()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function checks and records a sequence number in the replay window of the current central.
+* @param[in] seq , (epoch << 24) | (evt_counter << 8) | subevent.
+* @return    wiced_bool_t WICED_TRUE if the sequence number has not been seen.
+**************************************************************************************************/
+static wiced_bool_t pawr_sec_replay_check(uint64_t seq)
+{
+    pawr_sec_replay_t *r = sec_cur_replay;
+    uint64_t           diff;
+
+    if (r->window == 0)
+    {
+        r->top    = seq;
+        r->window = 1;
+        return WICED_TRUE;
+    }
+    if (seq > r->top)
+    {
+        diff      = seq - r->top;
+        r->window = (diff >= PAWR_SEC_REPLAY_WINDOW) ? 1 : ((r->window << diff) | 1);
+        r->top    = seq;
+        return WICED_TRUE;
+    }
+    diff = r->top - seq;
+    if ((diff >= PAWR_SEC_REPLAY_WINDOW) || (r->window & (1UL << diff)))
+    {
+        return WICED_FALSE;
+    }
+    r->window |= (1UL << diff);
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_open()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function authenticates and decrypts a PAWR_MSG_TYPE_SECURE message. The replay window is
+* only updated once the tag has been verified.
+* @param[in]  p_msg       , secure message.
+* @param[in]  msg_len     , length of the message.
+* @param[in]  evt_counter , periodic_evt_counter of the report.
+* @param[in]  subevent    , subevent of the report.
+* @param[out] p_out       , plaintext, msg_len - PAWR_SEC_OVERHEAD bytes.
+* @return     uint16_t plaintext length, 0 if the message was rejected.
+**************************************************************************************************/
+uint16_t pawr_sec_open(const uint8_t *p_msg, uint16_t msg_len, uint16_t evt_counter, uint8_t subevent, uint8_t *p_out)
+{
+    uint8_t  nonce[PAWR_SEC_NONCE_LEN];
+    uint8_t  mic[PAWR_SEC_MIC_LEN];
+    uint8_t  key_id;
+    uint16_t epoch;
+    uint16_t len;
+    uint8_t  diff = 0;
+    uint8_t  i;
+    uint32_t start = APP_BT_UTIL_CYCLES();
+
+    if ((msg_len <= PAWR_SEC_OVERHEAD) || (sec_cur_replay == NULL))
+    {
+        return 0;
+    }
+    key_id = p_msg[1];
+    if ((key_id >= PAWR_SEC_MAX_KEYS) || !sec_key[key_id].valid)
+    {
+        sec_no_key++;
+        return 0;
+    }
+    epoch = (uint16_t)(p_msg[2] | (p_msg[3] << 8));
+    len   = msg_len - PAWR_SEC_OVERHEAD;
+
+    pawr_sec_make_nonce(nonce, sec_central_addr, epoch, evt_counter, subevent, 0, PAWR_SEC_DIR_DOWNLINK, key_id);
+    pawr_sec_ccm(&sec_key[key_id], nonce, p_msg, PAWR_SEC_HDR_LEN, &p_msg[PAWR_SEC_HDR_LEN], len, p_out, mic, WICED_FALSE);
+
+    /* constant time compare */
+    for (i = 0; i < PAWR_SEC_MIC_LEN; i++)
+    {
+        diff |= mic[i] ^ p_msg[PAWR_SEC_HDR_LEN + len + i];
+    }
+    if (diff != 0)
+    {
+        sec_mic_fail++;
+        return 0;
+    }
+    if (!pawr_sec_replay_check(((uint64_t)epoch << 24) | ((uint32_t)evt_counter << 8) | subevent))
+    {
+        sec_replayed++;
+        return 0;
+    }
+
+    /* answer with the key and epoch the central is using */
+    sec_tx_key_id = key_id;
+    sec_tx_epoch  = epoch;
+    pawr_sec_account(sec_open_stats, len, APP_BT_UTIL_CYCLES() - start);
+    return len;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_seal()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function encrypts a response with the key and epoch of the last authenticated downlink.
+* @param[in]  p_data       , response payload.
+* @param[in]  data_len     , payload length.
+* @param[in]  evt_counter  , periodic_evt_counter of the request.
+* @param[in]  rsp_subevent , response subevent.
+* @param[in]  rsp_slot     , response slot.
+* @param[out] p_out        , secure message, data_len + PAWR_SEC_OVERHEAD bytes.
+* @param[in]  out_size     , size of p_out.
+* @return     uint16_t secure message length, 0 on error or before pawr_sec_set_device_addr().
+**************************************************************************************************/
+uint16_t pawr_sec_seal(const uint8_t *p_data, uint16_t data_len, uint16_t evt_counter, uint8_t rsp_subevent,
+                       uint8_t rsp_slot, uint8_t *p_out, uint16_t out_size)
+{
+    uint8_t  nonce[PAWR_SEC_NONCE_LEN];
+    uint32_t start = APP_BT_UTIL_CYCLES();
+
+    if (!pawr_sec_is_active() || !sec_device_set || ((uint32_t)data_len + PAWR_SEC_OVERHEAD > out_size))
+    {
+        return 0;
+    }
+    p_out[0] = PAWR_MSG_TYPE_SECURE;
+    p_out[1] = sec_tx_key_id;
+    p_out[2] = (uint8_t)sec_tx_epoch;
+    p_out[3] = (uint8_t)(sec_tx_epoch >> 8);
+    pawr_sec_make_nonce(nonce, sec_device_addr, sec_tx_epoch, evt_counter, rsp_subevent, rsp_slot, PAWR_SEC_DIR_UPLINK,
+                        sec_tx_key_id);
+    pawr_sec_ccm(&sec_key[sec_tx_key_id], nonce, p_out, PAWR_SEC_HDR_LEN, p_data, data_len,
+                 &p_out[PAWR_SEC_HDR_LEN], &p_out[PAWR_SEC_HDR_LEN + data_len], WICED_TRUE);
+    pawr_sec_account(sec_seal_stats, data_len, APP_BT_UTIL_CYCLES() - start);
+    return (uint16_t)(data_len + PAWR_SEC_OVERHEAD);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_sec_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints rejects and the average open and seal cycles per payload size.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_sec_print_stats(void)
+{
+    uint8_t i;
+
+    printf("pawr sec: mic_fail:%lu, replay:%lu, no_key:%lu\n",
+           (unsigned long)sec_mic_fail, (unsigned long)sec_replayed, (unsigned long)sec_no_key);
+    for (i = 0; i < PAWR_SEC_SIZE_BUCKETS; i++)
+    {
+        if ((sec_open_stats[i].count != 0) || (sec_seal_stats[i].count != 0))
+        {
+            printf("len %d-%d: open cnt:%lu cyc/msg:%lu, seal cnt:%lu cyc/msg:%lu\n",
+                   i * 32, i * 32 + 31,
+                   (unsigned long)sec_open_stats[i].count,
+                   (unsigned long)((sec_open_stats[i].count != 0) ? (sec_open_stats[i].cycles / sec_open_stats[i].count) : 0),
+                   (unsigned long)sec_seal_stats[i].count,
+                   (unsigned long)((sec_seal_stats[i].count != 0) ? (sec_seal_stats[i].cycles / sec_seal_stats[i].count) : 0));
+        }
+    }
+}
+
+/* [] END OF FILE */
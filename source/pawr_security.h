@@ -0,0 +1,75 @@
+/******************************************************************************
+* File Name:   pawr_security.h
+*
+* Description: This file consists of the inteface for the optional PAwR payload security layer.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_SECURITY_H_
+#define PAWR_SECURITY_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_SEC_KEY_LEN                (16)     /* AES-128 */
+#define PAWR_SEC_MAX_KEYS               (2)      /* current and next key for rotation */
+#define PAWR_SEC_MAX_CENTRALS           (4)      /* centrals with their own replay window */
+#define PAWR_SEC_MIC_LEN                (4)      /* CCM tag length */
+#define PAWR_SEC_HDR_LEN                (4)      /* type, key_id, epoch(LE16) */
+#define PAWR_SEC_OVERHEAD               (PAWR_SEC_HDR_LEN + PAWR_SEC_MIC_LEN)
+#define PAWR_SEC_MAX_MSG_LEN            (255)    /* periodic report data_length is 8 bit */
+#define PAWR_SEC_REPLAY_WINDOW          (32)     /* (event, subevent) pairs tolerated out of order */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_sec_init(void);
+wiced_result_t pawr_sec_set_key(uint8_t key_id, const uint8_t *p_key);
+void pawr_sec_set_device_addr(const wiced_bt_device_address_t device_addr);
+void pawr_sec_on_sync(const wiced_bt_device_address_t central_addr);
+wiced_bool_t pawr_sec_is_active(void);
+uint16_t pawr_sec_open(const uint8_t *p_msg, uint16_t msg_len, uint16_t evt_counter, uint8_t subevent, uint8_t *p_out);
+uint16_t pawr_sec_seal(const uint8_t *p_data, uint16_t data_len, uint16_t evt_counter, uint8_t rsp_subevent,
+                       uint8_t rsp_slot, uint8_t *p_out, uint16_t out_size);
+void pawr_sec_print_stats(void);
+#endif /* PAWR_SECURITY_H_ */
+
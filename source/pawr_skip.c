@@ -0,0 +1,354 @@
+/******************************************************************************
+* File Name:   pawr_skip.c
+*
+* Description: This file consists of adaptive periodic event skipping. While the central has nothing for this device, the skip count steps up a short ladder of precomputed values after each quiet period, up to the latency bound. Data or a wake flag for this device brings it back to 0.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include "pawr.h"
+#include "pawr_skip.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint32_t          skip_max_latency_ms = PAWR_CFG_SKIP_MAX_LATENCY_MS;
+static uint32_t          skip_quiet_ms       = PAWR_CFG_SKIP_QUIET_MS;
+static uint16_t          skip_cur            = 0;           /* skip asked of the PAwR layer */
+static uint16_t          skip_limit          = 0;           /* from the bounds and the train's interval */
+static uint16_t          skip_steps[PAWR_SKIP_NUM_STEPS];   /* ladder up to skip_limit, ascending */
+static uint32_t          skip_changed_ms     = 0;           /* last skip change, for the hold time */
+static uint32_t          skip_interval_ms    = 0;
+static wiced_bool_t      skip_synced         = WICED_FALSE;
+static uint32_t          skip_sync_ms        = 0;
+static uint32_t          skip_quiet_since_ms = 0;
+static wiced_bool_t      skip_wake_pending   = WICED_FALSE; /* skip 0 asked for, not in effect yet */
+static uint32_t          skip_wake_ms        = 0;
+static wiced_bool_t      skip_have_evt       = WICED_FALSE;
+static uint16_t          skip_last_evt       = 0;
+static pawr_skip_stats_t skip_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_skip_now_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the local time in milliseconds.
+* @return    uint32_t time, ms.
+**************************************************************************************************/
+static uint32_t pawr_skip_now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_update_limit()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function works out the largest skip: received events stay within the latency bound, and
+* enough of them fit into the sync timeout that a few lost ones do not end the sync. The ladder
+* of skips the policy raises through is 0, limit/16, limit/4 and limit.
+* @return    void.
+**************************************************************************************************/
+static void pawr_skip_update_limit(void)
+{
+    uint32_t by_latency;
+    uint32_t by_timeout;
+    uint8_t  i;
+
+    skip_limit = 0;
+    if (skip_interval_ms != 0)
+    {
+        by_latency = skip_max_latency_ms / skip_interval_ms;
+        by_timeout = ((uint32_t)PERIODIC_ADV_EXPIRD_TIME * 10) / (skip_interval_ms * PAWR_SKIP_TIMEOUT_EVENTS);
+        if (by_timeout < by_latency)
+        {
+            by_latency = by_timeout;
+        }
+        by_latency = (by_latency == 0) ? 0 : (by_latency - 1);
+        skip_limit = (uint16_t)((by_latency > PAWR_SKIP_MAX) ? PAWR_SKIP_MAX : by_latency);
+    }
+    skip_steps[0] = 0;
+    for (i = 1; i < PAWR_SKIP_NUM_STEPS; i++)
+    {
+        skip_steps[i] = (uint16_t)(skip_limit >> (2 * (PAWR_SKIP_NUM_STEPS - 1 - i)));
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_next_step()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the ladder step above the current skip.
+* @return    uint16_t next skip, skip_cur at the top of the ladder.
+**************************************************************************************************/
+static uint16_t pawr_skip_next_step(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PAWR_SKIP_NUM_STEPS; i++)
+    {
+        if (skip_steps[i] > skip_cur)
+        {
+            return skip_steps[i];
+        }
+    }
+    return skip_cur;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_apply()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function asks the PAwR layer for a new skip. Each change re-creates the sync, see
+* pawr_skip.h.
+* @param[in] skip , periodic events to skip.
+* @return    void.
+**************************************************************************************************/
+static void pawr_skip_apply(uint16_t skip)
+{
+    skip_cur        = skip;
+    skip_changed_ms = pawr_skip_now_ms();
+    pawr_set_skip(skip);
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_set_bounds()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function sets the latency bound and the quiet time; a skip above the new bound is
+* lowered right away.
+* @param[in] max_latency_ms , longest gap between received periodic events.
+* @param[in] quiet_ms       , quiet time before each skip increase.
+* @return    void.
+**************************************************************************************************/
+void pawr_skip_set_bounds(uint32_t max_latency_ms, uint32_t quiet_ms)
+{
+    skip_max_latency_ms = max_latency_ms;
+    skip_quiet_ms       = quiet_ms;
+    pawr_skip_update_limit();
+    if (skip_cur > skip_limit)
+    {
+        pawr_skip_apply(skip_limit);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_on_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts or continues the policy on a sync, including the re-created sync that
+* puts a new skip into effect.
+* @param[in] ps , sync established event data.
+* @return    void.
+**************************************************************************************************/
+void pawr_skip_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps)
+{
+    uint32_t now = pawr_skip_now_ms();
+    uint32_t ms;
+
+    skip_interval_ms    = ((uint32_t)ps->periodic_adv_int * 5) / 4;
+    skip_quiet_since_ms = now;
+    skip_have_evt       = WICED_FALSE;
+    if (!skip_synced)
+    {
+        skip_synced  = WICED_TRUE;
+        skip_sync_ms = now;
+    }
+    if (skip_wake_pending && (skip_cur == 0))
+    {
+        skip_wake_pending = WICED_FALSE;
+        ms = now - skip_wake_ms;
+        skip_stats.wake_ms_sum += ms;
+        if (ms > skip_stats.wake_ms_max)
+        {
+            skip_stats.wake_ms_max = ms;
+        }
+    }
+    pawr_skip_update_limit();
+    if (skip_cur > skip_limit)
+    {
+        pawr_skip_apply(skip_limit);
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_on_sync_lost()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function closes the synced time on a sync loss, roaming included. The next sync, which
+* may be on another train, starts again from skip 0; the PAwR layer clears its create sync
+* skip at the same point.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_skip_on_sync_lost(void)
+{
+    if (skip_synced)
+    {
+        skip_stats.synced_ms += pawr_skip_now_ms() - skip_sync_ms;
+        skip_synced = WICED_FALSE;
+    }
+    skip_wake_pending = WICED_FALSE;
+    skip_cur          = 0;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_on_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function feeds one periodic report into the policy.
+* @param[in] evt_counter , periodic event counter.
+* @param[in] active      , the report carried data for this device.
+* @param[in] wake        , a wake flag for this device came with it.
+* @return    void.
+**************************************************************************************************/
+void pawr_skip_on_report(uint16_t evt_counter, wiced_bool_t active, wiced_bool_t wake)
+{
+    uint32_t now = pawr_skip_now_ms();
+
+    if (!skip_synced)
+    {
+        return;
+    }
+    if (!skip_have_evt || (evt_counter != skip_last_evt))
+    {
+        skip_stats.events++;
+        skip_last_evt = evt_counter;
+        skip_have_evt = WICED_TRUE;
+    }
+    if (active || wake)
+    {
+        skip_quiet_since_ms = now;
+        if (skip_cur != 0)
+        {
+            if (wake)
+            {
+                skip_stats.wakes++;
+            }
+            skip_stats.drops++;
+            skip_wake_pending = WICED_TRUE;
+            skip_wake_ms      = now;
+            pawr_skip_apply(0);
+        }
+        return;
+    }
+    /* Raises also wait out the hold time since the last change, drops do not: a drop bounds the
+     * latency of what the central has queued for this device. */
+    if (((now - skip_quiet_since_ms) >= skip_quiet_ms) &&
+        ((now - skip_changed_ms) >= PAWR_CFG_SKIP_HOLD_MS) && (skip_cur < skip_limit))
+    {
+        skip_stats.raises++;
+        pawr_skip_apply(pawr_skip_next_step());
+        skip_quiet_since_ms = now;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_get()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the skip asked for.
+* @return    uint16_t periodic events skipped.
+**************************************************************************************************/
+uint16_t pawr_skip_get(void)
+{
+    return skip_cur;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the skip statistics; the synced time includes the current sync.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_skip_get_stats(pawr_skip_stats_t *p_stats)
+{
+    *p_stats = skip_stats;
+    if (skip_synced)
+    {
+        p_stats->synced_ms += pawr_skip_now_ms() - skip_sync_ms;
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_skip_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the skip statistics, with the radio wakeups per minute synced.
+* @param[in] void.
+* @return    void.
+**************************************************************************************************/
+void pawr_skip_print_stats(void)
+{
+    pawr_skip_stats_t stats;
+
+    pawr_skip_get_stats(&stats);
+    printf("pawr skip: skip:%d, limit:%d, raises:%lu, drops:%lu, wakes:%lu, wakeups/min:%lu, wake avg:%lu max:%lu ms\n",
+           skip_cur, skip_limit,
+           (unsigned long)stats.raises,
+           (unsigned long)stats.drops,
+           (unsigned long)stats.wakes,
+           (unsigned long)((stats.synced_ms != 0) ? (uint32_t)(((uint64_t)stats.events * 60000) / stats.synced_ms) : 0),
+           (unsigned long)((stats.drops != 0) ? (stats.wake_ms_sum / stats.drops) : 0),
+           (unsigned long)stats.wake_ms_max);
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:   pawr_skip.h
+*
+* Description: This file is the public interface of adaptive periodic event skipping.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_SKIP_H_
+#define PAWR_SKIP_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_SKIP_MAX                   (0x01F3) /* largest skip the controller accepts */
+#define PAWR_SKIP_TIMEOUT_EVENTS        (6)      /* received events that must fit into the sync timeout */
+#define PAWR_SKIP_NUM_STEPS             (4)      /* skips raised through: 0, limit/16, limit/4, limit */
+
+/* A skip change is not free: the controller takes the skip only at create sync, so each change
+ * terminates the sync and scans for the train again (pawr_set_skip()). Until the new sync is
+ * established no events are received and no responses are sent, for up to
+ * PAWR_SKIP_RESYNC_TIMEOUT_MS. The policy therefore raises through PAWR_SKIP_NUM_STEPS values
+ * only and holds each skip for at least PAWR_CFG_SKIP_HOLD_MS before raising it again. */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t raises;                             /* skip increases after quiet periods */
+    uint32_t drops;                              /* back to skip 0 */
+    uint32_t wakes;                              /* drops asked for by a wake flag */
+    uint32_t events;                             /* periodic events received, radio wakeups */
+    uint32_t synced_ms;                          /* time synced, closed at each sync loss */
+    uint32_t wake_ms_sum;                        /* drop asked for to skip 0 in effect */
+    uint32_t wake_ms_max;
+} pawr_skip_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_skip_set_bounds(uint32_t max_latency_ms, uint32_t quiet_ms);
+void pawr_skip_on_sync(const wiced_ble_padv_sync_established_event_data_t *ps);
+void pawr_skip_on_sync_lost(void);
+void pawr_skip_on_report(uint16_t evt_counter, wiced_bool_t active, wiced_bool_t wake);
+uint16_t pawr_skip_get(void);
+void pawr_skip_get_stats(pawr_skip_stats_t *p_stats);
+void pawr_skip_print_stats(void);
+#endif /* PAWR_SKIP_H_ */
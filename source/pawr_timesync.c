@@ -0,0 +1,591 @@
+/******************************************************************************
+* File Name:   pawr_timesync.c
+*
+* Description: This file consists of the network time service. Report arrival times are fitted against the periodic event counter to estimate the offset and drift of the local clock, so that application actions fire at the same network instant on every peripheral.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_bt_ble.h"
+#include "wiced_timer.h"
+#include "pawr_timesync.h"
+#ifdef ENABLE_BT_SPY_LOG
+#include "cybt_debug_uart.h"
+#else
+#include "cy_retarget_io.h"
+#endif
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define PAWR_TS_DATA_COMPLETE           (0x00)   /* HCI data_status of a complete report */
+#define PAWR_TS_UNIT_US                 (1250)   /* periodic_adv_int and subevent_interval unit */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* One sample: mean network time of the reports in a bucket and their mean local - network
+ * residual, relative to ts_y_base. */
+typedef struct
+{
+    int64_t x;
+    int32_t y;
+} pawr_ts_sample_t;
+
+typedef struct
+{
+    wiced_bool_t         in_use;
+    int64_t              net_us;
+    pawr_ts_action_cb_t *cb;
+    void                *p_arg;
+} pawr_ts_action_t;
+
+static uint32_t          ts_interval_us   = 0;
+static uint32_t          ts_subevent_us   = 0;
+static wiced_bool_t      ts_have_evt      = WICED_FALSE;
+static int64_t           ts_evt64;               /* periodic_evt_counter without the wrap */
+static uint16_t          ts_evt16;
+
+/* bucket being filled */
+static uint32_t          ts_acc_num       = 0;
+static int64_t           ts_acc_x0;
+static int64_t           ts_acc_dx;
+static int64_t           ts_acc_y;
+static uint32_t          ts_acc_err_max;
+
+/* fit over the last PAWR_TS_WINDOW samples, local = net + ts_c + ts_drift_ppb * (net - ts_x_ref) */
+static pawr_ts_sample_t  ts_win[PAWR_TS_WINDOW];
+static uint8_t           ts_win_head      = 0;
+static uint8_t           ts_win_num       = 0;
+static int64_t           ts_y_base;
+static wiced_bool_t      ts_model_valid   = WICED_FALSE;
+static int64_t           ts_x_ref;
+static int64_t           ts_c;
+static int32_t           ts_drift_ppb     = 0;
+static uint8_t           ts_outlier_run   = 0;
+
+static uint32_t          ts_tick_hi       = 0;
+static TickType_t        ts_tick_last     = 0;
+
+static pawr_ts_action_t  ts_action[PAWR_TS_MAX_ACTIONS];
+static wiced_timer_t     ts_timer;
+static pawr_ts_stats_t   ts_stats;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: pawr_ts_local_us()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the local clock, the RTOS tick count in microseconds. The tick keeps
+* counting across tickless idle, so the clock survives deep sleep; its resolution bounds the
+* accuracy to about one tick. Call from the stack context only.
+* @return    uint64_t local time, us.
+**************************************************************************************************/
+uint64_t pawr_ts_local_us(void)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    if (now < ts_tick_last)
+    {
+        ts_tick_hi++;
+    }
+    ts_tick_last = now;
+    return ((((uint64_t)ts_tick_hi << 32) | now) * 1000000ULL) / configTICK_RATE_HZ;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_model()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the fitted local - network offset at a network time.
+* @param[in] net_us , network time.
+* @return    int64_t offset, us.
+**************************************************************************************************/
+static int64_t pawr_ts_model(int64_t net_us)
+{
+    return ts_c + ((net_us - ts_x_ref) * ts_drift_ppb) / 1000000000LL;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_evt_to_net()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function places a 16 bit event counter within half a wrap of the last report and
+* returns the network time of an offset from that event.
+* @param[in] evt_counter , periodic_evt_counter.
+* @param[in] offset_us   , offset from the event anchor.
+* @return    int64_t network time, us.
+**************************************************************************************************/
+static int64_t pawr_ts_evt_to_net(uint16_t evt_counter, uint32_t offset_us)
+{
+    int64_t evt = ts_evt64 + (int16_t)(evt_counter - ts_evt16);
+
+    return evt * ts_interval_us + offset_us;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_fit()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function fits offset and drift to the sample window by least squares. The sums are
+* taken around the window means so that they stay within 64 bits.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ts_fit(void)
+{
+    int64_t x0 = ts_win[0].x;
+    int64_t sx = 0;
+    int64_t sy = 0;
+    int64_t xm;
+    int64_t ym;
+    int64_t sxx = 0;
+    int64_t sxy = 0;
+    int64_t dx;
+    uint8_t i;
+
+    for (i = 0; i < ts_win_num; i++)
+    {
+        sx += ts_win[i].x - x0;
+        sy += ts_win[i].y;
+    }
+    xm = x0 + sx / ts_win_num;
+    ym = sy / ts_win_num;
+    for (i = 0; i < ts_win_num; i++)
+    {
+        dx   = ts_win[i].x - xm;
+        sxx += dx * dx;
+        sxy += dx * (ts_win[i].y - ym);
+    }
+    /* one sample gives the offset only, the drift needs a span */
+    if (sxx / 1000000 != 0)
+    {
+        ts_drift_ppb = (int32_t)((sxy * 1000) / (sxx / 1000000));
+    }
+    ts_x_ref       = xm;
+    ts_c           = ts_y_base + ym;
+    ts_model_valid = WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_restart()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function drops the samples and the fit. Pending actions stay and fire on the next fit.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ts_restart(void)
+{
+    ts_acc_num     = 0;
+    ts_win_head    = 0;
+    ts_win_num     = 0;
+    ts_model_valid = WICED_FALSE;
+    ts_drift_ppb   = 0;
+    ts_outlier_run = 0;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_arm()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs the actions that are due and starts the timer for the next one. Due times
+* are taken from the current fit each time, so a corrected estimate moves them.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ts_arm(void)
+{
+    int64_t      now;
+    int64_t      due;
+    int64_t      next;
+    uint8_t      i;
+    wiced_bool_t fired;
+
+    if (!ts_model_valid)
+    {
+        return;
+    }
+    do
+    {
+        fired = WICED_FALSE;
+        next  = -1;
+        now   = (int64_t)pawr_ts_local_us();
+        for (i = 0; i < PAWR_TS_MAX_ACTIONS; i++)
+        {
+            if (!ts_action[i].in_use)
+            {
+                continue;
+            }
+            due = ts_action[i].net_us + pawr_ts_model(ts_action[i].net_us);
+            if (due <= now + PAWR_TS_EARLY_US)
+            {
+                ts_action[i].in_use = WICED_FALSE;
+                ts_stats.actions_fired++;
+                if ((int32_t)(now - due) > ts_stats.late_max_us)
+                {
+                    ts_stats.late_max_us = (int32_t)(now - due);
+                }
+                ts_action[i].cb(ts_action[i].p_arg, (int32_t)(now - due));
+                fired = WICED_TRUE;
+                break;
+            }
+            if ((next < 0) || (due < next))
+            {
+                next = due;
+            }
+        }
+    } while (fired);
+
+    /* an action may have scheduled another one and armed the timer already */
+    if (wiced_is_timer_in_use(&ts_timer))
+    {
+        wiced_stop_timer(&ts_timer);
+    }
+    if (next >= 0)
+    {
+        wiced_start_timer(&ts_timer, (uint32_t)((next - now + 999) / 1000));
+    }
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_timer_cb()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function is the action timer callback.
+* @param[in] cb_params , unused.
+* @return    void.
+**************************************************************************************************/
+static void pawr_ts_timer_cb(WICED_TIMER_PARAM_TYPE cb_params)
+{
+    pawr_ts_arm();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_init()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function initializes the time service.
+* @return    void.
+**************************************************************************************************/
+void pawr_ts_init(void)
+{
+    memset(ts_action, 0, sizeof(ts_action));
+    memset(&ts_stats, 0, sizeof(ts_stats));
+    wiced_init_timer(&ts_timer, pawr_ts_timer_cb, 0, WICED_MILLI_SECONDS_TIMER);
+    pawr_ts_restart();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_on_sync()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function starts the network time of a new train. Its event counter is unrelated to the
+* previous one, so the estimate restarts and pending actions are cancelled. After a sync loss
+* the last fit keeps running until this call.
+* @param[in] periodic_adv_int  , periodic advertising interval, 1.25 ms units.
+* @param[in] subevent_interval , subevent interval, 1.25 ms units.
+* @return    void.
+**************************************************************************************************/
+void pawr_ts_on_sync(uint16_t periodic_adv_int, uint8_t subevent_interval)
+{
+    uint8_t i;
+
+    for (i = 0; i < PAWR_TS_MAX_ACTIONS; i++)
+    {
+        if (ts_action[i].in_use)
+        {
+            ts_action[i].in_use = WICED_FALSE;
+            ts_stats.actions_dropped++;
+        }
+    }
+    if (wiced_is_timer_in_use(&ts_timer))
+    {
+        wiced_stop_timer(&ts_timer);
+    }
+    ts_interval_us = (uint32_t)periodic_adv_int * PAWR_TS_UNIT_US;
+    ts_subevent_us = (uint32_t)subevent_interval * PAWR_TS_UNIT_US;
+    ts_have_evt    = WICED_FALSE;
+    pawr_ts_restart();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_on_report()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function takes the arrival of a periodic report as a sample of the local clock at a
+* known network time. Call it first thing in the report handler.
+* @param[in] evt_counter , periodic_evt_counter.
+* @param[in] subevent    , subevent of the report.
+* @param[in] data_status , report data_status, only complete reports are used.
+* @return    void.
+**************************************************************************************************/
+void pawr_ts_on_report(uint16_t evt_counter, uint8_t subevent, uint8_t data_status)
+{
+    int64_t  local = (int64_t)pawr_ts_local_us();
+    int64_t  net;
+    int64_t  res;
+    int64_t  err;
+    uint32_t err_abs;
+
+    if ((ts_interval_us == 0) || (data_status != PAWR_TS_DATA_COMPLETE))
+    {
+        return;
+    }
+    if (!ts_have_evt)
+    {
+        ts_evt64    = evt_counter;
+        ts_evt16    = evt_counter;
+        ts_have_evt = WICED_TRUE;
+    }
+    ts_evt64 += (uint16_t)(evt_counter - ts_evt16);
+    ts_evt16  = evt_counter;
+    net = ts_evt64 * ts_interval_us + (int64_t)subevent * ts_subevent_us;
+    res = local - net;
+
+    err_abs = 0;
+    if (ts_model_valid)
+    {
+        err     = res - pawr_ts_model(net);
+        err_abs = (uint32_t)((err < 0) ? -err : err);
+        /* the stack delivered this report late, it says nothing about the clock */
+        if (err_abs > PAWR_TS_OUTLIER_US)
+        {
+            ts_stats.outliers++;
+            if (++ts_outlier_run >= PAWR_TS_MAX_OUTLIERS)
+            {
+                ts_stats.restarts++;
+                pawr_ts_restart();
+            }
+            return;
+        }
+        ts_outlier_run = 0;
+    }
+    if ((ts_win_num == 0) && (ts_acc_num == 0))
+    {
+        ts_y_base = res;
+    }
+    if (ts_acc_num == 0)
+    {
+        ts_acc_x0      = net;
+        ts_acc_dx      = 0;
+        ts_acc_y       = 0;
+        ts_acc_err_max = 0;
+    }
+    ts_acc_dx += net - ts_acc_x0;
+    ts_acc_y  += res - ts_y_base;
+    ts_acc_num++;
+    ts_stats.reports++;
+    if (err_abs > ts_acc_err_max)
+    {
+        ts_acc_err_max = err_abs;
+    }
+    if (net - ts_acc_x0 < PAWR_TS_BUCKET_US)
+    {
+        return;
+    }
+
+    ts_win[ts_win_head].x = ts_acc_x0 + ts_acc_dx / ts_acc_num;
+    ts_win[ts_win_head].y = (int32_t)(ts_acc_y / ts_acc_num);
+    ts_win_head = (uint8_t)((ts_win_head + 1) % PAWR_TS_WINDOW);
+    if (ts_win_num < PAWR_TS_WINDOW)
+    {
+        ts_win_num++;
+    }
+    ts_stats.jitter_us = ts_acc_err_max;
+    ts_acc_num = 0;
+    pawr_ts_fit();
+    pawr_ts_arm();
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_is_synced()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function tells whether network time can be converted.
+* @return    wiced_bool_t WICED_TRUE once the first sample is fitted.
+**************************************************************************************************/
+wiced_bool_t pawr_ts_is_synced(void)
+{
+    return ts_model_valid;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_now()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function returns the current network time as the last event counter that started and
+* the time since its anchor.
+* @param[out] p_evt_counter , periodic_evt_counter.
+* @param[out] p_offset_us   , time since the event anchor.
+* @return     wiced_bool_t WICED_FALSE before the first fit.
+**************************************************************************************************/
+wiced_bool_t pawr_ts_now(uint16_t *p_evt_counter, uint32_t *p_offset_us)
+{
+    int64_t local;
+    int64_t net;
+    int64_t evt;
+
+    if (!ts_model_valid)
+    {
+        return WICED_FALSE;
+    }
+    /* local = net + model(net); one correction step is exact to well below a microsecond */
+    local = (int64_t)pawr_ts_local_us();
+    net   = local - ts_c;
+    net   = local - pawr_ts_model(net);
+    evt   = net / ts_interval_us;
+    *p_evt_counter = (uint16_t)evt;
+    *p_offset_us   = (uint32_t)(net - evt * ts_interval_us);
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_net_to_local()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function converts a network instant to the local clock.
+* @param[in]  evt_counter , periodic_evt_counter, within half a counter wrap of now.
+* @param[in]  offset_us   , time after the event anchor.
+* @param[out] p_local_us  , local time, see pawr_ts_local_us().
+* @return     wiced_bool_t WICED_FALSE before the first fit.
+**************************************************************************************************/
+wiced_bool_t pawr_ts_net_to_local(uint16_t evt_counter, uint32_t offset_us, uint64_t *p_local_us)
+{
+    int64_t net;
+
+    if (!ts_model_valid)
+    {
+        return WICED_FALSE;
+    }
+    net = pawr_ts_evt_to_net(evt_counter, offset_us);
+    *p_local_us = (uint64_t)(net + pawr_ts_model(net));
+    return WICED_TRUE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_schedule()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function runs a callback at a network instant, e.g. a sample or an actuation that all
+* peripherals perform together. The callback runs from a stack timer.
+* @param[in] evt_counter , periodic_evt_counter, within half a counter wrap of now.
+* @param[in] offset_us   , time after the event anchor.
+* @param[in] callback    , action.
+* @param[in] p_arg       , passed to the action.
+* @return    wiced_bool_t WICED_FALSE before the first fit, when the instant has passed or
+*            when PAWR_TS_MAX_ACTIONS are pending.
+**************************************************************************************************/
+wiced_bool_t pawr_ts_schedule(uint16_t evt_counter, uint32_t offset_us, pawr_ts_action_cb_t *callback, void *p_arg)
+{
+    int64_t net;
+    uint8_t i;
+
+    if (!ts_model_valid || (callback == NULL))
+    {
+        return WICED_FALSE;
+    }
+    net = pawr_ts_evt_to_net(evt_counter, offset_us);
+    if (net + pawr_ts_model(net) + PAWR_TS_EARLY_US < (int64_t)pawr_ts_local_us())
+    {
+        return WICED_FALSE;
+    }
+    for (i = 0; i < PAWR_TS_MAX_ACTIONS; i++)
+    {
+        if (!ts_action[i].in_use)
+        {
+            ts_action[i].in_use = WICED_TRUE;
+            ts_action[i].net_us = net;
+            ts_action[i].cb     = callback;
+            ts_action[i].p_arg  = p_arg;
+            pawr_ts_arm();
+            return WICED_TRUE;
+        }
+    }
+    return WICED_FALSE;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_get_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function copies the time service statistics.
+* @param[out] p_stats , statistics.
+* @return     void.
+**************************************************************************************************/
+void pawr_ts_get_stats(pawr_ts_stats_t *p_stats)
+{
+    *p_stats           = ts_stats;
+    p_stats->synced    = ts_model_valid;
+    p_stats->drift_ppb = ts_drift_ppb;
+}
+
+/**************************************************************************************************
+* Function Name: pawr_ts_print_stats()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function prints the time service statistics.
+* @return    void.
+**************************************************************************************************/
+void pawr_ts_print_stats(void)
+{
+    pawr_ts_stats_t s;
+
+    pawr_ts_get_stats(&s);
+    printf("ts: synced %d, drift %ld ppb, jitter %lu us, reports %lu outliers %lu restarts %lu\n",
+           s.synced, (long)s.drift_ppb, (unsigned long)s.jitter_us,
+           (unsigned long)s.reports, (unsigned long)s.outliers, (unsigned long)s.restarts);
+    printf("ts: actions fired %lu dropped %lu, late max %ld us\n",
+           (unsigned long)s.actions_fired, (unsigned long)s.actions_dropped, (long)s.late_max_us);
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name:   pawr_timesync.h
+*
+* Description: This file is the public interface of the network time derived from the PAwR event counter.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef PAWR_TIMESYNC_H_
+#define PAWR_TIMESYNC_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Network time is periodic_evt_counter * periodic advertising interval + subevent * subevent
+ * interval, in microseconds. Every peripheral of a train sees the same counter, so the same
+ * (evt_counter, offset_us) pair names the same instant on all of them. */
+#define PAWR_TS_BUCKET_US               (4000000)   /* reports averaged into one sample */
+#define PAWR_TS_WINDOW                  (16)        /* samples in the drift fit */
+#define PAWR_TS_OUTLIER_US              (4000)      /* reports this far off the fit are late deliveries */
+#define PAWR_TS_MAX_OUTLIERS            (8)         /* consecutive outliers that restart the estimate */
+#define PAWR_TS_MAX_ACTIONS             (4)
+#define PAWR_TS_EARLY_US                (500)       /* actions this close to due run now, half a tick */
+
+/*******************************************************************************
+ * Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    wiced_bool_t synced;                         /* a clock model is in place */
+    int32_t      drift_ppb;                      /* local clock rate against the network, ppb */
+    uint32_t     jitter_us;                      /* largest report residual in the last sample, us */
+    uint32_t     reports;                        /* reports used */
+    uint32_t     outliers;                       /* reports rejected as late */
+    uint32_t     restarts;                       /* estimates restarted after outliers */
+    uint32_t     actions_fired;
+    uint32_t     actions_dropped;                /* pending actions cancelled by a new sync */
+    int32_t      late_max_us;                    /* latest action against its local due time */
+} pawr_ts_stats_t;
+
+/* Runs at the scheduled network instant; late_us is the local clock past the due time. */
+typedef void (pawr_ts_action_cb_t)(void *p_arg, int32_t late_us);
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void pawr_ts_init(void);
+void pawr_ts_on_sync(uint16_t periodic_adv_int, uint8_t subevent_interval);
+void pawr_ts_on_report(uint16_t evt_counter, uint8_t subevent, uint8_t data_status);
+uint64_t pawr_ts_local_us(void);
+wiced_bool_t pawr_ts_is_synced(void);
+wiced_bool_t pawr_ts_now(uint16_t *p_evt_counter, uint32_t *p_offset_us);
+wiced_bool_t pawr_ts_net_to_local(uint16_t evt_counter, uint32_t offset_us, uint64_t *p_local_us);
+wiced_bool_t pawr_ts_schedule(uint16_t evt_counter, uint32_t offset_us, pawr_ts_action_cb_t *callback, void *p_arg);
+void pawr_ts_get_stats(pawr_ts_stats_t *p_stats);
+void pawr_ts_print_stats(void);
+#endif /* PAWR_TIMESYNC_H_ */
@@ -0,0 +1,144 @@
+/******************************************************************************
+* File Name:   bench_app_bt_dispatch.c
+*
+* Description: This file times the event dispatch table against the switch based stack callback it
+*              replaced, with one and three handlers per event and for unhandled events.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "host_test.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_EVENTS                    (8)      /* events with handlers, as in the PAwR peripheral */
+#define BENCH_SEQ_LEN                   (256)    /* events in the order they arrive, repeated */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* event ids spread over the table, like the ids the peripheral subscribes to */
+static const uint8_t bench_event_id[BENCH_EVENTS] = {0, 3, 7, 12, 19, 24, 31, 40};
+
+static uint8_t           bench_seq[BENCH_SEQ_LEN];
+static volatile uint32_t bench_sink;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static __attribute__((noinline)) wiced_result_t bench_handler(uint32_t event, void *p_event_data)
+{
+    bench_sink += event;
+    return WICED_BT_SUCCESS;
+}
+
+/* the callback style the dispatcher replaced: one switch over the event id in the stack callback */
+static __attribute__((noinline)) wiced_result_t bench_switch_cb(uint32_t event, void *p_event_data)
+{
+    switch (event)
+    {
+    case 0:
+    case 3:
+    case 7:
+    case 12:
+    case 19:
+    case 24:
+    case 31:
+    case 40:
+        return bench_handler(event, p_event_data);
+    default:
+        return WICED_BT_ERROR;
+    }
+}
+
+static void bench_switch(uint32_t iter)
+{
+    bench_switch_cb(bench_seq[iter % BENCH_SEQ_LEN], NULL);
+}
+
+static void bench_dispatch(uint32_t iter)
+{
+    app_bt_dispatch(APP_BT_DISPATCH_BTM, bench_seq[iter % BENCH_SEQ_LEN], NULL);
+}
+
+static void bench_dispatch_three(uint32_t iter)
+{
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_ADV, bench_event_id[0], NULL);
+}
+
+static void bench_dispatch_unhandled(uint32_t iter)
+{
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_SCAN, 1 + iter % (APP_BT_DISPATCH_MAX_EVENTS - 1), NULL);
+}
+
+static void bench_print(const char *name, double ns)
+{
+    printf("%-34s %8.1f %10.1f\n", name, ns, 1000.0 / ns);
+}
+
+int main(void)
+{
+    uint32_t rng = 0x5EED0031UL;
+    uint32_t i;
+
+    /* events in random order, so the branch predictor does not learn the sequence */
+    for (i = 0; i < BENCH_SEQ_LEN; i++)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        bench_seq[i] = bench_event_id[rng % BENCH_EVENTS];
+    }
+    app_bt_dispatch_init();
+    for (i = 0; i < BENCH_EVENTS; i++)
+    {
+        TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_BTM, bench_event_id[i], bench_handler) == WICED_SUCCESS);
+    }
+    for (i = 0; i < 3; i++)
+    {
+        TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, bench_event_id[0], bench_handler) == WICED_SUCCESS);
+    }
+
+    printf("event dispatch, %d subscribed events in random order, host at -O2\n", BENCH_EVENTS);
+    printf("path                                ns/event  Mevents/s\n");
+    bench_print("switch callback, 1 handler", host_bench_ns(bench_switch));
+    bench_print("app_bt_dispatch, 1 handler", host_bench_ns(bench_dispatch));
+    bench_print("app_bt_dispatch, 3 handlers", host_bench_ns(bench_dispatch_three));
+    bench_print("app_bt_dispatch, unhandled", host_bench_ns(bench_dispatch_unhandled));
+    return 0;
+}
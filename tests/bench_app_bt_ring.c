@@ -0,0 +1,205 @@
+/******************************************************************************
+* File Name:   bench_app_bt_ring.c
+*
+* Description: This file times the SPSC ring against a model of a FreeRTOS queue on the host, one element
+*              at a time and in batches, for several element sizes.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <stdatomic.h>
+#include "host_test.h"
+#include "app_bt_ring.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_CAP                       (64)
+#define BENCH_BATCH                     (8)
+#define BENCH_MAX_ELEM                  (64)
+#define BENCH_MIN_NS                    (200000000ULL)   /* run each case at least this long */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* A model of a FreeRTOS queue on a single core with no task blocked on it: xQueueSend and
+ * xQueueReceive each enter a critical section, copy the item through a counted circular buffer
+ * and check the waiting-task lists. The critical section is a spin lock here. */
+typedef struct
+{
+    atomic_flag lock;
+    uint8_t     *p_buf;
+    uint16_t    item_size;
+    uint32_t    length;
+    uint32_t    count;
+    uint32_t    write;
+    uint32_t    read;
+    uint32_t    tasks_waiting_to_send;
+    uint32_t    tasks_waiting_to_receive;
+} bench_queue_t;
+
+static const uint16_t bench_sizes[] = {4, 16, 64};
+
+APP_BT_RING_DEFINE_BUF(bench_buf, BENCH_MAX_ELEM, BENCH_CAP);
+static app_bt_ring_t bench_ring;
+static uint8_t       bench_qbuf[BENCH_MAX_ELEM * BENCH_CAP];
+static bench_queue_t bench_q;
+static volatile uint8_t bench_sink;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static wiced_bool_t queue_send(bench_queue_t *p_q, const void *p_item)
+{
+    wiced_bool_t ok = WICED_FALSE;
+
+    while (atomic_flag_test_and_set_explicit(&p_q->lock, memory_order_acquire))
+    {
+    }
+    if (p_q->count < p_q->length)
+    {
+        memcpy(&p_q->p_buf[p_q->write * p_q->item_size], p_item, p_q->item_size);
+        p_q->write = (p_q->write + 1 == p_q->length) ? 0 : p_q->write + 1;
+        p_q->count++;
+        ok = WICED_TRUE;
+        if (p_q->tasks_waiting_to_receive != 0)
+        {
+            p_q->tasks_waiting_to_receive--;
+        }
+    }
+    atomic_flag_clear_explicit(&p_q->lock, memory_order_release);
+    return ok;
+}
+
+static wiced_bool_t queue_receive(bench_queue_t *p_q, void *p_item)
+{
+    wiced_bool_t ok = WICED_FALSE;
+
+    while (atomic_flag_test_and_set_explicit(&p_q->lock, memory_order_acquire))
+    {
+    }
+    if (p_q->count != 0)
+    {
+        memcpy(p_item, &p_q->p_buf[p_q->read * p_q->item_size], p_q->item_size);
+        p_q->read = (p_q->read + 1 == p_q->length) ? 0 : p_q->read + 1;
+        p_q->count--;
+        ok = WICED_TRUE;
+        if (p_q->tasks_waiting_to_send != 0)
+        {
+            p_q->tasks_waiting_to_send--;
+        }
+    }
+    atomic_flag_clear_explicit(&p_q->lock, memory_order_release);
+    return ok;
+}
+
+/* ns per element of a transfer: mode 0 ring one at a time, 1 ring in batches, 2 the queue model;
+ * BENCH_BATCH elements go in, then come out, as a stack callback and a task would on one core */
+static double bench_run(uint16_t size, uint8_t mode)
+{
+    uint8_t  in[BENCH_BATCH * BENCH_MAX_ELEM];
+    uint8_t  out[BENCH_BATCH * BENCH_MAX_ELEM];
+    uint64_t start = host_clock_ns();
+    uint64_t elems = 0;
+    uint32_t rounds;
+    uint8_t  i;
+
+    memset(in, 0x5A, sizeof(in));
+    TEST_CHECK(app_bt_ring_init(&bench_ring, bench_buf, size, BENCH_CAP) == WICED_SUCCESS);
+    memset(&bench_q, 0, sizeof(bench_q));
+    bench_q.p_buf     = bench_qbuf;
+    bench_q.item_size = size;
+    bench_q.length    = BENCH_CAP;
+    do
+    {
+        for (rounds = 0; rounds < 10000; rounds++)
+        {
+            in[0] = (uint8_t)rounds;
+            switch (mode)
+            {
+            case 0:
+                for (i = 0; i < BENCH_BATCH; i++)
+                {
+                    app_bt_ring_push(&bench_ring, &in[i * size]);
+                }
+                for (i = 0; i < BENCH_BATCH; i++)
+                {
+                    app_bt_ring_pop(&bench_ring, &out[i * size]);
+                }
+                break;
+            case 1:
+                app_bt_ring_push_batch(&bench_ring, in, BENCH_BATCH);
+                app_bt_ring_pop_batch(&bench_ring, out, BENCH_BATCH);
+                break;
+            default:
+                for (i = 0; i < BENCH_BATCH; i++)
+                {
+                    queue_send(&bench_q, &in[i * size]);
+                }
+                for (i = 0; i < BENCH_BATCH; i++)
+                {
+                    queue_receive(&bench_q, &out[i * size]);
+                }
+                break;
+            }
+            bench_sink ^= out[0];
+            TEST_CHECK(out[0] == (uint8_t)rounds);
+        }
+        elems += 10000ULL * BENCH_BATCH;
+    } while (host_clock_ns() - start < BENCH_MIN_NS);
+    return (double)(host_clock_ns() - start) / (double)elems;
+}
+
+int main(void)
+{
+    double  ns[3];
+    uint8_t i;
+    uint8_t mode;
+
+    printf("SPSC ring against a FreeRTOS queue model, %d elements in then out, one thread, ns per element\n",
+           BENCH_BATCH);
+    printf("elem B   ring   ring batch   queue model   queue/ring\n");
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++)
+    {
+        for (mode = 0; mode < 3; mode++)
+        {
+            ns[mode] = bench_run(bench_sizes[i], mode);
+        }
+        printf("%6u %6.1f %12.1f %13.1f %12.2f\n", bench_sizes[i], ns[0], ns[1], ns[2], ns[2] / ns[0]);
+    }
+    return 0;
+}
@@ -0,0 +1,272 @@
+/******************************************************************************
+* File Name:   bench_pawr_compress.c
+*
+* Description: This file measures the compression ratio and the time per byte of the response compression
+*              on corpora of the responses this application sends: backlog drains, multi-sample sensor
+*              frames and status text, and random data as the worst case.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_backlog.h"
+#include "pawr_compress.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_FRAMES                    (512)    /* frames per corpus */
+#define BENCH_SENSOR_FIELDS             (6)      /* temperature, humidity, pressure, acceleration x, y, z */
+#define BENCH_SENSOR_SAMPLES            (8)
+#define BENCH_SAMPLE_LEN                (4)      /* the demo's sample: sequence number and sensor reading */
+#define BENCH_DRAIN_RECORDS             ((PAWR_BACKLOG_MSG_MAX_LEN - PAWR_BACKLOG_MSG_HDR_LEN) / \
+                                         (PAWR_BACKLOG_REC_HDR_LEN + BENCH_SAMPLE_LEN))
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint8_t  len;
+    uint8_t  data[PAWR_CMP_MAX_IN_LEN];
+} bench_frame_t;
+
+typedef struct
+{
+    const char *name;
+    void       (*make)(bench_frame_t *p_frame, uint32_t n);
+    wiced_bool_t text_dict;                      /* use the status text dictionary instead of the default */
+} bench_corpus_t;
+
+/* what the central and the status frames share, installed with pawr_cmp_set_dict() */
+static const uint8_t bench_text_dict[] = "node  status ok low fw 1.4.2 batt % rssi -dBm temp C ";
+
+static bench_frame_t bench_frames[BENCH_FRAMES];
+static uint8_t       bench_msg[BENCH_FRAMES][PAWR_CMP_MAX_IN_LEN];
+static uint16_t      bench_msg_len[BENCH_FRAMES];
+static uint32_t      rng;
+static int16_t       bench_field[BENCH_SENSOR_FIELDS];
+static uint16_t      bench_seq;
+static volatile uint32_t bench_sink;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint32_t bench_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/* a slowly moving sensor value, as sampled once a second */
+static int16_t bench_drift(int16_t v)
+{
+    uint32_t r = bench_rand() % 8;
+
+    return (int16_t)(v + ((r == 0) ? -1 : ((r == 1) ? 1 : 0)));
+}
+
+/* backlog drain response: the demo's samples, one a second, with their record headers as
+ * pawr_backlog_drain() lays them out, as many as a drain response holds */
+static void bench_make_backlog(bench_frame_t *p_frame, uint32_t n)
+{
+    uint16_t pending = (uint16_t)((BENCH_FRAMES - n) * BENCH_DRAIN_RECORDS);
+    uint8_t  *p      = p_frame->data;
+    uint8_t  i;
+
+    *p++ = PAWR_MSG_TYPE_BACKLOG;
+    *p++ = (uint8_t)pending;
+    *p++ = (uint8_t)(pending >> 8);
+    for (i = 0; i < BENCH_DRAIN_RECORDS; i++)
+    {
+        bench_field[0] = bench_drift(bench_field[0]);
+        *p++ = BENCH_SAMPLE_LEN;
+        *p++ = (uint8_t)((BENCH_DRAIN_RECORDS - i) * (1000 / PAWR_BACKLOG_AGE_UNIT_MS));
+        *p++ = 0;
+        *p++ = (uint8_t)bench_seq;
+        *p++ = (uint8_t)(bench_seq >> 8);
+        *p++ = (uint8_t)bench_field[0];
+        *p++ = (uint8_t)(bench_field[0] >> 8);
+        bench_seq++;
+    }
+    p_frame->len = (uint8_t)(p - p_frame->data);
+}
+
+/* a sensor frame of 8 samples of six 16-bit fields, 98 bytes: beyond one response uncompressed */
+static void bench_make_sensor(bench_frame_t *p_frame, uint32_t n)
+{
+    uint8_t *p = p_frame->data;
+    uint8_t  s;
+    uint8_t  f;
+
+    *p++ = PAWR_MSG_TYPE_APP;
+    *p++ = (uint8_t)bench_seq;
+    for (s = 0; s < BENCH_SENSOR_SAMPLES; s++)
+    {
+        for (f = 0; f < BENCH_SENSOR_FIELDS; f++)
+        {
+            bench_field[f] = bench_drift(bench_field[f]);
+            *p++ = (uint8_t)bench_field[f];
+            *p++ = (uint8_t)(bench_field[f] >> 8);
+        }
+    }
+    bench_seq++;
+    p_frame->len = (uint8_t)(p - p_frame->data);
+}
+
+/* a status line */
+static void bench_make_status(bench_frame_t *p_frame, uint32_t n)
+{
+    int len = snprintf((char *)p_frame->data, sizeof(p_frame->data),
+                       "node %04u status %s fw 1.4.2 batt %u%% rssi -%udBm temp %dC",
+                       (unsigned int)(n % 64), ((bench_rand() % 16) == 0) ? "low" : "ok",
+                       (unsigned int)(60 + bench_rand() % 40), (unsigned int)(40 + bench_rand() % 50),
+                       (int)(18 + bench_rand() % 8));
+
+    p_frame->len = (uint8_t)len;
+}
+
+/* encrypted or otherwise random data, the worst case */
+static void bench_make_random(bench_frame_t *p_frame, uint32_t n)
+{
+    uint8_t i;
+
+    p_frame->len = 64;
+    for (i = 0; i < p_frame->len; i++)
+    {
+        p_frame->data[i] = (uint8_t)bench_rand();
+    }
+}
+
+static const bench_corpus_t bench_corpora[] =
+{
+    {"backlog drain",  bench_make_backlog, WICED_FALSE},
+    {"sensor frame",   bench_make_sensor,  WICED_FALSE},
+    {"status text",    bench_make_status,  WICED_FALSE},
+    {"status, dict",   bench_make_status,  WICED_TRUE},
+    {"random",         bench_make_random,  WICED_FALSE},
+};
+
+static void bench_compress(uint32_t iter)
+{
+    uint32_t n = iter % BENCH_FRAMES;
+
+    bench_sink += pawr_cmp_compress(bench_frames[n].data, bench_frames[n].len, bench_msg[n], PAWR_CMP_MAX_IN_LEN);
+}
+
+static void bench_decompress(uint32_t iter)
+{
+    uint8_t  out[PAWR_CMP_MAX_IN_LEN];
+    uint32_t n = iter % BENCH_FRAMES;
+
+    if (bench_msg_len[n] != 0)
+    {
+        bench_sink += pawr_cmp_decompress(bench_msg[n], bench_msg_len[n], out, sizeof(out));
+    }
+}
+
+static void bench_corpus(const bench_corpus_t *p_corpus)
+{
+    uint8_t  out[PAWR_CMP_MAX_IN_LEN];
+    uint32_t bytes_in     = 0;
+    uint32_t bytes_sent   = 0;
+    uint32_t bytes_packed = 0;
+    uint32_t packed       = 0;
+    uint32_t fit          = 0;
+    uint32_t n;
+    double   cmp_ns;
+    double   dec_ns;
+
+    rng       = 0x5EED0033UL;
+    bench_seq = 0;
+    memset(bench_field, 0, sizeof(bench_field));
+    pawr_cmp_init();
+    if (p_corpus->text_dict)
+    {
+        TEST_CHECK(pawr_cmp_set_dict(bench_text_dict, sizeof(bench_text_dict) - 1));
+    }
+    for (n = 0; n < BENCH_FRAMES; n++)
+    {
+        p_corpus->make(&bench_frames[n], n);
+        bench_msg_len[n] = pawr_cmp_compress(bench_frames[n].data, bench_frames[n].len, bench_msg[n], PAWR_CMP_MAX_IN_LEN);
+        bytes_in += bench_frames[n].len;
+        if (bench_msg_len[n] != 0)
+        {
+            TEST_CHECK(pawr_cmp_decompress(bench_msg[n], bench_msg_len[n], out, sizeof(out)) == bench_frames[n].len);
+            TEST_CHECK(memcmp(out, bench_frames[n].data, bench_frames[n].len) == 0);
+            packed++;
+            bytes_packed += bench_frames[n].len;
+        }
+        /* a frame goes out compressed only when that is shorter */
+        bytes_sent += (bench_msg_len[n] != 0) ? bench_msg_len[n] : bench_frames[n].len;
+        fit        += (((bench_msg_len[n] != 0) ? bench_msg_len[n] : bench_frames[n].len) <= PAWR_RSP_MAX_DATA_LEN);
+    }
+    cmp_ns = host_bench_ns(bench_compress);
+    dec_ns = host_bench_ns(bench_decompress);
+    printf("%-14s %6.1f %7.2f %5lu%% %5lu%% %10.1f",
+           p_corpus->name, (double)bytes_in / BENCH_FRAMES, (double)bytes_sent / bytes_in,
+           (unsigned long)(packed * 100U / BENCH_FRAMES), (unsigned long)(fit * 100U / BENCH_FRAMES),
+           cmp_ns * BENCH_FRAMES / bytes_in);
+    /* frames sent as they are are not decoded */
+    if (packed != 0)
+    {
+        printf(" %12.1f\n", dec_ns * BENCH_FRAMES / bytes_packed);
+    }
+    else
+    {
+        printf("            -\n");
+    }
+}
+
+int main(void)
+{
+    uint8_t i;
+
+    printf("response compression, %d frames a corpus, ns per original byte on the host at -O2\n", BENCH_FRAMES);
+    printf("ratio is bytes sent over original bytes, fits is frames within PAWR_RSP_MAX_DATA_LEN (%d)\n",
+           PAWR_RSP_MAX_DATA_LEN);
+    printf("corpus        avg len  ratio  comp  fits   comp ns/B  decomp ns/B\n");
+    for (i = 0; i < sizeof(bench_corpora) / sizeof(bench_corpora[0]); i++)
+    {
+        bench_corpus(&bench_corpora[i]);
+    }
+    return 0;
+}
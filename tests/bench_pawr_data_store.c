@@ -0,0 +1,147 @@
+/******************************************************************************
+* File Name:   bench_pawr_data_store.c
+*
+* Description: This file times the data store on the host: a report whose version is unchanged against
+*              deltas and full images that change the image, and the seqlock readers.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_data_store.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_MSG_MAX                   (247)    /* largest periodic advertising subevent data */
+#define BENCH_FULL_KEYS                 ((BENCH_MSG_MAX - PAWR_DS_HDR_LEN) / (2 + PAWR_DS_MAX_VALUE_LEN))
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint8_t  bench_msg[BENCH_MSG_MAX];
+static uint16_t bench_len;
+static uint16_t bench_version;
+static volatile uint32_t bench_sink;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* a delta on top of the current version, or a full image, with num_keys values of val_len bytes */
+static void bench_build(uint8_t flags, uint8_t num_keys, uint8_t val_len)
+{
+    uint8_t k;
+
+    bench_msg[0] = PAWR_MSG_TYPE_DS_DELTA;
+    bench_msg[5] = flags;
+    bench_len    = PAWR_DS_HDR_LEN;
+    for (k = 0; k < num_keys; k++)
+    {
+        bench_msg[bench_len]     = k;
+        bench_msg[bench_len + 1] = val_len;
+        memset(&bench_msg[bench_len + 2], k, val_len);
+        bench_len = (uint16_t)(bench_len + 2 + val_len);
+    }
+    TEST_CHECK(bench_len <= BENCH_MSG_MAX);
+}
+
+static void bench_stamp(uint16_t version, uint16_t base)
+{
+    bench_msg[1] = (uint8_t)version;
+    bench_msg[2] = (uint8_t)(version >> 8);
+    bench_msg[3] = (uint8_t)base;
+    bench_msg[4] = (uint8_t)(base >> 8);
+}
+
+/* the same version again, as in every event between two changes */
+static void bench_unchanged(uint32_t iter)
+{
+    bench_sink += pawr_ds_apply(bench_msg, bench_len);
+}
+
+/* a new version every call */
+static void bench_changed(uint32_t iter)
+{
+    bench_stamp((uint16_t)(bench_version + 1), bench_version);
+    TEST_CHECK(pawr_ds_apply(bench_msg, bench_len));
+    bench_version++;
+}
+
+static void bench_read(uint32_t iter)
+{
+    uint8_t buf[PAWR_DS_MAX_VALUE_LEN];
+
+    bench_sink += pawr_ds_read((uint8_t)(iter % BENCH_FULL_KEYS), buf, sizeof(buf), NULL);
+}
+
+static void bench_snapshot(uint32_t iter)
+{
+    pawr_ds_image_t image;
+
+    pawr_ds_snapshot(&image);
+    bench_sink += image.version;
+}
+
+static void bench_case(const char *name, uint8_t flags, uint8_t num_keys, uint8_t val_len)
+{
+    double unchanged;
+    double changed;
+
+    pawr_ds_init();
+    bench_build(flags, num_keys, val_len);
+    bench_version = 1;
+    bench_stamp(bench_version, 0);
+    bench_msg[5] = PAWR_DS_FLAG_FULL;
+    TEST_CHECK(pawr_ds_apply(bench_msg, bench_len));
+    bench_msg[5] = flags;
+    unchanged = host_bench_ns(bench_unchanged);
+    changed   = host_bench_ns(bench_changed);
+    printf("%-20s %4u %11.1f %9.1f\n", name, bench_len, unchanged, changed);
+}
+
+int main(void)
+{
+    printf("data store, ns per report on the host at -O2\n");
+    printf("report                len  unchanged   changed\n");
+    bench_case("delta, 1 key of 4 B", 0, 1, 4);
+    bench_case("delta, 4 keys of 16 B", 0, 4, PAWR_DS_MAX_VALUE_LEN);
+    bench_case("full image", PAWR_DS_FLAG_FULL, BENCH_FULL_KEYS, PAWR_DS_MAX_VALUE_LEN);
+    printf("reader, ns: pawr_ds_read() of one key %.1f, pawr_ds_snapshot() %.1f\n",
+           host_bench_ns(bench_read), host_bench_ns(bench_snapshot));
+    return 0;
+}
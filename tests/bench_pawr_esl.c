@@ -0,0 +1,155 @@
+/******************************************************************************
+* File Name:   bench_pawr_esl.c
+*
+* Description: This file times pawr_esl_process() on group payloads of the largest size: commands for
+*              other labels, for this label and broadcast, on the host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_esl.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_CMDS_MAX                  (246)    /* largest subevent data less the message type */
+#define BENCH_ESL_ID                    (7)
+#define BENCH_GROUP_ID                  (PAWR_CFG_FIRST_SUBEVENT)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static pawr_esl_ctx_t    bench_ctx;
+static uint8_t           bench_cmds[BENCH_CMDS_MAX];
+static uint16_t          bench_len;
+static uint16_t          bench_num;
+static volatile uint32_t bench_sink;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void hw_led(uint8_t led, const uint8_t *p_ctrl)
+{
+    bench_sink += p_ctrl[0];
+}
+
+static wiced_bool_t hw_display(uint8_t display, uint8_t image)
+{
+    bench_sink += image;
+    return WICED_TRUE;
+}
+
+static uint8_t hw_sensor(uint8_t sensor, uint8_t *p_data, uint8_t max_len)
+{
+    p_data[0] = 0x34;
+    p_data[1] = 0x12;
+    return 2;
+}
+
+static const pawr_esl_hw_t bench_hw =
+{
+    .num_leds      = 2,
+    .num_displays  = 1,
+    .num_images    = 4,
+    .num_sensors   = 1,
+    .led_control   = hw_led,
+    .display_image = hw_display,
+    .sensor_read   = hw_sensor,
+};
+
+/* as many copies of one command as fit, to IDs from first_id on, or all to one ID */
+static void bench_build(const uint8_t *p_cmd, uint8_t cmd_len, uint8_t first_id, wiced_bool_t same_id)
+{
+    bench_len = 0;
+    bench_num = 0;
+    while (bench_len + cmd_len <= BENCH_CMDS_MAX)
+    {
+        memcpy(&bench_cmds[bench_len], p_cmd, cmd_len);
+        bench_cmds[bench_len + 1] = same_id ? first_id : (uint8_t)((first_id + bench_num) % PAWR_ESL_ID_BROADCAST);
+        bench_len = (uint16_t)(bench_len + cmd_len);
+        bench_num++;
+    }
+}
+
+static void bench_process(uint32_t iter)
+{
+    uint8_t rsp[PAWR_ESL_MAX_RSP_LEN];
+    uint8_t slot;
+
+    bench_sink += pawr_esl_process(&bench_ctx, BENCH_GROUP_ID, bench_cmds, bench_len, iter, rsp, &slot);
+}
+
+static void bench_poll(uint32_t iter)
+{
+    pawr_esl_poll(&bench_ctx, 0);
+    bench_sink += bench_ctx.basic_state;
+}
+
+static void bench_case(const char *name, const uint8_t *p_cmd, uint8_t cmd_len, uint8_t first_id, wiced_bool_t same_id)
+{
+    double ns;
+
+    pawr_esl_init(&bench_ctx, &bench_hw, BENCH_ESL_ID, BENCH_GROUP_ID);
+    bench_build(p_cmd, cmd_len, first_id, same_id);
+    ns = host_bench_ns(bench_process);
+    printf("%-34s %4u %5u %10.1f %8.1f\n", name, bench_len, bench_num, ns, ns / bench_num);
+}
+
+int main(void)
+{
+    const uint8_t ping[]    = {PAWR_ESL_OP_PING, 0};
+    const uint8_t image[]   = {PAWR_ESL_OP_DISPLAY_IMAGE, 0, 0, 1};
+    const uint8_t led[]     = {PAWR_ESL_OP_LED_CONTROL, 0, 0, 0x07, 1, 2, 3, 4, 5, 10, 20, 0x05, 0x00};
+    const uint8_t sensor[]  = {PAWR_ESL_OP_READ_SENSOR, 0, 0};
+    const uint8_t unknown[] = {0x01, 0};
+
+    printf("ESL group payload, ns on the host at -O2\n");
+    printf("payload                             len  cmds    payload  per cmd\n");
+    /* the usual case: the payload is for other labels of the group and only its commands are walked */
+    bench_case("pings to other labels", ping, sizeof(ping), BENCH_ESL_ID + 1, WICED_FALSE);
+    bench_case("images to other labels", image, sizeof(image), BENCH_ESL_ID + 1, WICED_FALSE);
+    bench_case("pings, one to this label", ping, sizeof(ping), 0, WICED_FALSE);
+    bench_case("pings, all to this label", ping, sizeof(ping), BENCH_ESL_ID, WICED_TRUE);
+    bench_case("images, all to this label", image, sizeof(image), BENCH_ESL_ID, WICED_TRUE);
+    bench_case("sensor reads, all to this label", sensor, sizeof(sensor), BENCH_ESL_ID, WICED_TRUE);
+    bench_case("unknown opcode, all to this label", unknown, sizeof(unknown), BENCH_ESL_ID, WICED_TRUE);
+    bench_case("broadcast LED control", led, sizeof(led), PAWR_ESL_ID_BROADCAST, WICED_TRUE);
+    bench_case("broadcast image", image, sizeof(image), PAWR_ESL_ID_BROADCAST, WICED_TRUE);
+    printf("pawr_esl_poll() without timed commands, ns: %.1f\n", host_bench_ns(bench_poll));
+    return 0;
+}
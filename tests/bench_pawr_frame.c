@@ -0,0 +1,398 @@
+/******************************************************************************
+* File Name:   bench_pawr_frame.c
+*
+* Description: This file gives the bytes on air of display frame updates encoded as deltas, against
+*              sending the full frame, and the time pawr_frame.c takes to take in and decode them on the
+*              host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <setjmp.h>
+#include "host_test.h"
+#include "pawr_frame.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_FRAG_LEN                  (247 - PAWR_FRAME_DATA_HDR_LEN)   /* encoded bytes per DATA message */
+#define BENCH_MERGE_GAP                 (5)      /* unchanged bytes a span carries rather than start a record */
+#define BENCH_STREAM_MAX                (2 * PAWR_FRAME_BYTES)
+#define BENCH_SEED                      (0x5EED0042UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint8_t     frame[2][PAWR_FRAME_BYTES];      /* before and after */
+    uint8_t     strm[2][BENCH_STREAM_MAX];       /* before to after, and back */
+    uint16_t    strm_len[2];
+} bench_case_t;
+
+static bench_case_t      bench;
+static uint8_t           store[PAWR_FRAME_NUM_TILES][PAWR_FRAME_TILE_STRIDE];
+static uint8_t           bench_id;
+static uint16_t          bench_version = PAWR_FRAME_VERSION_NONE;   /* the first update is a full one */
+static uint8_t           bench_state;
+static jmp_buf           task_idle;
+static uint32_t          rng;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint32_t bench_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static wiced_bool_t store_init(void)
+{
+    return WICED_TRUE;
+}
+
+static wiced_bool_t store_read(uint16_t tile, uint8_t *p_buf, uint16_t len)
+{
+    memcpy(p_buf, store[tile], len);
+    return WICED_TRUE;
+}
+
+static wiced_bool_t store_write(uint16_t tile, const uint8_t *p_buf, uint16_t len)
+{
+    memcpy(store[tile], p_buf, len);
+    return WICED_TRUE;
+}
+
+static const pawr_frame_store_t ram_store =
+{
+    .init       = store_init,
+    .read_tile  = store_read,
+    .write_tile = store_write,
+};
+
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    bench_state = p_data[2];
+    return WICED_BT_SUCCESS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    longjmp(task_idle, 1);
+}
+
+static void pump(void)
+{
+    if (setjmp(task_idle) == 0)
+    {
+        host_task_fn[host_num_tasks - 1](NULL);
+    }
+}
+
+/* a simple central encoder: per tile, the changed spans as RUN or LITERAL records, or the bounding
+ * box of the changes as one RECT or FILL_RECT when that is shorter */
+static uint16_t bench_encode(const uint8_t *p_old, const uint8_t *p_new, uint8_t *p_out)
+{
+    uint16_t len = 0;
+    uint16_t tile;
+    uint16_t tile_len;
+    uint16_t span_len;
+    uint16_t pos;
+    uint16_t end;
+    uint16_t gap;
+    uint16_t x0;
+    uint16_t x1;
+    uint16_t y0;
+    uint16_t y1;
+    uint16_t i;
+    uint16_t r;
+    const uint8_t *o;
+    const uint8_t *n;
+
+    for (tile = 0; tile < PAWR_FRAME_NUM_TILES; tile++)
+    {
+        o        = &p_old[tile * PAWR_FRAME_TILE_BYTES];
+        n        = &p_new[tile * PAWR_FRAME_TILE_BYTES];
+        tile_len = pawr_frame_tile_len(tile);
+        x0 = PAWR_CFG_FRAME_ROW_BYTES;
+        y0 = PAWR_FRAME_TILE_ROWS;
+        x1 = 0;
+        y1 = 0;
+        for (i = 0; i < tile_len; i++)
+        {
+            if (o[i] != n[i])
+            {
+                x0 = (i % PAWR_CFG_FRAME_ROW_BYTES < x0) ? i % PAWR_CFG_FRAME_ROW_BYTES : x0;
+                x1 = (i % PAWR_CFG_FRAME_ROW_BYTES > x1) ? i % PAWR_CFG_FRAME_ROW_BYTES : x1;
+                y0 = (i / PAWR_CFG_FRAME_ROW_BYTES < y0) ? i / PAWR_CFG_FRAME_ROW_BYTES : y0;
+                y1 = i / PAWR_CFG_FRAME_ROW_BYTES;
+            }
+        }
+        if (x0 > x1)
+        {
+            continue;
+        }
+        p_out[len++] = PAWR_FRAME_REC_TILE;
+        p_out[len++] = (uint8_t)tile;
+
+        /* cost of the spans */
+        span_len = 0;
+        for (pos = 0; pos < tile_len; pos = end)
+        {
+            for (; (pos < tile_len) && (o[pos] == n[pos]); pos++)
+            {
+            }
+            if (pos == tile_len)
+            {
+                break;
+            }
+            for (end = pos, gap = 0; (end < tile_len) && (gap <= BENCH_MERGE_GAP); end++)
+            {
+                gap = (o[end] == n[end]) ? (uint16_t)(gap + 1) : 0;
+            }
+            end = (uint16_t)(end - gap);
+            span_len = (uint16_t)(span_len + 6 + end - pos);
+        }
+        if ((uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1) + 5 < span_len)
+        {
+            for (i = 1, r = y0; r <= y1; r++)
+            {
+                i = i && (memcmp(&n[r * PAWR_CFG_FRAME_ROW_BYTES + x0], &n[y0 * PAWR_CFG_FRAME_ROW_BYTES + x0], x1 - x0 + 1) == 0);
+                for (pos = x0; pos <= x1; pos++)
+                {
+                    i = i && (n[r * PAWR_CFG_FRAME_ROW_BYTES + pos] == n[y0 * PAWR_CFG_FRAME_ROW_BYTES + x0]);
+                }
+            }
+            p_out[len++] = i ? PAWR_FRAME_REC_FILL_RECT : PAWR_FRAME_REC_RECT;
+            p_out[len++] = (uint8_t)x0;
+            p_out[len++] = (uint8_t)y0;
+            p_out[len++] = (uint8_t)(x1 - x0 + 1);
+            p_out[len++] = (uint8_t)(y1 - y0 + 1);
+            for (r = y0; r <= y1; r++)
+            {
+                if (i)
+                {
+                    p_out[len++] = n[y0 * PAWR_CFG_FRAME_ROW_BYTES + x0];
+                    break;
+                }
+                memcpy(&p_out[len], &n[r * PAWR_CFG_FRAME_ROW_BYTES + x0], x1 - x0 + 1);
+                len = (uint16_t)(len + x1 - x0 + 1);
+            }
+            continue;
+        }
+        for (pos = 0; pos < tile_len; pos = end)
+        {
+            for (; (pos < tile_len) && (o[pos] == n[pos]); pos++)
+            {
+            }
+            if (pos == tile_len)
+            {
+                break;
+            }
+            for (end = pos, gap = 0; (end < tile_len) && (gap <= BENCH_MERGE_GAP); end++)
+            {
+                gap = (o[end] == n[end]) ? (uint16_t)(gap + 1) : 0;
+            }
+            end = (uint16_t)(end - gap);
+            for (i = pos; (i < end) && (n[i] == n[pos]); i++)
+            {
+            }
+            p_out[len++] = (i == end) ? PAWR_FRAME_REC_RUN : PAWR_FRAME_REC_LITERAL;
+            p_out[len++] = (uint8_t)pos;
+            p_out[len++] = (uint8_t)(pos >> 8);
+            p_out[len++] = (uint8_t)(end - pos);
+            p_out[len++] = (uint8_t)((end - pos) >> 8);
+            if (i == end)
+            {
+                p_out[len++] = n[pos];
+            }
+            else
+            {
+                memcpy(&p_out[len], &n[pos], end - pos);
+                len = (uint16_t)(len + end - pos);
+            }
+        }
+    }
+    p_out[len++] = PAWR_FRAME_REC_END;
+    return len;
+}
+
+/* one update of the stored frame, as the central sends it */
+static void bench_update(uint32_t iter)
+{
+    const uint8_t *p_strm = bench.strm[iter & 1];
+    uint16_t       len    = bench.strm_len[iter & 1];
+    uint8_t        m[PAWR_FRAME_DATA_HDR_LEN + BENCH_FRAG_LEN];
+    uint16_t       seq    = 0;
+    uint16_t       pos;
+    uint16_t       n;
+
+    bench_id++;
+    m[0] = PAWR_MSG_TYPE_FRAME;
+    m[1] = PAWR_FRAME_OP_BEGIN;
+    m[2] = bench_id;
+    m[3] = PAWR_FRAME_ADDR_ALL;
+    m[4] = (uint8_t)bench_version;
+    m[5] = (uint8_t)(bench_version >> 8);
+    m[6] = (uint8_t)(uint16_t)(bench_version + 1);
+    m[7] = (uint8_t)((uint16_t)(bench_version + 1) >> 8);
+    pawr_frame_on_msg(PAWR_CFG_FIRST_SUBEVENT, m, PAWR_FRAME_BEGIN_LEN);
+    m[1] = PAWR_FRAME_OP_DATA;
+    for (pos = 0; pos < len; pos = (uint16_t)(pos + n))
+    {
+        n    = (uint16_t)((len - pos < BENCH_FRAG_LEN) ? (len - pos) : BENCH_FRAG_LEN);
+        m[3] = (uint8_t)seq;
+        m[4] = (uint8_t)(seq >> 8);
+        memcpy(&m[PAWR_FRAME_DATA_HDR_LEN], &p_strm[pos], n);
+        pawr_frame_on_msg(PAWR_CFG_FIRST_SUBEVENT, m, (uint16_t)(PAWR_FRAME_DATA_HDR_LEN + n));
+        seq++;
+        pump();
+    }
+    m[1] = PAWR_FRAME_OP_QUERY;
+    pawr_frame_on_msg(PAWR_CFG_FIRST_SUBEVENT, m, 3);
+    TEST_CHECK(bench_state == PAWR_FRAME_STATE_DONE);
+    bench_version++;
+}
+
+/* text: rows of glyph-like bytes, mostly white with dark strokes */
+static void bench_text(uint8_t *p_frame, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    uint16_t r;
+    uint16_t c;
+
+    for (r = y; r < y + h; r++)
+    {
+        for (c = x; c < x + w; c++)
+        {
+            p_frame[r * PAWR_CFG_FRAME_ROW_BYTES + c] = ((bench_rand() % 4) == 0) ? 0 : (uint8_t)(bench_rand() & bench_rand());
+        }
+    }
+}
+
+static void bench_fill(uint8_t *p_frame, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t value)
+{
+    uint16_t r;
+
+    for (r = y; r < y + h; r++)
+    {
+        memset(&p_frame[r * PAWR_CFG_FRAME_ROW_BYTES + x], value, w);
+    }
+}
+
+/* the label layout: product name, price, a bar code and a footer */
+static void bench_label(uint8_t *p_frame)
+{
+    memset(p_frame, 0, PAWR_FRAME_BYTES);
+    bench_text(p_frame, 2, 10, 46, 24);
+    bench_text(p_frame, 2, 40, 30, 16);
+    bench_text(p_frame, 20, 120, 20, 48);
+    bench_text(p_frame, 4, 200, 30, 40);
+    bench_text(p_frame, 2, 280, 40, 12);
+}
+
+static void bench_run(const char *name)
+{
+    uint16_t           frags;
+    double             ns;
+    uint32_t           t;
+
+    bench.strm_len[0] = bench_encode(bench.frame[0], bench.frame[1], bench.strm[0]);
+    bench.strm_len[1] = bench_encode(bench.frame[1], bench.frame[0], bench.strm[1]);
+    frags = (uint16_t)((bench.strm_len[0] + BENCH_FRAG_LEN - 1) / BENCH_FRAG_LEN);
+    for (t = 0; t < PAWR_FRAME_NUM_TILES; t++)
+    {
+        memcpy(store[t], &bench.frame[0][t * PAWR_FRAME_TILE_BYTES], pawr_frame_tile_len((uint16_t)t));
+    }
+    /* the check after each update only holds from an even count */
+    bench_update(0);
+    TEST_CHECK(memcmp(store[PAWR_FRAME_NUM_TILES - 1], &bench.frame[1][(PAWR_FRAME_NUM_TILES - 1) * PAWR_FRAME_TILE_BYTES],
+                      pawr_frame_tile_len(PAWR_FRAME_NUM_TILES - 1)) == 0);
+    bench_update(1);
+    ns = host_bench_ns(bench_update);
+    printf("%-26s %6u %5.1f %6u %9.1f %7.2f %8.0f\n", name, bench.strm_len[0],
+           100.0 - bench.strm_len[0] * 100.0 / PAWR_FRAME_BYTES, frags, ns / 1000.0, ns / bench.strm_len[0],
+           bench.strm_len[0] * 1000.0 / ns);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    rng = BENCH_SEED;
+    pawr_frame_init();
+    pawr_frame_set_store(&ram_store);
+
+    printf("display frame updates, %u x %u bytes in %u tiles, DATA fragments of %u bytes, seed 0x%08lX\n",
+           PAWR_CFG_FRAME_ROW_BYTES, PAWR_CFG_FRAME_HEIGHT, (unsigned int)PAWR_FRAME_NUM_TILES, BENCH_FRAG_LEN,
+           (unsigned long)BENCH_SEED);
+    printf("an update is BEGIN, the DATA fragments and the decoder run for each, and QUERY, on the host at -O2;\n"
+           "the time includes copying each touched tile out of and back into a RAM store\n");
+    printf("update                    encoded saved%%  frags update us ns/byte  MB/s\n");
+
+    bench_label(bench.frame[0]);
+    memcpy(bench.frame[1], bench.frame[0], PAWR_FRAME_BYTES);
+    bench_text(bench.frame[1], 20, 120, 20, 48);
+    bench_run("price");
+
+    memcpy(bench.frame[1], bench.frame[0], PAWR_FRAME_BYTES);
+    bench_text(bench.frame[1], 2, 40, 30, 16);
+    bench_text(bench.frame[1], 20, 120, 20, 48);
+    bench_run("price and promo line");
+
+    memcpy(bench.frame[1], bench.frame[0], PAWR_FRAME_BYTES);
+    bench_fill(bench.frame[1], 0, 250, PAWR_CFG_FRAME_ROW_BYTES, 50, 0xFF);
+    bench_run("sale banner, one fill");
+
+    bench_label(bench.frame[1]);
+    bench_run("new product");
+
+    memset(bench.frame[0], 0, PAWR_FRAME_BYTES);
+    bench_label(bench.frame[1]);
+    bench_run("first image on a blank");
+
+    for (i = 0; i < PAWR_FRAME_BYTES; i++)
+    {
+        bench.frame[1][i] = (uint8_t)bench_rand();
+    }
+    bench_run("noise, worst case");
+    return 0;
+}
@@ -0,0 +1,173 @@
+/******************************************************************************
+* File Name:   bench_pawr_packed.c
+*
+* Description: This file times the lookup of this device's record in packed messages of the largest size,
+*              with the sorted index and with the bitmap, against a linear scan of the index.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_packed.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_MSG_MAX                   (247)    /* largest periodic advertising subevent data */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint8_t           bench_msg[BENCH_MSG_MAX];
+static uint16_t          bench_len;
+static uint8_t           bench_id;
+static volatile uint32_t bench_sink;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* INDEX: n records of rec_len bytes for the even IDs from 0 */
+static void bench_build_index(uint8_t n, uint8_t rec_len)
+{
+    uint16_t i;
+
+    bench_msg[0] = PAWR_MSG_TYPE_PACKED;
+    bench_msg[1] = PAWR_PACKED_FMT_INDEX;
+    bench_msg[2] = n;
+    for (i = 0; i < n; i++)
+    {
+        bench_msg[PAWR_PACKED_INDEX_HDR_LEN + 2 * i]     = (uint8_t)(2 * i);
+        bench_msg[PAWR_PACKED_INDEX_HDR_LEN + 2 * i + 1] = (uint8_t)((i + 1) * rec_len);
+    }
+    bench_len = (uint16_t)(PAWR_PACKED_INDEX_HDR_LEN + n * (2 + rec_len));
+    memset(&bench_msg[PAWR_PACKED_INDEX_HDR_LEN + 2 * n], PAWR_MSG_TYPE_APP, n * rec_len);
+    TEST_CHECK(bench_len <= BENCH_MSG_MAX);
+}
+
+/* BITMAP: records of rec_len bytes for every ID from 0 while they fit */
+static void bench_build_bitmap(uint8_t rec_len)
+{
+    uint8_t  map_len = 1;
+    uint16_t n;
+
+    while ((PAWR_PACKED_BITMAP_HDR_LEN + map_len + 1 + (map_len + 1) * 8 * rec_len <= BENCH_MSG_MAX) && (map_len < 32))
+    {
+        map_len++;
+    }
+    n = (uint16_t)((BENCH_MSG_MAX - PAWR_PACKED_BITMAP_HDR_LEN - map_len) / rec_len);
+    n = (n > map_len * 8) ? (uint16_t)(map_len * 8) : n;
+    bench_msg[0] = PAWR_MSG_TYPE_PACKED;
+    bench_msg[1] = PAWR_PACKED_FMT_BITMAP;
+    bench_msg[2] = rec_len;
+    bench_msg[3] = 0;
+    bench_msg[4] = map_len;
+    memset(&bench_msg[PAWR_PACKED_BITMAP_HDR_LEN], 0, map_len);
+    memset(&bench_msg[PAWR_PACKED_BITMAP_HDR_LEN], 0xFF, n / 8);
+    bench_msg[PAWR_PACKED_BITMAP_HDR_LEN + n / 8] = (uint8_t)((1U << (n % 8)) - 1);
+    memset(&bench_msg[PAWR_PACKED_BITMAP_HDR_LEN + map_len], PAWR_MSG_TYPE_APP, n * rec_len);
+    bench_len = (uint16_t)(PAWR_PACKED_BITMAP_HDR_LEN + map_len + n * rec_len);
+}
+
+static void bench_find(uint32_t iter)
+{
+    const uint8_t *p_rec = NULL;
+
+    bench_sink += pawr_packed_find(bench_msg, bench_len, &p_rec);
+}
+
+/* what every device would do without the sorted index: walk the entries up to its own */
+static void bench_scan(uint32_t iter)
+{
+    const uint8_t *p_idx = &bench_msg[PAWR_PACKED_INDEX_HDR_LEN];
+    uint16_t       start = 0;
+    uint16_t       i;
+
+    for (i = 0; i < bench_msg[2]; i++)
+    {
+        if (p_idx[2 * i] == bench_id)
+        {
+            bench_sink += (uint32_t)(p_idx[2 * i + 1] - start);
+            return;
+        }
+        start = p_idx[2 * i + 1];
+    }
+}
+
+static double bench_at(uint8_t id, void (*p_fn)(uint32_t iter))
+{
+    bench_id = id;
+    pawr_packed_set_id(id);
+    return host_bench_ns(p_fn);
+}
+
+static void bench_index(uint8_t n, uint8_t rec_len)
+{
+    const uint8_t last = (uint8_t)(2 * (n - 1));
+
+    bench_build_index(n, rec_len);
+    printf("index  %3u x %-3u %4u %7.1f %7.1f %7.1f %7.1f %7.1f\n", n, rec_len, bench_len,
+           bench_at(0, bench_find), bench_at(last, bench_find), bench_at(last + 1, bench_find),
+           bench_at(0, bench_scan), bench_at(last, bench_scan));
+}
+
+static void bench_bitmap(uint8_t rec_len)
+{
+    uint8_t n;
+
+    bench_build_bitmap(rec_len);
+    n = (uint8_t)((bench_len - PAWR_PACKED_BITMAP_HDR_LEN - bench_msg[4]) / rec_len);
+    printf("bitmap %3u x %-3u %4u %7.1f %7.1f %7.1f\n", n, rec_len, bench_len,
+           bench_at(0, bench_find), bench_at((uint8_t)(n - 1), bench_find), bench_at(n, bench_find));
+}
+
+int main(void)
+{
+    printf("packed message lookup, ns per message on the host at -O2\n");
+    printf("the index holds the even IDs; first and last are the positions of this device's record\n");
+    printf("layout records     len   first    last  absent scan 1st scan last\n");
+    bench_index(4, 40);
+    bench_index(16, 12);
+    bench_index(48, 3);
+    bench_index(80, 1);
+    bench_bitmap(1);
+    bench_bitmap(4);
+    bench_bitmap(16);
+    printf("with PAWR_PACKED_ID_NONE, before the ESL ID is assigned: %.1f ns\n",
+           bench_at(PAWR_PACKED_ID_NONE, bench_find));
+    return 0;
+}
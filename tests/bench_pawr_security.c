@@ -0,0 +1,146 @@
+/******************************************************************************
+* File Name:   bench_pawr_security.c
+*
+* Description: This file times opening a secure downlink message and sealing a response per payload size.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <openssl/evp.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_security.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BENCH_NONCE_LEN                 (13)
+#define BENCH_EPOCH                     (1)
+#define BENCH_SUBEVENT                  (0)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static const uint8_t                   bench_key[PAWR_SEC_KEY_LEN] = {0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7,
+                                                                      0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF};
+static const wiced_bt_device_address_t bench_central = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+static const wiced_bt_device_address_t bench_device  = {0xC1, 0x02, 0x03, 0x04, 0x05, 0x06};
+static const uint16_t                  bench_sizes[] = {8, 16, 32, 64, 128, PAWR_SEC_MAX_MSG_LEN - PAWR_SEC_OVERHEAD};
+
+static uint8_t           bench_plain[PAWR_SEC_MAX_MSG_LEN];
+static uint8_t           bench_msg[PAWR_SEC_MAX_MSG_LEN];
+static uint16_t          bench_len;
+static uint16_t          bench_evt = 100;
+static volatile uint32_t bench_sink;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* a downlink message of len bytes in a new event, as the central seals it with the OpenSSL AES-CCM */
+static void bench_central_seal(uint16_t len)
+{
+    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+    uint8_t         nonce[BENCH_NONCE_LEN];
+    int             out_len;
+
+    bench_evt++;
+    bench_msg[0] = PAWR_MSG_TYPE_SECURE;
+    bench_msg[1] = 0;
+    bench_msg[2] = (uint8_t)BENCH_EPOCH;
+    bench_msg[3] = (uint8_t)(BENCH_EPOCH >> 8);
+    memcpy(nonce, bench_central, BD_ADDR_LEN);
+    memset(&nonce[BD_ADDR_LEN], 0, BENCH_NONCE_LEN - BD_ADDR_LEN);
+    nonce[6] = (uint8_t)BENCH_EPOCH;
+    nonce[8] = (uint8_t)bench_evt;
+    nonce[9] = (uint8_t)(bench_evt >> 8);
+    TEST_CHECK(ctx != NULL);
+    TEST_CHECK(EVP_EncryptInit_ex(ctx, EVP_aes_128_ccm(), NULL, NULL, NULL) == 1);
+    TEST_CHECK(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, BENCH_NONCE_LEN, NULL) == 1);
+    TEST_CHECK(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, PAWR_SEC_MIC_LEN, NULL) == 1);
+    TEST_CHECK(EVP_EncryptInit_ex(ctx, NULL, NULL, bench_key, nonce) == 1);
+    TEST_CHECK(EVP_EncryptUpdate(ctx, NULL, &out_len, NULL, len) == 1);
+    TEST_CHECK(EVP_EncryptUpdate(ctx, NULL, &out_len, bench_msg, PAWR_SEC_HDR_LEN) == 1);
+    TEST_CHECK(EVP_EncryptUpdate(ctx, &bench_msg[PAWR_SEC_HDR_LEN], &out_len, bench_plain, len) == 1);
+    TEST_CHECK(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, PAWR_SEC_MIC_LEN, &bench_msg[PAWR_SEC_HDR_LEN + len]) == 1);
+    EVP_CIPHER_CTX_free(ctx);
+    bench_len = (uint16_t)(len + PAWR_SEC_OVERHEAD);
+}
+
+/* the tag is checked before the replay window, so opening the same message again costs what a
+ * fresh one does; only the first open is accepted */
+static void bench_open(uint32_t iter)
+{
+    uint8_t out[PAWR_SEC_MAX_MSG_LEN];
+
+    bench_sink += pawr_sec_open(bench_msg, bench_len, bench_evt, BENCH_SUBEVENT, out);
+}
+
+static void bench_seal(uint32_t iter)
+{
+    uint8_t out[PAWR_SEC_MAX_MSG_LEN];
+
+    bench_sink += pawr_sec_seal(bench_plain, (uint16_t)(bench_len - PAWR_SEC_OVERHEAD), (uint16_t)iter,
+                                BENCH_SUBEVENT, (uint8_t)iter, out, sizeof(out));
+}
+
+int main(void)
+{
+    uint8_t  out[PAWR_SEC_MAX_MSG_LEN];
+    uint16_t len;
+    double   open_ns;
+    double   seal_ns;
+    uint8_t  i;
+
+    memset(bench_plain, 0xA5, sizeof(bench_plain));
+    pawr_sec_init();
+    TEST_CHECK(pawr_sec_set_key(0, bench_key) == WICED_SUCCESS);
+    pawr_sec_set_device_addr(bench_device);
+    pawr_sec_on_sync(bench_central);
+
+    printf("AES-128-CCM, software AES as built without Cryptolite, host at -O2\n");
+    printf("payload B   open ns  ns/B   seal ns  ns/B\n");
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++)
+    {
+        len = bench_sizes[i];
+        bench_central_seal(len);
+        TEST_CHECK(pawr_sec_open(bench_msg, bench_len, bench_evt, BENCH_SUBEVENT, out) == len);
+        open_ns = host_bench_ns(bench_open);
+        seal_ns = host_bench_ns(bench_seal);
+        printf("%9u %9.0f %5.1f %9.0f %5.1f\n", len, open_ns, open_ns / len, seal_ns, seal_ns / len);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name:   host_test.h
+*
+* Description: This file holds the checks shared by the host tests and the controls of the fake clock,
+*              timers and tasks in host_fakes.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "host_stubs.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* A failed check ends the test program with its location; make reports the test as failed. */
+#define TEST_CHECK(cond) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1); \
+        } \
+    } while (0)
+
+#define TEST_PASS()                     printf("PASS %s\n", __FILE__)
+
+#define HOST_MAX_TIMERS                 (16)
+#define HOST_MAX_TASKS                  (4)
+#define HOST_BENCH_MIN_NS               (200000000ULL)   /* host_bench_ns() times at least this long */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+extern uint32_t host_now_ms;                     /* xTaskGetTickCount(), one tick per ms */
+extern void   (*host_task_fn[HOST_MAX_TASKS])(void *); /* created tasks, not started */
+extern uint8_t  host_num_tasks;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void host_advance_ms(uint32_t ms);
+uint64_t host_clock_ns(void);
+double host_bench_ns(void (*p_fn)(uint32_t iter));
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,167 @@
+/******************************************************************************
+* File Name:   replay_pawr.c
+*
+* Description: This file replays a PAwR capture on the host. It loads a UART log of PCAP: lines, or the
+*              decoded stream, starts the peripheral app as on the device and feeds the recording through
+*              pawr_cap_replay(), the extended adv dispatch path of pawr_ext_adv_callback(). The exit
+*              status tells whether every response matched.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr_app.h"
+#include "pawr_capture.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define REPLAY_MARKER                   "PCAP:"
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint64_t replay_unique_id = 0x0123456789ABCDEFULL;   /* the host default of host_fakes.c */
+
+const char brcm_patch_version[] = "host";
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* the device's unique ID picks its address and response slot; replay as that device */
+uint64_t Cy_SysLib_GetUniqueId(void)
+{
+    return replay_unique_id;
+}
+
+static int replay_hex(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+    {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f'))
+    {
+        return c - 'a' + 10;
+    }
+    if ((c >= 'A') && (c <= 'F'))
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/* a UART log: the hex after every "PCAP:" marker, in order, other lines skipped; a file without
+ * markers is taken as the binary stream itself */
+static uint32_t replay_decode(uint8_t *p_file, uint32_t file_len)
+{
+    const char *p = (const char *)p_file;
+    const char *mark;
+    uint32_t    len = 0;
+    int         hi;
+    int         lo;
+
+    /* p_file is terminated; a binary stream holds a zero long before any marker could appear */
+    if (strstr(p, REPLAY_MARKER) == NULL)
+    {
+        return file_len;
+    }
+    while ((mark = strstr(p, REPLAY_MARKER)) != NULL)
+    {
+        p = mark + strlen(REPLAY_MARKER);
+        while (((hi = replay_hex(p[0])) >= 0) && ((lo = replay_hex(p[1])) >= 0))
+        {
+            /* decoded bytes never overtake the text they come from */
+            p_file[len++] = (uint8_t)((hi << 4) | lo);
+            p += 2;
+        }
+    }
+    return len;
+}
+
+int main(int argc, char **argv)
+{
+    pawr_cap_replay_result_t res;
+    FILE                     *f;
+    uint8_t                  *p_buf;
+    long                     size;
+    uint32_t                 len;
+    wiced_bool_t             ok;
+
+    if ((argc > 3) && (strcmp(argv[1], "-u") == 0))
+    {
+        replay_unique_id = strtoull(argv[2], NULL, 0);
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s [-u unique_id] capture\n"
+                        "  capture   a UART log with PCAP: lines, or the binary stream\n"
+                        "  unique_id the recording device's Cy_SysLib_GetUniqueId()\n", argv[0]);
+        return 2;
+    }
+    f = fopen(argv[1], "rb");
+    if ((f == NULL) || (fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) < 0))
+    {
+        perror(argv[1]);
+        return 2;
+    }
+    p_buf = malloc((size_t)size + 1);
+    rewind(f);
+    if ((p_buf == NULL) || (fread(p_buf, 1, (size_t)size, f) != (size_t)size))
+    {
+        perror(argv[1]);
+        return 2;
+    }
+    fclose(f);
+    p_buf[size] = 0;
+    len = replay_decode(p_buf, (uint32_t)size);
+
+    /* the app as it starts on the device, then the recording where the stack events arrive, with
+     * the host clock moved on by the recorded gaps */
+    app_bt_dispatch_init();
+    app_peripheral_init();
+    pawr_cap_enable(WICED_FALSE);
+    ok = pawr_cap_replay(p_buf, len, 1, &res);
+    printf("%s: %lu bytes of stream\n", argv[1], (unsigned long)len);
+    pawr_cap_print_result(&res);
+    free(p_buf);
+    return ok ? 0 : 1;
+}
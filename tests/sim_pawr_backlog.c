@@ -0,0 +1,260 @@
+/******************************************************************************
+* File Name:   sim_pawr_backlog.c
+*
+* Description: This file simulates sync outages of several lengths with the uplink backlog, then the
+*              drain after the sync, and prints the flash pages used, the records given up, and the drain
+*              rate.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <setjmp.h>
+#include "host_test.h"
+#include "pawr_backlog.h"
+#include "pawr_flash.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define REC_LEN                         (8)
+#define REC_PERIOD_MS                   (1000)   /* the demo's sensor sample */
+#define SECTOR_LEN                      (4096)
+#define EVT_MS                          (100)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t outage_s;                           /* unsynced, records kept */
+    uint8_t  slots;                              /* per subevent while draining, owned and granted */
+} sim_case_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {300,  1},
+    {3000, 1},
+    {3000, 4},
+    {6000, 1},
+};
+
+/* serial flash stand-in over the backlog region: erase before program, as NOR flash */
+static uint8_t  flash[PAWR_CFG_BACKLOG_FLASH_SIZE];
+static uint32_t flash_erases;
+
+/* response scheduler stand-in: records checked for order as they go out */
+static uint8_t  rsp_slots;
+static uint8_t  rsp_depth;
+static uint32_t rx_records;
+static uint16_t rx_next;
+static uint32_t rx_gaps;
+static uint32_t rx_age_max_ms;
+static uint16_t put_seq;
+
+static jmp_buf  task_idle;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+wiced_bool_t pawr_flash_init(void)
+{
+    memset(flash, 0xFF, sizeof(flash));
+    return WICED_TRUE;
+}
+
+uint32_t pawr_flash_erase_size(uint32_t addr)
+{
+    return SECTOR_LEN;
+}
+
+wiced_bool_t pawr_flash_erase(uint32_t addr, uint32_t len)
+{
+    addr -= PAWR_CFG_BACKLOG_FLASH_ADDR;
+    TEST_CHECK(addr + len <= sizeof(flash));
+    memset(&flash[addr], 0xFF, len);
+    flash_erases++;
+    return WICED_TRUE;
+}
+
+wiced_bool_t pawr_flash_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    uint32_t i;
+
+    addr -= PAWR_CFG_BACKLOG_FLASH_ADDR;
+    TEST_CHECK(addr + len <= sizeof(flash));
+    for (i = 0; i < len; i++)
+    {
+        TEST_CHECK(flash[addr + i] == 0xFF);
+    }
+    memcpy(&flash[addr], p_data, len);
+    return WICED_TRUE;
+}
+
+wiced_bool_t pawr_flash_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    addr -= PAWR_CFG_BACKLOG_FLASH_ADDR;
+    TEST_CHECK(addr + len <= sizeof(flash));
+    memcpy(p_data, &flash[addr], len);
+    return WICED_TRUE;
+}
+
+uint8_t pawr_rsp_sched_num_slots(uint8_t subevent)
+{
+    return rsp_slots;
+}
+
+void pawr_rsp_sched_get_stats(pawr_rsp_prio_t prio, pawr_rsp_sched_stats_t *p_stats)
+{
+    memset(p_stats, 0, sizeof(*p_stats));
+    p_stats->depth = rsp_depth;
+}
+
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    uint16_t off = PAWR_BACKLOG_MSG_HDR_LEN;
+    uint16_t seq;
+    uint32_t age_ms;
+
+    TEST_CHECK((data_len <= PAWR_BACKLOG_MSG_MAX_LEN) && (p_data[0] == PAWR_MSG_TYPE_BACKLOG));
+    while (off < data_len)
+    {
+        age_ms = ((uint32_t)p_data[off + 1] | ((uint32_t)p_data[off + 2] << 8)) * PAWR_BACKLOG_AGE_UNIT_MS;
+        seq    = (uint16_t)(p_data[off + 3] | (p_data[off + 4] << 8));
+        TEST_CHECK((int16_t)(seq - rx_next) >= 0);
+        rx_gaps      += (seq != rx_next);
+        rx_next       = (uint16_t)(seq + 1);
+        rx_age_max_ms = (age_ms > rx_age_max_ms) ? age_ms : rx_age_max_ms;
+        rx_records++;
+        off = (uint16_t)(off + PAWR_BACKLOG_REC_HDR_LEN + p_data[off]);
+    }
+    TEST_CHECK(off == data_len);
+    rsp_depth++;
+    return WICED_BT_SUCCESS;
+}
+
+/* the backlog task calls it only when it has nothing to move */
+void vTaskDelay(TickType_t ticks)
+{
+    longjmp(task_idle, 1);
+}
+
+static void pump(void)
+{
+    if (setjmp(task_idle) == 0)
+    {
+        host_task_fn[host_num_tasks - 1](NULL);
+    }
+}
+
+static void put(void)
+{
+    uint8_t rec[REC_LEN] = {0};
+
+    rec[0] = (uint8_t)put_seq;
+    rec[1] = (uint8_t)(put_seq >> 8);
+    TEST_CHECK(pawr_backlog_put(rec, REC_LEN));
+    put_seq++;
+}
+
+/* an outage with a record a second, then the drain on a 100 ms train of two subevents while the
+ * records keep coming */
+static void sim_run(const sim_case_t *p_case)
+{
+    pawr_backlog_stats_t stats;
+    uint32_t             erases;
+    uint32_t             t;
+    uint8_t              subevent;
+
+    host_num_tasks = 0;
+    pawr_backlog_init();
+    pawr_backlog_set_store(NULL);
+    put_seq       = 0;
+    rx_next       = 0;
+    rx_records    = 0;
+    rx_gaps       = 0;
+    rx_age_max_ms = 0;
+    erases        = flash_erases;
+
+    for (t = 0; t < p_case->outage_s; t++)
+    {
+        host_advance_ms(REC_PERIOD_MS);
+        put();
+        pump();
+    }
+    pawr_backlog_get_stats(&stats);
+    printf("%9lu %8lu %8lu %8lu %8lu",
+           (unsigned long)p_case->outage_s, (unsigned long)stats.records, (unsigned long)stats.spilled_pages,
+           (unsigned long)(flash_erases - erases), (unsigned long)stats.dropped);
+
+    rsp_slots = p_case->slots;
+    pawr_backlog_on_sync();
+    for (t = 0; pawr_backlog_depth() != 0; t++)
+    {
+        TEST_CHECK(t < 1000000);
+        if ((t % (REC_PERIOD_MS / EVT_MS)) == 0)
+        {
+            put();
+        }
+        host_advance_ms(EVT_MS);
+        for (subevent = 0; subevent < PAWR_CFG_SUBEVENT_TABLE_LEN; subevent++)
+        {
+            rsp_depth = 0;
+            pawr_backlog_drain(subevent);
+        }
+        pump();
+    }
+    pawr_backlog_get_stats(&stats);
+    TEST_CHECK((rx_records + stats.dropped == put_seq) && (rx_next == put_seq));
+    printf(" %6u %9.1f %10.1f %11lu %5lu\n", p_case->slots, t * EVT_MS / 1000.0,
+           stats.drained * 1000.0 / stats.drain_ms, (unsigned long)(rx_age_max_ms / 1000), (unsigned long)rx_gaps);
+}
+
+int main(void)
+{
+    uint8_t i;
+
+    printf("uplink backlog, %d-byte record every %d ms, %d KiB flash region, %d B RAM, %d subevents on a %d ms train\n",
+           REC_LEN, REC_PERIOD_MS, PAWR_CFG_BACKLOG_FLASH_SIZE / 1024, PAWR_CFG_BACKLOG_RAM_LEN,
+           PAWR_CFG_SUBEVENT_TABLE_LEN, EVT_MS);
+    printf("outage s  records    pages  erases  dropped  slots   drain s  records/s  max age s  gaps\n");
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        sim_run(&sim_cases[i]);
+    }
+    return 0;
+}
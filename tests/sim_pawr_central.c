@@ -0,0 +1,290 @@
+/******************************************************************************
+* File Name:   sim_pawr_central.c
+*
+* Description: This file simulates a PAwR central serving many peripherals, each a pawr_app.c instance
+*              answering in its own response slot, with loss, late responses and slot collisions, and
+*              prints the response success rate, the per-peripheral latency distribution and the memory
+*              per instance.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr_app.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SIM_EVENTS                      (2000)
+#define SIM_MAX_PERIPHERALS             (4096)
+#define SIM_MAX_SLOTS                   (64)
+#define SIM_MAX_TRIES                   (32)     /* events a request is repeated, latency histogram bins */
+#define SIM_RSP_SLOT_DELAY_US           (1250)   /* response slot delay of the train */
+#define SIM_RSP_SLOT_SPACING_US         (375)    /* response slot spacing of the train */
+#define SEED                            (0x5EED0036UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint16_t peripherals;
+    uint16_t interval_ms;                        /* periodic advertising interval */
+    uint8_t  subevents;                          /* 1 to 128 */
+    uint8_t  slots;                              /* response slots per subevent */
+    uint8_t  dl_loss_pct;                        /* requests a peripheral does not receive */
+    uint8_t  ul_loss_pct;                        /* responses the central does not receive */
+    uint16_t proc_us;                            /* request to response data set, fixed part */
+    uint16_t jitter_us;                          /* and a uniform random part */
+} sim_case_t;
+
+typedef struct
+{
+    pawr_app_ctx_t ctx;                          /* the pawr_app.c instance */
+    uint16_t       req_evt;                      /* event the current request was first sent in */
+    uint32_t       sent;
+    uint32_t       answered;
+    uint32_t       hist[SIM_MAX_TRIES];          /* answered requests by events taken */
+} sim_peripheral_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {256,  200,  16,  16, 0,  0,  500, 0},
+    {256,  200,  16,  16, 5,  5,  500, 0},
+    {256,  200,  16,  16, 5,  5,  500, 3000},
+    {2048, 1000, 128, 16, 5,  5,  500, 1000},
+    {3072, 1000, 128, 16, 5,  5,  500, 1000},
+};
+
+/* the central's requests, the payloads pawr_app.c expects in its two demo subevents */
+static const uint8_t sim_payload[PAWR_APP_NUM_SUBEVENTS][PAWR_BUF_SIZE] =
+{
+    {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f},
+#if (PAWR_APP_NUM_SUBEVENTS > 1)
+    {0x00,0x11,0x22,0x33,0x44,0x55,0x66,0x77,0x88,0x99,0xaa,0xbb,0xcc,0xdd,0xee,0xff},
+#endif
+};
+
+static sim_peripheral_t sim_per[SIM_MAX_PERIPHERALS];
+static uint32_t         rng;
+
+const char brcm_patch_version[] = "host";
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint32_t sim_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static wiced_bool_t sim_chance(uint8_t pct)
+{
+    return (sim_rand() % 100U) < pct;
+}
+
+static int sim_cmp_ms(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* latency in ms of the answered request at fraction q of a peripheral's histogram */
+static uint32_t sim_quantile_ms(const sim_case_t *p_case, const sim_peripheral_t *p_per, uint32_t offset_us, double q)
+{
+    uint32_t need = (uint32_t)(q * p_per->answered + 0.999);
+    uint32_t sum  = 0;
+    uint8_t  k;
+
+    for (k = 0; k < SIM_MAX_TRIES; k++)
+    {
+        sum += p_per->hist[k];
+        if (sum >= need)
+        {
+            break;
+        }
+    }
+    return (uint32_t)k * p_case->interval_ms + (offset_us + 500U) / 1000U;
+}
+
+/* a latency in the last histogram bin is a lower bound */
+static const char *sim_fmt_ms(const sim_case_t *p_case, uint32_t ms, char *p_buf)
+{
+    sprintf(p_buf, "%s%lu", (ms >= (SIM_MAX_TRIES - 1U) * p_case->interval_ms) ? ">" : "", (unsigned long)ms);
+    return p_buf;
+}
+
+/* one periodic event: every subevent carries a request to its peripherals, each answers in its
+ * own slot; two answers in one slot collide and neither is received */
+static void sim_event(const sim_case_t *p_case, uint16_t evt, uint32_t *p_late, uint32_t *p_collided)
+{
+    static int16_t owner[SIM_MAX_SLOTS];
+    uint8_t        rsp[PAWR_BUF_SIZE];
+    uint8_t        rsp_len;
+    uint8_t        logical;
+    uint32_t       proc_us;
+    uint16_t       p;
+    uint8_t        se;
+    uint8_t        slot;
+
+    for (se = 0; se < p_case->subevents; se++)
+    {
+        memset(owner, 0xFF, sizeof(owner[0]) * p_case->slots);
+        logical = (uint8_t)(SUBEVT0 + (se % PAWR_APP_NUM_SUBEVENTS));
+        for (p = se; p < p_case->peripherals; p = (uint16_t)(p + p_case->subevents))
+        {
+            sim_per[p].sent++;
+            if (sim_chance(p_case->dl_loss_pct))
+            {
+                continue;
+            }
+            rsp_len = app_pawr_handle_request(&sim_per[p].ctx, sim_payload[logical - SUBEVT0], PAWR_BUF_SIZE, logical, rsp);
+            TEST_CHECK((rsp_len == PAWR_BUF_SIZE) && (memcmp(rsp, sim_payload[logical - SUBEVT0], PAWR_BUF_SIZE) == 0));
+            slot    = sim_per[p].ctx.rsp_slot;
+            proc_us = p_case->proc_us + ((p_case->jitter_us != 0) ? (sim_rand() % p_case->jitter_us) : 0);
+            if (proc_us > SIM_RSP_SLOT_DELAY_US + (uint32_t)slot * SIM_RSP_SLOT_SPACING_US)
+            {
+                (*p_late)++;
+                continue;
+            }
+            if (owner[slot] == -1)
+            {
+                owner[slot] = (int16_t)p;
+            }
+            else
+            {
+                if (owner[slot] >= 0)
+                {
+                    (*p_collided)++;
+                }
+                (*p_collided)++;
+                owner[slot] = -2;
+            }
+        }
+        for (slot = 0; slot < p_case->slots; slot++)
+        {
+            if ((owner[slot] < 0) || sim_chance(p_case->ul_loss_pct))
+            {
+                continue;
+            }
+            p = (uint16_t)owner[slot];
+            sim_per[p].answered++;
+            sim_per[p].hist[((uint16_t)(evt - sim_per[p].req_evt) < SIM_MAX_TRIES) ?
+                            (uint16_t)(evt - sim_per[p].req_evt) : (SIM_MAX_TRIES - 1)]++;
+            sim_per[p].req_evt = (uint16_t)(evt + 1);
+        }
+    }
+}
+
+static void sim_run(const sim_case_t *p_case)
+{
+    static uint32_t p50[SIM_MAX_PERIPHERALS];
+    static uint32_t p99[SIM_MAX_PERIPHERALS];
+    uint64_t        sent     = 0;
+    uint64_t        answered = 0;
+    uint32_t        late     = 0;
+    uint32_t        collided = 0;
+    uint32_t        offset_us;
+    uint32_t        worst_pct = 100;
+    uint16_t        evt;
+    uint16_t        p;
+    char            buf[3][16];
+
+    TEST_CHECK((p_case->peripherals <= SIM_MAX_PERIPHERALS) && (p_case->slots <= SIM_MAX_SLOTS));
+    TEST_CHECK((uint32_t)p_case->subevents * (SIM_RSP_SLOT_DELAY_US + p_case->slots * SIM_RSP_SLOT_SPACING_US) <=
+               p_case->interval_ms * 1000U);
+    rng = SEED;
+    memset(sim_per, 0, sizeof(sim_per));
+    for (p = 0; p < p_case->peripherals; p++)
+    {
+        /* peripheral p listens in subevent p % subevents and answers in slot (p / subevents) % slots;
+         * beyond subevents * slots peripherals share a slot */
+        app_pawr_ctx_init(&sim_per[p].ctx, (uint8_t)((p / p_case->subevents) % p_case->slots));
+    }
+    for (evt = 0; evt < SIM_EVENTS; evt++)
+    {
+        sim_event(p_case, evt, &late, &collided);
+    }
+
+    for (p = 0; p < p_case->peripherals; p++)
+    {
+        sent     += sim_per[p].sent;
+        answered += sim_per[p].answered;
+        if (sim_per[p].answered * 100U / sim_per[p].sent < worst_pct)
+        {
+            worst_pct = sim_per[p].answered * 100U / sim_per[p].sent;
+        }
+        /* from the request in the subevent to the answer in the peripheral's slot */
+        offset_us = SIM_RSP_SLOT_DELAY_US + (uint32_t)sim_per[p].ctx.rsp_slot * SIM_RSP_SLOT_SPACING_US;
+        p50[p] = (sim_per[p].answered != 0) ? sim_quantile_ms(p_case, &sim_per[p], offset_us, 0.50) : UINT32_MAX;
+        p99[p] = (sim_per[p].answered != 0) ? sim_quantile_ms(p_case, &sim_per[p], offset_us, 0.99) : UINT32_MAX;
+    }
+    qsort(p50, p_case->peripherals, sizeof(p50[0]), sim_cmp_ms);
+    qsort(p99, p_case->peripherals, sizeof(p99[0]), sim_cmp_ms);
+
+    printf("%5u %5u %4u %5u %5u/%-2u %6u+%-5u %7.2f %5lu %8lu %8lu %8s %8s %8s\n",
+           p_case->peripherals, p_case->interval_ms, p_case->subevents, p_case->slots,
+           p_case->dl_loss_pct, p_case->ul_loss_pct, p_case->proc_us, p_case->jitter_us,
+           answered * 100.0 / sent, (unsigned long)worst_pct,
+           (unsigned long)late, (unsigned long)collided,
+           sim_fmt_ms(p_case, p50[p_case->peripherals / 2], buf[0]),
+           sim_fmt_ms(p_case, p99[p_case->peripherals / 2], buf[1]),
+           sim_fmt_ms(p_case, p99[p_case->peripherals - 1], buf[2]));
+}
+
+int main(void)
+{
+    uint8_t i;
+
+    printf("central load, %d events a case, slot delay %d us, slot spacing %d us, seed 0x%08lX\n",
+           SIM_EVENTS, SIM_RSP_SLOT_DELAY_US, SIM_RSP_SLOT_SPACING_US, (unsigned long)SEED);
+    printf("app state per peripheral instance: %u bytes\n", (unsigned int)sizeof(pawr_app_ctx_t));
+    printf("latency per peripheral, from the first send of a request to its answer; median of the p50s and\n"
+           "the p99s over the peripherals, and the worst p99\n");
+    printf("  per    ms   se slots loss %% proc+jit us success %% worst %%    late collided   p50 ms   p99 ms  p99 max\n");
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        sim_run(&sim_cases[i]);
+    }
+    return 0;
+}
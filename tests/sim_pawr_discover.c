@@ -0,0 +1,278 @@
+/******************************************************************************
+* File Name:   sim_pawr_discover.c
+*
+* Description: This file simulates the discovery mode among many advertisers, a few of them centrals of
+*              the network, with random positions, loads, fading and collisions. It gives the time to the
+*              choice, how often the best-ranked central is chosen and the reports parsed.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_discover.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define MAX_ADVERTISERS                 (300)
+#define TRIALS                          (200)    /* discoveries a case, each with new positions */
+#define SID                             (5)
+#define CENTRAL_ADV_MS                  (100)    /* extended advertising of the centrals */
+#define OTHER_ADV_MIN_MS                (20)     /* other advertisers, uniform in between */
+#define OTHER_ADV_MAX_MS                (1000)
+#define ADV_DELAY_MS                    (10)     /* advDelay, random per event */
+#define PACKET_MS                       (0.4)    /* on air, a collision window is twice that */
+#define PERIODIC_SHARE                  (0.2)    /* other advertisers with a periodic train, of other networks */
+#define RSSI_NEAR_DBM                   (-45.0)  /* mean RSSI, uniform in between */
+#define RSSI_FAR_DBM                    (-95.0)
+#define SENSITIVITY_DBM                 (-94.0)  /* 1M PHY, as sim_pawr_link */
+#define PER_SLOPE_DB                    (1.0)
+#define TRIAL_MAX_MS                    (30000)
+#define SEED                            (0x5EED0047UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint16_t advertisers;                        /* all of them, centrals included */
+    uint8_t  centrals;                           /* of this network */
+} sim_case_t;
+
+typedef struct
+{
+    double   rssi;                               /* mean, dBm */
+    uint8_t  load;                               /* percent, centrals only */
+    uint16_t interval_ms;
+    uint32_t next_ms;
+    wiced_bool_t central;                        /* else of another network, or without a train */
+    wiced_bool_t periodic;
+} sim_adv_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {10,  1},
+    {10,  3},
+    {50,  5},
+    {100, 10},
+    {300, 1},
+    {300, 20},
+};
+
+static sim_adv_t                           sim_adv[MAX_ADVERTISERS];
+static wiced_ble_padv_create_sync_params_t sim_sync;
+static wiced_bool_t                        sim_chosen;
+static uint32_t                            rng;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static double sim_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng + 0.5) / 4294967296.0;
+}
+
+static wiced_bool_t sim_received(double rssi)
+{
+    return (sim_uniform() * (1.0 + exp(-(rssi - SENSITIVITY_DBM) / PER_SLOPE_DB)) < 1.0) ? WICED_TRUE : WICED_FALSE;
+}
+
+/* the ranking of pawr_discover.c on the mean RSSI */
+static double sim_score(uint16_t i)
+{
+    return sim_adv[i].rssi - (sim_adv[i].load * PAWR_DISC_LOAD_DB) / 100.0;
+}
+
+void pawr_scan_for_pawr_network(void)
+{
+    memset(&sim_sync, 0, sizeof(sim_sync));
+    sim_chosen = pawr_disc_prepare_sync(&sim_sync);
+}
+
+/* one advertising event of advertiser i: its report, unless it collides or fades */
+static void sim_report(uint16_t i, double p_clear)
+{
+    wiced_ble_ext_scan_results_t rpt;
+    double                       rssi = sim_adv[i].rssi + 10.0 * log10(-log(sim_uniform()));
+    uint8_t                      ad[] = {2, 0x01, 0x06,
+                                         1 + PAWR_DISC_SVC_DATA_LEN, PAWR_DISC_AD_SERVICE_DATA,
+                                         PAWR_CFG_DISC_UUID & 0xFF, PAWR_CFG_DISC_UUID >> 8,
+                                         PAWR_CFG_NETWORK_ID & 0xFF, PAWR_CFG_NETWORK_ID >> 8, sim_adv[i].load};
+
+    if (!sim_received(rssi) || (sim_uniform() >= p_clear))
+    {
+        return;
+    }
+    if (!sim_adv[i].central)
+    {
+        ad[7] = (uint8_t)((PAWR_CFG_NETWORK_ID + 1) & 0xFF);
+        ad[8] = (uint8_t)((PAWR_CFG_NETWORK_ID + 1) >> 8);
+    }
+    memset(&rpt, 0, sizeof(rpt));
+    rpt.bd_addr[0]            = 0xC0;
+    rpt.bd_addr[4]            = (uint8_t)(i >> 8);
+    rpt.bd_addr[5]            = (uint8_t)i;
+    rpt.adv_sid               = SID;
+    rpt.rssi                  = (int8_t)lrint(rssi);
+    rpt.periodic_adv_interval = sim_adv[i].periodic ? 80 : 0;
+    rpt.data_length           = sizeof(ad);
+    rpt.p_data                = ad;
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, &rpt);
+}
+
+/* one discovery among new positions and loads: the time to the choice and its rank */
+static uint32_t sim_trial(const sim_case_t *p_case, double p_clear, double *p_loss_db)
+{
+    wiced_ble_padv_sync_established_event_data_t ps;
+    uint32_t                                     start = host_now_ms;
+    uint16_t                                     best  = 0;
+    uint16_t                                     chosen;
+    uint16_t                                     i;
+
+    for (i = 0; i < p_case->advertisers; i++)
+    {
+        sim_adv[i].central     = (i < p_case->centrals) ? WICED_TRUE : WICED_FALSE;
+        sim_adv[i].rssi        = RSSI_FAR_DBM + (RSSI_NEAR_DBM - RSSI_FAR_DBM) * sim_uniform();
+        sim_adv[i].periodic    = sim_adv[i].central || (sim_uniform() < PERIODIC_SHARE);
+        sim_adv[i].load        = sim_adv[i].central ? (uint8_t)(sim_uniform() * 101.0) : 0;
+        sim_adv[i].interval_ms = sim_adv[i].central ? CENTRAL_ADV_MS :
+                                 (uint16_t)(OTHER_ADV_MIN_MS + (OTHER_ADV_MAX_MS - OTHER_ADV_MIN_MS) * sim_uniform());
+        sim_adv[i].next_ms     = start + (uint32_t)(sim_adv[i].interval_ms * sim_uniform());
+        if (sim_adv[i].central && (sim_score(i) > sim_score(best)))
+        {
+            best = i;
+        }
+    }
+
+    sim_chosen = WICED_FALSE;
+    pawr_scan_for_pawr_network();
+    while (!sim_chosen && ((host_now_ms - start) < TRIAL_MAX_MS))
+    {
+        for (i = 0; i < p_case->advertisers; i++)
+        {
+            if (sim_adv[i].next_ms == host_now_ms)
+            {
+                sim_report(i, p_clear);
+                sim_adv[i].next_ms += sim_adv[i].interval_ms + (uint32_t)(ADV_DELAY_MS * sim_uniform());
+            }
+        }
+        host_advance_ms(1);
+    }
+
+    chosen     = (uint16_t)((sim_sync.adv_addr[4] << 8) | sim_sync.adv_addr[5]);
+    *p_loss_db = sim_chosen ? sim_score(best) - sim_score(chosen) : INFINITY;
+    memset(&ps, 0, sizeof(ps));
+    memcpy(ps.adv_addr, sim_sync.adv_addr, BD_ADDR_LEN);
+    ps.adv_sid = SID;
+    pawr_disc_on_sync(&ps);
+    return host_now_ms - start;
+}
+
+int main(void)
+{
+    const sim_case_t *p_case;
+    double            p_clear;
+    double            loss_db;
+    double            loss_sum;
+    double            loss_max;
+    uint32_t          ms;
+    uint32_t          ms_sum;
+    uint32_t          ms_max;
+    uint32_t          n_best;
+    uint32_t          reports;
+    pawr_disc_stats_t stats;
+    uint16_t          t;
+    uint8_t           c;
+    int               out;
+    int               null_fd = open("/dev/null", O_WRONLY);
+
+    app_bt_dispatch_init();
+    pawr_disc_init();
+    printf("discovery among advertisers, %d trials a case, centrals every %d ms, others every %d-%d ms, "
+           "mean RSSI %.0f to %.0f dBm, Rayleigh fading, seed 0x%08lX\n", TRIALS, CENTRAL_ADV_MS,
+           OTHER_ADV_MIN_MS, OTHER_ADV_MAX_MS, RSSI_FAR_DBM, RSSI_NEAR_DBM, (unsigned long)SEED);
+    printf("best: the choice is the central of the highest score on mean RSSI and load; loss: the score given "
+           "up otherwise\n");
+    printf("advertisers  centrals  clear %%  avg ms  max ms  best %%  loss avg dB  loss max dB  reports/choice\n");
+    rng = SEED;
+    for (c = 0; c < sizeof(sim_cases) / sizeof(sim_cases[0]); c++)
+    {
+        p_case   = &sim_cases[c];
+        /* a report survives when no other packet starts within twice its airtime on its channel */
+        p_clear  = exp(-p_case->advertisers * 2.0 * PACKET_MS / ((OTHER_ADV_MIN_MS + OTHER_ADV_MAX_MS) / 2.0));
+        ms_sum   = 0;
+        ms_max   = 0;
+        n_best   = 0;
+        loss_sum = 0.0;
+        loss_max = 0.0;
+        pawr_disc_get_stats(&stats);
+        reports  = stats.reports;
+
+        /* the module logs every choice; keep the table readable */
+        fflush(stdout);
+        out = dup(STDOUT_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        for (t = 0; t < TRIALS; t++)
+        {
+            ms        = sim_trial(p_case, p_clear, &loss_db);
+            ms_sum   += ms;
+            ms_max    = (ms > ms_max) ? ms : ms_max;
+            n_best   += (loss_db <= 0.0) ? 1 : 0;
+            loss_sum += (loss_db > 0.0) ? loss_db : 0.0;
+            loss_max  = (loss_db > loss_max) ? loss_db : loss_max;
+        }
+        fflush(stdout);
+        dup2(out, STDOUT_FILENO);
+        close(out);
+
+        pawr_disc_get_stats(&stats);
+        printf("%11u %9u %8.0f %7lu %7lu %7.1f %12.1f %12.1f %15.1f\n", p_case->advertisers, p_case->centrals,
+               p_clear * 100.0, (unsigned long)(ms_sum / TRIALS), (unsigned long)ms_max, n_best * 100.0 / TRIALS,
+               (n_best < TRIALS) ? loss_sum / (TRIALS - n_best) : 0.0, loss_max,
+               (double)(stats.reports - reports) / TRIALS);
+    }
+    close(null_fd);
+    return 0;
+}
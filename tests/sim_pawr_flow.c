@@ -0,0 +1,296 @@
+/******************************************************************************
+* File Name:   sim_pawr_flow.c
+*
+* Description: This file simulates bursty uplink records drained through the backlog, with and without
+*              slot grants from the central, and prints the end-to-end latency of the records and the
+*              slots used.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <setjmp.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_backlog.h"
+#include "pawr_flash.h"
+#include "pawr_flow.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define EVT_MS                          (100)
+#define SIM_EVENTS                      (6000)   /* 10 minutes */
+#define BURST_EVENTS                    (100)    /* a burst every 10 s */
+#define SAMPLE_EVENTS                   (10)     /* and a sample every second in between */
+#define GRANT_MAX                       (3)      /* extra slots the central lends per subevent */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint16_t     burst;                          /* records per burst */
+    uint8_t      rec_len;
+    wiced_bool_t grants;                         /* the central grants what the field asks for */
+} sim_case_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {60,  24, WICED_FALSE},
+    {60,  24, WICED_TRUE},
+    {200, 8,  WICED_FALSE},
+    {200, 8,  WICED_TRUE},
+};
+
+/* serial flash stand-in over the backlog region */
+static uint8_t  flash[PAWR_CFG_BACKLOG_FLASH_SIZE];
+
+/* the central: records arriving, and the last slot request it read */
+static uint32_t put_ms[UINT16_MAX + 1];
+static uint16_t put_seq;
+static uint16_t rx_next;
+static uint32_t rx_records;
+static uint32_t rx_gaps;
+static uint64_t rx_lat_sum;
+static uint32_t rx_lat_max;
+static uint8_t  rx_req;
+static uint32_t rx_slots;
+
+static jmp_buf  task_idle;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+wiced_bool_t pawr_flash_init(void)
+{
+    memset(flash, 0xFF, sizeof(flash));
+    return WICED_TRUE;
+}
+
+uint32_t pawr_flash_erase_size(uint32_t addr)
+{
+    return 4096;
+}
+
+wiced_bool_t pawr_flash_erase(uint32_t addr, uint32_t len)
+{
+    memset(&flash[addr - PAWR_CFG_BACKLOG_FLASH_ADDR], 0xFF, len);
+    return WICED_TRUE;
+}
+
+wiced_bool_t pawr_flash_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    memcpy(&flash[addr - PAWR_CFG_BACKLOG_FLASH_ADDR], p_data, len);
+    return WICED_TRUE;
+}
+
+wiced_bool_t pawr_flash_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    memcpy(p_data, &flash[addr - PAWR_CFG_BACKLOG_FLASH_ADDR], len);
+    return WICED_TRUE;
+}
+
+/* the PAwR layer puts the field in front; the central reads it and the records behind it */
+wiced_bt_dev_status_t pawr_snd_se_rsp_central(uint16_t sync_handle, uint16_t evt_counter, uint8_t req_subevent,
+                                              uint8_t rsp_subevent, uint8_t rsp_slot, uint8_t rsp_data_len,
+                                              uint8_t *p_data)
+{
+    uint8_t  field[PAWR_FLOW_HDR_LEN];
+    uint16_t off = PAWR_BACKLOG_MSG_HDR_LEN;
+    uint16_t seq;
+    uint32_t lat_ms;
+
+    if (pawr_flow_get_field(field) != 0)
+    {
+        rx_req = field[4];
+    }
+    TEST_CHECK((rsp_data_len <= PAWR_RSP_MAX_DATA_LEN - PAWR_FLOW_HDR_LEN) && (p_data[0] == PAWR_MSG_TYPE_BACKLOG));
+    while (off < rsp_data_len)
+    {
+        seq         = (uint16_t)(p_data[off + 3] | (p_data[off + 4] << 8));
+        rx_gaps    += (seq != rx_next);
+        rx_next     = (uint16_t)(seq + 1);
+        lat_ms      = host_now_ms - put_ms[seq];
+        rx_lat_sum += lat_ms;
+        rx_lat_max  = (lat_ms > rx_lat_max) ? lat_ms : rx_lat_max;
+        rx_records++;
+        off = (uint16_t)(off + PAWR_BACKLOG_REC_HDR_LEN + p_data[off]);
+    }
+    rx_slots++;
+    return WICED_BT_SUCCESS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    longjmp(task_idle, 1);
+}
+
+static void pump(void)
+{
+    if (setjmp(task_idle) == 0)
+    {
+        host_task_fn[host_num_tasks - 1](NULL);
+    }
+}
+
+static void put(uint8_t rec_len)
+{
+    uint8_t rec[PAWR_BACKLOG_MAX_REC_LEN] = {0};
+
+    rec[0]          = (uint8_t)put_seq;
+    rec[1]          = (uint8_t)(put_seq >> 8);
+    put_ms[put_seq] = host_now_ms;
+    TEST_CHECK(pawr_backlog_put(rec, rec_len));
+    put_seq++;
+}
+
+/* the central answers a request in the next event: it raises the grants behind the owned slot,
+ * up to GRANT_MAX a subevent, subevent 0 first */
+static void grant(void)
+{
+    uint8_t msg[PAWR_FLOW_GRANT_HDR_LEN + PAWR_FLOW_GRANT_ENTRY_LEN * PAWR_CFG_SUBEVENT_TABLE_LEN];
+    uint8_t want = rx_req;
+    uint8_t held;
+    uint8_t n;
+    uint8_t subevent;
+
+    msg[0] = PAWR_MSG_TYPE_FLOW;
+    msg[1] = PAWR_CFG_SUBEVENT_TABLE_LEN;
+    for (subevent = 0; subevent < PAWR_CFG_SUBEVENT_TABLE_LEN; subevent++)
+    {
+        held  = (uint8_t)(pawr_rsp_sched_num_slots(subevent) - 1);
+        n     = (want > GRANT_MAX - held) ? (uint8_t)(GRANT_MAX - held) : want;
+        want -= n;
+        msg[PAWR_FLOW_GRANT_HDR_LEN + PAWR_FLOW_GRANT_ENTRY_LEN * subevent]     = subevent;
+        msg[PAWR_FLOW_GRANT_HDR_LEN + PAWR_FLOW_GRANT_ENTRY_LEN * subevent + 1] = 1;
+        msg[PAWR_FLOW_GRANT_HDR_LEN + PAWR_FLOW_GRANT_ENTRY_LEN * subevent + 2] = (uint8_t)(held + n);
+    }
+    pawr_flow_on_msg(msg, sizeof(msg));
+    rx_req = 0;
+}
+
+static void sim_run(const sim_case_t *p_case)
+{
+    wiced_ble_padv_sync_established_event_data_t ps;
+    pawr_flow_stats_t                            stats;
+    const uint8_t                                flow_on[] = {PAWR_MSG_TYPE_FLOW, 0};
+    uint32_t                                     peak      = 0;
+    uint32_t                                     slots;
+    uint16_t                                     evt;
+    uint16_t                                     b;
+    uint8_t                                      subevent;
+
+    host_num_tasks = 0;
+    pawr_rsp_sched_init();
+    pawr_backlog_init();
+    pawr_backlog_set_store(NULL);
+    pawr_flow_init();
+    for (subevent = 0; subevent < PAWR_CFG_SUBEVENT_TABLE_LEN; subevent++)
+    {
+        pawr_rsp_sched_set_slots(subevent, 0, 1);
+    }
+    memset(&ps, 0, sizeof(ps));
+    ps.periodic_adv_int = EVT_MS * 4 / 5;
+    pawr_rsp_sched_reset_timebase();
+    pawr_backlog_on_sync();
+    pawr_flow_on_sync(&ps);
+    pawr_flow_on_msg(flow_on, sizeof(flow_on));
+    put_seq    = 0;
+    rx_next    = 0;
+    rx_records = 0;
+    rx_gaps    = 0;
+    rx_lat_sum = 0;
+    rx_lat_max = 0;
+    rx_req     = 0;
+    rx_slots   = 0;
+
+    for (evt = 0; evt < SIM_EVENTS; evt++)
+    {
+        host_advance_ms(EVT_MS);
+        if ((evt % BURST_EVENTS) == 0)
+        {
+            /* the producer yields to the backlog task between records: a burst put at once
+             * overflows the RAM queue to the task after a few hundred bytes */
+            for (b = 0; b < p_case->burst; b++)
+            {
+                put(p_case->rec_len);
+                pump();
+            }
+        }
+        else if ((evt % SAMPLE_EVENTS) == 0)
+        {
+            put(p_case->rec_len);
+        }
+        pump();
+        if (p_case->grants && (rx_req != 0))
+        {
+            grant();
+        }
+        slots = rx_slots;
+        for (subevent = 0; subevent < PAWR_CFG_SUBEVENT_TABLE_LEN; subevent++)
+        {
+            pawr_backlog_drain(subevent);
+            pawr_flow_update(evt);
+            pawr_rsp_sched_service(1, evt, subevent);
+        }
+        peak = ((rx_slots - slots) > peak) ? (rx_slots - slots) : peak;
+        pump();
+    }
+    TEST_CHECK(rx_gaps == 0);
+    pawr_flow_get_stats(&stats);
+    printf("%6u %7u %7s %6lu/%-6u %10lu %10lu %8lu %8lu %8lu\n",
+           p_case->burst, p_case->rec_len, p_case->grants ? "yes" : "no",
+           (unsigned long)rx_records, put_seq,
+           (unsigned long)((rx_records != 0) ? (rx_lat_sum / rx_records) : 0), (unsigned long)rx_lat_max,
+           (unsigned long)peak, (unsigned long)rx_slots, (unsigned long)stats.grants);
+}
+
+int main(void)
+{
+    uint8_t i;
+
+    printf("uplink flow control, %d ms train, %d subevents of 1 owned slot, %d s, a burst every %d s and a record every %d s\n",
+           EVT_MS, PAWR_CFG_SUBEVENT_TABLE_LEN, SIM_EVENTS * EVT_MS / 1000, BURST_EVENTS * EVT_MS / 1000,
+           SAMPLE_EVENTS * EVT_MS / 1000);
+    printf(" burst rec len  grants  records/put  lat avg ms lat max ms peak/evt    slots   grants\n");
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        sim_run(&sim_cases[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+/******************************************************************************
+* File Name:   sim_pawr_link.c
+*
+* Description: This file simulates the response TX power of the link quality estimator on synthetic
+*              fading traces: Rician and Rayleigh fading over several path losses and a walk away from
+*              the central. It gives the response success rate and the energy per successful response
+*              against fixed TX powers.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr_link.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SIM_EVENTS                      (20000)
+#define CENTRAL_TX_DBM                  (0)
+#define SENSITIVITY_DBM                 (-94.0)  /* 1M PHY, 30.8% PER at 37 B */
+#define PER_SLOPE_DB                    (1.0)    /* PER falls by e per dB above the sensitivity */
+#define SUPPLY_V                        (3.0)
+#define RX_MA                           (5.5)    /* radio receiving */
+#define RX_US                           (400)    /* listen window with ramp, per event */
+#define RSP_US                          (360)    /* response on air with ramp, 16 B at 1M PHY */
+#define SEED                            (0x5EED0037UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    double      path_loss_db;                    /* mean path loss, both ways */
+    double      ramp_db;                         /* path loss added linearly over the run, a walk away */
+    double      rician_k;                        /* line of sight to scattered power, 0 for Rayleigh */
+    double      rho;                             /* event-to-event fading correlation, 0 with channel hopping */
+} sim_trace_t;
+
+typedef struct
+{
+    const char *name;
+    int8_t      fixed_dbm;                       /* response TX power, or adaptive */
+    wiced_bool_t adaptive;
+} sim_policy_t;
+
+static const sim_trace_t sim_traces[] =
+{
+    {"close, los",   45.0, 0.0,  10.0, 0.9},
+    {"near, los",    60.0, 0.0,  10.0, 0.9},
+    {"near, nlos",   60.0, 0.0,  0.0,  0.0},
+    {"mid, los",     75.0, 0.0,  10.0, 0.9},
+    {"mid, nlos",    75.0, 0.0,  0.0,  0.0},
+    {"far, los",     86.0, 0.0,  10.0, 0.9},
+    {"far, nlos",    86.0, 0.0,  0.0,  0.0},
+    {"walk away",    55.0, 40.0, 3.0,  0.5},
+};
+
+static const sim_policy_t sim_policies[] =
+{
+    {"0 dBm",    PAWR_LINK_TX_POWER_DEFAULT, WICED_FALSE},
+    {"max",      PAWR_LINK_TX_POWER_MAX,     WICED_FALSE},
+    {"adaptive", 0,                          WICED_TRUE},
+};
+
+/* TX current by power, typical of a BLE SoC at 3 V; replace with the datasheet figures */
+static const struct
+{
+    int8_t dbm;
+    double ma;
+} sim_tx_current[] =
+{
+    {-16, 3.4}, {-12, 3.7}, {-8, 4.1}, {-4, 4.7}, {0, 5.6}, {2, 6.4}, {4, 7.6},
+};
+
+static int8_t   sim_tx_dbm;
+static uint32_t sim_weak_events;
+static uint32_t rng;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static double sim_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng + 0.5) / 4294967296.0;
+}
+
+static double sim_gauss(void)
+{
+    return sqrt(-2.0 * log(sim_uniform())) * cos(2.0 * M_PI * sim_uniform());
+}
+
+static wiced_bool_t sim_received(double rssi)
+{
+    return (sim_uniform() * (1.0 + exp(-(rssi - SENSITIVITY_DBM) / PER_SLOPE_DB)) < 1.0) ? WICED_TRUE : WICED_FALSE;
+}
+
+/* linear between the table points */
+static double sim_tx_ma(int8_t dbm)
+{
+    uint8_t i;
+
+    for (i = 1; i < sizeof(sim_tx_current) / sizeof(sim_tx_current[0]) - 1; i++)
+    {
+        if (dbm < sim_tx_current[i].dbm)
+        {
+            break;
+        }
+    }
+    return sim_tx_current[i - 1].ma + (sim_tx_current[i].ma - sim_tx_current[i - 1].ma) *
+           (dbm - sim_tx_current[i - 1].dbm) / (sim_tx_current[i].dbm - sim_tx_current[i - 1].dbm);
+}
+
+static void sim_on_tx_power(uint8_t subevent, int8_t tx_power)
+{
+    sim_tx_dbm = tx_power;
+}
+
+static void sim_on_weak(uint8_t subevent, wiced_bool_t weak, const pawr_link_info_t *p_info)
+{
+    sim_weak_events += weak ? 1 : 0;
+}
+
+/* one trace under one policy: every event the central sends a request; the peripheral answers
+ * the ones it receives, the central receives the answer over the same reciprocal channel */
+static void sim_run(const sim_trace_t *p_trace, const sim_policy_t *p_policy, double *p_success, double *p_tx_dbm,
+                    double *p_uj)
+{
+    double   los = sqrt(p_trace->rician_k / (p_trace->rician_k + 1.0));
+    double   sc  = sqrt(1.0 / (2.0 * (p_trace->rician_k + 1.0)));
+    double   re;
+    double   im;
+    double   inn = sqrt(1.0 - p_trace->rho * p_trace->rho);
+    double   fade_db;
+    double   pl;
+    double   uj  = 0.0;
+    double   dbm = 0.0;
+    uint32_t sent = 0;
+    uint32_t ok  = 0;
+    uint32_t evt;
+
+    rng = SEED;
+    re  = sim_gauss();
+    im  = sim_gauss();
+    pawr_link_init();
+    pawr_link_reg_tx_power_cb(sim_on_tx_power);
+    pawr_link_reg_weak_cb(sim_on_weak);
+    sim_tx_dbm      = p_policy->fixed_dbm;
+    sim_weak_events = 0;
+    for (evt = 0; evt < SIM_EVENTS; evt++)
+    {
+        /* AR(1) scattered component, unit mean power with the line of sight one */
+        re      = p_trace->rho * re + inn * sim_gauss();
+        im      = p_trace->rho * im + inn * sim_gauss();
+        fade_db = 10.0 * log10((los + sc * re) * (los + sc * re) + (sc * im) * (sc * im));
+        pl      = p_trace->path_loss_db + p_trace->ramp_db * evt / SIM_EVENTS;
+
+        uj += SUPPLY_V * RX_MA * RX_US / 1000.0;
+        if (!sim_received(CENTRAL_TX_DBM - pl + fade_db))
+        {
+            continue;
+        }
+        if (p_policy->adaptive)
+        {
+            pawr_link_on_report(0, (uint16_t)evt, (int8_t)lrint(CENTRAL_TX_DBM - pl + fade_db), 0);
+        }
+        uj  += SUPPLY_V * sim_tx_ma(sim_tx_dbm) * RSP_US / 1000.0;
+        dbm += sim_tx_dbm;
+        sent++;
+        if (sim_received(sim_tx_dbm - pl + fade_db))
+        {
+            ok++;
+        }
+    }
+    *p_success = ok * 100.0 / SIM_EVENTS;
+    *p_tx_dbm  = (sent != 0) ? dbm / sent : 0.0;
+    *p_uj      = (ok != 0) ? uj / ok : INFINITY;
+}
+
+int main(void)
+{
+    double  success;
+    double  tx_dbm;
+    double  uj;
+    double  base_uj;
+    uint8_t t;
+    uint8_t p;
+
+    printf("response TX power on fading traces, %d events a trace, central at %d dBm, sensitivity %.0f dBm, "
+           "seed 0x%08lX\n", SIM_EVENTS, CENTRAL_TX_DBM, SENSITIVITY_DBM, (unsigned long)SEED);
+    printf("energy per successful response: listening every event, %.1f mA for %d us, and the response, "
+           "%d us at the TX current of its power, at %.1f V\n", RX_MA, RX_US, RSP_US, SUPPLY_V);
+    printf("trace        loss dB  policy    success %%  avg TX dBm  uJ/response  vs 0 dBm  weak\n");
+    for (t = 0; t < sizeof(sim_traces) / sizeof(sim_traces[0]); t++)
+    {
+        base_uj = 0.0;
+        for (p = 0; p < sizeof(sim_policies) / sizeof(sim_policies[0]); p++)
+        {
+            sim_run(&sim_traces[t], &sim_policies[p], &success, &tx_dbm, &uj);
+            if (p == 0)
+            {
+                base_uj = uj;
+            }
+            printf("%-12s %7.0f  %-9s %9.1f %11.1f %12.1f %8.2f %5lu\n",
+                   (p == 0) ? sim_traces[t].name : "", sim_traces[t].path_loss_db, sim_policies[p].name,
+                   success, tx_dbm, uj, uj / base_uj, (unsigned long)sim_weak_events);
+        }
+    }
+    return 0;
+}
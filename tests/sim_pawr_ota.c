@@ -0,0 +1,340 @@
+/******************************************************************************
+* File Name:   sim_pawr_ota.c
+*
+* Description: This file simulates a firmware update over PAwR through pawr_ota.c: a central that sends
+*              every chunk once, then the chunks the status responses name, over a lossy downlink and
+*              uplink. It gives the update time and the throughput in bytes per second and per periodic
+*              advertising interval.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <setjmp.h>
+#include "host_test.h"
+#include "pawr_ota.h"
+#include "pawr_flash.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define IMAGE_LEN                       (64 * 1024)
+#define NUM_CHUNKS                      ((IMAGE_LEN + PAWR_OTA_CHUNK_SIZE - 1) / PAWR_OTA_CHUNK_SIZE)
+#define SE                              (PAWR_CFG_OTA_SUBEVENT)
+#define MAX_EVENTS                      (100000)
+#define SEED                            (0x5EED0039UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint16_t interval_ms;                        /* periodic advertising interval */
+    uint8_t  dl_loss_pct;                        /* OTA messages a peripheral does not receive */
+    uint8_t  ul_loss_pct;                        /* status responses the central does not receive */
+} sim_case_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {20,   0,  0},
+    {20,   5,  5},
+    {20,   20, 20},
+    {100,  0,  0},
+    {100,  5,  5},
+    {100,  20, 20},
+    {1000, 5,  5},
+};
+
+static uint8_t      flash[PAWR_CFG_OTA_SLOT_SIZE];
+static uint8_t      image[IMAGE_LEN];
+static uint8_t      status[PAWR_OTA_STATUS_HDR_LEN + PAWR_OTA_STATUS_BITMAP_LEN];
+static uint8_t      status_len;
+static wiced_bool_t status_rcvd;
+static uint8_t      ul_loss_pct;
+static jmp_buf      task_idle;
+static uint32_t     rng;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint32_t sim_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static wiced_bool_t sim_chance(uint8_t pct)
+{
+    return (sim_rand() % 100U) < pct;
+}
+
+/* the serial flash is the default backend; the simulation installs a RAM one */
+wiced_bool_t pawr_flash_init(void)
+{
+    return WICED_FALSE;
+}
+
+uint32_t pawr_flash_erase_size(uint32_t addr)
+{
+    return 0;
+}
+
+wiced_bool_t pawr_flash_erase(uint32_t addr, uint32_t len)
+{
+    return WICED_FALSE;
+}
+
+wiced_bool_t pawr_flash_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    return WICED_FALSE;
+}
+
+wiced_bool_t pawr_flash_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    return WICED_FALSE;
+}
+
+static wiced_bool_t ram_init(void)
+{
+    return WICED_TRUE;
+}
+
+static uint32_t ram_erase_size(uint32_t addr)
+{
+    return 4096;
+}
+
+static wiced_bool_t ram_erase(uint32_t addr, uint32_t len)
+{
+    memset(&flash[addr - PAWR_CFG_OTA_SLOT_ADDR], 0xFF, len);
+    return WICED_TRUE;
+}
+
+static wiced_bool_t ram_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    memcpy(&flash[addr - PAWR_CFG_OTA_SLOT_ADDR], p_data, len);
+    return WICED_TRUE;
+}
+
+static wiced_bool_t ram_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    memcpy(p_data, &flash[addr - PAWR_CFG_OTA_SLOT_ADDR], len);
+    return WICED_TRUE;
+}
+
+static const pawr_ota_flash_t ram_flash =
+{
+    .init       = ram_init,
+    .erase_size = ram_erase_size,
+    .erase      = ram_erase,
+    .write      = ram_write,
+    .read       = ram_read,
+};
+
+/* the status reaches the central unless the uplink loses it */
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    if (!sim_chance(ul_loss_pct))
+    {
+        memcpy(status, p_data, data_len);
+        status_len  = data_len;
+        status_rcvd = WICED_TRUE;
+    }
+    return WICED_BT_SUCCESS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    longjmp(task_idle, 1);
+}
+
+/* the flash task keeps up with one page per event */
+static void pump(void)
+{
+    if (setjmp(task_idle) == 0)
+    {
+        host_task_fn[host_num_tasks - 1](NULL);
+    }
+}
+
+static uint32_t crc32(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint8_t  b;
+
+    while (len--)
+    {
+        crc ^= *p_data++;
+        for (b = 0; b < 8; b++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320UL : 0);
+        }
+    }
+    return ~crc;
+}
+
+/* one OTA message in the next periodic event */
+static void sim_send(const sim_case_t *p_case, uint32_t *p_evt, const uint8_t *p_msg, uint16_t len)
+{
+    if (!sim_chance(p_case->dl_loss_pct))
+    {
+        pawr_ota_on_msg(SE, (uint16_t)*p_evt, p_msg, len);
+    }
+    (*p_evt)++;
+    host_advance_ms(p_case->interval_ms);
+    pump();
+}
+
+static void sim_chunk(const sim_case_t *p_case, uint32_t *p_evt, uint8_t session, uint32_t idx)
+{
+    uint8_t  m[PAWR_OTA_CHUNK_HDR_LEN + PAWR_OTA_CHUNK_SIZE];
+    uint32_t len = IMAGE_LEN - idx * PAWR_OTA_CHUNK_SIZE;
+
+    len  = (len > PAWR_OTA_CHUNK_SIZE) ? PAWR_OTA_CHUNK_SIZE : len;
+    m[0] = PAWR_MSG_TYPE_OTA;
+    m[1] = PAWR_OTA_OP_CHUNK;
+    m[2] = session;
+    m[3] = (uint8_t)idx;
+    m[4] = (uint8_t)(idx >> 8);
+    memcpy(&m[PAWR_OTA_CHUNK_HDR_LEN], &image[idx * PAWR_OTA_CHUNK_SIZE], len);
+    sim_send(p_case, p_evt, m, (uint16_t)(PAWR_OTA_CHUNK_HDR_LEN + len));
+}
+
+/* the central: BEGIN until the status shows it, every chunk once, then QUERY and the chunks the
+ * status names until the image is verified, then APPLY */
+static void sim_run(const sim_case_t *p_case, uint8_t session)
+{
+    uint8_t          begin[PAWR_OTA_BEGIN_LEN];
+    uint8_t          query[] = {PAWR_MSG_TYPE_OTA, PAWR_OTA_OP_QUERY, session};
+    uint32_t         crc     = crc32(image, IMAGE_LEN);
+    uint32_t         base;
+    uint32_t         bit;
+    uint32_t         sent    = 0;
+    uint32_t         rounds  = 0;
+    uint32_t         evt     = 0;
+    pawr_ota_stats_t s;
+    uint32_t         i;
+
+    ul_loss_pct = p_case->ul_loss_pct;
+    begin[0]  = PAWR_MSG_TYPE_OTA;
+    begin[1]  = PAWR_OTA_OP_BEGIN;
+    begin[2]  = session;
+    begin[3]  = (uint8_t)IMAGE_LEN;
+    begin[4]  = (uint8_t)(IMAGE_LEN >> 8);
+    begin[5]  = (uint8_t)(IMAGE_LEN >> 16);
+    begin[6]  = (uint8_t)(IMAGE_LEN >> 24);
+    begin[7]  = (uint8_t)crc;
+    begin[8]  = (uint8_t)(crc >> 8);
+    begin[9]  = (uint8_t)(crc >> 16);
+    begin[10] = (uint8_t)(crc >> 24);
+    begin[11] = PAWR_OTA_CHUNK_SIZE;
+    do
+    {
+        sim_send(p_case, &evt, begin, sizeof(begin));
+        status_rcvd = WICED_FALSE;
+        sim_send(p_case, &evt, query, sizeof(query));
+    } while (!status_rcvd || (status[1] != session));
+
+    for (i = 0; i < NUM_CHUNKS; i++, sent++)
+    {
+        sim_chunk(p_case, &evt, session, i);
+    }
+    while (evt < MAX_EVENTS)
+    {
+        status_rcvd = WICED_FALSE;
+        sim_send(p_case, &evt, query, sizeof(query));
+        if (!status_rcvd)
+        {
+            continue;
+        }
+        if (status[2] == PAWR_OTA_STATE_READY)
+        {
+            break;
+        }
+        if (status[2] != PAWR_OTA_STATE_RECEIVING)
+        {
+            continue;                            /* verifying */
+        }
+        rounds++;
+        base = (uint32_t)status[5] | ((uint32_t)status[6] << 8);
+        for (bit = 0; bit < (uint32_t)(status_len - PAWR_OTA_STATUS_HDR_LEN) * 8; bit++)
+        {
+            if (status[PAWR_OTA_STATUS_HDR_LEN + bit / 8] & (1U << (bit % 8)))
+            {
+                sim_chunk(p_case, &evt, session, base + bit);
+                sent++;
+            }
+        }
+    }
+    TEST_CHECK((pawr_ota_get_state() == PAWR_OTA_STATE_READY) && (memcmp(flash, image, IMAGE_LEN) == 0));
+
+    pawr_ota_get_stats(&s);
+    printf("%8u %4u/%-3u %7lu %6lu %8.1f %9.1f %8.0f %9.1f %9.0f\n",
+           p_case->interval_ms, p_case->dl_loss_pct, p_case->ul_loss_pct,
+           (unsigned long)evt, (unsigned long)rounds, sent * 100.0 / NUM_CHUNKS,
+           evt * (double)p_case->interval_ms / 1000.0,
+           IMAGE_LEN * 1000.0 / (evt * (double)p_case->interval_ms),
+           (double)IMAGE_LEN / evt,
+           (s.elapsed_ms != 0) ? (double)IMAGE_LEN * 1000.0 / s.elapsed_ms : 0.0);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    rng = SEED;
+    for (i = 0; i < IMAGE_LEN; i++)
+    {
+        image[i] = (uint8_t)sim_rand();
+    }
+    pawr_ota_init();
+    pawr_ota_set_flash(&ram_flash);
+
+    printf("firmware update of %d bytes in %d-byte chunks, one chunk per periodic event, seed 0x%08lX\n",
+           IMAGE_LEN, PAWR_OTA_CHUNK_SIZE, (unsigned long)SEED);
+    printf("from the first BEGIN to the READY status; the last column is the module's own figure, BEGIN to the\n"
+           "last chunk written, as printed with the PAwR statistics\n");
+    printf("interval  loss %%  events rounds  sent %%   time s   bytes/s  B/interval  module B/s\n");
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        sim_run(&sim_cases[i], (uint8_t)(i + 1));
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+/******************************************************************************
+* File Name:   sim_pawr_prefetch.c
+*
+* Description: This file simulates the request-to-submit latency of the PAwR layer, from the periodic
+*              advertising report to the response handed to the controller, with responses built in the
+*              report callback against responses staged ahead with pawr_prefetch_stage().
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_msg.h"
+#include "pawr_prefetch.h"
+#include "pawr_rsp_sched.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SIM_EVENTS                      (20000)
+#define SIM_SYNC_HANDLE                 (0x0040)
+#define SIM_SUBEVENT                    (0)
+#define SIM_RSP_SLOT                    (2)
+#define SIM_RSP_LEN                     (12)     /* status and latest sample */
+#define SIM_REQ_NEEDS_CONTENT           (0x5A)   /* first request byte the demand check answers */
+#define SEED                            (0x5EED0034UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint32_t     handler_ns;                     /* time the app takes to build a response */
+    uint8_t      demand_pct;                     /* requests that need a content-dependent answer */
+    wiced_bool_t prefetch;
+} sim_case_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {0,     10, WICED_FALSE},
+    {0,     10, WICED_TRUE},
+    {5000,  10, WICED_FALSE},
+    {5000,  10, WICED_TRUE},
+    {50000, 10, WICED_FALSE},
+    {50000, 10, WICED_TRUE},
+    {50000, 50, WICED_TRUE},
+};
+
+static wiced_ble_ext_adv_cback_t *ext_adv_cback;
+static const sim_case_t          *sim_case;
+static uint64_t                  rpt_start_ns;
+static uint32_t                  lat_ns[SIM_EVENTS];
+static uint32_t                  lat_count;
+static wiced_bool_t              answered;
+static uint32_t                  rng;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint32_t sim_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+void wiced_ble_ext_adv_register_cback(wiced_ble_ext_adv_cback_t *p_cback)
+{
+    ext_adv_cback = p_cback;
+}
+
+/* the controller takes the response: the end of the request-to-submit interval */
+wiced_bt_dev_status_t wiced_ble_padv_set_subevent_rsp_data(uint16_t sync_handle, wiced_ble_padv_subevent_rsp_data_t *p_rsp)
+{
+    if (!answered)
+    {
+        lat_ns[lat_count++] = (uint32_t)(host_clock_ns() - rpt_start_ns);
+        answered = WICED_TRUE;
+    }
+    return WICED_BT_SUCCESS;
+}
+
+/* the app's work to build a response, a sensor read and formatting */
+static void sim_build_rsp(uint8_t *p_rsp)
+{
+    uint64_t start = host_clock_ns();
+
+    memset(p_rsp, 0x42, SIM_RSP_LEN);
+    while (host_clock_ns() - start < sim_case->handler_ns)
+    {
+    }
+}
+
+static wiced_bool_t sim_needs_content(uint8_t subevent, const uint8_t *p_msg, uint16_t msg_len)
+{
+    return (msg_len != 0) && (p_msg[0] == SIM_REQ_NEEDS_CONTENT);
+}
+
+/* answers what the staged response did not */
+static void sim_app_rcv(uint16_t sync_handle, uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num, uint16_t evt_counter)
+{
+    uint8_t rsp[SIM_RSP_LEN];
+
+    if (answered)
+    {
+        return;
+    }
+    sim_build_rsp(rsp);
+    TEST_CHECK(pawr_rsp_sched_submit(PAWR_RSP_PRIO_TELEMETRY, subevent_num, rsp, sizeof(rsp)) == WICED_BT_SUCCESS);
+}
+
+static void sim_sync_up(void)
+{
+    wiced_ble_ext_adv_event_data_t ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.sync_establish.status            = WICED_BT_SUCCESS;
+    ev.sync_establish.sync_handle       = SIM_SYNC_HANDLE;
+    ev.sync_establish.periodic_adv_int  = 80;
+    ev.sync_establish.num_subevents     = PAWR_CFG_NUM_SUBEVENTS;
+    ev.sync_establish.subevent_interval = 20;
+    ext_adv_cback(WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT, &ev);
+}
+
+static int sim_cmp_ns(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void sim_run(const sim_case_t *p_case)
+{
+    wiced_ble_ext_adv_event_data_t ev;
+    pawr_prefetch_stats_t          stats;
+    uint8_t                        req[2];
+    uint8_t                        rsp[SIM_RSP_LEN];
+    uint16_t                       evt;
+
+    sim_case  = p_case;
+    rng       = SEED;
+    lat_count = 0;
+    pawr_prefetch_init();
+    pawr_prefetch_reg_demand_cb(sim_needs_content);
+    sim_sync_up();
+
+    for (evt = 0; evt < SIM_EVENTS; evt++)
+    {
+        /* idle time before the event: stage the answer to the next request */
+        if (p_case->prefetch)
+        {
+            sim_build_rsp(rsp);
+            pawr_prefetch_stage(SIM_SUBEVENT, pawr_prefetch_next_evt(SIM_SUBEVENT), rsp, sizeof(rsp));
+        }
+        req[0] = ((sim_rand() % 100) < p_case->demand_pct) ? SIM_REQ_NEEDS_CONTENT : PAWR_MSG_TYPE_APP;
+        req[1] = (uint8_t)evt;
+        memset(&ev, 0, sizeof(ev));
+        ev.periodic_adv_report.sync_handle          = SIM_SYNC_HANDLE;
+        ev.periodic_adv_report.data_length          = sizeof(req);
+        ev.periodic_adv_report.p_data               = req;
+        ev.periodic_adv_report.periodic_evt_counter = evt;
+        ev.periodic_adv_report.sub_event            = SIM_SUBEVENT;
+        answered     = WICED_FALSE;
+        rpt_start_ns = host_clock_ns();
+        ext_adv_cback(WICED_BLE_PERIODIC_ADV_REPORT_EVENT, &ev);
+        TEST_CHECK(answered);
+    }
+
+    pawr_prefetch_get_stats(&stats);
+    qsort(lat_ns, lat_count, sizeof(lat_ns[0]), sim_cmp_ns);
+    printf("%8lu %5u%% %-8s %5lu%% %8lu %8lu %8lu\n",
+           (unsigned long)p_case->handler_ns, p_case->demand_pct, p_case->prefetch ? "prefetch" : "callback",
+           (unsigned long)(stats.hit * 100U / SIM_EVENTS),
+           (unsigned long)lat_ns[lat_count / 2], (unsigned long)lat_ns[lat_count * 99 / 100],
+           (unsigned long)lat_ns[lat_count - 1]);
+}
+
+int main(void)
+{
+    uint8_t i;
+
+    app_bt_dispatch_init();
+    pawr_reg_se_rsp_cb(sim_app_rcv);
+    pawr_init();
+    TEST_CHECK(pawr_rsp_sched_set_slots(SIM_SUBEVENT, SIM_RSP_SLOT, 1));
+    printf("\nrequest to submit latency, report callback to the response handed to the controller,\n");
+    printf("%d events a case, host clock, seed 0x%08lX\n", SIM_EVENTS, (unsigned long)SEED);
+    printf("build ns demand path      staged   p50 ns   p99 ns   max ns\n");
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        sim_run(&sim_cases[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,375 @@
+/******************************************************************************
+* File Name:   sim_pawr_roam.c
+*
+* Description: This file simulates roaming of a peripheral that walks past three centrals at several
+*              speeds, with path loss, shadowing and fading. It gives the surveys, the handovers and
+*              their time, the sync losses and the share of periodic events received.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_roam.h"
+#include "pawr_cmd.h"
+#include "pawr_link.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define NUM_CENTRALS                    (3)
+#define SID                             (3)
+#define CENTRAL_SPACING_M               (30.0)   /* centrals on a line along the aisle */
+#define CENTRAL_HEIGHT_M                (3.0)    /* above the peripheral */
+#define PASSES                          (20)     /* end to end walks, alternately out and back */
+#define CENTRAL_TX_DBM                  (0)
+#define PATH_LOSS_1M_DB                 (40.0)   /* 2.4 GHz at 1 m */
+#define PATH_LOSS_EXP                   (3.0)    /* indoor with shelving */
+#define SHADOW_DB                       (4.0)    /* log-normal shadowing, per central */
+#define SHADOW_CORR_M                   (5.0)    /* shadowing decorrelation distance */
+#define SENSITIVITY_DBM                 (-94.0)  /* 1M PHY, as sim_pawr_link */
+#define PER_SLOPE_DB                    (1.0)
+#define ADV_INTERVAL_MS                 (100)    /* extended advertising with the SyncInfo */
+#define SCAN_DUTY_SYNCED                (0.5)    /* scan share left beside the PAwR events */
+#define SYNC_TIMEOUT_MS                 (PERIODIC_ADV_EXPIRD_TIME * 10)
+#define SEED                            (0x5EED0046UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    double   speed;                              /* m/s */
+    uint16_t pa_interval_ms;                     /* periodic advertising interval */
+} sim_case_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {1.0, 100},
+    {2.0, 100},
+    {5.0, 100},
+    {1.0, 500},
+    {5.0, 500},
+};
+
+/* the controller: synced to one central, or creating a sync to any central of a mask */
+static int8_t       sim_serving;
+static uint8_t      sim_sync_mask;
+static uint8_t      sim_sync_info;               /* SyncInfo received, waiting for the first event */
+static wiced_bool_t sim_scan_on;
+static uint32_t     sim_last_rx_ms;
+static uint16_t     sim_pa_interval_ms;
+static uint16_t     sim_pa_phase[NUM_CENTRALS];
+static uint16_t     sim_adv_phase[NUM_CENTRALS];
+static double       sim_shadow[NUM_CENTRALS];
+
+/* results of one case */
+static uint32_t     sim_events;
+static uint32_t     sim_received_events;
+static uint32_t     sim_handover_ms_max;
+static uint32_t     sim_outage_ms_max;
+static uint32_t     rng;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static double sim_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng + 0.5) / 4294967296.0;
+}
+
+static double sim_gauss(void)
+{
+    return sqrt(-2.0 * log(sim_uniform())) * cos(2.0 * M_PI * sim_uniform());
+}
+
+/* mean path loss and shadowing at position x, Rayleigh fading per packet: channels hop */
+static double sim_rssi(uint8_t central, double x)
+{
+    double dx = x - central * CENTRAL_SPACING_M;
+    double d  = sqrt(dx * dx + CENTRAL_HEIGHT_M * CENTRAL_HEIGHT_M);
+
+    return CENTRAL_TX_DBM - PATH_LOSS_1M_DB - 10.0 * PATH_LOSS_EXP * log10(d) + sim_shadow[central] +
+           10.0 * log10(-log(sim_uniform()));
+}
+
+static wiced_bool_t sim_received(double rssi)
+{
+    return (sim_uniform() * (1.0 + exp(-(rssi - SENSITIVITY_DBM) / PER_SLOPE_DB)) < 1.0) ? WICED_TRUE : WICED_FALSE;
+}
+
+static int8_t sim_rssi_i8(double rssi)
+{
+    return (int8_t)lrint((rssi < -127.0) ? -127.0 : rssi);
+}
+
+static void central_addr(uint8_t central, uint8_t *addr)
+{
+    memset(addr, 0, BD_ADDR_LEN);
+    addr[0] = 0xC0;
+    addr[5] = central;
+}
+
+/* the create sync parameters pawr.c would use: the handover target, else the periodic advertiser list */
+static void sim_create_sync(void)
+{
+    wiced_ble_padv_create_sync_params_t sync;
+
+    memset(&sync, 0, sizeof(sync));
+    sim_serving   = -1;
+    sim_sync_info = 0;
+    sim_sync_mask = (1 << NUM_CENTRALS) - 1;
+    if (pawr_roam_prepare_sync(&sync) && (sync.options == WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST))
+    {
+        sim_sync_mask = (uint8_t)(1 << sync.adv_addr[5]);
+    }
+}
+
+static void sim_sync_established(uint8_t central)
+{
+    wiced_ble_padv_sync_established_event_data_t ps;
+    pawr_roam_stats_t                            before;
+    pawr_roam_stats_t                            after;
+
+    memset(&ps, 0, sizeof(ps));
+    central_addr(central, ps.adv_addr);
+    ps.adv_sid     = SID;
+    sim_serving    = (int8_t)central;
+    sim_sync_mask  = 0;
+    sim_last_rx_ms = host_now_ms;
+    pawr_link_reset();
+
+    /* the module keeps running totals; the difference is this sync's handover or outage */
+    pawr_roam_get_stats(&before);
+    pawr_roam_on_sync(&ps);
+    pawr_roam_get_stats(&after);
+    if ((after.handover_ms_sum - before.handover_ms_sum) > sim_handover_ms_max)
+    {
+        sim_handover_ms_max = after.handover_ms_sum - before.handover_ms_sum;
+    }
+    if ((after.outage_ms_sum - before.outage_ms_sum) > sim_outage_ms_max)
+    {
+        sim_outage_ms_max = after.outage_ms_sum - before.outage_ms_sum;
+    }
+}
+
+void pawr_scan_enable(wiced_bool_t enable)
+{
+    sim_scan_on = enable;
+}
+
+void pawr_resync(void)
+{
+    if (sim_serving >= 0)
+    {
+        pawr_roam_on_sync_lost();
+    }
+    sim_create_sync();
+}
+
+void pawr_scan_for_pawr_network(void)
+{
+    sim_create_sync();
+}
+
+wiced_bool_t pawr_cmd_submit(const pawr_cmd_t *p_cmd)
+{
+    p_cmd->issue();
+    return WICED_TRUE;
+}
+
+/* one millisecond at position x: advertising, periodic events and the sync timeout */
+static void sim_step(double x)
+{
+    wiced_ble_ext_scan_results_t rpt;
+    double                       rssi;
+    uint32_t                     now = host_now_ms;
+    uint8_t                      c;
+
+    for (c = 0; c < NUM_CENTRALS; c++)
+    {
+        if ((now % ADV_INTERVAL_MS) == sim_adv_phase[c])
+        {
+            rssi = sim_rssi(c, x);
+            if ((sim_scan_on || (sim_sync_mask != 0)) && sim_received(rssi) &&
+                (sim_uniform() < ((sim_serving >= 0) ? SCAN_DUTY_SYNCED : 1.0)))
+            {
+                memset(&rpt, 0, sizeof(rpt));
+                central_addr(c, rpt.bd_addr);
+                rpt.adv_sid = SID;
+                rpt.rssi    = sim_rssi_i8(rssi);
+                app_bt_dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, &rpt);
+                if ((sim_sync_mask & (1 << c)) != 0)
+                {
+                    sim_sync_info |= (uint8_t)(1 << c);
+                }
+            }
+        }
+        if ((now % sim_pa_interval_ms) != sim_pa_phase[c])
+        {
+            continue;
+        }
+        if (c == 0)
+        {
+            sim_events++;
+        }
+        if ((int8_t)c == sim_serving)
+        {
+            rssi = sim_rssi(c, x);
+            if (sim_received(rssi))
+            {
+                sim_received_events++;
+                sim_last_rx_ms = now;
+                pawr_link_on_report(0, (uint16_t)(now / sim_pa_interval_ms), sim_rssi_i8(rssi), 0);
+            }
+        }
+        else if (((sim_sync_info & (1 << c)) != 0) && sim_received(sim_rssi(c, x)))
+        {
+            sim_sync_established(c);
+        }
+    }
+    if ((sim_serving >= 0) && ((now - sim_last_rx_ms) >= SYNC_TIMEOUT_MS))
+    {
+        /* pawr.c reports the loss and scans for the network again */
+        pawr_roam_on_sync_lost();
+        sim_create_sync();
+    }
+    host_advance_ms(1);
+}
+
+/* walks PASSES times between the first and the last central at the speed of the case */
+static void sim_run(const sim_case_t *p_case, pawr_roam_stats_t *p_stats)
+{
+    pawr_roam_stats_t start;
+    double            length = (NUM_CENTRALS - 1) * CENTRAL_SPACING_M;
+    double            a      = exp(-p_case->speed / 1000.0 / SHADOW_CORR_M);
+    double            x;
+    uint32_t          steps  = (uint32_t)(length / p_case->speed * 1000.0);
+    uint32_t          pass;
+    uint32_t          i;
+    uint8_t           c;
+
+    rng = SEED;
+    sim_pa_interval_ms = p_case->pa_interval_ms;
+    for (c = 0; c < NUM_CENTRALS; c++)
+    {
+        sim_pa_phase[c]  = (uint16_t)(sim_uniform() * sim_pa_interval_ms);
+        sim_adv_phase[c] = (uint16_t)(sim_uniform() * ADV_INTERVAL_MS);
+        sim_shadow[c]    = SHADOW_DB * sim_gauss();
+    }
+    sim_events          = 0;
+    sim_received_events = 0;
+    sim_scan_on         = WICED_FALSE;
+    sim_sync_established(0);
+    sim_handover_ms_max = 0;
+    sim_outage_ms_max   = 0;
+    pawr_roam_get_stats(&start);
+
+    for (pass = 0; pass < PASSES; pass++)
+    {
+        for (i = 0; i < steps; i++)
+        {
+            x = length * i / steps;
+            sim_step(((pass % 2) == 0) ? x : length - x);
+            for (c = 0; c < NUM_CENTRALS; c++)
+            {
+                sim_shadow[c] = a * sim_shadow[c] + sqrt(1.0 - a * a) * SHADOW_DB * sim_gauss();
+            }
+        }
+    }
+    pawr_roam_get_stats(p_stats);
+    p_stats->surveys         -= start.surveys;
+    p_stats->handovers       -= start.handovers;
+    p_stats->handover_fails  -= start.handover_fails;
+    p_stats->handover_ms_sum -= start.handover_ms_sum;
+    p_stats->handover_ms_max  = sim_handover_ms_max;
+    p_stats->losses          -= start.losses;
+    p_stats->outage_ms_sum   -= start.outage_ms_sum;
+    p_stats->outage_ms_max    = sim_outage_ms_max;
+}
+
+int main(void)
+{
+    pawr_roam_stats_t stats;
+    uint8_t           addr[BD_ADDR_LEN];
+    uint8_t           i;
+    int               out;
+    int               null_fd = open("/dev/null", O_WRONLY);
+
+    app_bt_dispatch_init();
+    pawr_link_init();
+    pawr_roam_init();
+    for (i = 0; i < NUM_CENTRALS; i++)
+    {
+        central_addr(i, addr);
+        pawr_roam_add_central(BLE_ADDR_PUBLIC, addr, SID);
+    }
+
+    printf("roaming along %d centrals %.0f m apart, %d passes end to end, path loss %.0f dB + %.0f log d, "
+           "shadowing %.0f dB over %.0f m, Rayleigh fading, seed 0x%08lX\n", NUM_CENTRALS, CENTRAL_SPACING_M,
+           PASSES, PATH_LOSS_1M_DB, 10.0 * PATH_LOSS_EXP, SHADOW_DB, SHADOW_CORR_M, (unsigned long)SEED);
+    printf("handover: from dropping the sync to the sync with the chosen central; outage: from a sync loss "
+           "to the next sync\n");
+    printf("speed m/s  interval ms  surveys  handovers  fails  handover avg ms  max ms  losses  outage max ms  "
+           "events rx %%\n");
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        /* the module logs every handover; keep the table readable */
+        fflush(stdout);
+        out = dup(STDOUT_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        sim_run(&sim_cases[i], &stats);
+        fflush(stdout);
+        dup2(out, STDOUT_FILENO);
+        close(out);
+        printf("%9.0f %12u %8lu %10lu %6lu %16lu %7lu %7lu %14lu %12.1f\n",
+               sim_cases[i].speed, sim_cases[i].pa_interval_ms, (unsigned long)stats.surveys,
+               (unsigned long)stats.handovers, (unsigned long)stats.handover_fails,
+               (unsigned long)((stats.handovers != 0) ? (stats.handover_ms_sum / stats.handovers) : 0),
+               (unsigned long)stats.handover_ms_max, (unsigned long)stats.losses,
+               (unsigned long)stats.outage_ms_max, (sim_events != 0) ? sim_received_events * 100.0 / sim_events : 0.0);
+    }
+    close(null_fd);
+    return 0;
+}
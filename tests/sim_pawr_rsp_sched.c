@@ -0,0 +1,245 @@
+/******************************************************************************
+* File Name:   sim_pawr_rsp_sched.c
+*
+* Description: This file simulates the response scheduler with the telemetry class saturated and alarm
+*              bursts arriving at random, against one FIFO queue of the same depth, and prints the alarm
+*              latency distribution and the alarms refused.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define EVT_MS                          (100)
+#define NUM_SE                          (2)      /* subevents with owned slots, one every EVT_MS / NUM_SE */
+#define SIM_EVENTS                      (36000)  /* one hour */
+#define ALARM_GAP_MS                    (5000)   /* mean time between alarm bursts */
+#define MAX_ALARMS                      (8192)
+#define FIFO_DEPTH                      (PAWR_RSP_PRIO_NUM * PAWR_RSP_SCHED_QUEUE_DEPTH)   /* same RAM, one queue */
+#define SEED                            (0x5EED0026UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint8_t tele_per_evt;                        /* mean telemetry responses offered per event */
+    uint8_t slots;                               /* owned slots per subevent */
+    uint8_t burst;                               /* alarms per burst */
+} sim_case_t;
+
+typedef struct
+{
+    uint32_t lat_ms[MAX_ALARMS];
+    uint32_t sent;
+    uint32_t dropped;                            /* refused by a full queue */
+    uint32_t tele_sent;
+} sim_result_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {1,  1, 1},
+    {4,  1, 1},
+    {16, 1, 1},
+    {16, 2, 1},
+    {16, 1, 4},
+    {16, 1, 6},
+};
+
+static uint32_t     rng;
+static uint32_t     alarm_ms[MAX_ALARMS];        /* arrival time by alarm number */
+static uint16_t     alarm_seq;
+
+/* the baseline: one drop-tail FIFO of the same total depth, no classes */
+static uint16_t     fifo[FIFO_DEPTH];            /* alarm number, or UINT16_MAX for telemetry */
+static uint8_t      fifo_count;
+
+static sim_result_t res_sched;
+static sim_result_t res_fifo;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint32_t sim_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/* the controller: the scheduler's responses go out here */
+wiced_bt_dev_status_t pawr_snd_se_rsp_central(uint16_t sync_handle, uint16_t evt_counter, uint8_t req_subevent,
+                                              uint8_t rsp_subevent, uint8_t rsp_slot, uint8_t rsp_data_len,
+                                              uint8_t *p_data)
+{
+    uint16_t seq;
+
+    TEST_CHECK(rsp_data_len == 3);
+    if (p_data[0] == 'A')
+    {
+        seq = (uint16_t)(p_data[1] | (p_data[2] << 8));
+        res_sched.lat_ms[res_sched.sent++] = host_now_ms - alarm_ms[seq];
+    }
+    else
+    {
+        res_sched.tele_sent++;
+    }
+    return WICED_BT_SUCCESS;
+}
+
+static void offer(uint8_t tag, uint16_t seq)
+{
+    uint8_t rsp[3] = {tag, (uint8_t)seq, (uint8_t)(seq >> 8)};
+
+    if (pawr_rsp_sched_submit((tag == 'A') ? PAWR_RSP_PRIO_ALARM : PAWR_RSP_PRIO_TELEMETRY,
+                              PAWR_RSP_SCHED_ANY_SUBEVENT, rsp, sizeof(rsp)) != WICED_BT_SUCCESS)
+    {
+        res_sched.dropped += (tag == 'A');
+    }
+    if (fifo_count < FIFO_DEPTH)
+    {
+        fifo[fifo_count++] = (tag == 'A') ? seq : UINT16_MAX;
+    }
+    else
+    {
+        res_fifo.dropped += (tag == 'A');
+    }
+}
+
+static void fifo_service(uint8_t slots)
+{
+    while ((slots-- != 0) && (fifo_count != 0))
+    {
+        if (fifo[0] != UINT16_MAX)
+        {
+            res_fifo.lat_ms[res_fifo.sent++] = host_now_ms - alarm_ms[fifo[0]];
+        }
+        else
+        {
+            res_fifo.tele_sent++;
+        }
+        memmove(&fifo[0], &fifo[1], --fifo_count * sizeof(fifo[0]));
+    }
+}
+
+static int sim_cmp_ms(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void sim_print(const sim_case_t *p_case, const char *name, sim_result_t *p_res)
+{
+    qsort(p_res->lat_ms, p_res->sent, sizeof(p_res->lat_ms[0]), sim_cmp_ms);
+    printf("%9u %5u %5u %-6s %6lu %7lu %7lu %7lu %7lu %11.1f\n",
+           p_case->tele_per_evt, p_case->slots, p_case->burst, name,
+           (unsigned long)p_res->sent, (unsigned long)p_res->dropped,
+           (unsigned long)p_res->lat_ms[p_res->sent / 2], (unsigned long)p_res->lat_ms[p_res->sent * 99 / 100],
+           (unsigned long)p_res->lat_ms[p_res->sent - 1],
+           p_res->tele_sent * 1000.0 / ((double)SIM_EVENTS * EVT_MS));
+}
+
+/* one hour at ms resolution: telemetry and alarm bursts arrive at random times, each subevent of the
+ * train serves the owned slots */
+static void sim_run(const sim_case_t *p_case)
+{
+    uint32_t t;
+    uint8_t  b;
+    uint8_t  se;
+
+    rng        = SEED;
+    alarm_seq  = 0;
+    fifo_count = 0;
+    memset(&res_sched, 0, sizeof(res_sched));
+    memset(&res_fifo, 0, sizeof(res_fifo));
+    pawr_rsp_sched_init();
+    for (se = 0; se < NUM_SE; se++)
+    {
+        TEST_CHECK(pawr_rsp_sched_set_slots((uint8_t)(PAWR_CFG_FIRST_SUBEVENT + se), 0, p_case->slots));
+    }
+
+    for (t = 0; t < (uint32_t)SIM_EVENTS * EVT_MS; t++)
+    {
+        host_now_ms = t;
+        if ((sim_rand() % EVT_MS) < p_case->tele_per_evt)
+        {
+            offer('T', 0);
+        }
+        if ((sim_rand() % ALARM_GAP_MS) == 0)
+        {
+            for (b = 0; (b < p_case->burst) && (alarm_seq < MAX_ALARMS); b++)
+            {
+                alarm_ms[alarm_seq] = t;
+                offer('A', alarm_seq++);
+            }
+        }
+        if ((t % (EVT_MS / NUM_SE)) == 0)
+        {
+            se = (uint8_t)((t / (EVT_MS / NUM_SE)) % NUM_SE);
+            pawr_rsp_sched_service(1, (uint16_t)(t / EVT_MS), (uint8_t)(PAWR_CFG_FIRST_SUBEVENT + se));
+            fifo_service(p_case->slots);
+        }
+    }
+
+    sim_print(p_case, "sched", &res_sched);
+    sim_print(p_case, "fifo", &res_fifo);
+}
+
+int main(void)
+{
+    uint8_t i;
+
+    printf("alarm latency under telemetry load, %d ms train, %d subevents, %d s, an alarm burst every %d s on average, "
+           "seed 0x%08lX\n", EVT_MS, NUM_SE, SIM_EVENTS * EVT_MS / 1000, ALARM_GAP_MS / 1000, (unsigned long)SEED);
+    printf("sched: the scheduler, %d responses per class; fifo: one queue of %d responses\n",
+           PAWR_RSP_SCHED_QUEUE_DEPTH, FIFO_DEPTH);
+    printf("tele/evt  slots burst queue    sent dropped  p50 ms  p99 ms  max ms telemetry/s\n");
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        sim_run(&sim_cases[i]);
+    }
+    return 0;
+}
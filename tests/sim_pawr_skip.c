@@ -0,0 +1,198 @@
+/******************************************************************************
+* File Name:   sim_pawr_skip.c
+*
+* Description: This file simulates adaptive event skipping over ten hours of a 100 ms train for a table of
+*              command rates and bounds, and prints the radio wakeups per minute, the re-syncs, and the
+*              command latency.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_skip.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define EVT_MS                          (100)    /* train interval */
+#define RESYNC_MS                       (300)    /* a skip change until the new sync is established */
+#define SIM_MS                          (10UL * 3600 * 1000)
+#define SEED                            (0x5EED0048UL)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    double   cmds_per_min;                       /* mean rate, exponential gaps, one outstanding at a time */
+    uint32_t max_latency_ms;
+    uint32_t quiet_ms;
+} sim_case_t;
+
+static const sim_case_t sim_cases[] =
+{
+    {0.1, 2000, 10000},
+    {1.0, 2000, 10000},
+    {6.0, 2000, 10000},
+    {1.0, 1000, 10000},
+    {1.0, 2000, 30000},
+};
+
+static uint32_t     rng = SEED;
+static uint16_t     skip_asked;
+static wiced_bool_t resync_pending;
+static uint32_t     resync_done_ms;
+static uint32_t     resyncs;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* the PAwR layer: each change re-creates the sync, no events until it is back */
+void pawr_set_skip(uint16_t skip)
+{
+    skip_asked     = skip;
+    resync_pending = WICED_TRUE;
+    resync_done_ms = host_now_ms + RESYNC_MS;
+    resyncs++;
+}
+
+static double sim_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return ((double)rng + 1.0) / 4294967297.0;
+}
+
+static uint32_t sim_next_cmd_ms(double cmds_per_min)
+{
+    return host_now_ms + (uint32_t)(-log(sim_uniform()) * 60000.0 / cmds_per_min);
+}
+
+/* ten hours on a 100 ms train, the same seed in each case. The central holds a command for this
+ * device until it is received at skip 0 and sends the wake flag in every event meanwhile. Wakeups
+ * are the events received; the scans of the re-syncs are not in them. */
+static void sim_run(const sim_case_t *p_case)
+{
+    wiced_ble_padv_sync_established_event_data_t ps;
+    pawr_skip_stats_t                            stats;
+    uint32_t                                     end      = host_now_ms + SIM_MS;
+    uint32_t                                     next_cmd;
+    uint32_t                                     cmd_ms   = 0;
+    wiced_bool_t                                 cmd_wait = WICED_FALSE;
+    uint16_t                                     skip_eff = 0;   /* skip of the sync in place */
+    uint16_t                                     evt      = 0;
+    uint16_t                                     gap      = 0;
+    uint32_t                                     lat_ms;
+    uint32_t                                     lat_max  = 0;
+    uint64_t                                     lat_sum  = 0;
+    uint32_t                                     cmds     = 0;
+    pawr_skip_stats_t                            before;
+
+    memset(&ps, 0, sizeof(ps));
+    ps.periodic_adv_int = EVT_MS * 4 / 5;
+    rng                 = SEED;
+    resyncs             = 0;
+    resync_pending      = WICED_FALSE;
+    skip_asked          = 0;
+    pawr_skip_get_stats(&before);
+    pawr_skip_set_bounds(p_case->max_latency_ms, p_case->quiet_ms);
+    pawr_skip_on_sync(&ps);
+    next_cmd = sim_next_cmd_ms(p_case->cmds_per_min);
+
+    while (host_now_ms < end)
+    {
+        host_advance_ms(EVT_MS);
+        evt++;
+        gap++;
+        if (!cmd_wait && ((int32_t)(host_now_ms - next_cmd) >= 0))
+        {
+            cmd_wait = WICED_TRUE;
+            cmd_ms   = next_cmd;
+        }
+        if (resync_pending)
+        {
+            if ((int32_t)(host_now_ms - resync_done_ms) < 0)
+            {
+                continue;
+            }
+            resync_pending = WICED_FALSE;
+            skip_eff       = skip_asked;
+            gap            = skip_eff + 1U;
+            pawr_skip_on_sync(&ps);
+        }
+        if (gap <= skip_eff)
+        {
+            continue;
+        }
+        gap = 0;
+        pawr_skip_on_report(evt, cmd_wait && (skip_eff == 0), cmd_wait && (skip_eff != 0));
+        if (cmd_wait && (skip_eff == 0))
+        {
+            lat_ms   = host_now_ms - cmd_ms;
+            lat_sum += lat_ms;
+            lat_max  = (lat_ms > lat_max) ? lat_ms : lat_max;
+            cmds++;
+            cmd_wait = WICED_FALSE;
+            next_cmd = sim_next_cmd_ms(p_case->cmds_per_min);
+        }
+    }
+    pawr_skip_get_stats(&stats);
+    pawr_skip_on_sync_lost();
+    printf("%9.1f %8lu %8lu %12.0f %10lu %6lu %10lu %10lu\n",
+           p_case->cmds_per_min, (unsigned long)p_case->max_latency_ms, (unsigned long)p_case->quiet_ms,
+           (stats.events - before.events) * 60000.0 / (stats.synced_ms - before.synced_ms),
+           (unsigned long)resyncs, (unsigned long)cmds,
+           (unsigned long)((cmds != 0) ? (lat_sum / cmds) : 0), (unsigned long)lat_max);
+}
+
+int main(void)
+{
+    uint8_t i;
+
+    printf("adaptive skip, %d ms train, %d ms per re-sync, %lu s per case, seed 0x%08lX\n",
+           EVT_MS, RESYNC_MS, SIM_MS / 1000, (unsigned long)SEED);
+    printf("cmds/min  bound ms quiet ms  wakeups/min    resyncs   cmds lat avg ms lat max ms\n");
+    printf("%9s %8s %8s %12d %10d %6s %10d %10d   (skip 0)\n", "-", "-", "-", 60000 / EVT_MS, 0, "-", EVT_MS / 2, EVT_MS);
+    for (i = 0; i < sizeof(sim_cases) / sizeof(sim_cases[0]); i++)
+    {
+        sim_run(&sim_cases[i]);
+    }
+    return 0;
+}
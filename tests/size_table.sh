@@ -0,0 +1,108 @@
+#!/bin/sh
+################################################################################
+# \file size_table.sh
+# \version 1.0
+#
+# \brief
+# Prints the module size table of README.md as Markdown rows.
+#
+#   tests/size_table.sh            host build: each module compiled with the host
+#                                  cc -Os -fno-pic against tests/stubs, at the
+#                                  default and at 128 subevents, measured with
+#                                  size -A
+#   tests/size_table.sh app.map    target build: the sizes the linker kept for
+#                                  each module, from the GNU ld map file of a
+#                                  ModusToolbox build
+#
+# The host figures are x86-64 code with 8-byte pointers and are only relative;
+# prefer the map file of a target build where the Arm toolchain is installed.
+#
+################################################################################
+
+set -e
+cd "$(dirname "$0")/.."
+
+CC=${CC:-cc}
+SIZE=${SIZE:-size}
+CFLAGS="-std=gnu11 -Os -fno-pic -Itests -Itests/stubs -Isource -Iapp_bt -DENABLE_PAWR_BACKLOG -DENABLE_PAWR_ROAM"
+
+# pawr_flash.c needs the serial flash driver, which has no host stand-in
+MODULES=$(ls source/*.c | grep -v pawr_flash.c; echo app_bt/app_bt_bd_addr.c app_bt/app_bt_dispatch.c app_bt/app_bt_ring.c)
+
+# .text .rodata .data .bss of an object file, from size -A
+sections()
+{
+    "$SIZE" -A "$1" | awk '
+        $1 ~ /^\.text/   { t += $2 }
+        $1 ~ /^\.rodata/ { r += $2 }
+        $1 ~ /^\.data/   { d += $2 }
+        $1 ~ /^\.bss/    { b += $2 }
+        END              { print t + 0, r + 0, d + 0, b + 0 }'
+}
+
+host_table()
+{
+    tmp=$(mktemp -d)
+    trap 'rm -rf "$tmp"' EXIT
+
+    echo "Module | .text | .rodata | .data | .bss | .bss, 128 subevents"
+    echo "-------|------:|--------:|------:|-----:|-------------------:"
+    for f in $MODULES; do
+        "$CC" $CFLAGS -c -o "$tmp/a.o" "$f"
+        "$CC" $CFLAGS -DPAWR_CFG_NUM_SUBEVENTS=128 -c -o "$tmp/b.o" "$f"
+        echo "$(basename "$f") $(sections "$tmp/a.o") $(sections "$tmp/b.o" | cut -d' ' -f4)"
+    done | awk '
+        { printf "*%s* | %d | %d | %d | %d | %d\n", $1, $2, $3, $4, $5, $6
+          t += $2; r += $3; d += $4; b += $5; b128 += $6 }
+        END { printf "Total | %d | %d | %d | %d | %d\n", t, r, d, b, b128 }'
+}
+
+# input sections of the map: a name line, then address, size and object, on the
+# same line or the next one when the name is long
+map_table()
+{
+    awk -v modules="$MODULES" '
+        BEGIN {
+            n = split(modules, m, " ")
+            for (i = 1; i <= n; i++) { sub(/.*\//, "", m[i]); sub(/\.c$/, "", m[i]); order[i] = m[i]; known[m[i]] = 1 }
+        }
+        /^Linker script and memory map/ { in_map = 1; next }
+        !in_map { next }
+        /^ [.A-Z]/ {
+            sec = $1
+            if (NF >= 4) { add(sec, $3, $4) } else { pending = sec }
+            next
+        }
+        pending != "" && /^ +0x/ { add(pending, $2, $3); pending = ""; next }
+        { pending = "" }
+        function hex(s,   v, i) {
+            v = 0
+            for (i = 3; i <= length(s); i++) v = v * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1
+            return v
+        }
+        function add(sec, size, obj,   mod) {
+            mod = obj; sub(/.*[\/(]/, "", mod); sub(/(\.c)?\.o\)?$/, "", mod)
+            if (!(mod in known)) return
+            size = hex(size)
+            if (sec ~ /^\.text/)                         text[mod] += size
+            else if (sec ~ /^\.rodata/)                  ro[mod] += size
+            else if (sec ~ /^\.data/)                    data[mod] += size
+            else if (sec ~ /^\.bss/ || sec == "COMMON")  bss[mod] += size
+        }
+        END {
+            print "Module | .text | .rodata | .data | .bss"
+            print "-------|------:|--------:|------:|-----:"
+            for (i = 1; i <= n; i++) {
+                k = order[i]
+                printf "*%s.c* | %d | %d | %d | %d\n", k, text[k], ro[k], data[k], bss[k]
+                t += text[k]; r += ro[k]; d += data[k]; b += bss[k]
+            }
+            printf "Total | %d | %d | %d | %d\n", t, r, d, b
+        }' "$1"
+}
+
+if [ $# -eq 0 ]; then
+    host_table
+else
+    map_table "$1"
+fi
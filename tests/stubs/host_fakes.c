@@ -0,0 +1,331 @@
+/******************************************************************************
+* File Name:   host_fakes.c
+*
+* Description: This file holds the default fakes of the BTstack, PDL and FreeRTOS calls for the host
+*              tests: a millisecond clock, timers driven by host_advance_ms(), and controller calls that
+*              succeed. A test overrides any of them by defining its own.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <time.h>
+#include "host_test.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define HOST_WEAK                       __attribute__((weak))
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+uint32_t       host_now_ms = 0;
+void         (*host_task_fn[HOST_MAX_TASKS])(void *);
+uint8_t        host_num_tasks = 0;
+static wiced_timer_t *host_timers[HOST_MAX_TIMERS];
+static uint8_t        host_num_timers = 0;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/**************************************************************************************************
+* Function Name: host_advance_ms()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function moves the clock on one millisecond at a time and fires the timers that expire,
+* periodic ones again every period.
+* @param[in] ms , time to move on.
+* @return    void.
+**************************************************************************************************/
+void host_advance_ms(uint32_t ms)
+{
+    uint8_t        i;
+    wiced_timer_t *p_timer;
+
+    while (ms-- != 0)
+    {
+        host_now_ms++;
+        for (i = 0; i < host_num_timers; i++)
+        {
+            p_timer = host_timers[i];
+            if (!p_timer->in_use || ((int32_t)(host_now_ms - p_timer->expires_ms) < 0))
+            {
+                continue;
+            }
+            if ((p_timer->type == WICED_MILLI_SECONDS_PERIODIC_TIMER) || (p_timer->type == WICED_SECONDS_PERIODIC_TIMER))
+            {
+                p_timer->expires_ms += p_timer->period_ms;
+            }
+            else
+            {
+                p_timer->in_use = WICED_FALSE;
+            }
+            p_timer->p_cb(p_timer->param);
+        }
+    }
+}
+
+/**************************************************************************************************
+* Function Name: host_clock_ns()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function reads the host's monotonic clock, for the benchmarks. It is unrelated to
+* host_now_ms.
+* @param[in] void.
+* @return    uint64_t nanoseconds.
+**************************************************************************************************/
+uint64_t host_clock_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**************************************************************************************************
+* Function Name: host_bench_ns()
+***************************************************************************************************
+* Function Description:
+* @brief
+* This function calls a benchmark body in runs of 1000 until HOST_BENCH_MIN_NS have passed, after
+* one untimed run to warm the caches.
+* @param[in] p_fn , body, given a call count that keeps increasing.
+* @return    double nanoseconds per call.
+**************************************************************************************************/
+double host_bench_ns(void (*p_fn)(uint32_t iter))
+{
+    uint64_t start;
+    uint64_t ns;
+    uint32_t iter = 0;
+    uint32_t i;
+
+    for (i = 0; i < 1000; i++)
+    {
+        p_fn(iter++);
+    }
+    start = host_clock_ns();
+    do
+    {
+        for (i = 0; i < 1000; i++)
+        {
+            p_fn(iter++);
+        }
+        ns = host_clock_ns() - start;
+    } while (ns < HOST_BENCH_MIN_NS);
+    return (double)ns / (double)(iter - 1000);
+}
+
+HOST_WEAK wiced_result_t wiced_init_timer(wiced_timer_t *p_timer, wiced_timer_callback_t *p_cb,
+                                          WICED_TIMER_PARAM_TYPE param, wiced_timer_type_t type)
+{
+    uint8_t i;
+
+    memset(p_timer, 0, sizeof(*p_timer));
+    p_timer->p_cb  = p_cb;
+    p_timer->param = param;
+    p_timer->type  = type;
+    for (i = 0; i < host_num_timers; i++)
+    {
+        if (host_timers[i] == p_timer)
+        {
+            return WICED_SUCCESS;
+        }
+    }
+    if (host_num_timers == HOST_MAX_TIMERS)
+    {
+        return WICED_ERROR;
+    }
+    host_timers[host_num_timers++] = p_timer;
+    return WICED_SUCCESS;
+}
+
+HOST_WEAK wiced_result_t wiced_start_timer(wiced_timer_t *p_timer, uint32_t timeout)
+{
+    if ((p_timer->type == WICED_SECONDS_TIMER) || (p_timer->type == WICED_SECONDS_PERIODIC_TIMER))
+    {
+        timeout *= 1000;
+    }
+    p_timer->period_ms  = timeout;
+    p_timer->expires_ms = host_now_ms + timeout;
+    p_timer->in_use     = WICED_TRUE;
+    return WICED_SUCCESS;
+}
+
+HOST_WEAK wiced_result_t wiced_stop_timer(wiced_timer_t *p_timer)
+{
+    p_timer->in_use = WICED_FALSE;
+    return WICED_SUCCESS;
+}
+
+HOST_WEAK wiced_bool_t wiced_is_timer_in_use(wiced_timer_t *p_timer)
+{
+    return p_timer->in_use;
+}
+
+HOST_WEAK TickType_t xTaskGetTickCount(void)
+{
+    return host_now_ms;
+}
+
+HOST_WEAK void vTaskDelay(TickType_t ticks)
+{
+    host_now_ms += ticks;
+}
+
+HOST_WEAK BaseType_t xTaskCreate(void (*p_fn)(void *), const char *p_name, uint32_t depth, void *p_arg,
+                                 UBaseType_t prio, TaskHandle_t *p_handle)
+{
+    if (host_num_tasks == HOST_MAX_TASKS)
+    {
+        return 0;
+    }
+    host_task_fn[host_num_tasks++] = p_fn;
+    return pdPASS;
+}
+
+HOST_WEAK uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    return 0;
+}
+
+HOST_WEAK void Cy_SysLib_ExitCriticalSection(uint32_t state)
+{
+}
+
+HOST_WEAK uint64_t Cy_SysLib_GetUniqueId(void)
+{
+    return 0x0123456789ABCDEFULL;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_padv_set_subevent_rsp_data(uint16_t sync_handle, wiced_ble_padv_subevent_rsp_data_t *p_rsp)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_ext_scan_set_params(wiced_ble_ext_scan_params_t *p_params)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_ext_scan_enable(uint8_t enable, wiced_ble_ext_scan_enable_params_t *p_params)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_ext_scan_register_cb(wiced_ble_ext_scan_result_cback_t *p_cback)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_padv_create_sync(wiced_ble_padv_create_sync_params_t *p_params)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_padv_cancel_sync(void)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_padv_terminate_sync(uint16_t sync_handle)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_padv_set_sync_subevent(uint16_t sync_handle, uint16_t properties, uint8_t num, uint8_t *p_subevents)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_padv_add_device_to_list(wiced_bt_ble_address_type_t type, wiced_bt_device_address_t addr, uint8_t sid)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_ble_padv_clear_list(void)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK void wiced_ble_ext_adv_register_cback(wiced_ble_ext_adv_cback_t *p_cback)
+{
+}
+
+HOST_WEAK wiced_bt_dev_status_t wiced_bt_ble_observe(wiced_bool_t start, uint8_t duration, void *p_cback)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK wiced_result_t wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bd_addr, wiced_bt_ble_address_type_t addr_type)
+{
+    return WICED_BT_SUCCESS;
+}
+
+HOST_WEAK void wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr)
+{
+}
+
+HOST_WEAK void app_bt_util_cycle_counter_init(void)
+{
+}
+
+HOST_WEAK void app_bt_util_print_bd_address(const wiced_bt_device_address_t bdadr)
+{
+}
+
+HOST_WEAK void app_bt_util_print_byte_array(void *to_print, uint16_t len)
+{
+    uint16_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        printf("%02X ", ((uint8_t *)to_print)[i]);
+    }
+    printf("\n");
+}
+
+HOST_WEAK const char *app_bt_util_get_btm_event_name(wiced_bt_management_evt_t event)
+{
+    return "btm";
+}
+
+HOST_WEAK const char *app_bt_util_get_ext_adv_event_name(wiced_ble_ext_adv_event_t event)
+{
+    return "ext_adv";
+}
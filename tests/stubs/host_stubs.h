@@ -0,0 +1,307 @@
+/******************************************************************************
+* File Name:   host_stubs.h
+*
+* Description: This file stands in for the BTstack, PDL and FreeRTOS declarations the modules under test
+*              use, so that they build for the host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef HOST_STUBS_H_
+#define HOST_STUBS_H_
+/******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Status codes; only success and failure are told apart by the modules under test */
+#define WICED_TRUE                      (1)
+#define WICED_FALSE                     (0)
+#define TRUE                            (1)
+#define FALSE                           (0)
+#define WICED_SUCCESS                   (0)
+#define WICED_ERROR                     (1)
+#define WICED_BADARG                    (2)
+#define WICED_BT_SUCCESS                (0)
+#define WICED_BT_ERROR                  (0x10)
+#define WICED_BT_BADARG                 (0x11)
+#define WICED_BT_PENDING                (0x12)
+#define WICED_BT_BUSY                   (0x13)
+#define WICED_BT_NO_RESOURCES           (0x14)
+#define WICED_BT_UNSUPPORTED            (0x15)
+#define WICED_BT_TIMEOUT                (0x16)
+#define CY_RSLT_SUCCESS                 (0)
+
+#define BD_ADDR_LEN                     (6)
+#define BLE_ADDR_PUBLIC                 (0)
+#define BLE_ADDR_RANDOM                 (1)
+#define BTM_BLE_SCAN_MODE_PASSIVE       (0)
+#define WICED_BLE_OWN_ADDR_PUBLIC       (0)
+#define WICED_BLE_EXT_ADV_PHY_1M_BIT    (1)
+#define WICED_BLE_EXT_SCAN_BASIC_UNFILTERED_SP            (0)
+#define WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST  (0)
+#define WICED_BLE_PADV_CREATE_SYNC_OPTION_USE_PA_LIST     (1)
+#define WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_INTERVAL      (96)
+#define WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_WINDOW        (48)
+
+#define STREAM_TO_UINT8(u8, p)          {u8 = (uint8_t)(*(p)); (p) += 1;}
+#define STREAM_TO_UINT16(u16, p)        {u16 = (uint16_t)((*(p)) | ((*((p) + 1)) << 8)); (p) += 2;}
+#define STREAM_TO_UINT32(u32, p)        {u32 = ((uint32_t)(*(p))) | ((uint32_t)(*((p) + 1)) << 8) | \
+                                               ((uint32_t)(*((p) + 2)) << 16) | ((uint32_t)(*((p) + 3)) << 24); (p) += 4;}
+#define UINT8_TO_STREAM(p, u8)          {*(p)++ = (uint8_t)(u8);}
+#define UINT16_TO_STREAM(p, u16)        {*(p)++ = (uint8_t)(u16); *(p)++ = (uint8_t)((u16) >> 8);}
+#define UINT32_TO_STREAM(p, u32)        {*(p)++ = (uint8_t)(u32); *(p)++ = (uint8_t)((u32) >> 8); \
+                                         *(p)++ = (uint8_t)((u32) >> 16); *(p)++ = (uint8_t)((u32) >> 24);}
+#define STREAM_TO_ARRAY(a, p, len)      {int ijk; for (ijk = 0; ijk < (len); ijk++) ((uint8_t *)(a))[ijk] = *(p)++;}
+#define ARRAY_TO_STREAM(p, a, len)      {int ijk; for (ijk = 0; ijk < (len); ijk++) *(p)++ = (uint8_t)(a)[ijk];}
+
+/* PDL */
+#define CY_ASSERT(x)
+#define CY_ALIGN(x)                     __attribute__((aligned(x)))
+#define CY_UNUSED_PARAMETER(x)          (void)(x)
+
+/* FreeRTOS, one tick per millisecond */
+#define configTICK_RATE_HZ              (1000)
+#define configMINIMAL_STACK_SIZE        (128)
+#define portTICK_PERIOD_MS              (1)
+#define pdMS_TO_TICKS(x)                ((TickType_t)(x))
+#define tskIDLE_PRIORITY                (0)
+#define pdPASS                          (1)
+
+/* wiced_timer */
+#define WICED_TIMER_PARAM_TYPE          void *
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef uint32_t wiced_result_t;
+typedef uint8_t  wiced_bool_t;
+typedef int      wiced_bt_dev_status_t;
+typedef uint32_t cy_rslt_t;
+typedef uint8_t  wiced_bt_device_address_t[BD_ADDR_LEN];
+typedef uint8_t  wiced_bt_ble_address_type_t;
+
+typedef enum
+{
+    WICED_BLE_ADV_SET_TERMINATED_EVENT,
+    WICED_BLE_SCAN_REQUEST_RECEIVED_EVENT,
+    WICED_BLE_BIGINFO_ADV_REPORT_EVENT,
+    WICED_BLE_EXT_COMMAND_CMPLT_EVENT,
+    WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT,
+    WICED_BLE_PERIODIC_ADV_REPORT_EVENT,
+    WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT,
+    WICED_BLE_PERIODIC_ADV_SYNC_TRANSFER_EVENT,
+    WICED_BLE_PAWR_SUBEVENT_DATA_REQ_EVENT,
+    WICED_BLE_PAWR_RSP_REPORT_EVENT,
+    WICED_BLE_SET_PERIODIC_ADV_SYNC_TRANSFER_PARAM_EVENT,
+} wiced_ble_ext_adv_event_t;
+
+typedef struct
+{
+    uint8_t                     status;
+    uint16_t                    sync_handle;
+    uint8_t                     adv_sid;
+    wiced_bt_ble_address_type_t adv_addr_type;
+    wiced_bt_device_address_t   adv_addr;
+    uint8_t                     adv_phy;
+    uint16_t                    periodic_adv_int;
+    uint8_t                     adv_clock_accuracy;
+    uint8_t                     num_subevents;
+    uint8_t                     subevent_interval;
+    uint8_t                     response_slot_delay;
+    uint8_t                     response_slot_spacing;
+} wiced_ble_padv_sync_established_event_data_t;
+
+typedef struct
+{
+    uint16_t sync_handle;
+    int8_t   tx_power;
+    int8_t   rssi;
+    uint8_t  cte_type;
+    uint8_t  data_status;
+    uint8_t  data_length;
+    uint8_t  *p_data;
+    uint16_t periodic_evt_counter;
+    uint8_t  sub_event;
+} wiced_ble_padv_report_event_data_t;
+
+typedef struct
+{
+    uint16_t opcode;
+    uint8_t  status;
+} wiced_ble_ext_cmd_cmplt_t;
+
+typedef union
+{
+    wiced_ble_ext_cmd_cmplt_t                    cmd_cmplt;
+    wiced_ble_padv_sync_established_event_data_t sync_establish;
+    wiced_ble_padv_report_event_data_t           periodic_adv_report;
+    uint16_t                                     sync_handle;
+} wiced_ble_ext_adv_event_data_t;
+
+typedef void (wiced_ble_ext_adv_cback_t)(wiced_ble_ext_adv_event_t event, wiced_ble_ext_adv_event_data_t *p_data);
+
+typedef struct
+{
+    uint8_t  scan_type;
+    uint16_t scan_interval;
+    uint16_t scan_window;
+} wiced_ble_ext_scan_phy_params_t;
+
+typedef struct
+{
+    uint8_t                         own_addr_type;
+    uint8_t                         scanning_phys;
+    uint8_t                         scan_filter_policy;
+    wiced_ble_ext_scan_phy_params_t sp_1m;
+    wiced_ble_ext_scan_phy_params_t sp_coded;
+} wiced_ble_ext_scan_params_t;
+
+typedef struct
+{
+    uint8_t  filter_duplicates;
+    uint16_t scan_duration;
+    uint16_t scan_period;
+} wiced_ble_ext_scan_enable_params_t;
+
+typedef struct
+{
+    uint16_t                    event_type;
+    wiced_bt_ble_address_type_t addr_type;
+    wiced_bt_device_address_t   bd_addr;
+    uint8_t                     primary_phy;
+    uint8_t                     secondary_phy;
+    uint8_t                     adv_sid;
+    int8_t                      tx_power;
+    int8_t                      rssi;
+    uint16_t                    periodic_adv_interval;
+    wiced_bt_ble_address_type_t direct_addr_type;
+    wiced_bt_device_address_t   direct_addr;
+    uint16_t                    data_length;
+    uint8_t                     *p_data;
+} wiced_ble_ext_scan_results_t;
+
+typedef void (wiced_ble_ext_scan_result_cback_t)(wiced_ble_ext_scan_results_t *p_result);
+
+typedef struct
+{
+    uint8_t                     options;
+    uint8_t                     adv_sid;
+    wiced_bt_ble_address_type_t adv_addr_type;
+    wiced_bt_device_address_t   adv_addr;
+    uint16_t                    skip;
+    uint16_t                    sync_timeout;
+    uint8_t                     sync_cte_type;
+} wiced_ble_padv_create_sync_params_t;
+
+typedef struct
+{
+    uint16_t req_event;
+    uint8_t  req_subevent;
+    uint8_t  rsp_subevent;
+    uint8_t  rsp_slot;
+    uint8_t  rsp_data_len;
+    uint8_t  *p_data;
+} wiced_ble_padv_subevent_rsp_data_t;
+
+/* wiced_timer: a test fires callbacks itself, see host_fakes.h */
+typedef void (wiced_timer_callback_t)(WICED_TIMER_PARAM_TYPE cb_params);
+typedef enum
+{
+    WICED_SECONDS_TIMER = 1,
+    WICED_MILLI_SECONDS_TIMER,
+    WICED_SECONDS_PERIODIC_TIMER,
+    WICED_MILLI_SECONDS_PERIODIC_TIMER,
+} wiced_timer_type_t;
+typedef struct
+{
+    wiced_timer_callback_t *p_cb;
+    WICED_TIMER_PARAM_TYPE param;
+    wiced_timer_type_t     type;
+    uint32_t               period_ms;
+    uint32_t               expires_ms;
+    wiced_bool_t           in_use;
+} wiced_timer_t;
+
+/* named by the app_bt_utils.h, app_bt_event_handler.h and pawr_app.h prototypes only */
+typedef int      wiced_bt_management_evt_t;
+typedef union { int unused; } wiced_bt_management_evt_data_t;
+typedef int      wiced_bt_ble_advert_mode_t;
+typedef int      wiced_bt_gatt_disconn_reason_t;
+typedef int      wiced_bt_gatt_status_t;
+typedef int      wiced_bt_smp_status_t;
+typedef struct { uint8_t key[16]; } wiced_bt_device_sec_keys_t;
+typedef struct { uint8_t key[16]; } wiced_bt_local_identity_keys_t;
+
+/* FreeRTOS */
+typedef uint32_t      TickType_t;
+typedef long          BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef void          *TaskHandle_t;
+
+/******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+wiced_bt_dev_status_t wiced_ble_padv_set_subevent_rsp_data(uint16_t sync_handle, wiced_ble_padv_subevent_rsp_data_t *p_rsp);
+wiced_bt_dev_status_t wiced_ble_ext_scan_set_params(wiced_ble_ext_scan_params_t *p_params);
+wiced_bt_dev_status_t wiced_ble_ext_scan_enable(uint8_t enable, wiced_ble_ext_scan_enable_params_t *p_params);
+wiced_bt_dev_status_t wiced_ble_ext_scan_register_cb(wiced_ble_ext_scan_result_cback_t *p_cback);
+wiced_bt_dev_status_t wiced_ble_padv_create_sync(wiced_ble_padv_create_sync_params_t *p_params);
+wiced_bt_dev_status_t wiced_ble_padv_cancel_sync(void);
+wiced_bt_dev_status_t wiced_ble_padv_terminate_sync(uint16_t sync_handle);
+wiced_bt_dev_status_t wiced_ble_padv_set_sync_subevent(uint16_t sync_handle, uint16_t properties, uint8_t num, uint8_t *p_subevents);
+wiced_bt_dev_status_t wiced_ble_padv_add_device_to_list(wiced_bt_ble_address_type_t type, wiced_bt_device_address_t addr, uint8_t sid);
+wiced_bt_dev_status_t wiced_ble_padv_clear_list(void);
+void wiced_ble_ext_adv_register_cback(wiced_ble_ext_adv_cback_t *p_cback);
+wiced_bt_dev_status_t wiced_bt_ble_observe(wiced_bool_t start, uint8_t duration, void *p_cback);
+wiced_result_t wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bd_addr, wiced_bt_ble_address_type_t addr_type);
+void wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr);
+
+wiced_result_t wiced_init_timer(wiced_timer_t *p_timer, wiced_timer_callback_t *p_cb, WICED_TIMER_PARAM_TYPE param, wiced_timer_type_t type);
+wiced_result_t wiced_start_timer(wiced_timer_t *p_timer, uint32_t timeout);
+wiced_result_t wiced_stop_timer(wiced_timer_t *p_timer);
+wiced_bool_t wiced_is_timer_in_use(wiced_timer_t *p_timer);
+
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskCreate(void (*p_fn)(void *), const char *p_name, uint32_t depth, void *p_arg, UBaseType_t prio, TaskHandle_t *p_handle);
+
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t state);
+uint64_t Cy_SysLib_GetUniqueId(void);
+#endif /* HOST_STUBS_H_ */
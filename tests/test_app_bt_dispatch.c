@@ -0,0 +1,177 @@
+/******************************************************************************
+* File Name:   test_app_bt_dispatch.c
+*
+* Description: This file tests the event dispatch table: handler order, separate domains, results,
+*              unhandled events and the subscription limits.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define CALLS_MAX                       (8)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static char           calls[CALLS_MAX + 1];      /* handler tags in call order */
+static uint8_t        num_calls;
+static void          *last_data;
+static uint32_t       last_event;
+static wiced_result_t fail_result = WICED_BT_SUCCESS;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void record(char tag, uint32_t event, void *p_event_data)
+{
+    TEST_CHECK(num_calls < CALLS_MAX);
+    calls[num_calls++] = tag;
+    calls[num_calls]   = '\0';
+    last_event         = event;
+    last_data          = p_event_data;
+}
+
+static wiced_result_t handler_a(uint32_t event, void *p_event_data)
+{
+    record('a', event, p_event_data);
+    return WICED_BT_SUCCESS;
+}
+
+static wiced_result_t handler_b(uint32_t event, void *p_event_data)
+{
+    record('b', event, p_event_data);
+    return fail_result;
+}
+
+static wiced_result_t handler_c(uint32_t event, void *p_event_data)
+{
+    record('c', event, p_event_data);
+    return WICED_BT_SUCCESS;
+}
+
+static wiced_result_t dispatch(app_bt_dispatch_domain_t domain, uint32_t event, void *p_event_data)
+{
+    num_calls = 0;
+    calls[0]  = '\0';
+    return app_bt_dispatch(domain, event, p_event_data);
+}
+
+static void test_chain_order(void)
+{
+    app_bt_dispatch_stats_t stats;
+    int                     data;
+
+    app_bt_dispatch_init();
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, 5, handler_a) == WICED_SUCCESS);
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_BTM, 5, handler_c) == WICED_SUCCESS);
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, 5, handler_b) == WICED_SUCCESS);
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_ADV, 5, handler_c) == WICED_SUCCESS);
+
+    /* handlers of one event run in subscription order and see the event data */
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_EXT_ADV, 5, &data) == WICED_BT_SUCCESS);
+    TEST_CHECK((strcmp(calls, "abc") == 0) && (last_event == 5) && (last_data == &data));
+
+    /* domains are separate tables */
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_BTM, 5, NULL) == WICED_BT_SUCCESS);
+    TEST_CHECK(strcmp(calls, "c") == 0);
+
+    /* a failing handler does not stop the chain; its result is returned */
+    fail_result = WICED_BT_BADARG;
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_EXT_ADV, 5, NULL) == WICED_BT_BADARG);
+    TEST_CHECK(strcmp(calls, "abc") == 0);
+    fail_result = WICED_BT_SUCCESS;
+
+    app_bt_dispatch_get_stats(APP_BT_DISPATCH_EXT_ADV, 5, &stats);
+    TEST_CHECK(stats.count == 2);
+    app_bt_dispatch_get_stats(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_MAX_EVENTS, &stats);
+    TEST_CHECK(stats.count == 0);
+}
+
+static void test_unhandled_and_bounds(void)
+{
+    app_bt_dispatch_stats_t stats;
+
+    app_bt_dispatch_init();
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, handler_a) == WICED_SUCCESS);
+
+    /* no subscriber, an event id past the table and an unknown domain reach no handler */
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_EXT_SCAN, 1, NULL) == WICED_BT_ERROR);
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_MAX_EVENTS, NULL) == WICED_BT_ERROR);
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_DOMAIN_NUM, 0, NULL) == WICED_BT_ERROR);
+    TEST_CHECK(num_calls == 0);
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, NULL) == WICED_BT_SUCCESS);
+    TEST_CHECK(num_calls == 1);
+
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_DOMAIN_NUM, 0, handler_a) == WICED_BADARG);
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_BTM, APP_BT_DISPATCH_MAX_EVENTS, handler_a) == WICED_BADARG);
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_BTM, 0, NULL) == WICED_BADARG);
+
+    /* init forgets subscriptions and statistics */
+    app_bt_dispatch_init();
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, NULL) == WICED_BT_ERROR);
+    app_bt_dispatch_get_stats(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, &stats);
+    TEST_CHECK(stats.count == 0);
+}
+
+static void test_table_full(void)
+{
+    uint8_t i;
+
+    app_bt_dispatch_init();
+    for (i = 0; i < APP_BT_DISPATCH_MAX_SUBS; i++)
+    {
+        TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_BTM, i, handler_a) == WICED_SUCCESS);
+    }
+    TEST_CHECK(app_bt_dispatch_subscribe(APP_BT_DISPATCH_BTM, 0, handler_b) == WICED_BT_NO_RESOURCES);
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_BTM, 0, NULL) == WICED_BT_SUCCESS);
+    TEST_CHECK(strcmp(calls, "a") == 0);
+    TEST_CHECK(dispatch(APP_BT_DISPATCH_BTM, APP_BT_DISPATCH_MAX_SUBS - 1, NULL) == WICED_BT_SUCCESS);
+}
+
+int main(void)
+{
+    test_chain_order();
+    test_unhandled_and_bounds();
+    test_table_full();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,227 @@
+/******************************************************************************
+* File Name:   test_app_bt_ring.c
+*
+* Description: This file tests the SPSC ring from one thread: arguments, full and empty rings, partial
+*              batches, peek, and index wraparound.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "app_bt_ring.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define RING_CAP                        (8)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+APP_BT_RING_DEFINE_BUF(ring_buf, sizeof(uint32_t), RING_CAP);
+static app_bt_ring_t ring;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* Moves both free running indexes to start, as if start elements had passed through. */
+static void ring_reset_at(uint32_t start)
+{
+    TEST_CHECK(app_bt_ring_init(&ring, ring_buf, sizeof(uint32_t), RING_CAP) == WICED_SUCCESS);
+    atomic_store(&ring.head, start);
+    atomic_store(&ring.tail, start);
+    ring.tail_cache = start;
+    ring.head_cache = start;
+}
+
+static void test_init_args(void)
+{
+    TEST_CHECK(app_bt_ring_init(NULL, ring_buf, 4, RING_CAP) == WICED_BADARG);
+    TEST_CHECK(app_bt_ring_init(&ring, NULL, 4, RING_CAP) == WICED_BADARG);
+    TEST_CHECK(app_bt_ring_init(&ring, ring_buf, 0, RING_CAP) == WICED_BADARG);
+    TEST_CHECK(app_bt_ring_init(&ring, ring_buf, 4, 0) == WICED_BADARG);
+    TEST_CHECK(app_bt_ring_init(&ring, ring_buf, 4, 6) == WICED_BADARG);
+    TEST_CHECK(app_bt_ring_init(&ring, ring_buf, 4, 1) == WICED_SUCCESS);
+    TEST_CHECK(app_bt_ring_init(&ring, ring_buf, 4, RING_CAP) == WICED_SUCCESS);
+}
+
+static void test_empty_and_full(void)
+{
+    uint32_t v;
+    uint32_t i;
+    uint32_t out[RING_CAP];
+
+    ring_reset_at(0);
+    TEST_CHECK(app_bt_ring_count(&ring) == 0);
+    TEST_CHECK(app_bt_ring_peek(&ring) == NULL);
+    TEST_CHECK(!app_bt_ring_pop(&ring, &v));
+    TEST_CHECK(app_bt_ring_pop_batch(&ring, out, RING_CAP) == 0);
+
+    /* a full ring uses every element */
+    for (i = 0; i < RING_CAP; i++)
+    {
+        TEST_CHECK(app_bt_ring_push(&ring, &i));
+    }
+    TEST_CHECK(app_bt_ring_count(&ring) == RING_CAP);
+    v = 99;
+    TEST_CHECK(!app_bt_ring_push(&ring, &v));
+    TEST_CHECK(app_bt_ring_get_overflow(&ring) == 1);
+
+    /* the oldest element is peeked in place and stays until popped */
+    TEST_CHECK(*(uint32_t *)app_bt_ring_peek(&ring) == 0);
+    TEST_CHECK(*(uint32_t *)app_bt_ring_peek(&ring) == 0);
+    TEST_CHECK(app_bt_ring_pop(&ring, &v) && (v == 0));
+    TEST_CHECK(*(uint32_t *)app_bt_ring_peek(&ring) == 1);
+
+    /* one slot free again */
+    v = 8;
+    TEST_CHECK(app_bt_ring_push(&ring, &v));
+    TEST_CHECK(app_bt_ring_pop_batch(&ring, out, RING_CAP) == RING_CAP);
+    for (i = 0; i < RING_CAP; i++)
+    {
+        TEST_CHECK(out[i] == i + 1);
+    }
+    TEST_CHECK(app_bt_ring_count(&ring) == 0);
+    TEST_CHECK(app_bt_ring_peek(&ring) == NULL);
+}
+
+static void test_partial_batch(void)
+{
+    uint32_t in[RING_CAP + 3];
+    uint32_t out[RING_CAP + 3];
+    uint32_t i;
+
+    ring_reset_at(0);
+    for (i = 0; i < RING_CAP + 3; i++)
+    {
+        in[i] = 100 + i;
+    }
+    TEST_CHECK(app_bt_ring_push_batch(&ring, in, 5) == 5);
+    /* only what fits goes in, the rest counts as overflow */
+    TEST_CHECK(app_bt_ring_push_batch(&ring, &in[5], 6) == RING_CAP - 5);
+    TEST_CHECK(app_bt_ring_get_overflow(&ring) == 6 - (RING_CAP - 5));
+    TEST_CHECK(app_bt_ring_push_batch(&ring, in, 1) == 0);
+
+    /* pops are capped at max_num, and at what is queued */
+    TEST_CHECK(app_bt_ring_pop_batch(&ring, out, 3) == 3);
+    TEST_CHECK((out[0] == 100) && (out[2] == 102));
+    TEST_CHECK(app_bt_ring_pop_batch(&ring, out, RING_CAP + 3) == RING_CAP - 3);
+    for (i = 0; i < RING_CAP - 3; i++)
+    {
+        TEST_CHECK(out[i] == 103 + i);
+    }
+    TEST_CHECK(ring.pushed == RING_CAP);
+    TEST_CHECK(ring.popped == RING_CAP);
+}
+
+/* Batches that straddle the end of the storage, with the free running indexes passing 2^32. */
+static void test_wraparound(void)
+{
+    uint32_t in[RING_CAP];
+    uint32_t out[RING_CAP];
+    uint32_t next_in  = 0;
+    uint32_t next_out = 0;
+    uint32_t round;
+    uint32_t n;
+    uint32_t k;
+    uint32_t i;
+
+    ring_reset_at(0xFFFFFFF0u);
+    for (round = 0; round < 64; round++)
+    {
+        n = 1 + (round * 5) % RING_CAP;
+        for (i = 0; i < n; i++)
+        {
+            in[i] = next_in + i;
+        }
+        k = app_bt_ring_push_batch(&ring, in, n);
+        next_in += k;
+        TEST_CHECK(app_bt_ring_count(&ring) == next_in - next_out);
+        TEST_CHECK(app_bt_ring_count(&ring) <= RING_CAP);
+
+        n = 1 + (round * 3) % RING_CAP;
+        k = app_bt_ring_pop_batch(&ring, out, n);
+        for (i = 0; i < k; i++)
+        {
+            TEST_CHECK(out[i] == next_out + i);
+        }
+        next_out += k;
+    }
+    TEST_CHECK(atomic_load(&ring.head) < 0xFFFFFFF0u);  /* the index did pass 2^32 */
+    while ((k = app_bt_ring_pop_batch(&ring, out, RING_CAP)) != 0)
+    {
+        for (i = 0; i < k; i++)
+        {
+            TEST_CHECK(out[i] == next_out + i);
+        }
+        next_out += k;
+    }
+    TEST_CHECK(next_out == next_in);
+}
+
+/* Elements of an odd size keep their bytes across the wrap. */
+static void test_elem_size(void)
+{
+    APP_BT_RING_DEFINE_BUF(buf3, 3, 4);
+    app_bt_ring_t r3;
+    uint8_t       in[3 * 3];
+    uint8_t       out[3 * 4];
+    uint8_t       i;
+
+    TEST_CHECK(app_bt_ring_init(&r3, buf3, 3, 4) == WICED_SUCCESS);
+    for (i = 0; i < sizeof(in); i++)
+    {
+        in[i] = (uint8_t)(0xA0 + i);
+    }
+    TEST_CHECK(app_bt_ring_push_batch(&r3, in, 3) == 3);
+    TEST_CHECK(app_bt_ring_pop_batch(&r3, out, 2) == 2);
+    TEST_CHECK(app_bt_ring_push_batch(&r3, in, 3) == 3);     /* wraps after one element */
+    TEST_CHECK(app_bt_ring_pop_batch(&r3, out, 4) == 4);
+    TEST_CHECK(memcmp(out, &in[6], 3) == 0);
+    TEST_CHECK(memcmp(&out[3], in, sizeof(in)) == 0);
+}
+
+int main(void)
+{
+    test_init_args();
+    test_empty_and_full();
+    test_partial_batch();
+    test_wraparound();
+    test_elem_size();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,151 @@
+/******************************************************************************
+* File Name:   test_app_bt_ring_stress.c
+*
+* Description: This file runs the SPSC ring between two threads, built with ThreadSanitizer: one pushes a
+*              counting sequence in batches of varying size, the other pops and checks it arrives whole
+*              and in order.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <pthread.h>
+#include "host_test.h"
+#include "app_bt_ring.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define STRESS_CAP                      (16)
+#define STRESS_ELEMS                    (200000u)
+#define STRESS_BATCH_MAX                (STRESS_CAP + 3)  /* larger than the ring on purpose */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+APP_BT_RING_DEFINE_BUF(stress_buf, sizeof(uint64_t), STRESS_CAP);
+static app_bt_ring_t stress_ring;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* Gives the other side the core; the host may have a single one, where spinning starves it. */
+static void stress_wait(void)
+{
+    const struct timespec ts = {0, 1000};
+
+    nanosleep(&ts, NULL);
+}
+
+/* Producer thread: retries whatever did not fit, so every value is sent exactly once. */
+static void *stress_producer(void *p_arg)
+{
+    uint64_t batch[STRESS_BATCH_MAX];
+    uint64_t next = 0;
+    uint32_t n    = 1;
+    uint32_t k;
+    uint32_t i;
+
+    while (next < STRESS_ELEMS)
+    {
+        n = (n * 7 + 3) % STRESS_BATCH_MAX + 1;
+        if (n > STRESS_ELEMS - next)
+        {
+            n = (uint32_t)(STRESS_ELEMS - next);
+        }
+        for (i = 0; i < n; i++)
+        {
+            batch[i] = next + i;
+        }
+        k = (n == 1) ? (uint32_t)app_bt_ring_push(&stress_ring, batch) : app_bt_ring_push_batch(&stress_ring, batch, n);
+        next += k;
+        if (k == 0)
+        {
+            stress_wait();
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t producer;
+    uint64_t  batch[STRESS_BATCH_MAX];
+    uint64_t  expect = 0;
+    uint32_t  n      = 1;
+    uint32_t  k;
+    uint32_t  i;
+    uint64_t *p_peek;
+
+    TEST_CHECK(app_bt_ring_init(&stress_ring, stress_buf, sizeof(uint64_t), STRESS_CAP) == WICED_SUCCESS);
+    TEST_CHECK(pthread_create(&producer, NULL, stress_producer, NULL) == 0);
+    while (expect < STRESS_ELEMS)
+    {
+        /* alternate peek/pop with batch pops, as the backlog and OTA tasks do */
+        if ((expect & 1) == 0)
+        {
+            p_peek = app_bt_ring_peek(&stress_ring);
+            if (p_peek != NULL)
+            {
+                TEST_CHECK(*p_peek == expect);
+                TEST_CHECK(app_bt_ring_pop(&stress_ring, batch) && (batch[0] == expect));
+                expect++;
+            }
+            else
+            {
+                stress_wait();
+            }
+            continue;
+        }
+        n = (n * 5 + 1) % STRESS_BATCH_MAX + 1;
+        k = app_bt_ring_pop_batch(&stress_ring, batch, n);
+        for (i = 0; i < k; i++)
+        {
+            TEST_CHECK(batch[i] == expect + i);
+        }
+        expect += k;
+        if (k == 0)
+        {
+            stress_wait();
+        }
+        TEST_CHECK(app_bt_ring_count(&stress_ring) <= STRESS_CAP);
+    }
+    TEST_CHECK(pthread_join(producer, NULL) == 0);
+    TEST_CHECK(app_bt_ring_count(&stress_ring) == 0);
+    TEST_CHECK(stress_ring.pushed == STRESS_ELEMS);
+    TEST_CHECK(stress_ring.popped == STRESS_ELEMS);
+    TEST_PASS();
+    return 0;
+}
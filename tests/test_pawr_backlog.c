@@ -0,0 +1,427 @@
+/******************************************************************************
+* File Name:   test_pawr_backlog.c
+*
+* Description: This file tests the uplink backlog: packing of drain responses, the RAM queues, spilling
+*              to and draining from a RAM stand-in of the serial flash, wrap-around of the flash region,
+*              and store failures.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <setjmp.h>
+#include "host_test.h"
+#include "pawr_backlog.h"
+#include "pawr_flash.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define REC_LEN                         (8)
+#define SECTOR_LEN                      (4096)
+#define ENTRY_LEN                       (5 + REC_LEN)    /* stored: len, enqueue time, data */
+#define PAGE_ENTRIES                    ((PAWR_BACKLOG_PAGE_LEN - 1) / ENTRY_LEN)
+#define EVT_MS                          (100)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* serial flash stand-in over the backlog region: erase before program, as NOR flash */
+static uint8_t      flash[PAWR_CFG_BACKLOG_FLASH_SIZE];
+static uint32_t     flash_sector = SECTOR_LEN;
+static uint32_t     flash_writes;
+static uint32_t     flash_reads;
+static wiced_bool_t flash_fail;
+
+/* response scheduler stand-in: what went out, checked record by record */
+static uint8_t      rsp_slots = 1;
+static uint8_t      rsp_depth;                   /* telemetry queued this event */
+static wiced_bool_t rsp_full;
+static uint32_t     rx_records;
+static uint32_t     rx_msgs;
+static uint16_t     rx_next;                     /* sequence number expected next */
+static uint32_t     rx_gaps;
+static uint32_t     rx_age_max_ms;
+static uint16_t     put_seq;
+
+static jmp_buf      task_idle;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+wiced_bool_t pawr_flash_init(void)
+{
+    memset(flash, 0xFF, sizeof(flash));
+    return WICED_TRUE;
+}
+
+uint32_t pawr_flash_erase_size(uint32_t addr)
+{
+    return flash_sector;
+}
+
+wiced_bool_t pawr_flash_erase(uint32_t addr, uint32_t len)
+{
+    addr -= PAWR_CFG_BACKLOG_FLASH_ADDR;
+    TEST_CHECK(((addr % flash_sector) == 0) && ((len % flash_sector) == 0) && (addr + len <= sizeof(flash)));
+    memset(&flash[addr], 0xFF, len);
+    return !flash_fail;
+}
+
+wiced_bool_t pawr_flash_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    uint32_t i;
+
+    addr -= PAWR_CFG_BACKLOG_FLASH_ADDR;
+    TEST_CHECK((len <= PAWR_BACKLOG_PAGE_LEN) && (addr + len <= sizeof(flash)));
+    if (flash_fail)
+    {
+        return WICED_FALSE;
+    }
+    for (i = 0; i < len; i++)
+    {
+        TEST_CHECK(flash[addr + i] == 0xFF);
+    }
+    memcpy(&flash[addr], p_data, len);
+    flash_writes++;
+    return WICED_TRUE;
+}
+
+wiced_bool_t pawr_flash_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    addr -= PAWR_CFG_BACKLOG_FLASH_ADDR;
+    TEST_CHECK(addr + len <= sizeof(flash));
+    memcpy(p_data, &flash[addr], len);
+    flash_reads++;
+    return WICED_TRUE;
+}
+
+uint8_t pawr_rsp_sched_num_slots(uint8_t subevent)
+{
+    return rsp_slots;
+}
+
+void pawr_rsp_sched_get_stats(pawr_rsp_prio_t prio, pawr_rsp_sched_stats_t *p_stats)
+{
+    memset(p_stats, 0, sizeof(*p_stats));
+    p_stats->depth = rsp_depth;
+}
+
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    uint16_t off = PAWR_BACKLOG_MSG_HDR_LEN;
+    uint16_t seq;
+    uint32_t age_ms;
+    uint8_t  i;
+
+    TEST_CHECK(prio == PAWR_RSP_PRIO_TELEMETRY);
+    TEST_CHECK((data_len <= PAWR_BACKLOG_MSG_MAX_LEN) && (p_data[0] == PAWR_MSG_TYPE_BACKLOG));
+    if (rsp_full)
+    {
+        return WICED_BT_NO_RESOURCES;
+    }
+    while (off < data_len)
+    {
+        TEST_CHECK((p_data[off] == REC_LEN) && (off + PAWR_BACKLOG_REC_HDR_LEN + REC_LEN <= data_len));
+        age_ms = ((uint32_t)p_data[off + 1] | ((uint32_t)p_data[off + 2] << 8)) * PAWR_BACKLOG_AGE_UNIT_MS;
+        seq    = (uint16_t)(p_data[off + 3] | (p_data[off + 4] << 8));
+        for (i = 2; i < REC_LEN; i++)
+        {
+            TEST_CHECK(p_data[off + 3 + i] == (uint8_t)(seq + i));
+        }
+        TEST_CHECK((int16_t)(seq - rx_next) >= 0);
+        rx_gaps      += (seq != rx_next);
+        rx_next       = (uint16_t)(seq + 1);
+        rx_age_max_ms = (age_ms > rx_age_max_ms) ? age_ms : rx_age_max_ms;
+        rx_records++;
+        off = (uint16_t)(off + PAWR_BACKLOG_REC_HDR_LEN + REC_LEN);
+    }
+    TEST_CHECK(off == data_len);
+    /* pending after this message */
+    TEST_CHECK(((uint32_t)p_data[1] | ((uint32_t)p_data[2] << 8)) == pawr_backlog_depth());
+    rsp_depth++;
+    rx_msgs++;
+    return WICED_BT_SUCCESS;
+}
+
+/* the backlog task calls it only when it has nothing to move */
+void vTaskDelay(TickType_t ticks)
+{
+    longjmp(task_idle, 1);
+}
+
+/* runs the backlog task until it waits */
+static void pump(void)
+{
+    if (setjmp(task_idle) == 0)
+    {
+        host_task_fn[host_num_tasks - 1](NULL);
+    }
+}
+
+static wiced_bool_t put(void)
+{
+    uint8_t rec[REC_LEN];
+    uint8_t i;
+
+    rec[0] = (uint8_t)put_seq;
+    rec[1] = (uint8_t)(put_seq >> 8);
+    for (i = 2; i < REC_LEN; i++)
+    {
+        rec[i] = (uint8_t)(put_seq + i);
+    }
+    if (!pawr_backlog_put(rec, REC_LEN))
+    {
+        return WICED_FALSE;
+    }
+    put_seq++;
+    return WICED_TRUE;
+}
+
+/* one periodic event over both subevents, then the task catches up */
+static void event(void)
+{
+    uint8_t subevent;
+
+    host_advance_ms(EVT_MS);
+    for (subevent = 0; subevent < PAWR_CFG_SUBEVENT_TABLE_LEN; subevent++)
+    {
+        rsp_depth = 0;
+        pawr_backlog_drain(subevent);
+    }
+    pump();
+}
+
+static void restart(const pawr_backlog_store_t *p_store)
+{
+    host_num_tasks = 0;                          /* the previous task is abandoned */
+    pawr_backlog_init();
+    pawr_backlog_set_store(p_store);
+    put_seq       = 0;
+    rx_next       = 0;
+    rx_records    = 0;
+    rx_msgs       = 0;
+    rx_gaps       = 0;
+    rx_age_max_ms = 0;
+}
+
+static void test_ram(void)
+{
+    pawr_backlog_stats_t stats;
+    uint8_t              rec[PAWR_BACKLOG_MAX_REC_LEN + 1] = {0};
+    uint32_t             age;
+    uint8_t              i;
+
+    restart(NULL);
+    TEST_CHECK(!pawr_backlog_put(rec, 0) && !pawr_backlog_put(rec, PAWR_BACKLOG_MAX_REC_LEN + 1));
+    for (i = 0; i < 5; i++)
+    {
+        TEST_CHECK(put());
+    }
+    pump();
+    host_advance_ms(2500);
+
+    /* nothing goes out unsynced, or outside the subevent table */
+    TEST_CHECK(pawr_backlog_drain(0) == 0);
+    pawr_backlog_on_sync();
+    TEST_CHECK(pawr_backlog_drain(PAWR_CFG_SUBEVENT_TABLE_LEN) == 0);
+    TEST_CHECK((pawr_backlog_get_demand(&age) == 2) && (age == 2500));   /* 4 and 1 */
+
+    /* no slot left beside the telemetry queued already */
+    rsp_depth = 1;
+    TEST_CHECK(pawr_backlog_drain(0) == 0);
+    rsp_depth = 0;
+
+    /* full size messages, one per free slot, oldest first with their age */
+    rsp_slots = 3;
+    TEST_CHECK(pawr_backlog_drain(0) == 2);
+    rsp_slots = 1;
+    TEST_CHECK((pawr_backlog_depth() == 0) && (pawr_backlog_get_demand(&age) == 0) && (age == 0));
+    TEST_CHECK((rx_records == 5) && (rx_msgs == 2) && (rx_gaps == 0) && (rx_age_max_ms == 2500));
+
+    pawr_backlog_get_stats(&stats);
+    TEST_CHECK((stats.put == 5) && (stats.drained == 5) && (stats.drain_msgs == 2) && (stats.dropped == 0));
+
+    /* a message the scheduler refuses is lost, and counted as such */
+    TEST_CHECK(put() && put());
+    pump();
+    rsp_depth = 0;
+    rsp_full  = WICED_TRUE;
+    TEST_CHECK((pawr_backlog_drain(0) == 0) && (pawr_backlog_depth() == 0));
+    rsp_full = WICED_FALSE;
+    pawr_backlog_get_stats(&stats);
+    TEST_CHECK((stats.put == 7) && (stats.drained == 5) && (stats.dropped == 2));
+    TEST_CHECK((stats.spilled_pages == 0) && (flash_writes == 0));
+}
+
+/* the task falls behind: puts beyond the RAM are refused and counted */
+static void test_put_ring_full(void)
+{
+    pawr_backlog_stats_t stats;
+    uint32_t             n = 0;
+
+    restart(NULL);
+    while (put())
+    {
+        n++;
+    }
+    TEST_CHECK(n == (PAWR_CFG_BACKLOG_RAM_LEN / 2) / ENTRY_LEN);
+    pawr_backlog_get_stats(&stats);
+    TEST_CHECK((stats.dropped == 1) && (stats.put == n) && (stats.records == n));
+    pump();
+    TEST_CHECK(put());
+}
+
+/* an outage spills to the flash; after the sync everything drains in order while new records keep coming */
+static void test_outage(void)
+{
+    pawr_backlog_stats_t stats;
+    uint32_t             age;
+    uint32_t             demand;
+    uint32_t             reads;
+    uint32_t             t;
+    uint32_t             n;
+
+    restart(NULL);
+    for (t = 0; t < 3000; t++)
+    {
+        host_advance_ms(1000);
+        TEST_CHECK(put());
+        pump();
+    }
+    pawr_backlog_get_stats(&stats);
+    TEST_CHECK((stats.records == 3000) && (stats.dropped == 0) && (stats.store_errors == 0));
+    TEST_CHECK((stats.flash_pages > 0) && (stats.spilled_pages == stats.flash_pages));
+    TEST_CHECK(stats.oldest_age_ms == 2999U * 1000);
+
+    /* the stack side sizes the backlog without touching the flash */
+    reads  = flash_reads;
+    demand = pawr_backlog_get_demand(&age);
+    TEST_CHECK(flash_reads == reads);
+    TEST_CHECK((demand == (3000 + 3) / 4) && (age == 2999U * 1000));
+
+    pawr_backlog_on_sync();
+    for (n = 0; (pawr_backlog_depth() != 0) && (n < 100000); n++)
+    {
+        if ((n % 10) == 0)
+        {
+            TEST_CHECK(put());
+        }
+        event();
+    }
+    TEST_CHECK(pawr_backlog_depth() == 0);
+    TEST_CHECK((rx_records == put_seq) && (rx_next == put_seq) && (rx_gaps == 0));
+    TEST_CHECK(rx_age_max_ms >= 2999U * 1000);
+
+    /* two subevents of one slot, 4 records a message: 80 records a second */
+    pawr_backlog_get_stats(&stats);
+    TEST_CHECK((stats.drained == put_seq) && (stats.flash_pages == 0));
+    TEST_CHECK((stats.drained * 1000ULL / stats.drain_ms) >= 75);
+    pawr_backlog_print_stats();
+}
+
+/* a longer outage than the flash holds gives up the oldest sectors; the rest arrives in order */
+static void test_wrap(void)
+{
+    pawr_backlog_stats_t stats;
+    uint32_t             n;
+
+    restart(NULL);
+    for (n = 0; n < 6000; n++)
+    {
+        host_advance_ms(1000);
+        TEST_CHECK(put());
+        pump();
+    }
+    pawr_backlog_get_stats(&stats);
+    TEST_CHECK((stats.dropped > 0) && ((stats.dropped % (PAGE_ENTRIES * (SECTOR_LEN / PAWR_BACKLOG_PAGE_LEN))) == 0));
+    TEST_CHECK(stats.records + stats.dropped == 6000);
+    TEST_CHECK(stats.flash_pages <= PAWR_CFG_BACKLOG_FLASH_SIZE / PAWR_BACKLOG_PAGE_LEN);
+
+    pawr_backlog_on_sync();
+    for (n = 0; (pawr_backlog_depth() != 0) && (n < 100000); n++)
+    {
+        event();
+    }
+    TEST_CHECK((rx_records + stats.dropped == 6000) && (rx_next == 6000));
+    TEST_CHECK(rx_gaps == 1);
+}
+
+/* a store that fails, or whose sectors do not fit the region, keeps the backlog to RAM */
+static void test_store_failure(void)
+{
+    pawr_backlog_stats_t stats;
+    uint32_t             n;
+    uint32_t             writes = flash_writes;
+
+    for (n = 0; n < 2; n++)
+    {
+        restart(NULL);
+        flash_fail   = (n == 0);
+        flash_sector = (n == 0) ? SECTOR_LEN : 128;
+        while (put_seq < 200)
+        {
+            TEST_CHECK(put());
+            pump();
+        }
+        pawr_backlog_get_stats(&stats);
+        TEST_CHECK((stats.dropped > 0) && (stats.flash_pages == 0) && (stats.records + stats.dropped == 200));
+        TEST_CHECK(stats.store_errors == ((n == 0) ? stats.dropped / PAGE_ENTRIES : 0));
+        TEST_CHECK(flash_writes == writes);
+
+        pawr_backlog_on_sync();
+        while (pawr_backlog_depth() != 0)
+        {
+            event();
+        }
+        TEST_CHECK(rx_records == stats.records);
+        pawr_backlog_on_sync_lost();
+    }
+    flash_fail   = WICED_FALSE;
+    flash_sector = SECTOR_LEN;
+}
+
+int main(void)
+{
+    test_ram();
+    test_put_ring_full();
+    test_outage();
+    test_wrap();
+    test_store_failure();
+    TEST_PASS();
+    return 0;
+}
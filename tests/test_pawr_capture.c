@@ -0,0 +1,293 @@
+/******************************************************************************
+* File Name:   test_pawr_capture.c
+*
+* Description: This file records a PAwR session through the stack callback with capture enabled and
+*              checks that pawr_cap_replay() reproduces every response of the recording, and that it
+*              notices a recording that differs.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_app.h"
+#include "pawr_msg.h"
+#include "pawr_capture.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SYNC_HANDLE                     (0x0040)
+#define SESSION_EVENTS                  (200)
+#define STREAM_MAX                      (64 * 1024)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static wiced_ble_ext_adv_cback_t *ext_adv_cback;
+static uint8_t                    stream[STREAM_MAX];
+static uint32_t                   stream_len;
+static uint32_t                   num_rsp;
+static uint16_t                   evt = 300;
+
+const char brcm_patch_version[] = "host";
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+void wiced_ble_ext_adv_register_cback(wiced_ble_ext_adv_cback_t *p_cback)
+{
+    ext_adv_cback = p_cback;
+}
+
+wiced_bt_dev_status_t wiced_ble_padv_set_subevent_rsp_data(uint16_t sync_handle, wiced_ble_padv_subevent_rsp_data_t *p_rsp)
+{
+    num_rsp++;
+    return WICED_BT_SUCCESS;
+}
+
+/* what the drain task would print, collected as a stream */
+static void drain(void)
+{
+    uint16_t len;
+
+    while ((len = pawr_cap_read(&stream[stream_len], PAWR_CAP_REC_MAX_LEN)) != 0)
+    {
+        stream_len += len;
+        TEST_CHECK(stream_len + PAWR_CAP_REC_MAX_LEN <= sizeof(stream));
+    }
+}
+
+static void sync_up(void)
+{
+    wiced_ble_ext_adv_event_data_t ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.sync_establish.status            = WICED_BT_SUCCESS;
+    ev.sync_establish.sync_handle       = SYNC_HANDLE;
+    ev.sync_establish.periodic_adv_int  = 80;
+    ev.sync_establish.num_subevents     = PAWR_CFG_NUM_SUBEVENTS;
+    ev.sync_establish.subevent_interval = 20;
+    ext_adv_cback(WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT, &ev);
+    drain();
+}
+
+static void sync_lost(void)
+{
+    wiced_ble_ext_adv_event_data_t ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.sync_handle = SYNC_HANDLE;
+    ext_adv_cback(WICED_BLE_PERIODIC_ADV_SYNC_LOST_EVENT, &ev);
+    drain();
+}
+
+static void report(uint8_t subevent, const uint8_t *p_msg, uint8_t len)
+{
+    wiced_ble_ext_adv_event_data_t ev;
+    uint8_t                        msg[PAWR_BUF_SIZE + 2];
+
+    memcpy(msg, p_msg, len);
+    memset(&ev, 0, sizeof(ev));
+    ev.periodic_adv_report.sync_handle          = SYNC_HANDLE;
+    ev.periodic_adv_report.rssi                 = -60;
+    ev.periodic_adv_report.data_length          = len;
+    ev.periodic_adv_report.p_data               = msg;
+    ev.periodic_adv_report.periodic_evt_counter = evt;
+    ev.periodic_adv_report.sub_event            = subevent;
+    ext_adv_cback(WICED_BLE_PERIODIC_ADV_REPORT_EVENT, &ev);
+    drain();
+}
+
+/* a session as the app sees it on the device: demo requests echoed in the app's slot, requests
+ * it rejects, empty reports, and reliable messages acknowledged, some of them repeated */
+static void record_session(void)
+{
+    uint8_t  demo[PAWR_BUF_SIZE];
+    uint8_t  rel[] = {PAWR_MSG_TYPE_RELIABLE, 0, PAWR_MSG_TYPE_APP, 0x5A};
+    uint16_t i;
+    uint8_t  j;
+
+    sync_up();
+    for (i = 0; i < SESSION_EVENTS; i++, evt++)
+    {
+        for (j = 0; j < PAWR_BUF_SIZE; j++)
+        {
+            demo[j] = j;                          /* the request pawr_app.c expects in SUBEVT0 */
+        }
+        if ((i % 7) == 3)
+        {
+            demo[5] ^= 0xFF;                      /* not the expected payload, no answer */
+        }
+        report(SUBEVT0, demo, PAWR_BUF_SIZE);
+        if ((i % 5) == 0)
+        {
+            rel[1] = (uint8_t)(i / 5 - ((i % 15) == 0 ? 1 : 0));   /* every third one a repeat */
+            report(SUBEVT1, rel, sizeof(rel));
+        }
+        else
+        {
+            report(SUBEVT1, NULL, 0);
+        }
+        host_advance_ms(100);
+    }
+    sync_lost();
+}
+
+static uint32_t count_rsp_records(const uint8_t *p_stream, uint32_t len, uint32_t *p_events)
+{
+    uint32_t pos = 0;
+    uint32_t rsp = 0;
+
+    *p_events = 0;
+    while (pos + PAWR_CAP_REC_HDR_LEN <= len)
+    {
+        if (p_stream[pos] == PAWR_CAP_REC_RSP)
+        {
+            rsp++;
+        }
+        else if (p_stream[pos] != PAWR_CAP_REC_GAP)
+        {
+            (*p_events)++;
+        }
+        pos += PAWR_CAP_REC_HDR_LEN + (uint32_t)(p_stream[pos + 1] | (p_stream[pos + 2] << 8));
+    }
+    TEST_CHECK(pos == len);
+    return rsp;
+}
+
+/* returns the offset of the n-th record of a type */
+static uint32_t find_record(uint8_t type, uint32_t n)
+{
+    uint32_t pos = 0;
+
+    while (pos + PAWR_CAP_REC_HDR_LEN <= stream_len)
+    {
+        if ((stream[pos] == type) && (n-- == 0))
+        {
+            return pos;
+        }
+        pos += PAWR_CAP_REC_HDR_LEN + (uint32_t)(stream[pos + 1] | (stream[pos + 2] << 8));
+    }
+    TEST_CHECK(0);
+    return 0;
+}
+
+static void test_identical_replay(void)
+{
+    pawr_cap_replay_result_t res;
+    uint32_t                 events;
+    uint32_t                 recorded = count_rsp_records(stream, stream_len, &events);
+    uint32_t                 live     = num_rsp;
+
+    TEST_CHECK((recorded == live) && (recorded > SESSION_EVENTS));
+    TEST_CHECK(pawr_cap_replay(stream, stream_len, 1, &res));
+    TEST_CHECK((res.events == events) && (res.rsp_match == recorded));
+    TEST_CHECK((res.rsp_mismatch == 0) && (res.rsp_missing == 0) && (res.rsp_extra == 0));
+    TEST_CHECK((res.gaps == 0) && !res.malformed);
+    /* nothing went to the controller, and nothing was recorded again */
+    TEST_CHECK(num_rsp == live);
+    drain();
+    TEST_CHECK(count_rsp_records(stream, stream_len, &events) == recorded);
+
+    /* and again: the replay leaves the state as the recording found it */
+    TEST_CHECK(pawr_cap_replay(stream, stream_len, 0, &res));
+    TEST_CHECK(res.rsp_match == recorded);
+}
+
+static void test_changed_recording(void)
+{
+    pawr_cap_replay_result_t res;
+    uint32_t                 pos;
+    uint32_t                 len;
+
+    /* a response byte that differs */
+    pos = find_record(PAWR_CAP_REC_RSP, 10);
+    stream[pos + PAWR_CAP_REC_HDR_LEN + 6] ^= 0x01;
+    TEST_CHECK(!pawr_cap_replay(stream, stream_len, 0, &res));
+    TEST_CHECK((res.rsp_mismatch == 1) && (res.rsp_missing == 0) && (res.rsp_extra == 0));
+    stream[pos + PAWR_CAP_REC_HDR_LEN + 6] ^= 0x01;
+
+    /* a response the recording does not have is extra */
+    pos = find_record(PAWR_CAP_REC_RSP, 20);
+    len = PAWR_CAP_REC_HDR_LEN + (uint32_t)(stream[pos + 1] | (stream[pos + 2] << 8));
+    memmove(&stream[pos], &stream[pos + len], stream_len - pos - len);
+    TEST_CHECK(!pawr_cap_replay(stream, stream_len - len, 0, &res));
+    TEST_CHECK((res.rsp_mismatch == 0) && (res.rsp_missing == 0) && (res.rsp_extra == 1));
+
+    /* a cut record stops the replay */
+    TEST_CHECK(!pawr_cap_replay(stream, stream_len - len - 1, 0, &res));
+    TEST_CHECK(res.malformed);
+}
+
+/* the session as the device prints it, for replay_pawr */
+static void write_log(const char *p_name)
+{
+    char     path[256];
+    FILE     *f;
+    uint32_t pos = 0;
+    uint32_t end;
+
+    snprintf(path, sizeof(path), "%s.log", p_name);
+    f = fopen(path, "w");
+    TEST_CHECK(f != NULL);
+    while (pos < stream_len)
+    {
+        end = pos + PAWR_CAP_REC_HDR_LEN + (uint32_t)(stream[pos + 1] | (stream[pos + 2] << 8));
+        fprintf(f, "PCAP:");
+        for (; pos < end; pos++)
+        {
+            fprintf(f, "%02x", stream[pos]);
+        }
+        fprintf(f, "\n");
+    }
+    fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+    app_bt_dispatch_init();
+    app_peripheral_init();
+    TEST_CHECK(ext_adv_cback != NULL);
+    record_session();
+    write_log(argv[0]);
+
+    test_identical_replay();
+    test_changed_recording();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,252 @@
+/******************************************************************************
+* File Name:   test_pawr_cmd.c
+*
+* Description: This file tests the controller command pipeline: issue order, opcode matching of the
+*              command complete event, failed status and timeouts dropping the sequence, and superseding
+*              a sequence while a command is in flight.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "app_bt_dispatch.h"
+#include "pawr_cmd.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define LOG_MAX                         (32)
+#define HCI_ERR_DISALLOWED              (0x0C)   /* Command Disallowed */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static char                  issued[LOG_MAX + 1]; /* command names in issue order */
+static uint8_t               num_issued;
+static wiced_bt_dev_status_t next_status = WICED_BT_PENDING;
+static const pawr_cmd_t     *failed_cmd;
+static wiced_bt_dev_status_t failed_status;
+static uint8_t               num_failed;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static wiced_bt_dev_status_t issue(char tag)
+{
+    wiced_bt_dev_status_t status = next_status;
+
+    TEST_CHECK(num_issued < LOG_MAX);
+    issued[num_issued++] = tag;
+    issued[num_issued]   = '\0';
+    next_status          = WICED_BT_PENDING;
+    return status;
+}
+
+static wiced_bt_dev_status_t issue_a(void)
+{
+    return issue('a');
+}
+
+static wiced_bt_dev_status_t issue_b(void)
+{
+    return issue('b');
+}
+
+static wiced_bt_dev_status_t issue_c(void)
+{
+    return issue('c');
+}
+
+static const pawr_cmd_t cmd_a = {"a", issue_a, PAWR_CMD_DONE_ON_STATUS, 100, 0, PAWR_CMD_OP_SCAN_PARAMS};
+static const pawr_cmd_t cmd_b = {"b", issue_b, PAWR_CMD_DONE_ON_STATUS, 100, 1, PAWR_CMD_OP_SCAN_ENABLE};
+static const pawr_cmd_t cmd_c = {"c", issue_c, PAWR_CMD_DONE_ON_EVENT,  200, 2, PAWR_CMD_OP_CREATE_SYNC};
+
+static void on_fail(const pawr_cmd_t *p_cmd, wiced_bt_dev_status_t status)
+{
+    failed_cmd    = p_cmd;
+    failed_status = status;
+    num_failed++;
+}
+
+static void cmplt(uint16_t opcode, uint8_t status)
+{
+    wiced_ble_ext_adv_event_data_t data;
+
+    memset(&data, 0, sizeof(data));
+    data.cmd_cmplt.opcode = opcode;
+    data.cmd_cmplt.status = status;
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_ADV, WICED_BLE_EXT_COMMAND_CMPLT_EVENT, &data);
+}
+
+static void restart(void)
+{
+    pawr_cmd_supersede();
+    TEST_CHECK(pawr_cmd_in_flight() == NULL);
+    num_issued = 0;
+    issued[0]  = '\0';
+    num_failed = 0;
+    failed_cmd = NULL;
+}
+
+/* one at a time, in order; each waits for its own opcode or, for c, its owner's event */
+static void test_order(void)
+{
+    pawr_cmd_stats_t stats;
+
+    TEST_CHECK(pawr_cmd_submit(&cmd_a));
+    TEST_CHECK(pawr_cmd_submit(&cmd_b));
+    TEST_CHECK(pawr_cmd_submit(&cmd_c));
+    TEST_CHECK(pawr_cmd_submit(&cmd_a));
+    TEST_CHECK(strcmp(issued, "a") == 0);
+
+    host_advance_ms(7);
+    cmplt(PAWR_CMD_OP_SCAN_ENABLE, 0);               /* not a's */
+    TEST_CHECK(pawr_cmd_in_flight() == &cmd_a);
+    cmplt(PAWR_CMD_OP_SCAN_PARAMS, 0);
+    TEST_CHECK(strcmp(issued, "ab") == 0);
+    cmplt(PAWR_CMD_OP_SCAN_ENABLE, 0);
+    TEST_CHECK(strcmp(issued, "abc") == 0);
+
+    /* c's command complete only says the controller took it */
+    cmplt(PAWR_CMD_OP_CREATE_SYNC, 0);
+    TEST_CHECK(pawr_cmd_in_flight() == &cmd_c);
+    pawr_cmd_on_event(WICED_TRUE);
+    TEST_CHECK(strcmp(issued, "abca") == 0);
+    cmplt(PAWR_CMD_OP_SCAN_PARAMS, 0);
+    TEST_CHECK(pawr_cmd_in_flight() == NULL);
+    TEST_CHECK(num_failed == 0);
+
+    /* a call that returns WICED_BT_SUCCESS is complete without an event */
+    next_status = WICED_BT_SUCCESS;
+    TEST_CHECK(pawr_cmd_submit(&cmd_b));
+    TEST_CHECK(pawr_cmd_in_flight() == NULL);
+
+    pawr_cmd_get_stats(0, &stats);
+    TEST_CHECK((stats.issued == 2) && (stats.ms_max == 7) && (stats.failed == 0));
+    pawr_cmd_get_stats(1, &stats);
+    TEST_CHECK(stats.issued == 2);
+    restart();
+}
+
+static void test_failures(void)
+{
+    pawr_cmd_stats_t stats;
+
+    /* an error from the call fails the command and drops the rest of the sequence */
+    next_status = WICED_BT_ERROR;
+    TEST_CHECK(pawr_cmd_submit(&cmd_a));
+    TEST_CHECK(!pawr_cmd_submit(&cmd_b));
+    TEST_CHECK((num_failed == 1) && (failed_cmd == &cmd_a) && (failed_status == WICED_BT_ERROR));
+    TEST_CHECK(strcmp(issued, "a") == 0);
+    restart();
+
+    /* a failed HCI status fails it too, also a command waiting for its owner's event */
+    TEST_CHECK(pawr_cmd_submit(&cmd_c));
+    TEST_CHECK(pawr_cmd_submit(&cmd_a));
+    cmplt(PAWR_CMD_OP_CREATE_SYNC, HCI_ERR_DISALLOWED);
+    TEST_CHECK((num_failed == 1) && (failed_cmd == &cmd_c) && (failed_status == WICED_BT_ERROR));
+    TEST_CHECK((pawr_cmd_in_flight() == NULL) && (strcmp(issued, "c") == 0));
+    pawr_cmd_get_stats(0, &stats);
+    TEST_CHECK(stats.dropped == 1);                  /* a, queued behind c */
+    restart();
+
+    /* the owner's event reports a failure */
+    TEST_CHECK(pawr_cmd_submit(&cmd_c));
+    cmplt(PAWR_CMD_OP_CREATE_SYNC, 0);
+    pawr_cmd_on_event(WICED_FALSE);
+    TEST_CHECK((num_failed == 1) && (failed_cmd == &cmd_c));
+    restart();
+
+    /* nothing comes: the timeout fails it; a late event is ignored */
+    TEST_CHECK(pawr_cmd_submit(&cmd_a));
+    TEST_CHECK(pawr_cmd_submit(&cmd_b));
+    host_advance_ms(99);
+    TEST_CHECK(num_failed == 0);
+    host_advance_ms(1);
+    TEST_CHECK((num_failed == 1) && (failed_status == WICED_BT_TIMEOUT) && (pawr_cmd_in_flight() == NULL));
+    cmplt(PAWR_CMD_OP_SCAN_PARAMS, 0);
+    TEST_CHECK(strcmp(issued, "a") == 0);
+    pawr_cmd_get_stats(0, &stats);
+    TEST_CHECK((stats.timeouts == 1) && (stats.ms_max == 100));
+    restart();
+}
+
+/* a new sequence drops the queued steps, the command in flight runs out silently */
+static void test_supersede(void)
+{
+    uint8_t i;
+
+    TEST_CHECK(pawr_cmd_submit(&cmd_c));
+    TEST_CHECK(pawr_cmd_submit(&cmd_a));
+    pawr_cmd_supersede();
+    TEST_CHECK(pawr_cmd_in_flight() == &cmd_c);
+    TEST_CHECK(pawr_cmd_submit(&cmd_b));
+    TEST_CHECK(strcmp(issued, "c") == 0);
+    cmplt(PAWR_CMD_OP_CREATE_SYNC, 0);
+    pawr_cmd_on_event(WICED_FALSE);
+    TEST_CHECK(num_failed == 0);
+    TEST_CHECK(strcmp(issued, "cb") == 0);
+    cmplt(PAWR_CMD_OP_SCAN_ENABLE, 0);
+    restart();
+
+    /* the queue holds PAWR_CMD_QUEUE_LEN behind the one in flight */
+    TEST_CHECK(pawr_cmd_submit(&cmd_c));
+    for (i = 0; i < PAWR_CMD_QUEUE_LEN; i++)
+    {
+        TEST_CHECK(pawr_cmd_submit(&cmd_a));
+    }
+    TEST_CHECK(!pawr_cmd_submit(&cmd_a));
+    pawr_cmd_supersede();
+    cmplt(PAWR_CMD_OP_CREATE_SYNC, 0);
+    pawr_cmd_on_event(WICED_TRUE);
+    restart();
+    TEST_CHECK(pawr_cmd_submit(&cmd_b));
+    TEST_CHECK(strcmp(issued, "b") == 0);
+    cmplt(PAWR_CMD_OP_SCAN_ENABLE, 0);
+    pawr_cmd_print_stats();
+}
+
+int main(void)
+{
+    app_bt_dispatch_init();
+    pawr_cmd_init(on_fail);
+    test_order();
+    test_failures();
+    test_supersede();
+    TEST_PASS();
+    return 0;
+}
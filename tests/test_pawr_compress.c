@@ -0,0 +1,246 @@
+/******************************************************************************
+* File Name:   test_pawr_compress.c
+*
+* Description: This file tests the uplink compression: round trips of generated frames, the size limits,
+*              the static dictionary, the token format and corrupted messages.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_compress.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define NUM_FRAMES                      (20000)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint32_t rng = 1;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint8_t next_byte(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (uint8_t)rng;
+}
+
+/* kind 0: random, 1: telemetry with few changing fields, 2: fixed records with a sequence number */
+static void make_frame(uint8_t kind, uint8_t *p_buf, uint16_t len)
+{
+    uint16_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        switch (kind)
+        {
+            case 0:
+                p_buf[i] = next_byte();
+            break;
+            case 1:
+                p_buf[i] = ((i % 8) < 2) ? (next_byte() & 0x03) : (((i % 8) < 4) ? 0x00 : 0xFF);
+            break;
+            default:
+                p_buf[i] = ((i % 16) == 0) ? (uint8_t)(i / 16) : (uint8_t)(i % 16);
+            break;
+        }
+    }
+}
+
+static void test_round_trip(void)
+{
+    pawr_cmp_stats_t stats;
+    uint8_t          in[PAWR_CMP_MAX_IN_LEN];
+    uint8_t          msg[PAWR_CMP_MAX_IN_LEN];
+    uint8_t          out[PAWR_CMP_MAX_IN_LEN];
+    uint16_t         len;
+    uint16_t         n;
+    uint32_t         i;
+    uint32_t         packed[3] = {0};
+    uint32_t         long_kept = 0;
+
+    pawr_cmp_init();
+    for (i = 0; i < NUM_FRAMES; i++)
+    {
+        len = PAWR_CMP_MIN_IN_LEN + next_byte() % (PAWR_CMP_MAX_IN_LEN - PAWR_CMP_MIN_IN_LEN + 1);
+        make_frame((uint8_t)(i % 3), in, len);
+        n = pawr_cmp_compress(in, len, msg, sizeof(msg));
+        if (n == 0)
+        {
+            long_kept += ((i % 3) != 0) && (len >= 32);
+            continue;
+        }
+        /* only sent compressed when smaller, and then it decodes to the frame */
+        TEST_CHECK((n < len) && (msg[0] == PAWR_MSG_TYPE_COMPRESSED) && (msg[1] == len));
+        TEST_CHECK(pawr_cmp_decompress(msg, n, out, sizeof(out)) == len);
+        TEST_CHECK(memcmp(in, out, len) == 0);
+        packed[i % 3]++;
+    }
+    /* random data does not shrink; structured frames of some length always do */
+    TEST_CHECK(packed[0] == 0);
+    TEST_CHECK((long_kept == 0) && (packed[1] > NUM_FRAMES / 4) && (packed[2] > NUM_FRAMES / 4));
+    pawr_cmp_get_stats(&stats);
+    TEST_CHECK((stats.frames == NUM_FRAMES) && (stats.compressed == packed[1] + packed[2]));
+    TEST_CHECK(stats.bytes_out < stats.bytes_in / 2);
+}
+
+static void test_limits(void)
+{
+    uint8_t in[PAWR_CMP_MAX_IN_LEN + 1];
+    uint8_t msg[PAWR_CMP_MAX_IN_LEN];
+    uint8_t out[PAWR_CMP_MAX_IN_LEN];
+    uint16_t n;
+
+    pawr_cmp_init();
+    memset(in, 0x55, sizeof(in));
+    TEST_CHECK(pawr_cmp_compress(in, PAWR_CMP_MIN_IN_LEN - 1, msg, sizeof(msg)) == 0);
+    TEST_CHECK(pawr_cmp_compress(in, PAWR_CMP_MAX_IN_LEN + 1, msg, sizeof(msg)) == 0);
+    TEST_CHECK(pawr_cmp_compress(NULL, 16, msg, sizeof(msg)) == 0);
+    TEST_CHECK(pawr_cmp_compress(in, 16, msg, PAWR_CMP_HDR_LEN) == 0);
+
+    /* a 100 byte frame into a 64 byte response */
+    make_frame(2, in, 100);
+    n = pawr_cmp_compress(in, 100, msg, 64);
+    TEST_CHECK((n != 0) && (n <= 64));
+    TEST_CHECK(pawr_cmp_decompress(msg, n, out, sizeof(out)) == 100);
+    TEST_CHECK(pawr_cmp_compress(in, 100, msg, 4) == 0);
+    /* the decoder refuses a frame larger than its buffer */
+    TEST_CHECK(pawr_cmp_decompress(msg, n, out, 99) == 0);
+}
+
+static void test_dictionary(void)
+{
+    static const uint8_t dict[]  = "node 0042 status ok fw 1.4.2 batt ";
+    static const uint8_t frame[] = "node 0042 status lo fw 1.4.2 batt 17";
+    uint8_t              msg[PAWR_CMP_MAX_IN_LEN];
+    uint8_t              out[PAWR_CMP_MAX_IN_LEN];
+    uint16_t             plain_len;
+    uint16_t             dict_len;
+
+    pawr_cmp_init();
+    plain_len = pawr_cmp_compress(frame, sizeof(frame) - 1, msg, sizeof(msg));
+    TEST_CHECK(!pawr_cmp_set_dict(dict, PAWR_CMP_DICT_MAX_LEN + 1));
+    TEST_CHECK(!pawr_cmp_set_dict(NULL, 4));
+    TEST_CHECK(pawr_cmp_set_dict(dict, sizeof(dict) - 1));
+    dict_len = pawr_cmp_compress(frame, sizeof(frame) - 1, msg, sizeof(msg));
+    TEST_CHECK((dict_len != 0) && ((plain_len == 0) || (dict_len < plain_len)));
+    TEST_CHECK(pawr_cmp_decompress(msg, dict_len, out, sizeof(out)) == sizeof(frame) - 1);
+    TEST_CHECK(memcmp(out, frame, sizeof(frame) - 1) == 0);
+
+    /* without the dictionary the same message is refused, not misdecoded */
+    TEST_CHECK(pawr_cmp_set_dict(NULL, 0));
+    TEST_CHECK(pawr_cmp_decompress(msg, dict_len, out, sizeof(out)) == 0);
+}
+
+static void test_token_format(void)
+{
+    /* literal "ab", copy 5 from 2 back (overlapping), literal "c" */
+    static const uint8_t msg[] = {PAWR_MSG_TYPE_COMPRESSED, 8, 0x01, 'a', 'b', 0x80 | ((5 - 3) << 3), 0x01, 0x00, 'c'};
+    /* copy 4 from 8 back, from the end of the default dictionary: its 0x00, 0x01, 0x02, 0x03 */
+    static const uint8_t dict_ref[] = {PAWR_MSG_TYPE_COMPRESSED, 4, 0x80 | ((4 - 3) << 3), 8 - 1};
+    static const uint8_t seq[]      = {0x00, 0x01, 0x02, 0x03};
+    uint8_t              bad[sizeof(msg)];
+    uint8_t              out[16];
+
+    pawr_cmp_init();
+    TEST_CHECK(pawr_cmp_decompress(dict_ref, sizeof(dict_ref), out, sizeof(out)) == 4);
+    TEST_CHECK(memcmp(out, seq, sizeof(seq)) == 0);
+    TEST_CHECK(pawr_cmp_set_dict(NULL, 0));
+    TEST_CHECK(pawr_cmp_decompress(dict_ref, sizeof(dict_ref), out, sizeof(out)) == 0);
+    TEST_CHECK(pawr_cmp_decompress(msg, sizeof(msg), out, sizeof(out)) == 8);
+    TEST_CHECK(memcmp(out, "abababac", 8) == 0);
+
+    /* truncated, trailing bytes, wrong type, length mismatch, copy before the start */
+    TEST_CHECK(pawr_cmp_decompress(msg, sizeof(msg) - 1, out, sizeof(out)) == 0);
+    TEST_CHECK(pawr_cmp_decompress(msg, 6, out, sizeof(out)) == 0);
+    memcpy(bad, msg, sizeof(msg));
+    bad[0] = PAWR_MSG_TYPE_APP;
+    TEST_CHECK(pawr_cmp_decompress(bad, sizeof(bad), out, sizeof(out)) == 0);
+    memcpy(bad, msg, sizeof(msg));
+    bad[1] = 9;
+    TEST_CHECK(pawr_cmp_decompress(bad, sizeof(bad), out, sizeof(out)) == 0);
+    bad[1] = 7;
+    TEST_CHECK(pawr_cmp_decompress(bad, sizeof(bad), out, sizeof(out)) == 0);
+    memcpy(bad, msg, sizeof(msg));
+    bad[6] = 0x02;
+    TEST_CHECK(pawr_cmp_decompress(bad, sizeof(bad), out, sizeof(out)) == 0);
+}
+
+static void test_garbage(void)
+{
+    uint8_t  in[PAWR_CMP_MAX_IN_LEN];
+    uint8_t  msg[PAWR_CMP_MAX_IN_LEN];
+    uint8_t  out[PAWR_CMP_MAX_IN_LEN];
+    uint16_t n;
+    uint16_t i;
+    uint32_t k;
+
+    /* corrupted messages never write past the buffer nor report more than the header says */
+    pawr_cmp_init();
+    for (k = 0; k < NUM_FRAMES; k++)
+    {
+        make_frame(1, in, 200);
+        n = pawr_cmp_compress(in, 200, msg, sizeof(msg));
+        TEST_CHECK(n != 0);
+        for (i = PAWR_CMP_HDR_LEN; i < n; i++)
+        {
+            if ((next_byte() % 32) == 0)
+            {
+                msg[i] ^= next_byte();
+            }
+        }
+        TEST_CHECK(pawr_cmp_decompress(msg, n, out, 200) <= 200);
+    }
+}
+
+int main(void)
+{
+    test_round_trip();
+    test_limits();
+    test_dictionary();
+    test_token_format();
+    test_garbage();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,149 @@
+/******************************************************************************
+* File Name:   test_pawr_data_store.c
+*
+* Description: This file tests the versioned data store: full images, deltas on their base version, gaps,
+*              deletes, malformed records and the change mask.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_data_store.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define DS_MSG(version, base, flags)    PAWR_MSG_TYPE_DS_DELTA, (uint8_t)(version), (uint8_t)((version) >> 8), \
+                                        (uint8_t)(base), (uint8_t)((base) >> 8), (flags)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint16_t cb_version;
+static uint32_t cb_changed;
+static uint8_t  cb_calls;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void ds_update_cb(uint16_t version, uint32_t changed_keys)
+{
+    cb_version = version;
+    cb_changed = changed_keys;
+    cb_calls++;
+}
+
+static void test_full_and_delta(void)
+{
+    const uint8_t full[]  = {DS_MSG(1, 0, PAWR_DS_FLAG_FULL), 3, 2, 0xAA, 0xBB, 5, 1, 0x11};
+    const uint8_t delta[] = {DS_MSG(2, 1, 0), 3, 0, 7, 3, 1, 2, 3};
+    uint8_t       buf[PAWR_DS_MAX_VALUE_LEN];
+    uint16_t      version;
+
+    pawr_ds_init();
+    pawr_ds_reg_update_cb(ds_update_cb);
+    TEST_CHECK(pawr_ds_get_version() == PAWR_DS_VERSION_NONE);
+    TEST_CHECK(pawr_ds_read(3, buf, sizeof(buf), &version) == 0);
+
+    TEST_CHECK(pawr_ds_apply(full, sizeof(full)));
+    TEST_CHECK((cb_calls == 1) && (cb_version == 1) && (cb_changed == ((1u << 3) | (1u << 5))));
+    TEST_CHECK((pawr_ds_read(3, buf, sizeof(buf), &version) == 2) && (version == 1));
+    TEST_CHECK((buf[0] == 0xAA) && (buf[1] == 0xBB));
+    TEST_CHECK(pawr_ds_read(3, buf, 1, NULL) == 1);    /* cut to the caller's buffer */
+
+    /* the same version again is skipped */
+    TEST_CHECK(!pawr_ds_apply(full, sizeof(full)));
+    TEST_CHECK(cb_calls == 1);
+
+    /* delta: key 3 deleted, key 7 added, key 5 kept */
+    TEST_CHECK(pawr_ds_apply(delta, sizeof(delta)));
+    TEST_CHECK((cb_version == 2) && (cb_changed == ((1u << 3) | (1u << 7))));
+    TEST_CHECK(pawr_ds_read(3, buf, sizeof(buf), NULL) == 0);
+    TEST_CHECK((pawr_ds_read(5, buf, sizeof(buf), NULL) == 1) && (buf[0] == 0x11));
+    TEST_CHECK((pawr_ds_read(7, buf, sizeof(buf), &version) == 3) && (buf[2] == 3) && (version == 2));
+}
+
+static void test_gap_and_full_resync(void)
+{
+    const uint8_t gap[]  = {DS_MSG(4, 3, 0), 1, 1, 9};
+    const uint8_t full[] = {DS_MSG(4, 0, PAWR_DS_FLAG_FULL), 1, 1, 9};
+    pawr_ds_image_t image;
+    pawr_ds_stats_t stats;
+
+    /* version 3 was missed: the delta on top of it waits, a full image replaces everything */
+    TEST_CHECK(!pawr_ds_apply(gap, sizeof(gap)));
+    TEST_CHECK(pawr_ds_get_version() == 2);
+    TEST_CHECK(pawr_ds_apply(full, sizeof(full)));
+    TEST_CHECK(cb_changed == ((1u << 1) | (1u << 5) | (1u << 7)));
+    pawr_ds_snapshot(&image);
+    TEST_CHECK((image.version == 4) && (image.len[1] == 1) && (image.len[5] == 0) && (image.len[7] == 0));
+    pawr_ds_get_stats(&stats);
+    TEST_CHECK((stats.applied == 3) && (stats.unchanged == 1) && (stats.gap == 1));
+}
+
+static void test_malformed(void)
+{
+    const uint8_t short_hdr[] = {DS_MSG(5, 4, 0)};
+    const uint8_t bad_key[]   = {DS_MSG(5, 4, 0), PAWR_DS_MAX_KEYS, 1, 0};
+    const uint8_t too_long[]  = {DS_MSG(5, 4, 0), 2, PAWR_DS_MAX_VALUE_LEN + 1};
+    const uint8_t cut[]       = {DS_MSG(5, 4, 0), 2, 3, 1, 2};
+    const uint8_t half_rec[]  = {DS_MSG(5, 4, 0), 2, 1, 1, 6};
+    pawr_ds_stats_t stats;
+    uint8_t         calls = cb_calls;
+
+    TEST_CHECK(!pawr_ds_apply(short_hdr, sizeof(short_hdr) - 1));
+    TEST_CHECK(!pawr_ds_apply(bad_key, sizeof(bad_key)));
+    TEST_CHECK(!pawr_ds_apply(too_long, sizeof(too_long)));
+    TEST_CHECK(!pawr_ds_apply(cut, sizeof(cut)));
+    TEST_CHECK(!pawr_ds_apply(half_rec, sizeof(half_rec)));
+    pawr_ds_get_stats(&stats);
+    TEST_CHECK(stats.malformed == 5);
+
+    /* nothing of a rejected delta is written */
+    TEST_CHECK((pawr_ds_get_version() == 4) && (cb_calls == calls));
+    TEST_CHECK(pawr_ds_read(2, (uint8_t[PAWR_DS_MAX_VALUE_LEN]){0}, PAWR_DS_MAX_VALUE_LEN, NULL) == 0);
+}
+
+int main(void)
+{
+    test_full_and_delta();
+    test_gap_and_full_resync();
+    test_malformed();
+    TEST_PASS();
+    return 0;
+}
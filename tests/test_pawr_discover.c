@@ -0,0 +1,323 @@
+/******************************************************************************
+* File Name:   test_pawr_discover.c
+*
+* Description: This file tests the discovery of a central: parsing the network's service data, ranking by
+*              RSSI and load, the choice window, the candidate table, and a choice that does not sync.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_discover.h"
+#include "pawr_roam.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SID                             (5)
+#define ADV_INT                         (80)     /* periodic advertising interval of the centrals */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* the create sync pawr.c would issue on each scan */
+static wiced_ble_padv_create_sync_params_t sync_par;
+static wiced_bool_t sync_create;
+static uint32_t     num_scan;
+
+/* centrals handed to roaming */
+static uint8_t      roam_added[PAWR_DISC_MAX_CANDIDATES];
+static uint8_t      num_roam_added;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+void pawr_scan_for_pawr_network(void)
+{
+    num_scan++;
+    memset(&sync_par, 0, sizeof(sync_par));
+    sync_create = pawr_disc_prepare_sync(&sync_par);
+}
+
+wiced_bool_t pawr_roam_add_central(wiced_bt_ble_address_type_t addr_type, const uint8_t *addr, uint8_t sid)
+{
+    TEST_CHECK((num_roam_added < PAWR_DISC_MAX_CANDIDATES) && (sid == SID));
+    roam_added[num_roam_added++] = addr[5];
+    return WICED_TRUE;
+}
+
+static void report_ad(uint8_t central, int8_t rssi, uint16_t adv_int, uint8_t *p_ad, uint16_t len)
+{
+    wiced_ble_ext_scan_results_t rpt;
+
+    memset(&rpt, 0, sizeof(rpt));
+    rpt.bd_addr[0]            = 0xC0;
+    rpt.bd_addr[5]            = central;
+    rpt.adv_sid               = SID;
+    rpt.rssi                  = rssi;
+    rpt.periodic_adv_interval = adv_int;
+    rpt.data_length           = len;
+    rpt.p_data                = p_ad;
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, &rpt);
+}
+
+static void report(uint8_t central, int8_t rssi, uint8_t load)
+{
+    /* flags, then the network's service data */
+    uint8_t ad[] = {2, 0x01, 0x06,
+                    1 + PAWR_DISC_SVC_DATA_LEN, PAWR_DISC_AD_SERVICE_DATA,
+                    PAWR_CFG_DISC_UUID & 0xFF, PAWR_CFG_DISC_UUID >> 8,
+                    PAWR_CFG_NETWORK_ID & 0xFF, PAWR_CFG_NETWORK_ID >> 8, load};
+
+    report_ad(central, rssi, ADV_INT, ad, sizeof(ad));
+}
+
+static uint32_t discover(void)
+{
+    uint32_t start = host_now_ms;
+    uint32_t scans = num_scan;
+
+    while (num_scan == scans)
+    {
+        host_advance_ms(1);
+    }
+    TEST_CHECK(sync_create && (sync_par.options == WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST));
+    TEST_CHECK(sync_par.adv_sid == SID);
+    return host_now_ms - start;
+}
+
+static void sync_done(uint8_t central)
+{
+    wiced_ble_padv_sync_established_event_data_t ps;
+
+    memset(&ps, 0, sizeof(ps));
+    ps.adv_addr[0] = 0xC0;
+    ps.adv_addr[5] = central;
+    ps.adv_sid     = SID;
+    num_roam_added = 0;
+    pawr_disc_on_sync(&ps);
+}
+
+static void test_parse(void)
+{
+    pawr_disc_stats_t stats;
+    uint8_t           other_net[] = {1 + PAWR_DISC_SVC_DATA_LEN, PAWR_DISC_AD_SERVICE_DATA,
+                                     PAWR_CFG_DISC_UUID & 0xFF, PAWR_CFG_DISC_UUID >> 8,
+                                     (PAWR_CFG_NETWORK_ID + 1) & 0xFF, (PAWR_CFG_NETWORK_ID + 1) >> 8, 0};
+    uint8_t           other_uuid[] = {1 + PAWR_DISC_SVC_DATA_LEN, PAWR_DISC_AD_SERVICE_DATA,
+                                      (PAWR_CFG_DISC_UUID + 1) & 0xFF, (PAWR_CFG_DISC_UUID + 1) >> 8,
+                                      PAWR_CFG_NETWORK_ID & 0xFF, PAWR_CFG_NETWORK_ID >> 8, 0};
+    uint8_t           short_svc[] = {PAWR_DISC_SVC_DATA_LEN, PAWR_DISC_AD_SERVICE_DATA,
+                                     PAWR_CFG_DISC_UUID & 0xFF, PAWR_CFG_DISC_UUID >> 8,
+                                     PAWR_CFG_NETWORK_ID & 0xFF, PAWR_CFG_NETWORK_ID >> 8};
+    uint8_t           cut[] = {2, 0x01, 0x06, 1 + PAWR_DISC_SVC_DATA_LEN, PAWR_DISC_AD_SERVICE_DATA,
+                               PAWR_CFG_DISC_UUID & 0xFF, PAWR_CFG_DISC_UUID >> 8,
+                               PAWR_CFG_NETWORK_ID & 0xFF, PAWR_CFG_NETWORK_ID >> 8};
+    uint8_t           padded[] = {0, 0, 1 + PAWR_DISC_SVC_DATA_LEN, PAWR_DISC_AD_SERVICE_DATA,
+                                  PAWR_CFG_DISC_UUID & 0xFF, PAWR_CFG_DISC_UUID >> 8,
+                                  PAWR_CFG_NETWORK_ID & 0xFF, PAWR_CFG_NETWORK_ID >> 8, 0};
+
+    /* reports are looked at only while discovering */
+    report(1, -40, 0);
+    pawr_disc_get_stats(&stats);
+    TEST_CHECK(stats.reports == 0);
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+
+    /* advertisers without a periodic train, or without data, are passed over */
+    report_ad(1, -40, 0, other_net, sizeof(other_net));
+    report_ad(1, -40, ADV_INT, NULL, 0);
+    pawr_disc_get_stats(&stats);
+    TEST_CHECK(stats.reports == 0);
+
+    /* another network, another service, short service data, a structure cut short, padding */
+    report_ad(1, -40, ADV_INT, other_net, sizeof(other_net));
+    report_ad(1, -40, ADV_INT, other_uuid, sizeof(other_uuid));
+    report_ad(1, -40, ADV_INT, short_svc, sizeof(short_svc));
+    report_ad(1, -40, ADV_INT, cut, sizeof(cut));
+    report_ad(1, -40, ADV_INT, padded, sizeof(padded));
+    pawr_disc_get_stats(&stats);
+    TEST_CHECK((stats.reports == 5) && (stats.matched == 0));
+
+    /* nothing heard: no choice, not even after the window */
+    host_advance_ms(PAWR_DISC_WINDOW_MS * 2);
+    TEST_CHECK(num_scan == 0);
+}
+
+static void test_choice(void)
+{
+    pawr_disc_stats_t stats;
+    uint32_t          ms;
+    uint8_t           i;
+
+    /* PAWR_DISC_MIN_SAMPLES reports of the best central: chosen at PAWR_DISC_MIN_MS */
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    report(1, -70, 0);
+    report(1, -70, 0);
+    ms = discover();
+    TEST_CHECK((ms == PAWR_DISC_MIN_MS) && (sync_par.adv_addr[5] == 1));
+    sync_done(1);
+
+    /* a fully loaded central ranks PAWR_DISC_LOAD_DB weaker; a load above 100% counts as 100% */
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    report(2, -55, 100);
+    report(2, -55, 100);
+    report(3, -70, 0);
+    report(3, -70, 0);
+    discover();
+    TEST_CHECK(sync_par.adv_addr[5] == 3);
+    sync_done(3);
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    report(2, -55, 250);
+    report(2, -55, 250);
+    report(3, -80, 0);
+    report(3, -80, 0);
+    discover();
+    TEST_CHECK(sync_par.adv_addr[5] == 2);
+    sync_done(2);
+
+    /* one report of the best central: the choice waits for the window */
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    report(4, -60, 0);
+    report(1, -80, 0);
+    report(1, -80, 0);
+    ms = discover();
+    TEST_CHECK((ms == PAWR_DISC_WINDOW_MS) && (sync_par.adv_addr[5] == 4));
+    sync_done(4);
+
+    /* the average follows the reports */
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    report(1, -50, 0);
+    for (i = 0; i < 6; i++)
+    {
+        report(1, -90, 0);
+    }
+    report(2, -65, 0);
+    report(2, -65, 0);
+    discover();
+    TEST_CHECK(sync_par.adv_addr[5] == 2);
+    sync_done(2);
+
+    pawr_disc_get_stats(&stats);
+    TEST_CHECK((stats.discoveries == 5) && (stats.disc_ms_max == PAWR_DISC_WINDOW_MS) && (stats.sync_fails == 0));
+}
+
+static void test_table(void)
+{
+    uint32_t scans;
+    uint8_t  i;
+
+    /* a full table keeps the best ranked: a weaker newcomer is dropped, a stronger one replaces the weakest */
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    for (i = 0; i < PAWR_DISC_MAX_CANDIDATES; i++)
+    {
+        report((uint8_t)(10 + i), (int8_t)(-80 - i), 0);
+    }
+    report(30, -95, 0);
+    report(31, -50, 0);
+    report(31, -50, 0);
+    discover();
+    TEST_CHECK(sync_par.adv_addr[5] == 31);
+
+    /* the sync ends the discovery; every candidate becomes a known central */
+    sync_done(31);
+    TEST_CHECK(num_roam_added == PAWR_DISC_MAX_CANDIDATES);
+    for (i = 0; i < PAWR_DISC_MAX_CANDIDATES - 1; i++)
+    {
+        TEST_CHECK(roam_added[i] == 10 + i);
+    }
+    TEST_CHECK(roam_added[PAWR_DISC_MAX_CANDIDATES - 1] == 31);
+    scans = num_scan;
+    host_advance_ms(PAWR_DISC_SYNC_TIMEOUT_MS * 2);
+    TEST_CHECK(num_scan == scans);
+}
+
+static void test_sync_fail(void)
+{
+    pawr_disc_stats_t stats;
+    uint32_t          scans;
+
+    /* a choice that does not sync in time: discover again, without it */
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    report(1, -50, 0);
+    report(1, -50, 0);
+    report(2, -70, 0);
+    report(2, -70, 0);
+    discover();
+    TEST_CHECK(sync_par.adv_addr[5] == 1);
+    scans = num_scan;
+    host_advance_ms(PAWR_DISC_SYNC_TIMEOUT_MS - 1);
+    TEST_CHECK(num_scan == scans);
+    host_advance_ms(1);
+    pawr_disc_get_stats(&stats);
+    TEST_CHECK((num_scan == scans + 1) && !sync_create && (stats.sync_fails == 1));
+
+    report(1, -50, 0);
+    report(1, -50, 0);
+    report(2, -70, 0);
+    report(2, -70, 0);
+    discover();
+    TEST_CHECK(sync_par.adv_addr[5] == 2);
+    sync_done(2);
+
+    /* after PAWR_DISC_AVOID_MS it is a candidate again */
+    host_advance_ms(PAWR_DISC_AVOID_MS);
+    TEST_CHECK(!pawr_disc_prepare_sync(&sync_par));
+    report(1, -50, 0);
+    report(1, -50, 0);
+    report(2, -70, 0);
+    report(2, -70, 0);
+    discover();
+    TEST_CHECK(sync_par.adv_addr[5] == 1);
+    sync_done(1);
+    pawr_disc_get_stats(&stats);
+    TEST_CHECK((stats.sync_fails == 1) && (stats.discoveries == 9));
+    pawr_disc_print_stats();
+}
+
+int main(void)
+{
+    app_bt_dispatch_init();
+    pawr_disc_init();
+    test_parse();
+    test_choice();
+    test_table();
+    test_sync_fail();
+    TEST_PASS();
+    return 0;
+}
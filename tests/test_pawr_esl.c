@@ -0,0 +1,385 @@
+/******************************************************************************
+* File Name:   test_pawr_esl.c
+*
+* Description: This file tests the ESL command engine with a fake label: each command and its errors, the
+*              parsing of a group payload with the response slot, and timed commands.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_esl.h"
+#include "pawr_msg.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define ESL_ID                          (3)
+#define GROUP_ID                        (1)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint8_t      led_last = 0xFF;
+static uint8_t      led_ctrl[PAWR_ESL_LED_CTRL_LEN];
+static uint8_t      shown[PAWR_ESL_MAX_DISPLAYS] = {0xFF, 0xFF};
+static wiced_bool_t sensor_ready = WICED_TRUE;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void hw_led(uint8_t led, const uint8_t *p_ctrl)
+{
+    led_last = led;
+    memcpy(led_ctrl, p_ctrl, PAWR_ESL_LED_CTRL_LEN);
+}
+
+/* image 3 is not stored on the label */
+static wiced_bool_t hw_display(uint8_t display, uint8_t image)
+{
+    if (image == 3)
+    {
+        return WICED_FALSE;
+    }
+    shown[display] = image;
+    return WICED_TRUE;
+}
+
+static uint8_t hw_sensor(uint8_t sensor, uint8_t *p_data, uint8_t max_len)
+{
+    if (!sensor_ready)
+    {
+        return 0;
+    }
+    p_data[0] = 0x34;
+    p_data[1] = 0x12;
+    return 2;
+}
+
+static const pawr_esl_hw_t hw =
+{
+    .num_leds      = 2,
+    .num_displays  = 1,
+    .num_images    = 4,
+    .num_sensors   = 1,
+    .led_control   = hw_led,
+    .display_image = hw_display,
+    .sensor_read   = hw_sensor,
+};
+
+static uint8_t run(pawr_esl_ctx_t *p_ctx, const uint8_t *p_cmds, uint16_t len, uint32_t now_ms, uint8_t *p_rsp, uint8_t *p_slot)
+{
+    *p_slot = 0xFF;
+    return pawr_esl_process(p_ctx, GROUP_ID, p_cmds, len, now_ms, p_rsp, p_slot);
+}
+
+static void test_commands(void)
+{
+    pawr_esl_ctx_t ctx;
+    uint8_t        rsp[PAWR_ESL_MAX_RSP_LEN];
+    uint8_t        slot;
+
+    pawr_esl_init(&ctx, &hw, ESL_ID, GROUP_ID);
+    pawr_esl_set_synced(&ctx, WICED_TRUE);
+
+    /* ping answers with the basic state */
+    {
+        const uint8_t cmd[] = {PAWR_ESL_OP_PING, ESL_ID};
+        const uint8_t exp[] = {PAWR_ESL_RSP_BASIC_STATE, PAWR_ESL_STATE_SYNCHRONIZED, 0x00};
+
+        TEST_CHECK(run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == sizeof(exp));
+        TEST_CHECK((memcmp(rsp, exp, sizeof(exp)) == 0) && (slot == 0));
+    }
+    /* another group's payload is not ours */
+    {
+        const uint8_t cmd[] = {PAWR_ESL_OP_PING, ESL_ID};
+
+        slot = 0xFF;
+        TEST_CHECK(pawr_esl_process(&ctx, GROUP_ID + 1, cmd, sizeof(cmd), 0, rsp, &slot) == 0);
+        TEST_CHECK(slot == 0xFF);
+    }
+    /* sensor value, sensor not ready, sensor out of range */
+    {
+        const uint8_t cmd[]  = {PAWR_ESL_OP_READ_SENSOR, ESL_ID, 0};
+        const uint8_t bad[]  = {PAWR_ESL_OP_READ_SENSOR, ESL_ID, 1};
+        const uint8_t exp[]  = {(2 << 4) | PAWR_ESL_RSP_SENSOR_VALUE, 0, 0x34, 0x12};
+
+        TEST_CHECK(run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == sizeof(exp));
+        TEST_CHECK(memcmp(rsp, exp, sizeof(exp)) == 0);
+        sensor_ready = WICED_FALSE;
+        TEST_CHECK((run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == 2) && (rsp[0] == PAWR_ESL_RSP_ERROR) &&
+                   (rsp[1] == PAWR_ESL_ERR_RETRY));
+        sensor_ready = WICED_TRUE;
+        TEST_CHECK((run(&ctx, bad, sizeof(bad), 0, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_INVALID_PARAM));
+    }
+    /* display image, unknown image, image not stored, refresh */
+    {
+        const uint8_t cmd[]     = {PAWR_ESL_OP_DISPLAY_IMAGE, ESL_ID, 0, 2};
+        const uint8_t bad[]     = {PAWR_ESL_OP_DISPLAY_IMAGE, ESL_ID, 0, 4};
+        const uint8_t missing[] = {PAWR_ESL_OP_DISPLAY_IMAGE, ESL_ID, 0, 3};
+        const uint8_t refresh[] = {PAWR_ESL_OP_REFRESH_DISPLAY, ESL_ID, 0};
+        const uint8_t exp[]     = {PAWR_ESL_RSP_DISPLAY_STATE, 0, 2};
+
+        TEST_CHECK(run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == sizeof(exp));
+        TEST_CHECK((memcmp(rsp, exp, sizeof(exp)) == 0) && (shown[0] == 2));
+        TEST_CHECK((run(&ctx, bad, sizeof(bad), 0, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_INVALID_IMAGE));
+        TEST_CHECK((run(&ctx, missing, sizeof(missing), 0, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_IMAGE_NOT_AVAIL));
+        shown[0] = 0xFF;
+        TEST_CHECK(run(&ctx, refresh, sizeof(refresh), 0, rsp, &slot) == sizeof(exp));
+        TEST_CHECK((memcmp(rsp, exp, sizeof(exp)) == 0) && (shown[0] == 2));
+    }
+    /* LED on, then off; the active LED bit follows */
+    {
+        uint8_t cmd[] = {PAWR_ESL_OP_LED_CONTROL, ESL_ID, 1, 0x07, 1, 2, 3, 4, 5, 10, 20, 0x05, 0x00};
+
+        TEST_CHECK((run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == 2) && (rsp[0] == PAWR_ESL_RSP_LED_STATE) && (rsp[1] == 1));
+        TEST_CHECK((led_last == 1) && (memcmp(led_ctrl, &cmd[3], PAWR_ESL_LED_CTRL_LEN) == 0));
+        TEST_CHECK(ctx.basic_state & PAWR_ESL_STATE_ACTIVE_LED);
+        cmd[11] = 0;
+        TEST_CHECK(run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == 2);
+        TEST_CHECK(!(ctx.basic_state & PAWR_ESL_STATE_ACTIVE_LED));
+        cmd[2] = 2;
+        TEST_CHECK((run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_INVALID_PARAM));
+    }
+    /* an opcode without a handler, and service reset */
+    {
+        const uint8_t cmd[]   = {0x01, ESL_ID};
+        const uint8_t reset[] = {PAWR_ESL_OP_SERVICE_RESET, ESL_ID};
+
+        TEST_CHECK((run(&ctx, cmd, sizeof(cmd), 0, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_INVALID_OPCODE));
+        ctx.basic_state |= PAWR_ESL_STATE_SERVICE_NEEDED;
+        TEST_CHECK(run(&ctx, reset, sizeof(reset), 0, rsp, &slot) == 3);
+        TEST_CHECK(!(ctx.basic_state & PAWR_ESL_STATE_SERVICE_NEEDED) && !(rsp[1] & PAWR_ESL_STATE_SERVICE_NEEDED));
+    }
+}
+
+static void test_payload(void)
+{
+    pawr_esl_ctx_t ctx;
+    uint8_t        rsp[PAWR_ESL_MAX_RSP_LEN];
+    uint8_t        slot;
+
+    pawr_esl_init(&ctx, &hw, ESL_ID, GROUP_ID);
+
+    /* broadcast runs unanswered and takes no slot; our first unicast command sets the slot */
+    {
+        const uint8_t cmds[] = {PAWR_ESL_OP_DISPLAY_IMAGE, PAWR_ESL_ID_BROADCAST, 0, 1,
+                                PAWR_ESL_OP_PING, 7,
+                                PAWR_ESL_OP_PING, 9,
+                                PAWR_ESL_OP_PING, ESL_ID,
+                                PAWR_ESL_OP_READ_SENSOR, ESL_ID, 0,
+                                PAWR_ESL_OP_PING, 11};
+
+        TEST_CHECK(run(&ctx, cmds, sizeof(cmds), 0, rsp, &slot) == 3 + 4);
+        TEST_CHECK((slot == 2) && (shown[0] == 1));
+        TEST_CHECK((rsp[0] == PAWR_ESL_RSP_BASIC_STATE) && (rsp[3] == ((2 << 4) | PAWR_ESL_RSP_SENSOR_VALUE)));
+    }
+    /* only broadcasts: nothing to answer */
+    {
+        const uint8_t cmds[] = {PAWR_ESL_OP_PING, PAWR_ESL_ID_BROADCAST};
+
+        TEST_CHECK(run(&ctx, cmds, sizeof(cmds), 0, rsp, &slot) == 0);
+        TEST_CHECK(slot == 0xFF);
+    }
+    /* a command cut short ends the payload; what came before still runs */
+    {
+        const uint8_t cmds[] = {PAWR_ESL_OP_PING, ESL_ID, PAWR_ESL_OP_DISPLAY_IMAGE, ESL_ID, 0};
+
+        TEST_CHECK(run(&ctx, cmds, sizeof(cmds), 0, rsp, &slot) == 3);
+        TEST_CHECK(ctx.malformed == 1);
+    }
+    /* responses beyond PAWR_ESL_MAX_RSP_LEN are left out whole */
+    {
+        uint8_t cmds[2 * 20];
+        uint8_t i;
+
+        for (i = 0; i < 20; i++)
+        {
+            cmds[2 * i]     = PAWR_ESL_OP_PING;
+            cmds[2 * i + 1] = ESL_ID;
+        }
+        TEST_CHECK(run(&ctx, cmds, sizeof(cmds), 0, rsp, &slot) == (PAWR_ESL_MAX_RSP_LEN / 3) * 3);
+    }
+}
+
+static void test_timed(void)
+{
+    pawr_esl_ctx_t ctx;
+    uint8_t        rsp[PAWR_ESL_MAX_RSP_LEN];
+    uint8_t        slot;
+    uint8_t        led[] = {PAWR_ESL_OP_LED_TIMED_CONTROL, ESL_ID, 0, 1, 1, 2, 3, 4, 5, 10, 20, 1, 0, 0, 0, 0, 0};
+    uint8_t        img[] = {PAWR_ESL_OP_DISPLAY_TIMED_IMAGE, ESL_ID, 0, 1, 0, 0, 0, 0};
+    uint32_t       at    = 5000;
+
+    pawr_esl_init(&ctx, &hw, ESL_ID, GROUP_ID);
+    led_last = 0xFF;
+    shown[0] = 0xFF;
+    memcpy(&led[13], &at, 4);
+    at = 7000;
+    memcpy(&img[4], &at, 4);
+
+    TEST_CHECK(run(&ctx, led, sizeof(led), 1000, rsp, &slot) == 3);
+    TEST_CHECK(rsp[1] & PAWR_ESL_STATE_PENDING_LED);
+    TEST_CHECK(run(&ctx, img, sizeof(img), 1000, rsp, &slot) == 3);
+    TEST_CHECK(rsp[1] & PAWR_ESL_STATE_PENDING_DISPLAY);
+
+    pawr_esl_poll(&ctx, 4999);
+    TEST_CHECK((led_last == 0xFF) && (shown[0] == 0xFF));
+    pawr_esl_poll(&ctx, 5000);
+    TEST_CHECK((led_last == 0) && (ctx.basic_state & PAWR_ESL_STATE_ACTIVE_LED) && !(ctx.basic_state & PAWR_ESL_STATE_PENDING_LED));
+    pawr_esl_poll(&ctx, 7001);
+    TEST_CHECK((shown[0] == 1) && !(ctx.basic_state & PAWR_ESL_STATE_PENDING_DISPLAY));
+
+    /* a new command replaces the pending one; time 0 cancels it */
+    at = 9000;
+    memcpy(&img[4], &at, 4);
+    TEST_CHECK(run(&ctx, img, sizeof(img), 8000, rsp, &slot) == 3);
+    img[3] = 2;
+    TEST_CHECK(run(&ctx, img, sizeof(img), 8000, rsp, &slot) == 3);
+    memset(&img[4], 0, 4);
+    TEST_CHECK(run(&ctx, img, sizeof(img), 8000, rsp, &slot) == 3);
+    TEST_CHECK(!(rsp[1] & PAWR_ESL_STATE_PENDING_DISPLAY));
+    pawr_esl_poll(&ctx, 9001);
+    TEST_CHECK(shown[0] == 1);
+
+    /* a time too far ahead, or already passed, is implausible */
+    at = 8000 + PAWR_ESL_MAX_TIME_AHEAD_MS + 1;
+    memcpy(&img[4], &at, 4);
+    TEST_CHECK((run(&ctx, img, sizeof(img), 8000, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_IMPLAUSIBLE_TIME));
+    at = 7999;
+    memcpy(&img[4], &at, 4);
+    TEST_CHECK((run(&ctx, img, sizeof(img), 8000, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_IMPLAUSIBLE_TIME));
+
+    /* an image the label lacks when its time comes asks for service */
+    img[3] = 3;
+    at     = 9500;
+    memcpy(&img[4], &at, 4);
+    TEST_CHECK(run(&ctx, img, sizeof(img), 9000, rsp, &slot) == 3);
+    pawr_esl_poll(&ctx, 9500);
+    TEST_CHECK(ctx.basic_state & PAWR_ESL_STATE_SERVICE_NEEDED);
+}
+
+static void test_timed_queue_full(void)
+{
+    pawr_esl_ctx_t ctx;
+    uint8_t        rsp[PAWR_ESL_MAX_RSP_LEN];
+    uint8_t        slot;
+    uint8_t        led[] = {PAWR_ESL_OP_LED_TIMED_CONTROL, ESL_ID, 0, 1, 1, 2, 3, 4, 5, 10, 20, 1, 0, 0, 0, 0, 0};
+    uint8_t        img[] = {PAWR_ESL_OP_DISPLAY_TIMED_IMAGE, ESL_ID, 0, 1, 0, 0, 0, 0};
+    uint32_t       at    = 5000;
+    pawr_esl_hw_t  big   = hw;
+
+    big.num_leds = 4;
+    pawr_esl_init(&ctx, &big, ESL_ID, GROUP_ID);
+    memcpy(&led[13], &at, 4);
+    memcpy(&img[4], &at, 4);
+    for (led[2] = 0; led[2] < PAWR_ESL_MAX_TIMED; led[2]++)
+    {
+        TEST_CHECK(run(&ctx, led, sizeof(led), 0, rsp, &slot) == 3);
+    }
+    TEST_CHECK((run(&ctx, img, sizeof(img), 0, rsp, &slot) == 2) && (rsp[1] == PAWR_ESL_ERR_QUEUE_FULL));
+}
+
+/* labels start without an ESL ID; each takes the one assigned to its own BD address */
+static void test_assign(void)
+{
+    static const wiced_bt_device_address_t addr_a = {0xC1, 0x02, 0x03, 0x04, 0x05, 0x06};
+    static const wiced_bt_device_address_t addr_b = {0xC1, 0x02, 0x03, 0x04, 0x05, 0x07};
+    pawr_esl_ctx_t a;
+    pawr_esl_ctx_t b;
+    uint8_t        msg[PAWR_ESL_ADDR_LEN] = {PAWR_MSG_TYPE_ESL_ADDR};
+    uint8_t        rsp[PAWR_ESL_MAX_RSP_LEN];
+    uint8_t        slot;
+    uint16_t       id;
+
+    pawr_esl_init(&a, &hw, PAWR_ESL_ID_NONE, GROUP_ID);
+    pawr_esl_init(&b, &hw, PAWR_ESL_ID_NONE, GROUP_ID);
+
+    /* unassigned: no unicast ID reaches the label, broadcast still runs */
+    for (id = 0; id < PAWR_ESL_ID_BROADCAST; id++)
+    {
+        const uint8_t cmd[] = {PAWR_ESL_OP_PING, (uint8_t)id};
+
+        TEST_CHECK(run(&a, cmd, sizeof(cmd), 0, rsp, &slot) == 0);
+    }
+    {
+        const uint8_t cmd[] = {PAWR_ESL_OP_DISPLAY_IMAGE, PAWR_ESL_ID_BROADCAST, 0, 1};
+
+        shown[0] = 0xFF;
+        TEST_CHECK((run(&a, cmd, sizeof(cmd), 0, rsp, &slot) == 0) && (shown[0] == 1));
+    }
+
+    /* A's assignment: only A takes it and confirms */
+    memcpy(&msg[1], addr_a, BD_ADDR_LEN);
+    msg[7] = 5;
+    msg[8] = GROUP_ID;
+    TEST_CHECK(!pawr_esl_assign(&b, addr_b, msg, sizeof(msg), rsp) && (b.esl_id == PAWR_ESL_ID_NONE));
+    TEST_CHECK(pawr_esl_assign(&a, addr_a, msg, sizeof(msg), rsp));
+    TEST_CHECK((a.esl_id == 5) && (a.group_id == GROUP_ID));
+    TEST_CHECK((rsp[0] == PAWR_MSG_TYPE_ESL_ADDR) && (rsp[1] == 5) && (rsp[2] == GROUP_ID));
+
+    /* cut short, the broadcast ID, a group outside the subevents */
+    memcpy(&msg[1], addr_b, BD_ADDR_LEN);
+    msg[7] = 6;
+    TEST_CHECK(!pawr_esl_assign(&b, addr_b, msg, sizeof(msg) - 1, rsp));
+    msg[7] = PAWR_ESL_ID_BROADCAST;
+    TEST_CHECK(!pawr_esl_assign(&b, addr_b, msg, sizeof(msg), rsp));
+    msg[7] = 6;
+    msg[8] = PAWR_CFG_SUBEVENT_TABLE_LEN;
+    TEST_CHECK(!pawr_esl_assign(&b, addr_b, msg, sizeof(msg), rsp) && (b.esl_id == PAWR_ESL_ID_NONE));
+    msg[8] = GROUP_ID;
+    TEST_CHECK(pawr_esl_assign(&b, addr_b, msg, sizeof(msg), rsp) && (b.esl_id == 6));
+
+    /* one payload for both: each answers its own command in its own slot */
+    {
+        const uint8_t cmds[] = {PAWR_ESL_OP_PING, 5, PAWR_ESL_OP_PING, 6};
+
+        TEST_CHECK((run(&a, cmds, sizeof(cmds), 0, rsp, &slot) == 3) && (slot == 0));
+        TEST_CHECK((run(&b, cmds, sizeof(cmds), 0, rsp, &slot) == 3) && (slot == 1));
+    }
+}
+
+int main(void)
+{
+    test_commands();
+    test_payload();
+    test_timed();
+    test_timed_queue_full();
+    test_assign();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,248 @@
+/******************************************************************************
+* File Name:   test_pawr_filter.c
+*
+* Description: This file tests the addressed message filter: unicast and group addresses, the wake flag,
+*              malformed wrappers, and the Bloom filter addresses with their false positive rate.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_filter.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define BLOOM_SETS                      (2000)
+#define BLOOM_SET_SIZE                  (8)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint32_t rng = 3;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint8_t next_byte(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (uint8_t)rng;
+}
+
+/* runs the filter on a copy; returns the payload left, NULL when filtered out */
+static const uint8_t *filter(const uint8_t *p_msg, uint8_t len, uint8_t *p_left)
+{
+    static uint8_t                     buf[64];
+    wiced_ble_padv_report_event_data_t report;
+    wiced_bool_t                       pass;
+
+    memcpy(buf, p_msg, len);
+    memset(&report, 0, sizeof(report));
+    report.p_data      = buf;
+    report.data_length = len;
+    pass               = pawr_filter_report(&report);
+    TEST_CHECK(pass || (report.data_length == 0));
+    *p_left = report.data_length;
+    return pass ? report.p_data : NULL;
+}
+
+static void bloom_add(uint8_t *p_bloom, uint8_t id)
+{
+    uint8_t k;
+    uint8_t bit;
+
+    for (k = 0; k < 2; k++)
+    {
+        bit = PAWR_FILTER_BLOOM_BIT(id, k);
+        p_bloom[bit / 8] |= (uint8_t)(1U << (bit % 8));
+    }
+}
+
+static void test_unicast_and_groups(void)
+{
+    const uint8_t  app[]     = {PAWR_MSG_TYPE_APP, 0x42};
+    const uint8_t  ours[]    = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_UNICAST, 17, PAWR_MSG_TYPE_APP, 0x42};
+    const uint8_t  theirs[]  = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_UNICAST, 18, PAWR_MSG_TYPE_APP, 0x42};
+    const uint8_t  groups[]  = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_GROUPS, 0x00, 0x01, 0x00, 0x80, PAWR_MSG_TYPE_APP, 0x42};
+    const uint8_t  others[]  = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_GROUPS, 0xFF, 0xFE, 0xFF, 0x7F, PAWR_MSG_TYPE_APP, 0x42};
+    const uint8_t *p;
+    uint8_t        left;
+
+    pawr_filter_set_id(17);
+    pawr_filter_set_groups(0x80000000UL);
+    TEST_CHECK(pawr_filter_get_groups() == 0x80000000UL);
+
+    /* messages without the wrapper pass unchanged */
+    p = filter(app, sizeof(app), &left);
+    TEST_CHECK((p != NULL) && (left == sizeof(app)) && (memcmp(p, app, sizeof(app)) == 0));
+
+    /* ours loses the header, another device's is emptied */
+    p = filter(ours, sizeof(ours), &left);
+    TEST_CHECK((p != NULL) && (left == sizeof(app)) && (memcmp(p, app, sizeof(app)) == 0));
+    TEST_CHECK(filter(theirs, sizeof(theirs), &left) == NULL);
+    TEST_CHECK(left == 0);
+
+    /* a group bit in common is enough; none in common is not */
+    p = filter(groups, sizeof(groups), &left);
+    TEST_CHECK((p != NULL) && (left == sizeof(app)) && (memcmp(p, app, sizeof(app)) == 0));
+    TEST_CHECK(filter(others, sizeof(others), &left) == NULL);
+    pawr_filter_set_groups(0x00000100UL);
+    TEST_CHECK(filter(groups, sizeof(groups), &left) != NULL);
+    TEST_CHECK(filter(others, sizeof(others), &left) == NULL);
+
+    /* joining sets one bit; a group past the address is refused, not folded onto group % 32 */
+    pawr_filter_set_groups(0);
+    TEST_CHECK(pawr_filter_join_group(8) && (pawr_filter_get_groups() == 0x00000100UL));
+    TEST_CHECK(pawr_filter_join_group(PAWR_FILTER_NUM_GROUPS - 1) && (pawr_filter_get_groups() == 0x80000100UL));
+    pawr_filter_set_groups(0);
+    TEST_CHECK(!pawr_filter_join_group(PAWR_FILTER_NUM_GROUPS) && !pawr_filter_join_group(PAWR_FILTER_NUM_GROUPS + 8));
+    TEST_CHECK(!pawr_filter_join_group(0xFF) && (pawr_filter_get_groups() == 0));
+    TEST_CHECK(filter(groups, sizeof(groups), &left) == NULL);
+
+    /* without an ID no unicast address matches, not even PAWR_FILTER_ID_NONE */
+    pawr_filter_set_id(PAWR_FILTER_ID_NONE);
+    TEST_CHECK(filter(ours, sizeof(ours), &left) == NULL);
+    {
+        const uint8_t none[] = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_UNICAST, PAWR_FILTER_ID_NONE, PAWR_MSG_TYPE_APP};
+
+        TEST_CHECK(filter(none, sizeof(none), &left) == NULL);
+    }
+}
+
+static void test_wake_and_malformed(void)
+{
+    pawr_filter_stats_t stats;
+    pawr_filter_stats_t before;
+    const uint8_t       wake_only[] = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_UNICAST | PAWR_FILTER_MODE_WAKE, 17};
+    const uint8_t       wake_other[] = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_UNICAST | PAWR_FILTER_MODE_WAKE, 18};
+    const uint8_t       no_msg[]    = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_UNICAST, 17};
+    const uint8_t       short_grp[] = {PAWR_MSG_TYPE_ADDRESSED, PAWR_FILTER_MODE_GROUPS, 0xFF, 0xFF, 0xFF};
+    const uint8_t       bad_mode[]  = {PAWR_MSG_TYPE_ADDRESSED, 0x03, 17, PAWR_MSG_TYPE_APP};
+    const uint8_t       type_only[] = {PAWR_MSG_TYPE_ADDRESSED};
+    uint8_t             left;
+
+    pawr_filter_set_id(17);
+    pawr_filter_set_groups(0xFFFFFFFFUL);
+    pawr_filter_get_stats(&before);
+    TEST_CHECK(!pawr_filter_take_wake());
+
+    /* a wake header may come alone: a hit with nothing left, ours to take once */
+    TEST_CHECK(filter(wake_only, sizeof(wake_only), &left) != NULL);
+    TEST_CHECK(left == 0);
+    TEST_CHECK(pawr_filter_take_wake());
+    TEST_CHECK(!pawr_filter_take_wake());
+    TEST_CHECK(filter(wake_other, sizeof(wake_other), &left) == NULL);
+    TEST_CHECK(!pawr_filter_take_wake());
+
+    /* a header without a message and without wake, a short address, an unknown mode */
+    TEST_CHECK(filter(no_msg, sizeof(no_msg), &left) == NULL);
+    TEST_CHECK(filter(short_grp, sizeof(short_grp), &left) == NULL);
+    TEST_CHECK(filter(bad_mode, sizeof(bad_mode), &left) == NULL);
+    TEST_CHECK(filter(type_only, sizeof(type_only), &left) == NULL);
+
+    pawr_filter_get_stats(&stats);
+    TEST_CHECK(stats.malformed - before.malformed == 4);
+    TEST_CHECK((stats.wakes - before.wakes == 1) && (stats.delivered - before.delivered == 1));
+    TEST_CHECK(stats.filtered - before.filtered == 1);
+}
+
+static void test_bloom(void)
+{
+    uint8_t  msg[2 + 8 + 2];
+    uint8_t  set[BLOOM_SET_SIZE];
+    uint8_t  left;
+    uint32_t hits = 0;
+    uint32_t tries = 0;
+    uint16_t id;
+    uint16_t n;
+    uint8_t  i;
+
+    msg[0]  = PAWR_MSG_TYPE_ADDRESSED;
+    msg[1]  = PAWR_FILTER_MODE_BLOOM;
+    msg[10] = PAWR_MSG_TYPE_APP;
+    msg[11] = 0x42;
+    for (n = 0; n < BLOOM_SETS; n++)
+    {
+        memset(&msg[2], 0, 8);
+        for (i = 0; i < BLOOM_SET_SIZE; i++)
+        {
+            set[i] = next_byte() % PAWR_FILTER_ID_NONE;
+            bloom_add(&msg[2], set[i]);
+        }
+        /* members always pass */
+        for (i = 0; i < BLOOM_SET_SIZE; i++)
+        {
+            pawr_filter_set_id(set[i]);
+            TEST_CHECK(filter(msg, sizeof(msg), &left) != NULL);
+            TEST_CHECK(left == 2);
+        }
+        /* others pass only by chance */
+        for (id = 0; id < PAWR_FILTER_ID_NONE; id++)
+        {
+            for (i = 0; (i < BLOOM_SET_SIZE) && (set[i] != id); i++)
+            {
+            }
+            if (i < BLOOM_SET_SIZE)
+            {
+                continue;
+            }
+            pawr_filter_set_id((uint8_t)id);
+            hits += (filter(msg, sizeof(msg), &left) != NULL);
+            tries++;
+        }
+    }
+    /* 16 of 64 bits set: two bits both set about 1 in 20 */
+    TEST_CHECK(hits * 10 < tries);
+
+    /* no ID, no match, even with every bit set */
+    memset(&msg[2], 0xFF, 8);
+    pawr_filter_set_id(PAWR_FILTER_ID_NONE);
+    TEST_CHECK(filter(msg, sizeof(msg), &left) == NULL);
+}
+
+int main(void)
+{
+    test_unicast_and_groups();
+    test_wake_and_malformed();
+    test_bloom();
+    TEST_PASS();
+    return 0;
+}
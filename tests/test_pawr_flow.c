@@ -0,0 +1,236 @@
+/******************************************************************************
+* File Name:   test_pawr_flow.c
+*
+* Description: This file tests uplink flow control: the field and its slot request, slot grants from the
+*              central, refused grants, and grants given back when idle or on sync loss.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_flow.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define EVT_MS                          (100)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* response scheduler stand-in */
+static uint8_t      sched_pending;
+static uint16_t     sched_age_evts;
+static uint8_t      sched_slots[PAWR_CFG_SUBEVENT_TABLE_LEN];   /* configured */
+static uint8_t      sched_granted[PAWR_CFG_SUBEVENT_TABLE_LEN];
+static wiced_bool_t sched_refuse;
+static uint32_t     sched_releases;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+uint8_t pawr_rsp_sched_pending(uint16_t *p_oldest_age)
+{
+    *p_oldest_age = sched_age_evts;
+    return sched_pending;
+}
+
+uint8_t pawr_rsp_sched_num_slots(uint8_t subevent)
+{
+    return (uint8_t)(sched_slots[subevent] + sched_granted[subevent]);
+}
+
+wiced_bool_t pawr_rsp_sched_grant(uint8_t subevent, uint8_t first_slot, uint8_t num_slots)
+{
+    TEST_CHECK(subevent < PAWR_CFG_SUBEVENT_TABLE_LEN);
+    if (sched_refuse)
+    {
+        return WICED_FALSE;
+    }
+    sched_granted[subevent] = num_slots;
+    return WICED_TRUE;
+}
+
+void pawr_rsp_sched_release_grants(void)
+{
+    memset(sched_granted, 0, sizeof(sched_granted));
+    sched_releases++;
+}
+
+static void sync(void)
+{
+    wiced_ble_padv_sync_established_event_data_t ps;
+
+    memset(&ps, 0, sizeof(ps));
+    ps.periodic_adv_int = EVT_MS * 4 / 5;
+    pawr_flow_on_sync(&ps);
+}
+
+static void test_field(void)
+{
+    const uint8_t     on[]        = {PAWR_MSG_TYPE_FLOW, 0};
+    const uint8_t     short_msg[] = {PAWR_MSG_TYPE_FLOW, 1, 0, 0};
+    uint8_t           field[PAWR_FLOW_HDR_LEN];
+    pawr_flow_stats_t stats;
+
+    pawr_flow_init();
+    sched_slots[0] = 1;
+    sched_slots[1] = 1;
+    sync();
+
+    /* off until the central sends a flow message, a truncated one does not count */
+    sched_pending  = 9;
+    sched_age_evts = 25;
+    pawr_flow_update(1);
+    TEST_CHECK(pawr_flow_get_field(field) == 0);
+    pawr_flow_on_msg(short_msg, sizeof(short_msg));
+    pawr_flow_update(2);
+    TEST_CHECK(pawr_flow_get_field(field) == 0);
+    pawr_flow_on_msg(on, sizeof(on));
+    pawr_flow_update(3);
+
+    /* 9 pending, 2.5 s old, 3 slots an event would drain them in 4 events, 2 are held */
+    TEST_CHECK(pawr_flow_get_field(field) == PAWR_FLOW_HDR_LEN);
+    TEST_CHECK((field[0] == PAWR_MSG_TYPE_FLOW) && (field[1] == 9) && (field[2] == 25) && (field[3] == 0) && (field[4] == 1));
+
+    /* only while something is pending */
+    sched_pending = 0;
+    pawr_flow_update(4);
+    TEST_CHECK(pawr_flow_get_field(field) == 0);
+
+    /* the depth saturates; enough slots held means no request */
+    sched_pending  = 0xFF;
+    sched_age_evts = 0xFFFF;
+    pawr_flow_update(5);
+    TEST_CHECK(pawr_flow_get_field(field) == PAWR_FLOW_HDR_LEN);
+    TEST_CHECK((field[1] == 0xFF) && (field[2] == 0xFF) && (field[3] == 0xFF) && (field[4] == 64 - 2));
+    sched_slots[0] = 40;
+    sched_slots[1] = 40;
+    pawr_flow_update(6);
+    TEST_CHECK(pawr_flow_get_field(field) == PAWR_FLOW_HDR_LEN);
+    TEST_CHECK(field[4] == 0);
+    sched_slots[0] = 1;
+    sched_slots[1] = 1;
+
+    pawr_flow_get_stats(&stats);
+    TEST_CHECK((stats.fields == 3) && (stats.depth_max == 0xFF) && (stats.req_max == 62));
+
+    /* a new sync turns the field off again */
+    sync();
+    pawr_flow_update(7);
+    TEST_CHECK(pawr_flow_get_field(field) == 0);
+}
+
+static void test_grants(void)
+{
+    const uint8_t     grant[]   = {PAWR_MSG_TYPE_FLOW, 2, 0, 1, 3, 1, 1, 2};
+    const uint8_t     outside[] = {PAWR_MSG_TYPE_FLOW, 2, PAWR_CFG_SUBEVENT_TABLE_LEN, 1, 3, 0xFF, 1, 3};
+    const uint8_t     end[]     = {PAWR_MSG_TYPE_FLOW, 1, 1, 1, 0};
+    uint8_t           field[PAWR_FLOW_HDR_LEN];
+    pawr_flow_stats_t stats;
+    uint32_t          releases;
+    uint16_t          evt;
+
+    pawr_flow_init();
+    sync();
+    sched_pending  = 20;
+    sched_age_evts = 0;
+
+    /* grants on the synchronized subevents count towards the slots held */
+    pawr_flow_on_msg(grant, sizeof(grant));
+    TEST_CHECK((sched_granted[0] == 3) && (sched_granted[1] == 2));
+    pawr_flow_update(1);
+    TEST_CHECK((pawr_flow_get_field(field) == PAWR_FLOW_HDR_LEN) && (field[4] == 0));
+
+    /* subevents this device is not synchronized to are refused, as are grants the scheduler refuses */
+    pawr_flow_on_msg(outside, sizeof(outside));
+    sched_refuse = WICED_TRUE;
+    pawr_flow_on_msg(end, sizeof(end));
+    sched_refuse = WICED_FALSE;
+    TEST_CHECK(sched_granted[1] == 2);
+    pawr_flow_get_stats(&stats);
+    TEST_CHECK((stats.grants == 2) && (stats.rejected == 3) && (stats.granted_max == 5));
+
+    /* a grant of 0 slots ends one */
+    pawr_flow_on_msg(end, sizeof(end));
+    TEST_CHECK(sched_granted[1] == 0);
+
+    /* given back after PAWR_FLOW_IDLE_EVENTS events with nothing pending; subevents of one
+     * event count once, anything pending starts over */
+    releases      = sched_releases;
+    sched_pending = 0;
+    for (evt = 10; evt < 10 + PAWR_FLOW_IDLE_EVENTS - 1; evt++)
+    {
+        pawr_flow_update(evt);
+        pawr_flow_update(evt);
+    }
+    TEST_CHECK((sched_releases == releases) && (sched_granted[0] == 3));
+    sched_pending = 1;
+    pawr_flow_update(evt++);
+    sched_pending = 0;
+    for (; evt < 10 + 2 * PAWR_FLOW_IDLE_EVENTS - 1; evt++)
+    {
+        pawr_flow_update(evt);
+    }
+    TEST_CHECK(sched_releases == releases);
+    pawr_flow_update(evt++);
+    TEST_CHECK((sched_releases == releases + 1) && (sched_granted[0] == 0));
+    pawr_flow_get_stats(&stats);
+    TEST_CHECK(stats.releases == 1);
+
+    /* with nothing granted there is nothing to give back */
+    for (; evt < 10 + 4 * PAWR_FLOW_IDLE_EVENTS; evt++)
+    {
+        pawr_flow_update(evt);
+    }
+    TEST_CHECK(sched_releases == releases + 1);
+
+    /* the sync loss ends the grants */
+    pawr_flow_on_msg(grant, sizeof(grant));
+    pawr_flow_on_sync_lost();
+    TEST_CHECK((sched_granted[0] == 0) && (sched_granted[1] == 0));
+    pawr_flow_print_stats();
+}
+
+int main(void)
+{
+    test_field();
+    test_grants();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,530 @@
+/******************************************************************************
+* File Name:   test_pawr_frame.c
+*
+* Description: This file tests the display frame update of pawr_frame.c against a RAM frame store: every
+*              record type at the edges of its tile, streams cut inside any record, records outside the
+*              tile or the frame, fragment order and store failures.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <setjmp.h>
+#include "host_test.h"
+#include "pawr_frame.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SE                              (PAWR_CFG_FIRST_SUBEVENT)
+#define LAST_TILE                       (PAWR_FRAME_NUM_TILES - 1)
+#define LAST_TILE_ROWS                  (PAWR_CFG_FRAME_HEIGHT - LAST_TILE * PAWR_FRAME_TILE_ROWS)
+#define MY_ADDR                         (5)
+#define FRAG_MAX                        (247 - PAWR_FRAME_DATA_HDR_LEN)
+
+/* appends the bytes of one record to the stream */
+#define REC(...)                        do { const uint8_t rec_[] = {__VA_ARGS__}; put(rec_, sizeof(rec_)); } while (0)
+
+_Static_assert(LAST_TILE_ROWS < PAWR_FRAME_TILE_ROWS, "the tests need a short last tile");
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* frame store in RAM, tiles at their stride as in the serial flash */
+static uint8_t      store[PAWR_FRAME_NUM_TILES][PAWR_FRAME_TILE_STRIDE];
+static wiced_bool_t store_fail_init;
+static wiced_bool_t store_fail_write;
+
+/* what the stored frame should hold */
+static uint8_t      model[PAWR_FRAME_BYTES];
+
+static uint8_t      strm[2 * PAWR_FRAME_BYTES];
+static uint16_t     strm_len;
+
+static uint8_t      status[PAWR_FRAME_STATUS_LEN];
+static uint32_t     num_status;
+static uint16_t     ready_version;
+static uint32_t     num_ready;
+static uint8_t      update_id;
+static jmp_buf      task_idle;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static wiced_bool_t store_init(void)
+{
+    return !store_fail_init;
+}
+
+static wiced_bool_t store_read(uint16_t tile, uint8_t *p_buf, uint16_t len)
+{
+    TEST_CHECK((tile < PAWR_FRAME_NUM_TILES) && (len <= pawr_frame_tile_len(tile)));
+    memcpy(p_buf, store[tile], len);
+    return WICED_TRUE;
+}
+
+static wiced_bool_t store_write(uint16_t tile, const uint8_t *p_buf, uint16_t len)
+{
+    TEST_CHECK((tile < PAWR_FRAME_NUM_TILES) && (len == pawr_frame_tile_len(tile)));
+    if (store_fail_write)
+    {
+        return WICED_FALSE;
+    }
+    memcpy(store[tile], p_buf, len);
+    return WICED_TRUE;
+}
+
+static const pawr_frame_store_t ram_store =
+{
+    .init       = store_init,
+    .read_tile  = store_read,
+    .write_tile = store_write,
+};
+
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    TEST_CHECK((prio == PAWR_RSP_PRIO_CONTROL) && (data_len == PAWR_FRAME_STATUS_LEN) && (p_data[0] == PAWR_MSG_TYPE_FRAME));
+    memcpy(status, p_data, data_len);
+    num_status++;
+    return WICED_BT_SUCCESS;
+}
+
+static void ready_cb(uint16_t version)
+{
+    ready_version = version;
+    num_ready++;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    longjmp(task_idle, 1);
+}
+
+/* runs the decoder task until the byte queue is empty */
+static void pump(void)
+{
+    if (setjmp(task_idle) == 0)
+    {
+        host_task_fn[host_num_tasks - 1](NULL);
+    }
+}
+
+static void put(const uint8_t *p_data, uint16_t len)
+{
+    TEST_CHECK(strm_len + len <= sizeof(strm));
+    memcpy(&strm[strm_len], p_data, len);
+    strm_len = (uint16_t)(strm_len + len);
+}
+
+static void msg_begin(uint8_t id, uint8_t addr, uint16_t base, uint16_t version)
+{
+    const uint8_t m[] = {PAWR_MSG_TYPE_FRAME, PAWR_FRAME_OP_BEGIN, id, addr,
+                         (uint8_t)base, (uint8_t)(base >> 8), (uint8_t)version, (uint8_t)(version >> 8)};
+
+    pawr_frame_on_msg(SE, m, sizeof(m));
+}
+
+static void msg_data(uint8_t id, uint16_t seq, const uint8_t *p_data, uint16_t len)
+{
+    uint8_t m[PAWR_FRAME_DATA_HDR_LEN + FRAG_MAX];
+
+    m[0] = PAWR_MSG_TYPE_FRAME;
+    m[1] = PAWR_FRAME_OP_DATA;
+    m[2] = id;
+    m[3] = (uint8_t)seq;
+    m[4] = (uint8_t)(seq >> 8);
+    memcpy(&m[PAWR_FRAME_DATA_HDR_LEN], p_data, len);
+    pawr_frame_on_msg(SE, m, (uint16_t)(PAWR_FRAME_DATA_HDR_LEN + len));
+}
+
+/* queries the state after the decoder ran */
+static uint8_t query(uint8_t id)
+{
+    const uint8_t m[] = {PAWR_MSG_TYPE_FRAME, PAWR_FRAME_OP_QUERY, id};
+
+    pump();
+    pawr_frame_on_msg(SE, m, sizeof(m));
+    return status[2];
+}
+
+static uint16_t status_version(void)
+{
+    return (uint16_t)(status[3] | (status[4] << 8));
+}
+
+static uint16_t status_next_seq(void)
+{
+    return (uint16_t)(status[5] | (status[6] << 8));
+}
+
+/* a new update carrying the stream, in fragments of frag bytes; returns the state afterwards */
+static uint8_t update(uint16_t base, uint16_t version, uint16_t frag)
+{
+    uint16_t seq = 0;
+    uint16_t pos;
+    uint16_t n;
+
+    update_id++;
+    msg_begin(update_id, MY_ADDR, base, version);
+    TEST_CHECK((status[1] == update_id) && (status[2] == PAWR_FRAME_STATE_RECEIVING));
+    for (pos = 0; pos < strm_len; pos = (uint16_t)(pos + n))
+    {
+        n = (uint16_t)((strm_len - pos < frag) ? (strm_len - pos) : frag);
+        msg_data(update_id, seq++, &strm[pos], n);
+        pump();
+    }
+    return query(update_id);
+}
+
+static void check_store(void)
+{
+    uint16_t t;
+
+    for (t = 0; t < PAWR_FRAME_NUM_TILES; t++)
+    {
+        TEST_CHECK(memcmp(store[t], &model[t * PAWR_FRAME_TILE_BYTES], pawr_frame_tile_len(t)) == 0);
+    }
+}
+
+/* a full frame: every tile one run of its own value */
+static void full_frame(uint8_t value)
+{
+    uint16_t t;
+    uint16_t len;
+
+    strm_len = 0;
+    for (t = 0; t < PAWR_FRAME_NUM_TILES; t++)
+    {
+        len = pawr_frame_tile_len(t);
+        REC(PAWR_FRAME_REC_TILE, (uint8_t)t);
+        REC(PAWR_FRAME_REC_RUN, 0, 0, (uint8_t)len, (uint8_t)(len >> 8), (uint8_t)(value + t));
+        memset(&model[t * PAWR_FRAME_TILE_BYTES], value + t, len);
+    }
+    REC(PAWR_FRAME_REC_END);
+}
+
+static void model_rect(uint8_t tile, uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *p_data, uint8_t value)
+{
+    uint8_t r;
+    uint8_t c;
+
+    for (r = 0; r < h; r++)
+    {
+        for (c = 0; c < w; c++)
+        {
+            model[tile * PAWR_FRAME_TILE_BYTES + (y + r) * PAWR_CFG_FRAME_ROW_BYTES + x + c] =
+                (p_data != NULL) ? p_data[r * w + c] : value;
+        }
+    }
+}
+
+/* every record type, each at the edge of its tile */
+static void test_every_op(void)
+{
+    static const uint16_t frags[] = {1, 2, 5, 7, 64, FRAG_MAX};
+    const uint16_t        tile_end = PAWR_FRAME_TILE_BYTES;
+    const uint16_t        last_end = (uint16_t)(LAST_TILE_ROWS * PAWR_CFG_FRAME_ROW_BYTES);
+    uint8_t               lit[40];
+    uint8_t               rect[4 * 6];
+    uint16_t              version = 1;
+    pawr_frame_stats_t    s;
+    pawr_frame_stats_t    e;
+    uint8_t               i;
+
+    full_frame(0x10);
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, version, FRAG_MAX) == PAWR_FRAME_STATE_DONE);
+    TEST_CHECK((status_version() == version) && (num_ready == 1) && (ready_version == version));
+    check_store();
+
+    for (i = 0; i < sizeof(lit); i++)
+    {
+        lit[i] = (uint8_t)(0x80 + i);
+    }
+    for (i = 0; i < sizeof(rect); i++)
+    {
+        rect[i] = (uint8_t)(0xC0 + i);
+    }
+    strm_len = 0;
+    REC(PAWR_FRAME_REC_TILE, 0);
+    REC(PAWR_FRAME_REC_LITERAL, 10, 0, sizeof(lit), 0);
+    put(lit, sizeof(lit));
+    memcpy(&model[10], lit, sizeof(lit));
+    REC(PAWR_FRAME_REC_RECT, 5, 3, 4, 6);
+    put(rect, sizeof(rect));
+    model_rect(0, 5, 3, 4, 6, rect, 0);
+    REC(PAWR_FRAME_REC_RECT, PAWR_CFG_FRAME_ROW_BYTES - 4, PAWR_FRAME_TILE_ROWS - 6, 4, 6);
+    put(rect, sizeof(rect));
+    model_rect(0, PAWR_CFG_FRAME_ROW_BYTES - 4, PAWR_FRAME_TILE_ROWS - 6, 4, 6, rect, 0);
+    REC(PAWR_FRAME_REC_TILE, 2);
+    REC(PAWR_FRAME_REC_FILL_RECT, 0, PAWR_FRAME_TILE_ROWS - 1, PAWR_CFG_FRAME_ROW_BYTES, 1, 0xAA);
+    model_rect(2, 0, PAWR_FRAME_TILE_ROWS - 1, PAWR_CFG_FRAME_ROW_BYTES, 1, NULL, 0xAA);
+    REC(PAWR_FRAME_REC_RUN, (uint8_t)(tile_end - 50), (uint8_t)((tile_end - 50) >> 8), 50, 0, 0x55);
+    memset(&model[2 * PAWR_FRAME_TILE_BYTES + tile_end - 50], 0x55, 50);
+    REC(PAWR_FRAME_REC_TILE, LAST_TILE);
+    REC(PAWR_FRAME_REC_RECT, PAWR_CFG_FRAME_ROW_BYTES - 4, LAST_TILE_ROWS - 1, 4, 1);
+    put(rect, 4);
+    model_rect(LAST_TILE, PAWR_CFG_FRAME_ROW_BYTES - 4, LAST_TILE_ROWS - 1, 4, 1, rect, 0);
+    REC(PAWR_FRAME_REC_LITERAL, (uint8_t)(last_end - 2), (uint8_t)((last_end - 2) >> 8), 2, 0, 0xEE, 0xEF);
+    model[LAST_TILE * PAWR_FRAME_TILE_BYTES + last_end - 2] = 0xEE;
+    model[LAST_TILE * PAWR_FRAME_TILE_BYTES + last_end - 1] = 0xEF;
+    REC(PAWR_FRAME_REC_END);
+
+    /* records split at every place the fragment sizes put them */
+    for (i = 0; i < sizeof(frags) / sizeof(frags[0]); i++)
+    {
+        pawr_frame_get_stats(&s);
+        TEST_CHECK(update(version, (uint16_t)(version + 1), frags[i]) == PAWR_FRAME_STATE_DONE);
+        version++;
+        TEST_CHECK((status_version() == version) && (ready_version == version));
+        check_store();
+        /* tiles 0, 2 and the last one, nothing else */
+        pawr_frame_get_stats(&e);
+        TEST_CHECK(e.tiles_written == s.tiles_written + 3);
+    }
+    TEST_CHECK((e.encoded_bytes < e.raw_bytes) && (e.errors == 0));
+}
+
+/* a stream cut inside any record never completes; the next BEGIN aborts it */
+static void test_truncated(void)
+{
+    uint8_t            recs[5][PAWR_FRAME_REC_MAX_HDR + 4];
+    uint8_t            lens[5];
+    uint8_t            r;
+    uint8_t            cut;
+    pawr_frame_stats_t s;
+    pawr_frame_stats_t e;
+
+    const uint8_t run[]  = {PAWR_FRAME_REC_RUN, 0, 0, 8, 0, 0x77};
+    const uint8_t lit[]  = {PAWR_FRAME_REC_LITERAL, 0, 0, 4, 0, 1, 2, 3, 4};
+    const uint8_t rect[] = {PAWR_FRAME_REC_RECT, 0, 0, 2, 2, 1, 2, 3, 4};
+    const uint8_t fill[] = {PAWR_FRAME_REC_FILL_RECT, 0, 0, 2, 2, 0x66};
+    const uint8_t tile[] = {PAWR_FRAME_REC_TILE, 1};
+
+    memcpy(recs[0], run, lens[0] = sizeof(run));
+    memcpy(recs[1], lit, lens[1] = sizeof(lit));
+    memcpy(recs[2], rect, lens[2] = sizeof(rect));
+    memcpy(recs[3], fill, lens[3] = sizeof(fill));
+    memcpy(recs[4], tile, lens[4] = sizeof(tile));
+
+    full_frame(0x20);
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 100, FRAG_MAX) == PAWR_FRAME_STATE_DONE);
+    for (r = 0; r < 5; r++)
+    {
+        for (cut = 1; cut < lens[r]; cut++)
+        {
+            pawr_frame_get_stats(&s);
+            strm_len = 0;
+            REC(PAWR_FRAME_REC_TILE, 0);
+            put(recs[r], cut);
+            TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 101, 3) == PAWR_FRAME_STATE_RECEIVING);
+            /* the cut record never ran, so no tile was written */
+            pawr_frame_get_stats(&e);
+            TEST_CHECK((e.tiles_written == s.tiles_written) && (e.updates == s.updates));
+            msg_begin((uint8_t)(update_id + 1), MY_ADDR, PAWR_FRAME_VERSION_NONE, 102);
+            TEST_CHECK(query(update_id) == PAWR_FRAME_STATE_ERROR);
+            TEST_CHECK(status_version() == PAWR_FRAME_VERSION_NONE);
+            check_store();
+        }
+    }
+    pawr_frame_get_stats(&e);
+    TEST_CHECK(e.errors >= 5);
+
+    /* messages too short for their op are dropped without a status */
+    {
+        const uint8_t begin[] = {PAWR_MSG_TYPE_FRAME, PAWR_FRAME_OP_BEGIN, 0x77, MY_ADDR, 0xFF, 0xFF, 1};
+        const uint8_t data[]  = {PAWR_MSG_TYPE_FRAME, PAWR_FRAME_OP_DATA, 0x77, 0, 0};
+        const uint8_t two[]   = {PAWR_MSG_TYPE_FRAME, PAWR_FRAME_OP_QUERY};
+        uint32_t      n       = num_status;
+
+        pawr_frame_on_msg(SE, begin, sizeof(begin));
+        pawr_frame_on_msg(SE, data, sizeof(data));
+        pawr_frame_on_msg(SE, two, sizeof(two));
+        pawr_frame_on_msg(SE, two, 0);
+        TEST_CHECK(num_status == n);
+    }
+}
+
+/* each bad record fails the update before any tile is written */
+static void test_out_of_bounds(void)
+{
+    const uint16_t     tile_end = PAWR_FRAME_TILE_BYTES;
+    const uint16_t     last_end = (uint16_t)(LAST_TILE_ROWS * PAWR_CFG_FRAME_ROW_BYTES);
+    uint8_t            before[sizeof(store)];
+    pawr_frame_stats_t s;
+    pawr_frame_stats_t e;
+    uint8_t            c;
+
+    full_frame(0x30);
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 200, FRAG_MAX) == PAWR_FRAME_STATE_DONE);
+    memcpy(before, store, sizeof(store));
+    for (c = 0; c < 18; c++)
+    {
+        strm_len = 0;
+        switch (c)
+        {
+            case 0:  REC(PAWR_FRAME_REC_TILE, PAWR_FRAME_NUM_TILES); break;
+            case 1:  REC(PAWR_FRAME_REC_TILE, 1, PAWR_FRAME_REC_TILE, 1); break;
+            case 2:  REC(PAWR_FRAME_REC_TILE, 1, PAWR_FRAME_REC_TILE, 0); break;
+            case 3:  REC(PAWR_FRAME_REC_RUN, 0, 0, 1, 0, 0); break;                          /* before any TILE */
+            case 4:  REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_RUN, 0, 0, 0, 0, 0); break;  /* count 0 */
+            case 5:  REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_RUN, (uint8_t)(tile_end - 1), (uint8_t)((tile_end - 1) >> 8), 2, 0, 0); break;
+            case 6:  REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_RUN, 0xFF, 0xFF, 0xFF, 0xFF, 0); break;
+            case 7:  REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_LITERAL, 0, 0, (uint8_t)(tile_end + 1), (uint8_t)((tile_end + 1) >> 8)); break;
+            case 8:  REC(PAWR_FRAME_REC_TILE, LAST_TILE, PAWR_FRAME_REC_RUN, (uint8_t)(last_end - 1), (uint8_t)((last_end - 1) >> 8), 2, 0, 0); break;
+            case 9:  REC(PAWR_FRAME_REC_TILE, LAST_TILE, PAWR_FRAME_REC_LITERAL, (uint8_t)last_end, (uint8_t)(last_end >> 8), 1, 0); break;
+            case 10: REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_RECT, PAWR_CFG_FRAME_ROW_BYTES - 3, 0, 4, 1); break;
+            case 11: REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_RECT, 0, 0, 0, 1); break;
+            case 12: REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_FILL_RECT, 0, 0, 1, 0, 0); break;
+            case 13: REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_FILL_RECT, 0, PAWR_FRAME_TILE_ROWS - 1, 1, 2, 0); break;
+            case 14: REC(PAWR_FRAME_REC_TILE, LAST_TILE, PAWR_FRAME_REC_RECT, 0, LAST_TILE_ROWS - 1, 1, 2); break;
+            case 15: REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_FILL_RECT, 0xFF, 0xFF, 0xFF, 0xFF, 0); break;
+            case 16: REC(PAWR_FRAME_REC_TILE, 0, PAWR_FRAME_REC_FILL_RECT + 1); break;     /* unknown opcodes */
+            default: REC(PAWR_FRAME_REC_TILE, 0, 0xFF); break;
+        }
+        pawr_frame_get_stats(&s);
+        TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 201, 4) == PAWR_FRAME_STATE_ERROR);
+        pawr_frame_get_stats(&e);
+        TEST_CHECK((status_version() == PAWR_FRAME_VERSION_NONE) && (e.errors == s.errors + 1));
+        TEST_CHECK((e.tiles_written == s.tiles_written) && (memcmp(before, store, sizeof(store)) == 0));
+        /* a delta needs a known base, a full update recovers */
+        update_id++;
+        msg_begin(update_id, MY_ADDR, 200, 202);
+        TEST_CHECK(status[2] == PAWR_FRAME_STATE_ERROR);
+        full_frame(0x30);
+        TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 200, FRAG_MAX) == PAWR_FRAME_STATE_DONE);
+    }
+}
+
+/* fragments are taken in order only; the status names the next one wanted */
+static void test_fragments(void)
+{
+    pawr_frame_stats_t s;
+    pawr_frame_stats_t e;
+    uint32_t           n;
+    uint16_t           seq;
+
+    full_frame(0x40);
+    pawr_frame_get_stats(&s);
+    update_id++;
+    msg_begin(update_id, MY_ADDR, PAWR_FRAME_VERSION_NONE, 300);
+    n = num_status;
+    msg_data(update_id, 1, &strm[10], 10);                              /* gap */
+    TEST_CHECK((num_status == n + 1) && (status_next_seq() == 0));
+    msg_data(update_id, 0, &strm[0], 10);
+    msg_data(update_id, 0, &strm[0], 10);                               /* dup */
+    msg_data((uint8_t)(update_id + 1), 1, &strm[10], 10);               /* another update */
+    TEST_CHECK(num_status == n + 1);
+    /* the queue fills when the decoder does not run */
+    for (seq = 1; num_status == n + 1; seq++)
+    {
+        msg_data(update_id, seq, &strm[10 + (seq - 1) * 10], 10);
+    }
+    seq--;
+    TEST_CHECK((status_next_seq() == seq) && (seq * 10 <= PAWR_FRAME_RING_LEN));
+    pump();
+    for (; 10 + (seq - 1) * 10 < strm_len; seq++)
+    {
+        msg_data(update_id, seq, &strm[10 + (seq - 1) * 10],
+                 (uint16_t)((strm_len - (10 + (seq - 1) * 10) < 10) ? (strm_len - (10 + (seq - 1) * 10)) : 10));
+        pump();
+    }
+    TEST_CHECK(query(update_id) == PAWR_FRAME_STATE_DONE);
+    check_store();
+    pawr_frame_get_stats(&e);
+    TEST_CHECK((e.fragments_gap == s.fragments_gap + 1) && (e.fragments_dup == s.fragments_dup + 1) &&
+               (e.fragments_busy == s.fragments_busy + 1));
+}
+
+/* BEGIN is taken for our address or all, on a matching base, once per update */
+static void test_begin(void)
+{
+    uint32_t n = num_status;
+
+    full_frame(0x50);
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 400, FRAG_MAX) == PAWR_FRAME_STATE_DONE);
+    msg_begin((uint8_t)(update_id + 1), MY_ADDR + 1, PAWR_FRAME_VERSION_NONE, 401);
+    TEST_CHECK(num_status == n + 2);
+    msg_begin((uint8_t)(update_id + 1), MY_ADDR, 399, 401);
+    TEST_CHECK((status[1] == update_id) && (status[2] == PAWR_FRAME_STATE_DONE));
+    update_id++;
+    msg_begin(update_id, PAWR_FRAME_ADDR_ALL, 400, 401);
+    TEST_CHECK((status[1] == update_id) && (status[2] == PAWR_FRAME_STATE_RECEIVING));
+    /* repeated while receiving: unchanged */
+    msg_begin(update_id, PAWR_FRAME_ADDR_ALL, 400, 401);
+    TEST_CHECK((status[1] == update_id) && (status[2] == PAWR_FRAME_STATE_RECEIVING));
+    msg_data(update_id, 0, strm, (uint16_t)(strm_len - 1));           /* all but END */
+    pump();
+    TEST_CHECK(query(update_id) == PAWR_FRAME_STATE_RECEIVING);
+    /* another update id aborts it */
+    msg_begin((uint8_t)(update_id + 1), MY_ADDR, PAWR_FRAME_VERSION_NONE, 402);
+    TEST_CHECK(query(update_id) == PAWR_FRAME_STATE_ERROR);
+}
+
+static void test_store_failure(void)
+{
+    full_frame(0x60);
+    store_fail_write = WICED_TRUE;
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 500, FRAG_MAX) == PAWR_FRAME_STATE_ERROR);
+    store_fail_write = WICED_FALSE;
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 500, FRAG_MAX) == PAWR_FRAME_STATE_DONE);
+    check_store();
+
+    /* a store that does not come up fails the update, and is tried again for the next */
+    pawr_frame_set_store(&ram_store);
+    store_fail_init = WICED_TRUE;
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 501, FRAG_MAX) == PAWR_FRAME_STATE_ERROR);
+    store_fail_init = WICED_FALSE;
+    TEST_CHECK(update(PAWR_FRAME_VERSION_NONE, 501, FRAG_MAX) == PAWR_FRAME_STATE_DONE);
+}
+
+int main(void)
+{
+    memset(store, 0xEE, sizeof(store));
+    pawr_frame_init();
+    pawr_frame_set_store(&ram_store);
+    pawr_frame_set_addr(MY_ADDR);
+    pawr_frame_reg_ready_cb(ready_cb);
+    test_every_op();
+    test_truncated();
+    test_out_of_bounds();
+    test_fragments();
+    test_begin();
+    test_store_failure();
+    TEST_PASS();
+    return 0;
+}
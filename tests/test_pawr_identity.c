@@ -0,0 +1,220 @@
+/******************************************************************************
+* File Name:   test_pawr_identity.c
+*
+* Description: This file tests the peripheral identity: the static random address of the real
+*              generator in app_bt_bd_addr.c over 100k IDs, and the spread of the slot derived
+*              from the same IDs.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "pawr_identity.h"
+#include "app_bt_utils.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define NUM_IDS                         (100000)
+#define NUM_SLOTS                       (32)
+#define ADDR_RANDOM_BITS                (46)     /* below the two static random type bits */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint64_t addrs[NUM_IDS];
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void uid_from_index(uint32_t n, uint8_t *p_uid)
+{
+    memset(p_uid, 0, PAWR_IDENTITY_UID_LEN);
+    p_uid[0] = (uint8_t)n;
+    p_uid[1] = (uint8_t)(n >> 8);
+    p_uid[2] = (uint8_t)(n >> 16);
+}
+
+static uint64_t addr_to_u64(const wiced_bt_device_address_t addr)
+{
+    uint64_t v = 0;
+    uint8_t  i;
+
+    for (i = 0; i < BD_ADDR_LEN; i++)
+    {
+        v = (v << 8) | addr[i];
+    }
+    return v;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void test_init_reads_unique_id(void)
+{
+    const uint8_t             expect[PAWR_IDENTITY_UID_LEN] = {0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01};
+    wiced_bt_device_address_t addr;
+    wiced_bt_device_address_t ref;
+
+    /* Cy_SysLib_GetUniqueId() fake: 0x0123456789ABCDEF, taken least significant byte first */
+    pawr_identity_init();
+    pawr_identity_get_bd_addr(addr);
+    app_bt_util_generate_bd_address(expect, sizeof(expect), ref);
+    TEST_CHECK(memcmp(addr, ref, BD_ADDR_LEN) == 0);
+}
+
+static void test_addr_static_random(void)
+{
+    static uint32_t           bit_ones[ADDR_RANDOM_BITS];
+    static uint32_t           byte_hits[BD_ADDR_LEN][256];
+    uint8_t                   uid[PAWR_IDENTITY_UID_LEN];
+    wiced_bt_device_address_t addr;
+    uint64_t                  low;
+    uint32_t                  n;
+    uint32_t                  b;
+
+    /* consecutive IDs, as from one production lot */
+    for (n = 0; n < NUM_IDS; n++)
+    {
+        uid_from_index(n, uid);
+        pawr_identity_init_from_id(uid, sizeof(uid));
+        pawr_identity_get_bd_addr(addr);
+        addrs[n] = addr_to_u64(addr);
+
+        /* static random: the two most significant bits set, the other 46 neither all zero nor all one */
+        TEST_CHECK((addr[0] & 0xC0) == 0xC0);
+        low = addrs[n] & ((1ULL << ADDR_RANDOM_BITS) - 1);
+        TEST_CHECK((low != 0) && (low != (1ULL << ADDR_RANDOM_BITS) - 1));
+        for (b = 0; b < ADDR_RANDOM_BITS; b++)
+        {
+            bit_ones[b] += (uint32_t)((low >> b) & 1);
+        }
+        for (b = 0; b < BD_ADDR_LEN; b++)
+        {
+            byte_hits[b][addr[b]]++;
+        }
+    }
+
+    /* every address distinct; 100k draws from 2^46 collide with odds of about 1 in 14000 */
+    qsort(addrs, NUM_IDS, sizeof(addrs[0]), cmp_u64);
+    for (n = 1; n < NUM_IDS; n++)
+    {
+        TEST_CHECK(addrs[n] != addrs[n - 1]);
+    }
+
+    /* each random bit is set in half the addresses; 5 sigma is 791 */
+    for (b = 0; b < ADDR_RANDOM_BITS; b++)
+    {
+        TEST_CHECK((bit_ones[b] > NUM_IDS / 2 - 791) && (bit_ones[b] < NUM_IDS / 2 + 791));
+    }
+    /* each value of the five full bytes is equally likely, 391 each; 5 sigma is 99. The first byte
+     * holds 6 random bits, each of its 64 values 1563 times; 5 sigma is 196 */
+    for (b = 0; b < 256; b++)
+    {
+        TEST_CHECK((b < 0xC0) ? (byte_hits[0][b] == 0) :
+                                ((byte_hits[0][b] > 1563 - 196) && (byte_hits[0][b] < 1563 + 196)));
+        for (n = 1; n < BD_ADDR_LEN; n++)
+        {
+            TEST_CHECK((byte_hits[n][b] > 391 - 99) && (byte_hits[n][b] < 391 + 99));
+        }
+    }
+}
+
+static void test_slot_range(void)
+{
+    uint8_t uid[PAWR_IDENTITY_UID_LEN];
+    uint8_t slot;
+
+    uid_from_index(1, uid);
+    pawr_identity_init_from_id(uid, sizeof(uid));
+    TEST_CHECK(pawr_identity_get_slot(0) == 0);
+    TEST_CHECK(pawr_identity_get_slot(1) == 0);
+    TEST_CHECK(pawr_identity_get_slot(255) < 255);
+
+    /* the same ID always lands on the same position */
+    slot = pawr_identity_get_slot(NUM_SLOTS);
+    pawr_identity_init_from_id(uid, sizeof(uid));
+    TEST_CHECK(pawr_identity_get_slot(NUM_SLOTS) == slot);
+}
+
+static void test_slot_spread(void)
+{
+    static uint32_t hits[NUM_SLOTS];
+    uint8_t         uid[PAWR_IDENTITY_UID_LEN];
+    uint8_t         slot;
+    uint8_t         prev = 0xFF;
+    uint32_t        same_as_prev = 0;
+    uint32_t        n;
+
+    /* consecutive IDs still spread evenly over all positions */
+    for (n = 0; n < NUM_IDS; n++)
+    {
+        uid_from_index(n, uid);
+        pawr_identity_init_from_id(uid, sizeof(uid));
+        slot = pawr_identity_get_slot(NUM_SLOTS);
+        TEST_CHECK(slot < NUM_SLOTS);
+        hits[slot]++;
+        if (slot == prev)
+        {
+            same_as_prev++;
+        }
+        prev = slot;
+    }
+    for (n = 0; n < NUM_SLOTS; n++)
+    {
+        /* 3125 expected each; 5 sigma is 275 */
+        TEST_CHECK((hits[n] > 3125 - 275) && (hits[n] < 3125 + 275));
+    }
+    /* neighbours collide about as often as random pairs, 1 in 32 */
+    TEST_CHECK(same_as_prev < 2 * NUM_IDS / NUM_SLOTS);
+}
+
+int main(void)
+{
+    test_init_reads_unique_id();
+    test_addr_static_random();
+    test_slot_range();
+    test_slot_spread();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+* File Name:   test_pawr_link.c
+*
+* Description: This file tests the link quality estimator: RSSI and loss averages, response TX power
+*              steps, the weak link state and its hysteresis, and the reset on a new sync.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_link.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define RSSI_UNAVAILABLE                (127)
+#define DATA_INCOMPLETE                 (0x01)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint16_t     evt;
+static int8_t       cb_power[PAWR_LINK_MAX_SUBEVENTS];
+static uint32_t     num_power_cb;
+static wiced_bool_t cb_weak;
+static uint32_t     num_weak_cb;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void on_tx_power(uint8_t subevent, int8_t tx_power)
+{
+    TEST_CHECK(subevent < PAWR_LINK_MAX_SUBEVENTS);
+    cb_power[subevent] = tx_power;
+    num_power_cb++;
+}
+
+static void on_weak(uint8_t subevent, wiced_bool_t weak, const pawr_link_info_t *p_info)
+{
+    TEST_CHECK((subevent == 0) && (p_info->weak == weak));
+    cb_weak = weak;
+    num_weak_cb++;
+}
+
+/* n events on subevent 0, one in every period received */
+static void reports(uint32_t n, int8_t rssi, uint16_t period)
+{
+    while (n-- != 0)
+    {
+        evt = (uint16_t)(evt + period);
+        pawr_link_on_report(0, evt, rssi, 0);
+    }
+}
+
+static void test_power(void)
+{
+    pawr_link_info_t info;
+    uint8_t          i;
+
+    pawr_link_init();
+    pawr_link_reg_tx_power_cb(on_tx_power);
+    pawr_link_reg_weak_cb(on_weak);
+    TEST_CHECK(!pawr_link_get_info(0, &info) && !pawr_link_get_info(PAWR_LINK_MAX_SUBEVENTS, &info));
+
+    /* no change before PAWR_LINK_MIN_SAMPLES */
+    reports(PAWR_LINK_MIN_SAMPLES, -40, 1);
+    TEST_CHECK(pawr_link_get_info(0, &info));
+    TEST_CHECK((info.tx_power == PAWR_LINK_TX_POWER_DEFAULT) && (info.rssi == -40) && (info.loss_pct == 0));
+    TEST_CHECK(num_power_cb == 0);
+
+    /* a strong link steps down to the minimum, one step a report */
+    reports(1, -40, 1);
+    TEST_CHECK((num_power_cb == 1) && (cb_power[0] == PAWR_LINK_TX_POWER_DEFAULT - PAWR_LINK_TX_POWER_STEP));
+    reports(50, -40, 1);
+    pawr_link_get_info(0, &info);
+    TEST_CHECK((info.tx_power == PAWR_LINK_TX_POWER_MIN) && (cb_power[0] == PAWR_LINK_TX_POWER_MIN));
+    TEST_CHECK(info.tx_changes == (PAWR_LINK_TX_POWER_DEFAULT - PAWR_LINK_TX_POWER_MIN) / PAWR_LINK_TX_POWER_STEP);
+
+    /* within the RSSI window nothing moves; an unavailable RSSI leaves the average alone */
+    reports(100, -65, 1);
+    pawr_link_get_info(0, &info);
+    i = (uint8_t)info.tx_changes;
+    reports(100, -65, 1);
+    reports(20, RSSI_UNAVAILABLE, 1);
+    pawr_link_get_info(0, &info);
+    TEST_CHECK((info.tx_changes == i) && (info.rssi >= -66) && (info.rssi <= -64));
+
+    /* the subevents are estimated apart */
+    TEST_CHECK(!pawr_link_get_info(1, &info));
+    pawr_link_on_report(PAWR_LINK_MAX_SUBEVENTS, evt, -90, 0);
+    TEST_CHECK(!pawr_link_is_weak(PAWR_LINK_MAX_SUBEVENTS));
+}
+
+static void test_loss(void)
+{
+    pawr_link_info_t info;
+    uint32_t         missed;
+    uint32_t         n;
+
+    /* one event in three missed at a fair RSSI: loss about 33%, power goes up */
+    pawr_link_get_info(0, &info);
+    missed = info.missed;
+    for (n = 0; n < 60; n++)
+    {
+        reports(1, -65, 1);
+        reports(1, -65, 2);
+    }
+    pawr_link_get_info(0, &info);
+    TEST_CHECK((info.loss_pct > 25) && (info.loss_pct < 42));
+    TEST_CHECK((info.missed - missed == 60) && (info.tx_power == PAWR_LINK_TX_POWER_MAX));
+
+    /* incomplete reports count as lost */
+    for (n = 0; n < 40; n++)
+    {
+        evt++;
+        pawr_link_on_report(0, evt, -65, DATA_INCOMPLETE);
+    }
+    pawr_link_get_info(0, &info);
+    TEST_CHECK(info.loss_pct > 90);
+
+    /* a long gap is folded in up to PAWR_LINK_MAX_GAP_SAMPLES, and all of it counted */
+    reports(200, -65, 1);
+    pawr_link_get_info(0, &info);
+    missed = info.missed;
+    TEST_CHECK(info.loss_pct == 0);
+    reports(1, -65, 1000);
+    pawr_link_get_info(0, &info);
+    TEST_CHECK((info.missed - missed == 999) && (info.loss_pct > 80));
+
+    /* events the sync skips on purpose are not lost, those beyond the skip are */
+    pawr_link_set_skip(15);
+    pawr_link_get_info(0, &info);
+    missed = info.missed;
+    reports(100, -65, 16);
+    pawr_link_get_info(0, &info);
+    TEST_CHECK((info.missed == missed) && (info.loss_pct == 0));
+    reports(1, -65, 48);
+    pawr_link_get_info(0, &info);
+    TEST_CHECK(info.missed - missed == 2);
+    pawr_link_set_skip(0);
+
+    /* a counter going backwards, a new train before the reset, is no loss */
+    reports(200, -65, 1);
+    pawr_link_get_info(0, &info);
+    missed = info.missed;
+    evt -= 100;
+    reports(1, -65, 1);
+    pawr_link_get_info(0, &info);
+    TEST_CHECK(info.missed == missed);
+}
+
+static void test_weak(void)
+{
+    pawr_link_info_t info;
+
+    /* at full power and still poor: weak, once */
+    num_weak_cb = 0;
+    reports(100, -92, 1);
+    TEST_CHECK(pawr_link_is_weak(0) && cb_weak && (num_weak_cb == 1));
+
+    /* hysteresis: just above the threshold is not enough to leave */
+    reports(100, PAWR_LINK_WEAK_RSSI + 2, 1);
+    TEST_CHECK(pawr_link_is_weak(0) && (num_weak_cb == 1));
+    reports(100, PAWR_LINK_WEAK_RSSI + PAWR_LINK_HYSTERESIS_DB + 5, 1);
+    TEST_CHECK(!pawr_link_is_weak(0) && !cb_weak && (num_weak_cb == 2));
+
+    /* a new sync starts the estimate over, keeping power and statistics */
+    pawr_link_get_info(0, &info);
+    pawr_link_reset();
+    TEST_CHECK(!pawr_link_get_info(0, &info));
+    reports(1, -40, 1);
+    pawr_link_get_info(0, &info);
+    TEST_CHECK((info.rssi == -40) && (info.loss_pct == 0) && (info.tx_power == PAWR_LINK_TX_POWER_MAX) && (info.reports > 1));
+    pawr_link_print_stats();
+}
+
+int main(void)
+{
+    test_power();
+    test_loss();
+    test_weak();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,507 @@
+/******************************************************************************
+* File Name:   test_pawr_ota.c
+*
+* Description: This file tests the PAwR firmware update against a flash backend over a file, installed
+*              with pawr_ota_set_flash(): chunks in and out of order, the status of the missing chunks, a
+*              resumed and a replaced session, and the CRC and flash failures.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <setjmp.h>
+#include "host_test.h"
+#include "pawr_ota.h"
+#include "pawr_flash.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define IMAGE_LEN                       (20 * 1024 + 77)   /* the last chunk is short */
+#define NUM_CHUNKS                      ((IMAGE_LEN + PAWR_OTA_CHUNK_SIZE - 1) / PAWR_OTA_CHUNK_SIZE)
+#define SE                              (PAWR_CFG_OTA_SUBEVENT)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* flash backend over a file holding the OTA slot: erase before program, as NOR flash */
+static FILE         *flash_file;
+static uint32_t     flash_sector = 4096;
+static uint32_t     flash_erases;
+static wiced_bool_t flash_fail_write;
+
+/* last status response */
+static uint8_t      status[PAWR_OTA_STATUS_HDR_LEN + PAWR_OTA_STATUS_BITMAP_LEN];
+static uint8_t      status_len;
+static uint32_t     num_status;
+
+static uint32_t     ready_addr;
+static uint32_t     ready_size;
+static uint32_t     num_ready;
+
+static uint8_t      image[IMAGE_LEN];
+static uint32_t     image_crc;
+static uint16_t     evt;
+static jmp_buf      task_idle;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* the serial flash is the default backend; the tests install the file one */
+wiced_bool_t pawr_flash_init(void)
+{
+    return WICED_FALSE;
+}
+
+uint32_t pawr_flash_erase_size(uint32_t addr)
+{
+    return 0;
+}
+
+wiced_bool_t pawr_flash_erase(uint32_t addr, uint32_t len)
+{
+    return WICED_FALSE;
+}
+
+wiced_bool_t pawr_flash_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    return WICED_FALSE;
+}
+
+wiced_bool_t pawr_flash_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    return WICED_FALSE;
+}
+
+static wiced_bool_t file_init(void)
+{
+    static uint8_t blank[4096];
+    uint32_t       off;
+
+    flash_file = tmpfile();
+    TEST_CHECK(flash_file != NULL);
+    memset(blank, 0xA5, sizeof(blank));         /* not erased: the module must erase first */
+    for (off = 0; off < PAWR_CFG_OTA_SLOT_SIZE; off += sizeof(blank))
+    {
+        TEST_CHECK(fwrite(blank, 1, sizeof(blank), flash_file) == sizeof(blank));
+    }
+    return WICED_TRUE;
+}
+
+static uint32_t file_erase_size(uint32_t addr)
+{
+    return flash_sector;
+}
+
+static wiced_bool_t file_erase(uint32_t addr, uint32_t len)
+{
+    static uint8_t ff[4096];
+    uint32_t       i;
+
+    addr -= PAWR_CFG_OTA_SLOT_ADDR;
+    TEST_CHECK(((addr % flash_sector) == 0) && ((len % flash_sector) == 0) && (addr + len <= PAWR_CFG_OTA_SLOT_SIZE));
+    memset(ff, 0xFF, sizeof(ff));
+    TEST_CHECK(fseek(flash_file, (long)addr, SEEK_SET) == 0);
+    for (i = 0; i < len; i += sizeof(ff))
+    {
+        TEST_CHECK(fwrite(ff, 1, sizeof(ff), flash_file) == sizeof(ff));
+    }
+    flash_erases++;
+    return WICED_TRUE;
+}
+
+static wiced_bool_t file_read(uint32_t addr, uint32_t len, uint8_t *p_data)
+{
+    addr -= PAWR_CFG_OTA_SLOT_ADDR;
+    TEST_CHECK(addr + len <= PAWR_CFG_OTA_SLOT_SIZE);
+    TEST_CHECK(fseek(flash_file, (long)addr, SEEK_SET) == 0);
+    return (fread(p_data, 1, len, flash_file) == len) ? WICED_TRUE : WICED_FALSE;
+}
+
+static wiced_bool_t file_write(uint32_t addr, uint32_t len, const uint8_t *p_data)
+{
+    uint8_t  old[PAWR_OTA_PAGE_SIZE];
+    uint32_t i;
+
+    TEST_CHECK((len <= PAWR_OTA_PAGE_SIZE) && ((addr % PAWR_OTA_PAGE_SIZE) + len <= PAWR_OTA_PAGE_SIZE));
+    if (flash_fail_write)
+    {
+        return WICED_FALSE;
+    }
+    TEST_CHECK(file_read(addr, len, old));
+    for (i = 0; i < len; i++)
+    {
+        TEST_CHECK(old[i] == 0xFF);
+    }
+    TEST_CHECK(fseek(flash_file, (long)(addr - PAWR_CFG_OTA_SLOT_ADDR), SEEK_SET) == 0);
+    return (fwrite(p_data, 1, len, flash_file) == len) ? WICED_TRUE : WICED_FALSE;
+}
+
+static const pawr_ota_flash_t file_flash =
+{
+    .init       = file_init,
+    .erase_size = file_erase_size,
+    .erase      = file_erase,
+    .write      = file_write,
+    .read       = file_read,
+};
+
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    TEST_CHECK((prio == PAWR_RSP_PRIO_CONTROL) && (subevent == SE) && (data_len <= sizeof(status)));
+    TEST_CHECK((data_len >= PAWR_OTA_STATUS_HDR_LEN) && (p_data[0] == PAWR_MSG_TYPE_OTA));
+    memcpy(status, p_data, data_len);
+    status_len = data_len;
+    num_status++;
+    return WICED_BT_SUCCESS;
+}
+
+static void on_ready(uint32_t slot_addr, uint32_t image_size)
+{
+    ready_addr = slot_addr;
+    ready_size = image_size;
+    num_ready++;
+}
+
+/* the flash task calls it only when its queue is empty */
+void vTaskDelay(TickType_t ticks)
+{
+    longjmp(task_idle, 1);
+}
+
+/* runs the flash task until it waits */
+static void pump(void)
+{
+    if (setjmp(task_idle) == 0)
+    {
+        host_task_fn[host_num_tasks - 1](NULL);
+    }
+}
+
+static uint32_t crc32(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint8_t  b;
+
+    while (len--)
+    {
+        crc ^= *p_data++;
+        for (b = 0; b < 8; b++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320UL : 0);
+        }
+    }
+    return ~crc;
+}
+
+static void msg(const uint8_t *p_msg, uint16_t len)
+{
+    pawr_ota_on_msg(SE, evt++, p_msg, len);
+    host_now_ms += 100;
+    pump();
+}
+
+static void begin(uint8_t session, uint32_t size, uint32_t crc)
+{
+    uint8_t m[PAWR_OTA_BEGIN_LEN] =
+    {
+        PAWR_MSG_TYPE_OTA, PAWR_OTA_OP_BEGIN, session,
+        (uint8_t)size, (uint8_t)(size >> 8), (uint8_t)(size >> 16), (uint8_t)(size >> 24),
+        (uint8_t)crc, (uint8_t)(crc >> 8), (uint8_t)(crc >> 16), (uint8_t)(crc >> 24),
+        PAWR_OTA_CHUNK_SIZE,
+    };
+
+    msg(m, sizeof(m));
+}
+
+static void chunk(uint8_t session, uint32_t idx)
+{
+    uint8_t  m[PAWR_OTA_CHUNK_HDR_LEN + PAWR_OTA_CHUNK_SIZE];
+    uint32_t len = IMAGE_LEN - idx * PAWR_OTA_CHUNK_SIZE;
+
+    len = (len > PAWR_OTA_CHUNK_SIZE) ? PAWR_OTA_CHUNK_SIZE : len;
+    m[0] = PAWR_MSG_TYPE_OTA;
+    m[1] = PAWR_OTA_OP_CHUNK;
+    m[2] = session;
+    m[3] = (uint8_t)idx;
+    m[4] = (uint8_t)(idx >> 8);
+    memcpy(&m[PAWR_OTA_CHUNK_HDR_LEN], &image[idx * PAWR_OTA_CHUNK_SIZE], len);
+    msg(m, (uint16_t)(PAWR_OTA_CHUNK_HDR_LEN + len));
+}
+
+static void op(uint8_t session, uint8_t code)
+{
+    uint8_t m[] = {PAWR_MSG_TYPE_OTA, code, session};
+
+    num_status = 0;
+    msg(m, sizeof(m));
+    TEST_CHECK((num_status == 1) && (status[1] == session));
+}
+
+static uint32_t status_missing(void)
+{
+    return (uint32_t)status[3] | ((uint32_t)status[4] << 8);
+}
+
+static uint32_t status_base(void)
+{
+    return (uint32_t)status[5] | ((uint32_t)status[6] << 8);
+}
+
+static wiced_bool_t status_has(uint32_t idx)
+{
+    uint32_t bit = idx - status_base();
+
+    return ((idx >= status_base()) && (bit < (uint32_t)(status_len - PAWR_OTA_STATUS_HDR_LEN) * 8) &&
+            (status[PAWR_OTA_STATUS_HDR_LEN + bit / 8] & (1U << (bit % 8)))) ? WICED_TRUE : WICED_FALSE;
+}
+
+/* the slot holds the image, read back from the file */
+static wiced_bool_t slot_matches(void)
+{
+    static uint8_t back[IMAGE_LEN];
+
+    return file_read(PAWR_CFG_OTA_SLOT_ADDR, IMAGE_LEN, back) && (memcmp(back, image, IMAGE_LEN) == 0);
+}
+
+static void apply_ready(uint8_t session)
+{
+    num_ready = 0;
+    /* the QUERY writes a page still gathering; the CRC check follows in the flash task */
+    op(session, PAWR_OTA_OP_QUERY);
+    TEST_CHECK((status[2] == PAWR_OTA_STATE_VERIFYING) || (status[2] == PAWR_OTA_STATE_READY));
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_READY);
+    op(session, PAWR_OTA_OP_APPLY);
+    TEST_CHECK((status[2] == PAWR_OTA_STATE_READY) && (num_ready == 1) && (ready_addr == PAWR_CFG_OTA_SLOT_ADDR) && (ready_size == IMAGE_LEN));
+}
+
+static void test_in_order(void)
+{
+    pawr_ota_stats_t s;
+    uint32_t         i;
+
+    begin(1, IMAGE_LEN, image_crc);
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_RECEIVING);
+    op(1, PAWR_OTA_OP_QUERY);
+    TEST_CHECK((status_missing() == NUM_CHUNKS) && (status_base() == 0) && status_has(0) && status_has(NUM_CHUNKS - 1));
+    for (i = 0; i < NUM_CHUNKS; i++)
+    {
+        chunk(1, i);
+    }
+    apply_ready(1);
+    TEST_CHECK(slot_matches());
+
+    pawr_ota_get_stats(&s);
+    TEST_CHECK((s.chunks_rcvd == NUM_CHUNKS) && (s.chunks_dup == 0) && (s.chunks_dropped == 0));
+    TEST_CHECK((s.pages_written == (IMAGE_LEN + PAWR_OTA_PAGE_SIZE - 1) / PAWR_OTA_PAGE_SIZE) && (s.flash_errors == 0));
+    TEST_CHECK(s.sectors_erased == (IMAGE_LEN + flash_sector - 1) / flash_sector);
+    TEST_CHECK(s.intervals == NUM_CHUNKS + 1);  /* from the BEGIN, a QUERY came in between */
+}
+
+/* chunks in any order and repeated: each page is written once, from whatever chunks it holds */
+static void test_any_order(void)
+{
+    pawr_ota_stats_t s;
+    uint32_t         i;
+
+    begin(2, IMAGE_LEN, image_crc);
+    for (i = 0; i < NUM_CHUNKS; i++)
+    {
+        chunk(2, (i * 37) % NUM_CHUNKS);         /* 37 is prime to NUM_CHUNKS, every chunk once */
+    }
+    for (i = 0; i < NUM_CHUNKS; i += 5)
+    {
+        chunk(2, NUM_CHUNKS - 1 - i);
+    }
+    apply_ready(2);
+    TEST_CHECK(slot_matches());
+    pawr_ota_get_stats(&s);
+    TEST_CHECK((s.chunks_rcvd == NUM_CHUNKS) && (s.chunks_dup == (NUM_CHUNKS + 4) / 5) && (s.flash_errors == 0));
+}
+
+/* the status names the missing chunks from the first gap on; only those are sent again */
+static void test_gaps(void)
+{
+    uint32_t i;
+
+    begin(3, IMAGE_LEN, image_crc);
+    for (i = 0; i < NUM_CHUNKS; i++)
+    {
+        if ((i != 3) && (i != 4) && (i != 100) && (i != NUM_CHUNKS - 1))
+        {
+            chunk(3, i);
+        }
+    }
+    op(3, PAWR_OTA_OP_QUERY);
+    TEST_CHECK((status[2] == PAWR_OTA_STATE_RECEIVING) && (status_missing() == 4) && (status_base() == 3));
+    for (i = 3; i < NUM_CHUNKS; i++)
+    {
+        TEST_CHECK(status_has(i) == ((i == 3) || (i == 4) || (i == 100) || (i == NUM_CHUNKS - 1)));
+    }
+    /* the bitmap stops at the image end */
+    TEST_CHECK(status_len == PAWR_OTA_STATUS_HDR_LEN + (NUM_CHUNKS - 3 + 7) / 8);
+
+    chunk(3, 100);
+    chunk(3, 4);
+    op(3, PAWR_OTA_OP_QUERY);
+    TEST_CHECK((status_missing() == 2) && (status_base() == 3) && status_has(3) && !status_has(4));
+    chunk(3, NUM_CHUNKS - 1);
+    chunk(3, 3);
+    apply_ready(3);
+    TEST_CHECK(slot_matches());
+}
+
+/* a repeated BEGIN of the running session keeps what was received; a new session starts over */
+static void test_resume(void)
+{
+    pawr_ota_stats_t s;
+    uint32_t         i;
+
+    begin(4, IMAGE_LEN, image_crc);
+    for (i = 0; i < NUM_CHUNKS / 2; i++)
+    {
+        chunk(4, i);
+    }
+    begin(4, IMAGE_LEN, image_crc);             /* the client restarted and repeats its BEGIN */
+    op(4, PAWR_OTA_OP_QUERY);
+    TEST_CHECK((status_missing() == NUM_CHUNKS - NUM_CHUNKS / 2) && (status_base() == NUM_CHUNKS / 2));
+    for (; i < NUM_CHUNKS; i++)
+    {
+        chunk(4, i);
+    }
+    apply_ready(4);
+    pawr_ota_get_stats(&s);
+    TEST_CHECK(s.sectors_erased == (IMAGE_LEN + flash_sector - 1) / flash_sector);
+
+    /* chunks of the old session are ignored once a new one began */
+    begin(5, IMAGE_LEN, image_crc);
+    chunk(4, 0);
+    op(5, PAWR_OTA_OP_QUERY);
+    TEST_CHECK((status_missing() == NUM_CHUNKS) && (status_base() == 0));
+    for (i = 0; i < NUM_CHUNKS; i++)
+    {
+        chunk(5, i);
+    }
+    apply_ready(5);
+    TEST_CHECK(slot_matches());
+}
+
+/* a wrong CRC, a failed write and a bad BEGIN end in the error state; APPLY does nothing */
+static void test_failures(void)
+{
+    uint32_t i;
+
+    begin(6, IMAGE_LEN, image_crc ^ 1);
+    for (i = 0; i < NUM_CHUNKS; i++)
+    {
+        chunk(6, i);
+    }
+    num_ready = 0;
+    op(6, PAWR_OTA_OP_QUERY);
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_ERROR);
+    op(6, PAWR_OTA_OP_APPLY);
+    TEST_CHECK((status[2] == PAWR_OTA_STATE_ERROR) && (num_ready == 0));
+
+    begin(7, IMAGE_LEN, image_crc);
+    chunk(7, 0);
+    flash_fail_write = WICED_TRUE;
+    chunk(7, 1);
+    flash_fail_write = WICED_FALSE;
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_ERROR);
+    chunk(7, 2);
+    op(7, PAWR_OTA_OP_APPLY);
+    TEST_CHECK((num_ready == 0) && (status_missing() == 0));
+
+    begin(8, PAWR_CFG_OTA_SLOT_SIZE + 1, image_crc);
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_ERROR);
+
+    /* short messages and chunks of the wrong length are dropped */
+    begin(9, IMAGE_LEN, image_crc);
+    msg((const uint8_t[]){PAWR_MSG_TYPE_OTA, PAWR_OTA_OP_BEGIN, 10, 1, 0, 0, 0}, 7);
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_RECEIVING);
+    msg((const uint8_t[]){PAWR_MSG_TYPE_OTA, PAWR_OTA_OP_CHUNK, 9, 0, 0, 0xAA}, 6);
+    msg((const uint8_t[]){PAWR_MSG_TYPE_OTA, PAWR_OTA_OP_CHUNK, 9, 0xFF, 0xFF, 0xAA}, 6);
+    op(9, PAWR_OTA_OP_QUERY);
+    TEST_CHECK(status_missing() == NUM_CHUNKS);
+    pawr_ota_on_msg((uint8_t)(SE + 1), evt++, (const uint8_t[]){PAWR_MSG_TYPE_OTA, PAWR_OTA_OP_BEGIN, 11}, 3);
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_RECEIVING);
+}
+
+/* a 64 KB erase sector covers many pages and is erased once */
+static void test_large_sectors(void)
+{
+    pawr_ota_stats_t s;
+    uint32_t         i;
+
+    flash_sector = 65536;
+    flash_erases = 0;
+    begin(12, IMAGE_LEN, image_crc);
+    for (i = 0; i < NUM_CHUNKS; i++)
+    {
+        chunk(12, i);
+    }
+    apply_ready(12);
+    TEST_CHECK(slot_matches());
+    pawr_ota_get_stats(&s);
+    TEST_CHECK((s.sectors_erased == 1) && (flash_erases == 1));
+    flash_sector = 4096;
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < IMAGE_LEN; i++)
+    {
+        image[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    image_crc = crc32(image, IMAGE_LEN);
+    pawr_ota_init();
+    pawr_ota_set_flash(&file_flash);
+    pawr_ota_reg_ready_cb(on_ready);
+    TEST_CHECK(pawr_ota_get_state() == PAWR_OTA_STATE_IDLE);
+
+    test_in_order();
+    test_any_order();
+    test_gaps();
+    test_resume();
+    test_failures();
+    test_large_sectors();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,269 @@
+/******************************************************************************
+* File Name:   test_pawr_packed.c
+*
+* Description: This file tests the lookup of this device's record in packed messages: every device ID
+*              against random INDEX and BITMAP messages, compared with a linear scan, and malformed
+*              messages.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_packed.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define MSG_MAX                         (255)
+#define NUM_ROUNDS                      (300)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint32_t rng = 7;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint8_t next_byte(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (uint8_t)rng;
+}
+
+/* record of a device: type, its id, then id-dependent filler up to len */
+static void make_record(uint8_t id, uint8_t len, uint8_t *p_rec)
+{
+    uint8_t i;
+
+    p_rec[0] = PAWR_MSG_TYPE_APP;
+    for (i = 1; i < len; i++)
+    {
+        p_rec[i] = (uint8_t)(id + i);
+    }
+}
+
+static wiced_bool_t is_record_of(uint8_t id, const uint8_t *p_rec, uint16_t len)
+{
+    uint8_t exp[MSG_MAX];
+
+    make_record(id, (uint8_t)len, exp);
+    return (memcmp(exp, p_rec, len) == 0) ? WICED_TRUE : WICED_FALSE;
+}
+
+/* INDEX layout for the ids in p_ids, increasing; record i is 2 + i % 5 bytes */
+static uint16_t build_index(const uint8_t *p_ids, uint8_t n, uint8_t *p_msg)
+{
+    uint16_t pos = PAWR_PACKED_INDEX_HDR_LEN + 2 * n;
+    uint16_t off = 0;
+    uint8_t  len;
+    uint8_t  i;
+
+    p_msg[0] = PAWR_MSG_TYPE_PACKED;
+    p_msg[1] = PAWR_PACKED_FMT_INDEX;
+    p_msg[2] = n;
+    for (i = 0; i < n; i++)
+    {
+        len = (uint8_t)(2 + i % 5);
+        make_record(p_ids[i], len, &p_msg[pos + off]);
+        off = (uint16_t)(off + len);
+        p_msg[PAWR_PACKED_INDEX_HDR_LEN + 2 * i]     = p_ids[i];
+        p_msg[PAWR_PACKED_INDEX_HDR_LEN + 2 * i + 1] = (uint8_t)off;
+    }
+    return (uint16_t)(pos + off);
+}
+
+/* BITMAP layout, rec_len bytes per record, devices base_id + k for set bits k */
+static uint16_t build_bitmap(uint8_t base_id, const uint8_t *p_map, uint8_t map_len, uint8_t rec_len, uint8_t *p_msg)
+{
+    uint16_t pos = PAWR_PACKED_BITMAP_HDR_LEN + map_len;
+    uint16_t k;
+
+    p_msg[0] = PAWR_MSG_TYPE_PACKED;
+    p_msg[1] = PAWR_PACKED_FMT_BITMAP;
+    p_msg[2] = rec_len;
+    p_msg[3] = base_id;
+    p_msg[4] = map_len;
+    memcpy(&p_msg[PAWR_PACKED_BITMAP_HDR_LEN], p_map, map_len);
+    for (k = 0; k < map_len * 8; k++)
+    {
+        if (p_map[k / 8] & (1U << (k % 8)))
+        {
+            make_record((uint8_t)(base_id + k), rec_len, &p_msg[pos]);
+            pos = (uint16_t)(pos + rec_len);
+        }
+    }
+    return pos;
+}
+
+static void test_index(void)
+{
+    uint8_t        msg[MSG_MAX + 64];
+    uint8_t        ids[64];
+    uint8_t        present[256];
+    const uint8_t *p_rec;
+    uint16_t       len;
+    uint16_t       got;
+    uint16_t       round;
+    uint16_t       id;
+    uint8_t        n;
+
+    /* every id against random increasing id sets, compared with a linear scan */
+    for (round = 0; round < NUM_ROUNDS; round++)
+    {
+        memset(present, 0, sizeof(present));
+        n = 0;
+        for (id = next_byte() % 4; (id < PAWR_PACKED_ID_NONE) && (n < 40); id = (uint16_t)(id + 1 + next_byte() % 8))
+        {
+            ids[n++]    = (uint8_t)id;
+            present[id] = 1;
+        }
+        len = build_index(ids, n, msg);
+        TEST_CHECK(len <= MSG_MAX);
+        for (id = 0; id < PAWR_PACKED_ID_NONE; id++)
+        {
+            pawr_packed_set_id((uint8_t)id);
+            p_rec = NULL;
+            got   = pawr_packed_find(msg, len, &p_rec);
+            if (!present[id])
+            {
+                TEST_CHECK(got == 0);
+                continue;
+            }
+            TEST_CHECK((got >= 2) && (p_rec != NULL) && (p_rec + got <= msg + len));
+            TEST_CHECK(is_record_of((uint8_t)id, p_rec, got));
+        }
+    }
+}
+
+static void test_bitmap(void)
+{
+    uint8_t        msg[1024];
+    uint8_t        map[32];
+    const uint8_t *p_rec;
+    uint16_t       len;
+    uint16_t       got;
+    uint16_t       round;
+    uint16_t       id;
+    uint16_t       k;
+    uint8_t        base;
+    uint8_t        map_len;
+    uint8_t        rec_len;
+
+    for (round = 0; round < NUM_ROUNDS; round++)
+    {
+        base    = next_byte() % 64;
+        map_len = (uint8_t)(1 + next_byte() % 24);
+        rec_len = (uint8_t)(1 + next_byte() % 4);
+        for (k = 0; k < map_len; k++)
+        {
+            map[k] = next_byte() & next_byte();  /* about a quarter of the devices */
+        }
+        len = build_bitmap(base, map, map_len, rec_len, msg);
+        for (id = 0; id < PAWR_PACKED_ID_NONE; id++)
+        {
+            k = (uint16_t)(id - base);
+            pawr_packed_set_id((uint8_t)id);
+            p_rec = NULL;
+            got   = pawr_packed_find(msg, len, &p_rec);
+            if ((id < base) || (k >= map_len * 8) || !(map[k / 8] & (1U << (k % 8))))
+            {
+                TEST_CHECK(got == 0);
+                continue;
+            }
+            TEST_CHECK((got == rec_len) && (p_rec + got <= msg + len));
+            TEST_CHECK(is_record_of((uint8_t)id, p_rec, got));
+        }
+    }
+}
+
+static void test_malformed(void)
+{
+    pawr_packed_stats_t stats;
+    const uint8_t       ids[] = {3, 5, 9};
+    const uint8_t       map[] = {0x0F};
+    uint8_t             msg[64];
+    const uint8_t      *p_rec;
+    uint16_t            len;
+    uint32_t            bad;
+
+    pawr_packed_get_stats(&stats);
+    bad = stats.malformed;
+
+    /* no id set: nothing found */
+    len = build_index(ids, sizeof(ids), msg);
+    pawr_packed_set_id(PAWR_PACKED_ID_NONE);
+    TEST_CHECK(pawr_packed_find(msg, len, &p_rec) == 0);
+
+    /* index longer than the message; an end past the records; an end before the start */
+    pawr_packed_set_id(5);
+    TEST_CHECK(pawr_packed_find(msg, PAWR_PACKED_INDEX_HDR_LEN + 2 * sizeof(ids) - 1, &p_rec) == 0);
+    TEST_CHECK(pawr_packed_find(msg, len - 1, &p_rec) != 0);   /* the last record is not ours */
+    msg[PAWR_PACKED_INDEX_HDR_LEN + 3] = (uint8_t)(len);
+    TEST_CHECK(pawr_packed_find(msg, len, &p_rec) == 0);
+    msg[PAWR_PACKED_INDEX_HDR_LEN + 3] = msg[PAWR_PACKED_INDEX_HDR_LEN + 1];
+    TEST_CHECK(pawr_packed_find(msg, len, &p_rec) == 0);
+
+    /* unknown layout */
+    len    = build_index(ids, sizeof(ids), msg);
+    msg[1] = 0x7F;
+    TEST_CHECK(pawr_packed_find(msg, len, &p_rec) == 0);
+
+    /* bitmap: zero record length, map past the end, fewer records than set bits */
+    len = build_bitmap(2, map, sizeof(map), 2, msg);
+    TEST_CHECK(pawr_packed_find(msg, len, &p_rec) == 2);
+    msg[2] = 0;
+    TEST_CHECK(pawr_packed_find(msg, len, &p_rec) == 0);
+    msg[2] = 2;
+    TEST_CHECK(pawr_packed_find(msg, PAWR_PACKED_BITMAP_HDR_LEN, &p_rec) == 0);
+    TEST_CHECK(pawr_packed_find(msg, len - 2, &p_rec) == 0);     /* ours is the last of four */
+
+    pawr_packed_get_stats(&stats);
+    TEST_CHECK(stats.malformed - bad == 7);
+}
+
+int main(void)
+{
+    test_index();
+    test_bitmap();
+    test_malformed();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,229 @@
+/******************************************************************************
+* File Name:   test_pawr_prefetch.c
+*
+* Description: This file tests response prefetch: matching staged responses to events, stale and future
+*              entries, the demand check, the reset on a new sync, and a staging task racing the stack
+*              context.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "host_test.h"
+#include "pawr_prefetch.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define RACE_EVENTS                     (20000u)
+#define REQ_NEEDS_CONTENT               (0x5A)   /* first request byte the demand check answers */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint8_t      rsp_data[PAWR_RSP_MAX_DATA_LEN];
+static uint8_t      rsp_len;
+static uint8_t      rsp_subevent;
+static uint32_t     num_rsp;
+static wiced_bool_t rsp_refuse;
+static atomic_uint  race_evt;                    /* event the stack is at, for the staging thread */
+static atomic_uint  race_staged;                 /* event the staging thread staged last */
+static atomic_bool  race_done;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+wiced_bt_dev_status_t pawr_rsp_sched_submit(pawr_rsp_prio_t prio, uint8_t subevent, const uint8_t *p_data, uint8_t data_len)
+{
+    TEST_CHECK(prio == PAWR_RSP_PRIO_TELEMETRY);
+    if (rsp_refuse)
+    {
+        return WICED_BT_NO_RESOURCES;
+    }
+    memcpy(rsp_data, p_data, data_len);
+    rsp_len      = data_len;
+    rsp_subevent = subevent;
+    num_rsp++;
+    return WICED_BT_SUCCESS;
+}
+
+static wiced_bool_t needs_content(uint8_t subevent, const uint8_t *p_msg, uint16_t msg_len)
+{
+    return (msg_len != 0) && (p_msg[0] == REQ_NEEDS_CONTENT);
+}
+
+static void test_stage(void)
+{
+    const uint8_t         rsp[]   = {0x11, 0x22, 0x33};
+    const uint8_t         plain[] = {0x01};
+    const uint8_t         asks[]  = {REQ_NEEDS_CONTENT};
+    uint8_t               big[PAWR_RSP_MAX_DATA_LEN + 1] = {0};
+    pawr_prefetch_stats_t stats;
+    uint16_t              evt;
+
+    pawr_prefetch_init();
+    TEST_CHECK(!pawr_prefetch_stage(PAWR_PREFETCH_MAX_SUBEVENTS, 0, rsp, sizeof(rsp)));
+    TEST_CHECK(!pawr_prefetch_stage(0, 0, big, sizeof(big)) && !pawr_prefetch_stage(0, 0, NULL, 1));
+    TEST_CHECK(!pawr_prefetch_submit(PAWR_PREFETCH_MAX_SUBEVENTS, 0, plain, sizeof(plain)));
+
+    /* nothing staged: the callback answers; the next request is expected one event on */
+    TEST_CHECK(!pawr_prefetch_submit(1, 500, plain, sizeof(plain)));
+    evt = pawr_prefetch_next_evt(1);
+    TEST_CHECK((evt == 501) && (pawr_prefetch_next_evt(0) == 1));
+
+    /* staged for that event: submitted before the callback, once */
+    TEST_CHECK(pawr_prefetch_stage(1, evt, rsp, sizeof(rsp)));
+    TEST_CHECK(pawr_prefetch_submit(1, evt, plain, sizeof(plain)));
+    TEST_CHECK((num_rsp == 1) && (rsp_subevent == 1) && (rsp_len == sizeof(rsp)) && (memcmp(rsp_data, rsp, sizeof(rsp)) == 0));
+    TEST_CHECK(!pawr_prefetch_submit(1, evt, plain, sizeof(plain)) && (num_rsp == 1));
+
+    /* staged for a later event it waits; one for an event gone by is thrown away */
+    TEST_CHECK(pawr_prefetch_stage(1, evt + 3, rsp, sizeof(rsp)));
+    TEST_CHECK(!pawr_prefetch_submit(1, evt + 1, plain, sizeof(plain)));
+    TEST_CHECK(pawr_prefetch_submit(1, evt + 3, plain, sizeof(plain)) && (num_rsp == 2));
+    TEST_CHECK(pawr_prefetch_stage(1, evt + 2, rsp, sizeof(rsp)));
+    TEST_CHECK(!pawr_prefetch_submit(1, evt + 4, plain, sizeof(plain)));
+    TEST_CHECK(!pawr_prefetch_submit(1, evt + 2, plain, sizeof(plain)));
+
+    /* a request that needs its own answer keeps the staged one back; so does a full scheduler */
+    pawr_prefetch_reg_demand_cb(needs_content);
+    TEST_CHECK(pawr_prefetch_stage(0, 7, rsp, sizeof(rsp)));
+    TEST_CHECK(!pawr_prefetch_submit(0, 7, asks, sizeof(asks)));
+    rsp_refuse = WICED_TRUE;
+    TEST_CHECK(!pawr_prefetch_submit(0, 7, plain, sizeof(plain)));
+    rsp_refuse = WICED_FALSE;
+    TEST_CHECK(pawr_prefetch_submit(0, 7, plain, sizeof(plain)) && (num_rsp == 3) && (rsp_subevent == 0));
+    pawr_prefetch_reg_demand_cb(NULL);
+
+    /* an empty response is a response */
+    TEST_CHECK(pawr_prefetch_stage(0, 8, NULL, 0));
+    TEST_CHECK(pawr_prefetch_submit(0, 8, plain, sizeof(plain)) && (rsp_len == 0));
+
+    /* a new train: nothing staged for the old counter may match */
+    TEST_CHECK(pawr_prefetch_stage(0, 9, rsp, sizeof(rsp)));
+    pawr_prefetch_reset();
+    TEST_CHECK(!pawr_prefetch_submit(0, 9, plain, sizeof(plain)));
+
+    pawr_prefetch_get_stats(&stats);
+    TEST_CHECK((stats.staged == 6) && (stats.hit == 4) && (stats.stale == 1) && (stats.demanded == 1));
+    TEST_CHECK((stats.miss == 5) && (stats.busy == 0));
+}
+
+/* Application task: stages the response for the next event once the stack moved on to the
+ * current one, every byte the event counter. */
+static void *race_stager(void *p_arg)
+{
+    uint8_t  data[PAWR_RSP_MAX_DATA_LEN];
+    uint32_t staged = 0;
+    uint32_t evt;
+
+    while (!atomic_load(&race_done))
+    {
+        evt = atomic_load(&race_evt) + 1;
+        if (evt == staged)
+        {
+            continue;
+        }
+        memset(data, (uint8_t)evt, sizeof(data));
+        pawr_prefetch_stage(0, (uint16_t)evt, data, (uint8_t)(1 + evt % PAWR_RSP_MAX_DATA_LEN));
+        staged = evt;
+        atomic_store(&race_staged, evt);
+    }
+    return NULL;
+}
+
+/* Gives the other side the core; the host may have a single one, where spinning starves it. */
+static void race_wait(void)
+{
+    const struct timespec ts = {0, 1000};
+
+    nanosleep(&ts, NULL);
+}
+
+/* Stack context against the staging task: every other report waits for the response to be
+ * staged, the others race the write. Whatever goes out is one whole response. */
+static void test_race(void)
+{
+    const uint8_t         plain[] = {0x01};
+    pthread_t             stager;
+    pawr_prefetch_stats_t stats;
+    wiced_bool_t          hit;
+    uint32_t              n;
+    uint8_t               i;
+
+    pawr_prefetch_init();
+    num_rsp = 0;
+    atomic_init(&race_evt, 0);
+    atomic_init(&race_staged, 0);
+    atomic_init(&race_done, WICED_FALSE);
+    TEST_CHECK(pthread_create(&stager, NULL, race_stager, NULL) == 0);
+    for (n = 1; n <= RACE_EVENTS; n++)
+    {
+        while (((n % 2) == 0) && (atomic_load(&race_staged) != n))
+        {
+            race_wait();
+        }
+        rsp_len = 0;
+        hit = pawr_prefetch_submit(0, (uint16_t)n, plain, sizeof(plain));
+        atomic_store(&race_evt, n);
+        TEST_CHECK(hit || ((n % 2) != 0));
+        if (!hit)
+        {
+            continue;
+        }
+        TEST_CHECK(rsp_len == 1 + (uint16_t)n % PAWR_RSP_MAX_DATA_LEN);
+        for (i = 0; i < rsp_len; i++)
+        {
+            TEST_CHECK(rsp_data[i] == (uint8_t)n);
+        }
+    }
+    atomic_store(&race_done, WICED_TRUE);
+    pthread_join(stager, NULL);
+    pawr_prefetch_get_stats(&stats);
+    TEST_CHECK((stats.hit == num_rsp) && (num_rsp >= RACE_EVENTS / 2));
+    pawr_prefetch_print_stats();
+}
+
+int main(void)
+{
+    test_stage();
+    test_race();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,241 @@
+/******************************************************************************
+* File Name:   test_pawr_rel.c
+*
+* Description: This file tests the duplicate suppression and the acknowledgements of reliable messages
+*              through the PAwR layer, from the periodic advertising reports to the response data.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_msg.h"
+#include "pawr_rsp_sched.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SYNC_HANDLE                     (0x0040)
+#define RSP_SLOT                        (2)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static wiced_ble_ext_adv_cback_t *ext_adv_cback;
+static uint8_t                    rsp[PAWR_FLOW_HDR_LEN + PAWR_ACK_HDR_LEN + PAWR_RSP_MAX_DATA_LEN];
+static uint8_t                    rsp_len;
+static uint8_t                    rsp_subevent;
+static uint8_t                    rsp_slot;
+static uint8_t                    num_rsp;
+static uint8_t                    num_delivered;
+static uint8_t                    app_reply;     /* byte the app answers with, 0 for none */
+static uint16_t                   evt = 100;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+void wiced_ble_ext_adv_register_cback(wiced_ble_ext_adv_cback_t *p_cback)
+{
+    ext_adv_cback = p_cback;
+}
+
+wiced_bt_dev_status_t wiced_ble_padv_set_subevent_rsp_data(uint16_t sync_handle, wiced_ble_padv_subevent_rsp_data_t *p_rsp)
+{
+    TEST_CHECK(sync_handle == SYNC_HANDLE);
+    TEST_CHECK(p_rsp->rsp_data_len <= sizeof(rsp));
+    memcpy(rsp, p_rsp->p_data, p_rsp->rsp_data_len);
+    rsp_len      = p_rsp->rsp_data_len;
+    rsp_subevent = p_rsp->rsp_subevent;
+    rsp_slot     = p_rsp->rsp_slot;
+    num_rsp++;
+    return WICED_BT_SUCCESS;
+}
+
+static void app_rcv(uint16_t sync_handle, uint8_t *p_msg, uint16_t msg_len, uint8_t subevent_num, uint16_t evt_counter)
+{
+    TEST_CHECK((msg_len == 2) && (p_msg[0] == PAWR_MSG_TYPE_APP));
+    num_delivered++;
+    if (app_reply != 0)
+    {
+        TEST_CHECK(pawr_rsp_sched_submit(PAWR_RSP_PRIO_TELEMETRY, subevent_num, &app_reply, 1) == WICED_BT_SUCCESS);
+    }
+}
+
+static void sync_up(void)
+{
+    wiced_ble_ext_adv_event_data_t ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.sync_establish.status            = WICED_BT_SUCCESS;
+    ev.sync_establish.sync_handle       = SYNC_HANDLE;
+    ev.sync_establish.periodic_adv_int  = 80;
+    ev.sync_establish.num_subevents     = PAWR_CFG_NUM_SUBEVENTS;
+    ev.sync_establish.subevent_interval = 20;
+    ext_adv_cback(WICED_BLE_PERIODIC_ADV_SYNC_ESTABLISHED_EVENT, &ev);
+}
+
+/* one report in the next periodic event; returns whether the app saw the message */
+static wiced_bool_t report(uint8_t subevent, const uint8_t *p_msg, uint8_t len)
+{
+    wiced_ble_ext_adv_event_data_t ev;
+    uint8_t                        msg[8];
+    uint8_t                        delivered = num_delivered;
+
+    memcpy(msg, p_msg, len);
+    memset(&ev, 0, sizeof(ev));
+    ev.periodic_adv_report.sync_handle          = SYNC_HANDLE;
+    ev.periodic_adv_report.data_length          = len;
+    ev.periodic_adv_report.p_data               = msg;
+    ev.periodic_adv_report.periodic_evt_counter = evt++;
+    ev.periodic_adv_report.sub_event            = subevent;
+    num_rsp = 0;
+    rsp_len = 0;
+    ext_adv_cback(WICED_BLE_PERIODIC_ADV_REPORT_EVENT, &ev);
+    return (num_delivered != delivered) ? WICED_TRUE : WICED_FALSE;
+}
+
+static wiced_bool_t reliable(uint8_t subevent, uint8_t msg_id)
+{
+    const uint8_t msg[] = {PAWR_MSG_TYPE_RELIABLE, msg_id, PAWR_MSG_TYPE_APP, 0x5A};
+
+    return report(subevent, msg, sizeof(msg));
+}
+
+static wiced_bool_t ack_sent(uint8_t last_id, uint8_t window)
+{
+    return (num_rsp == 1) && (rsp_len >= PAWR_ACK_HDR_LEN) && (rsp[0] == PAWR_MSG_TYPE_ACK) &&
+           (rsp[1] == last_id) && (rsp[2] == window);
+}
+
+static void test_duplicates_and_acks(void)
+{
+    /* a new message is acknowledged in front of the app's own response */
+    app_reply = 'R';
+    TEST_CHECK(reliable(0, 5));
+    TEST_CHECK(ack_sent(5, 0) && (rsp_len == PAWR_ACK_HDR_LEN + 1) && (rsp[PAWR_ACK_HDR_LEN] == 'R'));
+    TEST_CHECK((rsp_subevent == 0) && (rsp_slot == RSP_SLOT));
+    app_reply = 0;
+
+    /* a retransmission is not delivered again but acknowledged again, alone */
+    TEST_CHECK(!reliable(0, 5));
+    TEST_CHECK(ack_sent(5, 0) && (rsp_len == PAWR_ACK_HDR_LEN));
+
+    /* the window reports the ids seen behind the newest one: 7 with 5, then with 6 and 5 */
+    TEST_CHECK(reliable(0, 7));
+    TEST_CHECK(ack_sent(7, 0x02));
+    TEST_CHECK(reliable(0, 6));
+    TEST_CHECK(ack_sent(7, 0x03));
+    TEST_CHECK(!reliable(0, 6));
+    TEST_CHECK(!reliable(0, 5));
+
+    /* ids that fell out of the window are refused */
+    TEST_CHECK(!reliable(0, (uint8_t)(7 - 32)));
+    TEST_CHECK(ack_sent(7, 0x03));
+
+    /* msg_id wraps modulo 256 */
+    TEST_CHECK(reliable(0, 120));
+    TEST_CHECK(reliable(0, 240));
+    TEST_CHECK(reliable(0, 3));
+    TEST_CHECK(ack_sent(3, 0));                  /* 240 is 19 ids back, past the 8 the ack reports */
+    TEST_CHECK(!reliable(0, 240));
+
+    /* a reliable message inside a reliable message is dropped without an ack */
+    {
+        const uint8_t nested[] = {PAWR_MSG_TYPE_RELIABLE, 9, PAWR_MSG_TYPE_RELIABLE, 10, PAWR_MSG_TYPE_APP, 0};
+
+        TEST_CHECK(!report(0, nested, sizeof(nested)));
+    }
+}
+
+static void test_stale_window(void)
+{
+    const uint8_t app[] = {PAWR_MSG_TYPE_APP, 0};
+
+    TEST_CHECK(reliable(0, 40));
+    TEST_CHECK(!reliable(0, 40));
+
+    /* after a long silence the same id is a new message of a restarted central */
+    evt += 300;
+    TEST_CHECK(reliable(0, 40));
+    TEST_CHECK(ack_sent(40, 0));
+    TEST_CHECK(report(0, app, sizeof(app)));
+    TEST_CHECK(num_rsp == 0);
+}
+
+static void test_ack_without_slot(void)
+{
+    const uint8_t app[] = {PAWR_MSG_TYPE_APP, 0};
+
+    /* no slot in subevent 1: delivered, the ack waits rather than queueing for nowhere */
+    TEST_CHECK(reliable(1, 20));
+    TEST_CHECK(num_rsp == 0);
+    TEST_CHECK(pawr_rsp_sched_pending(&(uint16_t){0}) == 0);
+
+    /* once a slot is held there the next report carries the ack out */
+    TEST_CHECK(pawr_rsp_sched_set_slots(1, RSP_SLOT + 1, 1));
+    TEST_CHECK(report(1, app, sizeof(app)));
+    TEST_CHECK(ack_sent(20, 0) && (rsp_subevent == 1) && (rsp_slot == RSP_SLOT + 1));
+    TEST_CHECK(report(1, app, sizeof(app)));
+    TEST_CHECK(num_rsp == 0);
+}
+
+static void test_resync_forgets(void)
+{
+    TEST_CHECK(reliable(0, 60));
+    TEST_CHECK(!reliable(0, 60));
+    sync_up();
+    TEST_CHECK(pawr_rsp_sched_set_slots(0, RSP_SLOT, 1));
+    TEST_CHECK(reliable(0, 60));
+}
+
+int main(void)
+{
+    app_bt_dispatch_init();
+    pawr_reg_se_rsp_cb(app_rcv);
+    pawr_init();
+    TEST_CHECK(ext_adv_cback != NULL);
+    sync_up();
+    TEST_CHECK(pawr_rsp_sched_set_slots(0, RSP_SLOT, 1));
+
+    test_duplicates_and_acks();
+    test_stale_window();
+    test_ack_without_slot();
+    test_resync_forgets();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,343 @@
+/******************************************************************************
+* File Name:   test_pawr_roam.c
+*
+* Description: This file tests roaming between known centrals: the periodic advertiser list, surveys of a
+*              poor serving link, candidate ranking with hysteresis, handover and its timeout, and outage
+*              timing.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_roam.h"
+#include "pawr_cmd.h"
+#include "pawr_link.h"
+#include "app_bt_dispatch.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SID                             (3)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+/* serving link stand-in */
+static wiced_bool_t link_valid;
+static int8_t       link_rssi;
+static uint8_t      link_loss;
+
+/* calls into pawr.c and the command queue */
+static wiced_bool_t scan_on;
+static uint32_t     num_resync;
+static uint32_t     resync_ms;
+static uint32_t     num_scan_network;
+static uint32_t     num_list_clear;
+static uint32_t     num_list_add;
+static uint8_t      list_addr[PAWR_ROAM_MAX_CENTRALS][BD_ADDR_LEN];
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+wiced_bool_t pawr_link_get_info(uint8_t subevent, pawr_link_info_t *p_info)
+{
+    if (!link_valid || (subevent != 0))
+    {
+        return WICED_FALSE;
+    }
+    memset(p_info, 0, sizeof(*p_info));
+    p_info->rssi     = link_rssi;
+    p_info->loss_pct = link_loss;
+    p_info->reports  = PAWR_LINK_MIN_SAMPLES;
+    return WICED_TRUE;
+}
+
+void pawr_scan_enable(wiced_bool_t enable)
+{
+    scan_on = enable;
+}
+
+void pawr_resync(void)
+{
+    num_resync++;
+    resync_ms = host_now_ms;
+    pawr_roam_on_sync_lost();
+}
+
+void pawr_scan_for_pawr_network(void)
+{
+    num_scan_network++;
+}
+
+wiced_bool_t pawr_cmd_submit(const pawr_cmd_t *p_cmd)
+{
+    TEST_CHECK((p_cmd->opcode == PAWR_CMD_OP_LIST_CLEAR) || (p_cmd->opcode == PAWR_CMD_OP_LIST_ADD));
+    TEST_CHECK(p_cmd->issue() == WICED_BT_SUCCESS);
+    return WICED_TRUE;
+}
+
+wiced_bt_dev_status_t wiced_ble_padv_clear_list(void)
+{
+    num_list_clear++;
+    num_list_add = 0;
+    return WICED_BT_SUCCESS;
+}
+
+wiced_bt_dev_status_t wiced_ble_padv_add_device_to_list(wiced_bt_ble_address_type_t type, wiced_bt_device_address_t addr, uint8_t sid)
+{
+    TEST_CHECK((num_list_add < PAWR_ROAM_MAX_CENTRALS) && (sid == SID));
+    memcpy(list_addr[num_list_add++], addr, BD_ADDR_LEN);
+    return WICED_BT_SUCCESS;
+}
+
+static void central_addr(uint8_t central, uint8_t *addr)
+{
+    memset(addr, 0, BD_ADDR_LEN);
+    addr[0] = 0xC0;
+    addr[5] = central;
+}
+
+static void scan_report(uint8_t central, int8_t rssi)
+{
+    wiced_ble_ext_scan_results_t rpt;
+
+    memset(&rpt, 0, sizeof(rpt));
+    central_addr(central, rpt.bd_addr);
+    rpt.adv_sid = SID;
+    rpt.rssi    = rssi;
+    app_bt_dispatch(APP_BT_DISPATCH_EXT_SCAN, APP_BT_DISPATCH_EXT_SCAN_REPORT, &rpt);
+}
+
+static void sync_to(uint8_t central)
+{
+    wiced_ble_padv_sync_established_event_data_t ps;
+
+    memset(&ps, 0, sizeof(ps));
+    central_addr(central, ps.adv_addr);
+    ps.adv_sid = SID;
+    pawr_roam_on_sync(&ps);
+}
+
+static void test_list(void)
+{
+    wiced_ble_padv_create_sync_params_t sync;
+    uint8_t                             addr[BD_ADDR_LEN];
+    uint8_t                             i;
+
+    /* without known centrals the create sync parameters are left alone */
+    memset(&sync, 0, sizeof(sync));
+    TEST_CHECK(!pawr_roam_prepare_sync(&sync) && (sync.options == 0));
+
+    /* a central added twice is kept once; the table holds PAWR_ROAM_MAX_CENTRALS */
+    for (i = 0; i < PAWR_ROAM_MAX_CENTRALS; i++)
+    {
+        central_addr(i, addr);
+        TEST_CHECK(pawr_roam_add_central(BLE_ADDR_PUBLIC, addr, SID));
+    }
+    central_addr(0, addr);
+    TEST_CHECK(pawr_roam_add_central(BLE_ADDR_PUBLIC, addr, SID));
+    central_addr(PAWR_ROAM_MAX_CENTRALS, addr);
+    TEST_CHECK(!pawr_roam_add_central(BLE_ADDR_PUBLIC, addr, SID));
+
+    /* the periodic advertiser list is loaded once, then used as it is */
+    TEST_CHECK(pawr_roam_prepare_sync(&sync) && (sync.options == WICED_BLE_PADV_CREATE_SYNC_OPTION_USE_PA_LIST));
+    TEST_CHECK((num_list_clear == 1) && (num_list_add == PAWR_ROAM_MAX_CENTRALS));
+    for (i = 0; i < PAWR_ROAM_MAX_CENTRALS; i++)
+    {
+        TEST_CHECK(list_addr[i][5] == i);
+    }
+    TEST_CHECK(pawr_roam_prepare_sync(&sync) && (num_list_clear == 1));
+}
+
+static void test_survey(void)
+{
+    pawr_roam_stats_t stats;
+
+    /* a good serving link: no survey */
+    sync_to(0);
+    link_valid = WICED_TRUE;
+    link_rssi  = -60;
+    link_loss  = 0;
+    host_advance_ms(5000);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.surveys == 0) && !scan_on);
+
+    /* without enough link samples nothing is rated */
+    link_valid = WICED_FALSE;
+    link_rssi  = -90;
+    host_advance_ms(5000);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK(stats.surveys == 0);
+
+    /* PAWR_ROAM_TRIGGER_CHECKS poor checks in a row start a survey; one good check starts over */
+    link_valid = WICED_TRUE;
+    host_advance_ms(PAWR_ROAM_CHECK_MS * (PAWR_ROAM_TRIGGER_CHECKS - 1));
+    link_rssi = -60;
+    host_advance_ms(PAWR_ROAM_CHECK_MS);
+    link_rssi = -70;
+    link_loss = PAWR_ROAM_TRIGGER_LOSS_PCT + 10;
+    host_advance_ms(PAWR_ROAM_CHECK_MS * (PAWR_ROAM_TRIGGER_CHECKS - 1));
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.surveys == 0) && !scan_on);
+    host_advance_ms(PAWR_ROAM_CHECK_MS);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.surveys == 1) && scan_on);
+
+    /* a candidate within the hysteresis is no reason to leave; the survey ends and backs off */
+    link_rssi = -85;
+    link_loss = 0;
+    while (scan_on)
+    {
+        scan_report(1, -85 + PAWR_ROAM_HYSTERESIS_DB - 1);
+        host_advance_ms(100);
+    }
+    TEST_CHECK(num_resync == 0);
+    host_advance_ms(PAWR_ROAM_SURVEY_BACKOFF_MS - PAWR_ROAM_CHECK_MS);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.surveys == 1) && !scan_on);
+    host_advance_ms(PAWR_ROAM_CHECK_MS * 2);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.surveys == 2) && scan_on);
+
+    /* the serving link recovering ends a survey early */
+    link_rssi = PAWR_ROAM_TRIGGER_RSSI + PAWR_ROAM_HYSTERESIS_DB;
+    host_advance_ms(PAWR_ROAM_CHECK_MS);
+    TEST_CHECK(!scan_on && (num_resync == 0));
+}
+
+static void test_handover(void)
+{
+    wiced_ble_padv_create_sync_params_t sync;
+    pawr_roam_stats_t                   stats;
+    uint8_t                             i;
+
+    /* samples of a stronger central gone stale do not count */
+    host_advance_ms(PAWR_ROAM_SURVEY_BACKOFF_MS);
+    for (i = 0; i < PAWR_ROAM_MIN_SAMPLES; i++)
+    {
+        scan_report(2, -50);
+    }
+    host_advance_ms(PAWR_ROAM_SAMPLE_MAX_AGE_MS + PAWR_ROAM_CHECK_MS);
+    link_rssi = -88;
+    host_advance_ms(PAWR_ROAM_CHECK_MS * PAWR_ROAM_TRIGGER_CHECKS);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK(scan_on && (stats.surveys == 3));
+    host_advance_ms(PAWR_ROAM_CHECK_MS);
+    TEST_CHECK(num_resync == 0);
+
+    /* a candidate needs PAWR_ROAM_MIN_SAMPLES fresh reports and the hysteresis margin */
+    for (i = 0; i < PAWR_ROAM_MIN_SAMPLES - 1; i++)
+    {
+        scan_report(2, -60);
+    }
+    for (i = 0; i < PAWR_ROAM_MIN_SAMPLES; i++)
+    {
+        scan_report(3, -88 + PAWR_ROAM_HYSTERESIS_DB - 1);
+    }
+    host_advance_ms(PAWR_ROAM_CHECK_MS);
+    TEST_CHECK(num_resync == 0);
+    scan_report(2, -60);
+    host_advance_ms(PAWR_ROAM_CHECK_MS);
+    TEST_CHECK(num_resync == 1);
+
+    /* the next sync goes to the chosen central alone; the sync loss of the handover is no outage */
+    memset(&sync, 0, sizeof(sync));
+    TEST_CHECK(pawr_roam_prepare_sync(&sync) && (sync.options == WICED_BLE_PADV_CREATE_SYNC_OPTION_IGNORE_PA_LIST));
+    TEST_CHECK((sync.adv_addr[5] == 2) && (sync.adv_sid == SID) && (num_list_clear == 1));
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.losses == 0) && (stats.handovers == 0));
+    host_advance_ms(320);
+    link_rssi = -55;
+    sync_to(2);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.handovers == 1) && (stats.handover_ms_max == host_now_ms - resync_ms) && (stats.handover_fails == 0));
+    TEST_CHECK(pawr_roam_prepare_sync(&sync) && (sync.options == WICED_BLE_PADV_CREATE_SYNC_OPTION_USE_PA_LIST));
+
+    /* a chosen central that does not sync: after the timeout any known one is joined */
+    host_advance_ms(PAWR_ROAM_SURVEY_BACKOFF_MS);
+    link_rssi = -90;
+    host_advance_ms(PAWR_ROAM_CHECK_MS * PAWR_ROAM_TRIGGER_CHECKS);
+    for (i = 0; i < PAWR_ROAM_MIN_SAMPLES; i++)
+    {
+        scan_report(0, -60);
+    }
+    host_advance_ms(PAWR_ROAM_CHECK_MS);
+    TEST_CHECK(num_resync == 2);
+    host_advance_ms(resync_ms + PAWR_ROAM_HANDOVER_TIMEOUT_MS - 1 - host_now_ms);
+    TEST_CHECK(num_scan_network == 0);
+    host_advance_ms(1);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((num_scan_network == 1) && (stats.handover_fails == 1) && (stats.losses == 1));
+    TEST_CHECK(pawr_roam_prepare_sync(&sync) && (sync.options == WICED_BLE_PADV_CREATE_SYNC_OPTION_USE_PA_LIST));
+
+    /* the outage runs from the start of the failed handover */
+    host_advance_ms(200);
+    sync_to(1);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.handovers == 1) && (stats.outage_ms_max == PAWR_ROAM_HANDOVER_TIMEOUT_MS + 200));
+}
+
+static void test_loss(void)
+{
+    pawr_roam_stats_t stats;
+
+    /* a sync lost on its own is timed until the next one; nothing is checked meanwhile */
+    pawr_roam_on_sync_lost();
+    host_advance_ms(1500);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.losses == 2) && (stats.surveys == 4) && (num_resync == 2));
+
+    /* a sync to a central outside the table ends the outage as well */
+    sync_to(PAWR_ROAM_MAX_CENTRALS + 1);
+    pawr_roam_get_stats(&stats);
+    TEST_CHECK((stats.outage_ms_sum == PAWR_ROAM_HANDOVER_TIMEOUT_MS + 200 + 1500) &&
+               (stats.outage_ms_max == PAWR_ROAM_HANDOVER_TIMEOUT_MS + 200));
+    pawr_roam_print_stats();
+}
+
+int main(void)
+{
+    app_bt_dispatch_init();
+    pawr_roam_init();
+    test_list();
+    test_survey();
+    test_handover();
+    test_loss();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,246 @@
+/******************************************************************************
+* File Name:   test_pawr_rsp_sched.c
+*
+* Description: This file tests the response scheduler: priority and aging, subevent binding, expiry,
+*              reserved slots and slots granted by the central.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_rsp_sched.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define SENT_MAX                        (8)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+typedef struct
+{
+    uint8_t subevent;
+    uint8_t slot;
+    uint8_t tag;                                 /* first payload byte */
+} sent_t;
+
+static sent_t       sent[SENT_MAX];
+static uint8_t      num_sent;
+static wiced_bool_t fail_send;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+wiced_bt_dev_status_t pawr_snd_se_rsp_central(uint16_t sync_handle, uint16_t evt_counter, uint8_t req_subevent,
+                                              uint8_t rsp_subevent, uint8_t rsp_slot, uint8_t rsp_data_len,
+                                              uint8_t *p_data)
+{
+    if (fail_send)
+    {
+        return WICED_BT_ERROR;
+    }
+    TEST_CHECK(num_sent < SENT_MAX);
+    sent[num_sent].subevent = rsp_subevent;
+    sent[num_sent].slot     = rsp_slot;
+    sent[num_sent].tag      = (rsp_data_len != 0) ? p_data[0] : 0;
+    num_sent++;
+    return WICED_BT_SUCCESS;
+}
+
+static void submit(pawr_rsp_prio_t prio, uint8_t subevent, uint8_t tag)
+{
+    TEST_CHECK(pawr_rsp_sched_submit(prio, subevent, &tag, 1) == WICED_BT_SUCCESS);
+}
+
+static uint8_t service(uint16_t evt, uint8_t subevent)
+{
+    num_sent = 0;
+    return pawr_rsp_sched_service(1, evt, subevent);
+}
+
+static void test_priority_and_aging(void)
+{
+    uint16_t evt;
+    uint16_t age;
+
+    pawr_rsp_sched_init();
+    TEST_CHECK(pawr_rsp_sched_set_slots(0, 3, 1));
+
+    /* one slot: alarm, then control, then telemetry */
+    submit(PAWR_RSP_PRIO_TELEMETRY, PAWR_RSP_SCHED_ANY_SUBEVENT, 'T');
+    submit(PAWR_RSP_PRIO_CONTROL, PAWR_RSP_SCHED_ANY_SUBEVENT, 'C');
+    submit(PAWR_RSP_PRIO_ALARM, PAWR_RSP_SCHED_ANY_SUBEVENT, 'A');
+    TEST_CHECK(pawr_rsp_sched_pending(&age) == 3);
+    TEST_CHECK((service(100, 0) == 1) && (sent[0].tag == 'A') && (sent[0].slot == 3));
+    TEST_CHECK((service(101, 0) == 1) && (sent[0].tag == 'C'));
+    TEST_CHECK((service(102, 0) == 1) && (sent[0].tag == 'T'));
+    TEST_CHECK(service(103, 0) == 0);
+
+    /* telemetry that waited two aging steps beats fresh control; a fresh alarm beats both */
+    submit(PAWR_RSP_PRIO_TELEMETRY, PAWR_RSP_SCHED_ANY_SUBEVENT, 'T');
+    for (evt = 104; evt < 104 + 2 * PAWR_RSP_SCHED_AGING_EVENTS; evt++)
+    {
+        TEST_CHECK(service(evt, 1) == 0);        /* no slot in subevent 1 */
+    }
+    submit(PAWR_RSP_PRIO_CONTROL, PAWR_RSP_SCHED_ANY_SUBEVENT, 'C');
+    submit(PAWR_RSP_PRIO_ALARM, PAWR_RSP_SCHED_ANY_SUBEVENT, 'A');
+    TEST_CHECK((service(evt, 0) == 1) && (sent[0].tag == 'A'));
+    TEST_CHECK((service(evt + 1, 0) == 1) && (sent[0].tag == 'T'));
+    TEST_CHECK((service(evt + 2, 0) == 1) && (sent[0].tag == 'C'));
+}
+
+static void test_subevent_and_expiry(void)
+{
+    pawr_rsp_sched_stats_t stats;
+    uint8_t                data[PAWR_RSP_MAX_DATA_LEN + 1] = {0};
+    uint8_t                i;
+
+    pawr_rsp_sched_init();
+    TEST_CHECK(pawr_rsp_sched_set_slots(0, 0, 1));
+    TEST_CHECK(pawr_rsp_sched_set_slots(2, 5, 1));
+    TEST_CHECK(!pawr_rsp_sched_set_slots(PAWR_RSP_SCHED_MAX_SUBEVENTS, 0, 1));
+    TEST_CHECK(!pawr_rsp_sched_set_slots(0, 0, PAWR_RSP_SCHED_MAX_SLOTS + 1));
+
+    /* bound to subevent 2, it waits through subevent 0 */
+    submit(PAWR_RSP_PRIO_CONTROL, 2, 'B');
+    TEST_CHECK(service(10, 0) == 0);
+    TEST_CHECK((service(11, 2) == 1) && (sent[0].subevent == 2) && (sent[0].slot == 5));
+
+    /* too long, queue full */
+    TEST_CHECK(pawr_rsp_sched_submit(PAWR_RSP_PRIO_CONTROL, 0, data, sizeof(data)) == WICED_BT_BADARG);
+    TEST_CHECK(service(0xFFF0, 0) == 0);
+    for (i = 0; i < PAWR_RSP_SCHED_QUEUE_DEPTH; i++)
+    {
+        submit(PAWR_RSP_PRIO_TELEMETRY, 3, i);   /* subevent 3 has no slot */
+    }
+    TEST_CHECK(pawr_rsp_sched_submit(PAWR_RSP_PRIO_TELEMETRY, 3, data, 1) == WICED_BT_NO_RESOURCES);
+    pawr_rsp_sched_get_stats(PAWR_RSP_PRIO_TELEMETRY, &stats);
+    TEST_CHECK((stats.dropped == 1) && (stats.depth == PAWR_RSP_SCHED_QUEUE_DEPTH));
+
+    /* the event counter wraps; the entries expire after PAWR_RSP_SCHED_MAX_AGE_EVENTS */
+    TEST_CHECK(service((uint16_t)(0xFFF0 + PAWR_RSP_SCHED_MAX_AGE_EVENTS), 0) == 0);
+    pawr_rsp_sched_get_stats(PAWR_RSP_PRIO_TELEMETRY, &stats);
+    TEST_CHECK(stats.expired == 0);
+    TEST_CHECK(service((uint16_t)(0xFFF0 + PAWR_RSP_SCHED_MAX_AGE_EVENTS + 1), 0) == 0);
+    pawr_rsp_sched_get_stats(PAWR_RSP_PRIO_TELEMETRY, &stats);
+    TEST_CHECK((stats.expired == PAWR_RSP_SCHED_QUEUE_DEPTH) && (stats.depth == 0));
+
+    /* after a sync loss the queued entries are restamped, a long gap does not expire them */
+    submit(PAWR_RSP_PRIO_CONTROL, 0, 'R');
+    pawr_rsp_sched_reset_timebase();
+    TEST_CHECK((service(5000, 0) == 1) && (sent[0].tag == 'R'));
+    pawr_rsp_sched_get_stats(PAWR_RSP_PRIO_CONTROL, &stats);
+    TEST_CHECK((stats.expired == 0) && (stats.age_max <= 1));
+}
+
+static void test_reserved_slots(void)
+{
+    uint8_t tag = 'X';
+
+    pawr_rsp_sched_init();
+    TEST_CHECK(pawr_rsp_sched_set_slots(1, 8, 2));
+
+    /* slots at or beyond the ones held are refused */
+    TEST_CHECK(pawr_rsp_sched_submit_slot(PAWR_RSP_PRIO_CONTROL, 1, 2, &tag, 1) == WICED_BT_BADARG);
+    TEST_CHECK(pawr_rsp_sched_submit_slot(PAWR_RSP_PRIO_CONTROL, 0, 0, &tag, 1) == WICED_BT_BADARG);
+
+    /* a reservation keeps its slot; lower classes fill the others */
+    submit(PAWR_RSP_PRIO_ALARM, 1, 'a');
+    tag = 'r';
+    TEST_CHECK(pawr_rsp_sched_submit_slot(PAWR_RSP_PRIO_TELEMETRY, 1, 0, &tag, 1) == WICED_BT_SUCCESS);
+    TEST_CHECK(service(20, 1) == 2);
+    TEST_CHECK((sent[0].tag == 'r') && (sent[0].slot == 8));
+    TEST_CHECK((sent[1].tag == 'a') && (sent[1].slot == 9));
+
+    /* two reservations of one slot go out one event apart */
+    tag = '1';
+    TEST_CHECK(pawr_rsp_sched_submit_slot(PAWR_RSP_PRIO_CONTROL, 1, 1, &tag, 1) == WICED_BT_SUCCESS);
+    tag = '2';
+    TEST_CHECK(pawr_rsp_sched_submit_slot(PAWR_RSP_PRIO_CONTROL, 1, 1, &tag, 1) == WICED_BT_SUCCESS);
+    TEST_CHECK((service(21, 1) == 1) && (sent[0].tag == '1') && (sent[0].slot == 9));
+    TEST_CHECK((service(22, 1) == 1) && (sent[0].tag == '2'));
+
+    /* a failed send stays queued */
+    submit(PAWR_RSP_PRIO_CONTROL, 1, 'f');
+    fail_send = WICED_TRUE;
+    TEST_CHECK(service(23, 1) == 0);
+    fail_send = WICED_FALSE;
+    TEST_CHECK((service(24, 1) == 1) && (sent[0].tag == 'f'));
+}
+
+static void test_grants(void)
+{
+    uint8_t i;
+
+    pawr_rsp_sched_init();
+    TEST_CHECK(pawr_rsp_sched_set_slots(0, 4, 1));
+    TEST_CHECK(!pawr_rsp_sched_grant(0, 3, 2));  /* overlaps the owned slot */
+    TEST_CHECK(pawr_rsp_sched_grant(0, 10, 2));
+    TEST_CHECK(pawr_rsp_sched_num_slots(0) == 3);
+
+    for (i = 0; i < 3; i++)
+    {
+        submit(PAWR_RSP_PRIO_TELEMETRY, 0, i);
+    }
+    TEST_CHECK(service(30, 0) == 3);
+    TEST_CHECK((sent[0].slot == 4) && (sent[1].slot == 10) && (sent[2].slot == 11));
+    TEST_CHECK((sent[0].tag == 0) && (sent[1].tag == 1) && (sent[2].tag == 2));
+
+    /* a reservation in a granted slot waits while the grant is gone */
+    i = 'g';
+    TEST_CHECK(pawr_rsp_sched_submit_slot(PAWR_RSP_PRIO_CONTROL, 0, 2, &i, 1) == WICED_BT_SUCCESS);
+    pawr_rsp_sched_release_grants();
+    TEST_CHECK(pawr_rsp_sched_num_slots(0) == 1);
+    TEST_CHECK(service(31, 0) == 0);
+    TEST_CHECK(pawr_rsp_sched_grant(0, 12, 3));
+    TEST_CHECK((service(32, 0) == 1) && (sent[0].slot == 13) && (sent[0].tag == 'g'));
+
+    pawr_rsp_sched_flush();
+    TEST_CHECK(pawr_rsp_sched_pending(&(uint16_t){0}) == 0);
+}
+
+int main(void)
+{
+    test_priority_and_aging();
+    test_subevent_and_expiry();
+    test_reserved_slots();
+    test_grants();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,303 @@
+/******************************************************************************
+* File Name:   test_pawr_security.c
+*
+* Description: This file tests the payload security against the AES-CCM of OpenSSL: downlink messages
+*              sealed by the reference open, uplink messages open at the reference, and tampered,
+*              replayed or misbound messages are refused.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include <openssl/evp.h>
+#include "host_test.h"
+#include "pawr_msg.h"
+#include "pawr_security.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define NONCE_LEN                       (13)
+#define DIR_DOWNLINK                    (0x00)
+#define DIR_UPLINK                      (0x80)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static const uint8_t                   key0[PAWR_SEC_KEY_LEN] = {0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7,
+                                                                 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF};
+static const uint8_t                   key1[PAWR_SEC_KEY_LEN] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+                                                                 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+static const wiced_bt_device_address_t central_a = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+static const wiced_bt_device_address_t central_b = {0x66, 0x55, 0x44, 0x33, 0x22, 0x11};
+static const wiced_bt_device_address_t device_a  = {0xC1, 0x02, 0x03, 0x04, 0x05, 0x06};
+static const wiced_bt_device_address_t device_b  = {0xC6, 0x05, 0x04, 0x03, 0x02, 0x01};
+static const uint8_t                   plain[]   = "shelf 12 price 3.49";
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static void make_nonce(uint8_t *p_nonce, const uint8_t *p_addr, uint16_t epoch, uint16_t evt, uint8_t subevent,
+                       uint8_t rsp_slot, uint8_t dir, uint8_t key_id)
+{
+    memcpy(p_nonce, p_addr, BD_ADDR_LEN);
+    p_nonce[6]  = (uint8_t)epoch;
+    p_nonce[7]  = (uint8_t)(epoch >> 8);
+    p_nonce[8]  = (uint8_t)evt;
+    p_nonce[9]  = (uint8_t)(evt >> 8);
+    p_nonce[10] = subevent;
+    p_nonce[11] = rsp_slot;
+    p_nonce[12] = (uint8_t)(dir | key_id);
+}
+
+/* AES-CCM of the reference implementation; returns the plaintext length or -1 on a tag mismatch */
+static int ref_ccm(wiced_bool_t encrypt, const uint8_t *p_key, const uint8_t *p_nonce, const uint8_t *p_aad,
+                   const uint8_t *p_in, int len, uint8_t *p_out, uint8_t *p_mic)
+{
+    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+    int             out_len;
+    int             ok;
+
+    TEST_CHECK(ctx != NULL);
+    TEST_CHECK(EVP_CipherInit_ex(ctx, EVP_aes_128_ccm(), NULL, NULL, NULL, encrypt) == 1);
+    TEST_CHECK(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, NONCE_LEN, NULL) == 1);
+    TEST_CHECK(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, PAWR_SEC_MIC_LEN, encrypt ? NULL : p_mic) == 1);
+    TEST_CHECK(EVP_CipherInit_ex(ctx, NULL, NULL, p_key, p_nonce, encrypt) == 1);
+    TEST_CHECK(EVP_CipherUpdate(ctx, NULL, &out_len, NULL, len) == 1);
+    TEST_CHECK(EVP_CipherUpdate(ctx, NULL, &out_len, p_aad, PAWR_SEC_HDR_LEN) == 1);
+    ok = EVP_CipherUpdate(ctx, p_out, &out_len, p_in, len);
+    if (ok && encrypt)
+    {
+        TEST_CHECK(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, PAWR_SEC_MIC_LEN, p_mic) == 1);
+    }
+    EVP_CIPHER_CTX_free(ctx);
+    return ok ? out_len : -1;
+}
+
+/* a downlink message as the central seals it */
+static uint16_t central_seal(const uint8_t *p_addr, const uint8_t *p_key, uint8_t key_id, uint16_t epoch,
+                             uint16_t evt, uint8_t subevent, uint8_t *p_msg)
+{
+    uint8_t nonce[NONCE_LEN];
+    uint8_t len = sizeof(plain);
+
+    p_msg[0] = PAWR_MSG_TYPE_SECURE;
+    p_msg[1] = key_id;
+    p_msg[2] = (uint8_t)epoch;
+    p_msg[3] = (uint8_t)(epoch >> 8);
+    make_nonce(nonce, p_addr, epoch, evt, subevent, 0, DIR_DOWNLINK, key_id);
+    TEST_CHECK(ref_ccm(WICED_TRUE, p_key, nonce, p_msg, plain, len, &p_msg[PAWR_SEC_HDR_LEN],
+                       &p_msg[PAWR_SEC_HDR_LEN + len]) == len);
+    return (uint16_t)(len + PAWR_SEC_OVERHEAD);
+}
+
+static wiced_bool_t opens(const uint8_t *p_msg, uint16_t len, uint16_t evt, uint8_t subevent)
+{
+    uint8_t out[PAWR_SEC_MAX_MSG_LEN];
+
+    memset(out, 0, sizeof(out));
+    if (pawr_sec_open(p_msg, len, evt, subevent, out) != sizeof(plain))
+    {
+        return WICED_FALSE;
+    }
+    TEST_CHECK(memcmp(out, plain, sizeof(plain)) == 0);
+    return WICED_TRUE;
+}
+
+/* the central opens a response of device_a, received in rsp_slot of the subevent */
+static wiced_bool_t central_opens(const uint8_t *p_key, uint16_t evt, uint8_t subevent, uint8_t rsp_slot)
+{
+    uint8_t msg[PAWR_SEC_MAX_MSG_LEN];
+    uint8_t data[PAWR_SEC_MAX_MSG_LEN];
+    uint8_t nonce[NONCE_LEN];
+    uint8_t len = 5;
+
+    TEST_CHECK(pawr_sec_seal((const uint8_t *)"hello", len, evt, subevent, rsp_slot, msg, sizeof(msg)) ==
+               len + PAWR_SEC_OVERHEAD);
+    TEST_CHECK(msg[0] == PAWR_MSG_TYPE_SECURE);
+    make_nonce(nonce, device_a, (uint16_t)(msg[2] | (msg[3] << 8)), evt, subevent, rsp_slot, DIR_UPLINK, msg[1]);
+    if (ref_ccm(WICED_FALSE, p_key, nonce, msg, &msg[PAWR_SEC_HDR_LEN], len, data, &msg[PAWR_SEC_HDR_LEN + len]) != len)
+    {
+        return WICED_FALSE;
+    }
+    return (memcmp(data, "hello", len) == 0) ? WICED_TRUE : WICED_FALSE;
+}
+
+static void test_interop(void)
+{
+    uint8_t  msg[PAWR_SEC_MAX_MSG_LEN];
+    uint8_t  out[PAWR_SEC_MAX_MSG_LEN];
+    uint16_t len;
+
+    pawr_sec_init();
+    TEST_CHECK(pawr_sec_set_key(PAWR_SEC_MAX_KEYS, key0) == WICED_BADARG);
+    TEST_CHECK(pawr_sec_set_key(0, key0) == WICED_SUCCESS);
+    pawr_sec_set_device_addr(device_a);
+    TEST_CHECK(!pawr_sec_is_active());           /* keys are expanded at sync */
+    len = central_seal(central_a, key0, 0, 7, 100, 1, msg);
+    TEST_CHECK(pawr_sec_open(msg, len, 100, 1, out) == 0);
+    pawr_sec_on_sync(central_a);
+    TEST_CHECK(pawr_sec_is_active());
+
+    /* downlink sealed by the reference opens; the uplink answer opens at the reference */
+    TEST_CHECK(opens(msg, len, 100, 1));
+    TEST_CHECK(central_opens(key0, 100, 1, 3));
+    TEST_CHECK(!central_opens(key1, 100, 1, 3));
+
+    /* the nonce binds the event, the subevent and the header */
+    len = central_seal(central_a, key0, 0, 7, 101, 1, msg);
+    TEST_CHECK(!opens(msg, len, 102, 1));
+    TEST_CHECK(!opens(msg, len, 101, 0));
+    msg[2] ^= 1;
+    TEST_CHECK(!opens(msg, len, 101, 1));
+    msg[2] ^= 1;
+    msg[PAWR_SEC_HDR_LEN] ^= 0x80;
+    TEST_CHECK(!opens(msg, len, 101, 1));
+    msg[PAWR_SEC_HDR_LEN] ^= 0x80;
+    msg[len - 1] ^= 0x01;
+    TEST_CHECK(!opens(msg, len, 101, 1));
+    msg[len - 1] ^= 0x01;
+    TEST_CHECK(opens(msg, len, 101, 1));
+
+    /* too short, unknown key id, no room for the overhead */
+    TEST_CHECK(pawr_sec_open(msg, PAWR_SEC_OVERHEAD, 101, 1, out) == 0);
+    len = central_seal(central_a, key0, PAWR_SEC_MAX_KEYS, 7, 103, 1, msg);
+    TEST_CHECK(!opens(msg, len, 103, 1));
+    TEST_CHECK(pawr_sec_seal(plain, sizeof(plain), 103, 1, 3, out, sizeof(plain) + PAWR_SEC_OVERHEAD - 1) == 0);
+}
+
+static void test_uplink_nonce(void)
+{
+    uint8_t  msg[PAWR_SEC_MAX_MSG_LEN];
+    uint8_t  owned[PAWR_SEC_MAX_MSG_LEN];
+    uint8_t  granted[PAWR_SEC_MAX_MSG_LEN];
+    uint8_t  other[PAWR_SEC_MAX_MSG_LEN];
+    uint16_t len;
+
+    /* no response is sealed without the device address */
+    pawr_sec_init();
+    TEST_CHECK(pawr_sec_set_key(0, key0) == WICED_SUCCESS);
+    pawr_sec_on_sync(central_a);
+    len = central_seal(central_a, key0, 0, 7, 400, 2, msg);
+    TEST_CHECK(opens(msg, len, 400, 2));
+    TEST_CHECK(pawr_sec_seal(plain, sizeof(plain), 400, 2, 3, owned, sizeof(owned)) == 0);
+
+    /* one device, two responses in the same event and subevent, in its owned and a granted slot */
+    pawr_sec_set_device_addr(device_a);
+    len = pawr_sec_seal(plain, sizeof(plain), 400, 2, 3, owned, sizeof(owned));
+    TEST_CHECK(len == sizeof(plain) + PAWR_SEC_OVERHEAD);
+    TEST_CHECK(pawr_sec_seal(plain, sizeof(plain), 400, 2, 9, granted, sizeof(granted)) == len);
+    TEST_CHECK(memcmp(&owned[PAWR_SEC_HDR_LEN], &granted[PAWR_SEC_HDR_LEN], len - PAWR_SEC_HDR_LEN) != 0);
+
+    /* another device on the same network key, same event, subevent and slot */
+    pawr_sec_set_device_addr(device_b);
+    TEST_CHECK(pawr_sec_seal(plain, sizeof(plain), 400, 2, 3, other, sizeof(other)) == len);
+    TEST_CHECK(memcmp(&owned[PAWR_SEC_HDR_LEN], &other[PAWR_SEC_HDR_LEN], len - PAWR_SEC_HDR_LEN) != 0);
+
+    /* and the central tells the slots apart */
+    pawr_sec_set_device_addr(device_a);
+    TEST_CHECK(central_opens(key0, 401, 2, 9));
+}
+
+static void test_replay(void)
+{
+    uint8_t  msg[4][PAWR_SEC_MAX_MSG_LEN];
+    uint16_t len;
+
+    pawr_sec_init();
+    TEST_CHECK(pawr_sec_set_key(0, key0) == WICED_SUCCESS);
+    pawr_sec_on_sync(central_a);
+
+    len = central_seal(central_a, key0, 0, 1, 200, 0, msg[0]);
+    TEST_CHECK(opens(msg[0], len, 200, 0));
+    TEST_CHECK(!opens(msg[0], len, 200, 0));
+
+    /* out of order inside the window is accepted once; the window counts subevents */
+    central_seal(central_a, key0, 0, 1, 201, 5, msg[1]);
+    central_seal(central_a, key0, 0, 1, 201, 2, msg[2]);
+    TEST_CHECK(opens(msg[1], len, 201, 5));
+    TEST_CHECK(opens(msg[2], len, 201, 2));
+    TEST_CHECK(!opens(msg[2], len, 201, 2));
+
+    /* never seen but behind the window */
+    central_seal(central_a, key0, 0, 1, 200, 1, msg[0]);
+    TEST_CHECK(!opens(msg[0], len, 200, 1));
+
+    /* a new epoch moves past every (event, subevent) of the old one */
+    central_seal(central_a, key0, 0, 2, 10, 0, msg[3]);
+    TEST_CHECK(opens(msg[3], len, 10, 0));
+    central_seal(central_a, key0, 0, 1, 211, 0, msg[1]);
+    TEST_CHECK(!opens(msg[1], len, 211, 0));
+
+    /* the window of a central survives a sync to another one */
+    pawr_sec_on_sync(central_b);
+    central_seal(central_b, key0, 0, 1, 200, 0, msg[0]);
+    TEST_CHECK(opens(msg[0], len, 200, 0));
+    pawr_sec_on_sync(central_a);
+    TEST_CHECK(!opens(msg[3], len, 10, 0));
+}
+
+static void test_key_rotation(void)
+{
+    uint8_t  msg[PAWR_SEC_MAX_MSG_LEN];
+    uint16_t len;
+
+    pawr_sec_init();
+    TEST_CHECK(pawr_sec_set_key(0, key0) == WICED_SUCCESS);
+    TEST_CHECK(pawr_sec_set_key(1, key1) == WICED_SUCCESS);
+    pawr_sec_set_device_addr(device_a);
+    pawr_sec_on_sync(central_a);
+    TEST_CHECK(central_opens(key0, 300, 0, 0));
+
+    /* once the central uses the next key the answers follow it */
+    len = central_seal(central_a, key1, 1, 4, 301, 0, msg);
+    TEST_CHECK(opens(msg, len, 301, 0));
+    TEST_CHECK(msg[1] == 1);
+    TEST_CHECK(central_opens(key1, 302, 0, 0));
+    len = central_seal(central_a, key0, 0, 4, 303, 0, msg);
+    TEST_CHECK(opens(msg, len, 303, 0));
+    TEST_CHECK(central_opens(key0, 304, 0, 0));
+}
+
+int main(void)
+{
+    test_interop();
+    test_uplink_nonce();
+    test_replay();
+    test_key_rotation();
+    TEST_PASS();
+    return 0;
+}
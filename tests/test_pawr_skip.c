@@ -0,0 +1,219 @@
+/******************************************************************************
+* File Name:   test_pawr_skip.c
+*
+* Description: This file tests the adaptive event skip policy: the ladder of skips and its limit, the
+*              quiet and hold times, drops on data or a wake flag, tighter bounds, and sync loss.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr.h"
+#include "pawr_skip.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define EVT_MS                          (100)    /* train interval of the test */
+#define RESYNC_MS                       (300)    /* a skip change until the new sync */
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static uint16_t                                     set_skip;
+static uint32_t                                     num_set;
+static uint16_t                                     evt;
+static wiced_ble_padv_sync_established_event_data_t sync_data;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+/* the PAwR layer; the tests re-create the sync themselves */
+void pawr_set_skip(uint16_t skip)
+{
+    set_skip = skip;
+    num_set++;
+}
+
+static void resync(void)
+{
+    host_advance_ms(RESYNC_MS);
+    pawr_skip_on_sync(&sync_data);
+}
+
+/* quiet events for ms, following each skip change with a new sync */
+static void quiet(uint32_t ms)
+{
+    uint32_t end = host_now_ms + ms;
+    uint32_t n;
+
+    while (host_now_ms < end)
+    {
+        n = num_set;
+        host_advance_ms(EVT_MS * (pawr_skip_get() + 1U));
+        evt = (uint16_t)(evt + pawr_skip_get() + 1U);
+        pawr_skip_on_report(evt, WICED_FALSE, WICED_FALSE);
+        if (num_set != n)
+        {
+            resync();
+        }
+    }
+}
+
+static void test_ladder(void)
+{
+    pawr_skip_stats_t stats;
+
+    /* 100 ms: 2000 ms of latency would allow 19, six events in the 10 s sync timeout allow 15 */
+    memset(&sync_data, 0, sizeof(sync_data));
+    sync_data.periodic_adv_int = EVT_MS * 4 / 5;
+    host_advance_ms(PAWR_CFG_SKIP_HOLD_MS);
+    pawr_skip_set_bounds(2000, 10000);
+    pawr_skip_on_sync(&sync_data);
+    TEST_CHECK(pawr_skip_get() == 0);
+
+    /* 0 to limit/16 = 0 is no step; the first raise after the quiet time goes to limit/4 */
+    quiet(9900);
+    TEST_CHECK((pawr_skip_get() == 0) && (num_set == 0));
+    quiet(200);
+    TEST_CHECK((pawr_skip_get() == 3) && (set_skip == 3) && (num_set == 1));
+
+    /* the next waits out the hold time since the change, not just the quiet time */
+    quiet(PAWR_CFG_SKIP_HOLD_MS - 1000);
+    TEST_CHECK(pawr_skip_get() == 3);
+    quiet(2000);
+    TEST_CHECK((pawr_skip_get() == 15) && (num_set == 2));
+    quiet(5U * PAWR_CFG_SKIP_HOLD_MS);
+    TEST_CHECK((pawr_skip_get() == 15) && (num_set == 2));
+
+    pawr_skip_get_stats(&stats);
+    TEST_CHECK((stats.raises == 2) && (stats.drops == 0));
+    TEST_CHECK(stats.synced_ms > 4U * PAWR_CFG_SKIP_HOLD_MS);
+}
+
+static void test_drop(void)
+{
+    pawr_skip_stats_t before;
+    pawr_skip_stats_t stats;
+
+    pawr_skip_get_stats(&before);
+
+    /* data for this device drops to 0 at once; the delay counts until the new sync */
+    evt += 16;
+    pawr_skip_on_report(evt, WICED_TRUE, WICED_FALSE);
+    TEST_CHECK((pawr_skip_get() == 0) && (set_skip == 0));
+    resync();
+    pawr_skip_get_stats(&stats);
+    TEST_CHECK((stats.drops - before.drops == 1) && (stats.wakes == before.wakes));
+    TEST_CHECK(stats.wake_ms_max == RESYNC_MS);
+
+    /* the drop restarts the hold time: quiet for 10 s is not enough to raise again */
+    quiet(15000);
+    TEST_CHECK(pawr_skip_get() == 0);
+    quiet(PAWR_CFG_SKIP_HOLD_MS - 15000 + 1000);
+    TEST_CHECK(pawr_skip_get() == 3);
+
+    /* a wake flag drops too, and counts as a wake */
+    evt += 4;
+    pawr_skip_on_report(evt, WICED_FALSE, WICED_TRUE);
+    TEST_CHECK(pawr_skip_get() == 0);
+    resync();
+    pawr_skip_get_stats(&stats);
+    TEST_CHECK((stats.drops - before.drops == 2) && (stats.wakes - before.wakes == 1));
+
+    /* at skip 0 activity only restarts the quiet time */
+    evt++;
+    pawr_skip_on_report(evt, WICED_TRUE, WICED_FALSE);
+    pawr_skip_get_stats(&before);
+    TEST_CHECK(before.drops == stats.drops);
+}
+
+static void test_bounds_and_loss(void)
+{
+    pawr_skip_stats_t before;
+    pawr_skip_stats_t stats;
+    uint32_t          n;
+
+    quiet(2U * PAWR_CFG_SKIP_HOLD_MS);
+    TEST_CHECK(pawr_skip_get() == 15);
+
+    /* a tighter bound lowers the skip right away: 500 ms allows 4 */
+    n = num_set;
+    pawr_skip_set_bounds(500, 10000);
+    TEST_CHECK((pawr_skip_get() == 4) && (num_set == n + 1));
+    resync();
+
+    /* a slower train lowers the limit at its sync: 500 ms interval, 3 events, skip 2 */
+    pawr_skip_set_bounds(2000, 10000);
+    sync_data.periodic_adv_int = 400;
+    pawr_skip_on_sync(&sync_data);
+    TEST_CHECK(pawr_skip_get() == 2);
+
+    /* events are counted once per event counter, whatever the subevents */
+    pawr_skip_get_stats(&before);
+    evt += 3;
+    pawr_skip_on_report(evt, WICED_FALSE, WICED_FALSE);
+    pawr_skip_on_report(evt, WICED_FALSE, WICED_FALSE);
+    pawr_skip_get_stats(&stats);
+    TEST_CHECK(stats.events - before.events == 1);
+
+    /* a sync loss starts over at 0 and stops the synced time; reports until the next sync are ignored */
+    pawr_skip_on_sync_lost();
+    TEST_CHECK(pawr_skip_get() == 0);
+    pawr_skip_get_stats(&before);
+    host_advance_ms(60000);
+    evt += 10;
+    pawr_skip_on_report(evt, WICED_TRUE, WICED_FALSE);
+    pawr_skip_get_stats(&stats);
+    TEST_CHECK((stats.synced_ms == before.synced_ms) && (stats.events == before.events));
+    TEST_CHECK(stats.drops == before.drops);
+    sync_data.periodic_adv_int = EVT_MS * 4 / 5;
+    pawr_skip_on_sync(&sync_data);
+    quiet(1000);
+    pawr_skip_get_stats(&stats);
+    TEST_CHECK(stats.synced_ms >= before.synced_ms + 1000);
+    pawr_skip_print_stats();
+}
+
+int main(void)
+{
+    test_ladder();
+    test_drop();
+    test_bounds_and_loss();
+    TEST_PASS();
+    return 0;
+}
@@ -0,0 +1,234 @@
+/******************************************************************************
+* File Name:   test_pawr_timesync.c
+*
+* Description: This file tests the network time service against a local clock that drifts from the train:
+*              the drift fit across the event counter wrap, conversions, scheduled actions, and late
+*              reports.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+ * (c) 2021-2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is
+ * owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+ * and is protected by and subject to worldwide patent protection, worldwide
+ * copyright laws, and international treaty provisions. Therefore, you may use
+ * this Software only as provided in the license agreement accompanying the
+ * software package from which you obtained this Software. If no license
+ * agreement applies, then any use, reproduction, modification, translation, or
+ * compilation of this Software is prohibited without the express written
+ * permission of Infineon.
+ *
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+ * THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+ * SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+ * Infineon reserves the right to make changes to the Software without notice.
+ * You are responsible for properly designing, programming, and testing the
+ * functionality and safety of your intended application of the Software, as
+ * well as complying with any legal requirements related to its use. Infineon
+ * does not guarantee that the Software will be free from intrusion, data theft
+ * or loss, or other breaches ("Security Breaches"), and Infineon shall have
+ * no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any
+ * application where a failure of the Product or any consequences of the use
+ * thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "host_test.h"
+#include "pawr_timesync.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define ADV_INT                         (80)     /* 100 ms */
+#define SUBEVENT_INT                    (8)      /* 10 ms */
+#define EVT_US                          (100000)
+#define SUBEVENT_US                     (10000)
+#define DRIFT_PPB                       (40000)  /* local clock 40 ppm fast */
+#define LOCAL_START_US                  (123456789LL)
+#define DATA_INCOMPLETE                 (0x01)
+
+/*******************************************************************************
+* Variable Definitions
+*******************************************************************************/
+static int64_t  net_evt;                         /* events since the start of the train */
+static uint16_t evt_base = 65000;                /* counter of event 0, wraps during the test */
+static uint32_t rng      = 11;
+static uint32_t late_us;                         /* added to every report, a stack that is behind */
+static int64_t  fired_local_us[4];
+static int32_t  fired_late_us[4];
+static uint8_t  num_fired;
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+static uint32_t next_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/* local clock at a network time */
+static int64_t local_at(int64_t net_us)
+{
+    return LOCAL_START_US + net_us + (net_us * DRIFT_PPB) / 1000000000LL;
+}
+
+static void advance_to_local(int64_t local_us)
+{
+    int64_t ms = local_us / 1000;
+
+    if (ms > (int64_t)host_now_ms)
+    {
+        host_advance_ms((uint32_t)(ms - host_now_ms));
+    }
+}
+
+/* reports of both subevents for n events, each 300 to 500 us after its anchor */
+static void run_events(uint32_t n)
+{
+    int64_t net;
+    uint8_t se;
+
+    while (n-- != 0)
+    {
+        for (se = 0; se < 2; se++)
+        {
+            net = net_evt * EVT_US + se * SUBEVENT_US;
+            advance_to_local(local_at(net) + 300 + (next_rand() % 200) + late_us);
+            pawr_ts_on_report((uint16_t)(evt_base + net_evt), se, 0);
+        }
+        net_evt++;
+    }
+}
+
+static void action(void *p_arg, int32_t late)
+{
+    uint8_t i = (uint8_t)(uintptr_t)p_arg;
+
+    fired_local_us[i] = (int64_t)host_now_ms * 1000;
+    fired_late_us[i]  = late;
+    num_fired++;
+}
+
+static void test_estimate(void)
+{
+    pawr_ts_stats_t stats;
+    uint16_t        evt;
+    uint32_t        offset_us;
+    uint64_t        local_us;
+    int64_t         err;
+
+    host_now_ms = (uint32_t)(LOCAL_START_US / 1000);
+    pawr_ts_init();
+    pawr_ts_on_sync(ADV_INT, SUBEVENT_INT);
+
+    /* nothing to convert until the first sample is in */
+    run_events(30);
+    TEST_CHECK(!pawr_ts_is_synced() && !pawr_ts_now(&evt, &offset_us));
+    TEST_CHECK(!pawr_ts_schedule(evt_base + 100, 0, action, NULL));
+    run_events(15);
+    TEST_CHECK(pawr_ts_is_synced());
+
+    /* incomplete reports say nothing */
+    pawr_ts_on_report((uint16_t)(evt_base + net_evt), 0, DATA_INCOMPLETE);
+    pawr_ts_get_stats(&stats);
+    TEST_CHECK(stats.reports == 2 * 45);
+
+    /* two minutes in, across the counter wrap, the drift is found to within 2 ppm */
+    run_events(1200);
+    pawr_ts_get_stats(&stats);
+    TEST_CHECK((stats.drift_ppb > DRIFT_PPB - 2000) && (stats.drift_ppb < DRIFT_PPB + 2000));
+    TEST_CHECK((stats.outliers == 0) && (stats.restarts == 0) && (stats.jitter_us < 2000));
+
+    /* an instant a minute ahead, within the 1 ms tick */
+    TEST_CHECK(pawr_ts_net_to_local((uint16_t)(evt_base + net_evt + 600), 50000, &local_us));
+    err = (int64_t)local_us - local_at((net_evt + 600) * EVT_US + 50000);
+    TEST_CHECK((err > -1500) && (err < 1500));
+
+    /* now is the event that started last */
+    TEST_CHECK(pawr_ts_now(&evt, &offset_us));
+    TEST_CHECK(((uint16_t)(evt_base + net_evt - 1 - evt) <= 1) && (offset_us < EVT_US));
+}
+
+static void test_actions(void)
+{
+    pawr_ts_stats_t stats;
+    int64_t         due;
+    uint16_t        evt = (uint16_t)(evt_base + net_evt);
+    uint8_t         i;
+
+    /* the same network instant on every peripheral: here it lands on the local due time */
+    num_fired = 0;
+    TEST_CHECK(pawr_ts_schedule((uint16_t)(evt + 50), 50000, action, (void *)0));
+    TEST_CHECK(pawr_ts_schedule((uint16_t)(evt + 20), 0, action, (void *)1));
+    TEST_CHECK(pawr_ts_schedule((uint16_t)(evt + 30), 0, action, (void *)2));
+    TEST_CHECK(pawr_ts_schedule((uint16_t)(evt + 40), 0, action, (void *)3));
+    TEST_CHECK(!pawr_ts_schedule((uint16_t)(evt + 60), 0, action, NULL));
+    TEST_CHECK(!pawr_ts_schedule((uint16_t)(evt - 10), 0, action, NULL));
+    run_events(60);
+    TEST_CHECK(num_fired == 4);
+    for (i = 0; i < 4; i++)
+    {
+        due = local_at((net_evt - 60 + ((i == 0) ? 50 : 10 + 10 * i)) * EVT_US + ((i == 0) ? 50000 : 0));
+        TEST_CHECK((fired_local_us[i] - due > -2000) && (fired_local_us[i] - due < 2000));
+        TEST_CHECK((fired_late_us[i] >= -PAWR_TS_EARLY_US) && (fired_late_us[i] < 2000));
+    }
+
+    /* a new train cancels what is pending */
+    TEST_CHECK(pawr_ts_schedule((uint16_t)(evt_base + net_evt + 50), 0, action, (void *)0));
+    pawr_ts_on_sync(ADV_INT, SUBEVENT_INT);
+    TEST_CHECK(!pawr_ts_is_synced());
+    pawr_ts_get_stats(&stats);
+    TEST_CHECK((stats.actions_fired == 4) && (stats.actions_dropped == 1));
+}
+
+static void test_outliers(void)
+{
+    pawr_ts_stats_t stats;
+    uint32_t        n;
+
+    run_events(100);
+    TEST_CHECK(pawr_ts_is_synced());
+
+    /* now and then a report handed over late: rejected, the estimate stays */
+    for (n = 0; n < 20; n++)
+    {
+        late_us = 20000;
+        run_events(1);
+        late_us = 0;
+        run_events(9);
+    }
+    pawr_ts_get_stats(&stats);
+    TEST_CHECK((stats.outliers == 40) && (stats.restarts == 0) && stats.synced);
+
+    /* a lasting shift is not lateness: the estimate starts over and settles on it */
+    late_us = 20000;
+    run_events(PAWR_TS_MAX_OUTLIERS / 2);
+    pawr_ts_get_stats(&stats);
+    TEST_CHECK((stats.restarts == 1) && !stats.synced);
+    run_events(100);
+    pawr_ts_get_stats(&stats);
+    TEST_CHECK(stats.synced && (stats.outliers == 40 + PAWR_TS_MAX_OUTLIERS));
+    late_us = 0;
+    pawr_ts_print_stats();
+}
+
+int main(void)
+{
+    test_estimate();
+    test_actions();
+    test_outliers();
+    TEST_PASS();
+    return 0;
+}